@@ -0,0 +1,284 @@
+/**
+ * @file bench_common.c
+ * @brief Shared timing, statistics and host utilities for native benchmarks
+ */
+
+#define _GNU_SOURCE
+
+#include "bench_common.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/utsname.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// ============================================================================
+// Timers
+// ============================================================================
+
+uint64_t bench_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_lfence();
+    uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+#elif defined(__aarch64__)
+    uint64_t t;
+    __asm__ __volatile__("isb; mrs %0, cntvct_el0" : "=r"(t) :: "memory");
+    return t;
+#else
+    return bench_now_ns();
+#endif
+}
+
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+#ifdef CLOCK_MONOTONIC_RAW
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+const char* bench_cycle_counter_name(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return "rdtsc";
+#elif defined(__aarch64__)
+    return "cntvct_el0";
+#else
+    return "clock_monotonic_ns";
+#endif
+}
+
+// ============================================================================
+// Host Control
+// ============================================================================
+
+int bench_pin_to_cpu(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0 ? 0 : -1;
+#else
+    (void)cpu;
+    return -1;
+#endif
+}
+
+int bench_online_cpus(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+void bench_get_system_info(bench_system_info_t *info) {
+    if (!info) {
+        return;
+    }
+
+    memset(info, 0, sizeof(*info));
+    strncpy(info->cpu, "unknown", sizeof(info->cpu) - 1);
+    info->cores = bench_online_cpus();
+
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    if (f) {
+        char line[256];
+        while (fgets(line, sizeof(line), f)) {
+            if (strncmp(line, "model name", 10) == 0) {
+                char *value = strchr(line, ':');
+                if (value) {
+                    value++;
+                    while (*value == ' ' || *value == '\t') {
+                        value++;
+                    }
+                    value[strcspn(value, "\n")] = '\0';
+                    strncpy(info->cpu, value, sizeof(info->cpu) - 1);
+                }
+                break;
+            }
+        }
+        fclose(f);
+    }
+
+    struct utsname uts;
+    if (uname(&uts) == 0) {
+        // uts.machine is 65 bytes; machine names that long get cut to fit
+        snprintf(info->architecture, sizeof(info->architecture), "%.*s",
+                 (int)sizeof(info->architecture) - 1, uts.machine);
+    }
+
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (pages > 0 && page_size > 0) {
+        double gib = (double)pages * (double)page_size / (1024.0 * 1024.0 * 1024.0);
+        snprintf(info->memory, sizeof(info->memory), "%.1fGi", gib);
+    } else {
+        strncpy(info->memory, "unknown", sizeof(info->memory) - 1);
+    }
+}
+
+int bench_cache_miss_counter_open(void) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    return fd >= 0 ? (int)fd : -1;
+#else
+    return -1;
+#endif
+}
+
+uint64_t bench_counter_read(int fd) {
+    uint64_t value = 0;
+    if (fd < 0 || read(fd, &value, sizeof(value)) != (ssize_t)sizeof(value)) {
+        return 0;
+    }
+    return value;
+}
+
+void bench_counter_close(int fd) {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+void bench_format_timestamp(char *buffer, size_t length) {
+    if (!buffer || length == 0) {
+        return;
+    }
+
+    time_t now = time(NULL);
+    struct tm tm_utc;
+    gmtime_r(&now, &tm_utc);
+    strftime(buffer, length, "%Y-%m-%dT%H:%M:%S+00:00", &tm_utc);
+}
+
+// ============================================================================
+// Samples and Statistics
+// ============================================================================
+
+int bench_samples_init(bench_samples_t *samples, size_t capacity) {
+    if (!samples || capacity == 0) {
+        return -1;
+    }
+
+    samples->count = 0;
+    samples->capacity = capacity;
+    samples->cycles = calloc(capacity, sizeof(uint64_t));
+    samples->ns = calloc(capacity, sizeof(uint64_t));
+    if (!samples->cycles || !samples->ns) {
+        bench_samples_free(samples);
+        return -1;
+    }
+
+    return 0;
+}
+
+void bench_samples_free(bench_samples_t *samples) {
+    if (!samples) {
+        return;
+    }
+
+    free(samples->cycles);
+    free(samples->ns);
+    samples->cycles = NULL;
+    samples->ns = NULL;
+    samples->count = 0;
+    samples->capacity = 0;
+}
+
+void bench_samples_push(bench_samples_t *samples, uint64_t cycles, uint64_t ns) {
+    if (!samples || samples->count >= samples->capacity) {
+        return;
+    }
+
+    samples->cycles[samples->count] = cycles;
+    samples->ns[samples->count] = ns;
+    samples->count++;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+int bench_compute_stats(const uint64_t *values, size_t count, bench_stats_t *stats) {
+    if (!values || !stats || count == 0) {
+        return -1;
+    }
+
+    uint64_t *sorted = malloc(count * sizeof(uint64_t));
+    if (!sorted) {
+        return -1;
+    }
+    memcpy(sorted, values, count * sizeof(uint64_t));
+    qsort(sorted, count, sizeof(uint64_t), compare_u64);
+
+    if (count % 2 == 1) {
+        stats->median = (double)sorted[count / 2];
+    } else {
+        stats->median = ((double)sorted[count / 2 - 1] + (double)sorted[count / 2]) / 2.0;
+    }
+
+    // Nearest-rank percentile
+    size_t rank = (size_t)ceil(0.99 * (double)count);
+    stats->p99 = (double)sorted[rank > 0 ? rank - 1 : 0];
+    stats->min = sorted[0];
+    stats->max = sorted[count - 1];
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sum += (double)sorted[i];
+    }
+    stats->mean = sum / (double)count;
+
+    double sq = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        double d = (double)sorted[i] - stats->mean;
+        sq += d * d;
+    }
+    stats->stddev = count > 1 ? sqrt(sq / (double)(count - 1)) : 0.0;
+
+    free(sorted);
+    return 0;
+}
+
+void bench_json_string(FILE *out, const char *value) {
+    fputc('"', out);
+    for (const char *p = value ? value : ""; *p; p++) {
+        switch (*p) {
+            case '"': fputs("\\\"", out); break;
+            case '\\': fputs("\\\\", out); break;
+            case '\n': fputs("\\n", out); break;
+            case '\t': fputs("\\t", out); break;
+            default:
+                if ((unsigned char)*p < 0x20) {
+                    fprintf(out, "\\u%04x", (unsigned char)*p);
+                } else {
+                    fputc(*p, out);
+                }
+                break;
+        }
+    }
+    fputc('"', out);
+}
@@ -0,0 +1,204 @@
+/**
+ * @file bench_common.h
+ * @brief Shared timing, statistics and host utilities for native benchmarks
+ *
+ * This header provides the cycle/nanosecond timers, CPU pinning helpers,
+ * sample buffers and summary statistics used by benchmark_runner and the
+ * other native measurement tools under benchmarks/.
+ */
+
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+#define BENCH_DEFAULT_WARMUP        32      /**< Default warmup iterations */
+#define BENCH_DEFAULT_ITERATIONS    256     /**< Default measured iterations */
+#define BENCH_MAX_NAME_LENGTH       64      /**< Maximum benchmark case name */
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+/**
+ * @brief Per-iteration samples for one benchmark case
+ */
+typedef struct {
+    size_t count;                       /**< Number of recorded samples */
+    size_t capacity;                    /**< Allocated sample slots */
+    uint64_t *cycles;                   /**< Cycle count per iteration */
+    uint64_t *ns;                       /**< Wall-clock nanoseconds per iteration */
+} bench_samples_t;
+
+/**
+ * @brief Summary statistics over a sample set
+ */
+typedef struct {
+    double median;                      /**< 50th percentile */
+    double p99;                         /**< 99th percentile (nearest rank) */
+    double mean;                        /**< Arithmetic mean */
+    double stddev;                      /**< Sample standard deviation */
+    uint64_t min;                       /**< Minimum sample */
+    uint64_t max;                       /**< Maximum sample */
+} bench_stats_t;
+
+/**
+ * @brief Host description recorded alongside results
+ */
+typedef struct {
+    char cpu[128];                      /**< CPU model name */
+    char architecture[32];              /**< Machine architecture */
+    char memory[32];                    /**< Total memory, human readable */
+    int cores;                          /**< Online logical CPUs */
+} bench_system_info_t;
+
+// ============================================================================
+// Timers
+// ============================================================================
+
+/**
+ * @brief Read the serialized cycle counter
+ *
+ * Uses RDTSC with LFENCE on x86-64 and CNTVCT_EL0 on AArch64. On other
+ * targets the monotonic clock in nanoseconds is returned instead.
+ *
+ * @return Current cycle counter value
+ */
+uint64_t bench_cycles(void);
+
+/**
+ * @brief Read the monotonic clock
+ *
+ * @return Current time in nanoseconds
+ */
+uint64_t bench_now_ns(void);
+
+/**
+ * @brief Get the name of the cycle counter used by bench_cycles()
+ *
+ * @return Counter name (e.g. "rdtsc")
+ */
+const char* bench_cycle_counter_name(void);
+
+// ============================================================================
+// Host Control
+// ============================================================================
+
+/**
+ * @brief Pin the calling thread to a single CPU
+ *
+ * @param[in] cpu CPU index to pin to
+ * @return 0 on success, -1 on failure
+ */
+int bench_pin_to_cpu(int cpu);
+
+/**
+ * @brief Get the number of online logical CPUs
+ *
+ * @return CPU count (at least 1)
+ */
+int bench_online_cpus(void);
+
+/**
+ * @brief Collect host information for reports
+ *
+ * @param[out] info System information structure
+ */
+void bench_get_system_info(bench_system_info_t *info);
+
+/**
+ * @brief Format the current UTC time as ISO-8601
+ *
+ * @param[out] buffer Output buffer
+ * @param[in] length Size of output buffer
+ */
+void bench_format_timestamp(char *buffer, size_t length);
+
+/**
+ * @brief Open a per-thread hardware cache-miss counter
+ *
+ * Counts PERF_COUNT_HW_CACHE_MISSES for the calling thread. The counter
+ * starts enabled.
+ *
+ * @return Counter file descriptor, or -1 if perf events are unavailable
+ */
+int bench_cache_miss_counter_open(void);
+
+/**
+ * @brief Read a counter opened with bench_cache_miss_counter_open()
+ *
+ * @param[in] fd Counter file descriptor
+ * @return Counter value, or 0 if fd is invalid or the read fails
+ */
+uint64_t bench_counter_read(int fd);
+
+/**
+ * @brief Close a counter
+ *
+ * @param[in] fd Counter file descriptor (ignored if negative)
+ */
+void bench_counter_close(int fd);
+
+// ============================================================================
+// Samples and Statistics
+// ============================================================================
+
+/**
+ * @brief Allocate sample storage
+ *
+ * @param[out] samples Sample set to initialize
+ * @param[in] capacity Number of samples to reserve
+ * @return 0 on success, -1 on failure
+ */
+int bench_samples_init(bench_samples_t *samples, size_t capacity);
+
+/**
+ * @brief Release sample storage
+ *
+ * @param[in,out] samples Sample set to free
+ */
+void bench_samples_free(bench_samples_t *samples);
+
+/**
+ * @brief Append one measurement
+ *
+ * @param[in,out] samples Sample set
+ * @param[in] cycles Cycles for the iteration
+ * @param[in] ns Nanoseconds for the iteration
+ */
+void bench_samples_push(bench_samples_t *samples, uint64_t cycles, uint64_t ns);
+
+/**
+ * @brief Compute summary statistics
+ *
+ * @param[in] values Sample values (not modified)
+ * @param[in] count Number of values
+ * @param[out] stats Computed statistics
+ * @return 0 on success, -1 on failure
+ */
+int bench_compute_stats(const uint64_t *values, size_t count, bench_stats_t *stats);
+
+/**
+ * @brief Write a JSON string literal with escaping
+ *
+ * @param[in] out Output stream
+ * @param[in] value String to write
+ */
+void bench_json_string(FILE *out, const char *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_COMMON_H */
@@ -0,0 +1,312 @@
+/**
+ * @file bench_json.c
+ * @brief Minimal JSON reader for benchmark reports and baselines
+ */
+
+#include "bench_json.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define BENCH_JSON_MAX_DEPTH 32         /**< Nesting limit */
+
+typedef struct {
+    const char *p;
+    int depth;
+} json_parser_t;
+
+static bool parse_value(json_parser_t *ps, bench_json_value_t *out);
+
+static void skip_ws(json_parser_t *ps) {
+    while (*ps->p && isspace((unsigned char)*ps->p)) {
+        ps->p++;
+    }
+}
+
+static void free_contents(bench_json_value_t *v) {
+    if (!v) {
+        return;
+    }
+
+    free(v->string);
+    for (size_t i = 0; i < v->count; i++) {
+        free_contents(&v->items[i]);
+        if (v->keys) {
+            free(v->keys[i]);
+        }
+    }
+    free(v->items);
+    free(v->keys);
+    memset(v, 0, sizeof(*v));
+}
+
+static char* parse_string_raw(json_parser_t *ps) {
+    if (*ps->p != '"') {
+        return NULL;
+    }
+    ps->p++;
+
+    size_t cap = 32, len = 0;
+    char *buf = malloc(cap);
+    if (!buf) {
+        return NULL;
+    }
+
+    while (*ps->p && *ps->p != '"') {
+        char c = *ps->p++;
+        if (c == '\\') {
+            char e = *ps->p++;
+            switch (e) {
+                case '"': c = '"'; break;
+                case '\\': c = '\\'; break;
+                case '/': c = '/'; break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'n': c = '\n'; break;
+                case 'r': c = '\r'; break;
+                case 't': c = '\t'; break;
+                case 'u': {
+                    unsigned code = 0;
+                    for (int i = 0; i < 4; i++) {
+                        if (!isxdigit((unsigned char)ps->p[i])) {
+                            free(buf);
+                            return NULL;
+                        }
+                    }
+                    sscanf(ps->p, "%4x", &code);
+                    ps->p += 4;
+                    c = code < 0x80 ? (char)code : '?';
+                    break;
+                }
+                default:
+                    free(buf);
+                    return NULL;
+            }
+        }
+
+        if (len + 1 >= cap) {
+            cap *= 2;
+            char *grown = realloc(buf, cap);
+            if (!grown) {
+                free(buf);
+                return NULL;
+            }
+            buf = grown;
+        }
+        buf[len++] = c;
+    }
+
+    if (*ps->p != '"') {
+        free(buf);
+        return NULL;
+    }
+    ps->p++;
+    buf[len] = '\0';
+    return buf;
+}
+
+static bool append_item(bench_json_value_t *container, size_t *cap,
+                        const bench_json_value_t *item, char *key) {
+    if (container->count == *cap) {
+        size_t new_cap = *cap ? *cap * 2 : 8;
+        bench_json_value_t *items = realloc(container->items, new_cap * sizeof(*items));
+        if (!items) {
+            return false;
+        }
+        container->items = items;
+        if (container->type == BENCH_JSON_OBJECT) {
+            char **keys = realloc(container->keys, new_cap * sizeof(*keys));
+            if (!keys) {
+                return false;
+            }
+            container->keys = keys;
+        }
+        *cap = new_cap;
+    }
+
+    container->items[container->count] = *item;
+    if (container->type == BENCH_JSON_OBJECT) {
+        container->keys[container->count] = key;
+    }
+    container->count++;
+    return true;
+}
+
+static bool parse_container(json_parser_t *ps, bench_json_value_t *out, bool object) {
+    char close = object ? '}' : ']';
+    size_t cap = 0;
+
+    if (++ps->depth > BENCH_JSON_MAX_DEPTH) {
+        return false;
+    }
+
+    out->type = object ? BENCH_JSON_OBJECT : BENCH_JSON_ARRAY;
+    ps->p++;
+    skip_ws(ps);
+    if (*ps->p == close) {
+        ps->p++;
+        ps->depth--;
+        return true;
+    }
+
+    while (1) {
+        char *key = NULL;
+        if (object) {
+            skip_ws(ps);
+            key = parse_string_raw(ps);
+            if (!key) {
+                return false;
+            }
+            skip_ws(ps);
+            if (*ps->p != ':') {
+                free(key);
+                return false;
+            }
+            ps->p++;
+        }
+
+        bench_json_value_t item;
+        memset(&item, 0, sizeof(item));
+        if (!parse_value(ps, &item) || !append_item(out, &cap, &item, key)) {
+            free_contents(&item);
+            free(key);
+            return false;
+        }
+
+        skip_ws(ps);
+        if (*ps->p == ',') {
+            ps->p++;
+            continue;
+        }
+        if (*ps->p == close) {
+            ps->p++;
+            ps->depth--;
+            return true;
+        }
+        return false;
+    }
+}
+
+static bool parse_value(json_parser_t *ps, bench_json_value_t *out) {
+    skip_ws(ps);
+
+    switch (*ps->p) {
+        case '{':
+            return parse_container(ps, out, true);
+        case '[':
+            return parse_container(ps, out, false);
+        case '"':
+            out->type = BENCH_JSON_STRING;
+            out->string = parse_string_raw(ps);
+            return out->string != NULL;
+        case 't':
+            if (strncmp(ps->p, "true", 4) == 0) {
+                out->type = BENCH_JSON_BOOL;
+                out->boolean = true;
+                ps->p += 4;
+                return true;
+            }
+            return false;
+        case 'f':
+            if (strncmp(ps->p, "false", 5) == 0) {
+                out->type = BENCH_JSON_BOOL;
+                out->boolean = false;
+                ps->p += 5;
+                return true;
+            }
+            return false;
+        case 'n':
+            if (strncmp(ps->p, "null", 4) == 0) {
+                out->type = BENCH_JSON_NULL;
+                ps->p += 4;
+                return true;
+            }
+            return false;
+        default: {
+            char *end = NULL;
+            double d = strtod(ps->p, &end);
+            if (end == ps->p) {
+                return false;
+            }
+            out->type = BENCH_JSON_NUMBER;
+            out->number = d;
+            ps->p = end;
+            return true;
+        }
+    }
+}
+
+bench_json_value_t* bench_json_parse(const char *text) {
+    if (!text) {
+        return NULL;
+    }
+
+    bench_json_value_t *root = calloc(1, sizeof(bench_json_value_t));
+    if (!root) {
+        return NULL;
+    }
+
+    json_parser_t ps = { .p = text, .depth = 0 };
+    if (!parse_value(&ps, root)) {
+        bench_json_free(root);
+        return NULL;
+    }
+
+    skip_ws(&ps);
+    if (*ps.p != '\0') {
+        bench_json_free(root);
+        return NULL;
+    }
+    return root;
+}
+
+bench_json_value_t* bench_json_parse_file(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return NULL;
+    }
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(f);
+        return NULL;
+    }
+
+    char *text = malloc((size_t)size + 1);
+    if (!text) {
+        fclose(f);
+        return NULL;
+    }
+
+    size_t read_bytes = fread(text, 1, (size_t)size, f);
+    fclose(f);
+    text[read_bytes] = '\0';
+
+    bench_json_value_t *root = bench_json_parse(text);
+    free(text);
+    return root;
+}
+
+void bench_json_free(bench_json_value_t *value) {
+    if (!value) {
+        return;
+    }
+    free_contents(value);
+    free(value);
+}
+
+const bench_json_value_t* bench_json_get(const bench_json_value_t *object, const char *key) {
+    if (!object || object->type != BENCH_JSON_OBJECT || !key) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < object->count; i++) {
+        if (strcmp(object->keys[i], key) == 0) {
+            return &object->items[i];
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file bench_json.h
+ * @brief Minimal JSON reader for benchmark reports and baselines
+ *
+ * Parses the JSON files written by the native benchmark tools into a small
+ * in-memory tree. Only what the tools need is supported: UTF-8 input,
+ * numbers as doubles, and \uXXXX escapes limited to the ASCII range.
+ */
+
+#ifndef BENCH_JSON_H
+#define BENCH_JSON_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief JSON value types
+ */
+typedef enum {
+    BENCH_JSON_NULL = 0,                /**< null */
+    BENCH_JSON_BOOL = 1,                /**< true / false */
+    BENCH_JSON_NUMBER = 2,              /**< Number (stored as double) */
+    BENCH_JSON_STRING = 3,              /**< String */
+    BENCH_JSON_ARRAY = 4,               /**< Array */
+    BENCH_JSON_OBJECT = 5               /**< Object */
+} bench_json_type_t;
+
+/**
+ * @brief Parsed JSON value
+ */
+typedef struct bench_json_value {
+    bench_json_type_t type;             /**< Value type */
+    bool boolean;                       /**< Value if BENCH_JSON_BOOL */
+    double number;                      /**< Value if BENCH_JSON_NUMBER */
+    char *string;                       /**< Value if BENCH_JSON_STRING */
+    struct bench_json_value *items;     /**< Elements (array) or member values (object) */
+    char **keys;                        /**< Member names (object only) */
+    size_t count;                       /**< Number of elements or members */
+} bench_json_value_t;
+
+/**
+ * @brief Parse a JSON document from a file
+ *
+ * @param[in] path File to read
+ * @return Parsed tree (free with bench_json_free()), or NULL on error
+ */
+bench_json_value_t* bench_json_parse_file(const char *path);
+
+/**
+ * @brief Parse a JSON document from memory
+ *
+ * @param[in] text NUL-terminated JSON text
+ * @return Parsed tree (free with bench_json_free()), or NULL on error
+ */
+bench_json_value_t* bench_json_parse(const char *text);
+
+/**
+ * @brief Free a tree returned by bench_json_parse*()
+ *
+ * @param[in] value Root value (may be NULL)
+ */
+void bench_json_free(bench_json_value_t *value);
+
+/**
+ * @brief Look up an object member
+ *
+ * @param[in] object Object value
+ * @param[in] key Member name
+ * @return Member value, or NULL if absent or object is not an object
+ */
+const bench_json_value_t* bench_json_get(const bench_json_value_t *object, const char *key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_JSON_H */
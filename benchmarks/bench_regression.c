@@ -0,0 +1,223 @@
+/**
+ * @file bench_regression.c
+ * @brief Statistical comparison of benchmark samples against a baseline
+ */
+
+#include "bench_regression.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef struct {
+    double value;
+    int group;                          /**< 0 = baseline, 1 = current */
+} ranked_sample_t;
+
+static int compare_ranked(const void *a, const void *b) {
+    double x = ((const ranked_sample_t *)a)->value;
+    double y = ((const ranked_sample_t *)b)->value;
+    return (x > y) - (x < y);
+}
+
+int bench_mann_whitney(const double *baseline, size_t n1,
+                       const double *current, size_t n2,
+                       bench_mann_whitney_t *result) {
+    if (!baseline || !current || !result || n1 == 0 || n2 == 0) {
+        return -1;
+    }
+
+    size_t n = n1 + n2;
+    ranked_sample_t *all = malloc(n * sizeof(ranked_sample_t));
+    if (!all) {
+        return -1;
+    }
+    for (size_t i = 0; i < n1; i++) {
+        all[i].value = baseline[i];
+        all[i].group = 0;
+    }
+    for (size_t i = 0; i < n2; i++) {
+        all[n1 + i].value = current[i];
+        all[n1 + i].group = 1;
+    }
+    qsort(all, n, sizeof(ranked_sample_t), compare_ranked);
+
+    // Average ranks over ties, accumulating the tie correction term
+    double rank_sum_current = 0.0;
+    double tie_term = 0.0;
+    size_t i = 0;
+    while (i < n) {
+        size_t j = i;
+        while (j + 1 < n && all[j + 1].value == all[i].value) {
+            j++;
+        }
+        double rank = ((double)i + (double)j) / 2.0 + 1.0;
+        double t = (double)(j - i + 1);
+        tie_term += t * t * t - t;
+        for (size_t k = i; k <= j; k++) {
+            if (all[k].group == 1) {
+                rank_sum_current += rank;
+            }
+        }
+        i = j + 1;
+    }
+    free(all);
+
+    double dn1 = (double)n1, dn2 = (double)n2, dn = (double)n;
+    double u = rank_sum_current - dn2 * (dn2 + 1.0) / 2.0;
+    double mean = dn1 * dn2 / 2.0;
+    double var = dn1 * dn2 / 12.0 * ((dn + 1.0) - tie_term / (dn * (dn - 1.0)));
+
+    result->u = u;
+    if (var <= 0.0) {
+        result->z = 0.0;
+        result->p_slower = 1.0;
+        result->p_faster = 1.0;
+        return 0;
+    }
+
+    // Continuity-corrected normal approximation, one-sided in each direction
+    double sd = sqrt(var);
+    result->z = (u - mean) / sd;
+    result->p_slower = 0.5 * erfc(((u - mean - 0.5) / sd) / sqrt(2.0));
+    result->p_faster = 0.5 * erfc((-(u - mean + 0.5) / sd) / sqrt(2.0));
+    return 0;
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double median_of(double *values, size_t count) {
+    qsort(values, count, sizeof(double), compare_double);
+    if (count % 2 == 1) {
+        return values[count / 2];
+    }
+    return (values[count / 2 - 1] + values[count / 2]) / 2.0;
+}
+
+const bench_json_value_t* bench_regression_find_operation(const bench_json_value_t *report,
+                                                          const char *name) {
+    const bench_json_value_t *ops = bench_json_get(report, "operations");
+    if (!ops || ops->type != BENCH_JSON_ARRAY) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < ops->count; i++) {
+        const bench_json_value_t *op_name = bench_json_get(&ops->items[i], "name");
+        if (op_name && op_name->type == BENCH_JSON_STRING && strcmp(op_name->string, name) == 0) {
+            return &ops->items[i];
+        }
+    }
+    return NULL;
+}
+
+int bench_regression_compare(const char *name, const uint64_t *current, size_t count,
+                             const bench_json_value_t *baseline_op, const char *samples_key,
+                             double threshold_pct, double alpha, bench_comparison_t *row) {
+    if (!name || !current || count == 0 || !row) {
+        return -1;
+    }
+
+    memset(row, 0, sizeof(*row));
+    row->name = name;
+    row->threshold_pct = threshold_pct;
+    row->p_value = 1.0;
+
+    double *cur = malloc(count * sizeof(double));
+    if (!cur) {
+        return -1;
+    }
+    for (size_t i = 0; i < count; i++) {
+        cur[i] = (double)current[i];
+    }
+
+    const bench_json_value_t *base_samples = baseline_op ? bench_json_get(baseline_op, samples_key) : NULL;
+    if (!baseline_op) {
+        row->verdict = BENCH_VERDICT_NO_BASELINE;
+    } else if (!base_samples || base_samples->type != BENCH_JSON_ARRAY || base_samples->count == 0) {
+        row->verdict = BENCH_VERDICT_NO_SAMPLES;
+    }
+
+    if (row->verdict != BENCH_VERDICT_OK) {
+        row->current_median = median_of(cur, count);
+        free(cur);
+        return 0;
+    }
+
+    size_t nbase = base_samples->count;
+    double *base = malloc(nbase * sizeof(double));
+    if (!base) {
+        free(cur);
+        return -1;
+    }
+    for (size_t i = 0; i < nbase; i++) {
+        base[i] = base_samples->items[i].type == BENCH_JSON_NUMBER ? base_samples->items[i].number : 0.0;
+    }
+
+    bench_mann_whitney_t mw;
+    int rc = bench_mann_whitney(base, nbase, cur, count, &mw);
+
+    row->baseline_median = median_of(base, nbase);
+    row->current_median = median_of(cur, count);
+    row->delta_pct = row->baseline_median > 0.0 ?
+        100.0 * (row->current_median - row->baseline_median) / row->baseline_median : 0.0;
+
+    if (rc == 0) {
+        if (row->delta_pct > 0.0) {
+            row->p_value = mw.p_slower;
+            if (row->delta_pct > threshold_pct && mw.p_slower < alpha) {
+                row->verdict = BENCH_VERDICT_REGRESSED;
+            }
+        } else {
+            row->p_value = mw.p_faster;
+            if (-row->delta_pct > threshold_pct && mw.p_faster < alpha) {
+                row->verdict = BENCH_VERDICT_IMPROVED;
+            }
+        }
+    }
+
+    free(base);
+    free(cur);
+    return rc;
+}
+
+double bench_regression_threshold(const bench_threshold_t *overrides, size_t count,
+                                  const char *name, double fallback) {
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(overrides[i].name, name) == 0) {
+            return overrides[i].threshold_pct;
+        }
+    }
+    return fallback;
+}
+
+const char* bench_verdict_to_string(bench_verdict_t verdict) {
+    switch (verdict) {
+        case BENCH_VERDICT_OK: return "ok";
+        case BENCH_VERDICT_IMPROVED: return "IMPROVED";
+        case BENCH_VERDICT_REGRESSED: return "REGRESSED";
+        case BENCH_VERDICT_NO_BASELINE: return "no-baseline";
+        case BENCH_VERDICT_NO_SAMPLES: return "no-samples";
+        default: return "unknown";
+    }
+}
+
+void bench_regression_print(FILE *out, const bench_comparison_t *rows, size_t count,
+                            const char *unit) {
+    fprintf(out, "\n%-30s %14s %14s %9s %10s %7s  %s\n", "operation",
+            "base_median", "cur_median", "delta", "p-value", "limit", "verdict");
+    for (size_t i = 0; i < count; i++) {
+        const bench_comparison_t *r = &rows[i];
+        if (r->verdict == BENCH_VERDICT_NO_BASELINE || r->verdict == BENCH_VERDICT_NO_SAMPLES) {
+            fprintf(out, "%-30s %14s %12.0f%-2s %9s %10s %6.1f%%  %s\n", r->name, "-",
+                    r->current_median, unit, "-", "-", r->threshold_pct,
+                    bench_verdict_to_string(r->verdict));
+            continue;
+        }
+        fprintf(out, "%-30s %12.0f%-2s %12.0f%-2s %+8.1f%% %10.2g %6.1f%%  %s\n", r->name,
+                r->baseline_median, unit, r->current_median, unit, r->delta_pct,
+                r->p_value, r->threshold_pct, bench_verdict_to_string(r->verdict));
+    }
+}
@@ -0,0 +1,144 @@
+/**
+ * @file bench_regression.h
+ * @brief Statistical comparison of benchmark samples against a baseline
+ *
+ * Compares per-iteration samples of the current run with those stored in a
+ * baseline report using a one-sided Mann-Whitney U test, so that a case is
+ * only reported as regressed when the slowdown is both larger than its
+ * threshold and statistically significant.
+ */
+
+#ifndef BENCH_REGRESSION_H
+#define BENCH_REGRESSION_H
+
+#include "bench_json.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BENCH_DEFAULT_THRESHOLD_PCT 5.0     /**< Default allowed median slowdown */
+#define BENCH_DEFAULT_ALPHA         0.01    /**< Default significance level */
+
+/**
+ * @brief Comparison outcome for one case
+ */
+typedef enum {
+    BENCH_VERDICT_OK = 0,               /**< No significant change beyond threshold */
+    BENCH_VERDICT_IMPROVED = 1,         /**< Significantly faster than baseline */
+    BENCH_VERDICT_REGRESSED = 2,        /**< Significantly slower than baseline */
+    BENCH_VERDICT_NO_BASELINE = 3,      /**< Case missing from baseline */
+    BENCH_VERDICT_NO_SAMPLES = 4        /**< Baseline has no per-iteration samples */
+} bench_verdict_t;
+
+/**
+ * @brief Mann-Whitney U test result
+ */
+typedef struct {
+    double u;                           /**< U statistic of the current sample */
+    double z;                           /**< Normal approximation (tie corrected) */
+    double p_slower;                    /**< One-sided p: current stochastically larger */
+    double p_faster;                    /**< One-sided p: current stochastically smaller */
+} bench_mann_whitney_t;
+
+/**
+ * @brief Per-case comparison row
+ */
+typedef struct {
+    const char *name;                   /**< Case name */
+    double baseline_median;             /**< Baseline median */
+    double current_median;              /**< Current median */
+    double delta_pct;                   /**< Median change in percent */
+    double p_value;                     /**< p-value for the direction of change */
+    double threshold_pct;               /**< Threshold applied to this case */
+    bench_verdict_t verdict;            /**< Outcome */
+} bench_comparison_t;
+
+/**
+ * @brief Per-case threshold override
+ */
+typedef struct {
+    const char *name;                   /**< Case name (exact match) */
+    double threshold_pct;               /**< Allowed median slowdown in percent */
+} bench_threshold_t;
+
+/**
+ * @brief Run a Mann-Whitney U test
+ *
+ * @param[in] baseline Baseline samples
+ * @param[in] n1 Number of baseline samples
+ * @param[in] current Current samples
+ * @param[in] n2 Number of current samples
+ * @param[out] result Test result
+ * @return 0 on success, -1 on failure
+ */
+int bench_mann_whitney(const double *baseline, size_t n1,
+                       const double *current, size_t n2,
+                       bench_mann_whitney_t *result);
+
+/**
+ * @brief Find an operation entry by name in a parsed report
+ *
+ * @param[in] report Parsed benchmark report
+ * @param[in] name Case name
+ * @return Operation object, or NULL if not found
+ */
+const bench_json_value_t* bench_regression_find_operation(const bench_json_value_t *report,
+                                                          const char *name);
+
+/**
+ * @brief Compare one case against its baseline entry
+ *
+ * @param[in] name Case name
+ * @param[in] current Current per-iteration samples
+ * @param[in] count Number of current samples
+ * @param[in] baseline_op Baseline operation object (may be NULL)
+ * @param[in] samples_key Baseline member holding the samples (e.g. "samples_ns")
+ * @param[in] threshold_pct Allowed median slowdown in percent
+ * @param[in] alpha Significance level
+ * @param[out] row Comparison result
+ * @return 0 on success, -1 on failure
+ */
+int bench_regression_compare(const char *name, const uint64_t *current, size_t count,
+                             const bench_json_value_t *baseline_op, const char *samples_key,
+                             double threshold_pct, double alpha, bench_comparison_t *row);
+
+/**
+ * @brief Resolve the threshold for a case
+ *
+ * @param[in] overrides Per-case overrides
+ * @param[in] count Number of overrides
+ * @param[in] name Case name
+ * @param[in] fallback Default threshold
+ * @return Threshold in percent
+ */
+double bench_regression_threshold(const bench_threshold_t *overrides, size_t count,
+                                  const char *name, double fallback);
+
+/**
+ * @brief Print the comparison as a diff table
+ *
+ * @param[in] out Output stream
+ * @param[in] rows Comparison rows
+ * @param[in] count Number of rows
+ * @param[in] unit Unit label for medians (e.g. "ns")
+ */
+void bench_regression_print(FILE *out, const bench_comparison_t *rows, size_t count,
+                            const char *unit);
+
+/**
+ * @brief Convert a verdict to a short label
+ *
+ * @param[in] verdict Verdict
+ * @return Label (e.g. "REGRESSED")
+ */
+const char* bench_verdict_to_string(bench_verdict_t verdict);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_REGRESSION_H */
@@ -0,0 +1,1214 @@
+/**
+ * @file benchmark_runner.c
+ * @brief Native benchmark runner for the PQC primitives
+ *
+ * Measures every public primitive (Kyber-1024, Dilithium-5, Falcon-512/1024,
+ * SPHINCS+-SHA256-128f/256f, HSS/LMS, SHA-2/SHA-3/SHAKE, key/ciphertext packing, secure
+ * memory operations and the attestation report path) on a pinned core
+ * after a warmup phase, and writes per-operation cycle and nanosecond
+ * statistics and median ops/sec in the benchmark_report.json format used under
+ * benchmarks/results/. Per-iteration samples are kept in the report so a
+ * later run can be compared against it with --baseline; the run fails with
+ * exit code 3 when any case is significantly slower than its threshold.
+ * With --counters, hardware performance counters (instructions, IPC, cache,
+ * branch and dTLB misses) are collected per operation, and per phase when
+ * the library is built with PQC_ENABLE_PERF_COUNTERS. When the library is
+ * built with PQC_ENABLE_BYTE_ACCOUNTING, the bytes copied, zeroed, hashed
+ * and allocated per call are reported for each case and for every library
+ * API it calls. With --profile, the cases run under the sampling profiler
+ * and its folded stacks, tagged by operation and phase when the library is
+ * built with PQC_ENABLE_PROFILING, are written for flamegraph tools.
+ *
+ * Usage: benchmark_runner [--iterations N] [--warmup N] [--cpu N]
+ *                         [--filter SUBSTR] [--output FILE] [--list]
+ *                         [--baseline FILE] [--save-baseline FILE]
+ *                         [--threshold NAME=PCT]... [--default-threshold PCT]
+ *                         [--alpha P] [--metric ns|cycles] [--counters]
+ *                         [--profile FILE] [--profile-hz N]
+ */
+
+#define _GNU_SOURCE
+
+#include "bench_common.h"
+#include "bench_regression.h"
+#include "../src/crypto/pqc_common.h"
+#include "../src/crypto/pqc_perf.h"
+#include "../src/crypto/pqc_bytes.h"
+#include "../src/crypto/pqc_profile.h"
+#include "../src/crypto/kyber.h"
+#include "../src/crypto/dilithium.h"
+#include "../src/crypto/falcon.h"
+#include "../src/crypto/sphincs.h"
+#include "../src/crypto/lms.h"
+#include "../src/crypto/sha2.h"
+#include "../src/crypto/secure_memory.h"
+#include "../src/attestation/attestation_engine.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+
+#define BENCH_MESSAGE_BYTES     32      /**< Signed message size (report digest) */
+#define BENCH_HASH_BYTES        1024    /**< Hash input size */
+#define BENCH_SHAKE_OUT_BYTES   672     /**< SHAKE output size (one Kyber row) */
+#define BENCH_HSS_SIG_BYTES     8192    /**< Room for the benchmark HSS signature */
+#define BENCH_MEMORY_BYTES      4096    /**< Secure memory operation size */
+#define BENCH_MAX_THRESHOLDS    32      /**< Per-case --threshold overrides */
+
+// ============================================================================
+// Benchmark Context
+// ============================================================================
+
+/**
+ * @brief Inputs and outputs shared by all benchmark cases
+ *
+ * Kept on the heap: the key and signature structures are far too large
+ * to live on the benchmark thread's stack next to the primitives' own
+ * working buffers.
+ */
+typedef struct {
+    kyber_public_key_t kyber_pk;
+    kyber_secret_key_t kyber_sk;
+    kyber_ciphertext_t kyber_ct;
+    uint8_t kyber_ss[KYBER_SSBYTES];
+    dilithium_public_key_t dilithium_pk;
+    dilithium_secret_key_t dilithium_sk;
+    uint8_t dilithium_sig[DILITHIUM_SIGNATUREBYTES];
+    size_t dilithium_siglen;
+    uint8_t falcon512_pk[FALCON_512_PUBLICKEYBYTES];
+    uint8_t falcon512_sk[FALCON_512_SECRETKEYBYTES];
+    uint8_t falcon512_sig[FALCON_512_SIGNATUREBYTES];
+    size_t falcon512_siglen;
+    uint8_t falcon1024_pk[FALCON_1024_PUBLICKEYBYTES];
+    uint8_t falcon1024_sk[FALCON_1024_SECRETKEYBYTES];
+    uint8_t falcon1024_sig[FALCON_1024_SIGNATUREBYTES];
+    size_t falcon1024_siglen;
+    uint8_t sphincs128_pk[SPHINCS_SHA256_128F_PUBLICKEYBYTES];
+    uint8_t sphincs128_sk[SPHINCS_SHA256_128F_SECRETKEYBYTES];
+    uint8_t sphincs128_sig[SPHINCS_SHA256_128F_SIGNATUREBYTES];
+    size_t sphincs128_siglen;
+    uint8_t sphincs256_pk[SPHINCS_SHA256_256F_PUBLICKEYBYTES];
+    uint8_t sphincs256_sk[SPHINCS_SHA256_256F_SECRETKEYBYTES];
+    uint8_t sphincs256_sig[SPHINCS_SHA256_256F_SIGNATUREBYTES];
+    size_t sphincs256_siglen;
+    uint8_t hss_pk[HSS_PUBLICKEYBYTES];
+    uint8_t hss_sk[HSS_SECRETKEYBYTES];
+    uint8_t hss_sig[BENCH_HSS_SIG_BYTES];
+    size_t hss_siglen;
+    uint8_t hss_nv[HSS_NV_RECORD_BYTES];
+    hss_signer_t *hss_signer;
+    uint8_t message[BENCH_MESSAGE_BYTES];
+    uint8_t hash_input[BENCH_HASH_BYTES];
+    uint8_t hash_output[BENCH_SHAKE_OUT_BYTES];
+    uint8_t mem_a[BENCH_MEMORY_BYTES];
+    uint8_t mem_b[BENCH_MEMORY_BYTES];
+    attestation_report_t report;
+    attestation_verification_result_t verification;
+    device_certificate_t certificate;
+    measurement_log_t measurement_log;
+    uint8_t pcr_values[MAX_PCR_REGISTERS][32];
+#ifdef PQC_ENABLE_TESTING
+    uint16_t kyber_u[4 * 256];
+    uint16_t kyber_v[256];
+    uint32_t dilithium_t1[8 * 256];
+#endif
+} bench_context_t;
+
+typedef pqc_result_t (*bench_op_fn)(bench_context_t *ctx);
+
+/**
+ * @brief Benchmark case descriptor
+ */
+typedef struct {
+    const char *name;                   /**< Case name, "<primitive>.<operation>" */
+    const char *group;                  /**< kem, signature, hash, packing, memory, attestation */
+    bench_op_fn run;                    /**< Operation under test */
+    size_t bytes;                       /**< Bytes processed per call (0 if n/a) */
+} bench_case_t;
+
+/**
+ * @brief Result of one benchmark case
+ */
+typedef struct {
+    const bench_case_t *bench;          /**< Case descriptor */
+    pqc_result_t status;                /**< First failure, or PQC_SUCCESS */
+    bench_samples_t samples;            /**< Per-iteration samples */
+    bench_stats_t cycles;               /**< Cycle statistics */
+    bench_stats_t ns;                   /**< Nanosecond statistics */
+    uint64_t counters[PQC_PERF_COUNTER_COUNT]; /**< Counter totals over all iterations */
+    uint32_t counter_mask;              /**< Valid counters, 0 if not collected */
+    pqc_perf_counters_t phases[PQC_PERF_PHASE_COUNT]; /**< Library phase totals */
+    pqc_bytes_scope_t bytes[PQC_BYTES_MAX_SCOPES]; /**< Case and library API scopes */
+    size_t bytes_count;                 /**< Scopes entered, 0 without byte accounting */
+} bench_case_result_t;
+
+/**
+ * @brief Runner options
+ */
+typedef struct {
+    size_t iterations;
+    size_t warmup;
+    int cpu;
+    const char *filter;
+    const char *output;
+    bool list_only;
+    const char *baseline;               /**< Baseline report to compare against */
+    const char *save_baseline;          /**< Also write the report here */
+    bench_threshold_t thresholds[BENCH_MAX_THRESHOLDS];
+    size_t threshold_count;
+    double default_threshold;           /**< Percent */
+    double alpha;                       /**< Significance level */
+    bool compare_cycles;                /**< Compare cycles instead of ns */
+    bool counters;                      /**< Collect hardware counters */
+    const char *profile;                /**< Folded stack output, NULL to disable */
+    unsigned profile_hz;                /**< Profiler sampling rate */
+} bench_options_t;
+
+// ============================================================================
+// Operations
+// ============================================================================
+
+static pqc_result_t op_kyber_keypair(bench_context_t *ctx) {
+    return kyber_keypair(&ctx->kyber_pk, &ctx->kyber_sk);
+}
+
+static pqc_result_t op_kyber_encaps(bench_context_t *ctx) {
+    memset(&ctx->kyber_ct, 0, sizeof(ctx->kyber_ct));
+    return kyber_encapsulate(&ctx->kyber_ct, ctx->kyber_ss, &ctx->kyber_pk);
+}
+
+static pqc_result_t op_kyber_decaps(bench_context_t *ctx) {
+    return kyber_decapsulate(ctx->kyber_ss, &ctx->kyber_ct, &ctx->kyber_sk);
+}
+
+static pqc_result_t op_dilithium_keypair(bench_context_t *ctx) {
+    memset(&ctx->dilithium_pk, 0, sizeof(ctx->dilithium_pk));
+    return dilithium_keypair(&ctx->dilithium_pk, &ctx->dilithium_sk);
+}
+
+static pqc_result_t op_dilithium_sign(bench_context_t *ctx) {
+    return dilithium_sign(ctx->dilithium_sig, &ctx->dilithium_siglen,
+                          ctx->message, sizeof(ctx->message),
+                          &ctx->dilithium_sk);
+}
+
+static pqc_result_t op_dilithium_verify(bench_context_t *ctx) {
+    return dilithium_verify(ctx->dilithium_sig, ctx->dilithium_siglen,
+                            ctx->message, sizeof(ctx->message),
+                            &ctx->dilithium_pk);
+}
+
+static pqc_result_t op_falcon512_keypair(bench_context_t *ctx) {
+    return falcon_keypair(PQC_ALG_FALCON_512, ctx->falcon512_pk, ctx->falcon512_sk);
+}
+
+static pqc_result_t op_falcon512_sign(bench_context_t *ctx) {
+    return falcon_sign(ctx->falcon512_sig, &ctx->falcon512_siglen,
+                       ctx->message, sizeof(ctx->message),
+                       ctx->falcon512_sk, sizeof(ctx->falcon512_sk));
+}
+
+static pqc_result_t op_falcon512_verify(bench_context_t *ctx) {
+    return falcon_verify(ctx->falcon512_sig, ctx->falcon512_siglen,
+                         ctx->message, sizeof(ctx->message),
+                         ctx->falcon512_pk, sizeof(ctx->falcon512_pk));
+}
+
+static pqc_result_t op_falcon1024_keypair(bench_context_t *ctx) {
+    return falcon_keypair(PQC_ALG_FALCON_1024, ctx->falcon1024_pk, ctx->falcon1024_sk);
+}
+
+static pqc_result_t op_falcon1024_sign(bench_context_t *ctx) {
+    return falcon_sign(ctx->falcon1024_sig, &ctx->falcon1024_siglen,
+                       ctx->message, sizeof(ctx->message),
+                       ctx->falcon1024_sk, sizeof(ctx->falcon1024_sk));
+}
+
+static pqc_result_t op_falcon1024_verify(bench_context_t *ctx) {
+    return falcon_verify(ctx->falcon1024_sig, ctx->falcon1024_siglen,
+                         ctx->message, sizeof(ctx->message),
+                         ctx->falcon1024_pk, sizeof(ctx->falcon1024_pk));
+}
+
+static pqc_result_t op_sphincs128_keypair(bench_context_t *ctx) {
+    return sphincs_keypair(PQC_ALG_SPHINCS_SHA256_128F, ctx->sphincs128_pk, ctx->sphincs128_sk);
+}
+
+static pqc_result_t op_sphincs128_sign(bench_context_t *ctx) {
+    return sphincs_sign(ctx->sphincs128_sig, &ctx->sphincs128_siglen,
+                        ctx->message, sizeof(ctx->message),
+                        ctx->sphincs128_sk, sizeof(ctx->sphincs128_sk));
+}
+
+static pqc_result_t op_sphincs128_verify(bench_context_t *ctx) {
+    return sphincs_verify(ctx->sphincs128_sig, ctx->sphincs128_siglen,
+                          ctx->message, sizeof(ctx->message),
+                          ctx->sphincs128_pk, sizeof(ctx->sphincs128_pk));
+}
+
+static pqc_result_t op_sphincs256_keypair(bench_context_t *ctx) {
+    return sphincs_keypair(PQC_ALG_SPHINCS_SHA256_256F, ctx->sphincs256_pk, ctx->sphincs256_sk);
+}
+
+static pqc_result_t op_sphincs256_sign(bench_context_t *ctx) {
+    return sphincs_sign(ctx->sphincs256_sig, &ctx->sphincs256_siglen,
+                        ctx->message, sizeof(ctx->message),
+                        ctx->sphincs256_sk, sizeof(ctx->sphincs256_sk));
+}
+
+static pqc_result_t op_sphincs256_verify(bench_context_t *ctx) {
+    return sphincs_verify(ctx->sphincs256_sig, ctx->sphincs256_siglen,
+                          ctx->message, sizeof(ctx->message),
+                          ctx->sphincs256_pk, sizeof(ctx->sphincs256_pk));
+}
+
+static pqc_result_t op_hss_sign(bench_context_t *ctx) {
+    return hss_sign(ctx->hss_signer, ctx->hss_sig, &ctx->hss_siglen,
+                    ctx->message, sizeof(ctx->message));
+}
+
+static pqc_result_t op_hss_verify(bench_context_t *ctx) {
+    return hss_verify(ctx->hss_sig, ctx->hss_siglen, ctx->message, sizeof(ctx->message),
+                      ctx->hss_pk, sizeof(ctx->hss_pk));
+}
+
+static pqc_result_t op_sha256(bench_context_t *ctx) {
+    return sha256(ctx->hash_output, ctx->hash_input, sizeof(ctx->hash_input));
+}
+
+static pqc_result_t op_sha3_256(bench_context_t *ctx) {
+    return sha3_256(ctx->hash_output, ctx->hash_input, sizeof(ctx->hash_input));
+}
+
+static pqc_result_t op_sha3_512(bench_context_t *ctx) {
+    return sha3_512(ctx->hash_output, ctx->hash_input, sizeof(ctx->hash_input));
+}
+
+static pqc_result_t op_shake128(bench_context_t *ctx) {
+    return shake128(ctx->hash_output, BENCH_SHAKE_OUT_BYTES, ctx->hash_input, 34);
+}
+
+static pqc_result_t op_shake256(bench_context_t *ctx) {
+    return shake256(ctx->hash_output, BENCH_SHAKE_OUT_BYTES, ctx->hash_input, 32,
+                    ctx->hash_input + 32, 2);
+}
+
+#ifdef PQC_ENABLE_TESTING
+static pqc_result_t op_kyber_pack_pk(bench_context_t *ctx) {
+    memset(ctx->kyber_pk.t, 0, sizeof(ctx->kyber_pk.t));
+    kyber_pack_public_key(&ctx->kyber_pk, ctx->kyber_u, ctx->kyber_pk.seed);
+    return PQC_SUCCESS;
+}
+
+static pqc_result_t op_kyber_unpack_pk(bench_context_t *ctx) {
+    kyber_unpack_public_key(ctx->kyber_u, &ctx->kyber_pk);
+    return PQC_SUCCESS;
+}
+
+static pqc_result_t op_kyber_pack_ct(bench_context_t *ctx) {
+    memset(&ctx->kyber_ct, 0, sizeof(ctx->kyber_ct));
+    kyber_pack_ciphertext(&ctx->kyber_ct, ctx->kyber_u, ctx->kyber_v);
+    return PQC_SUCCESS;
+}
+
+static pqc_result_t op_kyber_unpack_ct(bench_context_t *ctx) {
+    kyber_unpack_ciphertext(ctx->kyber_u, ctx->kyber_v, &ctx->kyber_ct);
+    return PQC_SUCCESS;
+}
+
+static pqc_result_t op_dilithium_pack_pk(bench_context_t *ctx) {
+    memset(ctx->dilithium_pk.t1, 0, sizeof(ctx->dilithium_pk.t1));
+    dilithium_pack_public_key(&ctx->dilithium_pk, ctx->dilithium_t1, ctx->dilithium_pk.rho);
+    return PQC_SUCCESS;
+}
+
+static pqc_result_t op_dilithium_unpack_pk(bench_context_t *ctx) {
+    dilithium_unpack_public_key(ctx->dilithium_t1, &ctx->dilithium_pk);
+    return PQC_SUCCESS;
+}
+#endif
+
+static pqc_result_t op_secure_memcmp(bench_context_t *ctx) {
+    volatile int r = secure_memcmp(ctx->mem_a, ctx->mem_b, BENCH_MEMORY_BYTES);
+    (void)r;
+    return PQC_SUCCESS;
+}
+
+static pqc_result_t op_secure_memzero(bench_context_t *ctx) {
+    secure_memzero(ctx->mem_b, BENCH_MEMORY_BYTES);
+    return PQC_SUCCESS;
+}
+
+static pqc_result_t op_secure_memcpy(bench_context_t *ctx) {
+    secure_memcpy(ctx->mem_b, ctx->mem_a, BENCH_MEMORY_BYTES);
+    return PQC_SUCCESS;
+}
+
+static pqc_result_t op_secure_memcpy_conditional(bench_context_t *ctx) {
+    secure_memcpy_conditional(ctx->mem_b, ctx->mem_a, BENCH_MEMORY_BYTES, 1);
+    return PQC_SUCCESS;
+}
+
+static pqc_result_t op_attestation_generate(bench_context_t *ctx) {
+    return attestation_generate_report(&ctx->report);
+}
+
+static pqc_result_t op_attestation_verify(bench_context_t *ctx) {
+    pqc_result_t result = attestation_verify_report(&ctx->report, &ctx->certificate.public_key,
+                                                    &ctx->verification);
+    if (result == PQC_SUCCESS && !ctx->verification.is_valid) {
+        return PQC_ERROR_INVALID_SIGNATURE;
+    }
+    return result;
+}
+
+static pqc_result_t op_attestation_certificate(bench_context_t *ctx) {
+    return attestation_get_device_certificate(&ctx->certificate);
+}
+
+static pqc_result_t op_attestation_measurement_log(bench_context_t *ctx) {
+    return attestation_get_measurement_log(&ctx->measurement_log);
+}
+
+static pqc_result_t op_attestation_pcr_values(bench_context_t *ctx) {
+    return attestation_get_pcr_values(ctx->pcr_values);
+}
+
+/*
+ * Order matters: each keypair case runs before the cases that consume its
+ * output, so encaps/decaps and sign/verify always see a consistent key.
+ */
+static const bench_case_t g_cases[] = {
+    { "kyber_1024.keypair",          "kem",       op_kyber_keypair,              0 },
+    { "kyber_1024.encaps",           "kem",       op_kyber_encaps,               0 },
+    { "kyber_1024.decaps",           "kem",       op_kyber_decaps,               0 },
+    { "dilithium_5.keypair",         "signature", op_dilithium_keypair,          0 },
+    { "dilithium_5.sign",            "signature", op_dilithium_sign,             BENCH_MESSAGE_BYTES },
+    { "dilithium_5.verify",          "signature", op_dilithium_verify,           BENCH_MESSAGE_BYTES },
+    { "falcon_512.keypair",          "signature", op_falcon512_keypair,          0 },
+    { "falcon_512.sign",             "signature", op_falcon512_sign,             BENCH_MESSAGE_BYTES },
+    { "falcon_512.verify",           "signature", op_falcon512_verify,           BENCH_MESSAGE_BYTES },
+    { "falcon_1024.keypair",         "signature", op_falcon1024_keypair,         0 },
+    { "falcon_1024.sign",            "signature", op_falcon1024_sign,            BENCH_MESSAGE_BYTES },
+    { "falcon_1024.verify",          "signature", op_falcon1024_verify,          BENCH_MESSAGE_BYTES },
+    { "sphincs_sha256_128f.keypair", "signature", op_sphincs128_keypair,         0 },
+    { "sphincs_sha256_128f.sign",    "signature", op_sphincs128_sign,            BENCH_MESSAGE_BYTES },
+    { "sphincs_sha256_128f.verify",  "signature", op_sphincs128_verify,          BENCH_MESSAGE_BYTES },
+    { "sphincs_sha256_256f.keypair", "signature", op_sphincs256_keypair,         0 },
+    { "sphincs_sha256_256f.sign",    "signature", op_sphincs256_sign,            BENCH_MESSAGE_BYTES },
+    { "sphincs_sha256_256f.verify",  "signature", op_sphincs256_verify,          BENCH_MESSAGE_BYTES },
+    { "hss_lms.sign",                "signature", op_hss_sign,                   BENCH_MESSAGE_BYTES },
+    { "hss_lms.verify",              "signature", op_hss_verify,                 BENCH_MESSAGE_BYTES },
+    { "sha256.1k",                   "hash",      op_sha256,                     BENCH_HASH_BYTES },
+    { "sha3_256.1k",                 "hash",      op_sha3_256,                   BENCH_HASH_BYTES },
+    { "sha3_512.1k",                 "hash",      op_sha3_512,                   BENCH_HASH_BYTES },
+    { "shake128.xof672",             "hash",      op_shake128,                   BENCH_SHAKE_OUT_BYTES },
+    { "shake256.xof672",             "hash",      op_shake256,                   BENCH_SHAKE_OUT_BYTES },
+#ifdef PQC_ENABLE_TESTING
+    { "kyber_1024.pack_pk",          "packing",   op_kyber_pack_pk,              KYBER_PUBLICKEYBYTES },
+    { "kyber_1024.unpack_pk",        "packing",   op_kyber_unpack_pk,            KYBER_PUBLICKEYBYTES },
+    { "kyber_1024.pack_ct",          "packing",   op_kyber_pack_ct,              KYBER_CIPHERTEXTBYTES },
+    { "kyber_1024.unpack_ct",        "packing",   op_kyber_unpack_ct,            KYBER_CIPHERTEXTBYTES },
+    { "dilithium_5.pack_pk",         "packing",   op_dilithium_pack_pk,          DILITHIUM_PUBLICKEYBYTES },
+    { "dilithium_5.unpack_pk",       "packing",   op_dilithium_unpack_pk,        DILITHIUM_PUBLICKEYBYTES },
+#endif
+    { "secure_memcmp.4k",            "memory",    op_secure_memcmp,              BENCH_MEMORY_BYTES },
+    { "secure_memzero.4k",           "memory",    op_secure_memzero,             BENCH_MEMORY_BYTES },
+    { "secure_memcpy.4k",            "memory",    op_secure_memcpy,              BENCH_MEMORY_BYTES },
+    { "secure_memcpy_conditional.4k", "memory",   op_secure_memcpy_conditional,  BENCH_MEMORY_BYTES },
+    { "attestation.generate_report",  "attestation", op_attestation_generate,   sizeof(attestation_report_t) },
+    { "attestation.verify_report",    "attestation", op_attestation_verify,     sizeof(attestation_report_t) },
+    { "attestation.get_certificate",  "attestation", op_attestation_certificate, sizeof(device_certificate_t) },
+    { "attestation.get_measurement_log", "attestation", op_attestation_measurement_log,
+      sizeof(measurement_log_t) },
+    { "attestation.get_pcr_values",   "attestation", op_attestation_pcr_values,
+      MAX_PCR_REGISTERS * 32 },
+};
+
+#define BENCH_CASE_COUNT (sizeof(g_cases) / sizeof(g_cases[0]))
+
+// ============================================================================
+// Measurement
+// ============================================================================
+
+static pqc_result_t run_case(bench_context_t *ctx, const bench_options_t *opts,
+                             bench_case_result_t *result) {
+    const bench_case_t *bench = result->bench;
+
+    for (size_t i = 0; i < opts->warmup; i++) {
+        pqc_result_t status = bench->run(ctx);
+        if (status != PQC_SUCCESS) {
+            return status;
+        }
+    }
+
+    if (bench_samples_init(&result->samples, opts->iterations) != 0) {
+        return PQC_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    uint32_t mask = opts->counters ? pqc_perf_valid_mask() : 0;
+    if (mask) {
+        pqc_reset_performance_stats();
+    }
+    bool bytes = pqc_bytes_enabled();
+    if (bytes) {
+        pqc_bytes_reset();
+    }
+
+    for (size_t i = 0; i < opts->iterations; i++) {
+        uint64_t before[PQC_PERF_COUNTER_COUNT], after[PQC_PERF_COUNTER_COUNT];
+
+        // Counter reads are syscalls: keep them outside the timed window
+        if (mask) {
+            pqc_perf_read(before);
+        }
+        // The case itself is a scope, so bytes outside library scopes count too
+        int scope = bytes ? pqc_bytes_scope_begin(bench->name) : 0;
+        uint64_t t0 = bench_now_ns();
+        uint64_t c0 = bench_cycles();
+        pqc_result_t status = bench->run(ctx);
+        uint64_t c1 = bench_cycles();
+        uint64_t t1 = bench_now_ns();
+        if (bytes) {
+            pqc_bytes_scope_end(&scope);
+        }
+        if (mask) {
+            pqc_perf_read(after);
+            for (int k = 0; k < PQC_PERF_COUNTER_COUNT; k++) {
+                result->counters[k] += after[k] - before[k];
+            }
+        }
+
+        if (status != PQC_SUCCESS) {
+            return status;
+        }
+        bench_samples_push(&result->samples, c1 - c0, t1 - t0);
+    }
+
+    if (mask) {
+        pqc_performance_stats_t stats;
+        pqc_get_performance_stats(&stats);
+        memcpy(result->phases, stats.phase_counters, sizeof(result->phases));
+        result->counter_mask = mask;
+    }
+    if (bytes) {
+        result->bytes_count = pqc_bytes_get_scopes(result->bytes, PQC_BYTES_MAX_SCOPES);
+    }
+
+    bench_compute_stats(result->samples.cycles, result->samples.count, &result->cycles);
+    bench_compute_stats(result->samples.ns, result->samples.count, &result->ns);
+    return PQC_SUCCESS;
+}
+
+static bool case_selected(const bench_case_t *bench, const char *filter) {
+    return !filter || strstr(bench->name, filter) || strcmp(bench->group, filter) == 0;
+}
+
+static const bench_case_result_t* find_result(const bench_case_result_t *results,
+                                              size_t count, const char *name) {
+    for (size_t i = 0; i < count; i++) {
+        if (results[i].status == PQC_SUCCESS && results[i].samples.count > 0 &&
+            strcmp(results[i].bench->name, name) == 0) {
+            return &results[i];
+        }
+    }
+    return NULL;
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+static void print_table(const bench_case_result_t *results, size_t count) {
+    printf("%-30s %12s %12s %12s %12s %10s\n",
+           "operation", "median_cyc", "p99_cyc", "median_ns", "p99_ns", "stddev%");
+    for (size_t i = 0; i < count; i++) {
+        const bench_case_result_t *r = &results[i];
+        if (r->status != PQC_SUCCESS) {
+            printf("%-30s FAILED: %s\n", r->bench->name, pqc_result_to_string(r->status));
+            continue;
+        }
+        double rel = r->ns.mean > 0.0 ? 100.0 * r->ns.stddev / r->ns.mean : 0.0;
+        printf("%-30s %12.0f %12.0f %12.0f %12.0f %9.1f%%\n", r->bench->name,
+               r->cycles.median, r->cycles.p99, r->ns.median, r->ns.p99, rel);
+    }
+}
+
+static double per_op(uint64_t total, size_t iterations) {
+    return iterations ? (double)total / (double)iterations : 0.0;
+}
+
+static bool counter_valid(uint32_t mask, pqc_perf_counter_t counter) {
+    return (mask & (1u << counter)) != 0;
+}
+
+static void print_counters(const bench_case_result_t *results, size_t count) {
+    printf("\n%-30s %12s %6s %10s %10s %10s %10s\n",
+           "operation", "instr/op", "IPC", "L1D/op", "LLC/op", "brmiss/op", "dTLB/op");
+    for (size_t i = 0; i < count; i++) {
+        const bench_case_result_t *r = &results[i];
+        if (r->status != PQC_SUCCESS || !r->counter_mask) {
+            continue;
+        }
+
+        size_t n = r->samples.count;
+        printf("%-30s", r->bench->name);
+        if (counter_valid(r->counter_mask, PQC_PERF_COUNTER_INSTRUCTIONS)) {
+            printf(" %12.0f", per_op(r->counters[PQC_PERF_COUNTER_INSTRUCTIONS], n));
+        } else {
+            printf(" %12s", "-");
+        }
+        if (counter_valid(r->counter_mask, PQC_PERF_COUNTER_INSTRUCTIONS) &&
+            counter_valid(r->counter_mask, PQC_PERF_COUNTER_CYCLES) &&
+            r->counters[PQC_PERF_COUNTER_CYCLES] > 0) {
+            printf(" %6.2f", (double)r->counters[PQC_PERF_COUNTER_INSTRUCTIONS] /
+                             (double)r->counters[PQC_PERF_COUNTER_CYCLES]);
+        } else {
+            printf(" %6s", "-");
+        }
+        for (int k = PQC_PERF_COUNTER_L1D_MISSES; k < PQC_PERF_COUNTER_COUNT; k++) {
+            if (counter_valid(r->counter_mask, (pqc_perf_counter_t)k)) {
+                printf(" %10.1f", per_op(r->counters[k], n));
+            } else {
+                printf(" %10s", "-");
+            }
+        }
+        printf("\n");
+    }
+}
+
+/**
+ * @brief Write per-operation counter averages, or null for missing counters
+ */
+static void write_counter_object(FILE *out, const uint64_t values[PQC_PERF_COUNTER_COUNT],
+                                 uint32_t mask, size_t divisor) {
+    fprintf(out, "{");
+    for (int k = 0; k < PQC_PERF_COUNTER_COUNT; k++) {
+        fprintf(out, "%s\"%s\": ", k ? ", " : "", pqc_perf_counter_name((pqc_perf_counter_t)k));
+        if (counter_valid(mask, (pqc_perf_counter_t)k)) {
+            fprintf(out, "%.1f", per_op(values[k], divisor));
+        } else {
+            fprintf(out, "null");
+        }
+    }
+    if (counter_valid(mask, PQC_PERF_COUNTER_INSTRUCTIONS) &&
+        counter_valid(mask, PQC_PERF_COUNTER_CYCLES) && values[PQC_PERF_COUNTER_CYCLES] > 0) {
+        fprintf(out, ", \"ipc\": %.3f", (double)values[PQC_PERF_COUNTER_INSTRUCTIONS] /
+                                         (double)values[PQC_PERF_COUNTER_CYCLES]);
+    } else {
+        fprintf(out, ", \"ipc\": null");
+    }
+    fprintf(out, "}");
+}
+
+static void write_counters(FILE *out, const bench_case_result_t *r) {
+    size_t n = r->samples.count;
+
+    fprintf(out, ", \"counters\": ");
+    write_counter_object(out, r->counters, r->counter_mask, n);
+
+    // Phase counters are normalised per operation, like the totals
+    fprintf(out, ", \"phases\": {");
+    bool first = true;
+    for (int p = 0; p < PQC_PERF_PHASE_COUNT; p++) {
+        const pqc_perf_counters_t *phase = &r->phases[p];
+        if (phase->samples == 0) {
+            continue;
+        }
+        fprintf(out, "%s\"%s\": ", first ? "" : ", ", pqc_perf_phase_name((pqc_perf_phase_t)p));
+        write_counter_object(out, phase->values, phase->valid_mask, n);
+        first = false;
+    }
+    fprintf(out, "}");
+}
+
+static uint64_t bytes_total(const pqc_bytes_scope_t *scope) {
+    uint64_t total = 0;
+    for (int k = 0; k < PQC_BYTES_KIND_COUNT; k++) {
+        total += scope->bytes[k];
+    }
+    return total;
+}
+
+static int compare_bytes_desc(const void *a, const void *b) {
+    double x = per_op(bytes_total(a), ((const pqc_bytes_scope_t *)a)->calls);
+    double y = per_op(bytes_total(b), ((const pqc_bytes_scope_t *)b)->calls);
+    return (x < y) - (x > y);
+}
+
+/**
+ * @brief Scopes entered during a case: the case itself, then library APIs
+ *        with the largest bytes-touched per call first
+ * @return Number of scopes written to sorted
+ */
+static size_t sorted_bytes(const bench_case_result_t *r, pqc_bytes_scope_t sorted[PQC_BYTES_MAX_SCOPES]) {
+    size_t n = 0;
+    for (size_t i = 0; i < r->bytes_count; i++) {
+        if (r->bytes[i].calls == 0) {
+            continue;
+        }
+        if (strcmp(r->bytes[i].name, r->bench->name) == 0 && n > 0) {
+            sorted[n++] = sorted[0];
+            sorted[0] = r->bytes[i];
+        } else {
+            sorted[n++] = r->bytes[i];
+        }
+    }
+    if (n > 1) {
+        qsort(sorted + 1, n - 1, sizeof(pqc_bytes_scope_t), compare_bytes_desc);
+    }
+    return n;
+}
+
+static void print_bytes(const bench_case_result_t *results, size_t count) {
+    printf("\n%-36s %8s %12s %12s %12s %12s %12s\n", "bytes touched per call",
+           "calls", "copied", "zeroed", "hashed", "allocated", "total");
+    for (size_t i = 0; i < count; i++) {
+        const bench_case_result_t *r = &results[i];
+        if (r->status != PQC_SUCCESS || r->bytes_count == 0) {
+            continue;
+        }
+
+        pqc_bytes_scope_t sorted[PQC_BYTES_MAX_SCOPES];
+        size_t n = sorted_bytes(r, sorted);
+        for (size_t j = 0; j < n; j++) {
+            const pqc_bytes_scope_t *b = &sorted[j];
+            bool own = j == 0;
+            printf("%s%-*s %8llu", own ? "" : "  ", own ? 36 : 34, b->name,
+                   (unsigned long long)b->calls);
+            for (int k = 0; k < PQC_BYTES_KIND_COUNT; k++) {
+                printf(" %12.0f", per_op(b->bytes[k], b->calls));
+            }
+            printf(" %12.0f\n", per_op(bytes_total(b), b->calls));
+        }
+    }
+}
+
+static void write_bytes(FILE *out, const bench_case_result_t *r) {
+    pqc_bytes_scope_t sorted[PQC_BYTES_MAX_SCOPES];
+    size_t n = sorted_bytes(r, sorted);
+
+    // Per call of each scope; the case's own scope is the per-iteration total
+    fprintf(out, ", \"bytes_touched\": {");
+    for (size_t j = 0; j < n; j++) {
+        const pqc_bytes_scope_t *b = &sorted[j];
+        fprintf(out, "%s\"%s\": {\"calls\": %llu", j ? ", " : "", b->name,
+                (unsigned long long)b->calls);
+        for (int k = 0; k < PQC_BYTES_KIND_COUNT; k++) {
+            fprintf(out, ", \"%s\": %.1f", pqc_bytes_kind_name((pqc_bytes_kind_t)k),
+                    per_op(b->bytes[k], b->calls));
+        }
+        fprintf(out, ", \"total\": %.1f}", per_op(bytes_total(b), b->calls));
+    }
+    fprintf(out, "}");
+}
+
+static void write_stats(FILE *out, const char *key, const bench_stats_t *s) {
+    fprintf(out, "\"%s\": {\"median\": %.1f, \"p99\": %.1f, \"mean\": %.1f, "
+                 "\"stddev\": %.1f, \"min\": %llu, \"max\": %llu}",
+            key, s->median, s->p99, s->mean, s->stddev,
+            (unsigned long long)s->min, (unsigned long long)s->max);
+}
+
+static void write_samples(FILE *out, const char *key, const uint64_t *values, size_t count) {
+    fprintf(out, "\"%s\": [", key);
+    for (size_t i = 0; i < count; i++) {
+        fprintf(out, "%s%llu", i ? "," : "", (unsigned long long)values[i]);
+    }
+    fprintf(out, "]");
+}
+
+/**
+ * @brief Sum of median latencies of the named cases, in milliseconds
+ * @return Sum, or -1.0 if any case is missing or failed
+ */
+static double median_ms(const bench_case_result_t *results, size_t count,
+                        const char *a, const char *b) {
+    const bench_case_result_t *ra = find_result(results, count, a);
+    const bench_case_result_t *rb = find_result(results, count, b);
+    if (!ra || !rb) {
+        return -1.0;
+    }
+    return (ra->ns.median + rb->ns.median) / 1e6;
+}
+
+static void write_ms_field(FILE *out, const char *key, double value, bool last) {
+    if (value < 0.0) {
+        fprintf(out, "    \"%s\": null%s\n", key, last ? "" : ",");
+    } else {
+        fprintf(out, "    \"%s\": %.4f%s\n", key, value, last ? "" : ",");
+    }
+}
+
+static int write_report(const char *path, const bench_options_t *opts,
+                        const bench_case_result_t *results, size_t count) {
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        perror(path);
+        return -1;
+    }
+
+    bench_system_info_t sys;
+    bench_get_system_info(&sys);
+    char timestamp[40];
+    bench_format_timestamp(timestamp, sizeof(timestamp));
+
+    size_t passed = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (results[i].status == PQC_SUCCESS) {
+            passed++;
+        }
+    }
+
+    fprintf(out, "{\n  \"timestamp\": \"%s\",\n", timestamp);
+    fprintf(out, "  \"system\": {\n    \"cpu\": ");
+    bench_json_string(out, sys.cpu);
+    fprintf(out, ",\n    \"cores\": %d,\n    \"memory\": ", sys.cores);
+    bench_json_string(out, sys.memory);
+    fprintf(out, ",\n    \"architecture\": ");
+    bench_json_string(out, sys.architecture);
+    fprintf(out, "\n  },\n");
+
+    // Round-trip medians: encaps + decaps, sign + verify
+    fprintf(out, "  \"cryptography\": {\n");
+    write_ms_field(out, "kyber_1024_time",
+                   median_ms(results, count, "kyber_1024.encaps", "kyber_1024.decaps"), false);
+    write_ms_field(out, "dilithium_5_time",
+                   median_ms(results, count, "dilithium_5.sign", "dilithium_5.verify"), false);
+    write_ms_field(out, "falcon_512_time",
+                   median_ms(results, count, "falcon_512.sign", "falcon_512.verify"), false);
+    write_ms_field(out, "falcon_1024_time",
+                   median_ms(results, count, "falcon_1024.sign", "falcon_1024.verify"), false);
+    write_ms_field(out, "sphincs_sha256_128f_time",
+                   median_ms(results, count, "sphincs_sha256_128f.sign",
+                             "sphincs_sha256_128f.verify"), false);
+    write_ms_field(out, "sphincs_sha256_256f_time",
+                   median_ms(results, count, "sphincs_sha256_256f.sign",
+                             "sphincs_sha256_256f.verify"), false);
+    write_ms_field(out, "hss_lms_time",
+                   median_ms(results, count, "hss_lms.sign", "hss_lms.verify"), false);
+    fprintf(out, "    \"time_unit\": \"ms\"\n  },\n");
+
+    fprintf(out, "  \"performance\": {\n");
+    fprintf(out, "    \"pinned_cpu\": %d,\n", opts->cpu);
+    fprintf(out, "    \"warmup_iterations\": %zu,\n", opts->warmup);
+    fprintf(out, "    \"iterations\": %zu,\n", opts->iterations);
+    fprintf(out, "    \"cycle_counter\": \"%s\",\n", bench_cycle_counter_name());
+    fprintf(out, "    \"hardware_counters\": %s,\n",
+            opts->counters && pqc_perf_valid_mask() ? "true" : "false");
+    fprintf(out, "    \"byte_accounting\": %s,\n", pqc_bytes_enabled() ? "true" : "false");
+    fprintf(out, "    \"sha256_backend\": \"%s\",\n", sha256_backend_name());
+    fprintf(out, "    \"sphincs_threads\": %u\n  },\n", sphincs_get_threads());
+
+    fprintf(out, "  \"operations\": [\n");
+    for (size_t i = 0; i < count; i++) {
+        const bench_case_result_t *r = &results[i];
+        fprintf(out, "    {\"name\": \"%s\", \"group\": \"%s\", \"bytes\": %zu, \"status\": ",
+                r->bench->name, r->bench->group, r->bench->bytes);
+        bench_json_string(out, pqc_result_to_string(r->status));
+        if (r->status == PQC_SUCCESS && r->samples.count > 0) {
+            fprintf(out, ", ");
+            write_stats(out, "cycles", &r->cycles);
+            fprintf(out, ", ");
+            write_stats(out, "ns", &r->ns);
+            fprintf(out, ", \"ops_per_sec\": %.1f, ", r->ns.median > 0.0 ? 1e9 / r->ns.median : 0.0);
+            write_samples(out, "samples_cycles", r->samples.cycles, r->samples.count);
+            fprintf(out, ", ");
+            write_samples(out, "samples_ns", r->samples.ns, r->samples.count);
+            if (r->counter_mask) {
+                write_counters(out, r);
+            }
+            if (r->bytes_count) {
+                write_bytes(out, r);
+            }
+        }
+        fprintf(out, "}%s\n", i + 1 < count ? "," : "");
+    }
+    fprintf(out, "  ],\n");
+
+    fprintf(out, "  \"overall_score\": %.1f,\n", count ? 100.0 * (double)passed / (double)count : 0.0);
+    fprintf(out, "  \"generation\": 3,\n");
+    fprintf(out, "  \"status\": \"%s\"\n}\n", passed == count ? "production_ready" : "failed");
+
+    fclose(out);
+    return 0;
+}
+
+/**
+ * @brief Write the profiler's folded stacks and report sample counts
+ */
+static int write_profile(const char *path) {
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        perror(path);
+        return 1;
+    }
+    pqc_result_t result = pqc_profile_write_folded(out);
+    if (fclose(out) != 0 || result != PQC_SUCCESS) {
+        fprintf(stderr, "Failed to write %s\n", path);
+        return 1;
+    }
+
+    pqc_profile_stats_t stats;
+    pqc_profile_get_stats(&stats);
+    printf("\nProfile: %llu samples (%llu dropped) written to %s\n",
+           (unsigned long long)stats.written, (unsigned long long)stats.dropped, path);
+    return 0;
+}
+
+// ============================================================================
+// Regression Gate
+// ============================================================================
+
+/**
+ * @brief Compare results against a baseline report
+ * @return 0 if no case regressed, 3 on regression, 1 if the baseline is unusable
+ */
+static int check_baseline(const bench_options_t *opts,
+                          const bench_case_result_t *results, size_t count) {
+    bench_json_value_t *baseline = bench_json_parse_file(opts->baseline);
+    if (!baseline) {
+        fprintf(stderr, "Could not read baseline %s\n", opts->baseline);
+        return 1;
+    }
+
+    bench_comparison_t *rows = calloc(count ? count : 1, sizeof(bench_comparison_t));
+    if (!rows) {
+        bench_json_free(baseline);
+        return 1;
+    }
+
+    const char *samples_key = opts->compare_cycles ? "samples_cycles" : "samples_ns";
+    size_t compared = 0, regressed = 0;
+    for (size_t i = 0; i < count; i++) {
+        const bench_case_result_t *r = &results[i];
+        if (r->status != PQC_SUCCESS || r->samples.count == 0) {
+            continue;
+        }
+
+        const char *name = r->bench->name;
+        double threshold = bench_regression_threshold(opts->thresholds, opts->threshold_count,
+                                                      name, opts->default_threshold);
+        const uint64_t *samples = opts->compare_cycles ? r->samples.cycles : r->samples.ns;
+        if (bench_regression_compare(name, samples, r->samples.count,
+                                     bench_regression_find_operation(baseline, name),
+                                     samples_key, threshold, opts->alpha,
+                                     &rows[compared]) != 0) {
+            continue;
+        }
+        if (rows[compared].verdict == BENCH_VERDICT_REGRESSED) {
+            regressed++;
+        }
+        compared++;
+    }
+
+    printf("\nBaseline: %s (alpha %.3g, metric %s)", opts->baseline, opts->alpha,
+           opts->compare_cycles ? "cycles" : "ns");
+    bench_regression_print(stdout, rows, compared, opts->compare_cycles ? "cy" : "ns");
+    printf("\n%zu of %zu cases regressed\n", regressed, compared);
+
+    free(rows);
+    bench_json_free(baseline);
+    return regressed ? 3 : 0;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --iterations N   measured iterations per case (default %d)\n"
+            "  --warmup N       warmup iterations per case (default %d)\n"
+            "  --cpu N          CPU to pin the benchmark thread to (default 0)\n"
+            "  --filter STR     only run cases whose name contains STR or whose group is STR\n"
+            "  --output FILE    JSON report path (default benchmark_report.json)\n"
+            "  --list           list cases and exit\n"
+            "  --baseline FILE  compare against a previous report, exit 3 on regression\n"
+            "  --save-baseline FILE\n"
+            "                   also write this run's report to FILE\n"
+            "  --threshold NAME=PCT\n"
+            "                   allowed median slowdown for one case (repeatable)\n"
+            "  --default-threshold PCT\n"
+            "                   allowed median slowdown for other cases (default %.1f)\n"
+            "  --alpha P        significance level of the Mann-Whitney U test (default %.2f)\n"
+            "  --metric M       compare 'ns' (default) or 'cycles' samples\n"
+            "  --counters       collect hardware performance counters (perf_event_open)\n"
+            "  --profile FILE   sample stacks while the cases run, write folded stacks to FILE\n"
+            "  --profile-hz N   profiler samples per CPU-second (default %d)\n",
+            argv0, BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_WARMUP,
+            BENCH_DEFAULT_THRESHOLD_PCT, BENCH_DEFAULT_ALPHA, PQC_PROFILE_DEFAULT_HZ);
+}
+
+static int parse_options(int argc, char **argv, bench_options_t *opts) {
+    static const struct option long_opts[] = {
+        { "iterations", required_argument, NULL, 'n' },
+        { "warmup",     required_argument, NULL, 'w' },
+        { "cpu",        required_argument, NULL, 'c' },
+        { "filter",     required_argument, NULL, 'f' },
+        { "output",     required_argument, NULL, 'o' },
+        { "list",       no_argument,       NULL, 'l' },
+        { "baseline",   required_argument, NULL, 'b' },
+        { "save-baseline", required_argument, NULL, 's' },
+        { "threshold",  required_argument, NULL, 't' },
+        { "default-threshold", required_argument, NULL, 'T' },
+        { "alpha",      required_argument, NULL, 'a' },
+        { "metric",     required_argument, NULL, 'm' },
+        { "counters",   no_argument,       NULL, 'C' },
+        { "profile",    required_argument, NULL, 'p' },
+        { "profile-hz", required_argument, NULL, 'P' },
+        { "help",       no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    opts->iterations = BENCH_DEFAULT_ITERATIONS;
+    opts->warmup = BENCH_DEFAULT_WARMUP;
+    opts->cpu = 0;
+    opts->filter = NULL;
+    opts->output = "benchmark_report.json";
+    opts->list_only = false;
+    opts->baseline = NULL;
+    opts->save_baseline = NULL;
+    opts->threshold_count = 0;
+    opts->default_threshold = BENCH_DEFAULT_THRESHOLD_PCT;
+    opts->alpha = BENCH_DEFAULT_ALPHA;
+    opts->compare_cycles = false;
+    opts->counters = false;
+    opts->profile = NULL;
+    opts->profile_hz = PQC_PROFILE_DEFAULT_HZ;
+
+    int c;
+    while ((c = getopt_long(argc, argv, "n:w:c:f:o:lb:s:t:T:a:m:Cp:P:h", long_opts, NULL)) != -1) {
+        switch (c) {
+            case 'n': opts->iterations = strtoul(optarg, NULL, 10); break;
+            case 'w': opts->warmup = strtoul(optarg, NULL, 10); break;
+            case 'c': opts->cpu = atoi(optarg); break;
+            case 'f': opts->filter = optarg; break;
+            case 'o': opts->output = optarg; break;
+            case 'l': opts->list_only = true; break;
+            case 'b': opts->baseline = optarg; break;
+            case 's': opts->save_baseline = optarg; break;
+            case 'T': opts->default_threshold = strtod(optarg, NULL); break;
+            case 'a': opts->alpha = strtod(optarg, NULL); break;
+            case 'C': opts->counters = true; break;
+            case 'p': opts->profile = optarg; break;
+            case 'P': opts->profile_hz = (unsigned)strtoul(optarg, NULL, 10); break;
+            case 'm':
+                if (strcmp(optarg, "cycles") == 0) {
+                    opts->compare_cycles = true;
+                } else if (strcmp(optarg, "ns") != 0) {
+                    fprintf(stderr, "--metric must be 'ns' or 'cycles'\n");
+                    return -1;
+                }
+                break;
+            case 't': {
+                char *eq = strchr(optarg, '=');
+                if (!eq || opts->threshold_count == BENCH_MAX_THRESHOLDS) {
+                    fprintf(stderr, "Invalid or too many --threshold values: %s\n", optarg);
+                    return -1;
+                }
+                *eq = '\0';
+                opts->thresholds[opts->threshold_count].name = optarg;
+                opts->thresholds[opts->threshold_count].threshold_pct = strtod(eq + 1, NULL);
+                opts->threshold_count++;
+                break;
+            }
+            default:
+                usage(argv[0]);
+                return -1;
+        }
+    }
+
+    if (opts->iterations == 0) {
+        fprintf(stderr, "--iterations must be positive\n");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief HSS state kept in the benchmark context: signing measures the
+ * hash work, not the durability of whatever disk the runner is on
+ */
+static pqc_result_t hss_memory_read(void *store_ctx, uint8_t record[HSS_NV_RECORD_BYTES]) {
+    memcpy(record, ((bench_context_t *)store_ctx)->hss_nv, HSS_NV_RECORD_BYTES);
+    return PQC_SUCCESS;
+}
+
+static pqc_result_t hss_memory_write(void *store_ctx, const uint8_t record[HSS_NV_RECORD_BYTES]) {
+    memcpy(((bench_context_t *)store_ctx)->hss_nv, record, HSS_NV_RECORD_BYTES);
+    return PQC_SUCCESS;
+}
+
+/**
+ * @brief Two-level H10/W4 key (about a million firmware signatures) and a signature
+ */
+static pqc_result_t prepare_hss(bench_context_t *ctx) {
+    const hss_params_t params = {
+        .levels = 2,
+        .lms_type = { LMS_SHA256_M32_H10, LMS_SHA256_M32_H10 },
+        .lmots_type = { LMOTS_SHA256_N32_W4, LMOTS_SHA256_N32_W4 }
+    };
+    const hss_nv_store_t store = { hss_memory_read, hss_memory_write, ctx };
+
+    if (hss_signature_bytes(&params) > sizeof(ctx->hss_sig)) {
+        return PQC_ERROR_INTERNAL;
+    }
+    pqc_result_t result = hss_keypair(&params, ctx->hss_pk, ctx->hss_sk, &store);
+    if (result == PQC_SUCCESS) {
+        result = hss_signer_open(&ctx->hss_signer, ctx->hss_sk, sizeof(ctx->hss_sk), &store, 0);
+    }
+    return result == PQC_SUCCESS ? op_hss_sign(ctx) : result;
+}
+
+int main(int argc, char **argv) {
+    bench_options_t opts;
+    if (parse_options(argc, argv, &opts) != 0) {
+        return 2;
+    }
+
+    if (opts.list_only) {
+        for (size_t i = 0; i < BENCH_CASE_COUNT; i++) {
+            printf("%-30s %s\n", g_cases[i].name, g_cases[i].group);
+        }
+        return 0;
+    }
+
+    if (bench_pin_to_cpu(opts.cpu) != 0) {
+        fprintf(stderr, "Warning: could not pin to CPU %d, results may be noisy\n", opts.cpu);
+    }
+
+    if (pqc_init(NULL) != PQC_SUCCESS) {
+        fprintf(stderr, "pqc_init failed\n");
+        return 1;
+    }
+
+    if (opts.counters) {
+        pqc_result_t perf = pqc_perf_thread_open();
+        if (perf != PQC_SUCCESS) {
+            fprintf(stderr, "Warning: hardware counters unavailable (%s), "
+                    "check /proc/sys/kernel/perf_event_paranoid; continuing without\n",
+                    pqc_result_to_string(perf));
+        }
+    }
+
+    bench_context_t *ctx = calloc(1, sizeof(bench_context_t));
+    bench_case_result_t *results = calloc(BENCH_CASE_COUNT, sizeof(bench_case_result_t));
+    if (!ctx || !results) {
+        fprintf(stderr, "Out of memory\n");
+        free(ctx);
+        free(results);
+        return 1;
+    }
+
+    pqc_randombytes(ctx->message, sizeof(ctx->message));
+    pqc_randombytes(ctx->hash_input, sizeof(ctx->hash_input));
+    pqc_randombytes(ctx->mem_a, sizeof(ctx->mem_a));
+    memcpy(ctx->mem_b, ctx->mem_a, sizeof(ctx->mem_b));
+
+    // Dependent cases need valid keys/ciphertexts even when filtered alone
+    if (op_kyber_keypair(ctx) != PQC_SUCCESS || op_kyber_encaps(ctx) != PQC_SUCCESS ||
+        op_dilithium_keypair(ctx) != PQC_SUCCESS || op_dilithium_sign(ctx) != PQC_SUCCESS ||
+        op_falcon512_keypair(ctx) != PQC_SUCCESS || op_falcon512_sign(ctx) != PQC_SUCCESS ||
+        op_falcon1024_keypair(ctx) != PQC_SUCCESS || op_falcon1024_sign(ctx) != PQC_SUCCESS ||
+        op_sphincs128_keypair(ctx) != PQC_SUCCESS || op_sphincs128_sign(ctx) != PQC_SUCCESS ||
+        op_sphincs256_keypair(ctx) != PQC_SUCCESS || op_sphincs256_sign(ctx) != PQC_SUCCESS ||
+        prepare_hss(ctx) != PQC_SUCCESS) {
+        fprintf(stderr, "Failed to prepare benchmark keys\n");
+        free(ctx);
+        free(results);
+        return 1;
+    }
+
+    // Attestation cases verify the engine's own reports with its device key
+    attestation_config_t att_config = {
+        .device_type = DEVICE_TYPE_DEVELOPMENT_BOARD,
+        .device_serial = "BENCH-0001",
+        .enable_measurement_log = true,
+        .max_log_entries = MAX_MEASUREMENT_LOG_ENTRIES
+    };
+    if (attestation_init(&att_config) != PQC_SUCCESS ||
+        attestation_collect_measurements() != PQC_SUCCESS ||
+        op_attestation_certificate(ctx) != PQC_SUCCESS ||
+        op_attestation_generate(ctx) != PQC_SUCCESS) {
+        fprintf(stderr, "Failed to prepare attestation engine\n");
+        free(ctx);
+        free(results);
+        return 1;
+    }
+#ifdef PQC_ENABLE_TESTING
+    kyber_unpack_public_key(ctx->kyber_u, &ctx->kyber_pk);
+    dilithium_unpack_public_key(ctx->dilithium_t1, &ctx->dilithium_pk);
+#endif
+
+    bool profiling = false;
+    if (opts.profile) {
+        pqc_result_t prof = pqc_profile_start(opts.profile_hz);
+        if (prof == PQC_SUCCESS) {
+            prof = pqc_profile_thread_start();
+        }
+        if (prof != PQC_SUCCESS) {
+            fprintf(stderr, "Warning: profiler unavailable (%s); continuing without\n",
+                    pqc_result_to_string(prof));
+        } else {
+            profiling = true;
+        }
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < BENCH_CASE_COUNT; i++) {
+        if (!case_selected(&g_cases[i], opts.filter)) {
+            continue;
+        }
+        results[count].bench = &g_cases[i];
+        results[count].status = run_case(ctx, &opts, &results[count]);
+        count++;
+    }
+
+    int rc = 0;
+    if (profiling) {
+        pqc_profile_stop();
+        rc = write_profile(opts.profile);
+    }
+
+    print_table(results, count);
+    if (opts.counters && pqc_perf_valid_mask()) {
+        print_counters(results, count);
+    }
+    if (pqc_bytes_enabled()) {
+        print_bytes(results, count);
+    }
+    if (write_report(opts.output, &opts, results, count) != 0) {
+        rc = 1;
+    }
+    if (opts.save_baseline && write_report(opts.save_baseline, &opts, results, count) != 0) {
+        rc = 1;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (results[i].status != PQC_SUCCESS) {
+            rc = 1;
+        }
+    }
+
+    if (opts.baseline) {
+        int gate = check_baseline(&opts, results, count);
+        if (gate != 0) {
+            rc = gate;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        bench_samples_free(&results[i].samples);
+    }
+
+    hss_signer_close(ctx->hss_signer);
+    secure_memzero(ctx, sizeof(*ctx));
+    free(ctx);
+    free(results);
+    attestation_cleanup();
+    pqc_perf_thread_close();
+    pqc_cleanup();
+    return rc;
+}
@@ -0,0 +1,564 @@
+/**
+ * @file ct_harness.c
+ * @brief Statistical constant-time regression harness (dudect-style)
+ *
+ * Times each target on two classes of secret input, "fixed" and "random",
+ * randomly interleaved, and compares the two cycle distributions with
+ * Welch's t-test. The test is repeated on the distribution cropped at a
+ * range of upper percentiles to suppress interrupt and frequency noise,
+ * and the largest |t| is reported. A target whose |t| exceeds the
+ * threshold (default 4.5) is flagged as leaking; above 10 the leak is
+ * considered definite.
+ *
+ * Targets and the secret that differs between the two classes:
+ *   kyber_1024.decaps            ciphertext: fixed valid vs. random (implicit rejection)
+ *   dilithium_5.sign             secret key: fixed vs. random from a key pool,
+ *                                fresh random message in both classes
+ *   secure_memcmp.64             second operand: equal vs. random
+ *   secure_memcpy_conditional.64 condition: 0 vs. 1
+ *
+ * A pass is evidence, not proof: it only means no leak was detected with
+ * the given number of measurements on this machine.
+ *
+ * Usage: ct_harness [--measurements N] [--threshold T] [--cpu N]
+ *                   [--filter SUBSTR] [--output FILE] [--list]
+ */
+
+#define _GNU_SOURCE
+
+#include "bench_common.h"
+#include "../src/crypto/pqc_common.h"
+#include "../src/crypto/kyber.h"
+#include "../src/crypto/dilithium.h"
+#include "../src/crypto/secure_memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <getopt.h>
+
+#define CT_BUFFER_BYTES         64      /**< Operand size for memory targets */
+#define CT_SIGN_KEY_POOL        16      /**< Random-class Dilithium keys */
+#define CT_MESSAGE_BYTES        32      /**< Signed message size */
+#define CT_PERCENTILES          100     /**< Number of cropped tests */
+#define CT_MIN_CLASS_SAMPLES    100     /**< Minimum per-class samples for a test */
+#define CT_DEFAULT_THRESHOLD    4.5     /**< |t| above this is reported as a leak */
+#define CT_DEFINITE_LEAK        10.0    /**< |t| above this is a definite leak */
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+/**
+ * @brief Inputs shared by all targets
+ */
+typedef struct {
+    kyber_public_key_t kyber_pk;
+    kyber_secret_key_t kyber_sk;
+    kyber_ciphertext_t kyber_ct_fixed;
+    kyber_ciphertext_t kyber_ct;        /**< Input of the next measurement */
+    uint8_t kyber_ss[KYBER_SSBYTES];
+    dilithium_secret_key_t *sign_keys;  /**< [0] fixed class, [1..] random class */
+    const dilithium_secret_key_t *sign_key; /**< Input of the next measurement */
+    uint8_t message[CT_MESSAGE_BYTES];
+    uint8_t signature[DILITHIUM_SIGNATUREBYTES];
+    size_t siglen;
+    uint8_t a[CT_BUFFER_BYTES];
+    uint8_t b[CT_BUFFER_BYTES];
+    uint8_t dst[CT_BUFFER_BYTES];
+    int condition;
+    uint64_t rng;                       /**< xorshift64* state for input generation */
+} ct_context_t;
+
+typedef void (*ct_prepare_fn)(ct_context_t *ctx, int cls);
+typedef void (*ct_run_fn)(ct_context_t *ctx);
+
+/**
+ * @brief Constant-time target descriptor
+ */
+typedef struct {
+    const char *name;                   /**< Target name */
+    const char *secret;                 /**< What differs between the classes */
+    ct_prepare_fn prepare;              /**< Set up the input for a class (untimed) */
+    ct_run_fn run;                      /**< Operation under test (timed) */
+    size_t default_measurements;        /**< Measurements if --measurements not given */
+} ct_target_t;
+
+/**
+ * @brief Running two-class mean/variance (Welford)
+ */
+typedef struct {
+    double n[2];
+    double mean[2];
+    double m2[2];
+} ct_welch_t;
+
+/**
+ * @brief Result for one target
+ */
+typedef struct {
+    const ct_target_t *target;
+    size_t measurements;
+    double max_t;                       /**< Largest |t| over all crops */
+    double crop_percentile;             /**< Crop that produced max_t (100 = uncropped) */
+    double mean_cycles[2];              /**< Uncropped class means */
+    bool leak;
+} ct_result_t;
+
+/**
+ * @brief Harness options
+ */
+typedef struct {
+    size_t measurements;                /**< 0 = per-target default */
+    double threshold;
+    int cpu;
+    const char *filter;
+    const char *output;
+    bool list_only;
+} ct_options_t;
+
+// ============================================================================
+// Input Generation
+// ============================================================================
+
+static uint64_t ct_rand(ct_context_t *ctx) {
+    ctx->rng ^= ctx->rng >> 12;
+    ctx->rng ^= ctx->rng << 25;
+    ctx->rng ^= ctx->rng >> 27;
+    return ctx->rng * 0x2545F4914F6CDD1DULL;
+}
+
+static void ct_rand_bytes(ct_context_t *ctx, uint8_t *out, size_t len) {
+    for (size_t i = 0; i < len; i += 8) {
+        uint64_t r = ct_rand(ctx);
+        size_t n = len - i < 8 ? len - i : 8;
+        memcpy(out + i, &r, n);
+    }
+}
+
+// ============================================================================
+// Targets
+// ============================================================================
+
+/*
+ * Both classes write the same amount of input right before the measurement
+ * so that the cache state seen by the timed call does not depend on the class.
+ */
+
+static void prepare_kyber_decaps(ct_context_t *ctx, int cls) {
+    if (cls == 0) {
+        memcpy(&ctx->kyber_ct, &ctx->kyber_ct_fixed, sizeof(ctx->kyber_ct));
+    } else {
+        ct_rand_bytes(ctx, (uint8_t *)&ctx->kyber_ct, sizeof(ctx->kyber_ct));
+    }
+}
+
+static void run_kyber_decaps(ct_context_t *ctx) {
+    kyber_decapsulate(ctx->kyber_ss, &ctx->kyber_ct, &ctx->kyber_sk);
+}
+
+/*
+ * The number of rejection-loop iterations depends on key, message and
+ * signing randomness. A fresh message for both classes keeps it equally
+ * distributed between them, so only a dependence on the key itself shows
+ * up in the t statistic, whether or not signing is randomized.
+ */
+static void prepare_dilithium_sign(ct_context_t *ctx, int cls) {
+    size_t index = cls == 0 ? 0 : 1 + (size_t)(ct_rand(ctx) % (CT_SIGN_KEY_POOL - 1));
+    ctx->sign_key = &ctx->sign_keys[index];
+    ct_rand_bytes(ctx, ctx->message, sizeof(ctx->message));
+}
+
+static void run_dilithium_sign(ct_context_t *ctx) {
+    dilithium_sign(ctx->signature, &ctx->siglen, ctx->message, sizeof(ctx->message),
+                   ctx->sign_key);
+}
+
+static void prepare_secure_memcmp(ct_context_t *ctx, int cls) {
+    if (cls == 0) {
+        memcpy(ctx->b, ctx->a, sizeof(ctx->b));
+    } else {
+        ct_rand_bytes(ctx, ctx->b, sizeof(ctx->b));
+    }
+}
+
+static void run_secure_memcmp(ct_context_t *ctx) {
+    volatile int r = secure_memcmp(ctx->a, ctx->b, sizeof(ctx->a));
+    (void)r;
+}
+
+static void prepare_secure_memcpy_conditional(ct_context_t *ctx, int cls) {
+    ct_rand_bytes(ctx, ctx->b, sizeof(ctx->b));
+    ctx->condition = cls;
+}
+
+static void run_secure_memcpy_conditional(ct_context_t *ctx) {
+    secure_memcpy_conditional(ctx->dst, ctx->b, sizeof(ctx->dst), ctx->condition);
+}
+
+static const ct_target_t g_targets[] = {
+    { "kyber_1024.decaps",            "ciphertext",  prepare_kyber_decaps,
+      run_kyber_decaps,               20000 },
+    { "dilithium_5.sign",             "secret key",  prepare_dilithium_sign,
+      run_dilithium_sign,             5000 },
+    { "secure_memcmp.64",             "operand",     prepare_secure_memcmp,
+      run_secure_memcmp,              200000 },
+    { "secure_memcpy_conditional.64", "condition",   prepare_secure_memcpy_conditional,
+      run_secure_memcpy_conditional,  200000 },
+};
+
+#define CT_TARGET_COUNT (sizeof(g_targets) / sizeof(g_targets[0]))
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+static void welch_push(ct_welch_t *w, int cls, double x) {
+    w->n[cls] += 1.0;
+    double delta = x - w->mean[cls];
+    w->mean[cls] += delta / w->n[cls];
+    w->m2[cls] += delta * (x - w->mean[cls]);
+}
+
+/**
+ * @brief Welch's t statistic, or 0 if either class is too small
+ */
+static double welch_t(const ct_welch_t *w) {
+    if (w->n[0] < CT_MIN_CLASS_SAMPLES || w->n[1] < CT_MIN_CLASS_SAMPLES) {
+        return 0.0;
+    }
+    double var0 = w->m2[0] / (w->n[0] - 1.0);
+    double var1 = w->m2[1] / (w->n[1] - 1.0);
+    double se = sqrt(var0 / w->n[0] + var1 / w->n[1]);
+    return se > 0.0 ? (w->mean[0] - w->mean[1]) / se : 0.0;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Run the uncropped and percentile-cropped tests over all samples
+ */
+static int analyse(const uint64_t *cycles, const uint8_t *classes, size_t count,
+                   ct_result_t *result) {
+    uint64_t *sorted = malloc(count * sizeof(uint64_t));
+    if (!sorted) {
+        return -1;
+    }
+    memcpy(sorted, cycles, count * sizeof(uint64_t));
+    qsort(sorted, count, sizeof(uint64_t), compare_u64);
+
+    ct_welch_t full;
+    memset(&full, 0, sizeof(full));
+    for (size_t i = 0; i < count; i++) {
+        welch_push(&full, classes[i], (double)cycles[i]);
+    }
+    result->mean_cycles[0] = full.mean[0];
+    result->mean_cycles[1] = full.mean[1];
+    result->max_t = fabs(welch_t(&full));
+    result->crop_percentile = 100.0;
+
+    // Crops concentrate near the low tail, where the signal is least noisy
+    for (int k = 0; k < CT_PERCENTILES; k++) {
+        double p = 1.0 - pow(0.5, 10.0 * (double)(k + 1) / CT_PERCENTILES);
+        uint64_t cutoff = sorted[(size_t)(p * (double)(count - 1))];
+
+        ct_welch_t cropped;
+        memset(&cropped, 0, sizeof(cropped));
+        for (size_t i = 0; i < count; i++) {
+            if (cycles[i] < cutoff) {
+                welch_push(&cropped, classes[i], (double)cycles[i]);
+            }
+        }
+
+        double t = fabs(welch_t(&cropped));
+        if (t > result->max_t) {
+            result->max_t = t;
+            result->crop_percentile = 100.0 * p;
+        }
+    }
+
+    free(sorted);
+    return 0;
+}
+
+// ============================================================================
+// Measurement
+// ============================================================================
+
+static int run_target(ct_context_t *ctx, const ct_target_t *target, size_t measurements,
+                      double threshold, ct_result_t *result) {
+    uint64_t *cycles = malloc(measurements * sizeof(uint64_t));
+    uint8_t *classes = malloc(measurements);
+    if (!cycles || !classes) {
+        free(cycles);
+        free(classes);
+        return -1;
+    }
+
+    for (size_t i = 0; i < measurements; i++) {
+        classes[i] = (uint8_t)(ct_rand(ctx) & 1);
+    }
+
+    // Warm caches and branch predictors on both classes
+    size_t warmup = measurements / 100 + 10;
+    for (size_t i = 0; i < warmup; i++) {
+        target->prepare(ctx, (int)(i & 1));
+        target->run(ctx);
+    }
+
+    for (size_t i = 0; i < measurements; i++) {
+        target->prepare(ctx, classes[i]);
+        uint64_t c0 = bench_cycles();
+        target->run(ctx);
+        uint64_t c1 = bench_cycles();
+        cycles[i] = c1 - c0;
+    }
+
+    result->target = target;
+    result->measurements = measurements;
+    int rc = analyse(cycles, classes, measurements, result);
+    result->leak = result->max_t > threshold;
+
+    free(cycles);
+    free(classes);
+    return rc;
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+static const char* verdict(const ct_result_t *r) {
+    if (r->max_t > CT_DEFINITE_LEAK) {
+        return "LEAK";
+    }
+    return r->leak ? "POSSIBLE LEAK" : "ok";
+}
+
+static void print_table(const ct_result_t *results, size_t count) {
+    printf("%-30s %-11s %12s %12s %12s %8s %7s  %s\n", "target", "secret",
+           "measurements", "mean_fixed", "mean_random", "max|t|", "crop%", "verdict");
+    for (size_t i = 0; i < count; i++) {
+        const ct_result_t *r = &results[i];
+        printf("%-30s %-11s %12zu %12.1f %12.1f %8.2f %7.2f  %s\n", r->target->name,
+               r->target->secret, r->measurements, r->mean_cycles[0], r->mean_cycles[1],
+               r->max_t, r->crop_percentile, verdict(r));
+    }
+}
+
+static int write_report(const char *path, const ct_options_t *opts,
+                        const ct_result_t *results, size_t count) {
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        perror(path);
+        return -1;
+    }
+
+    bench_system_info_t sys;
+    bench_get_system_info(&sys);
+    char timestamp[40];
+    bench_format_timestamp(timestamp, sizeof(timestamp));
+
+    fprintf(out, "{\n  \"timestamp\": \"%s\",\n", timestamp);
+    fprintf(out, "  \"system\": {\n    \"cpu\": ");
+    bench_json_string(out, sys.cpu);
+    fprintf(out, ",\n    \"architecture\": ");
+    bench_json_string(out, sys.architecture);
+    fprintf(out, "\n  },\n");
+    fprintf(out, "  \"cycle_counter\": \"%s\",\n", bench_cycle_counter_name());
+    fprintf(out, "  \"pinned_cpu\": %d,\n", opts->cpu);
+    fprintf(out, "  \"threshold\": %.2f,\n", opts->threshold);
+
+    size_t leaks = 0;
+    fprintf(out, "  \"targets\": [\n");
+    for (size_t i = 0; i < count; i++) {
+        const ct_result_t *r = &results[i];
+        if (r->leak) {
+            leaks++;
+        }
+        fprintf(out, "    {\"name\": \"%s\", \"secret\": \"%s\", \"measurements\": %zu, "
+                     "\"mean_cycles_fixed\": %.1f, \"mean_cycles_random\": %.1f, "
+                     "\"max_t\": %.3f, \"crop_percentile\": %.3f, \"verdict\": \"%s\"}%s\n",
+                r->target->name, r->target->secret, r->measurements,
+                r->mean_cycles[0], r->mean_cycles[1], r->max_t, r->crop_percentile,
+                verdict(r), i + 1 < count ? "," : "");
+    }
+    fprintf(out, "  ],\n");
+    fprintf(out, "  \"status\": \"%s\"\n}\n", leaks ? "leak_detected" : "no_leak_detected");
+
+    fclose(out);
+    return 0;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --measurements N  measurements per target (default: per target)\n"
+            "  --threshold T     |t| above which a target is reported (default %.1f)\n"
+            "  --cpu N           CPU to pin to (default 0)\n"
+            "  --filter STR      only run targets whose name contains STR\n"
+            "  --output FILE     JSON report path (default ct_report.json)\n"
+            "  --list            list targets and exit\n",
+            argv0, CT_DEFAULT_THRESHOLD);
+}
+
+static int parse_options(int argc, char **argv, ct_options_t *opts) {
+    static const struct option long_opts[] = {
+        { "measurements", required_argument, NULL, 'n' },
+        { "threshold",    required_argument, NULL, 't' },
+        { "cpu",          required_argument, NULL, 'c' },
+        { "filter",       required_argument, NULL, 'f' },
+        { "output",       required_argument, NULL, 'o' },
+        { "list",         no_argument,       NULL, 'l' },
+        { "help",         no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    opts->measurements = 0;
+    opts->threshold = CT_DEFAULT_THRESHOLD;
+    opts->cpu = 0;
+    opts->filter = NULL;
+    opts->output = "ct_report.json";
+    opts->list_only = false;
+
+    int c;
+    while ((c = getopt_long(argc, argv, "n:t:c:f:o:lh", long_opts, NULL)) != -1) {
+        switch (c) {
+            case 'n': opts->measurements = strtoul(optarg, NULL, 10); break;
+            case 't': opts->threshold = strtod(optarg, NULL); break;
+            case 'c': opts->cpu = atoi(optarg); break;
+            case 'f': opts->filter = optarg; break;
+            case 'o': opts->output = optarg; break;
+            case 'l': opts->list_only = true; break;
+            default:
+                usage(argv[0]);
+                return -1;
+        }
+    }
+
+    if (opts->measurements != 0 && opts->measurements < 2 * CT_MIN_CLASS_SAMPLES) {
+        fprintf(stderr, "--measurements must be at least %d\n", 2 * CT_MIN_CLASS_SAMPLES);
+        return -1;
+    }
+    return 0;
+}
+
+static pqc_result_t setup_context(ct_context_t *ctx) {
+    pqc_result_t rc;
+    size_t siglen;
+    dilithium_public_key_t *pk = malloc(sizeof(dilithium_public_key_t));
+    if (!pk) {
+        return PQC_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    if ((rc = pqc_randombytes((uint8_t *)&ctx->rng, sizeof(ctx->rng))) != PQC_SUCCESS) {
+        goto done;
+    }
+    ctx->rng |= 1;
+
+    if ((rc = kyber_keypair(&ctx->kyber_pk, &ctx->kyber_sk)) != PQC_SUCCESS ||
+        (rc = kyber_encapsulate(&ctx->kyber_ct_fixed, ctx->kyber_ss, &ctx->kyber_pk)) != PQC_SUCCESS) {
+        goto done;
+    }
+
+    for (int i = 0; i < CT_SIGN_KEY_POOL; i++) {
+        if ((rc = dilithium_keypair(pk, &ctx->sign_keys[i])) != PQC_SUCCESS) {
+            goto done;
+        }
+    }
+    ct_rand_bytes(ctx, ctx->message, sizeof(ctx->message));
+    ct_rand_bytes(ctx, ctx->a, sizeof(ctx->a));
+    rc = dilithium_sign(ctx->signature, &siglen, ctx->message, sizeof(ctx->message),
+                        &ctx->sign_keys[0]);
+
+done:
+    free(pk);
+    return rc;
+}
+
+int main(int argc, char **argv) {
+    ct_options_t opts;
+    if (parse_options(argc, argv, &opts) != 0) {
+        return 2;
+    }
+
+    if (opts.list_only) {
+        for (size_t i = 0; i < CT_TARGET_COUNT; i++) {
+            printf("%-30s %s\n", g_targets[i].name, g_targets[i].secret);
+        }
+        return 0;
+    }
+
+    if (bench_pin_to_cpu(opts.cpu) != 0) {
+        fprintf(stderr, "Warning: could not pin to CPU %d, results may be noisy\n", opts.cpu);
+    }
+
+    if (pqc_init(NULL) != PQC_SUCCESS) {
+        fprintf(stderr, "pqc_init failed\n");
+        return 1;
+    }
+
+    ct_context_t *ctx = calloc(1, sizeof(ct_context_t));
+    ct_result_t *results = calloc(CT_TARGET_COUNT, sizeof(ct_result_t));
+    if (ctx) {
+        ctx->sign_keys = calloc(CT_SIGN_KEY_POOL, sizeof(dilithium_secret_key_t));
+    }
+    if (!ctx || !results || !ctx->sign_keys) {
+        fprintf(stderr, "Out of memory\n");
+        if (ctx) {
+            free(ctx->sign_keys);
+        }
+        free(ctx);
+        free(results);
+        return 1;
+    }
+
+    int rc = 0;
+    if (setup_context(ctx) != PQC_SUCCESS) {
+        fprintf(stderr, "Failed to prepare keys\n");
+        rc = 1;
+        goto cleanup;
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < CT_TARGET_COUNT; i++) {
+        const ct_target_t *target = &g_targets[i];
+        if (opts.filter && !strstr(target->name, opts.filter)) {
+            continue;
+        }
+
+        size_t n = opts.measurements ? opts.measurements : target->default_measurements;
+        fprintf(stderr, "Measuring %s (%zu measurements)...\n", target->name, n);
+        if (run_target(ctx, target, n, opts.threshold, &results[count]) != 0) {
+            fprintf(stderr, "Out of memory measuring %s\n", target->name);
+            rc = 1;
+            goto cleanup;
+        }
+        if (results[count].leak) {
+            rc = 1;
+        }
+        count++;
+    }
+
+    print_table(results, count);
+    if (write_report(opts.output, &opts, results, count) != 0) {
+        rc = 1;
+    }
+
+cleanup:
+    secure_memzero(ctx->sign_keys, CT_SIGN_KEY_POOL * sizeof(dilithium_secret_key_t));
+    free(ctx->sign_keys);
+    secure_memzero(ctx, sizeof(*ctx));
+    free(ctx);
+    free(results);
+    pqc_cleanup();
+    return rc;
+}
@@ -0,0 +1,1200 @@
+/**
+ * @file fleet_loadgen.c
+ * @brief End-to-end fleet load generator for attestation verification
+ *
+ * Simulates a fleet of N devices, each with its own Dilithium-5 key pair,
+ * report and attestation interval, and feeds their reports to a pool of
+ * verifier threads calling attestation_verify_report(). Devices are spread
+ * over producer threads that emit each device's reports on its own
+ * schedule; intervals are drawn so the fleet as a whole offers the
+ * requested aggregate rate, with uniform jitter around each interval.
+ *
+ * Reports travel either through an in-process bounded queue or through a
+ * local AF_UNIX SOCK_SEQPACKET socket, so the cost of copying reports
+ * across a process boundary can be included. With --transport daemon the
+ * verifiers are not in this process at all: each producer streams compact
+ * report frames to a running verifierd over its own connection, and one
+ * receiver thread per connection collects the results.
+ *
+ * End-to-end latency is measured from the time a report was *scheduled*
+ * to be sent until its verification completes, so a generator or verifier
+ * that falls behind shows up as latency instead of silently lowering the
+ * offered rate. Producer lag is reported separately to tell the two apart.
+ *
+ * By default every device signs one report at setup and re-sends it, which
+ * keeps producers cheap enough to saturate the verifiers; --live-sign signs
+ * every report as a real device would. Pre-signed reports carry the setup
+ * time, so runs must stay within the verifier's 5 minute clock-skew window.
+ * verifierd answers re-sent reports from its result cache; start it with
+ * --result-cache 0, or use --live-sign, to measure verification itself.
+ * The devices enroll over the socket, so it also needs --allow-enroll.
+ *
+ * Usage: fleet_loadgen [--devices N] [--rate R] [--duration-ms MS]
+ *                      [--warmup-ms MS] [--jitter PCT] [--producers P]
+ *                      [--verifiers V] [--transport queue|socket|daemon]
+ *                      [--connect PATH] [--queue-depth D] [--measurements M]
+ *                      [--live-sign] [--output FILE]
+ */
+
+#define _GNU_SOURCE
+
+#include "bench_common.h"
+#include "../src/crypto/pqc_common.h"
+#include "../src/crypto/dilithium.h"
+#include "../src/crypto/secure_memory.h"
+#include "../src/attestation/attestation_engine.h"
+#include "../src/verifier/verifier_protocol.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <getopt.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define FLEET_DEFAULT_DEVICES       1000    /**< Simulated devices */
+#define FLEET_DEFAULT_RATE          200.0   /**< Aggregate reports per second */
+#define FLEET_DEFAULT_DURATION_MS   10000   /**< Measurement window */
+#define FLEET_DEFAULT_WARMUP_MS     1000    /**< Excluded from statistics */
+#define FLEET_DEFAULT_JITTER        20.0    /**< Interval jitter, +/- percent */
+#define FLEET_DEFAULT_QUEUE_DEPTH   1024    /**< In-process queue slots */
+#define FLEET_DEFAULT_MEASUREMENTS  8       /**< Measurements per report */
+#define FLEET_SATURATION_RATIO      0.95    /**< Sustained/offered below this is saturated */
+#define FLEET_CACHE_LINE            64
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+typedef enum {
+    FLEET_TRANSPORT_QUEUE = 0,
+    FLEET_TRANSPORT_SOCKET = 1,
+    FLEET_TRANSPORT_DAEMON = 2
+} fleet_transport_kind_t;
+
+static const char *const g_transport_names[] = { "queue", "socket", "daemon" };
+
+/**
+ * @brief One simulated device
+ */
+typedef struct {
+    dilithium_keypair_t keys;
+    attestation_report_t report;        /**< Pre-signed report or live template */
+    uint64_t interval_ns;               /**< Mean time between reports */
+    uint64_t next_due_ns;               /**< Scheduled time of the next report */
+    uint64_t sent;
+} fleet_device_t;
+
+/**
+ * @brief Report in flight between a producer and a verifier
+ */
+typedef struct {
+    uint32_t device;
+    uint64_t due_ns;                    /**< Scheduled send time */
+    attestation_report_t report;
+} fleet_msg_t;
+
+/**
+ * @brief Producer-to-verifier channel
+ */
+typedef struct {
+    fleet_transport_kind_t kind;
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    fleet_msg_t *slots;
+    size_t depth;
+    size_t head;
+    size_t count;
+    bool closed;
+    int fds[2];                         /**< [0] producers send, [1] verifiers receive */
+    int *conns;                         /**< Daemon: one connection per producer */
+    uint8_t **frames;                   /**< Daemon: encode buffer per connection */
+    int nconns;
+} fleet_transport_t;
+
+/**
+ * @brief Latency samples collected by one verifier
+ */
+typedef struct {
+    uint64_t *values;
+    size_t count;
+    size_t capacity;
+} fleet_latencies_t;
+
+typedef struct {
+    int devices;
+    double rate;
+    unsigned duration_ms;
+    unsigned warmup_ms;
+    double jitter;
+    int producers;
+    int verifiers;
+    fleet_transport_kind_t transport;
+    const char *connect;                /**< verifierd socket for the daemon transport */
+    size_t queue_depth;
+    unsigned measurements;
+    bool live_sign;
+    const char *output;
+} fleet_options_t;
+
+/**
+ * @brief Run-wide state shared by all threads (read-only once started)
+ */
+typedef struct {
+    const fleet_options_t *opts;
+    fleet_device_t *devices;
+    fleet_transport_t *transport;
+    uint64_t start_ns;
+    uint64_t measure_start_ns;
+    uint64_t measure_end_ns;
+} fleet_run_t;
+
+typedef struct {
+    _Alignas(FLEET_CACHE_LINE) pthread_t thread;
+    const fleet_run_t *run;
+    int first;                          /**< First device owned */
+    int last;                           /**< One past the last device owned */
+    int channel;                        /**< Daemon connection used */
+    uint64_t seed;
+    uint64_t sent;
+    fleet_latencies_t lag;              /**< Send time minus scheduled time */
+    pqc_result_t status;
+} fleet_producer_t;
+
+typedef struct {
+    _Alignas(FLEET_CACHE_LINE) pthread_t thread;
+    const fleet_run_t *run;
+    int channel;                        /**< Daemon connection read */
+    uint64_t verified;                  /**< Completions inside the window */
+    uint64_t drained;                   /**< Completions after the window closed */
+    uint64_t rejected;
+    uint64_t errors;
+    fleet_latencies_t e2e;              /**< Scheduled send to verification done */
+    fleet_latencies_t service;          /**< attestation_verify_report() only, in process */
+} fleet_verifier_t;
+
+/**
+ * @brief Percentiles over a latency sample set, in nanoseconds
+ */
+typedef struct {
+    size_t count;
+    double p50;
+    double p90;
+    double p99;
+    double p999;
+    double max;
+} fleet_percentiles_t;
+
+typedef struct {
+    double offered_rate;
+    double sustained_rate;
+    uint64_t sent;
+    uint64_t verified;
+    uint64_t drained;
+    uint64_t rejected;
+    uint64_t errors;
+    fleet_percentiles_t e2e;
+    fleet_percentiles_t service;
+    fleet_percentiles_t lag;
+    size_t device_bytes;                /**< sizeof(fleet_device_t) */
+    double rss_per_device;              /**< Resident set growth / devices, 0 if unknown */
+    bool saturated;
+} fleet_summary_t;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void sleep_until_ns(uint64_t deadline) {
+    struct timespec ts = {
+        .tv_sec = (time_t)(deadline / 1000000000ULL),
+        .tv_nsec = (long)(deadline % 1000000000ULL)
+    };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+}
+
+static uint64_t xorshift64(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/** Uniform in [0, 1) */
+static double random_unit(uint64_t *state) {
+    return (double)(xorshift64(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static uint64_t jittered_interval(uint64_t interval, double jitter_pct, uint64_t *state) {
+    double factor = 1.0 + (jitter_pct / 100.0) * (2.0 * random_unit(state) - 1.0);
+    return (uint64_t)((double)interval * factor);
+}
+
+static size_t resident_bytes(void) {
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (!f) {
+        return 0;
+    }
+    unsigned long size = 0, resident = 0;
+    int n = fscanf(f, "%lu %lu", &size, &resident);
+    fclose(f);
+    return n == 2 ? (size_t)resident * (size_t)sysconf(_SC_PAGESIZE) : 0;
+}
+
+static int latencies_init(fleet_latencies_t *lat, size_t capacity) {
+    lat->values = malloc(capacity * sizeof(uint64_t));
+    lat->count = 0;
+    lat->capacity = lat->values ? capacity : 0;
+    return lat->values ? 0 : -1;
+}
+
+static void latencies_push(fleet_latencies_t *lat, uint64_t value) {
+    if (lat->count < lat->capacity) {
+        lat->values[lat->count++] = value;
+    }
+}
+
+static void latencies_free(fleet_latencies_t *lat) {
+    free(lat->values);
+    memset(lat, 0, sizeof(*lat));
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static double nearest_rank(const uint64_t *sorted, size_t count, double pct) {
+    size_t rank = (size_t)((pct / 100.0) * (double)count + 0.999999);
+    if (rank < 1) {
+        rank = 1;
+    }
+    if (rank > count) {
+        rank = count;
+    }
+    return (double)sorted[rank - 1];
+}
+
+/**
+ * @brief Merge one latency set from every thread and compute percentiles
+ */
+static void merge_percentiles(const fleet_latencies_t *sets, size_t nsets, size_t stride,
+                              fleet_percentiles_t *out) {
+    memset(out, 0, sizeof(*out));
+    size_t total = 0;
+    for (size_t i = 0; i < nsets; i++) {
+        total += ((const fleet_latencies_t *)((const char *)sets + i * stride))->count;
+    }
+    if (total == 0) {
+        return;
+    }
+
+    uint64_t *merged = malloc(total * sizeof(uint64_t));
+    if (!merged) {
+        return;
+    }
+    size_t n = 0;
+    for (size_t i = 0; i < nsets; i++) {
+        const fleet_latencies_t *set = (const fleet_latencies_t *)((const char *)sets + i * stride);
+        memcpy(merged + n, set->values, set->count * sizeof(uint64_t));
+        n += set->count;
+    }
+    qsort(merged, n, sizeof(uint64_t), compare_u64);
+
+    out->count = n;
+    out->p50 = nearest_rank(merged, n, 50.0);
+    out->p90 = nearest_rank(merged, n, 90.0);
+    out->p99 = nearest_rank(merged, n, 99.0);
+    out->p999 = nearest_rank(merged, n, 99.9);
+    out->max = (double)merged[n - 1];
+    free(merged);
+}
+
+// ============================================================================
+// Transport
+// ============================================================================
+
+static int write_full(int fd, const void *buf, size_t length) {
+    const uint8_t *p = buf;
+    while (length > 0) {
+        ssize_t n = send(fd, p, length, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return -1;
+        }
+        p += n;
+        length -= (size_t)n;
+    }
+    return 0;
+}
+
+/**
+ * @return 0 on success, 1 at end of stream before the first byte, -1 on error
+ */
+static int read_full(int fd, void *buf, size_t length) {
+    uint8_t *p = buf;
+    size_t done = 0;
+    while (done < length) {
+        ssize_t n = recv(fd, p + done, length - done, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n == 0 && done == 0) {
+            return 1;
+        }
+        if (n <= 0) {
+            return -1;
+        }
+        done += (size_t)n;
+    }
+    return 0;
+}
+
+static int connect_daemon(const char *path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "%s: path too long\n", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        perror(path);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+static void transport_destroy(fleet_transport_t *t) {
+    if (t->kind == FLEET_TRANSPORT_DAEMON) {
+        for (int i = 0; t->conns && i < t->nconns; i++) {
+            if (t->conns[i] >= 0) {
+                close(t->conns[i]);
+            }
+            free(t->frames ? t->frames[i] : NULL);
+        }
+        free(t->conns);
+        free(t->frames);
+        return;
+    }
+    if (t->kind == FLEET_TRANSPORT_SOCKET) {
+        if (t->fds[0] >= 0) {
+            close(t->fds[0]);
+        }
+        if (t->fds[1] >= 0) {
+            close(t->fds[1]);
+        }
+        return;
+    }
+    pthread_cond_destroy(&t->not_full);
+    pthread_cond_destroy(&t->not_empty);
+    pthread_mutex_destroy(&t->lock);
+    free(t->slots);
+}
+
+static int transport_init(fleet_transport_t *t, const fleet_options_t *opts) {
+    memset(t, 0, sizeof(*t));
+    t->kind = opts->transport;
+    t->fds[0] = t->fds[1] = -1;
+    size_t depth = opts->queue_depth;
+
+    if (t->kind == FLEET_TRANSPORT_DAEMON) {
+        t->nconns = opts->producers;
+        t->conns = malloc((size_t)t->nconns * sizeof(int));
+        t->frames = calloc((size_t)t->nconns, sizeof(uint8_t *));
+        if (!t->conns || !t->frames) {
+            transport_destroy(t);
+            return -1;
+        }
+        for (int i = 0; i < t->nconns; i++) {
+            t->conns[i] = -1;
+        }
+        for (int i = 0; i < t->nconns; i++) {
+            t->conns[i] = connect_daemon(opts->connect);
+            t->frames[i] = malloc(VERIFIER_MAX_FRAME_BYTES);
+            if (t->conns[i] < 0 || !t->frames[i]) {
+                transport_destroy(t);
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    if (t->kind == FLEET_TRANSPORT_SOCKET) {
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, t->fds) != 0) {
+            perror("socketpair");
+            return -1;
+        }
+        // Room for roughly queue_depth reports in flight, as with the queue
+        int bytes = (int)(depth * sizeof(fleet_msg_t));
+        setsockopt(t->fds[0], SOL_SOCKET, SO_SNDBUF, &bytes, sizeof(bytes));
+        setsockopt(t->fds[1], SOL_SOCKET, SO_RCVBUF, &bytes, sizeof(bytes));
+        return 0;
+    }
+
+    t->slots = malloc(depth * sizeof(fleet_msg_t));
+    if (!t->slots) {
+        return -1;
+    }
+    t->depth = depth;
+    pthread_mutex_init(&t->lock, NULL);
+    pthread_cond_init(&t->not_empty, NULL);
+    pthread_cond_init(&t->not_full, NULL);
+    return 0;
+}
+
+/**
+ * @brief Send one report, blocking while the channel is full
+ *
+ * The daemon transport sends a compact REPORT frame on connection channel
+ * whose request_id is the scheduled send time.
+ *
+ * @return 0 on success, -1 on failure
+ */
+static int transport_send(fleet_transport_t *t, int channel, const fleet_msg_t *msg) {
+    if (t->kind == FLEET_TRANSPORT_DAEMON) {
+        uint8_t *frame = t->frames[channel];
+        size_t length = verifier_encode_report(frame + sizeof(verifier_frame_header_t),
+                                               VERIFIER_MAX_REPORT_BYTES, &msg->report);
+        if (length == 0) {
+            return -1;
+        }
+        verifier_frame_header_t header;
+        verifier_frame_header_init(&header, VERIFIER_FRAME_REPORT, (uint32_t)length, msg->due_ns);
+        memcpy(frame, &header, sizeof(header));
+        return write_full(t->conns[channel], frame, sizeof(header) + length);
+    }
+    if (t->kind == FLEET_TRANSPORT_SOCKET) {
+        ssize_t n;
+        do {
+            n = send(t->fds[0], msg, sizeof(*msg), MSG_NOSIGNAL);
+        } while (n < 0 && errno == EINTR);
+        return n == (ssize_t)sizeof(*msg) ? 0 : -1;
+    }
+
+    pthread_mutex_lock(&t->lock);
+    while (t->count == t->depth && !t->closed) {
+        pthread_cond_wait(&t->not_full, &t->lock);
+    }
+    if (t->closed) {
+        pthread_mutex_unlock(&t->lock);
+        return -1;
+    }
+    memcpy(&t->slots[(t->head + t->count) % t->depth], msg, sizeof(*msg));
+    t->count++;
+    pthread_cond_signal(&t->not_empty);
+    pthread_mutex_unlock(&t->lock);
+    return 0;
+}
+
+/**
+ * @brief Receive one report, blocking while the channel is empty
+ *
+ * @return 0 on success, -1 once the channel is closed and drained
+ */
+static int transport_recv(fleet_transport_t *t, fleet_msg_t *msg) {
+    if (t->kind == FLEET_TRANSPORT_SOCKET) {
+        ssize_t n;
+        do {
+            n = recv(t->fds[1], msg, sizeof(*msg), 0);
+        } while (n < 0 && errno == EINTR);
+        return n == (ssize_t)sizeof(*msg) ? 0 : -1;
+    }
+
+    pthread_mutex_lock(&t->lock);
+    while (t->count == 0 && !t->closed) {
+        pthread_cond_wait(&t->not_empty, &t->lock);
+    }
+    if (t->count == 0) {
+        pthread_mutex_unlock(&t->lock);
+        return -1;
+    }
+    memcpy(msg, &t->slots[t->head], sizeof(*msg));
+    t->head = (t->head + 1) % t->depth;
+    t->count--;
+    pthread_cond_signal(&t->not_full);
+    pthread_mutex_unlock(&t->lock);
+    return 0;
+}
+
+/**
+ * @brief Receive one RESULT frame from a daemon connection
+ *
+ * @return 0 on success, -1 once the daemon has closed the connection
+ */
+static int transport_recv_result(fleet_transport_t *t, int channel, uint64_t *request_id,
+                                 verifier_result_t *result) {
+    verifier_frame_header_t header;
+    if (read_full(t->conns[channel], &header, sizeof(header)) != 0 ||
+        verifier_frame_header_check(&header) != PQC_SUCCESS ||
+        header.type != VERIFIER_FRAME_RESULT ||
+        read_full(t->conns[channel], result, sizeof(*result)) != 0) {
+        return -1;
+    }
+    *request_id = header.request_id;
+    return 0;
+}
+
+/**
+ * @brief Stop accepting reports; receivers drain what is in flight
+ */
+static void transport_close(fleet_transport_t *t) {
+    if (t->kind == FLEET_TRANSPORT_DAEMON) {
+        for (int i = 0; i < t->nconns; i++) {
+            shutdown(t->conns[i], SHUT_WR);
+        }
+        return;
+    }
+    if (t->kind == FLEET_TRANSPORT_SOCKET) {
+        shutdown(t->fds[0], SHUT_WR);
+        return;
+    }
+    pthread_mutex_lock(&t->lock);
+    t->closed = true;
+    pthread_cond_broadcast(&t->not_empty);
+    pthread_cond_broadcast(&t->not_full);
+    pthread_mutex_unlock(&t->lock);
+}
+
+// ============================================================================
+// Devices
+// ============================================================================
+
+/**
+ * @brief Hash and sign a report the way attestation_generate_report() does
+ */
+static pqc_result_t report_sign(attestation_report_t *report, const dilithium_secret_key_t *sk) {
+    uint8_t hash[32];
+    pqc_result_t result = sha3_256(hash, (const uint8_t *)report, ATTESTATION_REPORT_SIGNED_BYTES);
+    if (result != PQC_SUCCESS) {
+        return result;
+    }
+
+    size_t siglen = 0;
+    result = dilithium_sign(report->signature, &siglen, hash, sizeof(hash), sk);
+    report->signature_length = (uint32_t)siglen;
+    return result;
+}
+
+static pqc_result_t device_init(fleet_device_t *dev, int index, const fleet_options_t *opts) {
+    memset(dev, 0, sizeof(*dev));
+    pqc_result_t result = dilithium_keypair(&dev->keys.pk, &dev->keys.sk);
+    if (result != PQC_SUCCESS) {
+        return result;
+    }
+
+    attestation_report_t *r = &dev->report;
+    snprintf((char *)r->device_id, sizeof(r->device_id), "loadgen-%08d", index);
+    r->report_version = ATTESTATION_REPORT_VERSION;
+    r->measurement_count = opts->measurements;
+    pqc_randombytes(&r->pcr_values[0][0], sizeof(r->pcr_values));
+    for (unsigned i = 0; i < opts->measurements; i++) {
+        platform_measurement_t *m = &r->measurements[i];
+        m->pcr_index = (uint8_t)(i % MAX_PCR_REGISTERS);
+        m->measurement_type = (measurement_type_t)(i % MEASUREMENT_TYPE_MAX);
+        pqc_randombytes(m->measurement_value, sizeof(m->measurement_value));
+        m->measurement_size = 4096;
+        snprintf(m->description, sizeof(m->description), "loadgen measurement %u", i);
+    }
+
+    dev->interval_ns = (uint64_t)((double)opts->devices * 1e9 / opts->rate);
+    r->timestamp = (uint64_t)time(NULL);
+    return report_sign(r, &dev->keys.sk);
+}
+
+// ============================================================================
+// Producers
+// ============================================================================
+
+/**
+ * @brief Binary min-heap of device indices ordered by next_due_ns
+ */
+typedef struct {
+    int *items;
+    size_t count;
+    fleet_device_t *devices;
+} fleet_heap_t;
+
+static bool heap_less(const fleet_heap_t *h, size_t a, size_t b) {
+    return h->devices[h->items[a]].next_due_ns < h->devices[h->items[b]].next_due_ns;
+}
+
+static void heap_swap(fleet_heap_t *h, size_t a, size_t b) {
+    int tmp = h->items[a];
+    h->items[a] = h->items[b];
+    h->items[b] = tmp;
+}
+
+static void heap_sift_down(fleet_heap_t *h, size_t i) {
+    for (;;) {
+        size_t left = 2 * i + 1, right = left + 1, min = i;
+        if (left < h->count && heap_less(h, left, min)) {
+            min = left;
+        }
+        if (right < h->count && heap_less(h, right, min)) {
+            min = right;
+        }
+        if (min == i) {
+            return;
+        }
+        heap_swap(h, i, min);
+        i = min;
+    }
+}
+
+static void* producer_main(void *arg) {
+    fleet_producer_t *p = (fleet_producer_t *)arg;
+    const fleet_run_t *run = p->run;
+    const fleet_options_t *opts = run->opts;
+    p->status = PQC_SUCCESS;
+
+    fleet_heap_t heap = { .count = (size_t)(p->last - p->first), .devices = run->devices };
+    heap.items = malloc(heap.count * sizeof(int));
+    fleet_msg_t *msg = malloc(sizeof(fleet_msg_t));
+    if (!heap.items || !msg) {
+        free(heap.items);
+        free(msg);
+        p->status = PQC_ERROR_INSUFFICIENT_MEMORY;
+        return NULL;
+    }
+
+    // Random phase within the first interval so devices do not send in lockstep
+    for (int d = p->first; d < p->last; d++) {
+        fleet_device_t *dev = &run->devices[d];
+        dev->next_due_ns = run->start_ns + (uint64_t)(random_unit(&p->seed) * (double)dev->interval_ns);
+        heap.items[d - p->first] = d;
+    }
+    for (size_t i = heap.count / 2; i-- > 0;) {
+        heap_sift_down(&heap, i);
+    }
+
+    while (heap.count > 0) {
+        int d = heap.items[0];
+        fleet_device_t *dev = &run->devices[d];
+        uint64_t due = dev->next_due_ns;
+        if (due >= run->measure_end_ns) {
+            break;
+        }
+
+        sleep_until_ns(due);
+        uint64_t sent_at = now_ns();
+        if (due >= run->measure_start_ns) {
+            latencies_push(&p->lag, sent_at - due);
+        }
+
+        msg->device = (uint32_t)d;
+        msg->due_ns = due;
+        memcpy(&msg->report, &dev->report, sizeof(attestation_report_t));
+        if (opts->live_sign) {
+            msg->report.timestamp = (uint64_t)time(NULL);
+            pqc_result_t result = report_sign(&msg->report, &dev->keys.sk);
+            if (result != PQC_SUCCESS) {
+                p->status = result;
+                break;
+            }
+        }
+        if (transport_send(run->transport, p->channel, msg) != 0) {
+            p->status = PQC_ERROR_HARDWARE_FAILURE;
+            break;
+        }
+        dev->sent++;
+        p->sent++;
+
+        dev->next_due_ns = due + jittered_interval(dev->interval_ns, opts->jitter, &p->seed);
+        heap_sift_down(&heap, 0);
+    }
+
+    free(heap.items);
+    free(msg);
+    return NULL;
+}
+
+// ============================================================================
+// Verifiers
+// ============================================================================
+
+static void* verifier_main(void *arg) {
+    fleet_verifier_t *v = (fleet_verifier_t *)arg;
+    const fleet_run_t *run = v->run;
+
+    fleet_msg_t *msg = malloc(sizeof(fleet_msg_t));
+    if (!msg) {
+        return NULL;
+    }
+
+    while (transport_recv(run->transport, msg) == 0) {
+        const fleet_device_t *dev = &run->devices[msg->device];
+        attestation_verification_result_t outcome;
+
+        uint64_t t0 = now_ns();
+        pqc_result_t result = attestation_verify_report(&msg->report, &dev->keys.pk, &outcome);
+        uint64_t done = now_ns();
+
+        if (result != PQC_SUCCESS) {
+            v->errors++;
+        } else if (!outcome.is_valid) {
+            v->rejected++;
+        }
+
+        if (done >= run->measure_end_ns) {
+            v->drained++;
+        } else if (done >= run->measure_start_ns) {
+            v->verified++;
+        }
+        if (msg->due_ns >= run->measure_start_ns) {
+            latencies_push(&v->e2e, done - msg->due_ns);
+            latencies_push(&v->service, done - t0);
+        }
+    }
+
+    free(msg);
+    return NULL;
+}
+
+/**
+ * @brief Collect a daemon connection's results in place of a verifier
+ *
+ * The daemon verifies; this thread only times the round trip, so there are
+ * no service-time samples.
+ */
+static void* receiver_main(void *arg) {
+    fleet_verifier_t *v = (fleet_verifier_t *)arg;
+    const fleet_run_t *run = v->run;
+    uint64_t due;
+    verifier_result_t result;
+
+    while (transport_recv_result(run->transport, v->channel, &due, &result) == 0) {
+        uint64_t done = now_ns();
+        if (result.status != PQC_SUCCESS) {
+            v->errors++;
+        } else if (result.error_code != ATTESTATION_ERROR_NONE) {
+            v->rejected++;
+        }
+
+        if (done >= run->measure_end_ns) {
+            v->drained++;
+        } else if (done >= run->measure_start_ns) {
+            v->verified++;
+        }
+        if (due >= run->measure_start_ns) {
+            latencies_push(&v->e2e, done - due);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Register every device's public key with the daemon
+ *
+ * Sent one at a time on the first connection before the run starts, so
+ * enrollment never competes with reports.
+ */
+static int daemon_enroll(fleet_transport_t *t, const fleet_device_t *devices, size_t count) {
+    int fd = t->conns[0];
+    uint8_t *frame = t->frames[0];
+    verifier_frame_header_t header;
+    verifier_frame_header_init(&header, VERIFIER_FRAME_ENROLL, sizeof(verifier_enroll_t), 0);
+
+    for (size_t i = 0; i < count; i++) {
+        verifier_enroll_t enroll;
+        memcpy(enroll.device_id, devices[i].report.device_id, sizeof(enroll.device_id));
+        memcpy(&enroll.public_key, &devices[i].keys.pk, sizeof(enroll.public_key));
+        header.request_id = i;
+        memcpy(frame, &header, sizeof(header));
+        memcpy(frame + sizeof(header), &enroll, sizeof(enroll));
+
+        uint64_t request_id;
+        verifier_result_t result = { .status = PQC_ERROR_INTERNAL };
+        if (write_full(fd, frame, sizeof(header) + sizeof(enroll)) != 0 ||
+            transport_recv_result(t, 0, &request_id, &result) != 0 ||
+            request_id != i || result.status != PQC_SUCCESS) {
+            fprintf(stderr, "Failed to enroll device %zu with the daemon%s\n", i,
+                    result.status == PQC_ERROR_NOT_IMPLEMENTED
+                        ? "; start verifierd with --allow-enroll" : "");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+// Run
+// ============================================================================
+
+static int run_fleet(const fleet_options_t *opts, fleet_summary_t *summary) {
+    memset(summary, 0, sizeof(*summary));
+    size_t ndevices = (size_t)opts->devices;
+
+    size_t rss_before = resident_bytes();
+    fleet_device_t *devices = calloc(ndevices, sizeof(fleet_device_t));
+    if (!devices) {
+        fprintf(stderr, "Out of memory for %d devices\n", opts->devices);
+        return 1;
+    }
+    printf("Provisioning %d devices...\n", opts->devices);
+    for (size_t i = 0; i < ndevices; i++) {
+        if (device_init(&devices[i], (int)i, opts) != PQC_SUCCESS) {
+            fprintf(stderr, "Failed to provision device %zu\n", i);
+            free(devices);
+            return 1;
+        }
+    }
+    size_t rss_after = resident_bytes();
+    summary->device_bytes = sizeof(fleet_device_t);
+    if (rss_before && rss_after > rss_before) {
+        summary->rss_per_device = (double)(rss_after - rss_before) / (double)ndevices;
+    }
+
+    fleet_transport_t transport;
+    if (transport_init(&transport, opts) != 0) {
+        free(devices);
+        return 1;
+    }
+    if (opts->transport == FLEET_TRANSPORT_DAEMON &&
+        daemon_enroll(&transport, devices, ndevices) != 0) {
+        transport_destroy(&transport);
+        free(devices);
+        return 1;
+    }
+
+    // Headroom over the offered load so late completions are still recorded
+    size_t expected = (size_t)(opts->rate * (double)(opts->duration_ms + opts->warmup_ms) / 1000.0);
+    size_t capacity = expected * 2 + 1024;
+
+    fleet_producer_t *producers = aligned_alloc(FLEET_CACHE_LINE,
+                                                sizeof(fleet_producer_t) * (size_t)opts->producers);
+    fleet_verifier_t *verifiers = aligned_alloc(FLEET_CACHE_LINE,
+                                                sizeof(fleet_verifier_t) * (size_t)opts->verifiers);
+    if (!producers || !verifiers) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    memset(producers, 0, sizeof(fleet_producer_t) * (size_t)opts->producers);
+    memset(verifiers, 0, sizeof(fleet_verifier_t) * (size_t)opts->verifiers);
+
+    fleet_run_t run = { .opts = opts, .devices = devices, .transport = &transport };
+    run.start_ns = now_ns() + 10000000ULL;
+    run.measure_start_ns = run.start_ns + (uint64_t)opts->warmup_ms * 1000000ULL;
+    run.measure_end_ns = run.measure_start_ns + (uint64_t)opts->duration_ms * 1000000ULL;
+
+    for (int i = 0; i < opts->verifiers; i++) {
+        verifiers[i].run = &run;
+        verifiers[i].channel = i;
+        if (latencies_init(&verifiers[i].e2e, capacity) != 0 ||
+            latencies_init(&verifiers[i].service, capacity) != 0) {
+            fprintf(stderr, "Out of memory\n");
+            return 1;
+        }
+        pthread_create(&verifiers[i].thread, NULL,
+                       opts->transport == FLEET_TRANSPORT_DAEMON ? receiver_main : verifier_main,
+                       &verifiers[i]);
+    }
+
+    uint64_t seed_base = 0;
+    pqc_randombytes((uint8_t *)&seed_base, sizeof(seed_base));
+    for (int i = 0; i < opts->producers; i++) {
+        producers[i].run = &run;
+        producers[i].first = (int)(ndevices * (size_t)i / (size_t)opts->producers);
+        producers[i].last = (int)(ndevices * (size_t)(i + 1) / (size_t)opts->producers);
+        producers[i].seed = (seed_base ^ (0x9E3779B97F4A7C15ULL * (uint64_t)(i + 1))) | 1;
+        producers[i].channel = i;
+        if (latencies_init(&producers[i].lag, capacity) != 0) {
+            fprintf(stderr, "Out of memory\n");
+            return 1;
+        }
+        pthread_create(&producers[i].thread, NULL, producer_main, &producers[i]);
+    }
+
+    int exit_code = 0;
+    for (int i = 0; i < opts->producers; i++) {
+        pthread_join(producers[i].thread, NULL);
+        summary->sent += producers[i].sent;
+        if (producers[i].status != PQC_SUCCESS) {
+            fprintf(stderr, "Producer %d failed: %s\n", i,
+                    pqc_result_to_string(producers[i].status));
+            exit_code = 1;
+        }
+    }
+    transport_close(&transport);
+    for (int i = 0; i < opts->verifiers; i++) {
+        pthread_join(verifiers[i].thread, NULL);
+        summary->verified += verifiers[i].verified;
+        summary->drained += verifiers[i].drained;
+        summary->rejected += verifiers[i].rejected;
+        summary->errors += verifiers[i].errors;
+    }
+
+    merge_percentiles(&verifiers[0].e2e, (size_t)opts->verifiers, sizeof(fleet_verifier_t),
+                      &summary->e2e);
+    merge_percentiles(&verifiers[0].service, (size_t)opts->verifiers, sizeof(fleet_verifier_t),
+                      &summary->service);
+    merge_percentiles(&producers[0].lag, (size_t)opts->producers, sizeof(fleet_producer_t),
+                      &summary->lag);
+
+    summary->offered_rate = opts->rate;
+    summary->sustained_rate = (double)summary->verified * 1000.0 / (double)opts->duration_ms;
+    summary->saturated = summary->sustained_rate < FLEET_SATURATION_RATIO * opts->rate;
+    if (summary->rejected || summary->errors) {
+        exit_code = 1;
+    }
+
+    for (int i = 0; i < opts->verifiers; i++) {
+        latencies_free(&verifiers[i].e2e);
+        latencies_free(&verifiers[i].service);
+    }
+    for (int i = 0; i < opts->producers; i++) {
+        latencies_free(&producers[i].lag);
+    }
+    free(producers);
+    free(verifiers);
+    transport_destroy(&transport);
+    secure_memzero(devices, sizeof(fleet_device_t) * ndevices);
+    free(devices);
+    return exit_code;
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+static void print_percentiles(const char *name, const fleet_percentiles_t *p) {
+    printf("%-22s %10zu %10.1f %10.1f %10.1f %10.1f %10.1f\n", name, p->count,
+           p->p50 / 1000.0, p->p90 / 1000.0, p->p99 / 1000.0, p->p999 / 1000.0, p->max / 1000.0);
+}
+
+static void print_summary(const fleet_options_t *opts, const fleet_summary_t *s) {
+    printf("\nDevices: %d  producers: %d  %s: %d  transport: %s%s\n",
+           opts->devices, opts->producers,
+           opts->transport == FLEET_TRANSPORT_DAEMON ? "receivers" : "verifiers",
+           opts->verifiers, g_transport_names[opts->transport],
+           opts->live_sign ? "  (live signing)" : "");
+    printf("Offered:   %10.1f reports/s\n", s->offered_rate);
+    printf("Sustained: %10.1f reports/s%s\n", s->sustained_rate,
+           s->saturated ? "  SATURATED" : "");
+    printf("Sent %llu, verified in window %llu, drained after window %llu, "
+           "rejected %llu, errors %llu\n",
+           (unsigned long long)s->sent, (unsigned long long)s->verified,
+           (unsigned long long)s->drained, (unsigned long long)s->rejected,
+           (unsigned long long)s->errors);
+    printf("Memory per device: %zu bytes state", s->device_bytes);
+    if (s->rss_per_device > 0.0) {
+        printf(", %.0f bytes resident", s->rss_per_device);
+    }
+    printf("\n\n%-22s %10s %10s %10s %10s %10s %10s\n",
+           "latency (us)", "samples", "p50", "p90", "p99", "p99.9", "max");
+    print_percentiles("end_to_end", &s->e2e);
+    print_percentiles("verify", &s->service);
+    print_percentiles("producer_lag", &s->lag);
+}
+
+static void json_percentiles(FILE *out, const char *name, const fleet_percentiles_t *p,
+                             const char *sep) {
+    fprintf(out, "    \"%s\": {\"samples\": %zu, \"p50_ns\": %.0f, \"p90_ns\": %.0f, "
+                 "\"p99_ns\": %.0f, \"p999_ns\": %.0f, \"max_ns\": %.0f}%s\n",
+            name, p->count, p->p50, p->p90, p->p99, p->p999, p->max, sep);
+}
+
+static int write_json(const char *path, const fleet_options_t *opts, const fleet_summary_t *s) {
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        perror(path);
+        return -1;
+    }
+
+    bench_system_info_t sys;
+    bench_get_system_info(&sys);
+    char timestamp[40];
+    bench_format_timestamp(timestamp, sizeof(timestamp));
+
+    fprintf(out, "{\n  \"timestamp\": \"%s\",\n  \"system\": {\"cpu\": ", timestamp);
+    bench_json_string(out, sys.cpu);
+    fprintf(out, ", \"cores\": %d, \"architecture\": ", sys.cores);
+    bench_json_string(out, sys.architecture);
+    fprintf(out, "},\n");
+    fprintf(out, "  \"config\": {\"devices\": %d, \"rate\": %.2f, \"duration_ms\": %u, "
+                 "\"warmup_ms\": %u, \"jitter_pct\": %.1f, \"producers\": %d, \"verifiers\": %d, "
+                 "\"transport\": \"%s\", \"queue_depth\": %zu, \"measurements\": %u, "
+                 "\"live_sign\": %s},\n",
+            opts->devices, opts->rate, opts->duration_ms, opts->warmup_ms, opts->jitter,
+            opts->producers, opts->verifiers, g_transport_names[opts->transport],
+            opts->queue_depth, opts->measurements, opts->live_sign ? "true" : "false");
+    fprintf(out, "  \"throughput\": {\"offered_per_sec\": %.2f, \"sustained_per_sec\": %.2f, "
+                 "\"saturated\": %s, \"sent\": %llu, \"verified\": %llu, \"drained\": %llu, "
+                 "\"rejected\": %llu, \"errors\": %llu},\n",
+            s->offered_rate, s->sustained_rate, s->saturated ? "true" : "false",
+            (unsigned long long)s->sent, (unsigned long long)s->verified,
+            (unsigned long long)s->drained, (unsigned long long)s->rejected,
+            (unsigned long long)s->errors);
+    fprintf(out, "  \"latency\": {\n");
+    json_percentiles(out, "end_to_end", &s->e2e, ",");
+    json_percentiles(out, "verify", &s->service, ",");
+    json_percentiles(out, "producer_lag", &s->lag, "");
+    fprintf(out, "  },\n  \"memory\": {\"device_state_bytes\": %zu, ", s->device_bytes);
+    if (s->rss_per_device > 0.0) {
+        fprintf(out, "\"resident_bytes_per_device\": %.0f}\n", s->rss_per_device);
+    } else {
+        fprintf(out, "\"resident_bytes_per_device\": null}\n");
+    }
+    fprintf(out, "}\n");
+
+    fclose(out);
+    return 0;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --devices N        simulated devices (default %d)\n"
+            "  --rate R           aggregate reports per second (default %.0f)\n"
+            "  --duration-ms MS   measurement window (default %d)\n"
+            "  --warmup-ms MS     excluded from statistics (default %d)\n"
+            "  --jitter PCT       +/- interval jitter in percent (default %.0f)\n"
+            "  --producers P      device simulation threads (default 1)\n"
+            "  --verifiers V      verifier threads (default online CPUs - producers)\n"
+            "  --transport T      queue, socket or daemon (default queue)\n"
+            "  --connect PATH     verifierd Unix socket, required by --transport daemon\n"
+            "  --queue-depth D    reports in flight before producers block (default %d)\n"
+            "  --measurements M   measurements per report (default %d, max %d)\n"
+            "  --live-sign        sign every report instead of re-sending a pre-signed one\n"
+            "  --output FILE      also write results as JSON\n",
+            argv0, FLEET_DEFAULT_DEVICES, FLEET_DEFAULT_RATE, FLEET_DEFAULT_DURATION_MS,
+            FLEET_DEFAULT_WARMUP_MS, FLEET_DEFAULT_JITTER, FLEET_DEFAULT_QUEUE_DEPTH,
+            FLEET_DEFAULT_MEASUREMENTS, MAX_MEASUREMENTS_PER_REPORT);
+}
+
+static int parse_options(int argc, char **argv, fleet_options_t *opts) {
+    static const struct option long_opts[] = {
+        { "devices",      required_argument, NULL, 'n' },
+        { "rate",         required_argument, NULL, 'r' },
+        { "duration-ms",  required_argument, NULL, 'd' },
+        { "warmup-ms",    required_argument, NULL, 'w' },
+        { "jitter",       required_argument, NULL, 'j' },
+        { "producers",    required_argument, NULL, 'p' },
+        { "verifiers",    required_argument, NULL, 'v' },
+        { "transport",    required_argument, NULL, 't' },
+        { "connect",      required_argument, NULL, 'c' },
+        { "queue-depth",  required_argument, NULL, 'q' },
+        { "measurements", required_argument, NULL, 'm' },
+        { "live-sign",    no_argument,       NULL, 'l' },
+        { "output",       required_argument, NULL, 'o' },
+        { "help",         no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    opts->devices = FLEET_DEFAULT_DEVICES;
+    opts->rate = FLEET_DEFAULT_RATE;
+    opts->duration_ms = FLEET_DEFAULT_DURATION_MS;
+    opts->warmup_ms = FLEET_DEFAULT_WARMUP_MS;
+    opts->jitter = FLEET_DEFAULT_JITTER;
+    opts->producers = 1;
+    opts->verifiers = 0;
+    opts->transport = FLEET_TRANSPORT_QUEUE;
+    opts->connect = NULL;
+    opts->queue_depth = FLEET_DEFAULT_QUEUE_DEPTH;
+    opts->measurements = FLEET_DEFAULT_MEASUREMENTS;
+    opts->live_sign = false;
+    opts->output = NULL;
+
+    int c;
+    while ((c = getopt_long(argc, argv, "n:r:d:w:j:p:v:t:c:q:m:lo:h", long_opts, NULL)) != -1) {
+        switch (c) {
+            case 'n': opts->devices = atoi(optarg); break;
+            case 'r': opts->rate = atof(optarg); break;
+            case 'd': opts->duration_ms = (unsigned)strtoul(optarg, NULL, 10); break;
+            case 'w': opts->warmup_ms = (unsigned)strtoul(optarg, NULL, 10); break;
+            case 'j': opts->jitter = atof(optarg); break;
+            case 'p': opts->producers = atoi(optarg); break;
+            case 'v': opts->verifiers = atoi(optarg); break;
+            case 'q': opts->queue_depth = strtoul(optarg, NULL, 10); break;
+            case 'm': opts->measurements = (unsigned)strtoul(optarg, NULL, 10); break;
+            case 'l': opts->live_sign = true; break;
+            case 'o': opts->output = optarg; break;
+            case 'c': opts->connect = optarg; break;
+            case 't':
+                if (strcmp(optarg, "queue") == 0) {
+                    opts->transport = FLEET_TRANSPORT_QUEUE;
+                } else if (strcmp(optarg, "socket") == 0) {
+                    opts->transport = FLEET_TRANSPORT_SOCKET;
+                } else if (strcmp(optarg, "daemon") == 0) {
+                    opts->transport = FLEET_TRANSPORT_DAEMON;
+                } else {
+                    usage(argv[0]);
+                    return -1;
+                }
+                break;
+            default:
+                usage(argv[0]);
+                return -1;
+        }
+    }
+
+    if (opts->transport == FLEET_TRANSPORT_DAEMON) {
+        // One receiver per producer connection; the daemon does the verifying
+        opts->verifiers = opts->producers;
+    } else if (opts->verifiers == 0) {
+        opts->verifiers = bench_online_cpus() - opts->producers;
+        if (opts->verifiers < 1) {
+            opts->verifiers = 1;
+        }
+    }
+
+    if (opts->devices < 1 || opts->rate <= 0.0 || opts->duration_ms == 0 ||
+        opts->jitter < 0.0 || opts->jitter >= 100.0 || opts->producers < 1 ||
+        opts->producers > opts->devices || opts->verifiers < 1 || opts->queue_depth == 0 ||
+        opts->measurements > MAX_MEASUREMENTS_PER_REPORT ||
+        (opts->transport == FLEET_TRANSPORT_DAEMON && !opts->connect)) {
+        usage(argv[0]);
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    fleet_options_t opts;
+    if (parse_options(argc, argv, &opts) != 0) {
+        return 2;
+    }
+
+    if (pqc_init(NULL) != PQC_SUCCESS) {
+        fprintf(stderr, "pqc_init failed\n");
+        return 1;
+    }
+
+    fleet_summary_t summary;
+    int exit_code = run_fleet(&opts, &summary);
+    print_summary(&opts, &summary);
+
+    if (opts.output && write_json(opts.output, &opts, &summary) != 0) {
+        exit_code = 1;
+    }
+
+    pqc_cleanup();
+    return exit_code;
+}
@@ -0,0 +1,463 @@
+/**
+ * @file scaling_benchmark.c
+ * @brief Multi-core throughput scaling benchmark for the PQC primitives
+ *
+ * Runs Dilithium-5 sign/verify and Kyber-1024 encaps/decaps on 1, 2, 4 ... N
+ * threads, once with an independent key set per thread and once with a
+ * single key set shared by every thread. For each point it reports ops/sec,
+ * parallel efficiency relative to the single-thread run and the change in
+ * per-operation cache misses, and flags points that scale sub-linearly.
+ *
+ * A drop in efficiency that only appears in shared-key mode points at
+ * contention on the key structures; one that appears in both modes points
+ * at global library state (e.g. the statistics counters in pqc_common.c
+ * and secure_memory.c) being written from every thread.
+ *
+ * Usage: scaling_benchmark [--max-threads N] [--duration-ms MS]
+ *                          [--threshold EFF] [--filter SUBSTR] [--output FILE]
+ */
+
+#define _GNU_SOURCE
+
+#include "bench_common.h"
+#include "../src/crypto/pqc_common.h"
+#include "../src/crypto/kyber.h"
+#include "../src/crypto/dilithium.h"
+#include "../src/crypto/secure_memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <getopt.h>
+#include <time.h>
+
+#define SCALING_CACHE_LINE          64      /**< Worker slot alignment */
+#define SCALING_DEFAULT_DURATION_MS 1000    /**< Measurement window per point */
+#define SCALING_DEFAULT_THRESHOLD   0.80    /**< Efficiency below this is flagged */
+#define SCALING_MESSAGE_BYTES       32      /**< Signed message size */
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+/**
+ * @brief Key material and inputs for one key set
+ */
+typedef struct {
+    kyber_public_key_t kyber_pk;
+    kyber_secret_key_t kyber_sk;
+    kyber_ciphertext_t kyber_ct;
+    dilithium_public_key_t dilithium_pk;
+    dilithium_secret_key_t dilithium_sk;
+    uint8_t dilithium_sig[DILITHIUM_SIGNATUREBYTES];
+    size_t dilithium_siglen;
+    uint8_t message[SCALING_MESSAGE_BYTES];
+} scaling_keys_t;
+
+/**
+ * @brief Per-thread outputs, never shared between threads
+ */
+typedef struct {
+    kyber_ciphertext_t ct;
+    uint8_t ss[KYBER_SSBYTES];
+    uint8_t sig[DILITHIUM_SIGNATUREBYTES];
+    size_t siglen;
+} scaling_scratch_t;
+
+typedef pqc_result_t (*scaling_op_fn)(const scaling_keys_t *keys, scaling_scratch_t *scratch);
+
+/**
+ * @brief Operation under test
+ */
+typedef struct {
+    const char *name;
+    scaling_op_fn run;
+} scaling_op_t;
+
+/**
+ * @brief Worker thread state, padded to its own cache lines
+ */
+typedef struct {
+    _Alignas(SCALING_CACHE_LINE) pthread_t thread;
+    int index;
+    int cpu;
+    const scaling_op_t *op;
+    const scaling_keys_t *keys;
+    scaling_scratch_t *scratch;
+    pthread_barrier_t *start;
+    atomic_bool *stop;
+    uint64_t ops;
+    uint64_t cache_misses;
+    bool counter_ok;
+    pqc_result_t status;
+} scaling_worker_t;
+
+/**
+ * @brief Result for one (operation, mode, thread count) point
+ */
+typedef struct {
+    const char *op;
+    bool shared_keys;
+    int threads;
+    double ops_per_sec;
+    double efficiency;
+    double misses_per_op;
+    double miss_delta;
+    bool counters_valid;
+    bool sublinear;
+    pqc_result_t status;
+} scaling_point_t;
+
+typedef struct {
+    int max_threads;
+    unsigned duration_ms;
+    double threshold;
+    const char *filter;
+    const char *output;
+} scaling_options_t;
+
+// ============================================================================
+// Operations
+// ============================================================================
+
+static pqc_result_t op_sign(const scaling_keys_t *k, scaling_scratch_t *s) {
+    return dilithium_sign(s->sig, &s->siglen, k->message, sizeof(k->message), &k->dilithium_sk);
+}
+
+static pqc_result_t op_verify(const scaling_keys_t *k, scaling_scratch_t *s) {
+    (void)s;
+    return dilithium_verify(k->dilithium_sig, k->dilithium_siglen,
+                            k->message, sizeof(k->message), &k->dilithium_pk);
+}
+
+static pqc_result_t op_encaps(const scaling_keys_t *k, scaling_scratch_t *s) {
+    memset(&s->ct, 0, sizeof(s->ct));
+    return kyber_encapsulate(&s->ct, s->ss, &k->kyber_pk);
+}
+
+static pqc_result_t op_decaps(const scaling_keys_t *k, scaling_scratch_t *s) {
+    return kyber_decapsulate(s->ss, &k->kyber_ct, &k->kyber_sk);
+}
+
+static const scaling_op_t g_ops[] = {
+    { "dilithium_5.sign",   op_sign },
+    { "dilithium_5.verify", op_verify },
+    { "kyber_1024.encaps",  op_encaps },
+    { "kyber_1024.decaps",  op_decaps },
+};
+
+#define SCALING_OP_COUNT (sizeof(g_ops) / sizeof(g_ops[0]))
+
+static pqc_result_t keys_generate(scaling_keys_t *keys) {
+    pqc_result_t result = kyber_keypair(&keys->kyber_pk, &keys->kyber_sk);
+    if (result != PQC_SUCCESS) {
+        return result;
+    }
+
+    uint8_t ss[KYBER_SSBYTES];
+    result = kyber_encapsulate(&keys->kyber_ct, ss, &keys->kyber_pk);
+    secure_memzero(ss, sizeof(ss));
+    if (result != PQC_SUCCESS) {
+        return result;
+    }
+
+    result = dilithium_keypair(&keys->dilithium_pk, &keys->dilithium_sk);
+    if (result != PQC_SUCCESS) {
+        return result;
+    }
+
+    pqc_randombytes(keys->message, sizeof(keys->message));
+    return dilithium_sign(keys->dilithium_sig, &keys->dilithium_siglen,
+                          keys->message, sizeof(keys->message), &keys->dilithium_sk);
+}
+
+// ============================================================================
+// Workers
+// ============================================================================
+
+static void* worker_main(void *arg) {
+    scaling_worker_t *w = (scaling_worker_t *)arg;
+
+    bench_pin_to_cpu(w->cpu);
+    int fd = bench_cache_miss_counter_open();
+    w->counter_ok = fd >= 0;
+    w->status = PQC_SUCCESS;
+
+    pthread_barrier_wait(w->start);
+
+    uint64_t misses_start = bench_counter_read(fd);
+    uint64_t ops = 0;
+    while (!atomic_load_explicit(w->stop, memory_order_relaxed)) {
+        pqc_result_t status = w->op->run(w->keys, w->scratch);
+        if (status != PQC_SUCCESS) {
+            w->status = status;
+            break;
+        }
+        ops++;
+    }
+    w->cache_misses = bench_counter_read(fd) - misses_start;
+    w->ops = ops;
+
+    bench_counter_close(fd);
+    return NULL;
+}
+
+static void sleep_ms(unsigned ms) {
+    struct timespec ts = { .tv_sec = ms / 1000, .tv_nsec = (long)(ms % 1000) * 1000000L };
+    while (nanosleep(&ts, &ts) != 0) {
+    }
+}
+
+static pqc_result_t run_point(const scaling_op_t *op, int threads, bool shared,
+                              scaling_keys_t *keys, scaling_scratch_t *scratch,
+                              const scaling_options_t *opts, scaling_point_t *point) {
+    int cpus = bench_online_cpus();
+    scaling_worker_t *workers = aligned_alloc(SCALING_CACHE_LINE,
+                                              sizeof(scaling_worker_t) * (size_t)threads);
+    if (!workers) {
+        return PQC_ERROR_INSUFFICIENT_MEMORY;
+    }
+    memset(workers, 0, sizeof(scaling_worker_t) * (size_t)threads);
+
+    pthread_barrier_t start;
+    pthread_barrier_init(&start, NULL, (unsigned)threads + 1);
+    atomic_bool stop = false;
+
+    for (int i = 0; i < threads; i++) {
+        workers[i].index = i;
+        workers[i].cpu = i % cpus;
+        workers[i].op = op;
+        workers[i].keys = shared ? &keys[0] : &keys[i];
+        workers[i].scratch = &scratch[i];
+        workers[i].start = &start;
+        workers[i].stop = &stop;
+        pthread_create(&workers[i].thread, NULL, worker_main, &workers[i]);
+    }
+
+    pthread_barrier_wait(&start);
+    uint64_t t0 = bench_now_ns();
+    sleep_ms(opts->duration_ms);
+    atomic_store(&stop, true);
+
+    uint64_t total_ops = 0, total_misses = 0;
+    bool counters = true;
+    pqc_result_t status = PQC_SUCCESS;
+    for (int i = 0; i < threads; i++) {
+        pthread_join(workers[i].thread, NULL);
+        total_ops += workers[i].ops;
+        total_misses += workers[i].cache_misses;
+        counters = counters && workers[i].counter_ok;
+        if (workers[i].status != PQC_SUCCESS) {
+            status = workers[i].status;
+        }
+    }
+    uint64_t elapsed = bench_now_ns() - t0;
+
+    pthread_barrier_destroy(&start);
+    free(workers);
+
+    point->op = op->name;
+    point->shared_keys = shared;
+    point->threads = threads;
+    point->ops_per_sec = elapsed ? (double)total_ops * 1e9 / (double)elapsed : 0.0;
+    point->counters_valid = counters;
+    point->misses_per_op = (counters && total_ops) ? (double)total_misses / (double)total_ops : 0.0;
+    point->status = status;
+    return status;
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+static void print_point(const scaling_point_t *p) {
+    if (p->status != PQC_SUCCESS) {
+        printf("%-20s %-11s %7d FAILED: %s\n", p->op, p->shared_keys ? "shared" : "independent",
+               p->threads, pqc_result_to_string(p->status));
+        return;
+    }
+
+    char misses[32] = "n/a";
+    if (p->counters_valid) {
+        snprintf(misses, sizeof(misses), "%+.1f", p->miss_delta);
+    }
+    printf("%-20s %-11s %7d %12.1f %9.1f%% %14s %s\n", p->op,
+           p->shared_keys ? "shared" : "independent", p->threads, p->ops_per_sec,
+           100.0 * p->efficiency, misses, p->sublinear ? "SUBLINEAR" : "");
+}
+
+static int write_json(const char *path, const scaling_options_t *opts,
+                      const scaling_point_t *points, size_t count) {
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        perror(path);
+        return -1;
+    }
+
+    bench_system_info_t sys;
+    bench_get_system_info(&sys);
+    char timestamp[40];
+    bench_format_timestamp(timestamp, sizeof(timestamp));
+
+    fprintf(out, "{\n  \"timestamp\": \"%s\",\n  \"system\": {\"cpu\": ", timestamp);
+    bench_json_string(out, sys.cpu);
+    fprintf(out, ", \"cores\": %d, \"architecture\": ", sys.cores);
+    bench_json_string(out, sys.architecture);
+    fprintf(out, "},\n  \"duration_ms\": %u,\n  \"efficiency_threshold\": %.2f,\n",
+            opts->duration_ms, opts->threshold);
+    fprintf(out, "  \"scaling\": [\n");
+    for (size_t i = 0; i < count; i++) {
+        const scaling_point_t *p = &points[i];
+        fprintf(out, "    {\"operation\": \"%s\", \"keys\": \"%s\", \"threads\": %d, "
+                     "\"status\": ", p->op, p->shared_keys ? "shared" : "independent", p->threads);
+        bench_json_string(out, pqc_result_to_string(p->status));
+        fprintf(out, ", \"ops_per_sec\": %.2f, \"parallel_efficiency\": %.4f, ",
+                p->ops_per_sec, p->efficiency);
+        if (p->counters_valid) {
+            fprintf(out, "\"cache_misses_per_op\": %.2f, \"cache_miss_delta_per_op\": %.2f, ",
+                    p->misses_per_op, p->miss_delta);
+        } else {
+            fprintf(out, "\"cache_misses_per_op\": null, \"cache_miss_delta_per_op\": null, ");
+        }
+        fprintf(out, "\"sublinear\": %s}%s\n", p->sublinear ? "true" : "false",
+                i + 1 < count ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+
+    fclose(out);
+    return 0;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --max-threads N   largest thread count (default: online CPUs)\n"
+            "  --duration-ms MS  measurement window per point (default %d)\n"
+            "  --threshold EFF   flag efficiency below EFF (default %.2f)\n"
+            "  --filter STR      only run operations whose name contains STR\n"
+            "  --output FILE     also write results as JSON\n",
+            argv0, SCALING_DEFAULT_DURATION_MS, SCALING_DEFAULT_THRESHOLD);
+}
+
+static int parse_options(int argc, char **argv, scaling_options_t *opts) {
+    static const struct option long_opts[] = {
+        { "max-threads", required_argument, NULL, 't' },
+        { "duration-ms", required_argument, NULL, 'd' },
+        { "threshold",   required_argument, NULL, 'e' },
+        { "filter",      required_argument, NULL, 'f' },
+        { "output",      required_argument, NULL, 'o' },
+        { "help",        no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    opts->max_threads = bench_online_cpus();
+    opts->duration_ms = SCALING_DEFAULT_DURATION_MS;
+    opts->threshold = SCALING_DEFAULT_THRESHOLD;
+    opts->filter = NULL;
+    opts->output = NULL;
+
+    int c;
+    while ((c = getopt_long(argc, argv, "t:d:e:f:o:h", long_opts, NULL)) != -1) {
+        switch (c) {
+            case 't': opts->max_threads = atoi(optarg); break;
+            case 'd': opts->duration_ms = (unsigned)strtoul(optarg, NULL, 10); break;
+            case 'e': opts->threshold = atof(optarg); break;
+            case 'f': opts->filter = optarg; break;
+            case 'o': opts->output = optarg; break;
+            default:
+                usage(argv[0]);
+                return -1;
+        }
+    }
+
+    if (opts->max_threads < 1 || opts->duration_ms == 0) {
+        usage(argv[0]);
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    scaling_options_t opts;
+    if (parse_options(argc, argv, &opts) != 0) {
+        return 2;
+    }
+
+    if (pqc_init(NULL) != PQC_SUCCESS) {
+        fprintf(stderr, "pqc_init failed\n");
+        return 1;
+    }
+
+    // Thread counts: 1, 2, 4 ... and max_threads itself if not a power of two
+    int counts[32];
+    size_t ncounts = 0;
+    for (int t = 1; t < opts.max_threads && ncounts < 31; t <<= 1) {
+        counts[ncounts++] = t;
+    }
+    counts[ncounts++] = opts.max_threads;
+
+    size_t nthreads = (size_t)opts.max_threads;
+    scaling_keys_t *keys = calloc(nthreads, sizeof(scaling_keys_t));
+    scaling_scratch_t *scratch = aligned_alloc(SCALING_CACHE_LINE,
+        ((sizeof(scaling_scratch_t) * nthreads + SCALING_CACHE_LINE - 1) / SCALING_CACHE_LINE) *
+        SCALING_CACHE_LINE);
+    scaling_point_t *points = calloc(SCALING_OP_COUNT * 2 * ncounts, sizeof(scaling_point_t));
+    if (!keys || !scratch || !points) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < nthreads; i++) {
+        if (keys_generate(&keys[i]) != PQC_SUCCESS) {
+            fprintf(stderr, "Failed to generate key set %zu\n", i);
+            return 1;
+        }
+    }
+
+    printf("%-20s %-11s %7s %12s %10s %14s\n",
+           "operation", "keys", "threads", "ops/sec", "efficiency", "miss_delta/op");
+
+    size_t npoints = 0;
+    int exit_code = 0;
+    for (size_t o = 0; o < SCALING_OP_COUNT; o++) {
+        if (opts.filter && !strstr(g_ops[o].name, opts.filter)) {
+            continue;
+        }
+        for (int mode = 0; mode < 2; mode++) {
+            bool shared = mode == 1;
+            scaling_point_t *base = &points[npoints];
+            for (size_t c = 0; c < ncounts; c++) {
+                scaling_point_t *p = &points[npoints++];
+                run_point(&g_ops[o], counts[c], shared, keys, scratch, &opts, p);
+
+                if (p->status == PQC_SUCCESS && base->status == PQC_SUCCESS &&
+                    base->ops_per_sec > 0.0) {
+                    p->efficiency = p->ops_per_sec / (base->ops_per_sec * (double)p->threads);
+                    p->miss_delta = p->misses_per_op - base->misses_per_op;
+                    p->counters_valid = p->counters_valid && base->counters_valid;
+                    p->sublinear = p->threads > 1 && p->efficiency < opts.threshold;
+                }
+                if (p->status != PQC_SUCCESS) {
+                    exit_code = 1;
+                }
+                print_point(p);
+            }
+        }
+    }
+
+    if (opts.output && write_json(opts.output, &opts, points, npoints) != 0) {
+        exit_code = 1;
+    }
+
+    secure_memzero(keys, sizeof(scaling_keys_t) * nthreads);
+    free(keys);
+    free(scratch);
+    free(points);
+    pqc_cleanup();
+    return exit_code;
+}
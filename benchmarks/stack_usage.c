@@ -0,0 +1,800 @@
+/**
+ * @file stack_usage.c
+ * @brief Stack high-water-mark measurement for the public entry points
+ *
+ * Runs each public function on a dedicated stack created with makecontext(),
+ * painted with a known pattern and protected by a guard page at its low
+ * end. After the call, the deepest byte that no longer holds the pattern
+ * gives the maximum depth reached. Touching the guard page is caught by a
+ * SIGSEGV handler running on a sigaltstack and reported as an overflow
+ * instead of crashing the harness.
+ *
+ * The cost of the context trampoline itself is measured with an empty
+ * entry and subtracted, so the reported figure is what the function and its
+ * callees need on top of the caller's frame. Results depend on compiler,
+ * flags and architecture and are therefore recorded per build profile; use
+ * the numbers from the profile that matches the firmware or verifier build
+ * when sizing RTOS task or thread stacks.
+ *
+ * Budgets are read from a file of "<entry> <bytes>[K|M]" lines (see
+ * benchmarks/stack_budgets.conf) and/or --budget options; the harness exits
+ * with status 1 if any entry exceeds its budget or overflows.
+ *
+ * Usage: stack_usage [--stack-size BYTES] [--repeat N] [--profile NAME]
+ *                    [--budgets FILE] [--budget NAME=BYTES]...
+ *                    [--filter SUBSTR] [--output FILE] [--list]
+ */
+
+#define _GNU_SOURCE
+
+#include "bench_common.h"
+#include "../src/crypto/pqc_common.h"
+#include "../src/crypto/kyber.h"
+#include "../src/crypto/dilithium.h"
+#include "../src/crypto/falcon.h"
+#include "../src/crypto/sphincs.h"
+#include "../src/crypto/lms.h"
+#include "../src/crypto/secure_memory.h"
+#include "../src/attestation/attestation_engine.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <setjmp.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <getopt.h>
+
+#define STACK_DEFAULT_SIZE      (1024 * 1024)   /**< Measurement stack size */
+#define STACK_DEFAULT_REPEAT    4               /**< Runs per entry (max is kept) */
+#define STACK_PAINT_BYTE        0xA5            /**< Paint pattern */
+#define STACK_MAX_BUDGETS       64              /**< Budget table size */
+#define STACK_HASH_BYTES        1024            /**< Hash input size */
+#define STACK_MEMORY_BYTES      4096            /**< Secure memory operation size */
+#define STACK_HSS_SIG_BYTES     20480           /**< Room for a two-level W1 HSS signature */
+
+#ifdef NDEBUG
+#define STACK_DEFAULT_PROFILE   "release"
+#else
+#define STACK_DEFAULT_PROFILE   "debug"
+#endif
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+/**
+ * @brief Inputs for all entry points, kept off the measured stack
+ */
+typedef struct {
+    kyber_public_key_t kyber_pk;
+    kyber_secret_key_t kyber_sk;
+    kyber_ciphertext_t kyber_ct;
+    uint8_t kyber_ss[KYBER_SSBYTES];
+    dilithium_public_key_t dilithium_pk;
+    dilithium_secret_key_t dilithium_sk;
+    dilithium_expanded_public_key_t dilithium_epk;
+    uint8_t dilithium_sig[DILITHIUM_SIGNATUREBYTES];
+    size_t dilithium_siglen;
+    uint8_t falcon_pk[FALCON_1024_PUBLICKEYBYTES];
+    uint8_t falcon_sk[FALCON_1024_SECRETKEYBYTES];
+    uint8_t falcon_sig[FALCON_1024_SIGNATUREBYTES];
+    size_t falcon_siglen;
+    uint8_t sphincs_pk[SPHINCS_SHA256_256F_PUBLICKEYBYTES];
+    uint8_t sphincs_sk[SPHINCS_SHA256_256F_SECRETKEYBYTES];
+    uint8_t sphincs_sig[SPHINCS_SHA256_256F_SIGNATUREBYTES];
+    size_t sphincs_siglen;
+    uint8_t hss_pk[HSS_PUBLICKEYBYTES];
+    uint8_t hss_sk[HSS_SECRETKEYBYTES];
+    uint8_t hss_sig[STACK_HSS_SIG_BYTES];
+    size_t hss_siglen;
+    uint8_t hss_nv[HSS_NV_RECORD_BYTES];
+    uint8_t message[32];
+    uint8_t hash_input[STACK_HASH_BYTES];
+    uint8_t hash_output[64];
+    uint8_t mem_a[STACK_MEMORY_BYTES];
+    uint8_t mem_b[STACK_MEMORY_BYTES];
+    attestation_report_t report;
+    attestation_verification_result_t verification;
+} stack_inputs_t;
+
+typedef pqc_result_t (*stack_entry_fn)(stack_inputs_t *in);
+
+/**
+ * @brief Measured entry point
+ */
+typedef struct {
+    const char *name;                   /**< Entry name (matches budget file) */
+    stack_entry_fn run;                 /**< Calls the public function */
+} stack_entry_t;
+
+/**
+ * @brief Per-entry budget
+ */
+typedef struct {
+    char name[BENCH_MAX_NAME_LENGTH];
+    size_t bytes;
+} stack_budget_t;
+
+/**
+ * @brief Measurement result for one entry
+ */
+typedef struct {
+    const stack_entry_t *entry;
+    size_t bytes;                       /**< High-water mark minus trampoline cost */
+    size_t budget;                      /**< 0 if none configured */
+    pqc_result_t status;                /**< Return code of the last run */
+    bool overflow;                      /**< Guard page was hit */
+} stack_result_t;
+
+/**
+ * @brief Harness options
+ */
+typedef struct {
+    size_t stack_size;
+    int repeat;
+    const char *profile;
+    const char *filter;
+    const char *output;
+    bool list_only;
+    stack_budget_t budgets[STACK_MAX_BUDGETS];
+    size_t budget_count;
+} stack_options_t;
+
+// ============================================================================
+// Entry Points
+// ============================================================================
+
+static pqc_result_t entry_noop(stack_inputs_t *in) {
+    (void)in;
+    return PQC_SUCCESS;
+}
+
+static pqc_result_t entry_kyber_keypair(stack_inputs_t *in) {
+    return kyber_keypair(&in->kyber_pk, &in->kyber_sk);
+}
+
+static pqc_result_t entry_kyber_encaps(stack_inputs_t *in) {
+    return kyber_encapsulate(&in->kyber_ct, in->kyber_ss, &in->kyber_pk);
+}
+
+static pqc_result_t entry_kyber_decaps(stack_inputs_t *in) {
+    return kyber_decapsulate(in->kyber_ss, &in->kyber_ct, &in->kyber_sk);
+}
+
+static pqc_result_t entry_dilithium_keypair(stack_inputs_t *in) {
+    return dilithium_keypair(&in->dilithium_pk, &in->dilithium_sk);
+}
+
+static pqc_result_t entry_dilithium_sign(stack_inputs_t *in) {
+    return dilithium_sign(in->dilithium_sig, &in->dilithium_siglen,
+                          in->message, sizeof(in->message), &in->dilithium_sk);
+}
+
+static pqc_result_t entry_dilithium_verify(stack_inputs_t *in) {
+    return dilithium_verify(in->dilithium_sig, in->dilithium_siglen,
+                            in->message, sizeof(in->message), &in->dilithium_pk);
+}
+
+static pqc_result_t entry_dilithium_verify_expanded(stack_inputs_t *in) {
+    return dilithium_verify_expanded(in->dilithium_sig, in->dilithium_siglen,
+                                     in->message, sizeof(in->message), &in->dilithium_epk);
+}
+
+static pqc_result_t entry_falcon_keypair(stack_inputs_t *in) {
+    return falcon_keypair(PQC_ALG_FALCON_1024, in->falcon_pk, in->falcon_sk);
+}
+
+static pqc_result_t entry_falcon_sign(stack_inputs_t *in) {
+    return falcon_sign(in->falcon_sig, &in->falcon_siglen, in->message, sizeof(in->message),
+                       in->falcon_sk, sizeof(in->falcon_sk));
+}
+
+static pqc_result_t entry_falcon_verify(stack_inputs_t *in) {
+    return falcon_verify(in->falcon_sig, in->falcon_siglen, in->message, sizeof(in->message),
+                         in->falcon_pk, sizeof(in->falcon_pk));
+}
+
+static pqc_result_t entry_sphincs_keypair(stack_inputs_t *in) {
+    return sphincs_keypair(PQC_ALG_SPHINCS_SHA256_256F, in->sphincs_pk, in->sphincs_sk);
+}
+
+static pqc_result_t entry_sphincs_sign(stack_inputs_t *in) {
+    // Single-threaded, so the subtree work runs on the measured stack
+    sphincs_set_threads(1);
+    pqc_result_t rc = sphincs_sign(in->sphincs_sig, &in->sphincs_siglen, in->message,
+                                   sizeof(in->message), in->sphincs_sk, sizeof(in->sphincs_sk));
+    sphincs_set_threads(0);
+    return rc;
+}
+
+static pqc_result_t entry_sphincs_verify(stack_inputs_t *in) {
+    return sphincs_verify(in->sphincs_sig, in->sphincs_siglen, in->message, sizeof(in->message),
+                          in->sphincs_pk, sizeof(in->sphincs_pk));
+}
+
+static pqc_result_t entry_hss_verify(stack_inputs_t *in) {
+    return hss_verify(in->hss_sig, in->hss_siglen, in->message, sizeof(in->message),
+                      in->hss_pk, sizeof(in->hss_pk));
+}
+
+static pqc_result_t entry_sha3_256(stack_inputs_t *in) {
+    return sha3_256(in->hash_output, in->hash_input, sizeof(in->hash_input));
+}
+
+static pqc_result_t entry_sha3_512(stack_inputs_t *in) {
+    return sha3_512(in->hash_output, in->hash_input, sizeof(in->hash_input));
+}
+
+static pqc_result_t entry_shake128(stack_inputs_t *in) {
+    return shake128(in->hash_output, sizeof(in->hash_output), in->hash_input, 34);
+}
+
+static pqc_result_t entry_shake256(stack_inputs_t *in) {
+    return shake256(in->hash_output, sizeof(in->hash_output), in->hash_input, 32,
+                    in->hash_input + 32, 2);
+}
+
+static pqc_result_t entry_secure_memcmp(stack_inputs_t *in) {
+    volatile int r = secure_memcmp(in->mem_a, in->mem_b, sizeof(in->mem_a));
+    (void)r;
+    return PQC_SUCCESS;
+}
+
+static pqc_result_t entry_secure_memcpy_conditional(stack_inputs_t *in) {
+    secure_memcpy_conditional(in->mem_b, in->mem_a, sizeof(in->mem_b), 1);
+    return PQC_SUCCESS;
+}
+
+static pqc_result_t entry_attestation_verify_report(stack_inputs_t *in) {
+    return attestation_verify_report(&in->report, &in->dilithium_pk, &in->verification);
+}
+
+static const stack_entry_t g_noop = { "noop", entry_noop };
+
+static const stack_entry_t g_entries[] = {
+    { "kyber_keypair",               entry_kyber_keypair },
+    { "kyber_encapsulate",           entry_kyber_encaps },
+    { "kyber_decapsulate",           entry_kyber_decaps },
+    { "dilithium_keypair",           entry_dilithium_keypair },
+    { "dilithium_sign",              entry_dilithium_sign },
+    { "dilithium_verify",            entry_dilithium_verify },
+    { "dilithium_verify_expanded",   entry_dilithium_verify_expanded },
+    { "falcon_keypair",              entry_falcon_keypair },
+    { "falcon_sign",                 entry_falcon_sign },
+    { "falcon_verify",               entry_falcon_verify },
+    { "sphincs_keypair",             entry_sphincs_keypair },
+    { "sphincs_sign",                entry_sphincs_sign },
+    { "sphincs_verify",              entry_sphincs_verify },
+    { "hss_verify",                  entry_hss_verify },
+    { "sha3_256",                    entry_sha3_256 },
+    { "sha3_512",                    entry_sha3_512 },
+    { "shake128",                    entry_shake128 },
+    { "shake256",                    entry_shake256 },
+    { "secure_memcmp",               entry_secure_memcmp },
+    { "secure_memcpy_conditional",   entry_secure_memcpy_conditional },
+    { "attestation_verify_report",   entry_attestation_verify_report },
+};
+
+#define STACK_ENTRY_COUNT (sizeof(g_entries) / sizeof(g_entries[0]))
+
+// ============================================================================
+// Measurement
+// ============================================================================
+
+static ucontext_t g_main_ctx;
+static ucontext_t g_entry_ctx;
+static sigjmp_buf g_overflow_jmp;
+static volatile sig_atomic_t g_in_entry = 0;
+static const stack_entry_t *g_current_entry;
+static stack_inputs_t *g_current_inputs;
+static pqc_result_t g_current_status;
+
+static void entry_trampoline(void) {
+    g_current_status = g_current_entry->run(g_current_inputs);
+}
+
+static void overflow_handler(int sig) {
+    if (g_in_entry) {
+        siglongjmp(g_overflow_jmp, 1);
+    }
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+static int install_overflow_handler(void) {
+    static uint8_t alt_stack[64 * 1024];
+    stack_t ss;
+    ss.ss_sp = alt_stack;
+    ss.ss_size = sizeof(alt_stack);
+    ss.ss_flags = 0;
+    if (sigaltstack(&ss, NULL) != 0) {
+        return -1;
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = overflow_handler;
+    sa.sa_flags = SA_ONSTACK;
+    sigemptyset(&sa.sa_mask);
+    return sigaction(SIGSEGV, &sa, NULL) == 0 && sigaction(SIGBUS, &sa, NULL) == 0 ? 0 : -1;
+}
+
+/**
+ * @brief Run one entry on a freshly painted stack
+ *
+ * @param[in] stack Usable stack region (above the guard page)
+ * @param[in] size Size of the usable region
+ * @param[out] used Deepest byte touched, measured from the top of the stack
+ * @return 0 on success, 1 on overflow, -1 on setup failure
+ */
+static int measure_once(const stack_entry_t *entry, stack_inputs_t *inputs,
+                        uint8_t *stack, volatile size_t size, size_t *used) {
+    // size is read after getcontext()/sigsetjmp() return a second time, so it
+    // must not live only in a register they restore
+    memset(stack, STACK_PAINT_BYTE, size);
+
+    if (getcontext(&g_entry_ctx) != 0) {
+        return -1;
+    }
+    g_entry_ctx.uc_stack.ss_sp = stack;
+    g_entry_ctx.uc_stack.ss_size = size;
+    g_entry_ctx.uc_link = &g_main_ctx;
+    makecontext(&g_entry_ctx, entry_trampoline, 0);
+
+    g_current_entry = entry;
+    g_current_inputs = inputs;
+    g_current_status = PQC_ERROR_INTERNAL;
+
+    if (sigsetjmp(g_overflow_jmp, 1) != 0) {
+        g_in_entry = 0;
+        *used = size;
+        return 1;
+    }
+
+    g_in_entry = 1;
+    if (swapcontext(&g_main_ctx, &g_entry_ctx) != 0) {
+        g_in_entry = 0;
+        return -1;
+    }
+    g_in_entry = 0;
+
+    // The stack grows down: the first modified byte from the bottom is the high-water mark
+    size_t untouched = 0;
+    while (untouched < size && stack[untouched] == STACK_PAINT_BYTE) {
+        untouched++;
+    }
+    *used = size - untouched;
+    return 0;
+}
+
+static int measure_entry(const stack_entry_t *entry, stack_inputs_t *inputs,
+                         uint8_t *stack, size_t size, int repeat, size_t baseline,
+                         stack_result_t *result) {
+    size_t max_used = 0;
+    result->entry = entry;
+    result->overflow = false;
+
+    // One call on the normal stack first: in a shared-library build the
+    // lazy PLT resolver saves the full vector state (~3 KiB) on first use
+    entry->run(inputs);
+
+    for (int i = 0; i < repeat; i++) {
+        size_t used = 0;
+        int rc = measure_once(entry, inputs, stack, size, &used);
+        if (rc < 0) {
+            return -1;
+        }
+        if (rc > 0) {
+            result->overflow = true;
+        }
+        if (used > max_used) {
+            max_used = used;
+        }
+        result->status = g_current_status;
+    }
+
+    result->bytes = max_used > baseline ? max_used - baseline : 0;
+    return 0;
+}
+
+// ============================================================================
+// Budgets
+// ============================================================================
+
+static bool parse_size(const char *text, size_t *bytes) {
+    char *end = NULL;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (end == text) {
+        return false;
+    }
+    if (*end == 'K' || *end == 'k') {
+        value *= 1024;
+        end++;
+    } else if (*end == 'M' || *end == 'm') {
+        value *= 1024 * 1024;
+        end++;
+    }
+    *bytes = (size_t)value;
+    return *end == '\0' || *end == '\n' || *end == ' ' || *end == '\t';
+}
+
+static int add_budget(stack_options_t *opts, const char *name, const char *size) {
+    size_t bytes;
+    if (!parse_size(size, &bytes)) {
+        fprintf(stderr, "Invalid budget size for %s: %s\n", name, size);
+        return -1;
+    }
+
+    // Later definitions override earlier ones (command line after file)
+    for (size_t i = 0; i < opts->budget_count; i++) {
+        if (strcmp(opts->budgets[i].name, name) == 0) {
+            opts->budgets[i].bytes = bytes;
+            return 0;
+        }
+    }
+    if (opts->budget_count == STACK_MAX_BUDGETS) {
+        fprintf(stderr, "Too many budgets\n");
+        return -1;
+    }
+    snprintf(opts->budgets[opts->budget_count].name,
+             sizeof(opts->budgets[opts->budget_count].name), "%s", name);
+    opts->budgets[opts->budget_count].bytes = bytes;
+    opts->budget_count++;
+    return 0;
+}
+
+static int load_budgets(stack_options_t *opts, const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+
+    char line[256];
+    int rc = 0;
+    while (rc == 0 && fgets(line, sizeof(line), f)) {
+        char name[BENCH_MAX_NAME_LENGTH], size[32];
+        char *hash = strchr(line, '#');
+        if (hash) {
+            *hash = '\0';
+        }
+        if (sscanf(line, "%63s %31s", name, size) == 2) {
+            rc = add_budget(opts, name, size);
+        }
+    }
+
+    fclose(f);
+    return rc;
+}
+
+static size_t find_budget(const stack_options_t *opts, const char *name) {
+    for (size_t i = 0; i < opts->budget_count; i++) {
+        if (strcmp(opts->budgets[i].name, name) == 0) {
+            return opts->budgets[i].bytes;
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+static const char* verdict(const stack_result_t *r) {
+    if (r->overflow) {
+        return "OVERFLOW";
+    }
+    if (r->budget && r->bytes > r->budget) {
+        return "OVER BUDGET";
+    }
+    return r->budget ? "ok" : "no budget";
+}
+
+static void print_table(const stack_result_t *results, size_t count) {
+    printf("%-30s %12s %12s %7s  %s\n", "entry", "stack_bytes", "budget", "used%", "verdict");
+    for (size_t i = 0; i < count; i++) {
+        const stack_result_t *r = &results[i];
+        if (r->budget) {
+            printf("%-30s %12zu %12zu %6.1f%%  %s\n", r->entry->name, r->bytes, r->budget,
+                   100.0 * (double)r->bytes / (double)r->budget, verdict(r));
+        } else {
+            printf("%-30s %12zu %12s %7s  %s\n", r->entry->name, r->bytes, "-", "-", verdict(r));
+        }
+    }
+}
+
+static int write_report(const char *path, const stack_options_t *opts, size_t baseline,
+                        const stack_result_t *results, size_t count) {
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        perror(path);
+        return -1;
+    }
+
+    bench_system_info_t sys;
+    bench_get_system_info(&sys);
+    char timestamp[40];
+    bench_format_timestamp(timestamp, sizeof(timestamp));
+
+    fprintf(out, "{\n  \"timestamp\": \"%s\",\n", timestamp);
+    fprintf(out, "  \"profile\": ");
+    bench_json_string(out, opts->profile);
+    fprintf(out, ",\n  \"compiler\": ");
+    bench_json_string(out, __VERSION__);
+#ifdef __OPTIMIZE__
+    fprintf(out, ",\n  \"optimized\": true");
+#else
+    fprintf(out, ",\n  \"optimized\": false");
+#endif
+    fprintf(out, ",\n  \"architecture\": ");
+    bench_json_string(out, sys.architecture);
+    fprintf(out, ",\n  \"stack_size\": %zu,\n", opts->stack_size);
+    fprintf(out, "  \"trampoline_bytes\": %zu,\n", baseline);
+
+    size_t failures = 0;
+    fprintf(out, "  \"entries\": [\n");
+    for (size_t i = 0; i < count; i++) {
+        const stack_result_t *r = &results[i];
+        bool failed = r->overflow || (r->budget && r->bytes > r->budget);
+        if (failed) {
+            failures++;
+        }
+        fprintf(out, "    {\"name\": \"%s\", \"stack_bytes\": %zu, ", r->entry->name, r->bytes);
+        if (r->budget) {
+            fprintf(out, "\"budget\": %zu, ", r->budget);
+        } else {
+            fprintf(out, "\"budget\": null, ");
+        }
+        fprintf(out, "\"overflow\": %s, \"status\": ", r->overflow ? "true" : "false");
+        bench_json_string(out, pqc_result_to_string(r->status));
+        fprintf(out, ", \"verdict\": \"%s\"}%s\n", verdict(r), i + 1 < count ? "," : "");
+    }
+    fprintf(out, "  ],\n");
+    fprintf(out, "  \"status\": \"%s\"\n}\n", failures ? "over_budget" : "within_budget");
+
+    fclose(out);
+    return 0;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --stack-size BYTES  measurement stack size (default %d)\n"
+            "  --repeat N          runs per entry, maximum is reported (default %d)\n"
+            "  --profile NAME      build profile recorded in the report (default %s)\n"
+            "  --budgets FILE      read '<entry> <bytes>[K|M]' budget lines from FILE\n"
+            "  --budget NAME=SIZE  budget for one entry (repeatable)\n"
+            "  --filter STR        only measure entries whose name contains STR\n"
+            "  --output FILE       JSON report path (default stack_usage.json)\n"
+            "  --list              list entries and exit\n",
+            argv0, STACK_DEFAULT_SIZE, STACK_DEFAULT_REPEAT, STACK_DEFAULT_PROFILE);
+}
+
+static int parse_options(int argc, char **argv, stack_options_t *opts) {
+    static const struct option long_opts[] = {
+        { "stack-size", required_argument, NULL, 's' },
+        { "repeat",     required_argument, NULL, 'r' },
+        { "profile",    required_argument, NULL, 'p' },
+        { "budgets",    required_argument, NULL, 'B' },
+        { "budget",     required_argument, NULL, 'b' },
+        { "filter",     required_argument, NULL, 'f' },
+        { "output",     required_argument, NULL, 'o' },
+        { "list",       no_argument,       NULL, 'l' },
+        { "help",       no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    memset(opts, 0, sizeof(*opts));
+    opts->stack_size = STACK_DEFAULT_SIZE;
+    opts->repeat = STACK_DEFAULT_REPEAT;
+    opts->profile = STACK_DEFAULT_PROFILE;
+    opts->output = "stack_usage.json";
+
+    int c;
+    while ((c = getopt_long(argc, argv, "s:r:p:B:b:f:o:lh", long_opts, NULL)) != -1) {
+        switch (c) {
+            case 's':
+                if (!parse_size(optarg, &opts->stack_size)) {
+                    fprintf(stderr, "Invalid --stack-size: %s\n", optarg);
+                    return -1;
+                }
+                break;
+            case 'r': opts->repeat = atoi(optarg); break;
+            case 'p': opts->profile = optarg; break;
+            case 'B':
+                if (load_budgets(opts, optarg) != 0) {
+                    return -1;
+                }
+                break;
+            case 'b': {
+                char *eq = strchr(optarg, '=');
+                if (!eq) {
+                    fprintf(stderr, "--budget expects NAME=SIZE\n");
+                    return -1;
+                }
+                *eq = '\0';
+                if (add_budget(opts, optarg, eq + 1) != 0) {
+                    return -1;
+                }
+                break;
+            }
+            case 'f': opts->filter = optarg; break;
+            case 'o': opts->output = optarg; break;
+            case 'l': opts->list_only = true; break;
+            default:
+                usage(argv[0]);
+                return -1;
+        }
+    }
+
+    if (opts->repeat < 1 || opts->stack_size < 64 * 1024) {
+        fprintf(stderr, "--repeat must be positive and --stack-size at least 64K\n");
+        return -1;
+    }
+    return 0;
+}
+
+static pqc_result_t hss_memory_read(void *ctx, uint8_t record[HSS_NV_RECORD_BYTES]) {
+    memcpy(record, ((stack_inputs_t *)ctx)->hss_nv, HSS_NV_RECORD_BYTES);
+    return PQC_SUCCESS;
+}
+
+static pqc_result_t hss_memory_write(void *ctx, const uint8_t record[HSS_NV_RECORD_BYTES]) {
+    memcpy(((stack_inputs_t *)ctx)->hss_nv, record, HSS_NV_RECORD_BYTES);
+    return PQC_SUCCESS;
+}
+
+/**
+ * @brief HSS signature with W1 on both levels, the deepest verifier stack
+ */
+static pqc_result_t prepare_hss(stack_inputs_t *in) {
+    const hss_params_t params = {
+        .levels = 2,
+        .lms_type = { LMS_SHA256_M32_H5, LMS_SHA256_M32_H5 },
+        .lmots_type = { LMOTS_SHA256_N32_W1, LMOTS_SHA256_N32_W1 }
+    };
+    const hss_nv_store_t store = { hss_memory_read, hss_memory_write, in };
+    hss_signer_t *signer;
+
+    if (hss_signature_bytes(&params) > sizeof(in->hss_sig)) {
+        return PQC_ERROR_INTERNAL;
+    }
+    pqc_result_t rc = hss_keypair(&params, in->hss_pk, in->hss_sk, &store);
+    if (rc == PQC_SUCCESS) {
+        rc = hss_signer_open(&signer, in->hss_sk, sizeof(in->hss_sk), &store, 0);
+    }
+    if (rc == PQC_SUCCESS) {
+        rc = hss_sign(signer, in->hss_sig, &in->hss_siglen, in->message, sizeof(in->message));
+        hss_signer_close(signer);
+    }
+    return rc;
+}
+
+static pqc_result_t prepare_inputs(stack_inputs_t *in) {
+    pqc_result_t rc;
+
+    pqc_randombytes(in->message, sizeof(in->message));
+    pqc_randombytes(in->hash_input, sizeof(in->hash_input));
+    pqc_randombytes(in->mem_a, sizeof(in->mem_a));
+
+    if ((rc = kyber_keypair(&in->kyber_pk, &in->kyber_sk)) != PQC_SUCCESS ||
+        (rc = kyber_encapsulate(&in->kyber_ct, in->kyber_ss, &in->kyber_pk)) != PQC_SUCCESS ||
+        (rc = dilithium_keypair(&in->dilithium_pk, &in->dilithium_sk)) != PQC_SUCCESS ||
+        (rc = dilithium_sign(in->dilithium_sig, &in->dilithium_siglen, in->message,
+                             sizeof(in->message), &in->dilithium_sk)) != PQC_SUCCESS ||
+        (rc = dilithium_expand_public_key(&in->dilithium_epk, &in->dilithium_pk)) != PQC_SUCCESS ||
+        (rc = falcon_keypair(PQC_ALG_FALCON_1024, in->falcon_pk, in->falcon_sk)) != PQC_SUCCESS ||
+        (rc = falcon_sign(in->falcon_sig, &in->falcon_siglen, in->message, sizeof(in->message),
+                          in->falcon_sk, sizeof(in->falcon_sk))) != PQC_SUCCESS ||
+        (rc = sphincs_keypair(PQC_ALG_SPHINCS_SHA256_256F, in->sphincs_pk,
+                              in->sphincs_sk)) != PQC_SUCCESS ||
+        (rc = sphincs_sign(in->sphincs_sig, &in->sphincs_siglen, in->message, sizeof(in->message),
+                           in->sphincs_sk, sizeof(in->sphincs_sk))) != PQC_SUCCESS ||
+        (rc = prepare_hss(in)) != PQC_SUCCESS) {
+        return rc;
+    }
+
+    // A correctly signed, current report so verification runs every check
+    in->report.report_version = ATTESTATION_REPORT_VERSION;
+    in->report.timestamp = (uint64_t)time(NULL);
+    uint8_t report_hash[32];
+    if ((rc = sha3_256(report_hash, (const uint8_t *)&in->report,
+                       ATTESTATION_REPORT_SIGNED_BYTES)) != PQC_SUCCESS) {
+        return rc;
+    }
+    size_t siglen = 0;
+    rc = dilithium_sign(in->report.signature, &siglen, report_hash, sizeof(report_hash),
+                        &in->dilithium_sk);
+    in->report.signature_length = (uint32_t)siglen;
+    return rc;
+}
+
+int main(int argc, char **argv) {
+    stack_options_t opts;
+    if (parse_options(argc, argv, &opts) != 0) {
+        return 2;
+    }
+
+    if (opts.list_only) {
+        for (size_t i = 0; i < STACK_ENTRY_COUNT; i++) {
+            printf("%s\n", g_entries[i].name);
+        }
+        return 0;
+    }
+
+    if (pqc_init(NULL) != PQC_SUCCESS) {
+        fprintf(stderr, "pqc_init failed\n");
+        return 1;
+    }
+
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t size = (opts.stack_size + page - 1) / page * page;
+    uint8_t *region = mmap(NULL, size + page, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    stack_inputs_t *inputs = calloc(1, sizeof(stack_inputs_t));
+    stack_result_t *results = calloc(STACK_ENTRY_COUNT, sizeof(stack_result_t));
+    if (region == MAP_FAILED || !inputs || !results) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    // Guard page below the stack turns an overflow into SIGSEGV
+    uint8_t *stack = region + page;
+    if (mprotect(region, page, PROT_NONE) != 0 || install_overflow_handler() != 0) {
+        perror("stack guard setup");
+        return 1;
+    }
+
+    int rc = 0;
+    if (prepare_inputs(inputs) != PQC_SUCCESS) {
+        fprintf(stderr, "Failed to prepare inputs\n");
+        rc = 1;
+        goto cleanup;
+    }
+
+    stack_result_t noop;
+    if (measure_entry(&g_noop, inputs, stack, size, 1, 0, &noop) != 0) {
+        fprintf(stderr, "makecontext/swapcontext failed\n");
+        rc = 1;
+        goto cleanup;
+    }
+    size_t baseline = noop.bytes;
+
+    size_t count = 0;
+    for (size_t i = 0; i < STACK_ENTRY_COUNT; i++) {
+        if (opts.filter && !strstr(g_entries[i].name, opts.filter)) {
+            continue;
+        }
+        stack_result_t *r = &results[count++];
+        if (measure_entry(&g_entries[i], inputs, stack, size, opts.repeat, baseline, r) != 0) {
+            fprintf(stderr, "makecontext/swapcontext failed\n");
+            rc = 1;
+            goto cleanup;
+        }
+        r->budget = find_budget(&opts, r->entry->name);
+        if (r->overflow || (r->budget && r->bytes > r->budget)) {
+            rc = 1;
+        }
+    }
+
+    printf("Profile %s, trampoline %zu bytes subtracted\n", opts.profile, baseline);
+    print_table(results, count);
+    if (write_report(opts.output, &opts, baseline, results, count) != 0) {
+        rc = 1;
+    }
+
+cleanup:
+    secure_memzero(inputs, sizeof(*inputs));
+    secure_memzero(stack, size);
+    free(inputs);
+    free(results);
+    munmap(region, size + page);
+    pqc_cleanup();
+    return rc;
+}
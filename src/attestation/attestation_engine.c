@@ -10,9 +10,14 @@
 #include "tpm2_interface.h"
 #include "../crypto/pqc_common.h"
 #include "../crypto/dilithium.h"
+#include "../crypto/lms.h"
 #include "../crypto/secure_memory.h"
+#include "../crypto/pqc_bytes.h"
+#include "../crypto/pqc_trace.h"
+#include <stdio.h>
 #include <string.h>
 #include <time.h>
+#include <stdatomic.h>
 
 // Platform Configuration Registers (PCRs) used for attestation
 #define PCR_FIRMWARE_HASH    0    /**< Firmware/bootloader hash */
@@ -28,6 +33,11 @@
 static attestation_context_t g_attestation_ctx = {0};
 static bool g_attestation_initialized = false;
 
+// Report verification counters
+static _Atomic uint64_t g_verify_count;
+static _Atomic uint64_t g_verify_valid;
+static _Atomic uint64_t g_verify_rejected[ATTESTATION_STAGE_COUNT];
+
 /**
  * @brief Calculate SHA-256 hash of data
  * @param data Input data
@@ -52,15 +62,17 @@ static pqc_result_t extend_pcr(uint8_t pcr_index, const uint8_t measurement[32])
 
     // Get current PCR value
     uint8_t current_pcr[32];
+    PQC_TRACE_TPM_ENTRY("read_pcr", 32);
     pqc_result_t result = tpm2_read_pcr(pcr_index, current_pcr);
+    PQC_TRACE_TPM_RETURN("read_pcr", result);
     if (result != PQC_SUCCESS) {
         return result;
     }
 
     // Compute new PCR value: SHA-256(current_pcr || measurement)
     uint8_t extend_data[64];
-    memcpy(extend_data, current_pcr, 32);
-    memcpy(extend_data + 32, measurement, 32);
+    PQC_MEMCPY(extend_data, current_pcr, 32);
+    PQC_MEMCPY(extend_data + 32, measurement, 32);
 
     uint8_t new_pcr[32];
     result = calculate_sha256(extend_data, 64, new_pcr);
@@ -69,13 +81,15 @@ static pqc_result_t extend_pcr(uint8_t pcr_index, const uint8_t measurement[32])
     }
 
     // Update PCR in TPM
+    PQC_TRACE_TPM_ENTRY("extend_pcr", 32);
     result = tpm2_extend_pcr(pcr_index, measurement);
+    PQC_TRACE_TPM_RETURN("extend_pcr", result);
     if (result != PQC_SUCCESS) {
         return result;
     }
 
     // Update local cache
-    memcpy(g_attestation_ctx.pcr_values[pcr_index], new_pcr, 32);
+    PQC_MEMCPY(g_attestation_ctx.pcr_values[pcr_index], new_pcr, 32);
     g_attestation_ctx.pcr_valid[pcr_index] = true;
 
     return PQC_SUCCESS;
@@ -91,12 +105,28 @@ static pqc_result_t collect_firmware_measurement(platform_measurement_t *measure
     measurement->measurement_type = MEASUREMENT_TYPE_FIRMWARE;
     measurement->timestamp = time(NULL);
 
-    // In a real implementation, this would read the firmware from flash
-    // and calculate its hash. For this implementation, we'll use a simulated value.
-    const char *firmware_version = "PQC-Edge-Attestor-v1.0.0";
-    pqc_result_t result = calculate_sha256((const uint8_t*)firmware_version, 
-                                          strlen(firmware_version), 
-                                          measurement->measurement_value);
+    // Without an image from the platform, measure a simulated firmware value
+    const uint8_t *image = g_attestation_ctx.firmware_image;
+    size_t image_len = g_attestation_ctx.firmware_image_len;
+    if (!image) {
+        image = (const uint8_t*)"PQC-Edge-Attestor-v1.0.0";
+        image_len = strlen((const char*)image);
+    }
+
+    // Refuse to measure firmware that was not signed by the firmware key
+    pqc_result_t result;
+    if (g_attestation_ctx.firmware_signature) {
+        result = hss_verify(g_attestation_ctx.firmware_signature,
+                            g_attestation_ctx.firmware_signature_len,
+                            image, image_len,
+                            g_attestation_ctx.firmware_public_key, HSS_PUBLICKEYBYTES);
+        if (result != PQC_SUCCESS) {
+            return result;
+        }
+    }
+
+    measurement->measurement_size = (uint32_t)image_len;
+    result = calculate_sha256(image, image_len, measurement->measurement_value);
     
     if (result == PQC_SUCCESS) {
         result = extend_pcr(PCR_FIRMWARE_HASH, measurement->measurement_value);
@@ -188,10 +218,10 @@ static pqc_result_t collect_keys_measurement(platform_measurement_t *measurement
         }
     } else {
         // Use placeholder if no keys available
-        memset(pubkey_hash, 0, 32);
+        PQC_MEMSET(pubkey_hash, 0, 32);
     }
 
-    memcpy(measurement->measurement_value, pubkey_hash, 32);
+    PQC_MEMCPY(measurement->measurement_value, pubkey_hash, 32);
     
     return extend_pcr(PCR_KEYS_HASH, measurement->measurement_value);
 }
@@ -228,6 +258,7 @@ static pqc_result_t collect_device_id_measurement(platform_measurement_t *measur
 }
 
 pqc_result_t attestation_init(const attestation_config_t *config) {
+    PQC_BYTES_SCOPE("attestation_init");
     if (!config) {
         return PQC_ERROR_INVALID_PARAMETER;
     }
@@ -237,19 +268,22 @@ pqc_result_t attestation_init(const attestation_config_t *config) {
     }
 
     // Initialize TPM interface
+    PQC_TRACE_TPM_ENTRY("init", 0);
     pqc_result_t result = tpm2_init();
+    PQC_TRACE_TPM_RETURN("init", result);
     if (result != PQC_SUCCESS) {
         return result;
     }
 
     // Copy configuration
-    memcpy(&g_attestation_ctx.config, config, sizeof(attestation_config_t));
+    PQC_MEMCPY(&g_attestation_ctx.config, config, sizeof(attestation_config_t));
 
     // Initialize device information
-    if (strlen(config->device_serial) > 0) {
-        strncpy(g_attestation_ctx.device_info.serial_number, 
-                config->device_serial, 
-                sizeof(g_attestation_ctx.device_info.serial_number) - 1);
+    // Bounded by both buffers: the configured serial need not be terminated
+    if (config->device_serial[0] != '\0') {
+        snprintf(g_attestation_ctx.device_info.serial_number,
+                 sizeof(g_attestation_ctx.device_info.serial_number), "%.*s",
+                 (int)sizeof(config->device_serial), config->device_serial);
     }
     g_attestation_ctx.device_info.device_type = config->device_type;
     g_attestation_ctx.device_info.hardware_version = 1;
@@ -257,7 +291,7 @@ pqc_result_t attestation_init(const attestation_config_t *config) {
 
     // Initialize PCR values to zero
     for (int i = 0; i < MAX_PCR_REGISTERS; i++) {
-        memset(g_attestation_ctx.pcr_values[i], 0, 32);
+        PQC_MEMSET(g_attestation_ctx.pcr_values[i], 0, 32);
         g_attestation_ctx.pcr_valid[i] = false;
     }
 
@@ -280,6 +314,7 @@ pqc_result_t attestation_init(const attestation_config_t *config) {
 }
 
 void attestation_cleanup(void) {
+    PQC_BYTES_SCOPE("attestation_cleanup");
     if (!g_attestation_initialized) {
         return;
     }
@@ -299,13 +334,20 @@ void attestation_cleanup(void) {
     // Clear measurement log
     secure_memzero(&g_attestation_ctx.measurement_log, sizeof(measurement_log_t));
 
+    // Forget the caller's firmware image
+    g_attestation_ctx.firmware_image = NULL;
+    g_attestation_ctx.firmware_image_len = 0;
+    g_attestation_ctx.firmware_signature = NULL;
+    g_attestation_ctx.firmware_signature_len = 0;
+
     // Cleanup TPM interface
-    tmp2_cleanup();
+    tpm2_cleanup();
 
     g_attestation_initialized = false;
 }
 
 pqc_result_t attestation_collect_measurements(void) {
+    PQC_BYTES_SCOPE("attestation_collect_measurements");
     if (!g_attestation_initialized) {
         return PQC_ERROR_INVALID_PARAMETER;
     }
@@ -321,7 +363,7 @@ pqc_result_t attestation_collect_measurements(void) {
     
     // Add to measurement log
     if (g_attestation_ctx.measurement_log.count < MAX_MEASUREMENT_LOG_ENTRIES) {
-        memcpy(&g_attestation_ctx.measurement_log.measurements[g_attestation_ctx.measurement_log.count],
+        PQC_MEMCPY(&g_attestation_ctx.measurement_log.measurements[g_attestation_ctx.measurement_log.count],
                &measurement, sizeof(platform_measurement_t));
         g_attestation_ctx.measurement_log.count++;
     }
@@ -333,7 +375,7 @@ pqc_result_t attestation_collect_measurements(void) {
     }
     
     if (g_attestation_ctx.measurement_log.count < MAX_MEASUREMENT_LOG_ENTRIES) {
-        memcpy(&g_attestation_ctx.measurement_log.measurements[g_attestation_ctx.measurement_log.count],
+        PQC_MEMCPY(&g_attestation_ctx.measurement_log.measurements[g_attestation_ctx.measurement_log.count],
                &measurement, sizeof(platform_measurement_t));
         g_attestation_ctx.measurement_log.count++;
     }
@@ -345,7 +387,7 @@ pqc_result_t attestation_collect_measurements(void) {
     }
     
     if (g_attestation_ctx.measurement_log.count < MAX_MEASUREMENT_LOG_ENTRIES) {
-        memcpy(&g_attestation_ctx.measurement_log.measurements[g_attestation_ctx.measurement_log.count],
+        PQC_MEMCPY(&g_attestation_ctx.measurement_log.measurements[g_attestation_ctx.measurement_log.count],
                &measurement, sizeof(platform_measurement_t));
         g_attestation_ctx.measurement_log.count++;
     }
@@ -357,7 +399,7 @@ pqc_result_t attestation_collect_measurements(void) {
     }
     
     if (g_attestation_ctx.measurement_log.count < MAX_MEASUREMENT_LOG_ENTRIES) {
-        memcpy(&g_attestation_ctx.measurement_log.measurements[g_attestation_ctx.measurement_log.count],
+        PQC_MEMCPY(&g_attestation_ctx.measurement_log.measurements[g_attestation_ctx.measurement_log.count],
                &measurement, sizeof(platform_measurement_t));
         g_attestation_ctx.measurement_log.count++;
     }
@@ -369,7 +411,7 @@ pqc_result_t attestation_collect_measurements(void) {
     }
     
     if (g_attestation_ctx.measurement_log.count < MAX_MEASUREMENT_LOG_ENTRIES) {
-        memcpy(&g_attestation_ctx.measurement_log.measurements[g_attestation_ctx.measurement_log.count],
+        PQC_MEMCPY(&g_attestation_ctx.measurement_log.measurements[g_attestation_ctx.measurement_log.count],
                &measurement, sizeof(platform_measurement_t));
         g_attestation_ctx.measurement_log.count++;
     }
@@ -378,15 +420,19 @@ pqc_result_t attestation_collect_measurements(void) {
 }
 
 pqc_result_t attestation_generate_report(attestation_report_t *report) {
+    PQC_BYTES_SCOPE("attestation_generate_report");
     if (!report || !g_attestation_initialized) {
         return PQC_ERROR_INVALID_PARAMETER;
     }
 
+    PQC_TRACE_OP_ENTRY("attestation_generate_report", 0);
+    PQC_TRACE_ATTEST_PHASE_ENTRY("assemble");
+
     // Clear report structure
-    memset(report, 0, sizeof(attestation_report_t));
+    PQC_MEMSET(report, 0, sizeof(attestation_report_t));
 
     // Set report metadata
-    memcpy(report->device_id, g_attestation_ctx.device_info.serial_number, 
+    PQC_MEMCPY(report->device_id, g_attestation_ctx.device_info.serial_number, 
            sizeof(report->device_id));
     report->timestamp = time(NULL);
     report->report_version = ATTESTATION_REPORT_VERSION;
@@ -395,7 +441,7 @@ pqc_result_t attestation_generate_report(attestation_report_t *report) {
     // Copy PCR values
     for (int i = 0; i < MAX_PCR_REGISTERS; i++) {
         if (g_attestation_ctx.pcr_valid[i]) {
-            memcpy(report->pcr_values[i], g_attestation_ctx.pcr_values[i], 32);
+            PQC_MEMCPY(report->pcr_values[i], g_attestation_ctx.pcr_values[i], 32);
         }
     }
 
@@ -404,25 +450,44 @@ pqc_result_t attestation_generate_report(attestation_report_t *report) {
                                  MAX_MEASUREMENTS_PER_REPORT : report->measurement_count;
     
     for (size_t i = 0; i < measurements_to_copy; i++) {
-        memcpy(&report->measurements[i],
+        PQC_MEMCPY(&report->measurements[i],
                &g_attestation_ctx.measurement_log.measurements[i],
                sizeof(platform_measurement_t));
     }
+    PQC_TRACE_ATTEST_PHASE_RETURN("assemble", PQC_SUCCESS);
+
+    // Sign the report with device attestation key
+    pqc_result_t result = attestation_sign_report(report, &g_attestation_ctx.device_keypair.sk);
+    if (result != PQC_SUCCESS) {
+        PQC_TRACE_OP_RETURN("attestation_generate_report", result, 0);
+        return result;
+    }
+
+    PQC_TRACE_OP_RETURN("attestation_generate_report", PQC_SUCCESS, sizeof(attestation_report_t));
+    return PQC_SUCCESS;
+}
+
+pqc_result_t attestation_sign_report(attestation_report_t *report,
+                                     const dilithium_secret_key_t *sk) {
+    if (!report || !sk) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
 
     // Calculate report hash for signing
     uint8_t report_hash[32];
+    PQC_TRACE_ATTEST_PHASE_ENTRY("hash");
     pqc_result_t result = calculate_sha256((const uint8_t*)report, 
-                                          sizeof(attestation_report_t) - sizeof(report->signature),
+                                          ATTESTATION_REPORT_SIGNED_BYTES,
                                           report_hash);
+    PQC_TRACE_ATTEST_PHASE_RETURN("hash", result);
     if (result != PQC_SUCCESS) {
         return result;
     }
 
-    // Sign the report with device attestation key
     size_t sig_len;
-    result = dilithium_sign(report->signature, &sig_len,
-                           report_hash, 32,
-                           &g_attestation_ctx.device_keypair.sk);
+    PQC_TRACE_ATTEST_PHASE_ENTRY("sign");
+    result = dilithium_sign(report->signature, &sig_len, report_hash, 32, sk);
+    PQC_TRACE_ATTEST_PHASE_RETURN("sign", result);
     if (result != PQC_SUCCESS) {
         return result;
     }
@@ -431,68 +496,120 @@ pqc_result_t attestation_generate_report(attestation_report_t *report) {
     return PQC_SUCCESS;
 }
 
-pqc_result_t attestation_verify_report(const attestation_report_t *report,
-                                      const dilithium_public_key_t *device_public_key,
-                                      attestation_verification_result_t *result_out) {
-    if (!report || !device_public_key || !result_out) {
-        return PQC_ERROR_INVALID_PARAMETER;
+/**
+ * @brief Record a report rejected in a verification phase
+ *
+ * Closes the phase and the operation in traces.
+ *
+ * @return PQC_SUCCESS: an invalid report is a verdict, not a failure
+ */
+static pqc_result_t reject_report(const char *op, const char *phase,
+                                  attestation_verification_result_t *result_out,
+                                  attestation_error_t error) {
+    // Only the trace macros read these, and they may be compiled out
+    (void)op;
+    (void)phase;
+    result_out->error_code = error;
+    atomic_fetch_add_explicit(&g_verify_rejected[attestation_error_stage(error)], 1,
+                              memory_order_relaxed);
+    PQC_TRACE_ATTEST_PHASE_RETURN(phase, error);
+    PQC_TRACE_OP_RETURN(op, PQC_SUCCESS, 0);
+    return PQC_SUCCESS;
+}
+
+/**
+ * @brief Structure and clock-skew stages
+ *
+ * @return true if the report passed; otherwise it was rejected through
+ *         reject_report() and result_out holds the error
+ */
+static bool check_structure(const char *op, const attestation_report_t *report,
+                            attestation_verification_result_t *result_out) {
+    // Verify report format
+    PQC_TRACE_ATTEST_PHASE_ENTRY("format");
+    if (report->report_version != ATTESTATION_REPORT_VERSION ||
+        report->measurement_count > MAX_MEASUREMENTS_PER_REPORT ||
+        report->signature_length == 0 || report->signature_length > DILITHIUM_SIGNATUREBYTES) {
+        reject_report(op, "format", result_out, ATTESTATION_ERROR_INVALID_FORMAT);
+        return false;
     }
+    PQC_TRACE_ATTEST_PHASE_RETURN("format", ATTESTATION_ERROR_NONE);
+
+    // Check timestamp (allow 5 minute clock skew)
+    PQC_TRACE_ATTEST_PHASE_ENTRY("timestamp");
+    uint64_t current_time = (uint64_t)time(NULL);
+    uint64_t skew = current_time > report->timestamp ? current_time - report->timestamp
+                                                     : report->timestamp - current_time;
+    if (skew > ATTESTATION_MAX_CLOCK_SKEW) {
+        reject_report(op, "timestamp", result_out, ATTESTATION_ERROR_TIMESTAMP_INVALID);
+        return false;
+    }
+    PQC_TRACE_ATTEST_PHASE_RETURN("timestamp", ATTESTATION_ERROR_NONE);
+    return true;
+}
+
+/**
+ * @brief Report verification against either form of the device key
+ *
+ * Exactly one of pk and epk is non-NULL; op names the public entry point
+ * in traces.
+ */
+static pqc_result_t verify_report(const char *op, const attestation_report_t *report,
+                                  const dilithium_public_key_t *pk,
+                                  const dilithium_expanded_public_key_t *epk,
+                                  attestation_verification_result_t *result_out) {
+    PQC_TRACE_OP_ENTRY(op, sizeof(attestation_report_t));
 
     // Initialize result
-    memset(result_out, 0, sizeof(attestation_verification_result_t));
+    PQC_MEMSET(result_out, 0, sizeof(attestation_verification_result_t));
     result_out->is_valid = false;
+    atomic_fetch_add_explicit(&g_verify_count, 1, memory_order_relaxed);
 
-    // Verify report format
-    if (report->report_version != ATTESTATION_REPORT_VERSION) {
-        result_out->error_code = ATTESTATION_ERROR_INVALID_FORMAT;
-        return PQC_SUCCESS; // Not a failure, just invalid report
+    // Cheapest checks first: only a report that passes everything else
+    // pays for the signature verification
+    if (!check_structure(op, report, result_out)) {
+        return PQC_SUCCESS;
     }
 
-    if (report->measurement_count > MAX_MEASUREMENTS_PER_REPORT) {
-        result_out->error_code = ATTESTATION_ERROR_INVALID_FORMAT;
-        return PQC_SUCCESS;
+    // Validate PCR values and measurements
+    PQC_TRACE_ATTEST_PHASE_ENTRY("policy");
+    for (size_t i = 0; i < report->measurement_count; i++) {
+        const platform_measurement_t *measurement = &report->measurements[i];
+        
+        if (measurement->pcr_index >= MAX_PCR_REGISTERS) {
+            return reject_report(op, "policy", result_out, ATTESTATION_ERROR_INVALID_PCR);
+        }
+        if (measurement->measurement_type >= MEASUREMENT_TYPE_MAX) {
+            return reject_report(op, "policy", result_out, ATTESTATION_ERROR_INVALID_MEASUREMENT);
+        }
     }
+    PQC_TRACE_ATTEST_PHASE_RETURN("policy", ATTESTATION_ERROR_NONE);
 
     // Calculate report hash
     uint8_t report_hash[32];
+    PQC_TRACE_ATTEST_PHASE_ENTRY("hash");
     pqc_result_t result = calculate_sha256((const uint8_t*)report,
-                                          sizeof(attestation_report_t) - sizeof(report->signature),
+                                          ATTESTATION_REPORT_SIGNED_BYTES,
                                           report_hash);
+    PQC_TRACE_ATTEST_PHASE_RETURN("hash", result);
     if (result != PQC_SUCCESS) {
+        PQC_TRACE_OP_RETURN(op, result, 0);
         return result;
     }
 
     // Verify signature
-    result = dilithium_verify(report->signature, report->signature_length,
-                             report_hash, 32,
-                             device_public_key);
-    
-    if (result != PQC_SUCCESS) {
-        result_out->error_code = ATTESTATION_ERROR_SIGNATURE_INVALID;
-        return PQC_SUCCESS;
-    }
-
-    // Check timestamp (allow 5 minute clock skew)
-    time_t current_time = time(NULL);
-    if (abs((int)(current_time - report->timestamp)) > 300) {
-        result_out->error_code = ATTESTATION_ERROR_TIMESTAMP_INVALID;
-        return PQC_SUCCESS;
+    PQC_TRACE_ATTEST_PHASE_ENTRY("signature");
+    if (epk) {
+        result = dilithium_verify_expanded(report->signature, report->signature_length,
+                                           report_hash, 32, epk);
+    } else {
+        result = dilithium_verify(report->signature, report->signature_length,
+                                  report_hash, 32, pk);
     }
-
-    // Validate PCR values and measurements
-    for (size_t i = 0; i < report->measurement_count; i++) {
-        const platform_measurement_t *measurement = &report->measurements[i];
-        
-        if (measurement->pcr_index >= MAX_PCR_REGISTERS) {
-            result_out->error_code = ATTESTATION_ERROR_INVALID_PCR;
-            return PQC_SUCCESS;
-        }
-
-        if (measurement->measurement_type >= MEASUREMENT_TYPE_MAX) {
-            result_out->error_code = ATTESTATION_ERROR_INVALID_MEASUREMENT;
-            return PQC_SUCCESS;
-        }
+    if (result != PQC_SUCCESS) {
+        return reject_report(op, "signature", result_out, ATTESTATION_ERROR_SIGNATURE_INVALID);
     }
+    PQC_TRACE_ATTEST_PHASE_RETURN("signature", result);
 
     // All checks passed
     result_out->is_valid = true;
@@ -500,22 +617,66 @@ pqc_result_t attestation_verify_report(const attestation_report_t *report,
     result_out->trust_level = TRUST_LEVEL_HIGH; // Could be computed based on measurements
     
     // Copy device information
-    memcpy(result_out->device_id, report->device_id, sizeof(result_out->device_id));
+    PQC_MEMCPY(result_out->device_id, report->device_id, sizeof(result_out->device_id));
     result_out->timestamp = report->timestamp;
+    atomic_fetch_add_explicit(&g_verify_valid, 1, memory_order_relaxed);
 
+    PQC_TRACE_OP_RETURN(op, PQC_SUCCESS,
+                        sizeof(attestation_verification_result_t));
+    return PQC_SUCCESS;
+}
+
+pqc_result_t attestation_verify_report(const attestation_report_t *report,
+                                      const dilithium_public_key_t *device_public_key,
+                                      attestation_verification_result_t *result_out) {
+    PQC_BYTES_SCOPE("attestation_verify_report");
+    if (!report || !device_public_key || !result_out) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    return verify_report("attestation_verify_report", report, device_public_key, NULL,
+                         result_out);
+}
+
+pqc_result_t attestation_verify_report_expanded(const attestation_report_t *report,
+                                               const dilithium_expanded_public_key_t *device_key,
+                                               attestation_verification_result_t *result_out) {
+    PQC_BYTES_SCOPE("attestation_verify_report_expanded");
+    if (!report || !device_key || !result_out) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    return verify_report("attestation_verify_report_expanded", report, NULL, device_key,
+                         result_out);
+}
+
+pqc_result_t attestation_check_report(const attestation_report_t *report,
+                                      attestation_verification_result_t *result_out) {
+    PQC_BYTES_SCOPE("attestation_check_report");
+    if (!report || !result_out) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    PQC_TRACE_OP_ENTRY("attestation_check_report", sizeof(attestation_report_t));
+    PQC_MEMSET(result_out, 0, sizeof(attestation_verification_result_t));
+    if (!check_structure("attestation_check_report", report, result_out)) {
+        // A passing report is counted by the verification that follows
+        atomic_fetch_add_explicit(&g_verify_count, 1, memory_order_relaxed);
+        return PQC_SUCCESS;
+    }
+    PQC_TRACE_OP_RETURN("attestation_check_report", PQC_SUCCESS, 0);
     return PQC_SUCCESS;
 }
 
 pqc_result_t attestation_get_device_certificate(device_certificate_t *cert) {
+    PQC_BYTES_SCOPE("attestation_get_device_certificate");
     if (!cert || !g_attestation_initialized) {
         return PQC_ERROR_INVALID_PARAMETER;
     }
 
     // Copy device public key
-    memcpy(&cert->public_key, &g_attestation_ctx.device_keypair.pk, sizeof(dilithium_public_key_t));
+    PQC_MEMCPY(&cert->public_key, &g_attestation_ctx.device_keypair.pk, sizeof(dilithium_public_key_t));
     
     // Copy device information
-    memcpy(&cert->device_info, &g_attestation_ctx.device_info, sizeof(device_info_t));
+    PQC_MEMCPY(&cert->device_info, &g_attestation_ctx.device_info, sizeof(device_info_t));
     
     // Set certificate metadata
     cert->certificate_version = 1;
@@ -546,15 +707,16 @@ pqc_result_t attestation_get_device_certificate(device_certificate_t *cert) {
 }
 
 pqc_result_t attestation_get_pcr_values(uint8_t pcr_values[MAX_PCR_REGISTERS][32]) {
+    PQC_BYTES_SCOPE("attestation_get_pcr_values");
     if (!pcr_values || !g_attestation_initialized) {
         return PQC_ERROR_INVALID_PARAMETER;
     }
 
     for (int i = 0; i < MAX_PCR_REGISTERS; i++) {
         if (g_attestation_ctx.pcr_valid[i]) {
-            memcpy(pcr_values[i], g_attestation_ctx.pcr_values[i], 32);
+            PQC_MEMCPY(pcr_values[i], g_attestation_ctx.pcr_values[i], 32);
         } else {
-            memset(pcr_values[i], 0, 32);
+            PQC_MEMSET(pcr_values[i], 0, 32);
         }
     }
 
@@ -562,14 +724,117 @@ pqc_result_t attestation_get_pcr_values(uint8_t pcr_values[MAX_PCR_REGISTERS][32
 }
 
 pqc_result_t attestation_get_measurement_log(measurement_log_t *log) {
+    PQC_BYTES_SCOPE("attestation_get_measurement_log");
     if (!log || !g_attestation_initialized) {
         return PQC_ERROR_INVALID_PARAMETER;
     }
 
-    memcpy(log, &g_attestation_ctx.measurement_log, sizeof(measurement_log_t));
+    PQC_MEMCPY(log, &g_attestation_ctx.measurement_log, sizeof(measurement_log_t));
+    return PQC_SUCCESS;
+}
+
+pqc_result_t attestation_set_firmware_image(const uint8_t *image,
+                                           size_t image_len,
+                                           const uint8_t *signature,
+                                           size_t signature_len,
+                                           const uint8_t *public_key) {
+    if (!g_attestation_initialized || !image || (signature && !public_key)) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    g_attestation_ctx.firmware_image = image;
+    g_attestation_ctx.firmware_image_len = image_len;
+    g_attestation_ctx.firmware_signature = signature;
+    g_attestation_ctx.firmware_signature_len = signature ? signature_len : 0;
+    if (signature) {
+        PQC_MEMCPY(g_attestation_ctx.firmware_public_key, public_key, HSS_PUBLICKEYBYTES);
+    }
+    return PQC_SUCCESS;
+}
+
+static pqc_result_t tpm_nv_store_read(void *ctx, uint8_t record[HSS_NV_RECORD_BYTES]) {
+    size_t size = HSS_NV_RECORD_BYTES;
+    PQC_TRACE_TPM_ENTRY("nv_read", HSS_NV_RECORD_BYTES);
+    pqc_result_t result = tpm2_nv_read((uint32_t)(uintptr_t)ctx, record, &size);
+    PQC_TRACE_TPM_RETURN("nv_read", result);
+    if (result == PQC_SUCCESS && size != HSS_NV_RECORD_BYTES) {
+        result = PQC_ERROR_HARDWARE_FAILURE;
+    }
+    return result;
+}
+
+static pqc_result_t tpm_nv_store_write(void *ctx, const uint8_t record[HSS_NV_RECORD_BYTES]) {
+    uint32_t index = (uint32_t)(uintptr_t)ctx;
+
+    // Define the index on first use; it already existing is fine
+    tpm2_nv_define(index, HSS_NV_RECORD_BYTES, 0);
+
+    PQC_TRACE_TPM_ENTRY("nv_write", HSS_NV_RECORD_BYTES);
+    pqc_result_t result = tpm2_nv_write(index, record, HSS_NV_RECORD_BYTES);
+    PQC_TRACE_TPM_RETURN("nv_write", result);
+    return result;
+}
+
+pqc_result_t attestation_hss_nv_store(hss_nv_store_t *store, uint32_t nv_index) {
+    if (!store) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    // An index that forgets its record on restart would let the signer reuse indices
+    if (!tpm2_nv_is_persistent()) {
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+    store->read = tpm_nv_store_read;
+    store->write = tpm_nv_store_write;
+    store->ctx = (void*)(uintptr_t)nv_index;
     return PQC_SUCCESS;
 }
 
 bool attestation_is_initialized(void) {
     return g_attestation_initialized;
-}
\ No newline at end of file
+}
+
+void attestation_get_verify_stats(attestation_verify_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+    stats->verified = atomic_load_explicit(&g_verify_count, memory_order_relaxed);
+    stats->valid = atomic_load_explicit(&g_verify_valid, memory_order_relaxed);
+    for (int i = 0; i < ATTESTATION_STAGE_COUNT; i++) {
+        stats->rejected[i] = atomic_load_explicit(&g_verify_rejected[i], memory_order_relaxed);
+    }
+}
+
+attestation_stage_t attestation_error_stage(attestation_error_t error) {
+    switch (error) {
+        case ATTESTATION_ERROR_TIMESTAMP_INVALID:
+        case ATTESTATION_ERROR_EXPIRED:
+        case ATTESTATION_ERROR_REPLAYED:            return ATTESTATION_STAGE_FRESHNESS;
+        case ATTESTATION_ERROR_REVOKED:
+        case ATTESTATION_ERROR_UNKNOWN_DEVICE:
+        case ATTESTATION_ERROR_RATE_LIMITED:        return ATTESTATION_STAGE_REVOCATION;
+        case ATTESTATION_ERROR_INVALID_PCR:
+        case ATTESTATION_ERROR_INVALID_MEASUREMENT:
+        case ATTESTATION_ERROR_POLICY_VIOLATION:    return ATTESTATION_STAGE_POLICY;
+        case ATTESTATION_ERROR_SIGNATURE_INVALID:   return ATTESTATION_STAGE_SIGNATURE;
+        default:                                    return ATTESTATION_STAGE_STRUCTURE;
+    }
+}
+
+const char* attestation_error_to_string(attestation_error_t error) {
+    switch (error) {
+        case ATTESTATION_ERROR_NONE:                return "No error";
+        case ATTESTATION_ERROR_INVALID_FORMAT:      return "Invalid report format";
+        case ATTESTATION_ERROR_SIGNATURE_INVALID:   return "Invalid signature";
+        case ATTESTATION_ERROR_TIMESTAMP_INVALID:   return "Invalid timestamp";
+        case ATTESTATION_ERROR_INVALID_PCR:         return "Invalid PCR value";
+        case ATTESTATION_ERROR_INVALID_MEASUREMENT: return "Invalid measurement";
+        case ATTESTATION_ERROR_POLICY_VIOLATION:    return "Security policy violation";
+        case ATTESTATION_ERROR_EXPIRED:             return "Certificate or report expired";
+        case ATTESTATION_ERROR_REVOKED:             return "Certificate revoked";
+        case ATTESTATION_ERROR_UNKNOWN_DEVICE:      return "Unknown device";
+        case ATTESTATION_ERROR_REPLAYED:            return "Report replayed";
+        case ATTESTATION_ERROR_RATE_LIMITED:        return "Rate limited";
+        default:                                    return "Unknown error";
+    }
+}
@@ -11,6 +11,7 @@
 
 #include "../crypto/pqc_common.h"
 #include "../crypto/dilithium.h"
+#include "../crypto/lms.h"
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
@@ -28,6 +29,7 @@ extern "C" {
 #define MAX_MEASUREMENT_LOG_ENTRIES  256    /**< Maximum measurement log entries */
 #define MAX_MEASUREMENTS_PER_REPORT  32     /**< Maximum measurements per report */
 #define ATTESTATION_REPORT_VERSION   1      /**< Current report format version */
+#define ATTESTATION_MAX_CLOCK_SKEW   300    /**< Seconds a report timestamp may be off */
 #define DEVICE_ID_LENGTH            32      /**< Device identifier length */
 #define SERIAL_NUMBER_LENGTH        64      /**< Serial number string length */
 
@@ -87,9 +89,36 @@ typedef enum {
     ATTESTATION_ERROR_POLICY_VIOLATION = 6, /**< Security policy violation */
     ATTESTATION_ERROR_EXPIRED = 7,          /**< Certificate or report expired */
     ATTESTATION_ERROR_REVOKED = 8,          /**< Certificate revoked */
-    ATTESTATION_ERROR_UNKNOWN_DEVICE = 9    /**< Unknown device */
+    ATTESTATION_ERROR_UNKNOWN_DEVICE = 9,   /**< Unknown device */
+    ATTESTATION_ERROR_REPLAYED = 10,        /**< Report already seen or outside the replay window */
+    ATTESTATION_ERROR_RATE_LIMITED = 11     /**< Device throttled after repeated failures */
 } attestation_error_t;
 
+/**
+ * @brief Verification stages, in the order a report passes them
+ *
+ * Everything that needs no public-key operation runs before the signature
+ * check, so malformed, stale and unauthorized reports are rejected for
+ * the cost of a few comparisons instead of a Dilithium verification.
+ */
+typedef enum {
+    ATTESTATION_STAGE_STRUCTURE = 0,        /**< Version, counts, signature length */
+    ATTESTATION_STAGE_FRESHNESS = 1,        /**< Clock skew, replay window */
+    ATTESTATION_STAGE_REVOCATION = 2,       /**< Unknown, revoked or throttled device */
+    ATTESTATION_STAGE_POLICY = 3,           /**< PCR indices, measurement types */
+    ATTESTATION_STAGE_SIGNATURE = 4,
+    ATTESTATION_STAGE_COUNT = 5
+} attestation_stage_t;
+
+/**
+ * @brief Report verification counters, process-wide
+ */
+typedef struct {
+    uint64_t verified;                      /**< Reports checked */
+    uint64_t valid;
+    uint64_t rejected[ATTESTATION_STAGE_COUNT]; /**< Invalid reports, by rejecting stage */
+} attestation_verify_stats_t;
+
 // ============================================================================
 // Data Structures
 // ============================================================================
@@ -141,6 +170,14 @@ typedef struct {
     uint8_t signature[DILITHIUM_SIGNATUREBYTES]; /**< PQC digital signature */
 } attestation_report_t;
 
+/**
+ * @brief Bytes of an attestation report covered by its signature
+ *
+ * Everything before signature_length; the length field and signature are
+ * not known when the report hash is computed.
+ */
+#define ATTESTATION_REPORT_SIGNED_BYTES offsetof(attestation_report_t, signature_length)
+
 /**
  * @brief Device certificate structure
  */
@@ -193,6 +230,11 @@ typedef struct {
     bool pcr_valid[MAX_PCR_REGISTERS];       /**< PCR validity flags */
     measurement_log_t measurement_log;       /**< Measurement history */
     uint64_t last_attestation_time;          /**< Last attestation timestamp */
+    const uint8_t *firmware_image;           /**< Measured firmware image, NULL if simulated */
+    size_t firmware_image_len;               /**< Length of firmware image */
+    const uint8_t *firmware_signature;       /**< HSS signature of the image, NULL if unsigned */
+    size_t firmware_signature_len;           /**< Length of firmware signature */
+    uint8_t firmware_public_key[HSS_PUBLICKEYBYTES]; /**< Firmware signing key */
 } attestation_context_t;
 
 // ============================================================================
@@ -248,11 +290,28 @@ pqc_result_t attestation_collect_measurements(void);
  */
 pqc_result_t attestation_generate_report(attestation_report_t *report);
 
+/**
+ * @brief Hash and sign an assembled report
+ *
+ * Signs the first ATTESTATION_REPORT_SIGNED_BYTES of the report and sets
+ * signature and signature_length. attestation_generate_report() uses this
+ * with the device key; report builders that assemble reports themselves
+ * call it directly.
+ *
+ * @param[in,out] report Report to sign
+ * @param[in] sk Signing key
+ * @return PQC_SUCCESS on success, error code on failure
+ */
+pqc_result_t attestation_sign_report(attestation_report_t *report,
+                                     const dilithium_secret_key_t *sk);
+
 /**
  * @brief Verify attestation report
  * 
  * This function verifies the cryptographic signature and integrity of
- * an attestation report received from a device.
+ * an attestation report received from a device. The structure, freshness
+ * and policy checks run before the signature check (attestation_stage_t),
+ * so a report failing several is reported with the error of the earliest.
  * 
  * @param[in] report Attestation report to verify
  * @param[in] device_public_key Device's public key for verification
@@ -266,6 +325,40 @@ pqc_result_t attestation_verify_report(const attestation_report_t *report,
                                       const dilithium_public_key_t *device_public_key,
                                       attestation_verification_result_t *result_out);
 
+/**
+ * @brief Verify an attestation report against an expanded device key
+ *
+ * Same checks and result as attestation_verify_report(), for verifiers
+ * that keep dilithium_expand_public_key() output for devices they hear
+ * from often.
+ *
+ * @param[in] report Attestation report to verify
+ * @param[in] device_key Device's expanded public key
+ * @param[out] result_out Verification result details
+ * @return PQC_SUCCESS on success, error code on failure
+ */
+pqc_result_t attestation_verify_report_expanded(const attestation_report_t *report,
+                                               const dilithium_expanded_public_key_t *device_key,
+                                               attestation_verification_result_t *result_out);
+
+/**
+ * @brief Run only the structure and clock-skew checks of a report
+ *
+ * For verifiers with checks of their own that belong between these and
+ * the signature check (a replay window): a report is first shown to be
+ * well formed and within the clock skew, and only then to have been seen
+ * before. attestation_verify_report() repeats these checks, which cost a
+ * few comparisons. A report rejected here is counted in
+ * attestation_get_verify_stats() as a verification rejected at its stage.
+ *
+ * @param[in] report Attestation report to check
+ * @param[out] result_out error_code is ATTESTATION_ERROR_NONE if the
+ *                        report passed, the rejecting error otherwise
+ * @return PQC_SUCCESS on success, PQC_ERROR_INVALID_PARAMETER
+ */
+pqc_result_t attestation_check_report(const attestation_report_t *report,
+                                      attestation_verification_result_t *result_out);
+
 // ============================================================================
 // Certificate and Key Management
 // ============================================================================
@@ -340,6 +433,43 @@ pqc_result_t attestation_add_custom_measurement(measurement_type_t measurement_t
                                                size_t data_size,
                                                const char *description);
 
+/**
+ * @brief Set the firmware image measured into the firmware PCR
+ * 
+ * When a signature is given, every firmware measurement first verifies it
+ * against the HSS/LMS firmware signing key and fails with
+ * PQC_ERROR_INVALID_SIGNATURE instead of extending the PCR.
+ * 
+ * @param[in] image Firmware image; must stay valid until attestation_cleanup()
+ * @param[in] image_len Length of firmware image
+ * @param[in] signature HSS signature of the image, NULL to measure without verifying;
+ *                      must stay valid until attestation_cleanup()
+ * @param[in] signature_len Length of signature
+ * @param[in] public_key HSS firmware signing key (HSS_PUBLICKEYBYTES)
+ * @return PQC_SUCCESS on success, error code on failure
+ */
+pqc_result_t attestation_set_firmware_image(const uint8_t *image,
+                                           size_t image_len,
+                                           const uint8_t *signature,
+                                           size_t signature_len,
+                                           const uint8_t *public_key);
+
+/**
+ * @brief HSS signing state store on a TPM NV index
+ * 
+ * For a firmware signing service keeping its HSS state in the TPM; the
+ * index is defined on first write. The simulated TPM only keeps NV across
+ * restarts once tpm2_nv_set_backing_dir() has been called, and this fails
+ * until then rather than hand out a store that breaks the hss_nv_store_t
+ * crash-safety contract; without a TPM, use hss_nv_file_store().
+ * 
+ * @param[out] store Store to initialize
+ * @param[in] nv_index TPM NV index holding the state record
+ * @return PQC_SUCCESS on success, PQC_ERROR_HARDWARE_FAILURE if TPM NV is
+ *         not persistent, error code on other failures
+ */
+pqc_result_t attestation_hss_nv_store(hss_nv_store_t *store, uint32_t nv_index);
+
 // ============================================================================
 // Policy and Verification
 // ============================================================================
@@ -395,6 +525,26 @@ pqc_result_t attestation_get_statistics(void *stats);
  */
 void attestation_reset_statistics(void);
 
+/**
+ * @brief Counters of attestation_verify_report() and
+ *        attestation_verify_report_expanded() since start-up
+ *
+ * The revocation stage is the caller's: these functions are handed the
+ * key to check against and never reject there.
+ */
+void attestation_get_verify_stats(attestation_verify_stats_t *stats);
+
+/**
+ * @brief Stage that rejects reports with a given error
+ *
+ * Lets verifiers that add stages of their own (device lookup, replay
+ * windows) count rejections the same way.
+ *
+ * @param[in] error Error code other than ATTESTATION_ERROR_NONE
+ * @return The stage
+ */
+attestation_stage_t attestation_error_stage(attestation_error_t error);
+
 /**
  * @brief Convert attestation error to string
  * 
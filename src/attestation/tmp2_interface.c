@@ -1,15 +1,19 @@
 /**
- * @file tpm2_interface.c
+ * @file tmp2_interface.c
  * @brief TPM 2.0 interface implementation for attestation engine
  * 
  * Generation 1: Simplified TPM interface for basic attestation functionality
  */
 
-#include "tmp2_interface.h"
+#define _GNU_SOURCE
+#include "tpm2_interface.h"
 #include "../crypto/pqc_common.h"
 #include "../crypto/secure_memory.h"
 #include <string.h>
 #include <stdio.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 // Simulated TPM state for Generation 1
 static struct {
@@ -19,8 +23,10 @@ static struct {
     uint32_t extend_count[MAX_PCR_REGISTERS];
 } tpm_state = {0};
 
+static void tpm_nv_forget(void);
+
 pqc_result_t tpm2_init(void) {
-    if (tmp_state.initialized) {
+    if (tpm_state.initialized) {
         return PQC_SUCCESS; // Already initialized
     }
     
@@ -36,22 +42,23 @@ pqc_result_t tpm2_init(void) {
 }
 
 void tpm2_cleanup(void) {
-    if (!tmp_state.initialized) {
+    if (!tpm_state.initialized) {
         return;
     }
     
     // Clear sensitive TPM state
     for (int i = 0; i < MAX_PCR_REGISTERS; i++) {
         secure_memzero(tpm_state.pcr_values[i], 32);
-        tmp_state.pcr_allocated[i] = false;
+        tpm_state.pcr_allocated[i] = false;
         tpm_state.extend_count[i] = 0;
     }
+    tpm_nv_forget();
     
-    tmp_state.initialized = false;
+    tpm_state.initialized = false;
 }
 
 pqc_result_t tpm2_read_pcr(uint8_t pcr_index, uint8_t pcr_value[32]) {
-    if (!tmp_state.initialized) {
+    if (!tpm_state.initialized) {
         return PQC_ERROR_HARDWARE_FAILURE;
     }
     
@@ -59,7 +66,7 @@ pqc_result_t tpm2_read_pcr(uint8_t pcr_index, uint8_t pcr_value[32]) {
         return PQC_ERROR_INVALID_PARAMETER;
     }
     
-    if (!tmp_state.pcr_allocated[pcr_index]) {
+    if (!tpm_state.pcr_allocated[pcr_index]) {
         return PQC_ERROR_HARDWARE_FAILURE;
     }
     
@@ -67,12 +74,12 @@ pqc_result_t tpm2_read_pcr(uint8_t pcr_index, uint8_t pcr_value[32]) {
         return PQC_ERROR_INVALID_PARAMETER;
     }
     
-    memcpy(pcr_value, tmp_state.pcr_values[pcr_index], 32);
+    memcpy(pcr_value, tpm_state.pcr_values[pcr_index], 32);
     return PQC_SUCCESS;
 }
 
-pqc_result_t tmp2_extend_pcr(uint8_t pcr_index, const uint8_t measurement[32]) {
-    if (!tmp_state.initialized) {
+pqc_result_t tpm2_extend_pcr(uint8_t pcr_index, const uint8_t measurement[32]) {
+    if (!tpm_state.initialized) {
         return PQC_ERROR_HARDWARE_FAILURE;
     }
     
@@ -90,21 +97,21 @@ pqc_result_t tmp2_extend_pcr(uint8_t pcr_index, const uint8_t measurement[32]) {
     
     // Perform PCR extend operation: PCR = SHA-256(current_PCR || measurement)
     uint8_t extend_data[64];
-    memcpy(extend_data, tmp_state.pcr_values[pcr_index], 32);
+    memcpy(extend_data, tpm_state.pcr_values[pcr_index], 32);
     memcpy(extend_data + 32, measurement, 32);
     
     // Calculate new PCR value (simplified hash for Generation 1)
-    pqc_result_t result = sha3_256(tmp_state.pcr_values[pcr_index], extend_data, 64);
+    pqc_result_t result = sha3_256(tpm_state.pcr_values[pcr_index], extend_data, 64);
     if (result != PQC_SUCCESS) {
         return result;
     }
     
-    tmp_state.extend_count[pcr_index]++;
+    tpm_state.extend_count[pcr_index]++;
     return PQC_SUCCESS;
 }
 
 pqc_result_t tpm2_quote(uint8_t pcr_mask, uint8_t *quote_data, size_t *quote_size) {
-    if (!tmp_state.initialized) {
+    if (!tpm_state.initialized) {
         return PQC_ERROR_HARDWARE_FAILURE;
     }
     
@@ -141,7 +148,7 @@ pqc_result_t tpm2_quote(uint8_t pcr_mask, uint8_t *quote_data, size_t *quote_siz
             if (offset + 32 > max_quote_size) {
                 return PQC_ERROR_INSUFFICIENT_MEMORY;
             }
-            memcpy(&quote_data[offset], tmp_state.pcr_values[i], 32);
+            memcpy(&quote_data[offset], tpm_state.pcr_values[i], 32);
             offset += 32;
         }
     }
@@ -151,7 +158,7 @@ pqc_result_t tpm2_quote(uint8_t pcr_mask, uint8_t *quote_data, size_t *quote_siz
 }
 
 pqc_result_t tpm2_create_key(tpm2_key_type_t key_type, tpm2_key_handle_t *key_handle) {
-    if (!tmp_state.initialized) {
+    if (!tpm_state.initialized) {
         return PQC_ERROR_HARDWARE_FAILURE;
     }
     
@@ -178,7 +185,7 @@ pqc_result_t tpm2_create_key(tpm2_key_type_t key_type, tpm2_key_handle_t *key_ha
 }
 
 pqc_result_t tpm2_load_key(const uint8_t *key_data, size_t key_size, tpm2_key_handle_t *key_handle) {
-    if (!tmp_state.initialized) {
+    if (!tpm_state.initialized) {
         return PQC_ERROR_HARDWARE_FAILURE;
     }
     
@@ -194,7 +201,7 @@ pqc_result_t tpm2_load_key(const uint8_t *key_data, size_t key_size, tpm2_key_ha
 }
 
 pqc_result_t tpm2_unload_key(tpm2_key_handle_t key_handle) {
-    if (!tmp_state.initialized) {
+    if (!tpm_state.initialized) {
         return PQC_ERROR_HARDWARE_FAILURE;
     }
     
@@ -205,9 +212,9 @@ pqc_result_t tpm2_unload_key(tpm2_key_handle_t key_handle) {
     return PQC_SUCCESS;
 }
 
-pqc_result_t tpm2_sign(tmp2_key_handle_t key_handle, const uint8_t *data, size_t data_size,
+pqc_result_t tpm2_sign(tpm2_key_handle_t key_handle, const uint8_t *data, size_t data_size,
                       uint8_t *signature, size_t *signature_size) {
-    if (!tmp_state.initialized) {
+    if (!tpm_state.initialized) {
         return PQC_ERROR_HARDWARE_FAILURE;
     }
     
@@ -238,9 +245,9 @@ pqc_result_t tpm2_sign(tmp2_key_handle_t key_handle, const uint8_t *data, size_t
     return PQC_SUCCESS;
 }
 
-pqc_result_t tpm2_verify(tmp2_key_handle_t key_handle, const uint8_t *data, size_t data_size,
+pqc_result_t tpm2_verify(tpm2_key_handle_t key_handle, const uint8_t *data, size_t data_size,
                         const uint8_t *signature, size_t signature_size) {
-    if (!tmp_state.initialized) {
+    if (!tpm_state.initialized) {
         return PQC_ERROR_HARDWARE_FAILURE;
     }
     
@@ -271,7 +278,7 @@ pqc_result_t tpm2_verify(tmp2_key_handle_t key_handle, const uint8_t *data, size
 }
 
 pqc_result_t tpm2_random(uint8_t *buffer, size_t size) {
-    if (!tmp_state.initialized) {
+    if (!tpm_state.initialized) {
         return PQC_ERROR_HARDWARE_FAILURE;
     }
     
@@ -283,13 +290,224 @@ pqc_result_t tpm2_random(uint8_t *buffer, size_t size) {
     return pqc_randombytes(buffer, size);
 }
 
+// Simulated NV indices for Generation 1
+#define TPM_NV_MAX_INDICES  8
+#define TPM_NV_MAX_SIZE     2048
+#define TPM_NV_MAGIC        0x564E5054u     /**< "TPNV" */
+
+static struct {
+    bool defined;
+    uint32_t index;
+    uint32_t attributes;
+    size_t size;
+    size_t written;
+    uint8_t data[TPM_NV_MAX_SIZE];
+} tpm_nv[TPM_NV_MAX_INDICES];
+
+// Directory holding one file per index; NULL keeps NV in RAM only
+static const char *tpm_nv_dir;
+
+// On-disk layout of a backed index, followed by `written` data bytes
+typedef struct {
+    uint32_t magic;
+    uint32_t index;
+    uint32_t attributes;
+    uint32_t size;
+    uint32_t written;
+} tpm_nv_file_header_t;
+
+static void tpm_nv_path(char path[PATH_MAX], uint32_t index, const char *suffix) {
+    snprintf(path, PATH_MAX, "%s/nv-%08x.bin%s", tpm_nv_dir, index, suffix);
+}
+
+// Replace the index file as a whole so a crash leaves the old or the new contents
+static pqc_result_t tpm_nv_persist(int slot) {
+    char path[PATH_MAX];
+    char tmp[PATH_MAX];
+    tpm_nv_file_header_t header = {
+        .magic = TPM_NV_MAGIC,
+        .index = tpm_nv[slot].index,
+        .attributes = tpm_nv[slot].attributes,
+        .size = (uint32_t)tpm_nv[slot].size,
+        .written = (uint32_t)tpm_nv[slot].written,
+    };
+
+    tpm_nv_path(path, header.index, "");
+    tpm_nv_path(tmp, header.index, ".tmp");
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+    bool ok = write(fd, &header, sizeof(header)) == (ssize_t)sizeof(header) &&
+              write(fd, tpm_nv[slot].data, header.written) == (ssize_t)header.written &&
+              fsync(fd) == 0;
+    ok = close(fd) == 0 && ok;
+    if (!ok || rename(tmp, path) != 0) {
+        unlink(tmp);
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+
+    // The rename itself must reach the disk before the caller relies on it
+    fd = open(tpm_nv_dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+    ok = fsync(fd) == 0;
+    close(fd);
+    return ok ? PQC_SUCCESS : PQC_ERROR_HARDWARE_FAILURE;
+}
+
+static int tpm_nv_free_slot(void) {
+    for (int i = 0; i < TPM_NV_MAX_INDICES; i++) {
+        if (!tpm_nv[i].defined) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Bring an index defined before a restart back from its file
+static int tpm_nv_load(uint32_t index) {
+    char path[PATH_MAX];
+    tpm_nv_file_header_t header;
+    int slot = tpm_nv_free_slot();
+    if (!tpm_nv_dir || slot < 0) {
+        return -1;
+    }
+
+    tpm_nv_path(path, index, "");
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    bool ok = read(fd, &header, sizeof(header)) == (ssize_t)sizeof(header) &&
+              header.magic == TPM_NV_MAGIC && header.index == index &&
+              header.size > 0 && header.size <= TPM_NV_MAX_SIZE &&
+              header.written <= header.size &&
+              read(fd, tpm_nv[slot].data, header.written) == (ssize_t)header.written;
+    close(fd);
+    if (!ok) {
+        secure_memzero(tpm_nv[slot].data, sizeof(tpm_nv[slot].data));
+        return -1;
+    }
+
+    tpm_nv[slot].defined = true;
+    tpm_nv[slot].index = index;
+    tpm_nv[slot].attributes = header.attributes;
+    tpm_nv[slot].size = header.size;
+    tpm_nv[slot].written = header.written;
+    return slot;
+}
+
+static int tpm_nv_find(uint32_t index) {
+    for (int i = 0; i < TPM_NV_MAX_INDICES; i++) {
+        if (tpm_nv[i].defined && tpm_nv[i].index == index) {
+            return i;
+        }
+    }
+    return tpm_nv_load(index);
+}
+
+// Drop RAM copies of backed indices; the next access reloads them from disk
+static void tpm_nv_forget(void) {
+    if (tpm_nv_dir) {
+        secure_memzero(tpm_nv, sizeof(tpm_nv));
+    }
+}
+
+pqc_result_t tpm2_nv_set_backing_dir(const char *dir) {
+    char path[PATH_MAX];
+    if (dir && (size_t)snprintf(path, sizeof(path), "%s/nv-00000000.bin.tmp", dir) >= sizeof(path)) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    // Indices already in RAM belong to the previous backing
+    secure_memzero(tpm_nv, sizeof(tpm_nv));
+    tpm_nv_dir = dir;
+    return PQC_SUCCESS;
+}
+
+bool tpm2_nv_is_persistent(void) {
+    return tpm_nv_dir != NULL;
+}
+
+pqc_result_t tpm2_nv_define(uint32_t index, size_t size, uint32_t attributes) {
+    if (!tpm_state.initialized) {
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+    if (size == 0 || size > TPM_NV_MAX_SIZE || tpm_nv_find(index) >= 0) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    int slot = tpm_nv_free_slot();
+    if (slot < 0) {
+        return PQC_ERROR_INSUFFICIENT_MEMORY;
+    }
+    tpm_nv[slot].defined = true;
+    tpm_nv[slot].index = index;
+    tpm_nv[slot].attributes = attributes;
+    tpm_nv[slot].size = size;
+    tpm_nv[slot].written = 0;
+
+    pqc_result_t result = tpm_nv_dir ? tpm_nv_persist(slot) : PQC_SUCCESS;
+    if (result != PQC_SUCCESS) {
+        secure_memzero(&tpm_nv[slot], sizeof(tpm_nv[slot]));
+    }
+    return result;
+}
+
+pqc_result_t tpm2_nv_undefine(uint32_t index) {
+    int slot = tpm_nv_find(index);
+    if (slot < 0) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    if (tpm_nv_dir) {
+        char path[PATH_MAX];
+        tpm_nv_path(path, index, "");
+        if (unlink(path) != 0) {
+            return PQC_ERROR_HARDWARE_FAILURE;
+        }
+    }
+    secure_memzero(&tpm_nv[slot], sizeof(tpm_nv[slot]));
+    return PQC_SUCCESS;
+}
+
+pqc_result_t tpm2_nv_write(uint32_t index, const uint8_t *data, size_t data_size) {
+    if (!tpm_state.initialized) {
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+    int slot = tpm_nv_find(index);
+    if (slot < 0 || !data || data_size > tpm_nv[slot].size) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    // A TPM applies an NV write of up to its NV buffer size atomically
+    memcpy(tpm_nv[slot].data, data, data_size);
+    tpm_nv[slot].written = data_size;
+    return tpm_nv_dir ? tpm_nv_persist(slot) : PQC_SUCCESS;
+}
+
+pqc_result_t tpm2_nv_read(uint32_t index, uint8_t *data, size_t *data_size) {
+    if (!tpm_state.initialized) {
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+    int slot = tpm_nv_find(index);
+    if (slot < 0 || !data || !data_size || *data_size < tpm_nv[slot].written) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    memcpy(data, tpm_nv[slot].data, tpm_nv[slot].written);
+    *data_size = tpm_nv[slot].written;
+    return PQC_SUCCESS;
+}
+
 bool tpm2_is_present(void) {
     // For Generation 1, assume TPM is always present in simulation
     return true;
 }
 
-pqc_result_t tmp2_get_capability(tmp2_capability_t capability, void *capability_data) {
-    if (!tmp_state.initialized) {
+pqc_result_t tpm2_get_capability(tpm2_capability_t capability, void *capability_data) {
+    if (!tpm_state.initialized) {
         return PQC_ERROR_HARDWARE_FAILURE;
     }
     
@@ -298,7 +516,7 @@ pqc_result_t tmp2_get_capability(tmp2_capability_t capability, void *capability_
     }
     
     switch (capability) {
-        case TMP2_CAP_TPM_PROPERTIES: {
+        case TPM2_CAP_TPM_PROPERTIES: {
             tpm2_tpm_properties_t *props = (tpm2_tpm_properties_t*)capability_data;
             props->family = 0x322E3000; // TPM 2.0
             props->level = 0;
@@ -307,15 +525,15 @@ pqc_result_t tmp2_get_capability(tmp2_capability_t capability, void *capability_
             strncpy(props->vendor_string, "Simulation TPM", sizeof(props->vendor_string));
             break;
         }
-        case TMP2_CAP_ALGORITHMS: {
+        case TPM2_CAP_ALGORITHMS: {
             tpm2_algorithm_list_t *algs = (tpm2_algorithm_list_t*)capability_data;
             algs->count = 3;
-            algs->algorithms[0] = TMP2_ALG_SHA256;
-            algs->algorithms[1] = TMP2_ALG_RSA;
-            algs->algorithms[2] = TMP2_ALG_ECC;
+            algs->algorithms[0] = TPM2_ALG_SHA256;
+            algs->algorithms[1] = TPM2_ALG_RSA;
+            algs->algorithms[2] = TPM2_ALG_ECC;
             break;
         }
-        case TMP2_CAP_PCR_PROPERTIES: {
+        case TPM2_CAP_PCR_PROPERTIES: {
             tpm2_pcr_properties_t *pcr_props = (tpm2_pcr_properties_t*)capability_data;
             pcr_props->pcr_count = MAX_PCR_REGISTERS;
             for (int i = 0; i < MAX_PCR_REGISTERS; i++) {
@@ -331,7 +549,7 @@ pqc_result_t tmp2_get_capability(tmp2_capability_t capability, void *capability_
 }
 
 pqc_result_t tpm2_self_test(void) {
-    if (!tmp_state.initialized) {
+    if (!tpm_state.initialized) {
         return PQC_ERROR_HARDWARE_FAILURE;
     }
     
@@ -348,7 +566,7 @@ pqc_result_t tpm2_self_test(void) {
         return result;
     }
     
-    result = tmp2_extend_pcr(test_pcr, test_measurement);
+    result = tpm2_extend_pcr(test_pcr, test_measurement);
     if (result != PQC_SUCCESS) {
         return result;
     }
@@ -365,8 +583,8 @@ pqc_result_t tpm2_self_test(void) {
     }
     
     // Test key operations
-    tmp2_key_handle_t test_key;
-    result = tpm2_create_key(TMP2_KEY_TYPE_RSA_2048, &test_key);
+    tpm2_key_handle_t test_key;
+    result = tpm2_create_key(TPM2_KEY_TYPE_RSA_2048, &test_key);
     if (result != PQC_SUCCESS) {
         return result;
     }
@@ -376,39 +594,39 @@ pqc_result_t tpm2_self_test(void) {
     uint8_t signature[256];
     size_t sig_size = sizeof(signature);
     
-    result = tmp2_sign(test_key, (const uint8_t*)test_data, strlen(test_data), 
+    result = tpm2_sign(test_key, (const uint8_t*)test_data, strlen(test_data), 
                       signature, &sig_size);
     if (result != PQC_SUCCESS) {
         return result;
     }
     
-    result = tmp2_verify(test_key, (const uint8_t*)test_data, strlen(test_data), 
+    result = tpm2_verify(test_key, (const uint8_t*)test_data, strlen(test_data), 
                         signature, sig_size);
     if (result != PQC_SUCCESS) {
         return result;
     }
     
     // Cleanup test key
-    tmp2_unload_key(test_key);
+    tpm2_unload_key(test_key);
     
     return PQC_SUCCESS;
 }
 
 uint32_t tpm2_get_extend_count(uint8_t pcr_index) {
-    if (!tmp_state.initialized || pcr_index >= MAX_PCR_REGISTERS) {
+    if (!tpm_state.initialized || pcr_index >= MAX_PCR_REGISTERS) {
         return 0;
     }
     
-    return tmp_state.extend_count[pcr_index];
+    return tpm_state.extend_count[pcr_index];
 }
 
-void tmp2_reset_pcr(uint8_t pcr_index) {
+void tpm2_reset_pcr(uint8_t pcr_index) {
     if (!tpm_state.initialized || pcr_index >= MAX_PCR_REGISTERS) {
         return;
     }
     
-    memset(tmp_state.pcr_values[pcr_index], 0, 32);
-    tmp_state.extend_count[pcr_index] = 0;
+    memset(tpm_state.pcr_values[pcr_index], 0, 32);
+    tpm_state.extend_count[pcr_index] = 0;
 }
 
 const char* tpm2_error_to_string(pqc_result_t error) {
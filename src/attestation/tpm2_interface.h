@@ -1,5 +1,5 @@
 /**
- * @file tmp2_interface.h
+ * @file tpm2_interface.h
  * @brief TPM 2.0 interface for hardware attestation
  * 
  * This header defines the interface for TPM 2.0 operations used in the
@@ -23,51 +23,51 @@ extern "C" {
 // ============================================================================
 
 #define MAX_PCR_REGISTERS        8      /**< Maximum number of PCR registers */
-#define TMP2_DIGEST_SIZE        32      /**< SHA-256 digest size */
-#define TMP2_MAX_SIGNATURE_SIZE 256     /**< Maximum signature size */
-#define TMP2_MAX_KEY_SIZE       512     /**< Maximum key size */
+#define TPM2_DIGEST_SIZE        32      /**< SHA-256 digest size */
+#define TPM2_MAX_SIGNATURE_SIZE 256     /**< Maximum signature size */
+#define TPM2_MAX_KEY_SIZE       512     /**< Maximum key size */
 
 /**
  * @brief TPM 2.0 key types
  */
 typedef enum {
-    TMP2_KEY_TYPE_RSA_2048 = 1,         /**< RSA 2048-bit key */
-    TMP2_KEY_TYPE_RSA_3072 = 2,         /**< RSA 3072-bit key */
-    TMP2_KEY_TYPE_ECC_P256 = 3,         /**< ECC P-256 key */
-    TMP2_KEY_TYPE_ECC_P384 = 4,         /**< ECC P-384 key */
-    TMP2_KEY_TYPE_HMAC = 5,             /**< HMAC key */
-    TMP2_KEY_TYPE_SYMMETRIC = 6         /**< Symmetric encryption key */
+    TPM2_KEY_TYPE_RSA_2048 = 1,         /**< RSA 2048-bit key */
+    TPM2_KEY_TYPE_RSA_3072 = 2,         /**< RSA 3072-bit key */
+    TPM2_KEY_TYPE_ECC_P256 = 3,         /**< ECC P-256 key */
+    TPM2_KEY_TYPE_ECC_P384 = 4,         /**< ECC P-384 key */
+    TPM2_KEY_TYPE_HMAC = 5,             /**< HMAC key */
+    TPM2_KEY_TYPE_SYMMETRIC = 6         /**< Symmetric encryption key */
 } tpm2_key_type_t;
 
 /**
  * @brief TPM 2.0 algorithm identifiers
  */
 typedef enum {
-    TMP2_ALG_SHA1 = 0x0004,             /**< SHA-1 algorithm */
-    TMP2_ALG_SHA256 = 0x000B,           /**< SHA-256 algorithm */
-    TMP2_ALG_SHA384 = 0x000C,           /**< SHA-384 algorithm */
-    TMP2_ALG_SHA512 = 0x000D,           /**< SHA-512 algorithm */
-    TMP2_ALG_RSA = 0x0001,              /**< RSA algorithm */
-    TMP2_ALG_ECC = 0x0018,              /**< ECC algorithm */
-    TMP2_ALG_HMAC = 0x0005,             /**< HMAC algorithm */
-    TMP2_ALG_AES = 0x0006               /**< AES algorithm */
-} tmp2_algorithm_t;
+    TPM2_ALG_SHA1 = 0x0004,             /**< SHA-1 algorithm */
+    TPM2_ALG_SHA256 = 0x000B,           /**< SHA-256 algorithm */
+    TPM2_ALG_SHA384 = 0x000C,           /**< SHA-384 algorithm */
+    TPM2_ALG_SHA512 = 0x000D,           /**< SHA-512 algorithm */
+    TPM2_ALG_RSA = 0x0001,              /**< RSA algorithm */
+    TPM2_ALG_ECC = 0x0018,              /**< ECC algorithm */
+    TPM2_ALG_HMAC = 0x0005,             /**< HMAC algorithm */
+    TPM2_ALG_AES = 0x0006               /**< AES algorithm */
+} tpm2_algorithm_t;
 
 /**
  * @brief TPM 2.0 capability types
  */
 typedef enum {
-    TMP2_CAP_TPM_PROPERTIES = 1,        /**< TPM properties */
-    TMP2_CAP_ALGORITHMS = 2,            /**< Supported algorithms */
-    TMP2_CAP_COMMANDS = 3,              /**< Supported commands */
-    TMP2_CAP_PCR_PROPERTIES = 4,        /**< PCR properties */
-    TMP2_CAP_HANDLES = 5                /**< Active handles */
-} tmp2_capability_t;
+    TPM2_CAP_TPM_PROPERTIES = 1,        /**< TPM properties */
+    TPM2_CAP_ALGORITHMS = 2,            /**< Supported algorithms */
+    TPM2_CAP_COMMANDS = 3,              /**< Supported commands */
+    TPM2_CAP_PCR_PROPERTIES = 4,        /**< PCR properties */
+    TPM2_CAP_HANDLES = 5                /**< Active handles */
+} tpm2_capability_t;
 
 /**
  * @brief TPM 2.0 key handle type
  */
-typedef uint32_t tmp2_key_handle_t;
+typedef uint32_t tpm2_key_handle_t;
 
 // ============================================================================
 // Data Structures
@@ -89,8 +89,8 @@ typedef struct {
  */
 typedef struct {
     uint32_t count;                     /**< Number of algorithms */
-    tmp2_algorithm_t algorithms[32];    /**< Algorithm list */
-} tmp2_algorithm_list_t;
+    tpm2_algorithm_t algorithms[32];    /**< Algorithm list */
+} tpm2_algorithm_list_t;
 
 /**
  * @brief PCR properties structure
@@ -98,39 +98,63 @@ typedef struct {
 typedef struct {
     uint32_t pcr_count;                 /**< Number of PCRs */
     uint32_t pcr_sizes[MAX_PCR_REGISTERS]; /**< Size of each PCR */
-} tmp2_pcr_properties_t;
+} tpm2_pcr_properties_t;
 
 /**
  * @brief TPM quote structure
  */
 typedef struct {
     uint8_t pcr_selection;              /**< Selected PCRs */
-    uint8_t pcr_digest[TMP2_DIGEST_SIZE]; /**< Digest of selected PCRs */
+    uint8_t pcr_digest[TPM2_DIGEST_SIZE]; /**< Digest of selected PCRs */
     uint64_t clock;                     /**< TPM clock */
     uint32_t reset_count;               /**< Reset count */
     uint32_t restart_count;             /**< Restart count */
-    uint8_t signature[TMP2_MAX_SIGNATURE_SIZE]; /**< Quote signature */
+    uint8_t signature[TPM2_MAX_SIGNATURE_SIZE]; /**< Quote signature */
     uint32_t signature_size;            /**< Signature size */
-} tmp2_quote_t;
+} tpm2_quote_t;
 
 // Core function declarations
-pqc_result_t tmp2_init(void);
-void tmp2_cleanup(void);
-bool tmp2_is_present(void);
-pqc_result_t tmp2_self_test(void);
-pqc_result_t tmp2_get_capability(tpm2_capability_t capability, void *capability_data);
-pqc_result_t tmp2_read_pcr(uint8_t pcr_index, uint8_t pcr_value[32]);
-pqc_result_t tmp2_extend_pcr(uint8_t pcr_index, const uint8_t measurement[32]);
-pqc_result_t tmp2_quote(uint8_t pcr_mask, uint8_t *quote_data, size_t *quote_size);
-uint32_t tmp2_get_extend_count(uint8_t pcr_index);
-void tmp2_reset_pcr(uint8_t pcr_index);
-pqc_result_t tmp2_create_key(tpm2_key_type_t key_type, tmp2_key_handle_t *key_handle);
-pqc_result_t tmp2_load_key(const uint8_t *key_data, size_t key_size, tmp2_key_handle_t *key_handle);
-pqc_result_t tmp2_unload_key(tmp2_key_handle_t key_handle);
-pqc_result_t tmp2_sign(tpm2_key_handle_t key_handle, const uint8_t *data, size_t data_size, uint8_t *signature, size_t *signature_size);
-pqc_result_t tmp2_verify(tmp2_key_handle_t key_handle, const uint8_t *data, size_t data_size, const uint8_t *signature, size_t signature_size);
-pqc_result_t tmp2_random(uint8_t *buffer, size_t size);
-const char* tmp2_error_to_string(pqc_result_t error);
+pqc_result_t tpm2_init(void);
+void tpm2_cleanup(void);
+bool tpm2_is_present(void);
+pqc_result_t tpm2_self_test(void);
+pqc_result_t tpm2_get_capability(tpm2_capability_t capability, void *capability_data);
+pqc_result_t tpm2_read_pcr(uint8_t pcr_index, uint8_t pcr_value[32]);
+pqc_result_t tpm2_extend_pcr(uint8_t pcr_index, const uint8_t measurement[32]);
+pqc_result_t tpm2_quote(uint8_t pcr_mask, uint8_t *quote_data, size_t *quote_size);
+uint32_t tpm2_get_extend_count(uint8_t pcr_index);
+void tpm2_reset_pcr(uint8_t pcr_index);
+pqc_result_t tpm2_create_key(tpm2_key_type_t key_type, tpm2_key_handle_t *key_handle);
+pqc_result_t tpm2_load_key(const uint8_t *key_data, size_t key_size, tpm2_key_handle_t *key_handle);
+pqc_result_t tpm2_unload_key(tpm2_key_handle_t key_handle);
+pqc_result_t tpm2_sign(tpm2_key_handle_t key_handle, const uint8_t *data, size_t data_size, uint8_t *signature, size_t *signature_size);
+pqc_result_t tpm2_verify(tpm2_key_handle_t key_handle, const uint8_t *data, size_t data_size, const uint8_t *signature, size_t signature_size);
+pqc_result_t tpm2_random(uint8_t *buffer, size_t size);
+pqc_result_t tpm2_nv_define(uint32_t index, size_t size, uint32_t attributes);
+pqc_result_t tpm2_nv_write(uint32_t index, const uint8_t *data, size_t data_size);
+pqc_result_t tpm2_nv_read(uint32_t index, uint8_t *data, size_t *data_size);
+pqc_result_t tpm2_nv_undefine(uint32_t index);
+const char* tpm2_error_to_string(pqc_result_t error);
+
+/**
+ * @brief Back the simulated NV indices with files in a directory
+ * 
+ * A real TPM keeps NV indices across power loss. The simulation keeps them
+ * in RAM until a backing directory is set; from then on each index lives
+ * in "<dir>/nv-<index>.bin", is replaced atomically (temp file, fsync,
+ * rename, fsync of the directory) on every write, and is found again after
+ * a restart.
+ * 
+ * @param[in] dir Backing directory, NULL to go back to RAM; the string must
+ *                outlive its use
+ * @return PQC_SUCCESS on success, PQC_ERROR_INVALID_PARAMETER if dir is too long
+ */
+pqc_result_t tpm2_nv_set_backing_dir(const char *dir);
+
+/**
+ * @brief Whether NV writes survive a restart or power loss
+ */
+bool tpm2_nv_is_persistent(void);
 
 #ifdef __cplusplus
 }
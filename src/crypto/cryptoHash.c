@@ -7,6 +7,8 @@
  */
 
 #include "pqc_common.h"
+#include "pqc_bytes.h"
+#include "pqc_trace.h"
 #include "secure_memory.h"
 #include <string.h>
 #include <stdint.h>
@@ -52,7 +54,7 @@ typedef struct {
  * @brief ROL64 - rotate left 64-bit
  */
 static inline uint64_t rol64(uint64_t x, unsigned int n) {
-    return (x << n) | (x >> (64 - n));
+    return (x << n) | (x >> ((64 - n) & 63));
 }
 
 /**
@@ -247,21 +249,37 @@ pqc_result_t shake256_enhanced(uint8_t *output, size_t outlen,
 
 // Convenience wrappers that replace the simplified Generation 1 implementations
 pqc_result_t sha3_256(uint8_t hash[32], const uint8_t *input, size_t inlen) {
-    return sha3_256_enhanced(hash, input, inlen);
+    PQC_BYTES_COUNT(PQC_BYTES_HASHED, inlen);
+    PQC_TRACE_KECCAK_ENTRY("sha3_256", inlen, 32);
+    pqc_result_t result = sha3_256_enhanced(hash, input, inlen);
+    PQC_TRACE_KECCAK_RETURN("sha3_256", result);
+    return result;
 }
 
 pqc_result_t sha3_512(uint8_t hash[64], const uint8_t *input, size_t inlen) {
-    return sha3_512_enhanced(hash, input, inlen);
+    PQC_BYTES_COUNT(PQC_BYTES_HASHED, inlen);
+    PQC_TRACE_KECCAK_ENTRY("sha3_512", inlen, 64);
+    pqc_result_t result = sha3_512_enhanced(hash, input, inlen);
+    PQC_TRACE_KECCAK_RETURN("sha3_512", result);
+    return result;
 }
 
 pqc_result_t shake128(uint8_t *output, size_t outlen, const uint8_t *input, size_t inlen) {
-    return shake128_enhanced(output, outlen, input, inlen);
+    PQC_BYTES_COUNT(PQC_BYTES_HASHED, inlen);
+    PQC_TRACE_KECCAK_ENTRY("shake128", inlen, outlen);
+    pqc_result_t result = shake128_enhanced(output, outlen, input, inlen);
+    PQC_TRACE_KECCAK_RETURN("shake128", result);
+    return result;
 }
 
 pqc_result_t shake256(uint8_t *output, size_t outlen, 
                      const uint8_t *input, size_t inlen,
                      const uint8_t *custom, size_t customlen) {
-    return shake256_enhanced(output, outlen, input, inlen, custom, customlen);
+    PQC_BYTES_COUNT(PQC_BYTES_HASHED, inlen + customlen);
+    PQC_TRACE_KECCAK_ENTRY("shake256", inlen + customlen, outlen);
+    pqc_result_t result = shake256_enhanced(output, outlen, input, inlen, custom, customlen);
+    PQC_TRACE_KECCAK_RETURN("shake256", result);
+    return result;
 }
 
 // Additional security-focused hash utilities
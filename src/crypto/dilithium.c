@@ -1,14 +1,23 @@
 /**
  * @file dilithium.c
  * @brief Dilithium-5 post-quantum digital signature implementation
- * 
+ *
  * This implements the NIST-standardized Dilithium-5 algorithm for quantum-resistant
  * digital signatures. The implementation focuses on security and constant-time
  * operations for embedded systems.
+ *
+ * The arithmetic, sampling and encodings follow the round 3.1 reference
+ * (mode 5, randomized signing). Coefficients are signed 32-bit values;
+ * the secret key and expanded public key structures keep them in their
+ * uint32_t arrays as two's complement.
  */
 
 #include "dilithium.h"
 #include "pqc_common.h"
+#include "pqc_bytes.h"
+#include "pqc_ntt.h"
+#include "pqc_perf.h"
+#include "pqc_trace.h"
 #include "secure_memory.h"
 #include <string.h>
 
@@ -17,7 +26,7 @@
 #define DILITHIUM_L 7
 #define DILITHIUM_ETA 2
 #define DILITHIUM_TAU 60
-#define DILITHIUM_BETA 196
+#define DILITHIUM_BETA 120
 #define DILITHIUM_GAMMA1 (1 << 19)
 #define DILITHIUM_GAMMA2 ((DILITHIUM_Q - 1) / 32)
 #define DILITHIUM_OMEGA 75
@@ -26,79 +35,85 @@
 #define DILITHIUM_Q 8380417
 #define DILITHIUM_D 13
 #define DILITHIUM_ROOT_OF_UNITY 1753
-#define DILITHIUM_QINV 58728449
+#define DILITHIUM_MONT PQC_NTT_RADIX(32, DILITHIUM_Q)   // 2^32 mod q
+
+#define DILITHIUM_CRHBYTES        64
+#define DILITHIUM_POLYT1_BYTES    320   /**< 10 bits per coefficient */
+#define DILITHIUM_POLYZ_BYTES     640   /**< 20 bits per coefficient */
+#define DILITHIUM_POLYW1_BYTES    128   /**< 4 bits per coefficient */
+#define DILITHIUM_SHAKE128_RATE   168
+#define DILITHIUM_SHAKE256_RATE   136
+
+_Static_assert(DILITHIUM_SYMBYTES + DILITHIUM_K * DILITHIUM_POLYT1_BYTES == DILITHIUM_PUBLICKEYBYTES,
+               "public key is rho || t1");
+_Static_assert(DILITHIUM_SYMBYTES + DILITHIUM_L * DILITHIUM_POLYZ_BYTES + DILITHIUM_OMEGA + DILITHIUM_K ==
+               DILITHIUM_SIGNATUREBYTES, "signature is c || z || h");
+_Static_assert(DILITHIUM_BETA == DILITHIUM_TAU * DILITHIUM_ETA, "beta bounds |c * s|");
+
+// NTT constants, generated from q and the root of unity
+PQC_NTT_DEFINE_POWERS(DILITHIUM_ROOT, DILITHIUM_ROOT_OF_UNITY, DILITHIUM_Q);
+
+_Static_assert(DILITHIUM_ROOT_POW256 == DILITHIUM_Q - 1,
+               "1753 must be a primitive 512-th root of unity mod q");
+_Static_assert(PQC_NTT_QINV32(DILITHIUM_Q) == DILITHIUM_QINV, "DILITHIUM_QINV must be q^-1 mod 2^32");
+
+// zetas[k] = mont * 1753^brev8(k) mod q; zetas[0] is never read and kept 0
+#define DILITHIUM_ZETA(k) \
+    ((k) ? PQC_NTT_MONT(PQC_NTT_POW_BITREV(DILITHIUM_ROOT, k, 8, DILITHIUM_Q), \
+                        DILITHIUM_MONT, DILITHIUM_Q) : 0)
+
+// Scaling folded into the last inverse NTT layer: mont^2/256 mod q
+#define DILITHIUM_INVNTT_F \
+    PQC_NTT_MULMOD(PQC_NTT_MULMOD(DILITHIUM_MONT, DILITHIUM_MONT, DILITHIUM_Q), \
+                   PQC_NTT_INV_N(256, DILITHIUM_Q), DILITHIUM_Q)
+
+_Static_assert(DILITHIUM_ZETA(1) == 25847, "zetas must match the Dilithium reference table");
+_Static_assert(DILITHIUM_INVNTT_F == 41978, "inverse NTT scaling must match the Dilithium reference");
 
 // Precomputed constants for NTT
-static const uint32_t zetas[256] = {
-    0, 25847, 5771523, 7861508, 237124, 7602457, 7504169, 466468,
-    1826347, 2353451, 8021166, 6288512, 3119733, 5495562, 3111497, 2680103,
-    2725464, 1024112, 7300517, 3585928, 7830929, 7260833, 2619752, 6271868,
-    6262231, 4520680, 6980856, 5102745, 1757237, 8360995, 4010497, 280005,
-    2706023, 95776, 3077325, 3530437, 6718724, 4788269, 5842901, 3915439,
-    4519302, 5336701, 3574422, 5512770, 3539968, 8079950, 2348700, 7841118,
-    6681150, 6736599, 3505694, 4558682, 3507263, 6239768, 6779997, 3699596,
-    811944, 531354, 954230, 3881043, 3900724, 5823537, 2071892, 5582638,
-    4450022, 6851714, 4702672, 5339162, 6927966, 3475950, 2176455, 6795196,
-    7122806, 1939314, 4296819, 7380215, 5190273, 5223087, 4747489, 126922,
-    3412210, 7396998, 2147896, 2715295, 5412772, 4686924, 7969390, 5903370,
-    7709315, 7151892, 8357436, 7072248, 7998430, 1349076, 1852771, 6949987,
-    5037034, 264944, 508951, 3097992, 44288, 7280319, 904516, 3958618,
-    4656075, 8371839, 1653064, 5130689, 2389356, 8169440, 759969, 7063561,
-    189548, 4827145, 3159746, 6529015, 5971092, 8202977, 1315589, 1341330,
-    1285669, 6795489, 7567685, 6940675, 5361315, 4499357, 4751448, 3839961,
-    2091667, 3407706, 2316500, 3817976, 5037939, 2244091, 5933984, 4817955,
-    266997, 2434439, 7144689, 3513181, 4860065, 4621053, 7183191, 5187039,
-    900702, 1859098, 909542, 819034, 495491, 6767243, 8337157, 7857917,
-    7725090, 5257975, 2031748, 3207046, 4823422, 7855319, 7611795, 4784579,
-    342297, 286988, 5942594, 4108315, 3437287, 5038140, 1735879, 203044,
-    2842341, 2691481, 5790267, 1265009, 4055324, 1247620, 2486353, 1595974,
-    4613401, 1250494, 2635921, 4832145, 5386378, 1869119, 1903435, 7329447,
-    7047359, 1237275, 5062207, 6950192, 7929317, 1312455, 3306115, 6417775,
-    7100756, 1917081, 5834105, 7005614, 1500165, 777191, 2235880, 3406031,
-    7838005, 5548557, 6709241, 6533464, 5796124, 4656147, 594136, 4603424,
-    6366809, 2432395, 2454455, 8215696, 1957272, 3369112, 185531, 7173032,
-    5196991, 162844, 1616392, 3014001, 810149, 1652634, 4686184, 6581310,
-    5341501, 3523897, 3866901, 269760, 2213111, 7404533, 1717735, 472078,
-    7953734, 1723600, 6577327, 1910376, 6712985, 7276084, 8119771, 4546524,
-    5441381, 6144432, 7959518, 6094090, 183443, 7403526, 1612842, 4834730,
-    7826001, 3919660, 8332111, 7018208, 3937738, 1400424, 7534263, 1976782
-};
+static const uint32_t zetas[256] = { PQC_NTT_REP256(DILITHIUM_ZETA, 0) };
 
 /**
  * @brief Montgomery reduction for Dilithium
- * @param a Input value
- * @return Reduced value modulo q
+ * @param a Input value, |a| <= 2^31 * q
+ * @return a * 2^-32 mod q, in (-q, q)
  */
-static inline uint32_t montgomery_reduce(uint64_t a) {
-    uint64_t t = (a * DILITHIUM_QINV) & ((1ULL << 32) - 1);
-    t *= DILITHIUM_Q;
-    t = a - t;
-    return (uint32_t)(t >> 32);
+static inline int32_t montgomery_reduce(int64_t a) {
+    int32_t t = (int32_t)((uint32_t)a * (uint32_t)DILITHIUM_QINV);
+    return (int32_t)((a - (int64_t)t * DILITHIUM_Q) >> 32);
 }
 
 /**
  * @brief Reduce polynomial coefficient modulo q
+ * @param a Input coefficient, a <= 2^31 - 2^22 - 1
+ * @return Representative in [-6283009, 6283007]
+ */
+static inline int32_t reduce32(int32_t a) {
+    int32_t t = (a + (1 << 22)) >> 23;
+    return a - t * DILITHIUM_Q;
+}
+
+/**
+ * @brief Add q to a negative coefficient
  * @param a Input coefficient
- * @return Reduced coefficient
+ * @return a mod q in [0, q) for a in (-q, q)
  */
-static inline uint32_t reduce32(uint32_t a) {
-    uint32_t t = (a + (1U << 22)) >> 23;
-    t *= DILITHIUM_Q;
-    return a - t;
+static inline int32_t caddq(int32_t a) {
+    return a + ((a >> 31) & DILITHIUM_Q);
 }
 
 /**
  * @brief Number theoretic transform for polynomial multiplication
- * @param poly Polynomial to transform
+ * @param poly Polynomial to transform; output is not reduced
  */
-static void ntt(uint32_t poly[DILITHIUM_N]) {
-    int len, start, j, k = 1;
+static void ntt(int32_t poly[DILITHIUM_N]) {
+    int len, start, j, k = 0;
 
     for (len = 128; len > 0; len >>= 1) {
         for (start = 0; start < DILITHIUM_N; start = j + len) {
-            uint32_t zeta = zetas[k++];
+            int32_t zeta = (int32_t)zetas[++k];
             for (j = start; j < start + len; j++) {
-                uint32_t t = montgomery_reduce((uint64_t)zeta * poly[j + len]);
+                int32_t t = montgomery_reduce((int64_t)zeta * poly[j + len]);
                 poly[j + len] = poly[j] - t;
                 poly[j] = poly[j] + t;
             }
@@ -107,82 +122,187 @@ static void ntt(uint32_t poly[DILITHIUM_N]) {
 }
 
 /**
- * @brief Inverse number theoretic transform
- * @param poly Polynomial to inverse transform
+ * @brief Inverse number theoretic transform, multiplying by the Montgomery factor
+ * @param poly Polynomial to inverse transform; coefficients end in (-q, q)
  */
-static void invntt(uint32_t poly[DILITHIUM_N]) {
-    int len, start, j, k = 255;
-    const uint32_t f = 41978; // 256^(-1) mod q
+static void invntt(int32_t poly[DILITHIUM_N]) {
+    int len, start, j, k = 256;
+    const int32_t f = DILITHIUM_INVNTT_F;
 
     for (len = 1; len < DILITHIUM_N; len <<= 1) {
         for (start = 0; start < DILITHIUM_N; start = j + len) {
-            uint32_t zeta = zetas[k--];
+            int32_t zeta = -(int32_t)zetas[--k];
             for (j = start; j < start + len; j++) {
-                uint32_t t = poly[j];
+                int32_t t = poly[j];
                 poly[j] = t + poly[j + len];
                 poly[j + len] = t - poly[j + len];
-                poly[j + len] = montgomery_reduce((uint64_t)zeta * poly[j + len]);
+                poly[j + len] = montgomery_reduce((int64_t)zeta * poly[j + len]);
             }
         }
     }
 
     for (j = 0; j < DILITHIUM_N; j++) {
-        poly[j] = montgomery_reduce((uint64_t)f * poly[j]);
+        poly[j] = montgomery_reduce((int64_t)f * poly[j]);
+    }
+}
+
+/**
+ * @brief Pointwise product in the NTT domain, c = a * b * 2^-32
+ */
+static void poly_pointwise(int32_t c[DILITHIUM_N], const int32_t a[DILITHIUM_N],
+                           const int32_t b[DILITHIUM_N]) {
+    for (int i = 0; i < DILITHIUM_N; i++) {
+        c[i] = montgomery_reduce((int64_t)a[i] * b[i]);
+    }
+}
+
+/**
+ * @brief w = sum_j A[j] * v[j] in the NTT domain
+ */
+static void poly_pointwise_acc(int32_t w[DILITHIUM_N], const int32_t a[DILITHIUM_L][DILITHIUM_N],
+                               const int32_t v[DILITHIUM_L][DILITHIUM_N]) {
+    int32_t t[DILITHIUM_N];
+    poly_pointwise(w, a[0], v[0]);
+    for (int j = 1; j < DILITHIUM_L; j++) {
+        poly_pointwise(t, a[j], v[j]);
+        for (int i = 0; i < DILITHIUM_N; i++) {
+            w[i] += t[i];
+        }
+    }
+}
+
+static void poly_reduce(int32_t a[DILITHIUM_N]) {
+    for (int i = 0; i < DILITHIUM_N; i++) {
+        a[i] = reduce32(a[i]);
+    }
+}
+
+static void poly_caddq(int32_t a[DILITHIUM_N]) {
+    for (int i = 0; i < DILITHIUM_N; i++) {
+        a[i] = caddq(a[i]);
     }
 }
 
+/**
+ * @brief Check the infinity norm of a reduced polynomial
+ * @return 1 if some |a[i]| >= bound, 0 otherwise
+ */
+static int poly_chknorm(const int32_t a[DILITHIUM_N], int32_t bound) {
+    for (int i = 0; i < DILITHIUM_N; i++) {
+        // Absolute value without a data-dependent branch
+        int32_t t = a[i] >> 31;
+        t = a[i] - (t & 2 * a[i]);
+        if (t >= bound) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
 /**
  * @brief Generate polynomial with coefficients in {-eta, ..., eta}
  * @param poly Output polynomial
  * @param seed Random seed
  * @param nonce Nonce for domain separation
  */
-static void poly_uniform_eta(uint32_t poly[DILITHIUM_N], const uint8_t seed[32], uint16_t nonce) {
-    uint8_t buf[136]; // (256 * 4 + 7) / 8 = 128 + 8 for safety
-    int i, ctr = 0;
-    uint16_t nonce_le = nonce;
+static void poly_uniform_eta(int32_t poly[DILITHIUM_N], const uint8_t seed[DILITHIUM_CRHBYTES],
+                             uint16_t nonce) {
+    // One block is usually enough (15 in 16 nibbles accepted); the second covers the tail
+    uint8_t buf[2 * DILITHIUM_SHAKE256_RATE];
+    uint8_t nonce_le[2] = { (uint8_t)nonce, (uint8_t)(nonce >> 8) };
+    size_t i = 0;
+    int ctr = 0;
 
-    shake256(buf, sizeof(buf), seed, 32, (uint8_t*)&nonce_le, 2);
+    shake256(buf, sizeof(buf), seed, DILITHIUM_CRHBYTES, nonce_le, sizeof(nonce_le));
 
-    i = 0;
     while (ctr < DILITHIUM_N && i < sizeof(buf)) {
         uint32_t t0 = buf[i] & 0x0F;
         uint32_t t1 = buf[i] >> 4;
 
         if (t0 < 15) {
             t0 = t0 - (205 * t0 >> 10) * 5;
-            poly[ctr++] = 2 - t0;
+            poly[ctr++] = 2 - (int32_t)t0;
         }
         if (t1 < 15 && ctr < DILITHIUM_N) {
             t1 = t1 - (205 * t1 >> 10) * 5;
-            poly[ctr++] = 2 - t1;
+            poly[ctr++] = 2 - (int32_t)t1;
         }
         i++;
     }
+
+    // Fewer than 256 of 544 nibbles accepted is beyond negligible; stay defined anyway
+    for (; ctr < DILITHIUM_N; ctr++) {
+        poly[ctr] = 0;
+    }
 }
 
 /**
- * @brief Generate uniform polynomial from seed
+ * @brief Generate uniform polynomial from seed, directly in the NTT domain
  * @param poly Output polynomial
  * @param seed Seed for generation
  * @param nonce Nonce for domain separation
  */
-static void poly_uniform(uint32_t poly[DILITHIUM_N], const uint8_t seed[32], uint16_t nonce) {
-    uint8_t buf[168]; // 3 * 256 / 8 * 7 = 672 bits per coefficient
-    int i, ctr = 0;
-    uint16_t nonce_le = nonce;
+static void poly_uniform(int32_t poly[DILITHIUM_N], const uint8_t seed[32], uint16_t nonce) {
+    // Five blocks give 280 candidates; all but 1 in 1024 are accepted
+    uint8_t buf[10 * DILITHIUM_SHAKE128_RATE];
+    size_t len = 5 * DILITHIUM_SHAKE128_RATE;
+    size_t i = 0;
+    int ctr = 0;
+    uint8_t seed_ext[34];
+
+    memcpy(seed_ext, seed, 32);
+    seed_ext[32] = nonce & 0xFF;
+    seed_ext[33] = nonce >> 8;
+    shake128(buf, len, seed_ext, sizeof(seed_ext));
+
+    for (;;) {
+        while (ctr < DILITHIUM_N && i + 3 <= len) {
+            uint32_t t = buf[i] | ((uint32_t)buf[i + 1] << 8) | ((uint32_t)buf[i + 2] << 16);
+            t &= 0x7FFFFF;
+            if (t < DILITHIUM_Q) {
+                poly[ctr++] = (int32_t)t;
+            }
+            i += 3;
+        }
+        if (ctr == DILITHIUM_N || len == sizeof(buf)) {
+            break;
+        }
+        // Squeeze further; the XOF output up to len is unchanged
+        len = sizeof(buf);
+        shake128(buf, len, seed_ext, sizeof(seed_ext));
+    }
 
-    shake128(buf, sizeof(buf), seed, 32, (uint8_t*)&nonce_le, 2);
+    for (; ctr < DILITHIUM_N; ctr++) {
+        poly[ctr] = 0;
+    }
+}
 
-    i = 0;
-    while (ctr < DILITHIUM_N && i < sizeof(buf) - 2) {
-        uint32_t t = buf[i] | ((uint32_t)buf[i + 1] << 8) | ((uint32_t)buf[i + 2] << 16);
-        t &= 0x7FFFFF;
+/**
+ * @brief Unpack a polynomial with coefficients in {-gamma1+1, ..., gamma1}
+ */
+static void polyz_unpack(int32_t r[DILITHIUM_N], const uint8_t *a) {
+    for (int i = 0; i < DILITHIUM_N / 2; i++) {
+        r[2 * i] = a[5 * i] | ((uint32_t)a[5 * i + 1] << 8) | ((uint32_t)a[5 * i + 2] << 16);
+        r[2 * i] &= 0xFFFFF;
+        r[2 * i + 1] = (a[5 * i + 2] >> 4) | ((uint32_t)a[5 * i + 3] << 4) |
+                       ((uint32_t)a[5 * i + 4] << 12);
+        r[2 * i] = DILITHIUM_GAMMA1 - r[2 * i];
+        r[2 * i + 1] = DILITHIUM_GAMMA1 - r[2 * i + 1];
+    }
+}
 
-        if (t < DILITHIUM_Q) {
-            poly[ctr++] = t;
-        }
-        i += 3;
+/**
+ * @brief Pack a polynomial with coefficients in {-gamma1+1, ..., gamma1}
+ */
+static void polyz_pack(uint8_t *r, const int32_t a[DILITHIUM_N]) {
+    for (int i = 0; i < DILITHIUM_N / 2; i++) {
+        uint32_t t0 = (uint32_t)(DILITHIUM_GAMMA1 - a[2 * i]);
+        uint32_t t1 = (uint32_t)(DILITHIUM_GAMMA1 - a[2 * i + 1]);
+        r[5 * i] = (uint8_t)t0;
+        r[5 * i + 1] = (uint8_t)(t0 >> 8);
+        r[5 * i + 2] = (uint8_t)((t0 >> 16) | (t1 << 4));
+        r[5 * i + 3] = (uint8_t)(t1 >> 4);
+        r[5 * i + 4] = (uint8_t)(t1 >> 12);
     }
 }
 
@@ -192,29 +312,51 @@ static void poly_uniform(uint32_t poly[DILITHIUM_N], const uint8_t seed[32], uin
  * @param seed Random seed
  * @param nonce Nonce for domain separation
  */
-static void poly_uniform_gamma1(uint32_t poly[DILITHIUM_N], const uint8_t seed[64], uint16_t nonce) {
-    uint8_t buf[640]; // 20 * 256 / 8 = 640 bytes
-    uint16_t nonce_le = nonce;
+static void poly_uniform_gamma1(int32_t poly[DILITHIUM_N], const uint8_t seed[DILITHIUM_CRHBYTES],
+                                uint16_t nonce) {
+    uint8_t buf[DILITHIUM_POLYZ_BYTES];
+    uint8_t nonce_le[2] = { (uint8_t)nonce, (uint8_t)(nonce >> 8) };
 
-    shake256(buf, sizeof(buf), seed, 64, (uint8_t*)&nonce_le, 2);
+    shake256(buf, sizeof(buf), seed, DILITHIUM_CRHBYTES, nonce_le, sizeof(nonce_le));
+    polyz_unpack(poly, buf);
+}
 
-    for (int i = 0; i < DILITHIUM_N; i++) {
-        uint32_t t = buf[5 * i] | ((uint32_t)buf[5 * i + 1] << 8) |
-                     ((uint32_t)buf[5 * i + 2] << 16) | ((uint32_t)buf[5 * i + 3] << 24);
-        t |= ((uint32_t)buf[5 * i + 4] << 32);
-        t &= (1ULL << 20) - 1;
+/**
+ * @brief Challenge polynomial with TAU coefficients in {-1, 1}
+ * @param c Output polynomial
+ * @param seed Challenge seed from the signature
+ */
+static void poly_challenge(int32_t c[DILITHIUM_N], const uint8_t seed[DILITHIUM_SYMBYTES]) {
+    uint8_t buf[4 * DILITHIUM_SHAKE256_RATE];
+    uint64_t signs = 0;
+    size_t pos = 8;
+
+    shake256(buf, sizeof(buf), seed, DILITHIUM_SYMBYTES, NULL, 0);
+    for (int i = 0; i < 8; i++) {
+        signs |= (uint64_t)buf[i] << (8 * i);
+    }
 
-        poly[i] = DILITHIUM_GAMMA1 - t;
+    memset(c, 0, DILITHIUM_N * sizeof(int32_t));
+    for (int i = DILITHIUM_N - DILITHIUM_TAU; i < DILITHIUM_N; i++) {
+        size_t b;
+        do {
+            b = pos < sizeof(buf) ? buf[pos] : 0;
+            pos++;
+        } while (b > (size_t)i);
+
+        c[i] = c[b];
+        c[b] = 1 - 2 * (int32_t)(signs & 1);
+        signs >>= 1;
     }
 }
 
 /**
  * @brief Power2Round decomposition
  * @param a1 High bits output
- * @param a0 Low bits output  
- * @param a Input value
+ * @param a0 Low bits output
+ * @param a Input value in [0, q)
  */
-static void power2round(uint32_t *a1, uint32_t *a0, uint32_t a) {
+static void power2round(int32_t *a1, int32_t *a0, int32_t a) {
     *a1 = (a + (1 << (DILITHIUM_D - 1)) - 1) >> DILITHIUM_D;
     *a0 = a - (*a1 << DILITHIUM_D);
 }
@@ -223,22 +365,16 @@ static void power2round(uint32_t *a1, uint32_t *a0, uint32_t a) {
  * @brief Decomposition for hint generation
  * @param a1 High bits output
  * @param a0 Low bits output
- * @param a Input value
+ * @param a Input value in [0, q)
  */
-static void decompose(uint32_t *a1, uint32_t *a0, uint32_t a) {
-    uint32_t a1_prime = (a + 127) >> 7;
-    
-    if (a1_prime == (DILITHIUM_Q - 1) / 128) {
-        *a1 = 0;
-        *a0 = a - 1;
-    } else {
-        *a1 = a1_prime;
-        *a0 = a - a1_prime * 128;
-    }
-
-    if (*a0 > 95) {
-        *a0 -= 256;
-    }
+static void decompose(int32_t *a1, int32_t *a0, int32_t a) {
+    int32_t high = (a + 127) >> 7;
+    high = (high * 1025 + (1 << 21)) >> 22;
+    high &= 15;
+
+    *a0 = a - high * 2 * DILITHIUM_GAMMA2;
+    *a0 -= (((DILITHIUM_Q - 1) / 2 - *a0) >> 31) & DILITHIUM_Q;
+    *a1 = high;
 }
 
 /**
@@ -247,7 +383,7 @@ static void decompose(uint32_t *a1, uint32_t *a0, uint32_t a) {
  * @param a1 High bits
  * @return Hint bit
  */
-static int make_hint(uint32_t a0, uint32_t a1) {
+static int make_hint(int32_t a0, int32_t a1) {
     if (a0 > DILITHIUM_GAMMA2 || a0 < -DILITHIUM_GAMMA2 || (a0 == -DILITHIUM_GAMMA2 && a1 != 0)) {
         return 1;
     }
@@ -256,12 +392,12 @@ static int make_hint(uint32_t a0, uint32_t a1) {
 
 /**
  * @brief Use hint to recover high bits
- * @param a Input value
+ * @param a Input value in [0, q)
  * @param hint Hint bit
  * @return Recovered high bits
  */
-static uint32_t use_hint(uint32_t a, int hint) {
-    uint32_t a1, a0;
+static int32_t use_hint(int32_t a, int hint) {
+    int32_t a1, a0;
     decompose(&a1, &a0, a);
 
     if (hint == 0) {
@@ -275,423 +411,541 @@ static uint32_t use_hint(uint32_t a, int hint) {
     }
 }
 
+/**
+ * @brief Pack the high bits w1 of all K polynomials, 4 bits each
+ */
+static void pack_w1(uint8_t r[DILITHIUM_K * DILITHIUM_POLYW1_BYTES],
+                    const int32_t w1[DILITHIUM_K][DILITHIUM_N]) {
+    for (int i = 0; i < DILITHIUM_K; i++) {
+        for (int j = 0; j < DILITHIUM_N / 2; j++) {
+            r[i * DILITHIUM_POLYW1_BYTES + j] = (uint8_t)(w1[i][2 * j] | (w1[i][2 * j + 1] << 4));
+        }
+    }
+}
+
+/**
+ * @brief Pack high bits t1 and public seed into a public key
+ * @param pk Output public key
+ * @param t1 High bits of t
+ * @param rho Public seed for matrix A
+ */
+static void pack_pk(dilithium_public_key_t *pk, const uint32_t t1[DILITHIUM_K][DILITHIUM_N],
+                    const uint8_t rho[32]) {
+    memcpy(pk->rho, rho, 32);
+    for (int i = 0; i < DILITHIUM_K; i++) {
+        uint8_t *r = pk->t1 + i * DILITHIUM_POLYT1_BYTES;
+        const uint32_t *a = t1[i];
+        for (int j = 0; j < DILITHIUM_N / 4; j++) {
+            r[5 * j] = (uint8_t)a[4 * j];
+            r[5 * j + 1] = (uint8_t)((a[4 * j] >> 8) | (a[4 * j + 1] << 2));
+            r[5 * j + 2] = (uint8_t)((a[4 * j + 1] >> 6) | (a[4 * j + 2] << 4));
+            r[5 * j + 3] = (uint8_t)((a[4 * j + 2] >> 4) | (a[4 * j + 3] << 6));
+            r[5 * j + 4] = (uint8_t)(a[4 * j + 3] >> 2);
+        }
+    }
+}
+
+/**
+ * @brief Unpack high bits t1 from a public key
+ * @param t1 Output high bits of t
+ * @param pk Public key
+ */
+static void unpack_pk(uint32_t t1[DILITHIUM_K][DILITHIUM_N], const dilithium_public_key_t *pk) {
+    for (int i = 0; i < DILITHIUM_K; i++) {
+        const uint8_t *a = pk->t1 + i * DILITHIUM_POLYT1_BYTES;
+        uint32_t *r = t1[i];
+        for (int j = 0; j < DILITHIUM_N / 4; j++) {
+            r[4 * j] = (a[5 * j] | ((uint32_t)a[5 * j + 1] << 8)) & 0x3FF;
+            r[4 * j + 1] = ((a[5 * j + 1] >> 2) | ((uint32_t)a[5 * j + 2] << 6)) & 0x3FF;
+            r[4 * j + 2] = ((a[5 * j + 2] >> 4) | ((uint32_t)a[5 * j + 3] << 4)) & 0x3FF;
+            r[4 * j + 3] = ((a[5 * j + 3] >> 6) | ((uint32_t)a[5 * j + 4] << 2)) & 0x3FF;
+        }
+    }
+}
+
+/**
+ * @brief Expand matrix A from rho, directly in the NTT domain
+ */
+static void expand_matrix(int32_t A[DILITHIUM_K][DILITHIUM_L][DILITHIUM_N], const uint8_t rho[32]) {
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_EXPAND_MATRIX);
+    for (int i = 0; i < DILITHIUM_K; i++) {
+        for (int j = 0; j < DILITHIUM_L; j++) {
+            poly_uniform(A[i][j], rho, (uint16_t)((i << 8) + j));
+        }
+    }
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_EXPAND_MATRIX);
+}
+
 pqc_result_t dilithium_keypair(dilithium_public_key_t *pk, dilithium_secret_key_t *sk) {
+    PQC_BYTES_SCOPE("dilithium_keypair");
     if (!pk || !sk) {
         return PQC_ERROR_INVALID_PARAMETER;
     }
 
-    uint8_t seedbuf[3 * 32];
-    uint8_t rho[32], rhoprime[64], key[32];
-    uint32_t A[DILITHIUM_K][DILITHIUM_L][DILITHIUM_N];
-    uint32_t s1[DILITHIUM_L][DILITHIUM_N], s2[DILITHIUM_K][DILITHIUM_N];
-    uint32_t t1[DILITHIUM_K][DILITHIUM_N], t0[DILITHIUM_K][DILITHIUM_N];
+    uint8_t seedbuf[2 * DILITHIUM_SYMBYTES + DILITHIUM_CRHBYTES];
+    const uint8_t *rho = seedbuf;
+    const uint8_t *rhoprime = seedbuf + DILITHIUM_SYMBYTES;
+    const uint8_t *key = rhoprime + DILITHIUM_CRHBYTES;
+    int32_t A[DILITHIUM_K][DILITHIUM_L][DILITHIUM_N];
+    int32_t s1[DILITHIUM_L][DILITHIUM_N], s1_ntt[DILITHIUM_L][DILITHIUM_N], s2[DILITHIUM_K][DILITHIUM_N];
+    uint32_t t1[DILITHIUM_K][DILITHIUM_N];
+    int32_t t0[DILITHIUM_K][DILITHIUM_N];
+
+    PQC_TRACE_OP_ENTRY("dilithium_keypair", 0);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_KEYGEN);
 
     // Generate random seed
-    if (pqc_randombytes(seedbuf, sizeof(seedbuf)) != PQC_SUCCESS) {
+    if (pqc_randombytes(seedbuf, DILITHIUM_SYMBYTES) != PQC_SUCCESS) {
+        PQC_PERF_PHASE_END(PQC_PERF_PHASE_KEYGEN);
+        PQC_TRACE_OP_RETURN("dilithium_keypair", PQC_ERROR_RANDOM_GENERATION, 0);
         return PQC_ERROR_RANDOM_GENERATION;
     }
 
-    shake256(rho, 32, seedbuf, 32);
-    shake256(rhoprime, 64, seedbuf + 32, 32);
-    memcpy(key, seedbuf + 64, 32);
+    // Expand it into rho, rhoprime and key
+    shake256(seedbuf, sizeof(seedbuf), seedbuf, DILITHIUM_SYMBYTES, NULL, 0);
 
     // Generate matrix A
-    for (int i = 0; i < DILITHIUM_K; i++) {
-        for (int j = 0; j < DILITHIUM_L; j++) {
-            poly_uniform(A[i][j], rho, (i << 8) + j);
-        }
-    }
+    expand_matrix(A, rho);
 
     // Generate secret vectors s1, s2
     for (int i = 0; i < DILITHIUM_L; i++) {
-        poly_uniform_eta(s1[i], rhoprime, i);
+        poly_uniform_eta(s1[i], rhoprime, (uint16_t)i);
     }
     for (int i = 0; i < DILITHIUM_K; i++) {
-        poly_uniform_eta(s2[i], rhoprime, DILITHIUM_L + i);
+        poly_uniform_eta(s2[i], rhoprime, (uint16_t)(DILITHIUM_L + i));
     }
 
     // Compute matrix-vector product t = As1 + s2
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_POLY_ARITH);
+    memcpy(s1_ntt, s1, sizeof(s1_ntt));
+    for (int j = 0; j < DILITHIUM_L; j++) {
+        ntt(s1_ntt[j]);
+    }
     for (int i = 0; i < DILITHIUM_K; i++) {
-        uint32_t temp[DILITHIUM_N];
-        memset(temp, 0, sizeof(temp));
-        
-        for (int j = 0; j < DILITHIUM_L; j++) {
-            uint32_t s1_ntt[DILITHIUM_N];
-            memcpy(s1_ntt, s1[j], sizeof(s1_ntt));
-            ntt(s1_ntt);
-            
-            uint32_t a_ntt[DILITHIUM_N];
-            memcpy(a_ntt, A[i][j], sizeof(a_ntt));
-            ntt(a_ntt);
-            
-            for (int k = 0; k < DILITHIUM_N; k++) {
-                temp[k] += montgomery_reduce((uint64_t)a_ntt[k] * s1_ntt[k]);
-            }
-        }
-        
+        int32_t temp[DILITHIUM_N];
+        poly_pointwise_acc(temp, (const int32_t (*)[DILITHIUM_N])A[i],
+                           (const int32_t (*)[DILITHIUM_N])s1_ntt);
+        poly_reduce(temp);
         invntt(temp);
-        
+
         for (int j = 0; j < DILITHIUM_N; j++) {
-            temp[j] = reduce32(temp[j] + s2[i][j]);
-            power2round(&t1[i][j], &t0[i][j], temp[j]);
+            int32_t high;
+            power2round(&high, &t0[i][j], caddq(temp[j] + s2[i][j]));
+            t1[i][j] = (uint32_t)high;
         }
     }
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_POLY_ARITH);
 
     // Pack public key
-    memcpy(pk->rho, rho, 32);
-    for (int i = 0; i < DILITHIUM_K; i++) {
-        for (int j = 0; j < DILITHIUM_N; j++) {
-            int idx = i * DILITHIUM_N + j;
-            uint32_t t = t1[i][j];
-            
-            pk->t1[idx * 10 / 8] |= (t & 0xFF) << (idx * 10 % 8);
-            if (idx * 10 % 8 > 6) {
-                pk->t1[idx * 10 / 8 + 1] |= (t >> (8 - idx * 10 % 8)) & 0xFF;
-            }
-            if (idx * 10 % 8 > 4) {
-                pk->t1[idx * 10 / 8 + 2] |= (t >> (16 - idx * 10 % 8)) & 0x03;
-            }
-        }
-    }
+    pack_pk(pk, (const uint32_t (*)[DILITHIUM_N])t1, rho);
 
-    // Pack secret key
+    // Pack secret key; tr = H(pk) fills the first SYMBYTES of the field
     memcpy(sk->rho, rho, 32);
     memcpy(sk->key, key, 32);
-    uint8_t tr[64];
-    shake256(tr, 64, (uint8_t*)pk, sizeof(dilithium_public_key_t));
-    memcpy(sk->tr, tr, 64);
+    memset(sk->tr, 0, sizeof(sk->tr));
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_HASH);
+    shake256(sk->tr, DILITHIUM_SYMBYTES, (uint8_t*)pk, sizeof(dilithium_public_key_t), NULL, 0);
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_HASH);
 
     for (int i = 0; i < DILITHIUM_L; i++) {
         for (int j = 0; j < DILITHIUM_N; j++) {
-            int idx = i * DILITHIUM_N + j;
-            sk->s1[idx] = s1[i][j];
+            sk->s1[i * DILITHIUM_N + j] = (uint32_t)s1[i][j];
         }
     }
     for (int i = 0; i < DILITHIUM_K; i++) {
         for (int j = 0; j < DILITHIUM_N; j++) {
-            int idx = i * DILITHIUM_N + j;
-            sk->s2[idx] = s2[i][j];
-        }
-    }
-    for (int i = 0; i < DILITHIUM_K; i++) {
-        for (int j = 0; j < DILITHIUM_N; j++) {
-            int idx = i * DILITHIUM_N + j;
-            sk->t0[idx] = t0[i][j];
+            sk->s2[i * DILITHIUM_N + j] = (uint32_t)s2[i][j];
+            sk->t0[i * DILITHIUM_N + j] = (uint32_t)t0[i][j];
         }
     }
 
     // Clear sensitive data
     secure_memzero(seedbuf, sizeof(seedbuf));
-    secure_memzero(rhoprime, sizeof(rhoprime));
-    secure_memzero(key, sizeof(key));
     secure_memzero(s1, sizeof(s1));
+    secure_memzero(s1_ntt, sizeof(s1_ntt));
     secure_memzero(s2, sizeof(s2));
+    secure_memzero(t0, sizeof(t0));
 
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_KEYGEN);
+    PQC_TRACE_OP_RETURN("dilithium_keypair", PQC_SUCCESS, DILITHIUM_PUBLICKEYBYTES);
     return PQC_SUCCESS;
 }
 
-pqc_result_t dilithium_sign(uint8_t *signature, size_t *siglen, 
+pqc_result_t dilithium_sign(uint8_t *signature, size_t *siglen,
                            const uint8_t *message, size_t msglen,
                            const dilithium_secret_key_t *sk) {
+    PQC_BYTES_SCOPE("dilithium_sign");
     if (!signature || !siglen || !message || !sk) {
         return PQC_ERROR_INVALID_PARAMETER;
     }
 
-    uint8_t mu[64], rhoprime[64];
-    uint32_t A[DILITHIUM_K][DILITHIUM_L][DILITHIUM_N];
-    uint32_t s1[DILITHIUM_L][DILITHIUM_N], s2[DILITHIUM_K][DILITHIUM_N], t0[DILITHIUM_K][DILITHIUM_N];
-    uint32_t y[DILITHIUM_L][DILITHIUM_N], z[DILITHIUM_L][DILITHIUM_N];
-    uint32_t w1[DILITHIUM_K][DILITHIUM_N], w0[DILITHIUM_K][DILITHIUM_N];
-    uint32_t h[DILITHIUM_K][DILITHIUM_N];
-    uint8_t c[32];
-    int nonce = 0;
+    uint8_t mu[DILITHIUM_CRHBYTES], rhoprime[DILITHIUM_CRHBYTES];
+    int32_t A[DILITHIUM_K][DILITHIUM_L][DILITHIUM_N];
+    int32_t s1[DILITHIUM_L][DILITHIUM_N], s2[DILITHIUM_K][DILITHIUM_N], t0[DILITHIUM_K][DILITHIUM_N];
+    int32_t y[DILITHIUM_L][DILITHIUM_N], z[DILITHIUM_L][DILITHIUM_N];
+    int32_t w1[DILITHIUM_K][DILITHIUM_N], w0[DILITHIUM_K][DILITHIUM_N];
+    int32_t h[DILITHIUM_K][DILITHIUM_N];
+    int32_t cp[DILITHIUM_N];
+    uint8_t w1_packed[DILITHIUM_K * DILITHIUM_POLYW1_BYTES];
+    uint16_t nonce = 0;
+
+    PQC_TRACE_OP_ENTRY("dilithium_sign", msglen);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_SIGN_ENCAPS);
 
-    // Unpack secret key
+    // Unpack secret key into the NTT domain
     for (int i = 0; i < DILITHIUM_L; i++) {
         for (int j = 0; j < DILITHIUM_N; j++) {
-            s1[i][j] = sk->s1[i * DILITHIUM_N + j];
+            s1[i][j] = (int32_t)sk->s1[i * DILITHIUM_N + j];
         }
+        ntt(s1[i]);
     }
     for (int i = 0; i < DILITHIUM_K; i++) {
         for (int j = 0; j < DILITHIUM_N; j++) {
-            s2[i][j] = sk->s2[i * DILITHIUM_N + j];
-            t0[i][j] = sk->t0[i * DILITHIUM_N + j];
+            s2[i][j] = (int32_t)sk->s2[i * DILITHIUM_N + j];
+            t0[i][j] = (int32_t)sk->t0[i * DILITHIUM_N + j];
         }
+        ntt(s2[i]);
+        ntt(t0[i]);
     }
 
     // Reconstruct matrix A
-    for (int i = 0; i < DILITHIUM_K; i++) {
-        for (int j = 0; j < DILITHIUM_L; j++) {
-            poly_uniform(A[i][j], sk->rho, (i << 8) + j);
-        }
-    }
+    expand_matrix(A, sk->rho);
 
     // Compute message hash
-    shake256(mu, 64, sk->tr, 64, message, msglen);
-
-    // Generate rhoprime for signing
-    if (pqc_randombytes(rhoprime, 64) != PQC_SUCCESS) {
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_HASH);
+    shake256(mu, sizeof(mu), sk->tr, DILITHIUM_SYMBYTES, message, msglen);
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_HASH);
+
+    // Randomized signing: fresh rhoprime per signature, so a glitched
+    // signer never produces two related signatures for one message
+    if (pqc_randombytes(rhoprime, sizeof(rhoprime)) != PQC_SUCCESS) {
+        PQC_PERF_PHASE_END(PQC_PERF_PHASE_SIGN_ENCAPS);
+        PQC_TRACE_OP_RETURN("dilithium_sign", PQC_ERROR_RANDOM_GENERATION, 0);
         return PQC_ERROR_RANDOM_GENERATION;
     }
 
     // Main signing loop
-    while (1) {
-        // Sample y uniformly at random
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_REJECTION_LOOP);
+    for (;;) {
+        // Sample y and compute w = Ay
         for (int i = 0; i < DILITHIUM_L; i++) {
-            poly_uniform_gamma1(y[i], rhoprime, DILITHIUM_L * nonce + i);
+            poly_uniform_gamma1(y[i], rhoprime, (uint16_t)(DILITHIUM_L * nonce + i));
+        }
+        nonce++;
+        memcpy(z, y, sizeof(z));
+        for (int i = 0; i < DILITHIUM_L; i++) {
+            ntt(z[i]);
         }
-
-        // Compute w = Ay
         for (int i = 0; i < DILITHIUM_K; i++) {
-            uint32_t temp[DILITHIUM_N];
-            memset(temp, 0, sizeof(temp));
-            
-            for (int j = 0; j < DILITHIUM_L; j++) {
-                uint32_t y_ntt[DILITHIUM_N];
-                memcpy(y_ntt, y[j], sizeof(y_ntt));
-                ntt(y_ntt);
-                
-                uint32_t a_ntt[DILITHIUM_N];
-                memcpy(a_ntt, A[i][j], sizeof(a_ntt));
-                ntt(a_ntt);
-                
-                for (int k = 0; k < DILITHIUM_N; k++) {
-                    temp[k] += montgomery_reduce((uint64_t)a_ntt[k] * y_ntt[k]);
-                }
-            }
-            
-            invntt(temp);
-            
+            poly_pointwise_acc(w1[i], (const int32_t (*)[DILITHIUM_N])A[i],
+                               (const int32_t (*)[DILITHIUM_N])z);
+            poly_reduce(w1[i]);
+            invntt(w1[i]);
+            poly_caddq(w1[i]);
             for (int j = 0; j < DILITHIUM_N; j++) {
-                temp[j] = reduce32(temp[j]);
-                decompose(&w1[i][j], &w0[i][j], temp[j]);
+                decompose(&w1[i][j], &w0[i][j], w1[i][j]);
             }
         }
 
-        // Compute challenge c = H(mu || w1)
-        uint8_t w1_packed[DILITHIUM_K * DILITHIUM_N * 6 / 8];
-        // Pack w1 (simplified packing)
-        memset(w1_packed, 0, sizeof(w1_packed));
-        for (int i = 0; i < DILITHIUM_K; i++) {
+        // Compute challenge c = H(mu || w1) into the signature
+        pack_w1(w1_packed, (const int32_t (*)[DILITHIUM_N])w1);
+        shake256(signature, DILITHIUM_SYMBYTES, mu, sizeof(mu), w1_packed, sizeof(w1_packed));
+        poly_challenge(cp, signature);
+        ntt(cp);
+
+        // Compute z = y + cs1, reject if it reveals the secret
+        int reject = 0;
+        for (int i = 0; i < DILITHIUM_L && !reject; i++) {
+            poly_pointwise(z[i], cp, s1[i]);
+            invntt(z[i]);
             for (int j = 0; j < DILITHIUM_N; j++) {
-                int idx = i * DILITHIUM_N + j;
-                w1_packed[idx * 6 / 8] |= (w1[i][j] & 0x3F) << (idx * 6 % 8);
-                if (idx * 6 % 8 > 2) {
-                    w1_packed[idx * 6 / 8 + 1] |= (w1[i][j] >> (8 - idx * 6 % 8)) & 0x3F;
-                }
+                z[i][j] += y[i][j];
             }
+            poly_reduce(z[i]);
+            reject = poly_chknorm(z[i], DILITHIUM_GAMMA1 - DILITHIUM_BETA);
         }
-        
-        shake256(c, 32, mu, 64, w1_packed, sizeof(w1_packed));
 
-        // Compute z = y + cs1
-        int valid = 1;
-        for (int i = 0; i < DILITHIUM_L; i++) {
-            uint32_t cs1[DILITHIUM_N];
-            memset(cs1, 0, sizeof(cs1));
-            
-            // Convert challenge to polynomial
-            uint32_t c_poly[DILITHIUM_N];
-            memset(c_poly, 0, sizeof(c_poly));
-            for (int j = 0; j < DILITHIUM_TAU; j++) {
-                int pos = c[j] | ((uint32_t)c[j + 32] << 8);
-                pos &= 0xFF;
-                if (pos < DILITHIUM_N) {
-                    c_poly[pos] = 1;
-                }
-            }
-            ntt(c_poly);
-            
-            uint32_t s1_ntt[DILITHIUM_N];
-            memcpy(s1_ntt, s1[i], sizeof(s1_ntt));
-            ntt(s1_ntt);
-            
+        // Subtracting cs2 must not change the high bits of w
+        for (int i = 0; i < DILITHIUM_K && !reject; i++) {
+            poly_pointwise(h[i], cp, s2[i]);
+            invntt(h[i]);
             for (int j = 0; j < DILITHIUM_N; j++) {
-                cs1[j] = montgomery_reduce((uint64_t)c_poly[j] * s1_ntt[j]);
+                w0[i][j] -= h[i][j];
             }
-            invntt(cs1);
-            
-            for (int j = 0; j < DILITHIUM_N; j++) {
-                z[i][j] = y[i][j] + cs1[j];
-                if (z[i][j] >= DILITHIUM_GAMMA1 - DILITHIUM_BETA || z[i][j] <= -(DILITHIUM_GAMMA1 - DILITHIUM_BETA)) {
-                    valid = 0;
-                    break;
-                }
-            }
-            if (!valid) break;
-        }
-
-        if (!valid) {
-            nonce++;
-            continue;
+            poly_reduce(w0[i]);
+            reject = poly_chknorm(w0[i], DILITHIUM_GAMMA2 - DILITHIUM_BETA);
         }
 
-        // Compute hint h
+        // Compute hints for w1
         int hint_count = 0;
-        for (int i = 0; i < DILITHIUM_K; i++) {
-            for (int j = 0; j < DILITHIUM_N; j++) {
-                uint32_t r0 = w0[i][j] - s2[i][j]; // Simplified computation
-                h[i][j] = make_hint(r0, w1[i][j]);
+        for (int i = 0; i < DILITHIUM_K && !reject; i++) {
+            poly_pointwise(h[i], cp, t0[i]);
+            invntt(h[i]);
+            poly_reduce(h[i]);
+            reject = poly_chknorm(h[i], DILITHIUM_GAMMA2);
+            for (int j = 0; j < DILITHIUM_N && !reject; j++) {
+                h[i][j] = make_hint(w0[i][j] + h[i][j], w1[i][j]);
                 hint_count += h[i][j];
             }
         }
 
-        if (hint_count > DILITHIUM_OMEGA) {
-            nonce++;
+        if (reject || hint_count > DILITHIUM_OMEGA) {
             continue;
         }
 
-        // Pack signature
-        memcpy(signature, c, 32);
-        int sig_pos = 32;
-        
-        // Pack z
+        // Pack z and the hint positions after the challenge
+        uint8_t *out = signature + DILITHIUM_SYMBYTES;
         for (int i = 0; i < DILITHIUM_L; i++) {
-            for (int j = 0; j < DILITHIUM_N; j++) {
-                uint32_t t = z[i][j];
-                signature[sig_pos++] = t & 0xFF;
-                signature[sig_pos++] = (t >> 8) & 0xFF;
-                signature[sig_pos++] = (t >> 16) & 0xFF;
-            }
+            polyz_pack(out + i * DILITHIUM_POLYZ_BYTES, z[i]);
         }
-        
-        // Pack hint
+        out += DILITHIUM_L * DILITHIUM_POLYZ_BYTES;
+        memset(out, 0, DILITHIUM_OMEGA + DILITHIUM_K);
+        int k = 0;
         for (int i = 0; i < DILITHIUM_K; i++) {
             for (int j = 0; j < DILITHIUM_N; j++) {
                 if (h[i][j]) {
-                    signature[sig_pos++] = j;
+                    out[k++] = (uint8_t)j;
                 }
             }
+            out[DILITHIUM_OMEGA + i] = (uint8_t)k;
         }
 
-        *siglen = sig_pos;
+        *siglen = DILITHIUM_SIGNATUREBYTES;
         break;
     }
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_REJECTION_LOOP);
 
     // Clear sensitive data
     secure_memzero(rhoprime, sizeof(rhoprime));
+    secure_memzero(s1, sizeof(s1));
+    secure_memzero(s2, sizeof(s2));
+    secure_memzero(t0, sizeof(t0));
     secure_memzero(y, sizeof(y));
     secure_memzero(z, sizeof(z));
+    secure_memzero(w0, sizeof(w0));
 
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_SIGN_ENCAPS);
+    PQC_TRACE_OP_RETURN("dilithium_sign", PQC_SUCCESS, *siglen);
     return PQC_SUCCESS;
 }
 
-pqc_result_t dilithium_verify(const uint8_t *signature, size_t siglen,
-                             const uint8_t *message, size_t msglen,
-                             const dilithium_public_key_t *pk) {
-    if (!signature || !message || !pk || siglen < 32) {
-        return PQC_ERROR_INVALID_PARAMETER;
+/**
+ * @brief Unpack the challenge, response and hints of a signature
+ * @return PQC_SUCCESS, or PQC_ERROR_INVALID_SIGNATURE if the encoding is malformed
+ *         or z is out of range
+ */
+static pqc_result_t unpack_sig(uint8_t c[32], int32_t z[DILITHIUM_L][DILITHIUM_N],
+                               int32_t h[DILITHIUM_K][DILITHIUM_N],
+                               const uint8_t *signature, size_t siglen) {
+    if (siglen != DILITHIUM_SIGNATUREBYTES) {
+        return PQC_ERROR_INVALID_SIGNATURE;
     }
 
-    uint8_t mu[64], c[32];
-    uint32_t A[DILITHIUM_K][DILITHIUM_L][DILITHIUM_N];
-    uint32_t t1[DILITHIUM_K][DILITHIUM_N], z[DILITHIUM_L][DILITHIUM_N];
-    uint32_t w1_prime[DILITHIUM_K][DILITHIUM_N];
-    uint32_t h[DILITHIUM_K][DILITHIUM_N];
-
-    // Unpack signature
     memcpy(c, signature, 32);
-    int sig_pos = 32;
-
-    // Unpack z
+    const uint8_t *in = signature + DILITHIUM_SYMBYTES;
     for (int i = 0; i < DILITHIUM_L; i++) {
-        for (int j = 0; j < DILITHIUM_N && sig_pos + 2 < siglen; j++) {
-            z[i][j] = signature[sig_pos] | ((uint32_t)signature[sig_pos + 1] << 8) |
-                     ((uint32_t)signature[sig_pos + 2] << 16);
-            sig_pos += 3;
-            
-            // Check z range
-            if (z[i][j] >= DILITHIUM_GAMMA1 - DILITHIUM_BETA) {
-                return PQC_ERROR_INVALID_SIGNATURE;
-            }
+        polyz_unpack(z[i], in + i * DILITHIUM_POLYZ_BYTES);
+        if (poly_chknorm(z[i], DILITHIUM_GAMMA1 - DILITHIUM_BETA)) {
+            return PQC_ERROR_INVALID_SIGNATURE;
         }
     }
+    in += DILITHIUM_L * DILITHIUM_POLYZ_BYTES;
 
-    // Unpack hint (simplified)
-    memset(h, 0, sizeof(h));
-    while (sig_pos < siglen) {
-        int pos = signature[sig_pos++];
-        if (pos < DILITHIUM_N) {
-            h[0][pos] = 1; // Simplified hint unpacking
+    // Hint positions must be strictly increasing per polynomial, unused slots zero
+    memset(h, 0, DILITHIUM_K * DILITHIUM_N * sizeof(int32_t));
+    int k = 0;
+    for (int i = 0; i < DILITHIUM_K; i++) {
+        int end = in[DILITHIUM_OMEGA + i];
+        if (end < k || end > DILITHIUM_OMEGA) {
+            return PQC_ERROR_INVALID_SIGNATURE;
         }
+        for (int j = k; j < end; j++) {
+            if (j > k && in[j] <= in[j - 1]) {
+                return PQC_ERROR_INVALID_SIGNATURE;
+            }
+            h[i][in[j]] = 1;
+        }
+        k = end;
     }
-
-    // Reconstruct matrix A
-    for (int i = 0; i < DILITHIUM_K; i++) {
-        for (int j = 0; j < DILITHIUM_L; j++) {
-            poly_uniform(A[i][j], pk->rho, (i << 8) + j);
+    for (int j = k; j < DILITHIUM_OMEGA; j++) {
+        if (in[j]) {
+            return PQC_ERROR_INVALID_SIGNATURE;
         }
     }
+    return PQC_SUCCESS;
+}
+
+/**
+ * @brief Expand matrix A (NTT domain), t1 and tr from a packed public key
+ */
+static void expand_pk(dilithium_expanded_public_key_t *epk, const dilithium_public_key_t *pk) {
+    memcpy(epk->rho, pk->rho, 32);
+    expand_matrix((int32_t (*)[DILITHIUM_L][DILITHIUM_N])epk->a, pk->rho);
 
     // Unpack t1
-    for (int i = 0; i < DILITHIUM_K; i++) {
-        for (int j = 0; j < DILITHIUM_N; j++) {
-            int idx = i * DILITHIUM_N + j;
-            t1[i][j] = pk->t1[idx * 10 / 8] >> (idx * 10 % 8);
-            if (idx * 10 % 8 > 6) {
-                t1[i][j] |= (uint32_t)pk->t1[idx * 10 / 8 + 1] << (8 - idx * 10 % 8);
-            }
-            if (idx * 10 % 8 > 4) {
-                t1[i][j] |= (uint32_t)pk->t1[idx * 10 / 8 + 2] << (16 - idx * 10 % 8);
-            }
-            t1[i][j] &= (1 << 10) - 1;
-        }
-    }
+    unpack_pk((uint32_t (*)[DILITHIUM_N])epk->t1, pk);
 
     // Compute tr = H(pk)
-    uint8_t tr[64];
-    shake256(tr, 64, (uint8_t*)pk, sizeof(dilithium_public_key_t));
-    
-    // Compute mu = H(tr || message)
-    shake256(mu, 64, tr, 64, message, msglen);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_HASH);
+    memset(epk->tr, 0, sizeof(epk->tr));
+    shake256(epk->tr, DILITHIUM_SYMBYTES, (uint8_t*)pk, sizeof(dilithium_public_key_t), NULL, 0);
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_HASH);
+}
+
+/**
+ * @brief Recompute the challenge from an unpacked signature and compare it
+ * @return PQC_SUCCESS if the challenge matches, PQC_ERROR_INVALID_SIGNATURE otherwise
+ */
+static pqc_result_t check_challenge(const uint8_t c[32],
+                                    int32_t z[DILITHIUM_L][DILITHIUM_N],
+                                    int32_t h[DILITHIUM_K][DILITHIUM_N],
+                                    const uint8_t *message, size_t msglen,
+                                    const dilithium_expanded_public_key_t *epk) {
+    const int32_t (*A)[DILITHIUM_L][DILITHIUM_N] =
+        (const int32_t (*)[DILITHIUM_L][DILITHIUM_N])epk->a;
+    uint8_t mu[DILITHIUM_CRHBYTES];
+    int32_t cp[DILITHIUM_N];
+    int32_t w1[DILITHIUM_K][DILITHIUM_N];
+    uint8_t w1_packed[DILITHIUM_K * DILITHIUM_POLYW1_BYTES];
+
+    // Compute mu = CRH(tr || message)
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_HASH);
+    shake256(mu, sizeof(mu), epk->tr, DILITHIUM_SYMBYTES, message, msglen);
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_HASH);
 
     // Compute w1' = UseHint(h, Az - ct1*2^d)
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_POLY_ARITH);
+    poly_challenge(cp, c);
+    ntt(cp);
+    for (int j = 0; j < DILITHIUM_L; j++) {
+        ntt(z[j]);
+    }
     for (int i = 0; i < DILITHIUM_K; i++) {
-        uint32_t temp[DILITHIUM_N];
-        memset(temp, 0, sizeof(temp));
-        
-        for (int j = 0; j < DILITHIUM_L; j++) {
-            uint32_t z_ntt[DILITHIUM_N];
-            memcpy(z_ntt, z[j], sizeof(z_ntt));
-            ntt(z_ntt);
-            
-            uint32_t a_ntt[DILITHIUM_N];
-            memcpy(a_ntt, A[i][j], sizeof(a_ntt));
-            ntt(a_ntt);
-            
-            for (int k = 0; k < DILITHIUM_N; k++) {
-                temp[k] += montgomery_reduce((uint64_t)a_ntt[k] * z_ntt[k]);
-            }
-        }
-        
-        invntt(temp);
-        
+        int32_t ct1[DILITHIUM_N];
         for (int j = 0; j < DILITHIUM_N; j++) {
-            temp[j] = reduce32(temp[j] - (t1[i][j] << DILITHIUM_D));
-            w1_prime[i][j] = use_hint(temp[j], h[i][j]);
+            ct1[j] = (int32_t)epk->t1[i * DILITHIUM_N + j] << DILITHIUM_D;
         }
-    }
+        ntt(ct1);
+        poly_pointwise(ct1, cp, ct1);
 
-    // Pack w1' and compute challenge
-    uint8_t w1_packed[DILITHIUM_K * DILITHIUM_N * 6 / 8];
-    memset(w1_packed, 0, sizeof(w1_packed));
-    for (int i = 0; i < DILITHIUM_K; i++) {
+        poly_pointwise_acc(w1[i], A[i], (const int32_t (*)[DILITHIUM_N])z);
         for (int j = 0; j < DILITHIUM_N; j++) {
-            int idx = i * DILITHIUM_N + j;
-            w1_packed[idx * 6 / 8] |= (w1_prime[i][j] & 0x3F) << (idx * 6 % 8);
-            if (idx * 6 % 8 > 2) {
-                w1_packed[idx * 6 / 8 + 1] |= (w1_prime[i][j] >> (8 - idx * 6 % 8)) & 0x3F;
-            }
+            w1[i][j] -= ct1[j];
+        }
+        poly_reduce(w1[i]);
+        invntt(w1[i]);
+        poly_caddq(w1[i]);
+        for (int j = 0; j < DILITHIUM_N; j++) {
+            w1[i][j] = use_hint(w1[i][j], h[i][j]);
         }
     }
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_POLY_ARITH);
 
+    // Pack w1' and compute challenge
     uint8_t c_computed[32];
-    shake256(c_computed, 32, mu, 64, w1_packed, sizeof(w1_packed));
+    pack_w1(w1_packed, (const int32_t (*)[DILITHIUM_N])w1);
+    shake256(c_computed, 32, mu, sizeof(mu), w1_packed, sizeof(w1_packed));
 
     // Verify challenge matches
     if (secure_memcmp(c, c_computed, 32) != 0) {
         return PQC_ERROR_INVALID_SIGNATURE;
     }
+    return PQC_SUCCESS;
+}
+
+pqc_result_t dilithium_verify(const uint8_t *signature, size_t siglen,
+                             const uint8_t *message, size_t msglen,
+                             const dilithium_public_key_t *pk) {
+    PQC_BYTES_SCOPE("dilithium_verify");
+    if (!signature || !message || !pk || siglen < 32) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    uint8_t c[32];
+    int32_t z[DILITHIUM_L][DILITHIUM_N];
+    int32_t h[DILITHIUM_K][DILITHIUM_N];
+    dilithium_expanded_public_key_t epk;
+
+    PQC_TRACE_OP_ENTRY("dilithium_verify", msglen);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_VERIFY_DECAPS);
+
+    // Reject malformed signatures before paying for the matrix expansion
+    pqc_result_t result = unpack_sig(c, z, h, signature, siglen);
+    if (result == PQC_SUCCESS) {
+        expand_pk(&epk, pk);
+        result = check_challenge(c, z, h, message, msglen, &epk);
+    }
+
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_VERIFY_DECAPS);
+    PQC_TRACE_OP_RETURN("dilithium_verify", result, 0);
+    return result;
+}
+
+pqc_result_t dilithium_expand_public_key(dilithium_expanded_public_key_t *epk,
+                                         const dilithium_public_key_t *pk) {
+    PQC_BYTES_SCOPE("dilithium_expand_public_key");
+    if (!epk || !pk) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    PQC_TRACE_OP_ENTRY("dilithium_expand_public_key", 0);
+    expand_pk(epk, pk);
+    PQC_TRACE_OP_RETURN("dilithium_expand_public_key", PQC_SUCCESS, 0);
+    return PQC_SUCCESS;
+}
+
+pqc_result_t dilithium_verify_expanded(const uint8_t *signature, size_t siglen,
+                                       const uint8_t *message, size_t msglen,
+                                       const dilithium_expanded_public_key_t *epk) {
+    PQC_BYTES_SCOPE("dilithium_verify_expanded");
+    if (!signature || !message || !epk || siglen < 32) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    uint8_t c[32];
+    int32_t z[DILITHIUM_L][DILITHIUM_N];
+    int32_t h[DILITHIUM_K][DILITHIUM_N];
+
+    PQC_TRACE_OP_ENTRY("dilithium_verify_expanded", msglen);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_VERIFY_DECAPS);
+
+    pqc_result_t result = unpack_sig(c, z, h, signature, siglen);
+    if (result == PQC_SUCCESS) {
+        result = check_challenge(c, z, h, message, msglen, epk);
+    }
+
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_VERIFY_DECAPS);
+    PQC_TRACE_OP_RETURN("dilithium_verify_expanded", result, 0);
+    return result;
+}
+
+pqc_result_t dilithium_validate_public_key(const dilithium_public_key_t *pk) {
+    if (!pk) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
 
+    // t1 is packed at 10 bits per coefficient and every pattern is in
+    // range, so there is nothing further to reject in a full-size key
     return PQC_SUCCESS;
-}
\ No newline at end of file
+}
+
+pqc_result_t dilithium_validate_signature(const uint8_t *signature, size_t siglen) {
+    if (!signature) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    uint8_t c[32];
+    int32_t z[DILITHIUM_L][DILITHIUM_N];
+    int32_t h[DILITHIUM_K][DILITHIUM_N];
+    return unpack_sig(c, z, h, signature, siglen);
+}
+
+#ifdef PQC_ENABLE_TESTING
+void dilithium_pack_public_key(dilithium_public_key_t *pk, const uint32_t t1[8 * 256], const uint8_t rho[32]) {
+    pack_pk(pk, (const uint32_t (*)[DILITHIUM_N])t1, rho);
+}
+
+void dilithium_unpack_public_key(uint32_t t1[8 * 256], const dilithium_public_key_t *pk) {
+    unpack_pk((uint32_t (*)[DILITHIUM_N])t1, pk);
+}
+#endif
@@ -55,6 +55,20 @@ typedef struct {
     uint8_t hint[80];                   /**< Hint vector h */
 } dilithium_signature_t;
 
+/**
+ * @brief Dilithium public key expanded for repeated verification
+ *
+ * Holds the matrix A in the NTT domain, the unpacked t1 and tr = H(pk), so
+ * verifying against the same key skips the SHAKE-128 matrix expansion, the
+ * matrix NTTs and the public key hash. About 64 KB; allocate it on the heap.
+ */
+typedef struct {
+    uint8_t rho[32];                    /**< Public seed for matrix A */
+    uint8_t tr[64];                     /**< Hash of public key */
+    uint32_t a[8 * 7 * 256];            /**< Matrix A, NTT domain */
+    uint32_t t1[8 * 256];               /**< Unpacked high bits of t */
+} dilithium_expanded_public_key_t;
+
 /**
  * @brief Dilithium keypair structure for convenience
  */
@@ -121,6 +135,32 @@ pqc_result_t dilithium_verify(const uint8_t *signature, size_t siglen,
                              const uint8_t *message, size_t msglen,
                              const dilithium_public_key_t *pk);
 
+/**
+ * @brief Expand a Dilithium-5 public key for repeated verification
+ *
+ * @param[out] epk Expanded public key
+ * @param[in] pk Public key
+ * @return PQC_SUCCESS on success, error code on failure
+ */
+pqc_result_t dilithium_expand_public_key(dilithium_expanded_public_key_t *epk,
+                                         const dilithium_public_key_t *pk);
+
+/**
+ * @brief Verify a Dilithium-5 signature against an expanded public key
+ *
+ * Same result as dilithium_verify() on the key epk was expanded from.
+ *
+ * @param[in] signature Signature to verify
+ * @param[in] siglen Length of signature
+ * @param[in] message Original message
+ * @param[in] msglen Length of message
+ * @param[in] epk Expanded public key
+ * @return PQC_SUCCESS if signature is valid, error code if invalid
+ */
+pqc_result_t dilithium_verify_expanded(const uint8_t *signature, size_t siglen,
+                                       const uint8_t *message, size_t msglen,
+                                       const dilithium_expanded_public_key_t *epk);
+
 /**
  * @brief Validate Dilithium public key format
  * 
@@ -161,6 +201,8 @@ void dilithium_power2round(uint32_t *a1, uint32_t *a0, uint32_t a);
 void dilithium_decompose(uint32_t *a1, uint32_t *a0, uint32_t a);
 int dilithium_make_hint(uint32_t a0, uint32_t a1);
 uint32_t dilithium_use_hint(uint32_t a, int hint);
+void dilithium_pack_public_key(dilithium_public_key_t *pk, const uint32_t t1[8 * 256], const uint8_t rho[32]);
+void dilithium_unpack_public_key(uint32_t t1[8 * 256], const dilithium_public_key_t *pk);
 #endif
 
 #ifdef __cplusplus
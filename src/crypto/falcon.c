@@ -0,0 +1,806 @@
+/**
+ * @file falcon.c
+ * @brief Falcon-512/1024 post-quantum digital signature implementation
+ *
+ * Signing uses fast Fourier sampling over the secret basis, with the
+ * basis and its Gram matrix expanded from the compact secret key (f, g, F)
+ * on every call. All floating-point work goes through the emulated fpr
+ * type (falcon_fpr.c). Verification is integer-only: it recomputes
+ * s1 = H(nonce || msg) - s2 * h mod q with the NTT and checks the norm of
+ * (s1, s2).
+ */
+
+#include "falcon.h"
+#include "falcon_internal.h"
+#include "pqc_common.h"
+#include "pqc_bytes.h"
+#include "pqc_perf.h"
+#include "pqc_trace.h"
+#include "secure_memory.h"
+#include <string.h>
+
+// ============================================================================
+// Parameters
+// ============================================================================
+
+#define FALCON_HEADER_PK        0x00
+#define FALCON_HEADER_SK        0x50
+#define FALCON_HEADER_SIG       0x30
+
+#define FALCON_HASH_BYTES(n)    (4 * (n))   /**< SHAKE output for HashToPoint */
+
+/**
+ * @brief Per-parameter-set constants, indexed by logn - 9
+ */
+typedef struct {
+    size_t pk_bytes;
+    size_t sk_bytes;
+    size_t sig_bytes;
+    unsigned fg_bits;                   /**< Bits per f, g coefficient in sk */
+    uint32_t l2bound;                   /**< Squared norm bound on (s1, s2) */
+    fpr inv_sigma;
+    fpr sigma_min;
+} falcon_params_t;
+
+static const falcon_params_t falcon_params[2] = {
+    {
+        FALCON_512_PUBLICKEYBYTES, FALCON_512_SECRETKEYBYTES, FALCON_512_SIGNATUREBYTES,
+        6, 34034726,
+        FPR_C(0x3F78B6C2DE64C7C9, 0.006033669668157723),
+        FPR_C(0x3FF47201BF1F7A75, 1.2778336969128337)
+    },
+    {
+        FALCON_1024_PUBLICKEYBYTES, FALCON_1024_SECRETKEYBYTES, FALCON_1024_SIGNATUREBYTES,
+        5, 70265242,
+        FPR_C(0x3F78531EF6311AE1, 0.005938645309533115),
+        FPR_C(0x3FF4C5C19990C764, 1.298280334344292)
+    }
+};
+
+static const fpr fpr_inv_2sqrsigma0 = FPR_C(0x3FC34F8BC183BBC2, 0.15086504887537272);
+static const fpr fpr_log2 = FPR_C(0x3FE62E42FEFA39EF, 0.6931471805599453);
+static const fpr fpr_inv_log2 = FPR_C(0x3FF71547652B82FE, 1.4426950408889634);
+
+static inline const falcon_params_t *params_for(unsigned logn) {
+    return &falcon_params[logn - 9];
+}
+
+// ============================================================================
+// PRNG
+// ============================================================================
+
+static void prng_refill(falcon_prng_t *prng) {
+    uint8_t ctr[8];
+    for (int i = 0; i < 8; i++) {
+        ctr[i] = (uint8_t)(prng->counter >> (8 * i));
+    }
+    prng->counter++;
+    shake256(prng->buf, sizeof(prng->buf), prng->seed, sizeof(prng->seed), ctr, sizeof(ctr));
+    prng->pos = 0;
+}
+
+void falcon_prng_init(falcon_prng_t *prng, const uint8_t *seed, size_t seedlen) {
+    memset(prng, 0, sizeof(*prng));
+    memcpy(prng->seed, seed, seedlen < sizeof(prng->seed) ? seedlen : sizeof(prng->seed));
+    prng_refill(prng);
+}
+
+uint8_t falcon_prng_u8(falcon_prng_t *prng) {
+    if (prng->pos >= sizeof(prng->buf)) {
+        prng_refill(prng);
+    }
+    return prng->buf[prng->pos++];
+}
+
+uint64_t falcon_prng_u64(falcon_prng_t *prng) {
+    if (prng->pos + 8 > sizeof(prng->buf)) {
+        prng_refill(prng);
+    }
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) {
+        v |= (uint64_t)prng->buf[prng->pos + i] << (8 * i);
+    }
+    prng->pos += 8;
+    return v;
+}
+
+// ============================================================================
+// Gaussian Sampling
+// ============================================================================
+
+/**
+ * @brief 2^72 * Pr[z > i] for the half-Gaussian of sigma0 = 1.8205,
+ * as (high, middle, low) 24-bit limbs
+ */
+static const uint32_t gauss0_rcdt[][3] = {
+    { 10745844u,  3068844u,  3741706u }, {  5559083u,  1580863u,  8248201u },
+    {  2260429u, 13669192u,  2736646u }, {   708981u,  4421575u, 10046186u },
+    {   169348u,  7122675u,  4136821u }, {    30538u, 13063405u,  7650660u },
+    {     4132u, 14505003u,  7826153u }, {      417u, 16768101u, 11363294u },
+    {       31u,  8444042u,  8086572u }, {        1u, 12844466u,   265324u },
+    {        0u,  1232676u, 13644286u }, {        0u,    38047u,  9111841u },
+    {        0u,      870u,  6138265u }, {        0u,       14u, 12545724u },
+    {        0u,        0u,  3104126u }, {        0u,        0u,    28824u },
+    {        0u,        0u,      198u }, {        0u,        0u,        1u }
+};
+
+/**
+ * @brief Sample z >= 0 from the base half-Gaussian (table scan, constant-time)
+ */
+static int gaussian0(falcon_prng_t *prng) {
+    uint64_t lo = falcon_prng_u64(prng);
+    uint32_t hi = falcon_prng_u8(prng);
+    uint32_t v0 = (uint32_t)lo & 0xFFFFFF;
+    uint32_t v1 = (uint32_t)(lo >> 24) & 0xFFFFFF;
+    uint32_t v2 = (uint32_t)(lo >> 48) | (hi << 16);
+    int z = 0;
+
+    for (size_t i = 0; i < sizeof(gauss0_rcdt) / sizeof(gauss0_rcdt[0]); i++) {
+        uint32_t cc = (v0 - gauss0_rcdt[i][2]) >> 31;
+        cc = (v1 - gauss0_rcdt[i][1] - cc) >> 31;
+        cc = (v2 - gauss0_rcdt[i][0] - cc) >> 31;
+        z += (int)cc;
+    }
+    return z;
+}
+
+/**
+ * @brief Return 1 with probability ccs * exp(-x), for x >= 0
+ */
+static int ber_exp(falcon_prng_t *prng, fpr x, fpr ccs) {
+    // x = s*ln(2) + r with r in [0, ln 2); s is clamped to 63
+    int s = (int)fpr_trunc(fpr_mul(x, fpr_inv_log2));
+    fpr r = fpr_sub(x, fpr_mul(fpr_of(s), fpr_log2));
+    uint32_t sw = (uint32_t)s;
+    sw ^= (sw ^ 63) & -((63 - sw) >> 31);
+    s = (int)sw;
+
+    uint64_t z = ((fpr_expm_p63(r, ccs) << 1) - 1) >> s;
+
+    // Lazy byte-wise comparison of a uniform 64-bit value with z
+    uint32_t w;
+    int i = 64;
+    do {
+        i -= 8;
+        w = falcon_prng_u8(prng) - ((uint32_t)(z >> i) & 0xFF);
+    } while (!w && i > 0);
+    return (int)(w >> 31);
+}
+
+/**
+ * @brief Sample an integer from the discrete Gaussian of center mu and
+ * standard deviation 1/isigma
+ */
+static int sampler_z(falcon_prng_t *prng, fpr sigma_min, fpr mu, fpr isigma) {
+    int s = (int)fpr_floor(mu);
+    fpr r = fpr_sub(mu, fpr_of(s));
+    fpr dss = fpr_half(fpr_sqr(isigma));
+    fpr ccs = fpr_mul(isigma, sigma_min);
+
+    for (;;) {
+        // Bimodal candidate z from the base sampler, then rejection
+        int z0 = gaussian0(prng);
+        int b = (int)falcon_prng_u8(prng) & 1;
+        int z = b + ((b << 1) - 1) * z0;
+
+        fpr x = fpr_mul(fpr_sqr(fpr_sub(fpr_of(z), r)), dss);
+        x = fpr_sub(x, fpr_mul(fpr_of(z0 * z0), fpr_inv_2sqrsigma0));
+        if (ber_exp(prng, x, ccs)) {
+            return s + z;
+        }
+    }
+}
+
+/**
+ * @brief Fast Fourier sampling over the LDL tree, built on the fly
+ *
+ * Samples (z0, z1) close to the target (t0, t1) for the Gram matrix
+ * [[g00, g01], [adj(g01), g11]]; the results replace t0 and t1. The Gram
+ * matrix is destroyed. tmp must hold 4n fpr values.
+ */
+static void ff_sampling(falcon_prng_t *prng, const falcon_params_t *p,
+                        fpr *t0, fpr *t1, fpr *g00, fpr *g01, fpr *g11,
+                        unsigned logn, fpr *tmp) {
+    if (logn == 0) {
+        // Leaf: D is a positive real; sample with sigma / sqrt(D)
+        fpr leaf = fpr_mul(fpr_sqrt(g00[0]), p->inv_sigma);
+        t0[0] = fpr_of(sampler_z(prng, p->sigma_min, t0[0], leaf));
+        t1[0] = fpr_of(sampler_z(prng, p->sigma_min, t1[0], leaf));
+        return;
+    }
+
+    size_t n = (size_t)1 << logn;
+    size_t hn = n >> 1;
+
+    // LDL in place: g01 <- L10, g11 <- D11 (D00 = g00). Split D00 and D11
+    // into the half-size Gram matrices of the two subtrees; L10 goes to tmp
+    falcon_poly_LDL_fft(g00, g01, g11, logn);
+    falcon_split_fft(tmp, tmp + hn, g00, logn);
+    memcpy(g00, tmp, n * sizeof(fpr));
+    falcon_split_fft(tmp, tmp + hn, g11, logn);
+    memcpy(g11, tmp, n * sizeof(fpr));
+    memcpy(tmp, g01, n * sizeof(fpr));
+    memcpy(g01, g00, hn * sizeof(fpr));
+    memcpy(g01 + hn, g11, hn * sizeof(fpr));
+
+    // Right subtree on t1
+    fpr *z1 = tmp + n;
+    falcon_split_fft(z1, z1 + hn, t1, logn);
+    ff_sampling(prng, p, z1, z1 + hn, g11, g11 + hn, g01 + hn, logn - 1, z1 + n);
+    falcon_merge_fft(tmp + (n << 1), z1, z1 + hn, logn);
+
+    // t0 += (t1 - z1) * L10, t1 <- z1
+    memcpy(z1, t1, n * sizeof(fpr));
+    falcon_poly_sub(z1, tmp + (n << 1), logn);
+    memcpy(t1, tmp + (n << 1), n * sizeof(fpr));
+    falcon_poly_mul_fft(tmp, z1, logn);
+    falcon_poly_add(t0, tmp, logn);
+
+    // Left subtree on the updated t0
+    fpr *z0 = tmp;
+    falcon_split_fft(z0, z0 + hn, t0, logn);
+    ff_sampling(prng, p, z0, z0 + hn, g00, g00 + hn, g01, logn - 1, z0 + n);
+    falcon_merge_fft(t0, z0, z0 + hn, logn);
+}
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+static size_t modq_encode(uint8_t *out, const uint16_t *x, size_t n) {
+    uint32_t acc = 0;
+    unsigned acc_len = 0;
+    size_t v = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        acc = (acc << 14) | x[i];
+        acc_len += 14;
+        while (acc_len >= 8) {
+            acc_len -= 8;
+            out[v++] = (uint8_t)(acc >> acc_len);
+        }
+    }
+    return v;
+}
+
+static int modq_decode(uint16_t *x, size_t n, const uint8_t *in) {
+    uint32_t acc = 0;
+    unsigned acc_len = 0;
+    size_t i = 0, v = 0;
+
+    while (i < n) {
+        acc = (acc << 8) | in[v++];
+        acc_len += 8;
+        if (acc_len >= 14) {
+            acc_len -= 14;
+            uint32_t w = (acc >> acc_len) & 0x3FFF;
+            if (w >= FALCON_Q) {
+                return -1;
+            }
+            x[i++] = (uint16_t)w;
+        }
+    }
+    return 0;
+}
+
+static size_t trim_i8_encode(uint8_t *out, const int8_t *x, size_t n, unsigned bits) {
+    uint32_t mask = (1U << bits) - 1;
+    uint32_t acc = 0;
+    unsigned acc_len = 0;
+    size_t v = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        acc = (acc << bits) | ((uint8_t)x[i] & mask);
+        acc_len += bits;
+        while (acc_len >= 8) {
+            acc_len -= 8;
+            out[v++] = (uint8_t)(acc >> acc_len);
+        }
+    }
+    return v;
+}
+
+static int trim_i8_decode(int8_t *x, size_t n, unsigned bits, const uint8_t *in) {
+    uint32_t mask1 = (1U << bits) - 1;
+    uint32_t mask2 = 1U << (bits - 1);
+    uint32_t acc = 0;
+    unsigned acc_len = 0;
+    size_t i = 0, v = 0;
+
+    while (i < n) {
+        acc = (acc << 8) | in[v++];
+        acc_len += 8;
+        while (acc_len >= bits && i < n) {
+            acc_len -= bits;
+            uint32_t w = (acc >> acc_len) & mask1;
+            w |= -(w & mask2);
+            if (w == -mask2) {
+                // -2^(bits-1) is never produced by key generation
+                return -1;
+            }
+            x[i++] = (int8_t)(int32_t)w;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Compressed encoding of s2: sign, low 7 bits, high bits in unary
+ *
+ * @return Bytes written, or 0 if a value is out of range or out is too short
+ */
+static size_t comp_encode(uint8_t *out, size_t maxlen, const int16_t *x, size_t n) {
+    uint32_t acc = 0;
+    unsigned acc_len = 0;
+    size_t v = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        if (x[i] < -2047 || x[i] > 2047) {
+            return 0;
+        }
+        int t = x[i];
+        acc <<= 1;
+        if (t < 0) {
+            t = -t;
+            acc |= 1;
+        }
+        unsigned w = (unsigned)t;
+        acc <<= 7;
+        acc |= w & 127U;
+        w >>= 7;
+        acc_len += 8;
+        acc <<= (w + 1);
+        acc |= 1;
+        acc_len += w + 1;
+        while (acc_len >= 8) {
+            acc_len -= 8;
+            if (v >= maxlen) {
+                return 0;
+            }
+            out[v++] = (uint8_t)(acc >> acc_len);
+        }
+    }
+    if (acc_len > 0) {
+        if (v >= maxlen) {
+            return 0;
+        }
+        out[v++] = (uint8_t)(acc << (8 - acc_len));
+    }
+    return v;
+}
+
+static size_t comp_decode(int16_t *x, size_t n, const uint8_t *in, size_t maxlen) {
+    uint32_t acc = 0;
+    unsigned acc_len = 0;
+    size_t v = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        if (v >= maxlen) {
+            return 0;
+        }
+        acc = (acc << 8) | in[v++];
+        unsigned b = acc >> acc_len;
+        unsigned s = b & 128;
+        unsigned m = b & 127;
+
+        for (;;) {
+            if (acc_len == 0) {
+                if (v >= maxlen) {
+                    return 0;
+                }
+                acc = (acc << 8) | in[v++];
+                acc_len = 8;
+            }
+            acc_len--;
+            if (((acc >> acc_len) & 1) != 0) {
+                break;
+            }
+            m += 128;
+            if (m > 2047) {
+                return 0;
+            }
+        }
+
+        // "-0" has no valid encoding
+        if (s && m == 0) {
+            return 0;
+        }
+        x[i] = (int16_t)(s ? -(int)m : (int)m);
+    }
+
+    // Unused bits of the last byte must be zero
+    if ((acc & ((1U << acc_len) - 1U)) != 0) {
+        return 0;
+    }
+    return v;
+}
+
+// ============================================================================
+// Hashing
+// ============================================================================
+
+/**
+ * @brief Hash nonce || message to a polynomial with coefficients mod q
+ *
+ * 16-bit big-endian SHAKE-256 outputs below 5q are kept and reduced.
+ */
+static pqc_result_t hash_to_point(uint16_t *x, unsigned logn, const uint8_t *nonce,
+                                  const uint8_t *message, size_t msglen) {
+    size_t n = (size_t)1 << logn;
+    uint8_t buf[FALCON_HASH_BYTES(FALCON_MAX_N)];
+    size_t len = FALCON_HASH_BYTES(n);
+
+    pqc_result_t ret = shake256(buf, len, nonce, FALCON_NONCEBYTES, message, msglen);
+    if (ret != PQC_SUCCESS) {
+        return ret;
+    }
+
+    // 2n candidates for n values: running short has negligible probability
+    size_t i = 0;
+    for (size_t v = 0; v + 1 < len && i < n; v += 2) {
+        uint32_t w = ((uint32_t)buf[v] << 8) | buf[v + 1];
+        if (w < 5 * FALCON_Q) {
+            x[i++] = (uint16_t)(w % FALCON_Q);
+        }
+    }
+    return i == n ? PQC_SUCCESS : PQC_ERROR_INTERNAL;
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/**
+ * @brief logn from a key or signature header byte, 0 if unsupported
+ */
+static unsigned header_logn(uint8_t header, uint8_t type) {
+    if ((header & 0xF0) != type) {
+        return 0;
+    }
+    unsigned logn = header & 0x0F;
+    return (logn == 9 || logn == 10) ? logn : 0;
+}
+
+static uint16_t mq_of(int32_t x) {
+    x %= FALCON_Q;
+    return (uint16_t)(x < 0 ? x + FALCON_Q : x);
+}
+
+static inline int32_t mq_center(uint32_t x) {
+    return x > FALCON_Q / 2 ? (int32_t)x - FALCON_Q : (int32_t)x;
+}
+
+static int is_short(const int16_t *s1, const int16_t *s2, size_t n, uint32_t bound) {
+    // Saturating sum of squares
+    uint32_t s = 0, ng = 0;
+    for (size_t i = 0; i < n; i++) {
+        s += (uint32_t)((int32_t)s1[i] * s1[i]);
+        ng |= s;
+        s += (uint32_t)((int32_t)s2[i] * s2[i]);
+        ng |= s;
+    }
+    s |= -(ng >> 31);
+    return s <= bound;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+pqc_result_t falcon_keypair(pqc_algorithm_t algorithm, uint8_t *pk, uint8_t *sk) {
+    PQC_BYTES_SCOPE("falcon_keypair");
+    if (!pk || !sk) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    if (algorithm != PQC_ALG_FALCON_512 && algorithm != PQC_ALG_FALCON_1024) {
+        return PQC_ERROR_ALGORITHM_NOT_SUPPORTED;
+    }
+
+    unsigned logn = algorithm == PQC_ALG_FALCON_512 ? 9 : 10;
+    size_t n = (size_t)1 << logn;
+    const falcon_params_t *p = params_for(logn);
+    uint8_t seed[FALCON_PRNG_SEEDBYTES];
+    int8_t f[FALCON_MAX_N], g[FALCON_MAX_N], F[FALCON_MAX_N], G[FALCON_MAX_N];
+    uint16_t h[FALCON_MAX_N];
+    falcon_prng_t prng;
+
+    PQC_TRACE_OP_ENTRY("falcon_keypair", 0);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_KEYGEN);
+
+    if (pqc_randombytes(seed, sizeof(seed)) != PQC_SUCCESS) {
+        PQC_PERF_PHASE_END(PQC_PERF_PHASE_KEYGEN);
+        PQC_TRACE_OP_RETURN("falcon_keypair", PQC_ERROR_RANDOM_GENERATION, 0);
+        return PQC_ERROR_RANDOM_GENERATION;
+    }
+    falcon_prng_init(&prng, seed, sizeof(seed));
+
+    pqc_result_t result = falcon_keygen(f, g, F, G, h, logn, &prng);
+    if (result == PQC_SUCCESS) {
+        pk[0] = (uint8_t)(FALCON_HEADER_PK + logn);
+        modq_encode(pk + 1, h, n);
+
+        size_t v = 1;
+        sk[0] = (uint8_t)(FALCON_HEADER_SK + logn);
+        v += trim_i8_encode(sk + v, f, n, p->fg_bits);
+        v += trim_i8_encode(sk + v, g, n, p->fg_bits);
+        trim_i8_encode(sk + v, F, n, 8);
+    }
+
+    // Clear sensitive data
+    secure_memzero(seed, sizeof(seed));
+    secure_memzero(&prng, sizeof(prng));
+    secure_memzero(f, sizeof(f));
+    secure_memzero(g, sizeof(g));
+    secure_memzero(F, sizeof(F));
+    secure_memzero(G, sizeof(G));
+
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_KEYGEN);
+    PQC_TRACE_OP_RETURN("falcon_keypair", result, result == PQC_SUCCESS ? p->pk_bytes : 0);
+    return result;
+}
+
+pqc_result_t falcon_sign(uint8_t *signature, size_t *siglen,
+                         const uint8_t *message, size_t msglen,
+                         const uint8_t *sk, size_t sklen) {
+    PQC_BYTES_SCOPE("falcon_sign");
+    if (!signature || !siglen || (!message && msglen) || !sk || sklen == 0) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    unsigned logn = header_logn(sk[0], FALCON_HEADER_SK);
+    if (!logn || sklen != params_for(logn)->sk_bytes) {
+        return PQC_ERROR_INVALID_KEY;
+    }
+
+    size_t n = (size_t)1 << logn;
+    const falcon_params_t *p = params_for(logn);
+    int8_t f[FALCON_MAX_N], g[FALCON_MAX_N], F[FALCON_MAX_N], G[FALCON_MAX_N];
+    uint16_t hm[FALCON_MAX_N], t[FALCON_MAX_N], u[FALCON_MAX_N];
+    int16_t s1[FALCON_MAX_N], s2[FALCON_MAX_N];
+    uint8_t seed[FALCON_PRNG_SEEDBYTES];
+    falcon_prng_t prng;
+    pqc_result_t result = PQC_SUCCESS;
+
+    PQC_TRACE_OP_ENTRY("falcon_sign", msglen);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_SIGN_ENCAPS);
+
+    fpr *ws = secure_malloc(15 * n * sizeof(fpr));
+    if (!ws) {
+        PQC_PERF_PHASE_END(PQC_PERF_PHASE_SIGN_ENCAPS);
+        PQC_TRACE_OP_RETURN("falcon_sign", PQC_ERROR_INSUFFICIENT_MEMORY, 0);
+        return PQC_ERROR_INSUFFICIENT_MEMORY;
+    }
+    fpr *b00 = ws, *b01 = b00 + n, *b10 = b01 + n, *b11 = b10 + n;
+    fpr *g00 = b11 + n, *g01 = g00 + n, *g11 = g01 + n;
+    fpr *t0 = g11 + n, *t1 = t0 + n, *tx = t1 + n, *ty = tx + n, *tmp = ty + n;
+
+    // Unpack secret key and recompute G = g*F/f mod q
+    size_t v = 1;
+    size_t fg_len = (n * p->fg_bits) >> 3;
+    if (trim_i8_decode(f, n, p->fg_bits, sk + v)
+        || trim_i8_decode(g, n, p->fg_bits, sk + v + fg_len)
+        || trim_i8_decode(F, n, 8, sk + v + 2 * fg_len)) {
+        result = PQC_ERROR_INVALID_KEY;
+        goto cleanup;
+    }
+
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_POLY_ARITH);
+    for (size_t i = 0; i < n; i++) {
+        t[i] = mq_of(f[i]);
+        u[i] = mq_of(g[i]);
+        hm[i] = mq_of(F[i]);
+    }
+    falcon_mq_ntt(t, logn);
+    falcon_mq_ntt(u, logn);
+    falcon_mq_ntt(hm, logn);
+    int invertible = 1;
+    for (size_t i = 0; i < n; i++) {
+        invertible &= t[i] != 0;
+        u[i] = (uint16_t)falcon_mq_mul(falcon_mq_mul(u[i], hm[i]), falcon_mq_inv(t[i]));
+    }
+    falcon_mq_intt(u, logn);
+    for (size_t i = 0; i < n; i++) {
+        int32_t w = mq_center(u[i]);
+        invertible &= (w >= -127 && w <= 127);
+        G[i] = (int8_t)w;
+    }
+    if (!invertible) {
+        PQC_PERF_PHASE_END(PQC_PERF_PHASE_POLY_ARITH);
+        result = PQC_ERROR_INVALID_KEY;
+        goto cleanup;
+    }
+
+    // Basis B = [[g, -f], [G, -F]] and Gram matrix B * adj(B) in FFT form
+    for (size_t i = 0; i < n; i++) {
+        b00[i] = fpr_of(g[i]);
+        b01[i] = fpr_of(-f[i]);
+        b10[i] = fpr_of(G[i]);
+        b11[i] = fpr_of(-F[i]);
+    }
+    falcon_fft(b00, logn);
+    falcon_fft(b01, logn);
+    falcon_fft(b10, logn);
+    falcon_fft(b11, logn);
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_POLY_ARITH);
+
+    // Nonce, hashed message and sampler seed
+    uint8_t *nonce = signature + 1;
+    if (pqc_randombytes(nonce, FALCON_NONCEBYTES) != PQC_SUCCESS
+        || pqc_randombytes(seed, sizeof(seed)) != PQC_SUCCESS) {
+        result = PQC_ERROR_RANDOM_GENERATION;
+        goto cleanup;
+    }
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_HASH);
+    result = hash_to_point(hm, logn, nonce, message, msglen);
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_HASH);
+    if (result != PQC_SUCCESS) {
+        goto cleanup;
+    }
+    falcon_prng_init(&prng, seed, sizeof(seed));
+
+    // Sample until (s1, s2) is short enough and s2 compresses into the
+    // fixed-size signature; a retry is rare
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_REJECTION_LOOP);
+    for (;;) {
+        memcpy(g00, b00, n * sizeof(fpr));
+        falcon_poly_mulselfadj_fft(g00, logn);
+        memcpy(tmp, b01, n * sizeof(fpr));
+        falcon_poly_mulselfadj_fft(tmp, logn);
+        falcon_poly_add(g00, tmp, logn);
+
+        memcpy(g01, b00, n * sizeof(fpr));
+        falcon_poly_muladj_fft(g01, b10, logn);
+        memcpy(tmp, b01, n * sizeof(fpr));
+        falcon_poly_muladj_fft(tmp, b11, logn);
+        falcon_poly_add(g01, tmp, logn);
+
+        memcpy(g11, b10, n * sizeof(fpr));
+        falcon_poly_mulselfadj_fft(g11, logn);
+        memcpy(tmp, b11, n * sizeof(fpr));
+        falcon_poly_mulselfadj_fft(tmp, logn);
+        falcon_poly_add(g11, tmp, logn);
+
+        // Target (hm, 0) * B^-1 = (hm * (-F), hm * f) / q
+        for (size_t i = 0; i < n; i++) {
+            t0[i] = fpr_of(hm[i]);
+        }
+        falcon_fft(t0, logn);
+        memcpy(t1, t0, n * sizeof(fpr));
+        falcon_poly_mul_fft(t1, b01, logn);
+        falcon_poly_mulconst(t1, fpr_neg(fpr_inv_q), logn);
+        falcon_poly_mul_fft(t0, b11, logn);
+        falcon_poly_mulconst(t0, fpr_inv_q, logn);
+
+        ff_sampling(&prng, p, t0, t1, g00, g01, g11, logn, tmp);
+
+        // Lattice point z * B, then s = (hm, 0) - z * B
+        memcpy(tx, t0, n * sizeof(fpr));
+        memcpy(ty, t1, n * sizeof(fpr));
+        falcon_poly_mul_fft(tx, b00, logn);
+        falcon_poly_mul_fft(ty, b10, logn);
+        falcon_poly_add(tx, ty, logn);
+        memcpy(ty, t0, n * sizeof(fpr));
+        falcon_poly_mul_fft(ty, b01, logn);
+        memcpy(t0, tx, n * sizeof(fpr));
+        falcon_poly_mul_fft(t1, b11, logn);
+        falcon_poly_add(t1, ty, logn);
+        falcon_ifft(t0, logn);
+        falcon_ifft(t1, logn);
+
+        for (size_t i = 0; i < n; i++) {
+            s1[i] = (int16_t)((int32_t)hm[i] - (int32_t)fpr_rint(t0[i]));
+            s2[i] = (int16_t)-fpr_rint(t1[i]);
+        }
+        if (!is_short(s1, s2, n, p->l2bound)) {
+            continue;
+        }
+
+        size_t body = p->sig_bytes - 1 - FALCON_NONCEBYTES;
+        size_t clen = comp_encode(signature + 1 + FALCON_NONCEBYTES, body, s2, n);
+        if (clen == 0) {
+            continue;
+        }
+        memset(signature + 1 + FALCON_NONCEBYTES + clen, 0, body - clen);
+        break;
+    }
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_REJECTION_LOOP);
+
+    signature[0] = (uint8_t)(FALCON_HEADER_SIG + logn);
+    *siglen = p->sig_bytes;
+
+cleanup:
+    // Clear sensitive data
+    secure_free(ws, 15 * n * sizeof(fpr));
+    secure_memzero(f, sizeof(f));
+    secure_memzero(g, sizeof(g));
+    secure_memzero(F, sizeof(F));
+    secure_memzero(G, sizeof(G));
+    secure_memzero(t, sizeof(t));
+    secure_memzero(u, sizeof(u));
+    secure_memzero(s1, sizeof(s1));
+    secure_memzero(seed, sizeof(seed));
+    secure_memzero(&prng, sizeof(prng));
+
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_SIGN_ENCAPS);
+    PQC_TRACE_OP_RETURN("falcon_sign", result, result == PQC_SUCCESS ? *siglen : 0);
+    return result;
+}
+
+pqc_result_t falcon_verify(const uint8_t *signature, size_t siglen,
+                           const uint8_t *message, size_t msglen,
+                           const uint8_t *pk, size_t pklen) {
+    PQC_BYTES_SCOPE("falcon_verify");
+    if (!signature || (!message && msglen) || !pk || siglen == 0 || pklen == 0) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    unsigned logn = header_logn(pk[0], FALCON_HEADER_PK);
+    if (!logn || pklen != params_for(logn)->pk_bytes) {
+        return PQC_ERROR_INVALID_KEY;
+    }
+
+    size_t n = (size_t)1 << logn;
+    const falcon_params_t *p = params_for(logn);
+    uint16_t h[FALCON_MAX_N], hm[FALCON_MAX_N], c[FALCON_MAX_N];
+    int16_t s1[FALCON_MAX_N], s2[FALCON_MAX_N];
+
+    PQC_TRACE_OP_ENTRY("falcon_verify", msglen);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_VERIFY_DECAPS);
+
+    // Unpack signature: header, nonce, compressed s2 and zero padding
+    if (siglen != p->sig_bytes || signature[0] != FALCON_HEADER_SIG + logn) {
+        PQC_PERF_PHASE_END(PQC_PERF_PHASE_VERIFY_DECAPS);
+        PQC_TRACE_OP_RETURN("falcon_verify", PQC_ERROR_INVALID_SIGNATURE, 0);
+        return PQC_ERROR_INVALID_SIGNATURE;
+    }
+    const uint8_t *body = signature + 1 + FALCON_NONCEBYTES;
+    size_t body_len = siglen - 1 - FALCON_NONCEBYTES;
+    size_t clen = comp_decode(s2, n, body, body_len);
+    uint8_t pad = 0;
+    for (size_t i = clen; i < body_len; i++) {
+        pad |= body[i];
+    }
+    if (clen == 0 || pad != 0) {
+        PQC_PERF_PHASE_END(PQC_PERF_PHASE_VERIFY_DECAPS);
+        PQC_TRACE_OP_RETURN("falcon_verify", PQC_ERROR_INVALID_SIGNATURE, 0);
+        return PQC_ERROR_INVALID_SIGNATURE;
+    }
+
+    // Unpack public key
+    if (modq_decode(h, n, pk + 1)) {
+        PQC_PERF_PHASE_END(PQC_PERF_PHASE_VERIFY_DECAPS);
+        PQC_TRACE_OP_RETURN("falcon_verify", PQC_ERROR_INVALID_KEY, 0);
+        return PQC_ERROR_INVALID_KEY;
+    }
+
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_HASH);
+    pqc_result_t result = hash_to_point(hm, logn, signature + 1, message, msglen);
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_HASH);
+    if (result != PQC_SUCCESS) {
+        PQC_PERF_PHASE_END(PQC_PERF_PHASE_VERIFY_DECAPS);
+        PQC_TRACE_OP_RETURN("falcon_verify", result, 0);
+        return result;
+    }
+
+    // s1 = hm - s2 * h mod q, centered
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_POLY_ARITH);
+    for (size_t i = 0; i < n; i++) {
+        c[i] = mq_of(s2[i]);
+    }
+    falcon_mq_ntt(c, logn);
+    falcon_mq_ntt(h, logn);
+    for (size_t i = 0; i < n; i++) {
+        c[i] = (uint16_t)falcon_mq_mul(c[i], h[i]);
+    }
+    falcon_mq_intt(c, logn);
+    for (size_t i = 0; i < n; i++) {
+        s1[i] = (int16_t)mq_center(((uint32_t)hm[i] + FALCON_Q - c[i]) % FALCON_Q);
+    }
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_POLY_ARITH);
+
+    result = is_short(s1, s2, n, p->l2bound) ? PQC_SUCCESS : PQC_ERROR_INVALID_SIGNATURE;
+
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_VERIFY_DECAPS);
+    PQC_TRACE_OP_RETURN("falcon_verify", result, 0);
+    return result;
+}
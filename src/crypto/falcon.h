@@ -0,0 +1,97 @@
+/**
+ * @file falcon.h
+ * @brief Falcon-512/1024 post-quantum digital signature interface
+ *
+ * Falcon is a hash-and-sign lattice signature over NTRU lattices. Its
+ * signatures are several times smaller than Dilithium's (666 bytes for
+ * Falcon-512 versus 4595 for Dilithium-5) and verification is a single
+ * NTT-based polynomial multiplication, which suits bandwidth-limited
+ * device links and the attestation verifier.
+ *
+ * Keys and signatures are byte strings in the Falcon encoding; the first
+ * byte carries the parameter set, so signing and verification need no
+ * separate algorithm argument. Signatures use the fixed-length padded
+ * format.
+ */
+
+#ifndef FALCON_H
+#define FALCON_H
+
+#include "pqc_common.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Falcon-512 parameters (NIST Level 1 security)
+#define FALCON_512_PUBLICKEYBYTES   897     /**< Public key size in bytes */
+#define FALCON_512_SECRETKEYBYTES   1281    /**< Secret key size in bytes */
+#define FALCON_512_SIGNATUREBYTES   666     /**< Signature size in bytes */
+
+// Falcon-1024 parameters (NIST Level 5 security)
+#define FALCON_1024_PUBLICKEYBYTES  1793    /**< Public key size in bytes */
+#define FALCON_1024_SECRETKEYBYTES  2305    /**< Secret key size in bytes */
+#define FALCON_1024_SIGNATUREBYTES  1280    /**< Signature size in bytes */
+
+#define FALCON_NONCEBYTES           40      /**< Per-signature salt */
+
+/**
+ * @brief Generate a Falcon keypair
+ *
+ * Key generation solves the NTRU equation with multi-precision
+ * arithmetic and typically takes tens of milliseconds (Falcon-512) to a
+ * few hundred milliseconds (Falcon-1024); it is meant for provisioning,
+ * not for the attestation path.
+ *
+ * @param[in] algorithm PQC_ALG_FALCON_512 or PQC_ALG_FALCON_1024
+ * @param[out] pk Public key (FALCON_*_PUBLICKEYBYTES)
+ * @param[out] sk Secret key (FALCON_*_SECRETKEYBYTES)
+ * @return PQC_SUCCESS on success, error code on failure
+ *
+ * @note This function is not constant-time.
+ */
+pqc_result_t falcon_keypair(pqc_algorithm_t algorithm, uint8_t *pk, uint8_t *sk);
+
+/**
+ * @brief Sign a message with Falcon
+ *
+ * Gaussian sampling runs on the emulated floating-point type, so signing
+ * is constant-time and does not use the FPU unless the library is built
+ * with PQC_FALCON_NATIVE_FPR.
+ *
+ * @param[out] signature Signature buffer (FALCON_*_SIGNATUREBYTES)
+ * @param[out] siglen Length of the generated signature
+ * @param[in] message Message to sign
+ * @param[in] msglen Length of message
+ * @param[in] sk Secret key
+ * @param[in] sklen Length of secret key
+ * @return PQC_SUCCESS on success, error code on failure
+ */
+pqc_result_t falcon_sign(uint8_t *signature, size_t *siglen,
+                         const uint8_t *message, size_t msglen,
+                         const uint8_t *sk, size_t sklen);
+
+/**
+ * @brief Verify a Falcon signature
+ *
+ * Integer-only; uses no heap memory and no floating point.
+ *
+ * @param[in] signature Signature to verify
+ * @param[in] siglen Length of signature
+ * @param[in] message Original message
+ * @param[in] msglen Length of message
+ * @param[in] pk Public key
+ * @param[in] pklen Length of public key
+ * @return PQC_SUCCESS if the signature is valid, error code if invalid
+ */
+pqc_result_t falcon_verify(const uint8_t *signature, size_t siglen,
+                           const uint8_t *message, size_t msglen,
+                           const uint8_t *pk, size_t pklen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FALCON_H */
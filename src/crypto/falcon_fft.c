@@ -0,0 +1,1402 @@
+/**
+ * @file falcon_fft.c
+ * @brief FFT-domain polynomial arithmetic and NTT modulo q for Falcon
+ *
+ * The complex FFT works on real polynomials of degree n = 2^logn and keeps
+ * only the n/2 evaluations that are not conjugates of each other (see
+ * falcon_internal.h for the layout). The NTT modulo q = 12289 is the
+ * integer-only path used by verification and by key generation to compute
+ * h = g/f.
+ */
+
+#include "falcon_internal.h"
+#include "pqc_ntt.h"
+
+// ============================================================================
+// Tables
+// ============================================================================
+
+/**
+ * @brief exp(i*pi*brev(k)/1024) for k = 0..1023 (10-bit bit reversal)
+ *
+ * Stored as (re, im) pairs; entry 1 is i, which is what makes the first
+ * FFT layer free in our representation.
+ */
+static const fpr fpr_gm_tab[2 * FALCON_MAX_N] = {
+    FPR_C(0x3FF0000000000000, 1.0), FPR_C(0x0000000000000000, 0.0),
+    FPR_C(0x0000000000000000, 0.0), FPR_C(0x3FF0000000000000, 1.0),
+    FPR_C(0x3FE6A09E667F3BCD, 0.7071067811865476), FPR_C(0x3FE6A09E667F3BCD, 0.7071067811865476),
+    FPR_C(0xBFE6A09E667F3BCD, -0.7071067811865476), FPR_C(0x3FE6A09E667F3BCD, 0.7071067811865476),
+    FPR_C(0x3FED906BCF328D46, 0.9238795325112867), FPR_C(0x3FD87DE2A6AEA963, 0.3826834323650898),
+    FPR_C(0xBFD87DE2A6AEA963, -0.3826834323650898), FPR_C(0x3FED906BCF328D46, 0.9238795325112867),
+    FPR_C(0x3FD87DE2A6AEA963, 0.3826834323650898), FPR_C(0x3FED906BCF328D46, 0.9238795325112867),
+    FPR_C(0xBFED906BCF328D46, -0.9238795325112867), FPR_C(0x3FD87DE2A6AEA963, 0.3826834323650898),
+    FPR_C(0x3FEF6297CFF75CB0, 0.9807852804032304), FPR_C(0x3FC8F8B83C69A60B, 0.19509032201612828),
+    FPR_C(0xBFC8F8B83C69A60B, -0.19509032201612828), FPR_C(0x3FEF6297CFF75CB0, 0.9807852804032304),
+    FPR_C(0x3FE1C73B39AE68C8, 0.5555702330196022), FPR_C(0x3FEA9B66290EA1A3, 0.8314696123025452),
+    FPR_C(0xBFEA9B66290EA1A3, -0.8314696123025452), FPR_C(0x3FE1C73B39AE68C8, 0.5555702330196022),
+    FPR_C(0x3FEA9B66290EA1A3, 0.8314696123025452), FPR_C(0x3FE1C73B39AE68C8, 0.5555702330196022),
+    FPR_C(0xBFE1C73B39AE68C8, -0.5555702330196022), FPR_C(0x3FEA9B66290EA1A3, 0.8314696123025452),
+    FPR_C(0x3FC8F8B83C69A60B, 0.19509032201612828), FPR_C(0x3FEF6297CFF75CB0, 0.9807852804032304),
+    FPR_C(0xBFEF6297CFF75CB0, -0.9807852804032304), FPR_C(0x3FC8F8B83C69A60B, 0.19509032201612828),
+    FPR_C(0x3FEFD88DA3D12526, 0.9951847266721969), FPR_C(0x3FB917A6BC29B42C, 0.0980171403295606),
+    FPR_C(0xBFB917A6BC29B42C, -0.0980171403295606), FPR_C(0x3FEFD88DA3D12526, 0.9951847266721969),
+    FPR_C(0x3FE44CF325091DD6, 0.6343932841636455), FPR_C(0x3FE8BC806B151741, 0.773010453362737),
+    FPR_C(0xBFE8BC806B151741, -0.773010453362737), FPR_C(0x3FE44CF325091DD6, 0.6343932841636455),
+    FPR_C(0x3FEC38B2F180BDB1, 0.881921264348355), FPR_C(0x3FDE2B5D3806F63B, 0.47139673682599764),
+    FPR_C(0xBFDE2B5D3806F63B, -0.47139673682599764), FPR_C(0x3FEC38B2F180BDB1, 0.881921264348355),
+    FPR_C(0x3FD294062ED59F06, 0.2902846772544624), FPR_C(0x3FEE9F4156C62DDA, 0.9569403357322088),
+    FPR_C(0xBFEE9F4156C62DDA, -0.9569403357322088), FPR_C(0x3FD294062ED59F06, 0.2902846772544624),
+    FPR_C(0x3FEE9F4156C62DDA, 0.9569403357322088), FPR_C(0x3FD294062ED59F06, 0.2902846772544624),
+    FPR_C(0xBFD294062ED59F06, -0.2902846772544624), FPR_C(0x3FEE9F4156C62DDA, 0.9569403357322088),
+    FPR_C(0x3FDE2B5D3806F63B, 0.47139673682599764), FPR_C(0x3FEC38B2F180BDB1, 0.881921264348355),
+    FPR_C(0xBFEC38B2F180BDB1, -0.881921264348355), FPR_C(0x3FDE2B5D3806F63B, 0.47139673682599764),
+    FPR_C(0x3FE8BC806B151741, 0.773010453362737), FPR_C(0x3FE44CF325091DD6, 0.6343932841636455),
+    FPR_C(0xBFE44CF325091DD6, -0.6343932841636455), FPR_C(0x3FE8BC806B151741, 0.773010453362737),
+    FPR_C(0x3FB917A6BC29B42C, 0.0980171403295606), FPR_C(0x3FEFD88DA3D12526, 0.9951847266721969),
+    FPR_C(0xBFEFD88DA3D12526, -0.9951847266721969), FPR_C(0x3FB917A6BC29B42C, 0.0980171403295606),
+    FPR_C(0x3FEFF621E3796D7E, 0.9987954562051724), FPR_C(0x3FA91F65F10DD814, 0.049067674327418015),
+    FPR_C(0xBFA91F65F10DD814, -0.049067674327418015), FPR_C(0x3FEFF621E3796D7E, 0.9987954562051724),
+    FPR_C(0x3FE57D69348CECA0, 0.6715589548470184), FPR_C(0x3FE7B5DF226AAFAF, 0.7409511253549591),
+    FPR_C(0xBFE7B5DF226AAFAF, -0.7409511253549591), FPR_C(0x3FE57D69348CECA0, 0.6715589548470184),
+    FPR_C(0x3FECED7AF43CC773, 0.9039892931234433), FPR_C(0x3FDB5D1009E15CC0, 0.4275550934302821),
+    FPR_C(0xBFDB5D1009E15CC0, -0.4275550934302821), FPR_C(0x3FECED7AF43CC773, 0.9039892931234433),
+    FPR_C(0x3FD58F9A75AB1FDD, 0.33688985339222005), FPR_C(0x3FEE212104F686E5, 0.9415440651830208),
+    FPR_C(0xBFEE212104F686E5, -0.9415440651830208), FPR_C(0x3FD58F9A75AB1FDD, 0.33688985339222005),
+    FPR_C(0x3FEF0A7EFB9230D7, 0.970031253194544), FPR_C(0x3FCF19F97B215F1B, 0.2429801799032639),
+    FPR_C(0xBFCF19F97B215F1B, -0.2429801799032639), FPR_C(0x3FEF0A7EFB9230D7, 0.970031253194544),
+    FPR_C(0x3FE073879922FFEE, 0.5141027441932218), FPR_C(0x3FEB728345196E3E, 0.8577286100002721),
+    FPR_C(0xBFEB728345196E3E, -0.8577286100002721), FPR_C(0x3FE073879922FFEE, 0.5141027441932218),
+    FPR_C(0x3FE9B3E047F38741, 0.8032075314806449), FPR_C(0x3FE30FF7FCE17035, 0.5956993044924334),
+    FPR_C(0xBFE30FF7FCE17035, -0.5956993044924334), FPR_C(0x3FE9B3E047F38741, 0.8032075314806449),
+    FPR_C(0x3FC2C8106E8E613A, 0.14673047445536175), FPR_C(0x3FEFA7557F08A517, 0.989176509964781),
+    FPR_C(0xBFEFA7557F08A517, -0.989176509964781), FPR_C(0x3FC2C8106E8E613A, 0.14673047445536175),
+    FPR_C(0x3FEFA7557F08A517, 0.989176509964781), FPR_C(0x3FC2C8106E8E613A, 0.14673047445536175),
+    FPR_C(0xBFC2C8106E8E613A, -0.14673047445536175), FPR_C(0x3FEFA7557F08A517, 0.989176509964781),
+    FPR_C(0x3FE30FF7FCE17035, 0.5956993044924334), FPR_C(0x3FE9B3E047F38741, 0.8032075314806449),
+    FPR_C(0xBFE9B3E047F38741, -0.8032075314806449), FPR_C(0x3FE30FF7FCE17035, 0.5956993044924334),
+    FPR_C(0x3FEB728345196E3E, 0.8577286100002721), FPR_C(0x3FE073879922FFEE, 0.5141027441932218),
+    FPR_C(0xBFE073879922FFEE, -0.5141027441932218), FPR_C(0x3FEB728345196E3E, 0.8577286100002721),
+    FPR_C(0x3FCF19F97B215F1B, 0.2429801799032639), FPR_C(0x3FEF0A7EFB9230D7, 0.970031253194544),
+    FPR_C(0xBFEF0A7EFB9230D7, -0.970031253194544), FPR_C(0x3FCF19F97B215F1B, 0.2429801799032639),
+    FPR_C(0x3FEE212104F686E5, 0.9415440651830208), FPR_C(0x3FD58F9A75AB1FDD, 0.33688985339222005),
+    FPR_C(0xBFD58F9A75AB1FDD, -0.33688985339222005), FPR_C(0x3FEE212104F686E5, 0.9415440651830208),
+    FPR_C(0x3FDB5D1009E15CC0, 0.4275550934302821), FPR_C(0x3FECED7AF43CC773, 0.9039892931234433),
+    FPR_C(0xBFECED7AF43CC773, -0.9039892931234433), FPR_C(0x3FDB5D1009E15CC0, 0.4275550934302821),
+    FPR_C(0x3FE7B5DF226AAFAF, 0.7409511253549591), FPR_C(0x3FE57D69348CECA0, 0.6715589548470184),
+    FPR_C(0xBFE57D69348CECA0, -0.6715589548470184), FPR_C(0x3FE7B5DF226AAFAF, 0.7409511253549591),
+    FPR_C(0x3FA91F65F10DD814, 0.049067674327418015), FPR_C(0x3FEFF621E3796D7E, 0.9987954562051724),
+    FPR_C(0xBFEFF621E3796D7E, -0.9987954562051724), FPR_C(0x3FA91F65F10DD814, 0.049067674327418015),
+    FPR_C(0x3FEFFD886084CD0D, 0.9996988186962042), FPR_C(0x3F992155F7A3667E, 0.024541228522912288),
+    FPR_C(0xBF992155F7A3667E, -0.024541228522912288), FPR_C(0x3FEFFD886084CD0D, 0.9996988186962042),
+    FPR_C(0x3FE610B7551D2CDF, 0.6895405447370669), FPR_C(0x3FE72D0837EFFF96, 0.7242470829514669),
+    FPR_C(0xBFE72D0837EFFF96, -0.7242470829514669), FPR_C(0x3FE610B7551D2CDF, 0.6895405447370669),
+    FPR_C(0x3FED4134D14DC93A, 0.9142097557035307), FPR_C(0x3FD9EF7943A8ED8A, 0.40524131400498986),
+    FPR_C(0xBFD9EF7943A8ED8A, -0.40524131400498986), FPR_C(0x3FED4134D14DC93A, 0.9142097557035307),
+    FPR_C(0x3FD7088530FA459F, 0.35989503653498817), FPR_C(0x3FEDDB13B6CCC23C, 0.9329927988347388),
+    FPR_C(0xBFEDDB13B6CCC23C, -0.9329927988347388), FPR_C(0x3FD7088530FA459F, 0.35989503653498817),
+    FPR_C(0x3FEF38F3AC64E589, 0.9757021300385286), FPR_C(0x3FCC0B826A7E4F63, 0.2191012401568698),
+    FPR_C(0xBFCC0B826A7E4F63, -0.2191012401568698), FPR_C(0x3FEF38F3AC64E589, 0.9757021300385286),
+    FPR_C(0x3FE11EB3541B4B23, 0.5349976198870973), FPR_C(0x3FEB090A58150200, 0.8448535652497071),
+    FPR_C(0xBFEB090A58150200, -0.8448535652497071), FPR_C(0x3FE11EB3541B4B23, 0.5349976198870973),
+    FPR_C(0x3FEA29A7A0462782, 0.8175848131515837), FPR_C(0x3FE26D054CDD12DF, 0.5758081914178453),
+    FPR_C(0xBFE26D054CDD12DF, -0.5758081914178453), FPR_C(0x3FEA29A7A0462782, 0.8175848131515837),
+    FPR_C(0x3FC5E214448B3FC6, 0.17096188876030122), FPR_C(0x3FEF8764FA714BA9, 0.9852776423889412),
+    FPR_C(0xBFEF8764FA714BA9, -0.9852776423889412), FPR_C(0x3FC5E214448B3FC6, 0.17096188876030122),
+    FPR_C(0x3FEFC26470E19FD3, 0.99247953459871), FPR_C(0x3FBF564E56A9730E, 0.1224106751992162),
+    FPR_C(0xBFBF564E56A9730E, -0.1224106751992162), FPR_C(0x3FEFC26470E19FD3, 0.99247953459871),
+    FPR_C(0x3FE3AFFA292050B9, 0.6152315905806268), FPR_C(0x3FE93A22499263FB, 0.7883464276266062),
+    FPR_C(0xBFE93A22499263FB, -0.7883464276266062), FPR_C(0x3FE3AFFA292050B9, 0.6152315905806268),
+    FPR_C(0x3FEBD7C0AC6F952A, 0.8700869911087115), FPR_C(0x3FDF8BA4DBF89ABA, 0.49289819222978404),
+    FPR_C(0xBFDF8BA4DBF89ABA, -0.49289819222978404), FPR_C(0x3FEBD7C0AC6F952A, 0.8700869911087115),
+    FPR_C(0x3FD111D262B1F677, 0.26671275747489837), FPR_C(0x3FEED740E7684963, 0.9637760657954398),
+    FPR_C(0xBFEED740E7684963, -0.9637760657954398), FPR_C(0x3FD111D262B1F677, 0.26671275747489837),
+    FPR_C(0x3FEE6288EC48E112, 0.9495281805930367), FPR_C(0x3FD4135C94176601, 0.31368174039889146),
+    FPR_C(0xBFD4135C94176601, -0.31368174039889146), FPR_C(0x3FEE6288EC48E112, 0.9495281805930367),
+    FPR_C(0x3FDCC66E9931C45E, 0.4496113296546066), FPR_C(0x3FEC954B213411F5, 0.8932243011955153),
+    FPR_C(0xBFEC954B213411F5, -0.8932243011955153), FPR_C(0x3FDCC66E9931C45E, 0.4496113296546066),
+    FPR_C(0x3FE83B0E0BFF976E, 0.7572088465064846), FPR_C(0x3FE4E6CABBE3E5E9, 0.6531728429537768),
+    FPR_C(0xBFE4E6CABBE3E5E9, -0.6531728429537768), FPR_C(0x3FE83B0E0BFF976E, 0.7572088465064846),
+    FPR_C(0x3FB2D52092CE19F6, 0.07356456359966743), FPR_C(0x3FEFE9CDAD01883A, 0.9972904566786902),
+    FPR_C(0xBFEFE9CDAD01883A, -0.9972904566786902), FPR_C(0x3FB2D52092CE19F6, 0.07356456359966743),
+    FPR_C(0x3FEFE9CDAD01883A, 0.9972904566786902), FPR_C(0x3FB2D52092CE19F6, 0.07356456359966743),
+    FPR_C(0xBFB2D52092CE19F6, -0.07356456359966743), FPR_C(0x3FEFE9CDAD01883A, 0.9972904566786902),
+    FPR_C(0x3FE4E6CABBE3E5E9, 0.6531728429537768), FPR_C(0x3FE83B0E0BFF976E, 0.7572088465064846),
+    FPR_C(0xBFE83B0E0BFF976E, -0.7572088465064846), FPR_C(0x3FE4E6CABBE3E5E9, 0.6531728429537768),
+    FPR_C(0x3FEC954B213411F5, 0.8932243011955153), FPR_C(0x3FDCC66E9931C45E, 0.4496113296546066),
+    FPR_C(0xBFDCC66E9931C45E, -0.4496113296546066), FPR_C(0x3FEC954B213411F5, 0.8932243011955153),
+    FPR_C(0x3FD4135C94176601, 0.31368174039889146), FPR_C(0x3FEE6288EC48E112, 0.9495281805930367),
+    FPR_C(0xBFEE6288EC48E112, -0.9495281805930367), FPR_C(0x3FD4135C94176601, 0.31368174039889146),
+    FPR_C(0x3FEED740E7684963, 0.9637760657954398), FPR_C(0x3FD111D262B1F677, 0.26671275747489837),
+    FPR_C(0xBFD111D262B1F677, -0.26671275747489837), FPR_C(0x3FEED740E7684963, 0.9637760657954398),
+    FPR_C(0x3FDF8BA4DBF89ABA, 0.49289819222978404), FPR_C(0x3FEBD7C0AC6F952A, 0.8700869911087115),
+    FPR_C(0xBFEBD7C0AC6F952A, -0.8700869911087115), FPR_C(0x3FDF8BA4DBF89ABA, 0.49289819222978404),
+    FPR_C(0x3FE93A22499263FB, 0.7883464276266062), FPR_C(0x3FE3AFFA292050B9, 0.6152315905806268),
+    FPR_C(0xBFE3AFFA292050B9, -0.6152315905806268), FPR_C(0x3FE93A22499263FB, 0.7883464276266062),
+    FPR_C(0x3FBF564E56A9730E, 0.1224106751992162), FPR_C(0x3FEFC26470E19FD3, 0.99247953459871),
+    FPR_C(0xBFEFC26470E19FD3, -0.99247953459871), FPR_C(0x3FBF564E56A9730E, 0.1224106751992162),
+    FPR_C(0x3FEF8764FA714BA9, 0.9852776423889412), FPR_C(0x3FC5E214448B3FC6, 0.17096188876030122),
+    FPR_C(0xBFC5E214448B3FC6, -0.17096188876030122), FPR_C(0x3FEF8764FA714BA9, 0.9852776423889412),
+    FPR_C(0x3FE26D054CDD12DF, 0.5758081914178453), FPR_C(0x3FEA29A7A0462782, 0.8175848131515837),
+    FPR_C(0xBFEA29A7A0462782, -0.8175848131515837), FPR_C(0x3FE26D054CDD12DF, 0.5758081914178453),
+    FPR_C(0x3FEB090A58150200, 0.8448535652497071), FPR_C(0x3FE11EB3541B4B23, 0.5349976198870973),
+    FPR_C(0xBFE11EB3541B4B23, -0.5349976198870973), FPR_C(0x3FEB090A58150200, 0.8448535652497071),
+    FPR_C(0x3FCC0B826A7E4F63, 0.2191012401568698), FPR_C(0x3FEF38F3AC64E589, 0.9757021300385286),
+    FPR_C(0xBFEF38F3AC64E589, -0.9757021300385286), FPR_C(0x3FCC0B826A7E4F63, 0.2191012401568698),
+    FPR_C(0x3FEDDB13B6CCC23C, 0.9329927988347388), FPR_C(0x3FD7088530FA459F, 0.35989503653498817),
+    FPR_C(0xBFD7088530FA459F, -0.35989503653498817), FPR_C(0x3FEDDB13B6CCC23C, 0.9329927988347388),
+    FPR_C(0x3FD9EF7943A8ED8A, 0.40524131400498986), FPR_C(0x3FED4134D14DC93A, 0.9142097557035307),
+    FPR_C(0xBFED4134D14DC93A, -0.9142097557035307), FPR_C(0x3FD9EF7943A8ED8A, 0.40524131400498986),
+    FPR_C(0x3FE72D0837EFFF96, 0.7242470829514669), FPR_C(0x3FE610B7551D2CDF, 0.6895405447370669),
+    FPR_C(0xBFE610B7551D2CDF, -0.6895405447370669), FPR_C(0x3FE72D0837EFFF96, 0.7242470829514669),
+    FPR_C(0x3F992155F7A3667E, 0.024541228522912288), FPR_C(0x3FEFFD886084CD0D, 0.9996988186962042),
+    FPR_C(0xBFEFFD886084CD0D, -0.9996988186962042), FPR_C(0x3F992155F7A3667E, 0.024541228522912288),
+    FPR_C(0x3FEFFF62169B92DB, 0.9999247018391445), FPR_C(0x3F8921D1FCDEC784, 0.012271538285719925),
+    FPR_C(0xBF8921D1FCDEC784, -0.012271538285719925), FPR_C(0x3FEFFF62169B92DB, 0.9999247018391445),
+    FPR_C(0x3FE6591925F0783D, 0.6983762494089728), FPR_C(0x3FE6E74454EAA8AF, 0.7157308252838187),
+    FPR_C(0xBFE6E74454EAA8AF, -0.7157308252838187), FPR_C(0x3FE6591925F0783D, 0.6983762494089728),
+    FPR_C(0x3FED696173C9E68B, 0.9191138516900578), FPR_C(0x3FD9372A63BC93D7, 0.3939920400610481),
+    FPR_C(0xBFD9372A63BC93D7, -0.3939920400610481), FPR_C(0x3FED696173C9E68B, 0.9191138516900578),
+    FPR_C(0x3FD7C3A9311DCCE7, 0.37131719395183754), FPR_C(0x3FEDB6526238A09B, 0.9285060804732156),
+    FPR_C(0xBFEDB6526238A09B, -0.9285060804732156), FPR_C(0x3FD7C3A9311DCCE7, 0.37131719395183754),
+    FPR_C(0x3FEF4E603B0B2F2D, 0.9783173707196277), FPR_C(0x3FCA82A025B00451, 0.20711137619221856),
+    FPR_C(0xBFCA82A025B00451, -0.20711137619221856), FPR_C(0x3FEF4E603B0B2F2D, 0.9783173707196277),
+    FPR_C(0x3FE1734D63DEDB49, 0.5453249884220465), FPR_C(0x3FEAD2BC9E21D511, 0.8382247055548381),
+    FPR_C(0xBFEAD2BC9E21D511, -0.8382247055548381), FPR_C(0x3FE1734D63DEDB49, 0.5453249884220465),
+    FPR_C(0x3FEA63091B02FAE2, 0.8245893027850253), FPR_C(0x3FE21A799933EB59, 0.5657318107836132),
+    FPR_C(0xBFE21A799933EB59, -0.5657318107836132), FPR_C(0x3FEA63091B02FAE2, 0.8245893027850253),
+    FPR_C(0x3FC76DD9DE50BF31, 0.18303988795514095), FPR_C(0x3FEF7599A3A12077, 0.9831054874312163),
+    FPR_C(0xBFEF7599A3A12077, -0.9831054874312163), FPR_C(0x3FC76DD9DE50BF31, 0.18303988795514095),
+    FPR_C(0x3FEFCE15FD6DA67B, 0.9939069700023561), FPR_C(0x3FBC3785C79EC2D5, 0.11022220729388306),
+    FPR_C(0xBFBC3785C79EC2D5, -0.11022220729388306), FPR_C(0x3FEFCE15FD6DA67B, 0.9939069700023561),
+    FPR_C(0x3FE3FED9534556D4, 0.6248594881423863), FPR_C(0x3FE8FBCCA3EF940D, 0.7807372285720945),
+    FPR_C(0xBFE8FBCCA3EF940D, -0.7807372285720945), FPR_C(0x3FE3FED9534556D4, 0.6248594881423863),
+    FPR_C(0x3FEC08C426725549, 0.8760700941954066), FPR_C(0x3FDEDC1952EF78D6, 0.4821837720791228),
+    FPR_C(0xBFDEDC1952EF78D6, -0.4821837720791228), FPR_C(0x3FEC08C426725549, 0.8760700941954066),
+    FPR_C(0x3FD1D3443F4CDB3E, 0.2785196893850531), FPR_C(0x3FEEBBD8C8DF0B74, 0.9604305194155658),
+    FPR_C(0xBFEEBBD8C8DF0B74, -0.9604305194155658), FPR_C(0x3FD1D3443F4CDB3E, 0.2785196893850531),
+    FPR_C(0x3FEE817BAB4CD10D, 0.9533060403541939), FPR_C(0x3FD35410C2E18152, 0.3020059493192281),
+    FPR_C(0xBFD35410C2E18152, -0.3020059493192281), FPR_C(0x3FEE817BAB4CD10D, 0.9533060403541939),
+    FPR_C(0x3FDD79775B86E389, 0.46053871095824), FPR_C(0x3FEC678B3488739B, 0.8876396204028539),
+    FPR_C(0xBFEC678B3488739B, -0.8876396204028539), FPR_C(0x3FDD79775B86E389, 0.46053871095824),
+    FPR_C(0x3FE87C400FBA2EBF, 0.765167265622459), FPR_C(0x3FE49A449B9B0939, 0.6438315428897915),
+    FPR_C(0xBFE49A449B9B0939, -0.6438315428897915), FPR_C(0x3FE87C400FBA2EBF, 0.765167265622459),
+    FPR_C(0x3FB5F6D00A9AA419, 0.0857973123444399), FPR_C(0x3FEFE1CAFCBD5B09, 0.996312612182778),
+    FPR_C(0xBFEFE1CAFCBD5B09, -0.996312612182778), FPR_C(0x3FB5F6D00A9AA419, 0.0857973123444399),
+    FPR_C(0x3FEFF095658E71AD, 0.9981181129001492), FPR_C(0x3FAF656E79F820E0, 0.06132073630220858),
+    FPR_C(0xBFAF656E79F820E0, -0.06132073630220858), FPR_C(0x3FEFF095658E71AD, 0.9981181129001492),
+    FPR_C(0x3FE5328292A35596, 0.6624157775901718), FPR_C(0x3FE7F8ECE3571771, 0.7491363945234594),
+    FPR_C(0xBFE7F8ECE3571771, -0.7491363945234594), FPR_C(0x3FE5328292A35596, 0.6624157775901718),
+    FPR_C(0x3FECC1F0F3FCFC5C, 0.8986744656939538), FPR_C(0x3FDC1249D8011EE7, 0.43861623853852766),
+    FPR_C(0xBFDC1249D8011EE7, -0.43861623853852766), FPR_C(0x3FECC1F0F3FCFC5C, 0.8986744656939538),
+    FPR_C(0x3FD4D1E24278E76A, 0.3253102921622629), FPR_C(0x3FEE426A4B2BC17E, 0.9456073253805213),
+    FPR_C(0xBFEE426A4B2BC17E, -0.9456073253805213), FPR_C(0x3FD4D1E24278E76A, 0.3253102921622629),
+    FPR_C(0x3FEEF178A3E473C2, 0.9669764710448521), FPR_C(0x3FD04FB80E37FDAE, 0.25486565960451457),
+    FPR_C(0xBFD04FB80E37FDAE, -0.25486565960451457), FPR_C(0x3FEEF178A3E473C2, 0.9669764710448521),
+    FPR_C(0x3FE01CFC874C3EB7, 0.5035383837257176), FPR_C(0x3FEBA5AA673590D2, 0.8639728561215867),
+    FPR_C(0xBFEBA5AA673590D2, -0.8639728561215867), FPR_C(0x3FE01CFC874C3EB7, 0.5035383837257176),
+    FPR_C(0x3FE9777EF4C7D742, 0.7958369046088836), FPR_C(0x3FE36058B10659F3, 0.6055110414043255),
+    FPR_C(0xBFE36058B10659F3, -0.6055110414043255), FPR_C(0x3FE9777EF4C7D742, 0.7958369046088836),
+    FPR_C(0x3FC139F0CEDAF577, 0.1345807085071262), FPR_C(0x3FEFB5797195D741, 0.99090263542778),
+    FPR_C(0xBFEFB5797195D741, -0.99090263542778), FPR_C(0x3FC139F0CEDAF577, 0.1345807085071262),
+    FPR_C(0x3FEF97F924C9099B, 0.9873014181578584), FPR_C(0x3FC45576B1293E5A, 0.15885814333386145),
+    FPR_C(0xBFC45576B1293E5A, -0.15885814333386145), FPR_C(0x3FEF97F924C9099B, 0.9873014181578584),
+    FPR_C(0x3FE2BEDB25FAF3EA, 0.5857978574564389), FPR_C(0x3FE9EF43EF29AF94, 0.8104571982525948),
+    FPR_C(0xBFE9EF43EF29AF94, -0.8104571982525948), FPR_C(0x3FE2BEDB25FAF3EA, 0.5857978574564389),
+    FPR_C(0x3FEB3E4D3EF55712, 0.8513551931052652), FPR_C(0x3FE0C9704D5D898F, 0.524589682678469),
+    FPR_C(0xBFE0C9704D5D898F, -0.524589682678469), FPR_C(0x3FEB3E4D3EF55712, 0.8513551931052652),
+    FPR_C(0x3FCD934FE5454311, 0.2310581082806711), FPR_C(0x3FEF2252F7763ADA, 0.9729399522055602),
+    FPR_C(0xBFEF2252F7763ADA, -0.9729399522055602), FPR_C(0x3FCD934FE5454311, 0.2310581082806711),
+    FPR_C(0x3FEDFEAE622DBE2B, 0.937339011912575), FPR_C(0x3FD64C7DDD3F27C6, 0.34841868024943456),
+    FPR_C(0xBFD64C7DDD3F27C6, -0.34841868024943456), FPR_C(0x3FEDFEAE622DBE2B, 0.937339011912575),
+    FPR_C(0x3FDAA6C82B6D3FCA, 0.4164295600976372), FPR_C(0x3FED17E7743E35DC, 0.9091679830905224),
+    FPR_C(0xBFED17E7743E35DC, -0.9091679830905224), FPR_C(0x3FDAA6C82B6D3FCA, 0.4164295600976372),
+    FPR_C(0x3FE771E75F037261, 0.7326542716724128), FPR_C(0x3FE5C77BBE65018C, 0.680600997795453),
+    FPR_C(0xBFE5C77BBE65018C, -0.680600997795453), FPR_C(0x3FE771E75F037261, 0.7326542716724128),
+    FPR_C(0x3FA2D865759455CD, 0.03680722294135883), FPR_C(0x3FEFFA72EFFEF75D, 0.9993223845883495),
+    FPR_C(0xBFEFFA72EFFEF75D, -0.9993223845883495), FPR_C(0x3FA2D865759455CD, 0.03680722294135883),
+    FPR_C(0x3FEFFA72EFFEF75D, 0.9993223845883495), FPR_C(0x3FA2D865759455CD, 0.03680722294135883),
+    FPR_C(0xBFA2D865759455CD, -0.03680722294135883), FPR_C(0x3FEFFA72EFFEF75D, 0.9993223845883495),
+    FPR_C(0x3FE5C77BBE65018C, 0.680600997795453), FPR_C(0x3FE771E75F037261, 0.7326542716724128),
+    FPR_C(0xBFE771E75F037261, -0.7326542716724128), FPR_C(0x3FE5C77BBE65018C, 0.680600997795453),
+    FPR_C(0x3FED17E7743E35DC, 0.9091679830905224), FPR_C(0x3FDAA6C82B6D3FCA, 0.4164295600976372),
+    FPR_C(0xBFDAA6C82B6D3FCA, -0.4164295600976372), FPR_C(0x3FED17E7743E35DC, 0.9091679830905224),
+    FPR_C(0x3FD64C7DDD3F27C6, 0.34841868024943456), FPR_C(0x3FEDFEAE622DBE2B, 0.937339011912575),
+    FPR_C(0xBFEDFEAE622DBE2B, -0.937339011912575), FPR_C(0x3FD64C7DDD3F27C6, 0.34841868024943456),
+    FPR_C(0x3FEF2252F7763ADA, 0.9729399522055602), FPR_C(0x3FCD934FE5454311, 0.2310581082806711),
+    FPR_C(0xBFCD934FE5454311, -0.2310581082806711), FPR_C(0x3FEF2252F7763ADA, 0.9729399522055602),
+    FPR_C(0x3FE0C9704D5D898F, 0.524589682678469), FPR_C(0x3FEB3E4D3EF55712, 0.8513551931052652),
+    FPR_C(0xBFEB3E4D3EF55712, -0.8513551931052652), FPR_C(0x3FE0C9704D5D898F, 0.524589682678469),
+    FPR_C(0x3FE9EF43EF29AF94, 0.8104571982525948), FPR_C(0x3FE2BEDB25FAF3EA, 0.5857978574564389),
+    FPR_C(0xBFE2BEDB25FAF3EA, -0.5857978574564389), FPR_C(0x3FE9EF43EF29AF94, 0.8104571982525948),
+    FPR_C(0x3FC45576B1293E5A, 0.15885814333386145), FPR_C(0x3FEF97F924C9099B, 0.9873014181578584),
+    FPR_C(0xBFEF97F924C9099B, -0.9873014181578584), FPR_C(0x3FC45576B1293E5A, 0.15885814333386145),
+    FPR_C(0x3FEFB5797195D741, 0.99090263542778), FPR_C(0x3FC139F0CEDAF577, 0.1345807085071262),
+    FPR_C(0xBFC139F0CEDAF577, -0.1345807085071262), FPR_C(0x3FEFB5797195D741, 0.99090263542778),
+    FPR_C(0x3FE36058B10659F3, 0.6055110414043255), FPR_C(0x3FE9777EF4C7D742, 0.7958369046088836),
+    FPR_C(0xBFE9777EF4C7D742, -0.7958369046088836), FPR_C(0x3FE36058B10659F3, 0.6055110414043255),
+    FPR_C(0x3FEBA5AA673590D2, 0.8639728561215867), FPR_C(0x3FE01CFC874C3EB7, 0.5035383837257176),
+    FPR_C(0xBFE01CFC874C3EB7, -0.5035383837257176), FPR_C(0x3FEBA5AA673590D2, 0.8639728561215867),
+    FPR_C(0x3FD04FB80E37FDAE, 0.25486565960451457), FPR_C(0x3FEEF178A3E473C2, 0.9669764710448521),
+    FPR_C(0xBFEEF178A3E473C2, -0.9669764710448521), FPR_C(0x3FD04FB80E37FDAE, 0.25486565960451457),
+    FPR_C(0x3FEE426A4B2BC17E, 0.9456073253805213), FPR_C(0x3FD4D1E24278E76A, 0.3253102921622629),
+    FPR_C(0xBFD4D1E24278E76A, -0.3253102921622629), FPR_C(0x3FEE426A4B2BC17E, 0.9456073253805213),
+    FPR_C(0x3FDC1249D8011EE7, 0.43861623853852766), FPR_C(0x3FECC1F0F3FCFC5C, 0.8986744656939538),
+    FPR_C(0xBFECC1F0F3FCFC5C, -0.8986744656939538), FPR_C(0x3FDC1249D8011EE7, 0.43861623853852766),
+    FPR_C(0x3FE7F8ECE3571771, 0.7491363945234594), FPR_C(0x3FE5328292A35596, 0.6624157775901718),
+    FPR_C(0xBFE5328292A35596, -0.6624157775901718), FPR_C(0x3FE7F8ECE3571771, 0.7491363945234594),
+    FPR_C(0x3FAF656E79F820E0, 0.06132073630220858), FPR_C(0x3FEFF095658E71AD, 0.9981181129001492),
+    FPR_C(0xBFEFF095658E71AD, -0.9981181129001492), FPR_C(0x3FAF656E79F820E0, 0.06132073630220858),
+    FPR_C(0x3FEFE1CAFCBD5B09, 0.996312612182778), FPR_C(0x3FB5F6D00A9AA419, 0.0857973123444399),
+    FPR_C(0xBFB5F6D00A9AA419, -0.0857973123444399), FPR_C(0x3FEFE1CAFCBD5B09, 0.996312612182778),
+    FPR_C(0x3FE49A449B9B0939, 0.6438315428897915), FPR_C(0x3FE87C400FBA2EBF, 0.765167265622459),
+    FPR_C(0xBFE87C400FBA2EBF, -0.765167265622459), FPR_C(0x3FE49A449B9B0939, 0.6438315428897915),
+    FPR_C(0x3FEC678B3488739B, 0.8876396204028539), FPR_C(0x3FDD79775B86E389, 0.46053871095824),
+    FPR_C(0xBFDD79775B86E389, -0.46053871095824), FPR_C(0x3FEC678B3488739B, 0.8876396204028539),
+    FPR_C(0x3FD35410C2E18152, 0.3020059493192281), FPR_C(0x3FEE817BAB4CD10D, 0.9533060403541939),
+    FPR_C(0xBFEE817BAB4CD10D, -0.9533060403541939), FPR_C(0x3FD35410C2E18152, 0.3020059493192281),
+    FPR_C(0x3FEEBBD8C8DF0B74, 0.9604305194155658), FPR_C(0x3FD1D3443F4CDB3E, 0.2785196893850531),
+    FPR_C(0xBFD1D3443F4CDB3E, -0.2785196893850531), FPR_C(0x3FEEBBD8C8DF0B74, 0.9604305194155658),
+    FPR_C(0x3FDEDC1952EF78D6, 0.4821837720791228), FPR_C(0x3FEC08C426725549, 0.8760700941954066),
+    FPR_C(0xBFEC08C426725549, -0.8760700941954066), FPR_C(0x3FDEDC1952EF78D6, 0.4821837720791228),
+    FPR_C(0x3FE8FBCCA3EF940D, 0.7807372285720945), FPR_C(0x3FE3FED9534556D4, 0.6248594881423863),
+    FPR_C(0xBFE3FED9534556D4, -0.6248594881423863), FPR_C(0x3FE8FBCCA3EF940D, 0.7807372285720945),
+    FPR_C(0x3FBC3785C79EC2D5, 0.11022220729388306), FPR_C(0x3FEFCE15FD6DA67B, 0.9939069700023561),
+    FPR_C(0xBFEFCE15FD6DA67B, -0.9939069700023561), FPR_C(0x3FBC3785C79EC2D5, 0.11022220729388306),
+    FPR_C(0x3FEF7599A3A12077, 0.9831054874312163), FPR_C(0x3FC76DD9DE50BF31, 0.18303988795514095),
+    FPR_C(0xBFC76DD9DE50BF31, -0.18303988795514095), FPR_C(0x3FEF7599A3A12077, 0.9831054874312163),
+    FPR_C(0x3FE21A799933EB59, 0.5657318107836132), FPR_C(0x3FEA63091B02FAE2, 0.8245893027850253),
+    FPR_C(0xBFEA63091B02FAE2, -0.8245893027850253), FPR_C(0x3FE21A799933EB59, 0.5657318107836132),
+    FPR_C(0x3FEAD2BC9E21D511, 0.8382247055548381), FPR_C(0x3FE1734D63DEDB49, 0.5453249884220465),
+    FPR_C(0xBFE1734D63DEDB49, -0.5453249884220465), FPR_C(0x3FEAD2BC9E21D511, 0.8382247055548381),
+    FPR_C(0x3FCA82A025B00451, 0.20711137619221856), FPR_C(0x3FEF4E603B0B2F2D, 0.9783173707196277),
+    FPR_C(0xBFEF4E603B0B2F2D, -0.9783173707196277), FPR_C(0x3FCA82A025B00451, 0.20711137619221856),
+    FPR_C(0x3FEDB6526238A09B, 0.9285060804732156), FPR_C(0x3FD7C3A9311DCCE7, 0.37131719395183754),
+    FPR_C(0xBFD7C3A9311DCCE7, -0.37131719395183754), FPR_C(0x3FEDB6526238A09B, 0.9285060804732156),
+    FPR_C(0x3FD9372A63BC93D7, 0.3939920400610481), FPR_C(0x3FED696173C9E68B, 0.9191138516900578),
+    FPR_C(0xBFED696173C9E68B, -0.9191138516900578), FPR_C(0x3FD9372A63BC93D7, 0.3939920400610481),
+    FPR_C(0x3FE6E74454EAA8AF, 0.7157308252838187), FPR_C(0x3FE6591925F0783D, 0.6983762494089728),
+    FPR_C(0xBFE6591925F0783D, -0.6983762494089728), FPR_C(0x3FE6E74454EAA8AF, 0.7157308252838187),
+    FPR_C(0x3F8921D1FCDEC784, 0.012271538285719925), FPR_C(0x3FEFFF62169B92DB, 0.9999247018391445),
+    FPR_C(0xBFEFFF62169B92DB, -0.9999247018391445), FPR_C(0x3F8921D1FCDEC784, 0.012271538285719925),
+    FPR_C(0x3FEFFFD8858E8A92, 0.9999811752826011), FPR_C(0x3F7921F0FE670071, 0.006135884649154475),
+    FPR_C(0xBF7921F0FE670071, -0.006135884649154475), FPR_C(0x3FEFFFD8858E8A92, 0.9999811752826011),
+    FPR_C(0x3FE67CF78491AF10, 0.7027547444572253), FPR_C(0x3FE6C40D73C18275, 0.7114321957452164),
+    FPR_C(0xBFE6C40D73C18275, -0.7114321957452164), FPR_C(0x3FE67CF78491AF10, 0.7027547444572253),
+    FPR_C(0x3FED7D0B02B8ECF9, 0.9215140393420419), FPR_C(0x3FD8DAA52EC8A4B0, 0.3883450466988263),
+    FPR_C(0xBFD8DAA52EC8A4B0, -0.3883450466988263), FPR_C(0x3FED7D0B02B8ECF9, 0.9215140393420419),
+    FPR_C(0x3FD820E3B04EAAC4, 0.37700741021641826), FPR_C(0x3FEDA383A9668988, 0.9262102421383114),
+    FPR_C(0xBFEDA383A9668988, -0.9262102421383114), FPR_C(0x3FD820E3B04EAAC4, 0.37700741021641826),
+    FPR_C(0x3FEF58A2B1789E84, 0.9795697656854405), FPR_C(0x3FC9BDCBF2DC4366, 0.2011046348420919),
+    FPR_C(0xBFC9BDCBF2DC4366, -0.2011046348420919), FPR_C(0x3FEF58A2B1789E84, 0.9795697656854405),
+    FPR_C(0x3FE19D5A09F2B9B8, 0.5504579729366048), FPR_C(0x3FEAB7325916C0D4, 0.83486287498638),
+    FPR_C(0xBFEAB7325916C0D4, -0.83486287498638), FPR_C(0x3FE19D5A09F2B9B8, 0.5504579729366048),
+    FPR_C(0x3FEA7F58529FE69D, 0.8280450452577558), FPR_C(0x3FE1F0F08BBC861B, 0.560661576197336),
+    FPR_C(0xBFE1F0F08BBC861B, -0.560661576197336), FPR_C(0x3FEA7F58529FE69D, 0.8280450452577558),
+    FPR_C(0x3FC83366E89C64C6, 0.18906866414980622), FPR_C(0x3FEF6C3F7DF5BBB7, 0.9819638691095552),
+    FPR_C(0xBFEF6C3F7DF5BBB7, -0.9819638691095552), FPR_C(0x3FC83366E89C64C6, 0.18906866414980622),
+    FPR_C(0x3FEFD37914220B84, 0.9945645707342554), FPR_C(0x3FBAA7B724495C03, 0.10412163387205457),
+    FPR_C(0xBFBAA7B724495C03, -0.10412163387205457), FPR_C(0x3FEFD37914220B84, 0.9945645707342554),
+    FPR_C(0x3FE425FF178E6BB1, 0.629638238914927), FPR_C(0x3FE8DC45331698CC, 0.7768884656732324),
+    FPR_C(0xBFE8DC45331698CC, -0.7768884656732324), FPR_C(0x3FE425FF178E6BB1, 0.629638238914927),
+    FPR_C(0x3FEC20DE3FA971B0, 0.8790122264286335), FPR_C(0x3FDE83E0EAF85114, 0.47679923006332214),
+    FPR_C(0xBFDE83E0EAF85114, -0.47679923006332214), FPR_C(0x3FEC20DE3FA971B0, 0.8790122264286335),
+    FPR_C(0x3FD233BBABC3BB71, 0.2844075372112718), FPR_C(0x3FEEADB2E8E7A88E, 0.9587034748958716),
+    FPR_C(0xBFEEADB2E8E7A88E, -0.9587034748958716), FPR_C(0x3FD233BBABC3BB71, 0.2844075372112718),
+    FPR_C(0x3FEE9084361DF7F2, 0.9551411683057707), FPR_C(0x3FD2F422DAEC0387, 0.29615088824362384),
+    FPR_C(0xBFD2F422DAEC0387, -0.29615088824362384), FPR_C(0x3FEE9084361DF7F2, 0.9551411683057707),
+    FPR_C(0x3FDDD28F1481CC58, 0.4659764957679662), FPR_C(0x3FEC5042012B6907, 0.8847970984309378),
+    FPR_C(0xBFEC5042012B6907, -0.8847970984309378), FPR_C(0x3FDDD28F1481CC58, 0.4659764957679662),
+    FPR_C(0x3FE89C7E9A4DD4AA, 0.7691033376455796), FPR_C(0x3FE473B51B987347, 0.6391244448637757),
+    FPR_C(0xBFE473B51B987347, -0.6391244448637757), FPR_C(0x3FE89C7E9A4DD4AA, 0.7691033376455796),
+    FPR_C(0x3FB787586A5D5B21, 0.09190895649713272), FPR_C(0x3FEFDD539FF1F456, 0.9957674144676598),
+    FPR_C(0xBFEFDD539FF1F456, -0.9957674144676598), FPR_C(0x3FB787586A5D5B21, 0.09190895649713272),
+    FPR_C(0x3FEFF3830F8D575C, 0.9984755805732948), FPR_C(0x3FAC428D12C0D7E3, 0.05519524434968994),
+    FPR_C(0xBFAC428D12C0D7E3, -0.05519524434968994), FPR_C(0x3FEFF3830F8D575C, 0.9984755805732948),
+    FPR_C(0x3FE5581038975137, 0.6669999223036375), FPR_C(0x3FE7D7836CC33DB2, 0.745057785441466),
+    FPR_C(0xBFE7D7836CC33DB2, -0.745057785441466), FPR_C(0x3FE5581038975137, 0.6669999223036375),
+    FPR_C(0x3FECD7D9898B32F6, 0.901348847046022), FPR_C(0x3FDBB7CF2304BD01, 0.43309381885315196),
+    FPR_C(0xBFDBB7CF2304BD01, -0.43309381885315196), FPR_C(0x3FECD7D9898B32F6, 0.901348847046022),
+    FPR_C(0x3FD530D880AF3C24, 0.33110630575987643), FPR_C(0x3FEE31EAE870CE25, 0.9435934581619604),
+    FPR_C(0xBFEE31EAE870CE25, -0.9435934581619604), FPR_C(0x3FD530D880AF3C24, 0.33110630575987643),
+    FPR_C(0x3FEEFE220C0B95EC, 0.9685220942744173), FPR_C(0x3FCFDCDC1ADFEDF9, 0.24892760574572018),
+    FPR_C(0xBFCFDCDC1ADFEDF9, -0.24892760574572018), FPR_C(0x3FEEFE220C0B95EC, 0.9685220942744173),
+    FPR_C(0x3FE0485626AE221A, 0.508830142543107), FPR_C(0x3FEB8C38D27504E9, 0.8608669386377673),
+    FPR_C(0xBFEB8C38D27504E9, -0.8608669386377673), FPR_C(0x3FE0485626AE221A, 0.508830142543107),
+    FPR_C(0x3FE995CF2ED80D22, 0.799537269107905), FPR_C(0x3FE338400D0C8E57, 0.600616479383869),
+    FPR_C(0xBFE338400D0C8E57, -0.600616479383869), FPR_C(0x3FE995CF2ED80D22, 0.799537269107905),
+    FPR_C(0x3FC20116D4EC7BCF, 0.14065823933284924), FPR_C(0x3FEFAE8E8E46CFBB, 0.9900582102622971),
+    FPR_C(0xBFEFAE8E8E46CFBB, -0.9900582102622971), FPR_C(0x3FC20116D4EC7BCF, 0.14065823933284924),
+    FPR_C(0x3FEF9FCE55ADB2C8, 0.9882575677307495), FPR_C(0x3FC38EDBB0CD8D14, 0.15279718525844344),
+    FPR_C(0xBFC38EDBB0CD8D14, -0.15279718525844344), FPR_C(0x3FEF9FCE55ADB2C8, 0.9882575677307495),
+    FPR_C(0x3FE2E780E3E8EA17, 0.5907597018588743), FPR_C(0x3FE9D1B1F5EA80D5, 0.8068475535437992),
+    FPR_C(0xBFE9D1B1F5EA80D5, -0.8068475535437992), FPR_C(0x3FE2E780E3E8EA17, 0.5907597018588743),
+    FPR_C(0x3FEB5889FE921405, 0.8545579883654005), FPR_C(0x3FE09E907417C5E1, 0.5193559901655896),
+    FPR_C(0xBFE09E907417C5E1, -0.5193559901655896), FPR_C(0x3FEB5889FE921405, 0.8545579883654005),
+    FPR_C(0x3FCE56CA1E101A1B, 0.2370236059943672), FPR_C(0x3FEF168F53F7205D, 0.9715038909862518),
+    FPR_C(0xBFEF168F53F7205D, -0.9715038909862518), FPR_C(0x3FCE56CA1E101A1B, 0.2370236059943672),
+    FPR_C(0x3FEE100CCA2980AC, 0.9394592236021899), FPR_C(0x3FD5EE27379EA693, 0.3426607173119944),
+    FPR_C(0xBFD5EE27379EA693, -0.3426607173119944), FPR_C(0x3FEE100CCA2980AC, 0.9394592236021899),
+    FPR_C(0x3FDB020D6C7F4009, 0.4220002707997997), FPR_C(0x3FED02D4FEB2BD92, 0.9065957045149153),
+    FPR_C(0xBFED02D4FEB2BD92, -0.9065957045149153), FPR_C(0x3FDB020D6C7F4009, 0.4220002707997997),
+    FPR_C(0x3FE79400574F55E5, 0.7368165688773699), FPR_C(0x3FE5A28D2A5D7250, 0.6760927035753159),
+    FPR_C(0xBFE5A28D2A5D7250, -0.6760927035753159), FPR_C(0x3FE79400574F55E5, 0.7368165688773699),
+    FPR_C(0x3FA5FC00D290CD43, 0.04293825693494082), FPR_C(0x3FEFF871DADB81DF, 0.9990777277526454),
+    FPR_C(0xBFEFF871DADB81DF, -0.9990777277526454), FPR_C(0x3FA5FC00D290CD43, 0.04293825693494082),
+    FPR_C(0x3FEFFC251DF1D3F8, 0.9995294175010931), FPR_C(0x3F9F693731D1CF01, 0.030674803176636626),
+    FPR_C(0xBF9F693731D1CF01, -0.030674803176636626), FPR_C(0x3FEFFC251DF1D3F8, 0.9995294175010931),
+    FPR_C(0x3FE5EC3495837074, 0.6850836677727004), FPR_C(0x3FE74F948DA8D28D, 0.7284643904482252),
+    FPR_C(0xBFE74F948DA8D28D, -0.7284643904482252), FPR_C(0x3FE5EC3495837074, 0.6850836677727004),
+    FPR_C(0x3FED2CB220E0EF9F, 0.9117060320054299), FPR_C(0x3FDA4B4127DEA1E5, 0.41084317105790397),
+    FPR_C(0xBFDA4B4127DEA1E5, -0.41084317105790397), FPR_C(0x3FED2CB220E0EF9F, 0.9117060320054299),
+    FPR_C(0x3FD6AA9D7DC77E17, 0.3541635254204904), FPR_C(0x3FEDED05F7DE47DA, 0.9351835099389476),
+    FPR_C(0xBFEDED05F7DE47DA, -0.9351835099389476), FPR_C(0x3FD6AA9D7DC77E17, 0.3541635254204904),
+    FPR_C(0x3FEF2DC9C9089A9D, 0.9743393827855759), FPR_C(0x3FCCCF8CB312B286, 0.22508391135979283),
+    FPR_C(0xBFCCCF8CB312B286, -0.22508391135979283), FPR_C(0x3FEF2DC9C9089A9D, 0.9743393827855759),
+    FPR_C(0x3FE0F426BB2A8E7E, 0.5298036246862947), FPR_C(0x3FEB23CD470013B4, 0.8481203448032972),
+    FPR_C(0xBFEB23CD470013B4, -0.8481203448032972), FPR_C(0x3FE0F426BB2A8E7E, 0.5298036246862947),
+    FPR_C(0x3FEA0C95EABAF937, 0.8140363297059484), FPR_C(0x3FE2960727629CA8, 0.5808139580957645),
+    FPR_C(0xBFE2960727629CA8, -0.5808139580957645), FPR_C(0x3FEA0C95EABAF937, 0.8140363297059484),
+    FPR_C(0x3FC51BDF8597C5F2, 0.16491312048996992), FPR_C(0x3FEF8FD5FFAE41DB, 0.9863080972445987),
+    FPR_C(0xBFEF8FD5FFAE41DB, -0.9863080972445987), FPR_C(0x3FC51BDF8597C5F2, 0.16491312048996992),
+    FPR_C(0x3FEFBC1617E44186, 0.9917097536690995), FPR_C(0x3FC072A047BA831D, 0.12849811079379317),
+    FPR_C(0xBFC072A047BA831D, -0.12849811079379317), FPR_C(0x3FEFBC1617E44186, 0.9917097536690995),
+    FPR_C(0x3FE3884185DFEB22, 0.6103828062763095), FPR_C(0x3FE958EFE48E6DD7, 0.7921065773002124),
+    FPR_C(0xBFE958EFE48E6DD7, -0.7921065773002124), FPR_C(0x3FE3884185DFEB22, 0.6103828062763095),
+    FPR_C(0x3FEBBED7C49380EA, 0.8670462455156926), FPR_C(0x3FDFE2F64BE71210, 0.49822766697278187),
+    FPR_C(0xBFDFE2F64BE71210, -0.49822766697278187), FPR_C(0x3FEBBED7C49380EA, 0.8670462455156926),
+    FPR_C(0x3FD0B0D9CFDBDB90, 0.2607941179152755), FPR_C(0x3FEEE482E25A9DBC, 0.9653944416976894),
+    FPR_C(0xBFEEE482E25A9DBC, -0.9653944416976894), FPR_C(0x3FD0B0D9CFDBDB90, 0.2607941179152755),
+    FPR_C(0x3FEE529F04729FFC, 0.9475855910177411), FPR_C(0x3FD472B8A5571054, 0.3195020308160157),
+    FPR_C(0xBFD472B8A5571054, -0.3195020308160157), FPR_C(0x3FEE529F04729FFC, 0.9475855910177411),
+    FPR_C(0x3FDC6C7F4997000B, 0.44412214457042926), FPR_C(0x3FECABC169A0B900, 0.8959662497561851),
+    FPR_C(0xBFECABC169A0B900, -0.8959662497561851), FPR_C(0x3FDC6C7F4997000B, 0.44412214457042926),
+    FPR_C(0x3FE81A1B33B57ACC, 0.7531867990436125), FPR_C(0x3FE50CC09F59A09B, 0.6578066932970786),
+    FPR_C(0xBFE50CC09F59A09B, -0.6578066932970786), FPR_C(0x3FE81A1B33B57ACC, 0.7531867990436125),
+    FPR_C(0x3FB1440134D709B3, 0.06744391956366406), FPR_C(0x3FEFED58ECB673C4, 0.9977230666441916),
+    FPR_C(0xBFEFED58ECB673C4, -0.9977230666441916), FPR_C(0x3FB1440134D709B3, 0.06744391956366406),
+    FPR_C(0x3FEFE5F3AF2E3940, 0.9968202992911657), FPR_C(0x3FB4661179272096, 0.07968243797143013),
+    FPR_C(0xBFB4661179272096, -0.07968243797143013), FPR_C(0x3FEFE5F3AF2E3940, 0.9968202992911657),
+    FPR_C(0x3FE4C0A145EC0004, 0.6485144010221124), FPR_C(0x3FE85BC51AE958CC, 0.7612023854842618),
+    FPR_C(0xBFE85BC51AE958CC, -0.7612023854842618), FPR_C(0x3FE4C0A145EC0004, 0.6485144010221124),
+    FPR_C(0x3FEC7E8E52233CF3, 0.8904487232447579), FPR_C(0x3FDD2016E8E9DB5B, 0.45508358712634384),
+    FPR_C(0xBFDD2016E8E9DB5B, -0.45508358712634384), FPR_C(0x3FEC7E8E52233CF3, 0.8904487232447579),
+    FPR_C(0x3FD3B3CEFA0414B7, 0.30784964004153487), FPR_C(0x3FEE7227DB6A9744, 0.9514350209690083),
+    FPR_C(0xBFEE7227DB6A9744, -0.9514350209690083), FPR_C(0x3FD3B3CEFA0414B7, 0.30784964004153487),
+    FPR_C(0x3FEEC9B2D3C3BF84, 0.9621214042690416), FPR_C(0x3FD172A0D7765177, 0.272621355449949),
+    FPR_C(0xBFD172A0D7765177, -0.272621355449949), FPR_C(0x3FEEC9B2D3C3BF84, 0.9621214042690416),
+    FPR_C(0x3FDF3405963FD067, 0.48755016014843594), FPR_C(0x3FEBF064E15377DD, 0.8730949784182901),
+    FPR_C(0xBFEBF064E15377DD, -0.8730949784182901), FPR_C(0x3FDF3405963FD067, 0.48755016014843594),
+    FPR_C(0x3FE91B166FD49DA2, 0.7845565971555752), FPR_C(0x3FE3D78238C58344, 0.6200572117632892),
+    FPR_C(0xBFE3D78238C58344, -0.6200572117632892), FPR_C(0x3FE91B166FD49DA2, 0.7845565971555752),
+    FPR_C(0x3FBDC70ECBAE9FC9, 0.11631863091190477), FPR_C(0x3FEFC8646CFEB721, 0.9932119492347945),
+    FPR_C(0xBFEFC8646CFEB721, -0.9932119492347945), FPR_C(0x3FBDC70ECBAE9FC9, 0.11631863091190477),
+    FPR_C(0x3FEF7EA629E63D6E, 0.984210092386929), FPR_C(0x3FC6A81304F64AB2, 0.17700422041214875),
+    FPR_C(0xBFC6A81304F64AB2, -0.17700422041214875), FPR_C(0x3FEF7EA629E63D6E, 0.984210092386929),
+    FPR_C(0x3FE243D5FB98AC1F, 0.5707807458869673), FPR_C(0x3FEA4678C8119AC8, 0.8211025149911046),
+    FPR_C(0xBFEA4678C8119AC8, -0.8211025149911046), FPR_C(0x3FE243D5FB98AC1F, 0.5707807458869673),
+    FPR_C(0x3FEAEE04B43C1474, 0.8415549774368984), FPR_C(0x3FE14915AF336CEB, 0.5401714727298929),
+    FPR_C(0xBFE14915AF336CEB, -0.5401714727298929), FPR_C(0x3FEAEE04B43C1474, 0.8415549774368984),
+    FPR_C(0x3FCB4732EF3D6722, 0.21311031991609136), FPR_C(0x3FEF43D085FF92DD, 0.9770281426577544),
+    FPR_C(0xBFEF43D085FF92DD, -0.9770281426577544), FPR_C(0x3FCB4732EF3D6722, 0.21311031991609136),
+    FPR_C(0x3FEDC8D7CB410260, 0.9307669610789837), FPR_C(0x3FD766340F2418F6, 0.36561299780477385),
+    FPR_C(0xBFD766340F2418F6, -0.36561299780477385), FPR_C(0x3FEDC8D7CB410260, 0.9307669610789837),
+    FPR_C(0x3FD993716141BDFF, 0.39962419984564684), FPR_C(0x3FED556F52E93EB1, 0.9166790599210427),
+    FPR_C(0xBFED556F52E93EB1, -0.9166790599210427), FPR_C(0x3FD993716141BDFF, 0.39962419984564684),
+    FPR_C(0x3FE70A42B3176D7A, 0.7200025079613817), FPR_C(0x3FE63503A31C1BE9, 0.693971460889654),
+    FPR_C(0xBFE63503A31C1BE9, -0.693971460889654), FPR_C(0x3FE70A42B3176D7A, 0.7200025079613817),
+    FPR_C(0x3F92D936BBE30EFD, 0.01840672990580482), FPR_C(0x3FEFFE9CB44B51A1, 0.9998305817958234),
+    FPR_C(0xBFEFFE9CB44B51A1, -0.9998305817958234), FPR_C(0x3F92D936BBE30EFD, 0.01840672990580482),
+    FPR_C(0x3FEFFE9CB44B51A1, 0.9998305817958234), FPR_C(0x3F92D936BBE30EFD, 0.01840672990580482),
+    FPR_C(0xBF92D936BBE30EFD, -0.01840672990580482), FPR_C(0x3FEFFE9CB44B51A1, 0.9998305817958234),
+    FPR_C(0x3FE63503A31C1BE9, 0.693971460889654), FPR_C(0x3FE70A42B3176D7A, 0.7200025079613817),
+    FPR_C(0xBFE70A42B3176D7A, -0.7200025079613817), FPR_C(0x3FE63503A31C1BE9, 0.693971460889654),
+    FPR_C(0x3FED556F52E93EB1, 0.9166790599210427), FPR_C(0x3FD993716141BDFF, 0.39962419984564684),
+    FPR_C(0xBFD993716141BDFF, -0.39962419984564684), FPR_C(0x3FED556F52E93EB1, 0.9166790599210427),
+    FPR_C(0x3FD766340F2418F6, 0.36561299780477385), FPR_C(0x3FEDC8D7CB410260, 0.9307669610789837),
+    FPR_C(0xBFEDC8D7CB410260, -0.9307669610789837), FPR_C(0x3FD766340F2418F6, 0.36561299780477385),
+    FPR_C(0x3FEF43D085FF92DD, 0.9770281426577544), FPR_C(0x3FCB4732EF3D6722, 0.21311031991609136),
+    FPR_C(0xBFCB4732EF3D6722, -0.21311031991609136), FPR_C(0x3FEF43D085FF92DD, 0.9770281426577544),
+    FPR_C(0x3FE14915AF336CEB, 0.5401714727298929), FPR_C(0x3FEAEE04B43C1474, 0.8415549774368984),
+    FPR_C(0xBFEAEE04B43C1474, -0.8415549774368984), FPR_C(0x3FE14915AF336CEB, 0.5401714727298929),
+    FPR_C(0x3FEA4678C8119AC8, 0.8211025149911046), FPR_C(0x3FE243D5FB98AC1F, 0.5707807458869673),
+    FPR_C(0xBFE243D5FB98AC1F, -0.5707807458869673), FPR_C(0x3FEA4678C8119AC8, 0.8211025149911046),
+    FPR_C(0x3FC6A81304F64AB2, 0.17700422041214875), FPR_C(0x3FEF7EA629E63D6E, 0.984210092386929),
+    FPR_C(0xBFEF7EA629E63D6E, -0.984210092386929), FPR_C(0x3FC6A81304F64AB2, 0.17700422041214875),
+    FPR_C(0x3FEFC8646CFEB721, 0.9932119492347945), FPR_C(0x3FBDC70ECBAE9FC9, 0.11631863091190477),
+    FPR_C(0xBFBDC70ECBAE9FC9, -0.11631863091190477), FPR_C(0x3FEFC8646CFEB721, 0.9932119492347945),
+    FPR_C(0x3FE3D78238C58344, 0.6200572117632892), FPR_C(0x3FE91B166FD49DA2, 0.7845565971555752),
+    FPR_C(0xBFE91B166FD49DA2, -0.7845565971555752), FPR_C(0x3FE3D78238C58344, 0.6200572117632892),
+    FPR_C(0x3FEBF064E15377DD, 0.8730949784182901), FPR_C(0x3FDF3405963FD067, 0.48755016014843594),
+    FPR_C(0xBFDF3405963FD067, -0.48755016014843594), FPR_C(0x3FEBF064E15377DD, 0.8730949784182901),
+    FPR_C(0x3FD172A0D7765177, 0.272621355449949), FPR_C(0x3FEEC9B2D3C3BF84, 0.9621214042690416),
+    FPR_C(0xBFEEC9B2D3C3BF84, -0.9621214042690416), FPR_C(0x3FD172A0D7765177, 0.272621355449949),
+    FPR_C(0x3FEE7227DB6A9744, 0.9514350209690083), FPR_C(0x3FD3B3CEFA0414B7, 0.30784964004153487),
+    FPR_C(0xBFD3B3CEFA0414B7, -0.30784964004153487), FPR_C(0x3FEE7227DB6A9744, 0.9514350209690083),
+    FPR_C(0x3FDD2016E8E9DB5B, 0.45508358712634384), FPR_C(0x3FEC7E8E52233CF3, 0.8904487232447579),
+    FPR_C(0xBFEC7E8E52233CF3, -0.8904487232447579), FPR_C(0x3FDD2016E8E9DB5B, 0.45508358712634384),
+    FPR_C(0x3FE85BC51AE958CC, 0.7612023854842618), FPR_C(0x3FE4C0A145EC0004, 0.6485144010221124),
+    FPR_C(0xBFE4C0A145EC0004, -0.6485144010221124), FPR_C(0x3FE85BC51AE958CC, 0.7612023854842618),
+    FPR_C(0x3FB4661179272096, 0.07968243797143013), FPR_C(0x3FEFE5F3AF2E3940, 0.9968202992911657),
+    FPR_C(0xBFEFE5F3AF2E3940, -0.9968202992911657), FPR_C(0x3FB4661179272096, 0.07968243797143013),
+    FPR_C(0x3FEFED58ECB673C4, 0.9977230666441916), FPR_C(0x3FB1440134D709B3, 0.06744391956366406),
+    FPR_C(0xBFB1440134D709B3, -0.06744391956366406), FPR_C(0x3FEFED58ECB673C4, 0.9977230666441916),
+    FPR_C(0x3FE50CC09F59A09B, 0.6578066932970786), FPR_C(0x3FE81A1B33B57ACC, 0.7531867990436125),
+    FPR_C(0xBFE81A1B33B57ACC, -0.7531867990436125), FPR_C(0x3FE50CC09F59A09B, 0.6578066932970786),
+    FPR_C(0x3FECABC169A0B900, 0.8959662497561851), FPR_C(0x3FDC6C7F4997000B, 0.44412214457042926),
+    FPR_C(0xBFDC6C7F4997000B, -0.44412214457042926), FPR_C(0x3FECABC169A0B900, 0.8959662497561851),
+    FPR_C(0x3FD472B8A5571054, 0.3195020308160157), FPR_C(0x3FEE529F04729FFC, 0.9475855910177411),
+    FPR_C(0xBFEE529F04729FFC, -0.9475855910177411), FPR_C(0x3FD472B8A5571054, 0.3195020308160157),
+    FPR_C(0x3FEEE482E25A9DBC, 0.9653944416976894), FPR_C(0x3FD0B0D9CFDBDB90, 0.2607941179152755),
+    FPR_C(0xBFD0B0D9CFDBDB90, -0.2607941179152755), FPR_C(0x3FEEE482E25A9DBC, 0.9653944416976894),
+    FPR_C(0x3FDFE2F64BE71210, 0.49822766697278187), FPR_C(0x3FEBBED7C49380EA, 0.8670462455156926),
+    FPR_C(0xBFEBBED7C49380EA, -0.8670462455156926), FPR_C(0x3FDFE2F64BE71210, 0.49822766697278187),
+    FPR_C(0x3FE958EFE48E6DD7, 0.7921065773002124), FPR_C(0x3FE3884185DFEB22, 0.6103828062763095),
+    FPR_C(0xBFE3884185DFEB22, -0.6103828062763095), FPR_C(0x3FE958EFE48E6DD7, 0.7921065773002124),
+    FPR_C(0x3FC072A047BA831D, 0.12849811079379317), FPR_C(0x3FEFBC1617E44186, 0.9917097536690995),
+    FPR_C(0xBFEFBC1617E44186, -0.9917097536690995), FPR_C(0x3FC072A047BA831D, 0.12849811079379317),
+    FPR_C(0x3FEF8FD5FFAE41DB, 0.9863080972445987), FPR_C(0x3FC51BDF8597C5F2, 0.16491312048996992),
+    FPR_C(0xBFC51BDF8597C5F2, -0.16491312048996992), FPR_C(0x3FEF8FD5FFAE41DB, 0.9863080972445987),
+    FPR_C(0x3FE2960727629CA8, 0.5808139580957645), FPR_C(0x3FEA0C95EABAF937, 0.8140363297059484),
+    FPR_C(0xBFEA0C95EABAF937, -0.8140363297059484), FPR_C(0x3FE2960727629CA8, 0.5808139580957645),
+    FPR_C(0x3FEB23CD470013B4, 0.8481203448032972), FPR_C(0x3FE0F426BB2A8E7E, 0.5298036246862947),
+    FPR_C(0xBFE0F426BB2A8E7E, -0.5298036246862947), FPR_C(0x3FEB23CD470013B4, 0.8481203448032972),
+    FPR_C(0x3FCCCF8CB312B286, 0.22508391135979283), FPR_C(0x3FEF2DC9C9089A9D, 0.9743393827855759),
+    FPR_C(0xBFEF2DC9C9089A9D, -0.9743393827855759), FPR_C(0x3FCCCF8CB312B286, 0.22508391135979283),
+    FPR_C(0x3FEDED05F7DE47DA, 0.9351835099389476), FPR_C(0x3FD6AA9D7DC77E17, 0.3541635254204904),
+    FPR_C(0xBFD6AA9D7DC77E17, -0.3541635254204904), FPR_C(0x3FEDED05F7DE47DA, 0.9351835099389476),
+    FPR_C(0x3FDA4B4127DEA1E5, 0.41084317105790397), FPR_C(0x3FED2CB220E0EF9F, 0.9117060320054299),
+    FPR_C(0xBFED2CB220E0EF9F, -0.9117060320054299), FPR_C(0x3FDA4B4127DEA1E5, 0.41084317105790397),
+    FPR_C(0x3FE74F948DA8D28D, 0.7284643904482252), FPR_C(0x3FE5EC3495837074, 0.6850836677727004),
+    FPR_C(0xBFE5EC3495837074, -0.6850836677727004), FPR_C(0x3FE74F948DA8D28D, 0.7284643904482252),
+    FPR_C(0x3F9F693731D1CF01, 0.030674803176636626), FPR_C(0x3FEFFC251DF1D3F8, 0.9995294175010931),
+    FPR_C(0xBFEFFC251DF1D3F8, -0.9995294175010931), FPR_C(0x3F9F693731D1CF01, 0.030674803176636626),
+    FPR_C(0x3FEFF871DADB81DF, 0.9990777277526454), FPR_C(0x3FA5FC00D290CD43, 0.04293825693494082),
+    FPR_C(0xBFA5FC00D290CD43, -0.04293825693494082), FPR_C(0x3FEFF871DADB81DF, 0.9990777277526454),
+    FPR_C(0x3FE5A28D2A5D7250, 0.6760927035753159), FPR_C(0x3FE79400574F55E5, 0.7368165688773699),
+    FPR_C(0xBFE79400574F55E5, -0.7368165688773699), FPR_C(0x3FE5A28D2A5D7250, 0.6760927035753159),
+    FPR_C(0x3FED02D4FEB2BD92, 0.9065957045149153), FPR_C(0x3FDB020D6C7F4009, 0.4220002707997997),
+    FPR_C(0xBFDB020D6C7F4009, -0.4220002707997997), FPR_C(0x3FED02D4FEB2BD92, 0.9065957045149153),
+    FPR_C(0x3FD5EE27379EA693, 0.3426607173119944), FPR_C(0x3FEE100CCA2980AC, 0.9394592236021899),
+    FPR_C(0xBFEE100CCA2980AC, -0.9394592236021899), FPR_C(0x3FD5EE27379EA693, 0.3426607173119944),
+    FPR_C(0x3FEF168F53F7205D, 0.9715038909862518), FPR_C(0x3FCE56CA1E101A1B, 0.2370236059943672),
+    FPR_C(0xBFCE56CA1E101A1B, -0.2370236059943672), FPR_C(0x3FEF168F53F7205D, 0.9715038909862518),
+    FPR_C(0x3FE09E907417C5E1, 0.5193559901655896), FPR_C(0x3FEB5889FE921405, 0.8545579883654005),
+    FPR_C(0xBFEB5889FE921405, -0.8545579883654005), FPR_C(0x3FE09E907417C5E1, 0.5193559901655896),
+    FPR_C(0x3FE9D1B1F5EA80D5, 0.8068475535437992), FPR_C(0x3FE2E780E3E8EA17, 0.5907597018588743),
+    FPR_C(0xBFE2E780E3E8EA17, -0.5907597018588743), FPR_C(0x3FE9D1B1F5EA80D5, 0.8068475535437992),
+    FPR_C(0x3FC38EDBB0CD8D14, 0.15279718525844344), FPR_C(0x3FEF9FCE55ADB2C8, 0.9882575677307495),
+    FPR_C(0xBFEF9FCE55ADB2C8, -0.9882575677307495), FPR_C(0x3FC38EDBB0CD8D14, 0.15279718525844344),
+    FPR_C(0x3FEFAE8E8E46CFBB, 0.9900582102622971), FPR_C(0x3FC20116D4EC7BCF, 0.14065823933284924),
+    FPR_C(0xBFC20116D4EC7BCF, -0.14065823933284924), FPR_C(0x3FEFAE8E8E46CFBB, 0.9900582102622971),
+    FPR_C(0x3FE338400D0C8E57, 0.600616479383869), FPR_C(0x3FE995CF2ED80D22, 0.799537269107905),
+    FPR_C(0xBFE995CF2ED80D22, -0.799537269107905), FPR_C(0x3FE338400D0C8E57, 0.600616479383869),
+    FPR_C(0x3FEB8C38D27504E9, 0.8608669386377673), FPR_C(0x3FE0485626AE221A, 0.508830142543107),
+    FPR_C(0xBFE0485626AE221A, -0.508830142543107), FPR_C(0x3FEB8C38D27504E9, 0.8608669386377673),
+    FPR_C(0x3FCFDCDC1ADFEDF9, 0.24892760574572018), FPR_C(0x3FEEFE220C0B95EC, 0.9685220942744173),
+    FPR_C(0xBFEEFE220C0B95EC, -0.9685220942744173), FPR_C(0x3FCFDCDC1ADFEDF9, 0.24892760574572018),
+    FPR_C(0x3FEE31EAE870CE25, 0.9435934581619604), FPR_C(0x3FD530D880AF3C24, 0.33110630575987643),
+    FPR_C(0xBFD530D880AF3C24, -0.33110630575987643), FPR_C(0x3FEE31EAE870CE25, 0.9435934581619604),
+    FPR_C(0x3FDBB7CF2304BD01, 0.43309381885315196), FPR_C(0x3FECD7D9898B32F6, 0.901348847046022),
+    FPR_C(0xBFECD7D9898B32F6, -0.901348847046022), FPR_C(0x3FDBB7CF2304BD01, 0.43309381885315196),
+    FPR_C(0x3FE7D7836CC33DB2, 0.745057785441466), FPR_C(0x3FE5581038975137, 0.6669999223036375),
+    FPR_C(0xBFE5581038975137, -0.6669999223036375), FPR_C(0x3FE7D7836CC33DB2, 0.745057785441466),
+    FPR_C(0x3FAC428D12C0D7E3, 0.05519524434968994), FPR_C(0x3FEFF3830F8D575C, 0.9984755805732948),
+    FPR_C(0xBFEFF3830F8D575C, -0.9984755805732948), FPR_C(0x3FAC428D12C0D7E3, 0.05519524434968994),
+    FPR_C(0x3FEFDD539FF1F456, 0.9957674144676598), FPR_C(0x3FB787586A5D5B21, 0.09190895649713272),
+    FPR_C(0xBFB787586A5D5B21, -0.09190895649713272), FPR_C(0x3FEFDD539FF1F456, 0.9957674144676598),
+    FPR_C(0x3FE473B51B987347, 0.6391244448637757), FPR_C(0x3FE89C7E9A4DD4AA, 0.7691033376455796),
+    FPR_C(0xBFE89C7E9A4DD4AA, -0.7691033376455796), FPR_C(0x3FE473B51B987347, 0.6391244448637757),
+    FPR_C(0x3FEC5042012B6907, 0.8847970984309378), FPR_C(0x3FDDD28F1481CC58, 0.4659764957679662),
+    FPR_C(0xBFDDD28F1481CC58, -0.4659764957679662), FPR_C(0x3FEC5042012B6907, 0.8847970984309378),
+    FPR_C(0x3FD2F422DAEC0387, 0.29615088824362384), FPR_C(0x3FEE9084361DF7F2, 0.9551411683057707),
+    FPR_C(0xBFEE9084361DF7F2, -0.9551411683057707), FPR_C(0x3FD2F422DAEC0387, 0.29615088824362384),
+    FPR_C(0x3FEEADB2E8E7A88E, 0.9587034748958716), FPR_C(0x3FD233BBABC3BB71, 0.2844075372112718),
+    FPR_C(0xBFD233BBABC3BB71, -0.2844075372112718), FPR_C(0x3FEEADB2E8E7A88E, 0.9587034748958716),
+    FPR_C(0x3FDE83E0EAF85114, 0.47679923006332214), FPR_C(0x3FEC20DE3FA971B0, 0.8790122264286335),
+    FPR_C(0xBFEC20DE3FA971B0, -0.8790122264286335), FPR_C(0x3FDE83E0EAF85114, 0.47679923006332214),
+    FPR_C(0x3FE8DC45331698CC, 0.7768884656732324), FPR_C(0x3FE425FF178E6BB1, 0.629638238914927),
+    FPR_C(0xBFE425FF178E6BB1, -0.629638238914927), FPR_C(0x3FE8DC45331698CC, 0.7768884656732324),
+    FPR_C(0x3FBAA7B724495C03, 0.10412163387205457), FPR_C(0x3FEFD37914220B84, 0.9945645707342554),
+    FPR_C(0xBFEFD37914220B84, -0.9945645707342554), FPR_C(0x3FBAA7B724495C03, 0.10412163387205457),
+    FPR_C(0x3FEF6C3F7DF5BBB7, 0.9819638691095552), FPR_C(0x3FC83366E89C64C6, 0.18906866414980622),
+    FPR_C(0xBFC83366E89C64C6, -0.18906866414980622), FPR_C(0x3FEF6C3F7DF5BBB7, 0.9819638691095552),
+    FPR_C(0x3FE1F0F08BBC861B, 0.560661576197336), FPR_C(0x3FEA7F58529FE69D, 0.8280450452577558),
+    FPR_C(0xBFEA7F58529FE69D, -0.8280450452577558), FPR_C(0x3FE1F0F08BBC861B, 0.560661576197336),
+    FPR_C(0x3FEAB7325916C0D4, 0.83486287498638), FPR_C(0x3FE19D5A09F2B9B8, 0.5504579729366048),
+    FPR_C(0xBFE19D5A09F2B9B8, -0.5504579729366048), FPR_C(0x3FEAB7325916C0D4, 0.83486287498638),
+    FPR_C(0x3FC9BDCBF2DC4366, 0.2011046348420919), FPR_C(0x3FEF58A2B1789E84, 0.9795697656854405),
+    FPR_C(0xBFEF58A2B1789E84, -0.9795697656854405), FPR_C(0x3FC9BDCBF2DC4366, 0.2011046348420919),
+    FPR_C(0x3FEDA383A9668988, 0.9262102421383114), FPR_C(0x3FD820E3B04EAAC4, 0.37700741021641826),
+    FPR_C(0xBFD820E3B04EAAC4, -0.37700741021641826), FPR_C(0x3FEDA383A9668988, 0.9262102421383114),
+    FPR_C(0x3FD8DAA52EC8A4B0, 0.3883450466988263), FPR_C(0x3FED7D0B02B8ECF9, 0.9215140393420419),
+    FPR_C(0xBFED7D0B02B8ECF9, -0.9215140393420419), FPR_C(0x3FD8DAA52EC8A4B0, 0.3883450466988263),
+    FPR_C(0x3FE6C40D73C18275, 0.7114321957452164), FPR_C(0x3FE67CF78491AF10, 0.7027547444572253),
+    FPR_C(0xBFE67CF78491AF10, -0.7027547444572253), FPR_C(0x3FE6C40D73C18275, 0.7114321957452164),
+    FPR_C(0x3F7921F0FE670071, 0.006135884649154475), FPR_C(0x3FEFFFD8858E8A92, 0.9999811752826011),
+    FPR_C(0xBFEFFFD8858E8A92, -0.9999811752826011), FPR_C(0x3F7921F0FE670071, 0.006135884649154475),
+    FPR_C(0x3FEFFFF621621D02, 0.9999952938095762), FPR_C(0x3F6921F8BECCA4BA, 0.003067956762965976),
+    FPR_C(0xBF6921F8BECCA4BA, -0.003067956762965976), FPR_C(0x3FEFFFF621621D02, 0.9999952938095762),
+    FPR_C(0x3FE68ED1EAA19C71, 0.7049340803759049), FPR_C(0x3FE6B25CED2FE29C, 0.7092728264388657),
+    FPR_C(0xBFE6B25CED2FE29C, -0.7092728264388657), FPR_C(0x3FE68ED1EAA19C71, 0.7049340803759049),
+    FPR_C(0x3FED86C48445A44F, 0.9227011283338785), FPR_C(0x3FD8AC4B86D5ED44, 0.38551605384391885),
+    FPR_C(0xBFD8AC4B86D5ED44, -0.38551605384391885), FPR_C(0x3FED86C48445A44F, 0.9227011283338785),
+    FPR_C(0x3FD84F6AAAF3903F, 0.37984720892405116), FPR_C(0x3FED9A00DD8B3D46, 0.9250492407826776),
+    FPR_C(0xBFED9A00DD8B3D46, -0.9250492407826776), FPR_C(0x3FD84F6AAAF3903F, 0.37984720892405116),
+    FPR_C(0x3FEF5DA6ED43685D, 0.9801821359681174), FPR_C(0x3FC95B49E9B62AFA, 0.1980984107179536),
+    FPR_C(0xBFC95B49E9B62AFA, -0.1980984107179536), FPR_C(0x3FEF5DA6ED43685D, 0.9801821359681174),
+    FPR_C(0x3FE1B250171373BF, 0.5530167055800276), FPR_C(0x3FEAA9547A2CB98E, 0.8331701647019132),
+    FPR_C(0xBFEAA9547A2CB98E, -0.8331701647019132), FPR_C(0x3FE1B250171373BF, 0.5530167055800276),
+    FPR_C(0x3FEA8D676E545AD2, 0.829761233794523), FPR_C(0x3FE1DC1B64DC4872, 0.5581185312205561),
+    FPR_C(0xBFE1DC1B64DC4872, -0.5581185312205561), FPR_C(0x3FEA8D676E545AD2, 0.829761233794523),
+    FPR_C(0x3FC8961727C41804, 0.19208039704989244), FPR_C(0x3FEF677556883CEE, 0.9813791933137546),
+    FPR_C(0xBFEF677556883CEE, -0.9813791933137546), FPR_C(0x3FC8961727C41804, 0.19208039704989244),
+    FPR_C(0x3FEFD60D2DA75C9E, 0.9948793307948056), FPR_C(0x3FB9DFB6EB24A85C, 0.10106986275482782),
+    FPR_C(0xBFB9DFB6EB24A85C, -0.10106986275482782), FPR_C(0x3FEFD60D2DA75C9E, 0.9948793307948056),
+    FPR_C(0x3FE4397F5B2A4380, 0.6320187359398091), FPR_C(0x3FE8CC6A75184655, 0.7749531065948739),
+    FPR_C(0xBFE8CC6A75184655, -0.7749531065948739), FPR_C(0x3FE4397F5B2A4380, 0.6320187359398091),
+    FPR_C(0x3FEC2CD14931E3F1, 0.8804708890521608), FPR_C(0x3FDE57A86D3CD825, 0.47410021465055),
+    FPR_C(0xBFDE57A86D3CD825, -0.47410021465055), FPR_C(0x3FEC2CD14931E3F1, 0.8804708890521608),
+    FPR_C(0x3FD263E6995554BA, 0.2873474595447295), FPR_C(0x3FEEA68393E65800, 0.9578264130275329),
+    FPR_C(0xBFEEA68393E65800, -0.9578264130275329), FPR_C(0x3FD263E6995554BA, 0.2873474595447295),
+    FPR_C(0x3FEE97EC36016B30, 0.9560452513499964), FPR_C(0x3FD2C41A4E954520, 0.29321916269425863),
+    FPR_C(0xBFD2C41A4E954520, -0.29321916269425863), FPR_C(0x3FEE97EC36016B30, 0.9560452513499964),
+    FPR_C(0x3FDDFEFF66A941DE, 0.46868882203582796), FPR_C(0x3FEC44833141C004, 0.8833633386657316),
+    FPR_C(0xBFEC44833141C004, -0.8833633386657316), FPR_C(0x3FDDFEFF66A941DE, 0.46868882203582796),
+    FPR_C(0x3FE8AC871EDE1D88, 0.7710605242618138), FPR_C(0x3FE4605A692B32A2, 0.6367618612362842),
+    FPR_C(0xBFE4605A692B32A2, -0.6367618612362842), FPR_C(0x3FE8AC871EDE1D88, 0.7710605242618138),
+    FPR_C(0x3FB84F8712C130A1, 0.094963495329639), FPR_C(0x3FEFDAFA7514538C, 0.9954807554919269),
+    FPR_C(0xBFEFDAFA7514538C, -0.9954807554919269), FPR_C(0x3FB84F8712C130A1, 0.094963495329639),
+    FPR_C(0x3FEFF4DC54B1BED3, 0.9986402181802653), FPR_C(0x3FAAB101BD5F8317, 0.052131704680283324),
+    FPR_C(0xBFAAB101BD5F8317, -0.052131704680283324), FPR_C(0x3FEFF4DC54B1BED3, 0.9986402181802653),
+    FPR_C(0x3FE56AC35197649F, 0.6692825883466361), FPR_C(0x3FE7C6B89CE2D333, 0.7430079521351217),
+    FPR_C(0xBFE7C6B89CE2D333, -0.7430079521351217), FPR_C(0x3FE56AC35197649F, 0.6692825883466361),
+    FPR_C(0x3FECE2B32799A060, 0.9026733182372588), FPR_C(0x3FDB8A7814FD5693, 0.4303264813400826),
+    FPR_C(0xBFDB8A7814FD5693, -0.4303264813400826), FPR_C(0x3FECE2B32799A060, 0.9026733182372588),
+    FPR_C(0x3FD5604012F467B4, 0.3339996514420094), FPR_C(0x3FEE298F4439197A, 0.9425731976014469),
+    FPR_C(0xBFEE298F4439197A, -0.9425731976014469), FPR_C(0x3FD5604012F467B4, 0.3339996514420094),
+    FPR_C(0x3FEF045A14CF738C, 0.9692812353565485), FPR_C(0x3FCF7B7480BD3802, 0.24595505033579462),
+    FPR_C(0xBFCF7B7480BD3802, -0.24595505033579462), FPR_C(0x3FEF045A14CF738C, 0.9692812353565485),
+    FPR_C(0x3FE05DF3EC31B8B7, 0.5114688504379704), FPR_C(0x3FEB7F6686E792E9, 0.8593018183570084),
+    FPR_C(0xBFEB7F6686E792E9, -0.8593018183570084), FPR_C(0x3FE05DF3EC31B8B7, 0.5114688504379704),
+    FPR_C(0x3FE9A4DFA42B06B2, 0.8013761717231402), FPR_C(0x3FE32421EC49A61F, 0.5981607069963423),
+    FPR_C(0xBFE32421EC49A61F, -0.5981607069963423), FPR_C(0x3FE9A4DFA42B06B2, 0.8013761717231402),
+    FPR_C(0x3FC264994DFD3409, 0.14369503315029444), FPR_C(0x3FEFAAFBCB0CFDDC, 0.9896220174632009),
+    FPR_C(0xBFEFAAFBCB0CFDDC, -0.9896220174632009), FPR_C(0x3FC264994DFD3409, 0.14369503315029444),
+    FPR_C(0x3FEFA39BAC7A1791, 0.9887216919603238), FPR_C(0x3FC32B7BF94516A7, 0.1497645346773215),
+    FPR_C(0xBFC32B7BF94516A7, -0.1497645346773215), FPR_C(0x3FEFA39BAC7A1791, 0.9887216919603238),
+    FPR_C(0x3FE2FBC24B441015, 0.5932322950397998), FPR_C(0x3FE9C2D110F075C2, 0.8050313311429635),
+    FPR_C(0xBFE9C2D110F075C2, -0.8050313311429635), FPR_C(0x3FE2FBC24B441015, 0.5932322950397998),
+    FPR_C(0x3FEB658F14FDBC47, 0.8561473283751945), FPR_C(0x3FE089112032B08C, 0.5167317990176499),
+    FPR_C(0xBFE089112032B08C, -0.5167317990176499), FPR_C(0x3FEB658F14FDBC47, 0.8561473283751945),
+    FPR_C(0x3FCEB86B462DE348, 0.2400030224487415), FPR_C(0x3FEF1090BC898F5F, 0.9707721407289504),
+    FPR_C(0xBFEF1090BC898F5F, -0.9707721407289504), FPR_C(0x3FCEB86B462DE348, 0.2400030224487415),
+    FPR_C(0x3FEE18A02FDC66D9, 0.9405060705932683), FPR_C(0x3FD5BEE78B9DB3B6, 0.33977688440682685),
+    FPR_C(0xBFD5BEE78B9DB3B6, -0.33977688440682685), FPR_C(0x3FEE18A02FDC66D9, 0.9405060705932683),
+    FPR_C(0x3FDB2F971DB31972, 0.4247796812091088), FPR_C(0x3FECF830E8CE467B, 0.9052967593181188),
+    FPR_C(0xBFECF830E8CE467B, -0.9052967593181188), FPR_C(0x3FDB2F971DB31972, 0.4247796812091088),
+    FPR_C(0x3FE7A4F707BF97D2, 0.7388873244606151), FPR_C(0x3FE59001D5F723DF, 0.673829000378756),
+    FPR_C(0xBFE59001D5F723DF, -0.673829000378756), FPR_C(0x3FE7A4F707BF97D2, 0.7388873244606151),
+    FPR_C(0x3FA78DBAA5874686, 0.04600318213091463), FPR_C(0x3FEFF753BB1B9164, 0.9989412931868569),
+    FPR_C(0xBFEFF753BB1B9164, -0.9989412931868569), FPR_C(0x3FA78DBAA5874686, 0.04600318213091463),
+    FPR_C(0x3FEFFCE09CE2A679, 0.9996188224951786), FPR_C(0x3F9C454F4CE53B1D, 0.027608145778965743),
+    FPR_C(0xBF9C454F4CE53B1D, -0.027608145778965743), FPR_C(0x3FEFFCE09CE2A679, 0.9996188224951786),
+    FPR_C(0x3FE5FE7CBDE56A10, 0.6873153408917592), FPR_C(0x3FE73E558E079942, 0.726359155084346),
+    FPR_C(0xBFE73E558E079942, -0.726359155084346), FPR_C(0x3FE5FE7CBDE56A10, 0.6873153408917592),
+    FPR_C(0x3FED36FC7BCBFBDC, 0.9129621904283982), FPR_C(0x3FDA1D6543B50AC0, 0.4080441628649787),
+    FPR_C(0xBFDA1D6543B50AC0, -0.4080441628649787), FPR_C(0x3FED36FC7BCBFBDC, 0.9129621904283982),
+    FPR_C(0x3FD6D998638A0CB6, 0.35703096123343003), FPR_C(0x3FEDE4160F6D8D81, 0.9340925504042589),
+    FPR_C(0xBFEDE4160F6D8D81, -0.9340925504042589), FPR_C(0x3FD6D998638A0CB6, 0.35703096123343003),
+    FPR_C(0x3FEF33685A3AAEF0, 0.9750253450669941), FPR_C(0x3FCC6D90535D74DD, 0.22209362097320354),
+    FPR_C(0xBFCC6D90535D74DD, -0.22209362097320354), FPR_C(0x3FEF33685A3AAEF0, 0.9750253450669941),
+    FPR_C(0x3FE1097248D0A957, 0.532403127877198), FPR_C(0x3FEB16742A4CA2F5, 0.8464909387740521),
+    FPR_C(0xBFEB16742A4CA2F5, -0.8464909387740521), FPR_C(0x3FE1097248D0A957, 0.532403127877198),
+    FPR_C(0x3FEA1B26D2C0A75E, 0.8158144108067338), FPR_C(0x3FE2818BEF4D3CBA, 0.5783137964116556),
+    FPR_C(0xBFE2818BEF4D3CBA, -0.5783137964116556), FPR_C(0x3FEA1B26D2C0A75E, 0.8158144108067338),
+    FPR_C(0x3FC57F008654CBDE, 0.16793829497473117), FPR_C(0x3FEF8BA737CB4B78, 0.9857975091675675),
+    FPR_C(0xBFEF8BA737CB4B78, -0.9857975091675675), FPR_C(0x3FC57F008654CBDE, 0.16793829497473117),
+    FPR_C(0x3FEFBF470F0A8D88, 0.9920993131421918), FPR_C(0x3FC00EE8AD6FB85B, 0.12545498341154623),
+    FPR_C(0xBFC00EE8AD6FB85B, -0.12545498341154623), FPR_C(0x3FEFBF470F0A8D88, 0.9920993131421918),
+    FPR_C(0x3FE39C23E3D63029, 0.6128100824294097), FPR_C(0x3FE94990E3AC4A6C, 0.79023022143731),
+    FPR_C(0xBFE94990E3AC4A6C, -0.79023022143731), FPR_C(0x3FE39C23E3D63029, 0.6128100824294097),
+    FPR_C(0x3FEBCB54CB0D2327, 0.8685707059713409), FPR_C(0x3FDFB7575C24D2DE, 0.49556526182577254),
+    FPR_C(0xBFDFB7575C24D2DE, -0.49556526182577254), FPR_C(0x3FEBCB54CB0D2327, 0.8685707059713409),
+    FPR_C(0x3FD0E15B4E1749CE, 0.2637546789748314), FPR_C(0x3FEEDDEB6A078651, 0.9645897932898128),
+    FPR_C(0xBFEEDDEB6A078651, -0.9645897932898128), FPR_C(0x3FD0E15B4E1749CE, 0.2637546789748314),
+    FPR_C(0x3FEE5A9D550467D3, 0.9485613499157303), FPR_C(0x3FD44310DC8936F0, 0.31659337555616585),
+    FPR_C(0xBFD44310DC8936F0, -0.31659337555616585), FPR_C(0x3FEE5A9D550467D3, 0.9485613499157303),
+    FPR_C(0x3FDC997FC3865389, 0.4468688401623742), FPR_C(0x3FECA08F19B9C449, 0.8945994856313827),
+    FPR_C(0xBFECA08F19B9C449, -0.8945994856313827), FPR_C(0x3FDC997FC3865389, 0.4468688401623742),
+    FPR_C(0x3FE82A9C13F545FF, 0.7552013768965365), FPR_C(0x3FE4F9CC25CCA486, 0.6554928529996153),
+    FPR_C(0xBFE4F9CC25CCA486, -0.6554928529996153), FPR_C(0x3FE82A9C13F545FF, 0.7552013768965365),
+    FPR_C(0x3FB20C9674ED444D, 0.07050457338961387), FPR_C(0x3FEFEB9D2530410F, 0.9975114561403035),
+    FPR_C(0xBFEFEB9D2530410F, -0.9975114561403035), FPR_C(0x3FB20C9674ED444D, 0.07050457338961387),
+    FPR_C(0x3FEFE7EA85482D60, 0.997060070339483), FPR_C(0x3FB39D9F12C5A299, 0.07662386139203149),
+    FPR_C(0xBFB39D9F12C5A299, -0.07662386139203149), FPR_C(0x3FEFE7EA85482D60, 0.997060070339483),
+    FPR_C(0x3FE4D3BC6D589F7F, 0.6508466849963809), FPR_C(0x3FE84B7111AF83FA, 0.7592091889783881),
+    FPR_C(0xBFE84B7111AF83FA, -0.7592091889783881), FPR_C(0x3FE4D3BC6D589F7F, 0.6508466849963809),
+    FPR_C(0x3FEC89F587029C13, 0.8918407093923427), FPR_C(0x3FDCF34BAEE1CD21, 0.4523495872337709),
+    FPR_C(0xBFDCF34BAEE1CD21, -0.4523495872337709), FPR_C(0x3FEC89F587029C13, 0.8918407093923427),
+    FPR_C(0x3FD3E39BE96EC271, 0.3107671527496115), FPR_C(0x3FEE6A61C55D53A7, 0.9504860739494817),
+    FPR_C(0xBFEE6A61C55D53A7, -0.9504860739494817), FPR_C(0x3FD3E39BE96EC271, 0.3107671527496115),
+    FPR_C(0x3FEED0835E999009, 0.9629532668736839), FPR_C(0x3FD1423EEFC69378, 0.2696683255729151),
+    FPR_C(0xBFD1423EEFC69378, -0.2696683255729151), FPR_C(0x3FEED0835E999009, 0.9629532668736839),
+    FPR_C(0x3FDF5FDEE656CDA3, 0.49022648328829116), FPR_C(0x3FEBE41B611154C1, 0.8715950866559511),
+    FPR_C(0xBFEBE41B611154C1, -0.8715950866559511), FPR_C(0x3FDF5FDEE656CDA3, 0.49022648328829116),
+    FPR_C(0x3FE92AA41FC5A815, 0.7864552135990858), FPR_C(0x3FE3C3C44981C518, 0.617647307937804),
+    FPR_C(0xBFE3C3C44981C518, -0.617647307937804), FPR_C(0x3FE92AA41FC5A815, 0.7864552135990858),
+    FPR_C(0x3FBE8EB7FDE4AA3F, 0.11936521481099137), FPR_C(0x3FEFC56E3B7D9AF6, 0.9928504144598651),
+    FPR_C(0xBFEFC56E3B7D9AF6, -0.9928504144598651), FPR_C(0x3FBE8EB7FDE4AA3F, 0.11936521481099137),
+    FPR_C(0x3FEF830F4A40C60C, 0.9847485018019042), FPR_C(0x3FC6451A831D830D, 0.17398387338746382),
+    FPR_C(0xBFC6451A831D830D, -0.17398387338746382), FPR_C(0x3FEF830F4A40C60C, 0.9847485018019042),
+    FPR_C(0x3FE258734CBB7110, 0.5732971666980422), FPR_C(0x3FEA38184A593BC6, 0.819347520076797),
+    FPR_C(0xBFEA38184A593BC6, -0.819347520076797), FPR_C(0x3FE258734CBB7110, 0.5732971666980422),
+    FPR_C(0x3FEAFB8FD89F57B6, 0.8432082396418454), FPR_C(0x3FE133E9CFEE254F, 0.5375870762956455),
+    FPR_C(0xBFE133E9CFEE254F, -0.5375870762956455), FPR_C(0x3FEAFB8FD89F57B6, 0.8432082396418454),
+    FPR_C(0x3FCBA96334F15DAD, 0.21610679707621952), FPR_C(0x3FEF3E6BBC1BBC65, 0.9763697313300211),
+    FPR_C(0xBFEF3E6BBC1BBC65, -0.9763697313300211), FPR_C(0x3FCBA96334F15DAD, 0.21610679707621952),
+    FPR_C(0x3FEDD1FEF38A915A, 0.9318842655816681), FPR_C(0x3FD73763C9261092, 0.3627557243673972),
+    FPR_C(0xBFD73763C9261092, -0.3627557243673972), FPR_C(0x3FEDD1FEF38A915A, 0.9318842655816681),
+    FPR_C(0x3FD9C17D440DF9F2, 0.40243465085941843), FPR_C(0x3FED4B5B1B187524, 0.9154487160882678),
+    FPR_C(0xBFED4B5B1B187524, -0.9154487160882678), FPR_C(0x3FD9C17D440DF9F2, 0.40243465085941843),
+    FPR_C(0x3FE71BAC960E41BF, 0.7221281939292153), FPR_C(0x3FE622E44FEC22FF, 0.6917592583641577),
+    FPR_C(0xBFE622E44FEC22FF, -0.6917592583641577), FPR_C(0x3FE71BAC960E41BF, 0.7221281939292153),
+    FPR_C(0x3F95FD4D21FAB226, 0.021474080275469508), FPR_C(0x3FEFFE1C6870CB77, 0.9997694053512153),
+    FPR_C(0xBFEFFE1C6870CB77, -0.9997694053512153), FPR_C(0x3F95FD4D21FAB226, 0.021474080275469508),
+    FPR_C(0x3FEFFF0943C53BD1, 0.9998823474542126), FPR_C(0x3F8F6A296AB997CB, 0.015339206284988102),
+    FPR_C(0xBF8F6A296AB997CB, -0.015339206284988102), FPR_C(0x3FEFFF0943C53BD1, 0.9998823474542126),
+    FPR_C(0x3FE64715437F535B, 0.696177131491463), FPR_C(0x3FE6F8CA99C95B75, 0.7178700450557317),
+    FPR_C(0xBFE6F8CA99C95B75, -0.7178700450557317), FPR_C(0x3FE64715437F535B, 0.696177131491463),
+    FPR_C(0x3FED5F7172888A7F, 0.9179007756213905), FPR_C(0x3FD96555B7AB948F, 0.3968099874167103),
+    FPR_C(0xBFD96555B7AB948F, -0.3968099874167103), FPR_C(0x3FED5F7172888A7F, 0.9179007756213905),
+    FPR_C(0x3FD794F5E613DFAE, 0.3684668299533723), FPR_C(0x3FEDBF9E4395759A, 0.9296408958431812),
+    FPR_C(0xBFEDBF9E4395759A, -0.9296408958431812), FPR_C(0x3FD794F5E613DFAE, 0.3684668299533723),
+    FPR_C(0x3FEF492206BCABB4, 0.9776773578245099), FPR_C(0x3FCAE4F1D5F3B9AB, 0.2101118368804696),
+    FPR_C(0xBFCAE4F1D5F3B9AB, -0.2101118368804696), FPR_C(0x3FEF492206BCABB4, 0.9776773578245099),
+    FPR_C(0x3FE15E36E4DBE2BC, 0.5427507848645159), FPR_C(0x3FEAE068F345ECEF, 0.8398937941959995),
+    FPR_C(0xBFEAE068F345ECEF, -0.8398937941959995), FPR_C(0x3FE15E36E4DBE2BC, 0.5427507848645159),
+    FPR_C(0x3FEA54C91090F523, 0.8228497813758263), FPR_C(0x3FE22F2D662C13E2, 0.5682589526701316),
+    FPR_C(0xBFE22F2D662C13E2, -0.5682589526701316), FPR_C(0x3FEA54C91090F523, 0.8228497813758263),
+    FPR_C(0x3FC70AFD8D08C4FF, 0.18002290140569951), FPR_C(0x3FEF7A299C1A322A, 0.9836624192117303),
+    FPR_C(0xBFEF7A299C1A322A, -0.9836624192117303), FPR_C(0x3FC70AFD8D08C4FF, 0.18002290140569951),
+    FPR_C(0x3FEFCB4703914354, 0.9935641355205953), FPR_C(0x3FBCFF533B307DC1, 0.11327095217756435),
+    FPR_C(0xBFBCFF533B307DC1, -0.11327095217756435), FPR_C(0x3FEFCB4703914354, 0.9935641355205953),
+    FPR_C(0x3FE3EB33EABE0680, 0.62246127937415), FPR_C(0x3FE90B7943575EFE, 0.7826505961665757),
+    FPR_C(0xBFE90B7943575EFE, -0.7826505961665757), FPR_C(0x3FE3EB33EABE0680, 0.62246127937415),
+    FPR_C(0x3FEBFC9D25A1B147, 0.8745866522781761), FPR_C(0x3FDF081906BFF7FE, 0.4848692480007911),
+    FPR_C(0xBFDF081906BFF7FE, -0.4848692480007911), FPR_C(0x3FEBFC9D25A1B147, 0.8745866522781761),
+    FPR_C(0x3FD1A2F7FBE8F243, 0.27557181931095814), FPR_C(0x3FEEC2CF4B1AF6B2, 0.9612804858113206),
+    FPR_C(0xBFEEC2CF4B1AF6B2, -0.9612804858113206), FPR_C(0x3FD1A2F7FBE8F243, 0.27557181931095814),
+    FPR_C(0x3FEE79DB29A5165A, 0.9523750127197659), FPR_C(0x3FD383F5E353B6AB, 0.30492922973540243),
+    FPR_C(0xBFD383F5E353B6AB, -0.30492922973540243), FPR_C(0x3FEE79DB29A5165A, 0.9523750127197659),
+    FPR_C(0x3FDD4CD02BA8609D, 0.45781330359887723), FPR_C(0x3FEC7315899EAAD7, 0.8890483558546646),
+    FPR_C(0xBFEC7315899EAAD7, -0.8890483558546646), FPR_C(0x3FDD4CD02BA8609D, 0.45781330359887723),
+    FPR_C(0x3FE86C0A1D9AA195, 0.7631884172633813), FPR_C(0x3FE4AD79516722F1, 0.6461760129833164),
+    FPR_C(0xBFE4AD79516722F1, -0.6461760129833164), FPR_C(0x3FE86C0A1D9AA195, 0.7631884172633813),
+    FPR_C(0x3FB52E774A4D4D0A, 0.08274026454937569), FPR_C(0x3FEFE3E92BE9D886, 0.9965711457905548),
+    FPR_C(0xBFEFE3E92BE9D886, -0.9965711457905548), FPR_C(0x3FB52E774A4D4D0A, 0.08274026454937569),
+    FPR_C(0x3FEFEF0102826191, 0.997925286198596), FPR_C(0x3FB07B614E463064, 0.06438263092985747),
+    FPR_C(0xBFB07B614E463064, -0.06438263092985747), FPR_C(0x3FEFEF0102826191, 0.997925286198596),
+    FPR_C(0x3FE51FA81CD99AA6, 0.6601143420674205), FPR_C(0x3FE8098B756E52FA, 0.7511651319096864),
+    FPR_C(0xBFE8098B756E52FA, -0.7511651319096864), FPR_C(0x3FE51FA81CD99AA6, 0.6601143420674205),
+    FPR_C(0x3FECB6E20A00DA99, 0.8973245807054183), FPR_C(0x3FDC3F6D47263129, 0.44137126873171667),
+    FPR_C(0xBFDC3F6D47263129, -0.44137126873171667), FPR_C(0x3FECB6E20A00DA99, 0.8973245807054183),
+    FPR_C(0x3FD4A253D11B82F3, 0.32240767880106985), FPR_C(0x3FEE4A8DFF81CE5E, 0.9466009130832835),
+    FPR_C(0xBFEE4A8DFF81CE5E, -0.9466009130832835), FPR_C(0x3FD4A253D11B82F3, 0.32240767880106985),
+    FPR_C(0x3FEEEB074C50A544, 0.9661900034454125), FPR_C(0x3FD0804E05EB661E, 0.257831102162159),
+    FPR_C(0xBFD0804E05EB661E, -0.257831102162159), FPR_C(0x3FEEEB074C50A544, 0.9661900034454125),
+    FPR_C(0x3FE00740C82B82E1, 0.5008853826112408), FPR_C(0x3FEBB249A0B6C40D, 0.8655136240905691),
+    FPR_C(0xBFEBB249A0B6C40D, -0.8655136240905691), FPR_C(0x3FE00740C82B82E1, 0.5008853826112408),
+    FPR_C(0x3FE9683F42BD7FE1, 0.7939754775543372), FPR_C(0x3FE374531B817F8D, 0.6079497849677736),
+    FPR_C(0xBFE374531B817F8D, -0.6079497849677736), FPR_C(0x3FE9683F42BD7FE1, 0.7939754775543372),
+    FPR_C(0x3FC0D64DBCB26786, 0.13154002870288312), FPR_C(0x3FEFB8D18D66ADB7, 0.9913108598461154),
+    FPR_C(0xBFEFB8D18D66ADB7, -0.9913108598461154), FPR_C(0x3FC0D64DBCB26786, 0.13154002870288312),
+    FPR_C(0x3FEF93F14F85AC08, 0.9868094018141855), FPR_C(0x3FC4B8B17F79FA88, 0.16188639378011183),
+    FPR_C(0xBFC4B8B17F79FA88, -0.16188639378011183), FPR_C(0x3FEF93F14F85AC08, 0.9868094018141855),
+    FPR_C(0x3FE2AA76E87AEB58, 0.5833086529376983), FPR_C(0x3FE9FDF4F13149DE, 0.8122505865852039),
+    FPR_C(0xBFE9FDF4F13149DE, -0.8122505865852039), FPR_C(0x3FE2AA76E87AEB58, 0.5833086529376983),
+    FPR_C(0x3FEB3115A5F37BF3, 0.8497417680008524), FPR_C(0x3FE0DED0B84BC4B6, 0.5271991347819014),
+    FPR_C(0xBFE0DED0B84BC4B6, -0.5271991347819014), FPR_C(0x3FEB3115A5F37BF3, 0.8497417680008524),
+    FPR_C(0x3FCD31774D2CBDEE, 0.22807208317088573), FPR_C(0x3FEF2817FC4609CE, 0.973644249650812),
+    FPR_C(0xBFEF2817FC4609CE, -0.973644249650812), FPR_C(0x3FCD31774D2CBDEE, 0.22807208317088573),
+    FPR_C(0x3FEDF5E36A9BA59C, 0.9362656671702783), FPR_C(0x3FD67B949CAD63CB, 0.35129275608556715),
+    FPR_C(0xBFD67B949CAD63CB, -0.35129275608556715), FPR_C(0x3FEDF5E36A9BA59C, 0.9362656671702783),
+    FPR_C(0x3FDA790CD3DBF31B, 0.41363831223843456), FPR_C(0x3FED2255C6E5A4E1, 0.9104412922580672),
+    FPR_C(0xBFED2255C6E5A4E1, -0.9104412922580672), FPR_C(0x3FDA790CD3DBF31B, 0.41363831223843456),
+    FPR_C(0x3FE760C52C304764, 0.7305627692278276), FPR_C(0x3FE5D9DEE73E345C, 0.6828455463852481),
+    FPR_C(0xBFE5D9DEE73E345C, -0.6828455463852481), FPR_C(0x3FE760C52C304764, 0.7305627692278276),
+    FPR_C(0x3FA14685DB42C17F, 0.03374117185137759), FPR_C(0x3FEFFB55E425FDAE, 0.9994306045554617),
+    FPR_C(0xBFEFFB55E425FDAE, -0.9994306045554617), FPR_C(0x3FA14685DB42C17F, 0.03374117185137759),
+    FPR_C(0x3FEFF97C4208C014, 0.9992047586183639), FPR_C(0x3FA46A396FF86179, 0.03987292758773981),
+    FPR_C(0xBFA46A396FF86179, -0.03987292758773981), FPR_C(0x3FEFF97C4208C014, 0.9992047586183639),
+    FPR_C(0x3FE5B50B264F7448, 0.6783500431298615), FPR_C(0x3FE782FB1B90B35B, 0.7347388780959635),
+    FPR_C(0xBFE782FB1B90B35B, -0.7347388780959635), FPR_C(0x3FE5B50B264F7448, 0.6783500431298615),
+    FPR_C(0x3FED0D672F59D2B9, 0.9078861164876663), FPR_C(0x3FDAD473125CDC09, 0.41921688836322396),
+    FPR_C(0xBFDAD473125CDC09, -0.41921688836322396), FPR_C(0x3FED0D672F59D2B9, 0.9078861164876663),
+    FPR_C(0x3FD61D595C88C202, 0.34554132496398904), FPR_C(0x3FEE0766D9280F54, 0.9384035340631081),
+    FPR_C(0xBFEE0766D9280F54, -0.9384035340631081), FPR_C(0x3FD61D595C88C202, 0.34554132496398904),
+    FPR_C(0x3FEF1C7ABE284708, 0.9722264970789363), FPR_C(0x3FCDF5163F01099A, 0.23404195858354343),
+    FPR_C(0xBFCDF5163F01099A, -0.23404195858354343), FPR_C(0x3FEF1C7ABE284708, 0.9722264970789363),
+    FPR_C(0x3FE0B405878F85EC, 0.5219752929371544), FPR_C(0x3FEB4B7409DE7925, 0.8529606049303636),
+    FPR_C(0xBFEB4B7409DE7925, -0.8529606049303636), FPR_C(0x3FE0B405878F85EC, 0.5219752929371544),
+    FPR_C(0x3FE9E082EDB42472, 0.808656181588175), FPR_C(0x3FE2D333D34E9BB8, 0.5882815482226453),
+    FPR_C(0xBFE2D333D34E9BB8, -0.5882815482226453), FPR_C(0x3FE9E082EDB42472, 0.808656181588175),
+    FPR_C(0x3FC3F22F57DB4893, 0.15582839765426523), FPR_C(0x3FEF9BED7CFBDE29, 0.9877841416445722),
+    FPR_C(0xBFEF9BED7CFBDE29, -0.9877841416445722), FPR_C(0x3FC3F22F57DB4893, 0.15582839765426523),
+    FPR_C(0x3FEFB20DC681D54D, 0.9904850842564571), FPR_C(0x3FC19D8940BE24E7, 0.13762012158648604),
+    FPR_C(0xBFC19D8940BE24E7, -0.13762012158648604), FPR_C(0x3FEFB20DC681D54D, 0.9904850842564571),
+    FPR_C(0x3FE34C5252C14DE1, 0.6030665985403482), FPR_C(0x3FE986AEF1457594, 0.7976908409433912),
+    FPR_C(0xBFE986AEF1457594, -0.7976908409433912), FPR_C(0x3FE34C5252C14DE1, 0.6030665985403482),
+    FPR_C(0x3FEB98FA1FD9155E, 0.8624239561110405), FPR_C(0x3FE032AE55EDBD96, 0.5061866453451553),
+    FPR_C(0xBFE032AE55EDBD96, -0.5061866453451553), FPR_C(0x3FEB98FA1FD9155E, 0.8624239561110405),
+    FPR_C(0x3FD01F1806B9FDD2, 0.25189781815421697), FPR_C(0x3FEEF7D6E51CA3C0, 0.9677538370934755),
+    FPR_C(0xBFEEF7D6E51CA3C0, -0.9677538370934755), FPR_C(0x3FD01F1806B9FDD2, 0.25189781815421697),
+    FPR_C(0x3FEE3A33EC75CE85, 0.9446048372614803), FPR_C(0x3FD50163DC197048, 0.32820984357909255),
+    FPR_C(0xBFD50163DC197048, -0.32820984357909255), FPR_C(0x3FEE3A33EC75CE85, 0.9446048372614803),
+    FPR_C(0x3FDBE51517FFC0D9, 0.4358570799222555), FPR_C(0x3FECCCEE20C2DEA0, 0.9000158920161603),
+    FPR_C(0xBFECCCEE20C2DEA0, -0.9000158920161603), FPR_C(0x3FDBE51517FFC0D9, 0.4358570799222555),
+    FPR_C(0x3FE7E83F87B03686, 0.7471006059801801), FPR_C(0x3FE5454FF5159DFC, 0.6647109782033449),
+    FPR_C(0xBFE5454FF5159DFC, -0.6647109782033449), FPR_C(0x3FE7E83F87B03686, 0.7471006059801801),
+    FPR_C(0x3FADD406F9808EC9, 0.05825826450043576), FPR_C(0x3FEFF21614E131ED, 0.9983015449338929),
+    FPR_C(0xBFEFF21614E131ED, -0.9983015449338929), FPR_C(0x3FADD406F9808EC9, 0.05825826450043576),
+    FPR_C(0x3FEFDF9922F73307, 0.996044700901252), FPR_C(0x3FB6BF1B3E79B129, 0.0888535525825246),
+    FPR_C(0xBFB6BF1B3E79B129, -0.0888535525825246), FPR_C(0x3FEFDF9922F73307, 0.996044700901252),
+    FPR_C(0x3FE48703306091FF, 0.6414810128085832), FPR_C(0x3FE88C66E7481BA1, 0.7671389119358204),
+    FPR_C(0xBFE88C66E7481BA1, -0.7671389119358204), FPR_C(0x3FE48703306091FF, 0.6414810128085832),
+    FPR_C(0x3FEC5BEF59FEF85A, 0.8862225301488806), FPR_C(0x3FDDA60C5CFA10D9, 0.4632597835518602),
+    FPR_C(0xBFDDA60C5CFA10D9, -0.4632597835518602), FPR_C(0x3FEC5BEF59FEF85A, 0.8862225301488806),
+    FPR_C(0x3FD3241FB638BAAF, 0.2990798263080405), FPR_C(0x3FEE89095BAD6025, 0.9542280951091057),
+    FPR_C(0xBFEE89095BAD6025, -0.9542280951091057), FPR_C(0x3FD3241FB638BAAF, 0.2990798263080405),
+    FPR_C(0x3FEEB4CF515B8811, 0.9595715130819845), FPR_C(0x3FD2038583D727BE, 0.281464937925758),
+    FPR_C(0xBFD2038583D727BE, -0.281464937925758), FPR_C(0x3FEEB4CF515B8811, 0.9595715130819845),
+    FPR_C(0x3FDEB00695F25620, 0.479493757660153), FPR_C(0x3FEC14D9DC465E57, 0.8775452902072612),
+    FPR_C(0xBFEC14D9DC465E57, -0.8775452902072612), FPR_C(0x3FDEB00695F25620, 0.479493757660153),
+    FPR_C(0x3FE8EC109B486C49, 0.778816512381476), FPR_C(0x3FE41272663D108C, 0.6272518154951441),
+    FPR_C(0xBFE41272663D108C, -0.6272518154951441), FPR_C(0x3FE8EC109B486C49, 0.778816512381476),
+    FPR_C(0x3FBB6FA6EC38F64C, 0.10717242495680884), FPR_C(0x3FEFD0D158D86087, 0.9942404494531879),
+    FPR_C(0xBFEFD0D158D86087, -0.9942404494531879), FPR_C(0x3FBB6FA6EC38F64C, 0.10717242495680884),
+    FPR_C(0x3FEF70F6434B7EB7, 0.9825393022874412), FPR_C(0x3FC7D0A7BBD2CB1C, 0.18605515166344666),
+    FPR_C(0xBFC7D0A7BBD2CB1C, -0.18605515166344666), FPR_C(0x3FEF70F6434B7EB7, 0.9825393022874412),
+    FPR_C(0x3FE205BAA17560D6, 0.5631993440138341), FPR_C(0x3FEA7138DE9D60F5, 0.8263210628456635),
+    FPR_C(0xBFEA7138DE9D60F5, -0.8263210628456635), FPR_C(0x3FE205BAA17560D6, 0.5631993440138341),
+    FPR_C(0x3FEAC4FFBD3EFAC8, 0.836547727223512), FPR_C(0x3FE188591F3A46E5, 0.5478940591731002),
+    FPR_C(0xBFE188591F3A46E5, -0.5478940591731002), FPR_C(0x3FEAC4FFBD3EFAC8, 0.836547727223512),
+    FPR_C(0x3FCA203E1B1831DA, 0.20410896609281687), FPR_C(0x3FEF538B1FAF2D07, 0.9789481753190622),
+    FPR_C(0xBFEF538B1FAF2D07, -0.9789481753190622), FPR_C(0x3FCA203E1B1831DA, 0.20410896609281687),
+    FPR_C(0x3FEDACF42CE68AB9, 0.9273625256504011), FPR_C(0x3FD7F24DD37341E4, 0.374164062971458),
+    FPR_C(0xBFD7F24DD37341E4, -0.374164062971458), FPR_C(0x3FEDACF42CE68AB9, 0.9273625256504011),
+    FPR_C(0x3FD908EF81EF7BD1, 0.39117038430225387), FPR_C(0x3FED733F508C0DFF, 0.9203182767091106),
+    FPR_C(0xBFED733F508C0DFF, -0.9203182767091106), FPR_C(0x3FD908EF81EF7BD1, 0.39117038430225387),
+    FPR_C(0x3FE6D5AFEF4AAFCD, 0.7135848687807936), FPR_C(0x3FE66B0F3F52B386, 0.7005687939432483),
+    FPR_C(0xBFE66B0F3F52B386, -0.7005687939432483), FPR_C(0x3FE6D5AFEF4AAFCD, 0.7135848687807936),
+    FPR_C(0x3F82D96B0E509703, 0.00920375478205982), FPR_C(0x3FEFFFA72C978C4F, 0.9999576445519639),
+    FPR_C(0xBFEFFFA72C978C4F, -0.9999576445519639), FPR_C(0x3F82D96B0E509703, 0.00920375478205982),
+    FPR_C(0x3FEFFFA72C978C4F, 0.9999576445519639), FPR_C(0x3F82D96B0E509703, 0.00920375478205982),
+    FPR_C(0xBF82D96B0E509703, -0.00920375478205982), FPR_C(0x3FEFFFA72C978C4F, 0.9999576445519639),
+    FPR_C(0x3FE66B0F3F52B386, 0.7005687939432483), FPR_C(0x3FE6D5AFEF4AAFCD, 0.7135848687807936),
+    FPR_C(0xBFE6D5AFEF4AAFCD, -0.7135848687807936), FPR_C(0x3FE66B0F3F52B386, 0.7005687939432483),
+    FPR_C(0x3FED733F508C0DFF, 0.9203182767091106), FPR_C(0x3FD908EF81EF7BD1, 0.39117038430225387),
+    FPR_C(0xBFD908EF81EF7BD1, -0.39117038430225387), FPR_C(0x3FED733F508C0DFF, 0.9203182767091106),
+    FPR_C(0x3FD7F24DD37341E4, 0.374164062971458), FPR_C(0x3FEDACF42CE68AB9, 0.9273625256504011),
+    FPR_C(0xBFEDACF42CE68AB9, -0.9273625256504011), FPR_C(0x3FD7F24DD37341E4, 0.374164062971458),
+    FPR_C(0x3FEF538B1FAF2D07, 0.9789481753190622), FPR_C(0x3FCA203E1B1831DA, 0.20410896609281687),
+    FPR_C(0xBFCA203E1B1831DA, -0.20410896609281687), FPR_C(0x3FEF538B1FAF2D07, 0.9789481753190622),
+    FPR_C(0x3FE188591F3A46E5, 0.5478940591731002), FPR_C(0x3FEAC4FFBD3EFAC8, 0.836547727223512),
+    FPR_C(0xBFEAC4FFBD3EFAC8, -0.836547727223512), FPR_C(0x3FE188591F3A46E5, 0.5478940591731002),
+    FPR_C(0x3FEA7138DE9D60F5, 0.8263210628456635), FPR_C(0x3FE205BAA17560D6, 0.5631993440138341),
+    FPR_C(0xBFE205BAA17560D6, -0.5631993440138341), FPR_C(0x3FEA7138DE9D60F5, 0.8263210628456635),
+    FPR_C(0x3FC7D0A7BBD2CB1C, 0.18605515166344666), FPR_C(0x3FEF70F6434B7EB7, 0.9825393022874412),
+    FPR_C(0xBFEF70F6434B7EB7, -0.9825393022874412), FPR_C(0x3FC7D0A7BBD2CB1C, 0.18605515166344666),
+    FPR_C(0x3FEFD0D158D86087, 0.9942404494531879), FPR_C(0x3FBB6FA6EC38F64C, 0.10717242495680884),
+    FPR_C(0xBFBB6FA6EC38F64C, -0.10717242495680884), FPR_C(0x3FEFD0D158D86087, 0.9942404494531879),
+    FPR_C(0x3FE41272663D108C, 0.6272518154951441), FPR_C(0x3FE8EC109B486C49, 0.778816512381476),
+    FPR_C(0xBFE8EC109B486C49, -0.778816512381476), FPR_C(0x3FE41272663D108C, 0.6272518154951441),
+    FPR_C(0x3FEC14D9DC465E57, 0.8775452902072612), FPR_C(0x3FDEB00695F25620, 0.479493757660153),
+    FPR_C(0xBFDEB00695F25620, -0.479493757660153), FPR_C(0x3FEC14D9DC465E57, 0.8775452902072612),
+    FPR_C(0x3FD2038583D727BE, 0.281464937925758), FPR_C(0x3FEEB4CF515B8811, 0.9595715130819845),
+    FPR_C(0xBFEEB4CF515B8811, -0.9595715130819845), FPR_C(0x3FD2038583D727BE, 0.281464937925758),
+    FPR_C(0x3FEE89095BAD6025, 0.9542280951091057), FPR_C(0x3FD3241FB638BAAF, 0.2990798263080405),
+    FPR_C(0xBFD3241FB638BAAF, -0.2990798263080405), FPR_C(0x3FEE89095BAD6025, 0.9542280951091057),
+    FPR_C(0x3FDDA60C5CFA10D9, 0.4632597835518602), FPR_C(0x3FEC5BEF59FEF85A, 0.8862225301488806),
+    FPR_C(0xBFEC5BEF59FEF85A, -0.8862225301488806), FPR_C(0x3FDDA60C5CFA10D9, 0.4632597835518602),
+    FPR_C(0x3FE88C66E7481BA1, 0.7671389119358204), FPR_C(0x3FE48703306091FF, 0.6414810128085832),
+    FPR_C(0xBFE48703306091FF, -0.6414810128085832), FPR_C(0x3FE88C66E7481BA1, 0.7671389119358204),
+    FPR_C(0x3FB6BF1B3E79B129, 0.0888535525825246), FPR_C(0x3FEFDF9922F73307, 0.996044700901252),
+    FPR_C(0xBFEFDF9922F73307, -0.996044700901252), FPR_C(0x3FB6BF1B3E79B129, 0.0888535525825246),
+    FPR_C(0x3FEFF21614E131ED, 0.9983015449338929), FPR_C(0x3FADD406F9808EC9, 0.05825826450043576),
+    FPR_C(0xBFADD406F9808EC9, -0.05825826450043576), FPR_C(0x3FEFF21614E131ED, 0.9983015449338929),
+    FPR_C(0x3FE5454FF5159DFC, 0.6647109782033449), FPR_C(0x3FE7E83F87B03686, 0.7471006059801801),
+    FPR_C(0xBFE7E83F87B03686, -0.7471006059801801), FPR_C(0x3FE5454FF5159DFC, 0.6647109782033449),
+    FPR_C(0x3FECCCEE20C2DEA0, 0.9000158920161603), FPR_C(0x3FDBE51517FFC0D9, 0.4358570799222555),
+    FPR_C(0xBFDBE51517FFC0D9, -0.4358570799222555), FPR_C(0x3FECCCEE20C2DEA0, 0.9000158920161603),
+    FPR_C(0x3FD50163DC197048, 0.32820984357909255), FPR_C(0x3FEE3A33EC75CE85, 0.9446048372614803),
+    FPR_C(0xBFEE3A33EC75CE85, -0.9446048372614803), FPR_C(0x3FD50163DC197048, 0.32820984357909255),
+    FPR_C(0x3FEEF7D6E51CA3C0, 0.9677538370934755), FPR_C(0x3FD01F1806B9FDD2, 0.25189781815421697),
+    FPR_C(0xBFD01F1806B9FDD2, -0.25189781815421697), FPR_C(0x3FEEF7D6E51CA3C0, 0.9677538370934755),
+    FPR_C(0x3FE032AE55EDBD96, 0.5061866453451553), FPR_C(0x3FEB98FA1FD9155E, 0.8624239561110405),
+    FPR_C(0xBFEB98FA1FD9155E, -0.8624239561110405), FPR_C(0x3FE032AE55EDBD96, 0.5061866453451553),
+    FPR_C(0x3FE986AEF1457594, 0.7976908409433912), FPR_C(0x3FE34C5252C14DE1, 0.6030665985403482),
+    FPR_C(0xBFE34C5252C14DE1, -0.6030665985403482), FPR_C(0x3FE986AEF1457594, 0.7976908409433912),
+    FPR_C(0x3FC19D8940BE24E7, 0.13762012158648604), FPR_C(0x3FEFB20DC681D54D, 0.9904850842564571),
+    FPR_C(0xBFEFB20DC681D54D, -0.9904850842564571), FPR_C(0x3FC19D8940BE24E7, 0.13762012158648604),
+    FPR_C(0x3FEF9BED7CFBDE29, 0.9877841416445722), FPR_C(0x3FC3F22F57DB4893, 0.15582839765426523),
+    FPR_C(0xBFC3F22F57DB4893, -0.15582839765426523), FPR_C(0x3FEF9BED7CFBDE29, 0.9877841416445722),
+    FPR_C(0x3FE2D333D34E9BB8, 0.5882815482226453), FPR_C(0x3FE9E082EDB42472, 0.808656181588175),
+    FPR_C(0xBFE9E082EDB42472, -0.808656181588175), FPR_C(0x3FE2D333D34E9BB8, 0.5882815482226453),
+    FPR_C(0x3FEB4B7409DE7925, 0.8529606049303636), FPR_C(0x3FE0B405878F85EC, 0.5219752929371544),
+    FPR_C(0xBFE0B405878F85EC, -0.5219752929371544), FPR_C(0x3FEB4B7409DE7925, 0.8529606049303636),
+    FPR_C(0x3FCDF5163F01099A, 0.23404195858354343), FPR_C(0x3FEF1C7ABE284708, 0.9722264970789363),
+    FPR_C(0xBFEF1C7ABE284708, -0.9722264970789363), FPR_C(0x3FCDF5163F01099A, 0.23404195858354343),
+    FPR_C(0x3FEE0766D9280F54, 0.9384035340631081), FPR_C(0x3FD61D595C88C202, 0.34554132496398904),
+    FPR_C(0xBFD61D595C88C202, -0.34554132496398904), FPR_C(0x3FEE0766D9280F54, 0.9384035340631081),
+    FPR_C(0x3FDAD473125CDC09, 0.41921688836322396), FPR_C(0x3FED0D672F59D2B9, 0.9078861164876663),
+    FPR_C(0xBFED0D672F59D2B9, -0.9078861164876663), FPR_C(0x3FDAD473125CDC09, 0.41921688836322396),
+    FPR_C(0x3FE782FB1B90B35B, 0.7347388780959635), FPR_C(0x3FE5B50B264F7448, 0.6783500431298615),
+    FPR_C(0xBFE5B50B264F7448, -0.6783500431298615), FPR_C(0x3FE782FB1B90B35B, 0.7347388780959635),
+    FPR_C(0x3FA46A396FF86179, 0.03987292758773981), FPR_C(0x3FEFF97C4208C014, 0.9992047586183639),
+    FPR_C(0xBFEFF97C4208C014, -0.9992047586183639), FPR_C(0x3FA46A396FF86179, 0.03987292758773981),
+    FPR_C(0x3FEFFB55E425FDAE, 0.9994306045554617), FPR_C(0x3FA14685DB42C17F, 0.03374117185137759),
+    FPR_C(0xBFA14685DB42C17F, -0.03374117185137759), FPR_C(0x3FEFFB55E425FDAE, 0.9994306045554617),
+    FPR_C(0x3FE5D9DEE73E345C, 0.6828455463852481), FPR_C(0x3FE760C52C304764, 0.7305627692278276),
+    FPR_C(0xBFE760C52C304764, -0.7305627692278276), FPR_C(0x3FE5D9DEE73E345C, 0.6828455463852481),
+    FPR_C(0x3FED2255C6E5A4E1, 0.9104412922580672), FPR_C(0x3FDA790CD3DBF31B, 0.41363831223843456),
+    FPR_C(0xBFDA790CD3DBF31B, -0.41363831223843456), FPR_C(0x3FED2255C6E5A4E1, 0.9104412922580672),
+    FPR_C(0x3FD67B949CAD63CB, 0.35129275608556715), FPR_C(0x3FEDF5E36A9BA59C, 0.9362656671702783),
+    FPR_C(0xBFEDF5E36A9BA59C, -0.9362656671702783), FPR_C(0x3FD67B949CAD63CB, 0.35129275608556715),
+    FPR_C(0x3FEF2817FC4609CE, 0.973644249650812), FPR_C(0x3FCD31774D2CBDEE, 0.22807208317088573),
+    FPR_C(0xBFCD31774D2CBDEE, -0.22807208317088573), FPR_C(0x3FEF2817FC4609CE, 0.973644249650812),
+    FPR_C(0x3FE0DED0B84BC4B6, 0.5271991347819014), FPR_C(0x3FEB3115A5F37BF3, 0.8497417680008524),
+    FPR_C(0xBFEB3115A5F37BF3, -0.8497417680008524), FPR_C(0x3FE0DED0B84BC4B6, 0.5271991347819014),
+    FPR_C(0x3FE9FDF4F13149DE, 0.8122505865852039), FPR_C(0x3FE2AA76E87AEB58, 0.5833086529376983),
+    FPR_C(0xBFE2AA76E87AEB58, -0.5833086529376983), FPR_C(0x3FE9FDF4F13149DE, 0.8122505865852039),
+    FPR_C(0x3FC4B8B17F79FA88, 0.16188639378011183), FPR_C(0x3FEF93F14F85AC08, 0.9868094018141855),
+    FPR_C(0xBFEF93F14F85AC08, -0.9868094018141855), FPR_C(0x3FC4B8B17F79FA88, 0.16188639378011183),
+    FPR_C(0x3FEFB8D18D66ADB7, 0.9913108598461154), FPR_C(0x3FC0D64DBCB26786, 0.13154002870288312),
+    FPR_C(0xBFC0D64DBCB26786, -0.13154002870288312), FPR_C(0x3FEFB8D18D66ADB7, 0.9913108598461154),
+    FPR_C(0x3FE374531B817F8D, 0.6079497849677736), FPR_C(0x3FE9683F42BD7FE1, 0.7939754775543372),
+    FPR_C(0xBFE9683F42BD7FE1, -0.7939754775543372), FPR_C(0x3FE374531B817F8D, 0.6079497849677736),
+    FPR_C(0x3FEBB249A0B6C40D, 0.8655136240905691), FPR_C(0x3FE00740C82B82E1, 0.5008853826112408),
+    FPR_C(0xBFE00740C82B82E1, -0.5008853826112408), FPR_C(0x3FEBB249A0B6C40D, 0.8655136240905691),
+    FPR_C(0x3FD0804E05EB661E, 0.257831102162159), FPR_C(0x3FEEEB074C50A544, 0.9661900034454125),
+    FPR_C(0xBFEEEB074C50A544, -0.9661900034454125), FPR_C(0x3FD0804E05EB661E, 0.257831102162159),
+    FPR_C(0x3FEE4A8DFF81CE5E, 0.9466009130832835), FPR_C(0x3FD4A253D11B82F3, 0.32240767880106985),
+    FPR_C(0xBFD4A253D11B82F3, -0.32240767880106985), FPR_C(0x3FEE4A8DFF81CE5E, 0.9466009130832835),
+    FPR_C(0x3FDC3F6D47263129, 0.44137126873171667), FPR_C(0x3FECB6E20A00DA99, 0.8973245807054183),
+    FPR_C(0xBFECB6E20A00DA99, -0.8973245807054183), FPR_C(0x3FDC3F6D47263129, 0.44137126873171667),
+    FPR_C(0x3FE8098B756E52FA, 0.7511651319096864), FPR_C(0x3FE51FA81CD99AA6, 0.6601143420674205),
+    FPR_C(0xBFE51FA81CD99AA6, -0.6601143420674205), FPR_C(0x3FE8098B756E52FA, 0.7511651319096864),
+    FPR_C(0x3FB07B614E463064, 0.06438263092985747), FPR_C(0x3FEFEF0102826191, 0.997925286198596),
+    FPR_C(0xBFEFEF0102826191, -0.997925286198596), FPR_C(0x3FB07B614E463064, 0.06438263092985747),
+    FPR_C(0x3FEFE3E92BE9D886, 0.9965711457905548), FPR_C(0x3FB52E774A4D4D0A, 0.08274026454937569),
+    FPR_C(0xBFB52E774A4D4D0A, -0.08274026454937569), FPR_C(0x3FEFE3E92BE9D886, 0.9965711457905548),
+    FPR_C(0x3FE4AD79516722F1, 0.6461760129833164), FPR_C(0x3FE86C0A1D9AA195, 0.7631884172633813),
+    FPR_C(0xBFE86C0A1D9AA195, -0.7631884172633813), FPR_C(0x3FE4AD79516722F1, 0.6461760129833164),
+    FPR_C(0x3FEC7315899EAAD7, 0.8890483558546646), FPR_C(0x3FDD4CD02BA8609D, 0.45781330359887723),
+    FPR_C(0xBFDD4CD02BA8609D, -0.45781330359887723), FPR_C(0x3FEC7315899EAAD7, 0.8890483558546646),
+    FPR_C(0x3FD383F5E353B6AB, 0.30492922973540243), FPR_C(0x3FEE79DB29A5165A, 0.9523750127197659),
+    FPR_C(0xBFEE79DB29A5165A, -0.9523750127197659), FPR_C(0x3FD383F5E353B6AB, 0.30492922973540243),
+    FPR_C(0x3FEEC2CF4B1AF6B2, 0.9612804858113206), FPR_C(0x3FD1A2F7FBE8F243, 0.27557181931095814),
+    FPR_C(0xBFD1A2F7FBE8F243, -0.27557181931095814), FPR_C(0x3FEEC2CF4B1AF6B2, 0.9612804858113206),
+    FPR_C(0x3FDF081906BFF7FE, 0.4848692480007911), FPR_C(0x3FEBFC9D25A1B147, 0.8745866522781761),
+    FPR_C(0xBFEBFC9D25A1B147, -0.8745866522781761), FPR_C(0x3FDF081906BFF7FE, 0.4848692480007911),
+    FPR_C(0x3FE90B7943575EFE, 0.7826505961665757), FPR_C(0x3FE3EB33EABE0680, 0.62246127937415),
+    FPR_C(0xBFE3EB33EABE0680, -0.62246127937415), FPR_C(0x3FE90B7943575EFE, 0.7826505961665757),
+    FPR_C(0x3FBCFF533B307DC1, 0.11327095217756435), FPR_C(0x3FEFCB4703914354, 0.9935641355205953),
+    FPR_C(0xBFEFCB4703914354, -0.9935641355205953), FPR_C(0x3FBCFF533B307DC1, 0.11327095217756435),
+    FPR_C(0x3FEF7A299C1A322A, 0.9836624192117303), FPR_C(0x3FC70AFD8D08C4FF, 0.18002290140569951),
+    FPR_C(0xBFC70AFD8D08C4FF, -0.18002290140569951), FPR_C(0x3FEF7A299C1A322A, 0.9836624192117303),
+    FPR_C(0x3FE22F2D662C13E2, 0.5682589526701316), FPR_C(0x3FEA54C91090F523, 0.8228497813758263),
+    FPR_C(0xBFEA54C91090F523, -0.8228497813758263), FPR_C(0x3FE22F2D662C13E2, 0.5682589526701316),
+    FPR_C(0x3FEAE068F345ECEF, 0.8398937941959995), FPR_C(0x3FE15E36E4DBE2BC, 0.5427507848645159),
+    FPR_C(0xBFE15E36E4DBE2BC, -0.5427507848645159), FPR_C(0x3FEAE068F345ECEF, 0.8398937941959995),
+    FPR_C(0x3FCAE4F1D5F3B9AB, 0.2101118368804696), FPR_C(0x3FEF492206BCABB4, 0.9776773578245099),
+    FPR_C(0xBFEF492206BCABB4, -0.9776773578245099), FPR_C(0x3FCAE4F1D5F3B9AB, 0.2101118368804696),
+    FPR_C(0x3FEDBF9E4395759A, 0.9296408958431812), FPR_C(0x3FD794F5E613DFAE, 0.3684668299533723),
+    FPR_C(0xBFD794F5E613DFAE, -0.3684668299533723), FPR_C(0x3FEDBF9E4395759A, 0.9296408958431812),
+    FPR_C(0x3FD96555B7AB948F, 0.3968099874167103), FPR_C(0x3FED5F7172888A7F, 0.9179007756213905),
+    FPR_C(0xBFED5F7172888A7F, -0.9179007756213905), FPR_C(0x3FD96555B7AB948F, 0.3968099874167103),
+    FPR_C(0x3FE6F8CA99C95B75, 0.7178700450557317), FPR_C(0x3FE64715437F535B, 0.696177131491463),
+    FPR_C(0xBFE64715437F535B, -0.696177131491463), FPR_C(0x3FE6F8CA99C95B75, 0.7178700450557317),
+    FPR_C(0x3F8F6A296AB997CB, 0.015339206284988102), FPR_C(0x3FEFFF0943C53BD1, 0.9998823474542126),
+    FPR_C(0xBFEFFF0943C53BD1, -0.9998823474542126), FPR_C(0x3F8F6A296AB997CB, 0.015339206284988102),
+    FPR_C(0x3FEFFE1C6870CB77, 0.9997694053512153), FPR_C(0x3F95FD4D21FAB226, 0.021474080275469508),
+    FPR_C(0xBF95FD4D21FAB226, -0.021474080275469508), FPR_C(0x3FEFFE1C6870CB77, 0.9997694053512153),
+    FPR_C(0x3FE622E44FEC22FF, 0.6917592583641577), FPR_C(0x3FE71BAC960E41BF, 0.7221281939292153),
+    FPR_C(0xBFE71BAC960E41BF, -0.7221281939292153), FPR_C(0x3FE622E44FEC22FF, 0.6917592583641577),
+    FPR_C(0x3FED4B5B1B187524, 0.9154487160882678), FPR_C(0x3FD9C17D440DF9F2, 0.40243465085941843),
+    FPR_C(0xBFD9C17D440DF9F2, -0.40243465085941843), FPR_C(0x3FED4B5B1B187524, 0.9154487160882678),
+    FPR_C(0x3FD73763C9261092, 0.3627557243673972), FPR_C(0x3FEDD1FEF38A915A, 0.9318842655816681),
+    FPR_C(0xBFEDD1FEF38A915A, -0.9318842655816681), FPR_C(0x3FD73763C9261092, 0.3627557243673972),
+    FPR_C(0x3FEF3E6BBC1BBC65, 0.9763697313300211), FPR_C(0x3FCBA96334F15DAD, 0.21610679707621952),
+    FPR_C(0xBFCBA96334F15DAD, -0.21610679707621952), FPR_C(0x3FEF3E6BBC1BBC65, 0.9763697313300211),
+    FPR_C(0x3FE133E9CFEE254F, 0.5375870762956455), FPR_C(0x3FEAFB8FD89F57B6, 0.8432082396418454),
+    FPR_C(0xBFEAFB8FD89F57B6, -0.8432082396418454), FPR_C(0x3FE133E9CFEE254F, 0.5375870762956455),
+    FPR_C(0x3FEA38184A593BC6, 0.819347520076797), FPR_C(0x3FE258734CBB7110, 0.5732971666980422),
+    FPR_C(0xBFE258734CBB7110, -0.5732971666980422), FPR_C(0x3FEA38184A593BC6, 0.819347520076797),
+    FPR_C(0x3FC6451A831D830D, 0.17398387338746382), FPR_C(0x3FEF830F4A40C60C, 0.9847485018019042),
+    FPR_C(0xBFEF830F4A40C60C, -0.9847485018019042), FPR_C(0x3FC6451A831D830D, 0.17398387338746382),
+    FPR_C(0x3FEFC56E3B7D9AF6, 0.9928504144598651), FPR_C(0x3FBE8EB7FDE4AA3F, 0.11936521481099137),
+    FPR_C(0xBFBE8EB7FDE4AA3F, -0.11936521481099137), FPR_C(0x3FEFC56E3B7D9AF6, 0.9928504144598651),
+    FPR_C(0x3FE3C3C44981C518, 0.617647307937804), FPR_C(0x3FE92AA41FC5A815, 0.7864552135990858),
+    FPR_C(0xBFE92AA41FC5A815, -0.7864552135990858), FPR_C(0x3FE3C3C44981C518, 0.617647307937804),
+    FPR_C(0x3FEBE41B611154C1, 0.8715950866559511), FPR_C(0x3FDF5FDEE656CDA3, 0.49022648328829116),
+    FPR_C(0xBFDF5FDEE656CDA3, -0.49022648328829116), FPR_C(0x3FEBE41B611154C1, 0.8715950866559511),
+    FPR_C(0x3FD1423EEFC69378, 0.2696683255729151), FPR_C(0x3FEED0835E999009, 0.9629532668736839),
+    FPR_C(0xBFEED0835E999009, -0.9629532668736839), FPR_C(0x3FD1423EEFC69378, 0.2696683255729151),
+    FPR_C(0x3FEE6A61C55D53A7, 0.9504860739494817), FPR_C(0x3FD3E39BE96EC271, 0.3107671527496115),
+    FPR_C(0xBFD3E39BE96EC271, -0.3107671527496115), FPR_C(0x3FEE6A61C55D53A7, 0.9504860739494817),
+    FPR_C(0x3FDCF34BAEE1CD21, 0.4523495872337709), FPR_C(0x3FEC89F587029C13, 0.8918407093923427),
+    FPR_C(0xBFEC89F587029C13, -0.8918407093923427), FPR_C(0x3FDCF34BAEE1CD21, 0.4523495872337709),
+    FPR_C(0x3FE84B7111AF83FA, 0.7592091889783881), FPR_C(0x3FE4D3BC6D589F7F, 0.6508466849963809),
+    FPR_C(0xBFE4D3BC6D589F7F, -0.6508466849963809), FPR_C(0x3FE84B7111AF83FA, 0.7592091889783881),
+    FPR_C(0x3FB39D9F12C5A299, 0.07662386139203149), FPR_C(0x3FEFE7EA85482D60, 0.997060070339483),
+    FPR_C(0xBFEFE7EA85482D60, -0.997060070339483), FPR_C(0x3FB39D9F12C5A299, 0.07662386139203149),
+    FPR_C(0x3FEFEB9D2530410F, 0.9975114561403035), FPR_C(0x3FB20C9674ED444D, 0.07050457338961387),
+    FPR_C(0xBFB20C9674ED444D, -0.07050457338961387), FPR_C(0x3FEFEB9D2530410F, 0.9975114561403035),
+    FPR_C(0x3FE4F9CC25CCA486, 0.6554928529996153), FPR_C(0x3FE82A9C13F545FF, 0.7552013768965365),
+    FPR_C(0xBFE82A9C13F545FF, -0.7552013768965365), FPR_C(0x3FE4F9CC25CCA486, 0.6554928529996153),
+    FPR_C(0x3FECA08F19B9C449, 0.8945994856313827), FPR_C(0x3FDC997FC3865389, 0.4468688401623742),
+    FPR_C(0xBFDC997FC3865389, -0.4468688401623742), FPR_C(0x3FECA08F19B9C449, 0.8945994856313827),
+    FPR_C(0x3FD44310DC8936F0, 0.31659337555616585), FPR_C(0x3FEE5A9D550467D3, 0.9485613499157303),
+    FPR_C(0xBFEE5A9D550467D3, -0.9485613499157303), FPR_C(0x3FD44310DC8936F0, 0.31659337555616585),
+    FPR_C(0x3FEEDDEB6A078651, 0.9645897932898128), FPR_C(0x3FD0E15B4E1749CE, 0.2637546789748314),
+    FPR_C(0xBFD0E15B4E1749CE, -0.2637546789748314), FPR_C(0x3FEEDDEB6A078651, 0.9645897932898128),
+    FPR_C(0x3FDFB7575C24D2DE, 0.49556526182577254), FPR_C(0x3FEBCB54CB0D2327, 0.8685707059713409),
+    FPR_C(0xBFEBCB54CB0D2327, -0.8685707059713409), FPR_C(0x3FDFB7575C24D2DE, 0.49556526182577254),
+    FPR_C(0x3FE94990E3AC4A6C, 0.79023022143731), FPR_C(0x3FE39C23E3D63029, 0.6128100824294097),
+    FPR_C(0xBFE39C23E3D63029, -0.6128100824294097), FPR_C(0x3FE94990E3AC4A6C, 0.79023022143731),
+    FPR_C(0x3FC00EE8AD6FB85B, 0.12545498341154623), FPR_C(0x3FEFBF470F0A8D88, 0.9920993131421918),
+    FPR_C(0xBFEFBF470F0A8D88, -0.9920993131421918), FPR_C(0x3FC00EE8AD6FB85B, 0.12545498341154623),
+    FPR_C(0x3FEF8BA737CB4B78, 0.9857975091675675), FPR_C(0x3FC57F008654CBDE, 0.16793829497473117),
+    FPR_C(0xBFC57F008654CBDE, -0.16793829497473117), FPR_C(0x3FEF8BA737CB4B78, 0.9857975091675675),
+    FPR_C(0x3FE2818BEF4D3CBA, 0.5783137964116556), FPR_C(0x3FEA1B26D2C0A75E, 0.8158144108067338),
+    FPR_C(0xBFEA1B26D2C0A75E, -0.8158144108067338), FPR_C(0x3FE2818BEF4D3CBA, 0.5783137964116556),
+    FPR_C(0x3FEB16742A4CA2F5, 0.8464909387740521), FPR_C(0x3FE1097248D0A957, 0.532403127877198),
+    FPR_C(0xBFE1097248D0A957, -0.532403127877198), FPR_C(0x3FEB16742A4CA2F5, 0.8464909387740521),
+    FPR_C(0x3FCC6D90535D74DD, 0.22209362097320354), FPR_C(0x3FEF33685A3AAEF0, 0.9750253450669941),
+    FPR_C(0xBFEF33685A3AAEF0, -0.9750253450669941), FPR_C(0x3FCC6D90535D74DD, 0.22209362097320354),
+    FPR_C(0x3FEDE4160F6D8D81, 0.9340925504042589), FPR_C(0x3FD6D998638A0CB6, 0.35703096123343003),
+    FPR_C(0xBFD6D998638A0CB6, -0.35703096123343003), FPR_C(0x3FEDE4160F6D8D81, 0.9340925504042589),
+    FPR_C(0x3FDA1D6543B50AC0, 0.4080441628649787), FPR_C(0x3FED36FC7BCBFBDC, 0.9129621904283982),
+    FPR_C(0xBFED36FC7BCBFBDC, -0.9129621904283982), FPR_C(0x3FDA1D6543B50AC0, 0.4080441628649787),
+    FPR_C(0x3FE73E558E079942, 0.726359155084346), FPR_C(0x3FE5FE7CBDE56A10, 0.6873153408917592),
+    FPR_C(0xBFE5FE7CBDE56A10, -0.6873153408917592), FPR_C(0x3FE73E558E079942, 0.726359155084346),
+    FPR_C(0x3F9C454F4CE53B1D, 0.027608145778965743), FPR_C(0x3FEFFCE09CE2A679, 0.9996188224951786),
+    FPR_C(0xBFEFFCE09CE2A679, -0.9996188224951786), FPR_C(0x3F9C454F4CE53B1D, 0.027608145778965743),
+    FPR_C(0x3FEFF753BB1B9164, 0.9989412931868569), FPR_C(0x3FA78DBAA5874686, 0.04600318213091463),
+    FPR_C(0xBFA78DBAA5874686, -0.04600318213091463), FPR_C(0x3FEFF753BB1B9164, 0.9989412931868569),
+    FPR_C(0x3FE59001D5F723DF, 0.673829000378756), FPR_C(0x3FE7A4F707BF97D2, 0.7388873244606151),
+    FPR_C(0xBFE7A4F707BF97D2, -0.7388873244606151), FPR_C(0x3FE59001D5F723DF, 0.673829000378756),
+    FPR_C(0x3FECF830E8CE467B, 0.9052967593181188), FPR_C(0x3FDB2F971DB31972, 0.4247796812091088),
+    FPR_C(0xBFDB2F971DB31972, -0.4247796812091088), FPR_C(0x3FECF830E8CE467B, 0.9052967593181188),
+    FPR_C(0x3FD5BEE78B9DB3B6, 0.33977688440682685), FPR_C(0x3FEE18A02FDC66D9, 0.9405060705932683),
+    FPR_C(0xBFEE18A02FDC66D9, -0.9405060705932683), FPR_C(0x3FD5BEE78B9DB3B6, 0.33977688440682685),
+    FPR_C(0x3FEF1090BC898F5F, 0.9707721407289504), FPR_C(0x3FCEB86B462DE348, 0.2400030224487415),
+    FPR_C(0xBFCEB86B462DE348, -0.2400030224487415), FPR_C(0x3FEF1090BC898F5F, 0.9707721407289504),
+    FPR_C(0x3FE089112032B08C, 0.5167317990176499), FPR_C(0x3FEB658F14FDBC47, 0.8561473283751945),
+    FPR_C(0xBFEB658F14FDBC47, -0.8561473283751945), FPR_C(0x3FE089112032B08C, 0.5167317990176499),
+    FPR_C(0x3FE9C2D110F075C2, 0.8050313311429635), FPR_C(0x3FE2FBC24B441015, 0.5932322950397998),
+    FPR_C(0xBFE2FBC24B441015, -0.5932322950397998), FPR_C(0x3FE9C2D110F075C2, 0.8050313311429635),
+    FPR_C(0x3FC32B7BF94516A7, 0.1497645346773215), FPR_C(0x3FEFA39BAC7A1791, 0.9887216919603238),
+    FPR_C(0xBFEFA39BAC7A1791, -0.9887216919603238), FPR_C(0x3FC32B7BF94516A7, 0.1497645346773215),
+    FPR_C(0x3FEFAAFBCB0CFDDC, 0.9896220174632009), FPR_C(0x3FC264994DFD3409, 0.14369503315029444),
+    FPR_C(0xBFC264994DFD3409, -0.14369503315029444), FPR_C(0x3FEFAAFBCB0CFDDC, 0.9896220174632009),
+    FPR_C(0x3FE32421EC49A61F, 0.5981607069963423), FPR_C(0x3FE9A4DFA42B06B2, 0.8013761717231402),
+    FPR_C(0xBFE9A4DFA42B06B2, -0.8013761717231402), FPR_C(0x3FE32421EC49A61F, 0.5981607069963423),
+    FPR_C(0x3FEB7F6686E792E9, 0.8593018183570084), FPR_C(0x3FE05DF3EC31B8B7, 0.5114688504379704),
+    FPR_C(0xBFE05DF3EC31B8B7, -0.5114688504379704), FPR_C(0x3FEB7F6686E792E9, 0.8593018183570084),
+    FPR_C(0x3FCF7B7480BD3802, 0.24595505033579462), FPR_C(0x3FEF045A14CF738C, 0.9692812353565485),
+    FPR_C(0xBFEF045A14CF738C, -0.9692812353565485), FPR_C(0x3FCF7B7480BD3802, 0.24595505033579462),
+    FPR_C(0x3FEE298F4439197A, 0.9425731976014469), FPR_C(0x3FD5604012F467B4, 0.3339996514420094),
+    FPR_C(0xBFD5604012F467B4, -0.3339996514420094), FPR_C(0x3FEE298F4439197A, 0.9425731976014469),
+    FPR_C(0x3FDB8A7814FD5693, 0.4303264813400826), FPR_C(0x3FECE2B32799A060, 0.9026733182372588),
+    FPR_C(0xBFECE2B32799A060, -0.9026733182372588), FPR_C(0x3FDB8A7814FD5693, 0.4303264813400826),
+    FPR_C(0x3FE7C6B89CE2D333, 0.7430079521351217), FPR_C(0x3FE56AC35197649F, 0.6692825883466361),
+    FPR_C(0xBFE56AC35197649F, -0.6692825883466361), FPR_C(0x3FE7C6B89CE2D333, 0.7430079521351217),
+    FPR_C(0x3FAAB101BD5F8317, 0.052131704680283324), FPR_C(0x3FEFF4DC54B1BED3, 0.9986402181802653),
+    FPR_C(0xBFEFF4DC54B1BED3, -0.9986402181802653), FPR_C(0x3FAAB101BD5F8317, 0.052131704680283324),
+    FPR_C(0x3FEFDAFA7514538C, 0.9954807554919269), FPR_C(0x3FB84F8712C130A1, 0.094963495329639),
+    FPR_C(0xBFB84F8712C130A1, -0.094963495329639), FPR_C(0x3FEFDAFA7514538C, 0.9954807554919269),
+    FPR_C(0x3FE4605A692B32A2, 0.6367618612362842), FPR_C(0x3FE8AC871EDE1D88, 0.7710605242618138),
+    FPR_C(0xBFE8AC871EDE1D88, -0.7710605242618138), FPR_C(0x3FE4605A692B32A2, 0.6367618612362842),
+    FPR_C(0x3FEC44833141C004, 0.8833633386657316), FPR_C(0x3FDDFEFF66A941DE, 0.46868882203582796),
+    FPR_C(0xBFDDFEFF66A941DE, -0.46868882203582796), FPR_C(0x3FEC44833141C004, 0.8833633386657316),
+    FPR_C(0x3FD2C41A4E954520, 0.29321916269425863), FPR_C(0x3FEE97EC36016B30, 0.9560452513499964),
+    FPR_C(0xBFEE97EC36016B30, -0.9560452513499964), FPR_C(0x3FD2C41A4E954520, 0.29321916269425863),
+    FPR_C(0x3FEEA68393E65800, 0.9578264130275329), FPR_C(0x3FD263E6995554BA, 0.2873474595447295),
+    FPR_C(0xBFD263E6995554BA, -0.2873474595447295), FPR_C(0x3FEEA68393E65800, 0.9578264130275329),
+    FPR_C(0x3FDE57A86D3CD825, 0.47410021465055), FPR_C(0x3FEC2CD14931E3F1, 0.8804708890521608),
+    FPR_C(0xBFEC2CD14931E3F1, -0.8804708890521608), FPR_C(0x3FDE57A86D3CD825, 0.47410021465055),
+    FPR_C(0x3FE8CC6A75184655, 0.7749531065948739), FPR_C(0x3FE4397F5B2A4380, 0.6320187359398091),
+    FPR_C(0xBFE4397F5B2A4380, -0.6320187359398091), FPR_C(0x3FE8CC6A75184655, 0.7749531065948739),
+    FPR_C(0x3FB9DFB6EB24A85C, 0.10106986275482782), FPR_C(0x3FEFD60D2DA75C9E, 0.9948793307948056),
+    FPR_C(0xBFEFD60D2DA75C9E, -0.9948793307948056), FPR_C(0x3FB9DFB6EB24A85C, 0.10106986275482782),
+    FPR_C(0x3FEF677556883CEE, 0.9813791933137546), FPR_C(0x3FC8961727C41804, 0.19208039704989244),
+    FPR_C(0xBFC8961727C41804, -0.19208039704989244), FPR_C(0x3FEF677556883CEE, 0.9813791933137546),
+    FPR_C(0x3FE1DC1B64DC4872, 0.5581185312205561), FPR_C(0x3FEA8D676E545AD2, 0.829761233794523),
+    FPR_C(0xBFEA8D676E545AD2, -0.829761233794523), FPR_C(0x3FE1DC1B64DC4872, 0.5581185312205561),
+    FPR_C(0x3FEAA9547A2CB98E, 0.8331701647019132), FPR_C(0x3FE1B250171373BF, 0.5530167055800276),
+    FPR_C(0xBFE1B250171373BF, -0.5530167055800276), FPR_C(0x3FEAA9547A2CB98E, 0.8331701647019132),
+    FPR_C(0x3FC95B49E9B62AFA, 0.1980984107179536), FPR_C(0x3FEF5DA6ED43685D, 0.9801821359681174),
+    FPR_C(0xBFEF5DA6ED43685D, -0.9801821359681174), FPR_C(0x3FC95B49E9B62AFA, 0.1980984107179536),
+    FPR_C(0x3FED9A00DD8B3D46, 0.9250492407826776), FPR_C(0x3FD84F6AAAF3903F, 0.37984720892405116),
+    FPR_C(0xBFD84F6AAAF3903F, -0.37984720892405116), FPR_C(0x3FED9A00DD8B3D46, 0.9250492407826776),
+    FPR_C(0x3FD8AC4B86D5ED44, 0.38551605384391885), FPR_C(0x3FED86C48445A44F, 0.9227011283338785),
+    FPR_C(0xBFED86C48445A44F, -0.9227011283338785), FPR_C(0x3FD8AC4B86D5ED44, 0.38551605384391885),
+    FPR_C(0x3FE6B25CED2FE29C, 0.7092728264388657), FPR_C(0x3FE68ED1EAA19C71, 0.7049340803759049),
+    FPR_C(0xBFE68ED1EAA19C71, -0.7049340803759049), FPR_C(0x3FE6B25CED2FE29C, 0.7092728264388657),
+    FPR_C(0x3F6921F8BECCA4BA, 0.003067956762965976), FPR_C(0x3FEFFFF621621D02, 0.9999952938095762),
+    FPR_C(0xBFEFFFF621621D02, -0.9999952938095762), FPR_C(0x3F6921F8BECCA4BA, 0.003067956762965976),
+};
+
+// psi = 1945, a primitive 2048-th root of unity modulo q
+PQC_NTT_DEFINE_POWERS(FALCON_PSI, 1945, FALCON_Q);
+
+_Static_assert(FALCON_PSI_POW1024 == FALCON_Q - 1, "psi must be a primitive 2048-th root of unity");
+
+#define FALCON_MQ_ZETA(k) PQC_NTT_POW_BITREV(FALCON_PSI, k, 10, FALCON_Q)
+#define FALCON_MQ_NINV(logn) PQC_NTT_INV_N(1u << (logn), FALCON_Q)
+
+_Static_assert(FALCON_MQ_ZETA(1) == 1479 && FALCON_MQ_ZETA(2) == 8246,
+               "mq_zetas must match the reference table");
+
+/**
+ * @brief psi^brev(k) mod q for k = 0..1023
+ */
+static const uint16_t mq_zetas[FALCON_MAX_N] = { PQC_NTT_REP1024(FALCON_MQ_ZETA, 0) };
+
+/**
+ * @brief n^-1 mod q, indexed by logn
+ */
+static const uint16_t mq_ninv[FALCON_MAX_LOGN + 1] = {
+    FALCON_MQ_NINV(0), FALCON_MQ_NINV(1), FALCON_MQ_NINV(2), FALCON_MQ_NINV(3),
+    FALCON_MQ_NINV(4), FALCON_MQ_NINV(5), FALCON_MQ_NINV(6), FALCON_MQ_NINV(7),
+    FALCON_MQ_NINV(8), FALCON_MQ_NINV(9), FALCON_MQ_NINV(10)
+};
+
+// ============================================================================
+// Complex Helpers
+// ============================================================================
+
+#define FPC_ADD(d_re, d_im, a_re, a_im, b_re, b_im) do { \
+        fpr fpct_re = fpr_add(a_re, b_re); \
+        fpr fpct_im = fpr_add(a_im, b_im); \
+        (d_re) = fpct_re; \
+        (d_im) = fpct_im; \
+    } while (0)
+
+#define FPC_SUB(d_re, d_im, a_re, a_im, b_re, b_im) do { \
+        fpr fpct_re = fpr_sub(a_re, b_re); \
+        fpr fpct_im = fpr_sub(a_im, b_im); \
+        (d_re) = fpct_re; \
+        (d_im) = fpct_im; \
+    } while (0)
+
+#define FPC_MUL(d_re, d_im, a_re, a_im, b_re, b_im) do { \
+        fpr fpct_a_re = (a_re), fpct_a_im = (a_im); \
+        fpr fpct_b_re = (b_re), fpct_b_im = (b_im); \
+        fpr fpct_re = fpr_sub(fpr_mul(fpct_a_re, fpct_b_re), fpr_mul(fpct_a_im, fpct_b_im)); \
+        fpr fpct_im = fpr_add(fpr_mul(fpct_a_re, fpct_b_im), fpr_mul(fpct_a_im, fpct_b_re)); \
+        (d_re) = fpct_re; \
+        (d_im) = fpct_im; \
+    } while (0)
+
+#define FPC_DIV(d_re, d_im, a_re, a_im, b_re, b_im) do { \
+        fpr fpcd_a_re = (a_re), fpcd_a_im = (a_im); \
+        fpr fpcd_b_re = (b_re), fpcd_b_im = (b_im); \
+        fpr fpcd_m = fpr_div(fpr_one, fpr_add(fpr_sqr(fpcd_b_re), fpr_sqr(fpcd_b_im))); \
+        fpcd_b_re = fpr_mul(fpcd_b_re, fpcd_m); \
+        fpcd_b_im = fpr_neg(fpr_mul(fpcd_b_im, fpcd_m)); \
+        FPC_MUL(d_re, d_im, fpcd_a_re, fpcd_a_im, fpcd_b_re, fpcd_b_im); \
+    } while (0)
+
+// ============================================================================
+// FFT
+// ============================================================================
+
+void falcon_fft(fpr *f, unsigned logn) {
+    // The first layer combines f[j] and f[j + n/2] with the twiddle i,
+    // which is exactly how the input is laid out already
+    size_t n = (size_t)1 << logn;
+    size_t hn = n >> 1;
+    size_t t = hn;
+
+    for (unsigned u = 1, m = 2; u < logn; u++, m <<= 1) {
+        size_t ht = t >> 1;
+        size_t hm = m >> 1;
+        for (size_t i1 = 0, j1 = 0; i1 < hm; i1++, j1 += t) {
+            size_t j2 = j1 + ht;
+            fpr s_re = fpr_gm_tab[((m + i1) << 1) + 0];
+            fpr s_im = fpr_gm_tab[((m + i1) << 1) + 1];
+            for (size_t j = j1; j < j2; j++) {
+                fpr x_re = f[j];
+                fpr x_im = f[j + hn];
+                fpr y_re = f[j + ht];
+                fpr y_im = f[j + ht + hn];
+                FPC_MUL(y_re, y_im, y_re, y_im, s_re, s_im);
+                FPC_ADD(f[j], f[j + hn], x_re, x_im, y_re, y_im);
+                FPC_SUB(f[j + ht], f[j + ht + hn], x_re, x_im, y_re, y_im);
+            }
+        }
+        t = ht;
+    }
+}
+
+void falcon_ifft(fpr *f, unsigned logn) {
+    size_t n = (size_t)1 << logn;
+    size_t hn = n >> 1;
+    size_t t = 1;
+    size_t m = n;
+
+    for (unsigned u = logn; u > 1; u--) {
+        size_t hm = m >> 1;
+        size_t dt = t << 1;
+        for (size_t i1 = 0, j1 = 0; j1 < hn; i1++, j1 += dt) {
+            size_t j2 = j1 + t;
+            fpr s_re = fpr_gm_tab[((hm + i1) << 1) + 0];
+            fpr s_im = fpr_neg(fpr_gm_tab[((hm + i1) << 1) + 1]);
+            for (size_t j = j1; j < j2; j++) {
+                fpr x_re = f[j];
+                fpr x_im = f[j + hn];
+                fpr y_re = f[j + t];
+                fpr y_im = f[j + t + hn];
+                FPC_ADD(f[j], f[j + hn], x_re, x_im, y_re, y_im);
+                FPC_SUB(x_re, x_im, x_re, x_im, y_re, y_im);
+                FPC_MUL(f[j + t], f[j + t + hn], x_re, x_im, s_re, s_im);
+            }
+        }
+        t = dt;
+        m = hm;
+    }
+
+    // The skipped first layer is accounted for by scaling with 2/n
+    if (logn > 0) {
+        fpr ni = fpr_scaled(2, -(int)logn);
+        for (size_t u = 0; u < n; u++) {
+            f[u] = fpr_mul(f[u], ni);
+        }
+    }
+}
+
+// ============================================================================
+// Polynomial Operations
+// ============================================================================
+
+void falcon_poly_add(fpr *a, const fpr *b, unsigned logn) {
+    size_t n = (size_t)1 << logn;
+    for (size_t u = 0; u < n; u++) {
+        a[u] = fpr_add(a[u], b[u]);
+    }
+}
+
+void falcon_poly_sub(fpr *a, const fpr *b, unsigned logn) {
+    size_t n = (size_t)1 << logn;
+    for (size_t u = 0; u < n; u++) {
+        a[u] = fpr_sub(a[u], b[u]);
+    }
+}
+
+void falcon_poly_neg(fpr *a, unsigned logn) {
+    size_t n = (size_t)1 << logn;
+    for (size_t u = 0; u < n; u++) {
+        a[u] = fpr_neg(a[u]);
+    }
+}
+
+void falcon_poly_adj_fft(fpr *a, unsigned logn) {
+    size_t n = (size_t)1 << logn;
+    for (size_t u = n >> 1; u < n; u++) {
+        a[u] = fpr_neg(a[u]);
+    }
+}
+
+void falcon_poly_mul_fft(fpr *a, const fpr *b, unsigned logn) {
+    size_t hn = ((size_t)1 << logn) >> 1;
+    for (size_t u = 0; u < hn; u++) {
+        FPC_MUL(a[u], a[u + hn], a[u], a[u + hn], b[u], b[u + hn]);
+    }
+}
+
+void falcon_poly_muladj_fft(fpr *a, const fpr *b, unsigned logn) {
+    size_t hn = ((size_t)1 << logn) >> 1;
+    for (size_t u = 0; u < hn; u++) {
+        FPC_MUL(a[u], a[u + hn], a[u], a[u + hn], b[u], fpr_neg(b[u + hn]));
+    }
+}
+
+void falcon_poly_mulselfadj_fft(fpr *a, unsigned logn) {
+    size_t hn = ((size_t)1 << logn) >> 1;
+    for (size_t u = 0; u < hn; u++) {
+        a[u] = fpr_add(fpr_sqr(a[u]), fpr_sqr(a[u + hn]));
+        a[u + hn] = fpr_zero;
+    }
+}
+
+void falcon_poly_mulconst(fpr *a, fpr x, unsigned logn) {
+    size_t n = (size_t)1 << logn;
+    for (size_t u = 0; u < n; u++) {
+        a[u] = fpr_mul(a[u], x);
+    }
+}
+
+void falcon_poly_div_fft(fpr *a, const fpr *b, unsigned logn) {
+    size_t hn = ((size_t)1 << logn) >> 1;
+    for (size_t u = 0; u < hn; u++) {
+        FPC_DIV(a[u], a[u + hn], a[u], a[u + hn], b[u], b[u + hn]);
+    }
+}
+
+void falcon_poly_invnorm2_fft(fpr *d, const fpr *a, const fpr *b, unsigned logn) {
+    size_t hn = ((size_t)1 << logn) >> 1;
+    for (size_t u = 0; u < hn; u++) {
+        fpr s = fpr_add(fpr_add(fpr_sqr(a[u]), fpr_sqr(a[u + hn])),
+                        fpr_add(fpr_sqr(b[u]), fpr_sqr(b[u + hn])));
+        d[u] = fpr_div(fpr_one, s);
+    }
+}
+
+void falcon_poly_add_muladj_fft(fpr *d, const fpr *F, const fpr *G,
+                                const fpr *f, const fpr *g, unsigned logn) {
+    size_t hn = ((size_t)1 << logn) >> 1;
+    for (size_t u = 0; u < hn; u++) {
+        fpr a_re, a_im, b_re, b_im;
+        FPC_MUL(a_re, a_im, F[u], F[u + hn], f[u], fpr_neg(f[u + hn]));
+        FPC_MUL(b_re, b_im, G[u], G[u + hn], g[u], fpr_neg(g[u + hn]));
+        d[u] = fpr_add(a_re, b_re);
+        d[u + hn] = fpr_add(a_im, b_im);
+    }
+}
+
+void falcon_poly_mul_autoadj_fft(fpr *a, const fpr *b, unsigned logn) {
+    size_t hn = ((size_t)1 << logn) >> 1;
+    for (size_t u = 0; u < hn; u++) {
+        a[u] = fpr_mul(a[u], b[u]);
+        a[u + hn] = fpr_mul(a[u + hn], b[u]);
+    }
+}
+
+void falcon_poly_LDL_fft(const fpr *g00, fpr *g01, fpr *g11, unsigned logn) {
+    size_t hn = ((size_t)1 << logn) >> 1;
+    for (size_t u = 0; u < hn; u++) {
+        fpr g01_re = g01[u];
+        fpr g01_im = g01[u + hn];
+        fpr mu_re, mu_im;
+        FPC_DIV(mu_re, mu_im, g01_re, g01_im, g00[u], g00[u + hn]);
+        FPC_MUL(g01_re, g01_im, mu_re, mu_im, g01_re, fpr_neg(g01_im));
+        FPC_SUB(g11[u], g11[u + hn], g11[u], g11[u + hn], g01_re, g01_im);
+        g01[u] = mu_re;
+        g01[u + hn] = fpr_neg(mu_im);
+    }
+}
+
+void falcon_split_fft(fpr *f0, fpr *f1, const fpr *f, unsigned logn) {
+    size_t n = (size_t)1 << logn;
+    size_t hn = n >> 1;
+    size_t qn = hn >> 1;
+
+    // For logn = 1 the loop is empty: the single value splits into its
+    // real and imaginary parts
+    f0[0] = f[0];
+    f1[0] = f[hn];
+
+    for (size_t u = 0; u < qn; u++) {
+        fpr a_re = f[(u << 1) + 0];
+        fpr a_im = f[(u << 1) + 0 + hn];
+        fpr b_re = f[(u << 1) + 1];
+        fpr b_im = f[(u << 1) + 1 + hn];
+        fpr t_re, t_im;
+
+        FPC_ADD(t_re, t_im, a_re, a_im, b_re, b_im);
+        f0[u] = fpr_half(t_re);
+        f0[u + qn] = fpr_half(t_im);
+
+        FPC_SUB(t_re, t_im, a_re, a_im, b_re, b_im);
+        FPC_MUL(t_re, t_im, t_re, t_im,
+                fpr_gm_tab[((u + hn) << 1) + 0],
+                fpr_neg(fpr_gm_tab[((u + hn) << 1) + 1]));
+        f1[u] = fpr_half(t_re);
+        f1[u + qn] = fpr_half(t_im);
+    }
+}
+
+void falcon_merge_fft(fpr *f, const fpr *f0, const fpr *f1, unsigned logn) {
+    size_t n = (size_t)1 << logn;
+    size_t hn = n >> 1;
+    size_t qn = hn >> 1;
+
+    f[0] = f0[0];
+    f[hn] = f1[0];
+
+    for (size_t u = 0; u < qn; u++) {
+        fpr a_re = f0[u];
+        fpr a_im = f0[u + qn];
+        fpr b_re, b_im, t_re, t_im;
+
+        FPC_MUL(b_re, b_im, f1[u], f1[u + qn],
+                fpr_gm_tab[((u + hn) << 1) + 0],
+                fpr_gm_tab[((u + hn) << 1) + 1]);
+        FPC_ADD(t_re, t_im, a_re, a_im, b_re, b_im);
+        f[(u << 1) + 0] = t_re;
+        f[(u << 1) + 0 + hn] = t_im;
+        FPC_SUB(t_re, t_im, a_re, a_im, b_re, b_im);
+        f[(u << 1) + 1] = t_re;
+        f[(u << 1) + 1 + hn] = t_im;
+    }
+}
+
+// ============================================================================
+// Arithmetic Modulo q
+// ============================================================================
+
+uint32_t falcon_mq_mul(uint32_t a, uint32_t b) {
+    return (a * b) % FALCON_Q;
+}
+
+uint32_t falcon_mq_inv(uint32_t a) {
+    // a^(q-2) by square-and-multiply over the fixed exponent 12287
+    uint32_t r = 1;
+    uint32_t e = FALCON_Q - 2;
+    for (int i = 13; i >= 0; i--) {
+        r = falcon_mq_mul(r, r);
+        uint32_t t = falcon_mq_mul(r, a);
+        uint32_t mask = -(uint32_t)((e >> i) & 1);
+        r = (r & ~mask) | (t & mask);
+    }
+    return r;
+}
+
+void falcon_mq_ntt(uint16_t *a, unsigned logn) {
+    size_t n = (size_t)1 << logn;
+    size_t k = 1;
+
+    for (size_t len = n >> 1; len > 0; len >>= 1) {
+        for (size_t start = 0; start < n; start += len << 1) {
+            uint32_t zeta = mq_zetas[k++];
+            for (size_t j = start; j < start + len; j++) {
+                uint32_t t = falcon_mq_mul(zeta, a[j + len]);
+                a[j + len] = (uint16_t)((a[j] + FALCON_Q - t) % FALCON_Q);
+                a[j] = (uint16_t)((a[j] + t) % FALCON_Q);
+            }
+        }
+    }
+}
+
+void falcon_mq_intt(uint16_t *a, unsigned logn) {
+    size_t n = (size_t)1 << logn;
+    size_t k = n;
+
+    for (size_t len = 1; len < n; len <<= 1) {
+        for (size_t start = 0; start < n; start += len << 1) {
+            uint32_t zeta = FALCON_Q - mq_zetas[--k];
+            for (size_t j = start; j < start + len; j++) {
+                uint32_t t = a[j];
+                a[j] = (uint16_t)((t + a[j + len]) % FALCON_Q);
+                a[j + len] = (uint16_t)falcon_mq_mul(zeta, t + FALCON_Q - a[j + len]);
+            }
+        }
+    }
+
+    for (size_t j = 0; j < n; j++) {
+        a[j] = (uint16_t)falcon_mq_mul(mq_ninv[logn], a[j]);
+    }
+}
@@ -0,0 +1,423 @@
+/**
+ * @file falcon_fpr.c
+ * @brief Constant-time floating-point arithmetic for Falcon signing
+ *
+ * Implements the fpr operations declared in falcon_internal.h on top of
+ * 64-bit integer arithmetic. Results are bit-identical to IEEE-754
+ * binary64 with round-to-nearest-even (subnormals flushed to zero), so
+ * emulated and PQC_FALCON_NATIVE_FPR builds produce the same signatures.
+ * No operation branches on or indexes memory with secret data; shifts
+ * by a variable count are split into a 32-bit conditional swap and a
+ * shift below 32, which is constant-time on the cores we target.
+ */
+
+#include "falcon_internal.h"
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+const fpr fpr_zero = FPR_C(0x0000000000000000, 0.0);
+const fpr fpr_one = FPR_C(0x3FF0000000000000, 1.0);
+const fpr fpr_q = FPR_C(0x40C8008000000000, 12289.0);
+const fpr fpr_inv_q = FPR_C(0x3F1554E39097A782, 8.137358613394092e-05);
+
+static const fpr fpr_ptwo63 = FPR_C(0x43E0000000000000, 9223372036854775808.0);
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static inline uint64_t fpr_ursh(uint64_t x, int n) {
+    x ^= (x ^ (x >> 32)) & -(uint64_t)(n >> 5);
+    return x >> (n & 31);
+}
+
+static inline int64_t fpr_irsh(int64_t x, int n) {
+    x ^= (x ^ (x >> 32)) & -(int64_t)(n >> 5);
+    return x >> (n & 31);
+}
+
+static inline uint64_t fpr_ulsh(uint64_t x, int n) {
+    x ^= (x ^ (x << 32)) & -(uint64_t)(n >> 5);
+    return x << (n & 31);
+}
+
+#ifndef PQC_FALCON_NATIVE_FPR
+
+/**
+ * @brief Assemble sign s, exponent e and mantissa m into an fpr
+ *
+ * The value is (-1)^s * m * 2^e with m in [2^54, 2^55) or m = 0. The two
+ * extra low bits of m are a guard bit and a sticky bit used for rounding.
+ * Values below the normal range are flushed to zero.
+ */
+static inline fpr FPR(int s, int e, uint64_t m) {
+    e += 1076;
+    uint32_t t = (uint32_t)e >> 31;
+    m &= (uint64_t)t - 1;
+
+    // A zero mantissa gets a zero exponent (the sign is kept)
+    t = (uint32_t)(m >> 54);
+    e &= -(int)t;
+
+    // The top bit of m lands in the exponent field and adds the implicit 1
+    fpr x = (((uint64_t)s << 63) | (m >> 2)) + ((uint64_t)(uint32_t)e << 52);
+
+    // Round to nearest even on the low three bits (011, 110 and 111 round up)
+    unsigned f = (unsigned)m & 7U;
+    x += (0xC8U >> f) & 1;
+    return x;
+}
+
+/**
+ * @brief Shift m left until its top bit is set, adjusting e to match
+ *
+ * m = 0 is left unchanged (with e decreased by 63).
+ */
+#define FPR_NORM64(m, e) do { \
+        uint32_t nt; \
+        (e) -= 63; \
+        nt = (uint32_t)((m) >> 32); \
+        nt = (nt | -nt) >> 31; \
+        (m) ^= ((m) ^ ((m) << 32)) & ((uint64_t)nt - 1); \
+        (e) += (int)(nt << 5); \
+        nt = (uint32_t)((m) >> 48); \
+        nt = (nt | -nt) >> 31; \
+        (m) ^= ((m) ^ ((m) << 16)) & ((uint64_t)nt - 1); \
+        (e) += (int)(nt << 4); \
+        nt = (uint32_t)((m) >> 56); \
+        nt = (nt | -nt) >> 31; \
+        (m) ^= ((m) ^ ((m) << 8)) & ((uint64_t)nt - 1); \
+        (e) += (int)(nt << 3); \
+        nt = (uint32_t)((m) >> 60); \
+        nt = (nt | -nt) >> 31; \
+        (m) ^= ((m) ^ ((m) << 4)) & ((uint64_t)nt - 1); \
+        (e) += (int)(nt << 2); \
+        nt = (uint32_t)((m) >> 62); \
+        nt = (nt | -nt) >> 31; \
+        (m) ^= ((m) ^ ((m) << 2)) & ((uint64_t)nt - 1); \
+        (e) += (int)(nt << 1); \
+        nt = (uint32_t)((m) >> 63); \
+        (m) ^= ((m) ^ ((m) << 1)) & ((uint64_t)nt - 1); \
+        (e) += (int)(nt); \
+    } while (0)
+
+// ============================================================================
+// Emulated Operations
+// ============================================================================
+
+fpr fpr_scaled(int64_t i, int sc) {
+    // Absolute value and sign
+    int s = (int)((uint64_t)i >> 63);
+    i ^= -(int64_t)s;
+    i += s;
+
+    uint64_t m = (uint64_t)i;
+    int e = 9 + sc;
+    FPR_NORM64(m, e);
+
+    // Scale down to [2^54, 2^55) keeping the dropped bits as sticky
+    m |= ((uint32_t)m & 0x1FF) + 0x1FF;
+    m >>= 9;
+
+    // i = 0 gives m = 0 and e = 0
+    uint32_t t = (uint32_t)((uint64_t)(i | -i) >> 63);
+    m &= -(uint64_t)t;
+    e &= -(int)t;
+
+    return FPR(s, e, m);
+}
+
+fpr fpr_add(fpr x, fpr y) {
+    // Swap so that |x| >= |y|; on a tie with x negative, swap too so
+    // that x + (-x) yields +0
+    uint64_t m = ((uint64_t)1 << 63) - 1;
+    uint64_t za = (x & m) - (y & m);
+    uint32_t cs = (uint32_t)(za >> 63)
+        | ((1U - (uint32_t)(-za >> 63)) & (uint32_t)(x >> 63));
+    m = (x ^ y) & -(uint64_t)cs;
+    x ^= m;
+    y ^= m;
+
+    // Mantissas scaled to [2^55, 2^56); zero operands get a zero mantissa
+    int ex = (int)(x >> 52);
+    int sx = ex >> 11;
+    ex &= 0x7FF;
+    m = (uint64_t)(uint32_t)((ex + 0x7FF) >> 11) << 52;
+    uint64_t xu = ((x & (((uint64_t)1 << 52) - 1)) | m) << 3;
+    ex -= 1078;
+    int ey = (int)(y >> 52);
+    int sy = ey >> 11;
+    ey &= 0x7FF;
+    m = (uint64_t)(uint32_t)((ey + 0x7FF) >> 11) << 52;
+    uint64_t yu = ((y & (((uint64_t)1 << 52) - 1)) | m) << 3;
+    ey -= 1078;
+
+    // Align y on x; beyond 59 bits y only matters as a sticky bit of zero
+    int cc = ex - ey;
+    yu &= -(uint64_t)((uint32_t)(cc - 60) >> 31);
+    cc &= 63;
+    m = fpr_ulsh(1, cc) - 1;
+    yu |= (yu & m) + m;
+    yu = fpr_ursh(yu, cc);
+
+    // Add or subtract depending on the signs
+    xu += yu - ((yu << 1) & -(uint64_t)(sx ^ sy));
+
+    FPR_NORM64(xu, ex);
+    xu |= ((uint32_t)xu & 0x1FF) + 0x1FF;
+    xu >>= 9;
+    ex += 9;
+
+    return FPR(sx, ex, xu);
+}
+
+fpr fpr_mul(fpr x, fpr y) {
+    uint64_t xu = (x & (((uint64_t)1 << 52) - 1)) | ((uint64_t)1 << 52);
+    uint64_t yu = (y & (((uint64_t)1 << 52) - 1)) | ((uint64_t)1 << 52);
+
+    // 53x53-bit product with 25-bit low limbs, so that the low limbs only
+    // contribute to the sticky bit
+    uint32_t x0 = (uint32_t)xu & 0x01FFFFFF;
+    uint32_t x1 = (uint32_t)(xu >> 25);
+    uint32_t y0 = (uint32_t)yu & 0x01FFFFFF;
+    uint32_t y1 = (uint32_t)(yu >> 25);
+    uint64_t w = (uint64_t)x0 * (uint64_t)y0;
+    uint32_t z0 = (uint32_t)w & 0x01FFFFFF;
+    uint32_t z1 = (uint32_t)(w >> 25);
+    w = (uint64_t)x0 * (uint64_t)y1;
+    z1 += (uint32_t)w & 0x01FFFFFF;
+    uint32_t z2 = (uint32_t)(w >> 25);
+    w = (uint64_t)x1 * (uint64_t)y0;
+    z1 += (uint32_t)w & 0x01FFFFFF;
+    z2 += (uint32_t)(w >> 25);
+    uint64_t zu = (uint64_t)x1 * (uint64_t)y1;
+    z2 += (z1 >> 25);
+    z1 &= 0x01FFFFFF;
+    zu += z2;
+
+    // zu is in [2^54, 2^56); fold the low limbs into the sticky bit and
+    // normalize to [2^54, 2^55)
+    zu |= ((z0 | z1) + 0x01FFFFFF) >> 25;
+    uint64_t zv = (zu >> 1) | (zu & 1);
+    w = zu >> 55;
+    zu ^= (zu ^ zv) & -w;
+
+    // Biases: 2 * (1023 + 52) for the operands, +50 for the dropped limbs
+    int ex = (int)((x >> 52) & 0x7FF);
+    int ey = (int)((y >> 52) & 0x7FF);
+    int e = ex + ey - 2100 + (int)w;
+    int s = (int)((x ^ y) >> 63);
+
+    // Either operand zero: force a zero mantissa
+    int d = ((ex + 0x7FF) & (ey + 0x7FF)) >> 11;
+    zu &= -(uint64_t)d;
+
+    return FPR(s, e, zu);
+}
+
+fpr fpr_div(fpr x, fpr y) {
+    uint64_t xu = (x & (((uint64_t)1 << 52) - 1)) | ((uint64_t)1 << 52);
+    uint64_t yu = (y & (((uint64_t)1 << 52) - 1)) | ((uint64_t)1 << 52);
+
+    // Restoring division, one quotient bit per iteration
+    uint64_t q = 0;
+    for (int i = 0; i < 55; i++) {
+        uint64_t b = ((xu - yu) >> 63) - 1;
+        xu -= b & yu;
+        q |= b & 1;
+        xu <<= 1;
+        q <<= 1;
+    }
+
+    // Sticky bit from the remainder, then normalize to [2^54, 2^55)
+    q |= (xu | -xu) >> 63;
+    uint64_t q2 = (q >> 1) | (q & 1);
+    uint64_t w = q >> 55;
+    q ^= (q ^ q2) & -w;
+
+    int ex = (int)((x >> 52) & 0x7FF);
+    int ey = (int)((y >> 52) & 0x7FF);
+    int e = ex - ey - 55 + (int)w;
+    int s = (int)((x ^ y) >> 63);
+
+    // x = 0 gives +0; division by zero is never performed
+    int d = (ex + 0x7FF) >> 11;
+    s &= d;
+    e &= -d;
+    q &= -(uint64_t)d;
+
+    return FPR(s, e, q);
+}
+
+fpr fpr_sqrt(fpr x) {
+    // The operand is non-negative by construction; the sign is ignored
+    uint64_t xu = (x & (((uint64_t)1 << 52) - 1)) | ((uint64_t)1 << 52);
+    int ex = (int)((x >> 52) & 0x7FF);
+    int e = ex - 1023;
+
+    // Make the exponent even, then halve it
+    xu += xu & -(uint64_t)(e & 1);
+    e >>= 1;
+    xu <<= 1;
+
+    // Bit-by-bit square root of xu, a fixed-point value in [1, 4)
+    uint64_t q = 0, s = 0, r = (uint64_t)1 << 53;
+    for (int i = 0; i < 54; i++) {
+        uint64_t t = s + r;
+        uint64_t b = ((xu - t) >> 63) - 1;
+        s += (r << 1) & b;
+        xu -= t & b;
+        q += r & b;
+        xu <<= 1;
+        r >>= 1;
+    }
+
+    // Guard bit plus sticky bit from the remainder
+    q <<= 1;
+    q |= (xu | -xu) >> 63;
+    e -= 54;
+
+    q &= -(uint64_t)((ex + 0x7FF) >> 11);
+    return FPR(0, e, q);
+}
+
+int64_t fpr_rint(fpr x) {
+    // Mantissa as a 63-bit integer, to be right-shifted by e
+    uint64_t m = ((x << 10) | ((uint64_t)1 << 62)) & (((uint64_t)1 << 63) - 1);
+    int e = 1085 - ((int)(x >> 52) & 0x7FF);
+
+    // Shifts of 64 or more (including zero inputs) give 0
+    m &= -(uint64_t)((uint32_t)(e - 64) >> 31);
+    e &= 63;
+
+    // Reduce the dropped bits and the lowest kept bit to three bits
+    // (kept, half, sticky) and round to nearest even
+    uint64_t d = fpr_ulsh(m, 63 - e);
+    uint32_t dd = (uint32_t)d | ((uint32_t)(d >> 32) & 0x1FFFFFFF);
+    uint32_t f = (uint32_t)(d >> 61) | ((dd | -dd) >> 31);
+    m = fpr_ursh(m, e) + (uint64_t)((0xC8U >> f) & 1U);
+
+    uint32_t s = (uint32_t)(x >> 63);
+    return ((int64_t)m ^ -(int64_t)s) + (int64_t)s;
+}
+
+int64_t fpr_floor(fpr x) {
+    // Signed mantissa in [2^62, 2^63), then an arithmetic right shift
+    int e = (int)(x >> 52) & 0x7FF;
+    uint64_t t = x >> 63;
+    int64_t xi = (int64_t)(((x << 10) | ((uint64_t)1 << 62))
+        & (((uint64_t)1 << 63) - 1));
+    xi = (xi ^ -(int64_t)t) + (int64_t)t;
+    int cc = 1085 - e;
+    xi = fpr_irsh(xi, cc & 63);
+
+    // Shifts of 64 or more give 0 or -1 depending on the sign
+    xi ^= (xi ^ -(int64_t)t) & -(int64_t)((uint32_t)(63 - cc) >> 31);
+    return xi;
+}
+
+int64_t fpr_trunc(fpr x) {
+    int e = (int)(x >> 52) & 0x7FF;
+    uint64_t xu = ((x << 10) | ((uint64_t)1 << 62)) & (((uint64_t)1 << 63) - 1);
+    int cc = 1085 - e;
+    xu = fpr_ursh(xu, cc & 63);
+    xu &= -(uint64_t)((uint32_t)(cc - 64) >> 31);
+
+    uint64_t t = x >> 63;
+    xu = (xu ^ -t) + t;
+    return (int64_t)xu;
+}
+
+#else /* PQC_FALCON_NATIVE_FPR */
+
+// ============================================================================
+// Native Operations
+// ============================================================================
+
+#include <math.h>
+
+fpr fpr_scaled(int64_t i, int sc) {
+    fpr x = { ldexp((double)i, sc) };
+    return x;
+}
+
+fpr fpr_sqrt(fpr x) {
+    fpr z = { sqrt(x.v) };
+    return z;
+}
+
+int64_t fpr_rint(fpr x) {
+    // Adding and subtracting 2^52 rounds to nearest even without
+    // depending on the current rounding-mode functions
+    double a = x.v < 0.0 ? -x.v : x.v;
+    double r = (a + 4503599627370496.0) - 4503599627370496.0;
+    if (a >= 4503599627370496.0) {
+        r = a;
+    }
+    int64_t i = (int64_t)r;
+    return x.v < 0.0 ? -i : i;
+}
+
+int64_t fpr_floor(fpr x) {
+    int64_t i = (int64_t)x.v;
+    return i - (x.v < (double)i);
+}
+
+int64_t fpr_trunc(fpr x) {
+    return (int64_t)x.v;
+}
+
+#endif /* PQC_FALCON_NATIVE_FPR */
+
+// ============================================================================
+// Exponential
+// ============================================================================
+
+/**
+ * @brief High 64 bits of the 128-bit product x * y, from 32-bit halves
+ */
+static inline uint64_t mulhi64(uint64_t x, uint64_t y) {
+    uint32_t x0 = (uint32_t)x;
+    uint32_t x1 = (uint32_t)(x >> 32);
+    uint32_t y0 = (uint32_t)y;
+    uint32_t y1 = (uint32_t)(y >> 32);
+    uint64_t a = ((uint64_t)x0 * (uint64_t)y1) + (((uint64_t)x0 * (uint64_t)y0) >> 32);
+    uint64_t b = (uint64_t)x1 * (uint64_t)y0;
+    uint64_t c = (a >> 32) + (b >> 32);
+    c += ((uint64_t)(uint32_t)a + (uint64_t)(uint32_t)b) >> 32;
+    c += (uint64_t)x1 * (uint64_t)y1;
+    return c;
+}
+
+uint64_t fpr_expm_p63(fpr x, fpr ccs) {
+    // Polynomial approximation of exp(-x) on [0, ln 2], coefficients
+    // scaled by 2^63 (error below 2^-51), evaluated with Horner's rule
+    static const uint64_t C[] = {
+        UINT64_C(0x00000004741183A3),
+        UINT64_C(0x00000036548CFC06),
+        UINT64_C(0x0000024FDCBF140A),
+        UINT64_C(0x0000171D939DE045),
+        UINT64_C(0x0000D00CF58F6F84),
+        UINT64_C(0x000680681CF796E3),
+        UINT64_C(0x002D82D8305B0FEA),
+        UINT64_C(0x011111110E066FD0),
+        UINT64_C(0x0555555555070F00),
+        UINT64_C(0x155555555581FF00),
+        UINT64_C(0x400000000002B400),
+        UINT64_C(0x7FFFFFFFFFFF4800),
+        UINT64_C(0x8000000000000000)
+    };
+
+    uint64_t y = C[0];
+    uint64_t z = (uint64_t)fpr_trunc(fpr_mul(x, fpr_ptwo63)) << 1;
+    for (size_t u = 1; u < sizeof(C) / sizeof(C[0]); u++) {
+        y = C[u] - mulhi64(z, y);
+    }
+
+    // Final scaling by ccs
+    z = (uint64_t)fpr_trunc(fpr_mul(ccs, fpr_ptwo63)) << 1;
+    y = mulhi64(z, y);
+    return y;
+}
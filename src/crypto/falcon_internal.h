@@ -0,0 +1,246 @@
+/**
+ * @file falcon_internal.h
+ * @brief Internal interfaces shared by the Falcon implementation files
+ *
+ * Floating-point arithmetic goes through the fpr type. By default fpr is
+ * an IEEE-754 binary64 bit pattern and every operation is emulated with
+ * constant-time integer code, so signing does not depend on the timing
+ * of the FPU (or on having one). Build with PQC_FALCON_NATIVE_FPR to use
+ * the hardware double type instead on cores whose FPU is known to run in
+ * constant time. Subnormals are flushed to zero and infinities/NaNs are
+ * not handled; Falcon never produces them.
+ *
+ * FFT-domain polynomials of degree n = 2^logn use n fpr values: the
+ * polynomial is real, so only n/2 of its evaluations are stored (the
+ * others are their conjugates), real parts in f[0..n/2) and imaginary
+ * parts in f[n/2..n). Value j is f(w_j) with w_j = exp(i*pi*(2*brev(j)+1)/n)
+ * and brev the bit reversal over logn bits, so consecutive pairs
+ * (2k, 2k+1) are evaluations at opposite roots, which is what
+ * falcon_split_fft()/falcon_merge_fft() rely on.
+ */
+
+#ifndef FALCON_INTERNAL_H
+#define FALCON_INTERNAL_H
+
+#include "pqc_common.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Parameters
+// ============================================================================
+
+#define FALCON_Q                12289
+#define FALCON_MAX_LOGN         10
+#define FALCON_MAX_N            (1 << FALCON_MAX_LOGN)
+
+// ============================================================================
+// Floating Point
+// ============================================================================
+
+#ifdef PQC_FALCON_NATIVE_FPR
+
+typedef struct { double v; } fpr;
+#define FPR_C(bits, value)      { value }
+
+static inline fpr fpr_of(int64_t i) { fpr x = { (double)i }; return x; }
+static inline fpr fpr_add(fpr x, fpr y) { fpr z = { x.v + y.v }; return z; }
+static inline fpr fpr_sub(fpr x, fpr y) { fpr z = { x.v - y.v }; return z; }
+static inline fpr fpr_mul(fpr x, fpr y) { fpr z = { x.v * y.v }; return z; }
+static inline fpr fpr_div(fpr x, fpr y) { fpr z = { x.v / y.v }; return z; }
+static inline fpr fpr_neg(fpr x) { fpr z = { -x.v }; return z; }
+static inline fpr fpr_half(fpr x) { fpr z = { x.v * 0.5 }; return z; }
+static inline fpr fpr_double(fpr x) { fpr z = { x.v + x.v }; return z; }
+static inline int fpr_lt(fpr x, fpr y) { return x.v < y.v; }
+fpr fpr_scaled(int64_t i, int sc);
+fpr fpr_sqrt(fpr x);
+int64_t fpr_rint(fpr x);
+int64_t fpr_floor(fpr x);
+int64_t fpr_trunc(fpr x);
+
+#else
+
+typedef uint64_t fpr;
+#define FPR_C(bits, value)      UINT64_C(bits)
+
+fpr fpr_scaled(int64_t i, int sc);
+fpr fpr_add(fpr x, fpr y);
+fpr fpr_mul(fpr x, fpr y);
+fpr fpr_div(fpr x, fpr y);
+fpr fpr_sqrt(fpr x);
+int64_t fpr_rint(fpr x);
+int64_t fpr_floor(fpr x);
+int64_t fpr_trunc(fpr x);
+
+static inline fpr fpr_of(int64_t i) {
+    return fpr_scaled(i, 0);
+}
+
+static inline fpr fpr_neg(fpr x) {
+    return x ^ ((uint64_t)1 << 63);
+}
+
+static inline fpr fpr_sub(fpr x, fpr y) {
+    return fpr_add(x, fpr_neg(y));
+}
+
+static inline fpr fpr_half(fpr x) {
+    // Decrement the exponent; zero (or an exponent that underflows) stays zero
+    x -= (uint64_t)1 << 52;
+    uint32_t t = (((uint32_t)(x >> 52) & 0x7FF) + 1) >> 11;
+    return x & ((uint64_t)t - 1);
+}
+
+static inline fpr fpr_double(fpr x) {
+    // Increment the exponent unless x is zero
+    return x + ((uint64_t)((((uint32_t)(x >> 52) & 0x7FF) + 0x7FF) >> 11) << 52);
+}
+
+static inline int fpr_lt(fpr x, fpr y) {
+    // Signed comparison of the bit patterns, reversed when both are negative
+    int64_t sx = (int64_t)x;
+    int64_t sy = (int64_t)y;
+    sy &= ~((sx ^ sy) >> 63);
+    int cc0 = (int)((uint64_t)(sx - sy) >> 63);
+    int cc1 = (int)((uint64_t)(sy - sx) >> 63);
+    return cc0 ^ ((cc0 ^ cc1) & (int)((x & y) >> 63));
+}
+
+#endif /* PQC_FALCON_NATIVE_FPR */
+
+static inline fpr fpr_sqr(fpr x) {
+    return fpr_mul(x, x);
+}
+
+/**
+ * @brief Compute ccs * exp(-x) * 2^63 for x in [0, ln 2], ccs in [0, 1]
+ *
+ * Integer polynomial evaluation; used by the Bernoulli sampler.
+ */
+uint64_t fpr_expm_p63(fpr x, fpr ccs);
+
+extern const fpr fpr_zero;
+extern const fpr fpr_one;
+extern const fpr fpr_q;
+extern const fpr fpr_inv_q;
+
+// ============================================================================
+// FFT
+// ============================================================================
+
+/**
+ * @brief Forward FFT of a real polynomial
+ *
+ * @param[in,out] f n coefficients in, n/2 complex values out (see file doc)
+ * @param[in] logn log2 of the degree (0..FALCON_MAX_LOGN)
+ */
+void falcon_fft(fpr *f, unsigned logn);
+
+/**
+ * @brief Inverse FFT
+ */
+void falcon_ifft(fpr *f, unsigned logn);
+
+void falcon_poly_add(fpr *a, const fpr *b, unsigned logn);
+void falcon_poly_sub(fpr *a, const fpr *b, unsigned logn);
+void falcon_poly_neg(fpr *a, unsigned logn);
+void falcon_poly_adj_fft(fpr *a, unsigned logn);
+void falcon_poly_mul_fft(fpr *a, const fpr *b, unsigned logn);
+void falcon_poly_muladj_fft(fpr *a, const fpr *b, unsigned logn);
+void falcon_poly_mulselfadj_fft(fpr *a, unsigned logn);
+void falcon_poly_mulconst(fpr *a, fpr x, unsigned logn);
+void falcon_poly_div_fft(fpr *a, const fpr *b, unsigned logn);
+
+/**
+ * @brief d = 1 / (a * adj(a) + b * adj(b)); only the n/2 real parts are written
+ */
+void falcon_poly_invnorm2_fft(fpr *d, const fpr *a, const fpr *b, unsigned logn);
+
+/**
+ * @brief d = F * adj(f) + G * adj(g)
+ */
+void falcon_poly_add_muladj_fft(fpr *d, const fpr *F, const fpr *G,
+                                const fpr *f, const fpr *g, unsigned logn);
+
+/**
+ * @brief Multiply a by a self-adjoint polynomial b given by its n/2 real parts
+ */
+void falcon_poly_mul_autoadj_fft(fpr *a, const fpr *b, unsigned logn);
+
+/**
+ * @brief LDL decomposition of the self-adjoint Gram matrix [[g00, g01], [adj(g01), g11]]
+ *
+ * On output g01 holds L10 = adj(g01)/g00 and g11 holds D11 = g11 - |g01|^2/g00.
+ */
+void falcon_poly_LDL_fft(const fpr *g00, fpr *g01, fpr *g11, unsigned logn);
+
+/**
+ * @brief Split f(x) = f0(x^2) + x*f1(x^2) in the FFT domain
+ *
+ * @param[out] f0 FFT of f0 (degree n/2)
+ * @param[out] f1 FFT of f1 (degree n/2)
+ * @param[in] f FFT of f (logn >= 1)
+ * @param[in] logn log2 of the degree of f
+ */
+void falcon_split_fft(fpr *f0, fpr *f1, const fpr *f, unsigned logn);
+
+/**
+ * @brief Inverse of falcon_split_fft()
+ */
+void falcon_merge_fft(fpr *f, const fpr *f0, const fpr *f1, unsigned logn);
+
+// ============================================================================
+// Sampling
+// ============================================================================
+
+#define FALCON_PRNG_SEEDBYTES   48
+#define FALCON_PRNG_BUFFER      512
+
+/**
+ * @brief SHAKE-256 based generator for the samplers
+ */
+typedef struct {
+    uint8_t buf[FALCON_PRNG_BUFFER];
+    size_t pos;
+    uint8_t seed[64];
+    uint64_t counter;
+} falcon_prng_t;
+
+void falcon_prng_init(falcon_prng_t *prng, const uint8_t *seed, size_t seedlen);
+uint8_t falcon_prng_u8(falcon_prng_t *prng);
+uint64_t falcon_prng_u64(falcon_prng_t *prng);
+
+// ============================================================================
+// Arithmetic Modulo q
+// ============================================================================
+
+void falcon_mq_ntt(uint16_t *a, unsigned logn);
+void falcon_mq_intt(uint16_t *a, unsigned logn);
+uint32_t falcon_mq_mul(uint32_t a, uint32_t b);
+uint32_t falcon_mq_inv(uint32_t a);
+
+// ============================================================================
+// Key Generation
+// ============================================================================
+
+/**
+ * @brief Generate a Falcon key (f, g, F, G) and public key h = g/f mod q
+ *
+ * @param[out] f, g, F, G Secret polynomials (n coefficients each)
+ * @param[out] h Public key polynomial (n coefficients, in [0, q))
+ * @param[in] logn 9 or 10
+ * @param[in] prng Seeded generator
+ * @return PQC_SUCCESS on success, error code on failure
+ */
+pqc_result_t falcon_keygen(int8_t *f, int8_t *g, int8_t *F, int8_t *G, uint16_t *h,
+                           unsigned logn, falcon_prng_t *prng);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FALCON_INTERNAL_H */
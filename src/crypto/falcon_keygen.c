@@ -0,0 +1,852 @@
+/**
+ * @file falcon_keygen.c
+ * @brief Falcon key generation (NTRU equation solver)
+ *
+ * Samples short polynomials f, g and solves f*G - g*F = q with the
+ * recursive field-norm algorithm: f and g are repeatedly replaced by
+ * their field norms down to degree 1, the equation is solved there with
+ * an extended GCD, and the solution is lifted back level by level with a
+ * Babai reduction at each step to keep F and G short. Intermediate values
+ * are multi-thousand-bit integers, held as fixed-width two's complement
+ * numbers in 32-bit limbs.
+ *
+ * Key generation is not constant-time: sizes and iteration counts depend
+ * on the secret key. It only runs during provisioning.
+ */
+
+#include "falcon_internal.h"
+#include "secure_memory.h"
+#include <string.h>
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+/** Roughly one candidate (f, g) in twenty passes the norm checks and solves */
+#define FALCON_KEYGEN_MAX_TRIES     1024
+#define FALCON_BABAI_MAX_ROUNDS     4096
+#define FALCON_BABAI_K_BITS         30
+
+/**
+ * @brief 2^63 * Pr[|X| >= k], k = 1..26, for X a discrete Gaussian of
+ * standard deviation 1.17 * sqrt(q / 2048)
+ *
+ * Coefficients of f and g for degree n are sums of 1024/n such samples.
+ */
+static const uint64_t keygen_cdt[] = {
+    UINT64_C(0x6E2EC827D20D54A7), UINT64_C(0x4CA71379D0D44E74),
+    UINT64_C(0x30B8137BD96BCCF5), UINT64_C(0x1C1D82B0C61FB6DB),
+    UINT64_C(0x0EA8F1A2E8A80D59), UINT64_C(0x06E14E41D01BF047),
+    UINT64_C(0x02E5BE00E3FC0FB7), UINT64_C(0x0117A1A6BD470417),
+    UINT64_C(0x005E30BF367966C1), UINT64_C(0x001C4DEA0BD5921B),
+    UINT64_C(0x000794225CD14A1E), UINT64_C(0x0001CE69617DF12A),
+    UINT64_C(0x00006205F2DEBAFA), UINT64_C(0x00001278063F6C50),
+    UINT64_C(0x00000317547AF83B), UINT64_C(0x00000075990F1DDB),
+    UINT64_C(0x0000000F82C483BF), UINT64_C(0x00000001D0AF3998),
+    UINT64_C(0x00000000303C51DB), UINT64_C(0x000000000470AEA1),
+    UINT64_C(0x00000000005CC4D1), UINT64_C(0x000000000006B625),
+    UINT64_C(0x0000000000006E2B), UINT64_C(0x0000000000000642),
+    UINT64_C(0x0000000000000050), UINT64_C(0x0000000000000003)
+};
+
+/** Squared norm bound for (g, -f) and for the orthogonalized basis: (1.17)^2 * q */
+static const fpr fpr_bnorm_max = FPR_C(0x40D06D9A5FD8ADAC, 16822.4121);
+
+// ============================================================================
+// Big Integers
+// ============================================================================
+
+/**
+ * @brief Polynomial with big-integer coefficients
+ *
+ * Coefficient i occupies c[i*len .. i*len + len), little-endian 32-bit
+ * limbs, two's complement.
+ */
+typedef struct {
+    uint32_t *c;
+    size_t m;
+    size_t len;
+    size_t bytes;   /**< Allocated size; bp_trim() lowers len but not this */
+} bigpoly_t;
+
+static int bp_alloc(bigpoly_t *p, size_t m, size_t len) {
+    p->m = m;
+    p->len = len;
+    p->bytes = m * len * sizeof(uint32_t);
+    p->c = secure_malloc(p->bytes);
+    if (!p->c) {
+        return -1;
+    }
+    memset(p->c, 0, p->bytes);
+    return 0;
+}
+
+static void bp_free(bigpoly_t *p) {
+    if (p->c) {
+        secure_free(p->c, p->bytes);
+        p->c = NULL;
+    }
+}
+
+static inline uint32_t big_sign(const uint32_t *a, size_t len) {
+    return -(a[len - 1] >> 31);
+}
+
+/**
+ * @brief d +/-= a * k (mod 2^(32*dlen)), with a signed and k unsigned
+ */
+static void big_addmul_small(uint32_t *d, size_t dlen, const uint32_t *a, size_t alen,
+                             uint32_t k, int sub) {
+    uint32_t ext = big_sign(a, alen);
+    uint64_t mc = 0;
+    uint32_t ac = 0;
+
+    for (size_t i = 0; i < dlen; i++) {
+        uint32_t aw = i < alen ? a[i] : ext;
+        uint64_t z = (uint64_t)aw * k + mc;
+        mc = z >> 32;
+        uint64_t s;
+        if (sub) {
+            s = (uint64_t)d[i] - (uint32_t)z - ac;
+            ac = (uint32_t)(s >> 63);
+        } else {
+            s = (uint64_t)d[i] + (uint32_t)z + ac;
+            ac = (uint32_t)(s >> 32);
+        }
+        d[i] = (uint32_t)s;
+    }
+}
+
+/**
+ * @brief d +/-= a * b for signed a and b
+ *
+ * b = b_unsigned - 2^(32*blen) when b is negative, which is applied as a
+ * correction on the high limbs.
+ */
+static void big_addmul(uint32_t *d, size_t dlen, const uint32_t *a, size_t alen,
+                       const uint32_t *b, size_t blen, int sub) {
+    for (size_t j = 0; j < blen && j < dlen; j++) {
+        big_addmul_small(d + j, dlen - j, a, alen, b[j], sub);
+    }
+    if (big_sign(b, blen) && blen < dlen) {
+        big_addmul_small(d + blen, dlen - blen, a, alen, 1, !sub);
+    }
+}
+
+/**
+ * @brief d -= a * 2^sh (mod 2^(32*dlen)), a signed
+ */
+static void big_sub_shifted(uint32_t *d, size_t dlen, const uint32_t *a, size_t alen,
+                            unsigned sh) {
+    size_t sw = sh >> 5;
+    unsigned sb = sh & 31;
+    uint32_t ext = big_sign(a, alen);
+    uint32_t prev = 0;
+    uint32_t bc = 0;
+
+    for (size_t i = sw; i < dlen; i++) {
+        size_t k = i - sw;
+        uint32_t w = k < alen ? a[k] : ext;
+        uint32_t v = sb ? (w << sb) | (prev >> (32 - sb)) : w;
+        prev = w;
+        uint64_t s = (uint64_t)d[i] - v - bc;
+        d[i] = (uint32_t)s;
+        bc = (uint32_t)(s >> 63);
+    }
+}
+
+static void big_add(uint32_t *d, const uint32_t *a, size_t len) {
+    uint32_t cc = 0;
+    for (size_t i = 0; i < len; i++) {
+        uint64_t s = (uint64_t)d[i] + a[i] + cc;
+        d[i] = (uint32_t)s;
+        cc = (uint32_t)(s >> 32);
+    }
+}
+
+static void big_sub(uint32_t *d, const uint32_t *a, size_t len) {
+    uint32_t bc = 0;
+    for (size_t i = 0; i < len; i++) {
+        uint64_t s = (uint64_t)d[i] - a[i] - bc;
+        d[i] = (uint32_t)s;
+        bc = (uint32_t)(s >> 63);
+    }
+}
+
+static void big_neg(uint32_t *a, size_t len) {
+    uint32_t cc = 1;
+    for (size_t i = 0; i < len; i++) {
+        uint64_t s = (uint64_t)(uint32_t)~a[i] + cc;
+        a[i] = (uint32_t)s;
+        cc = (uint32_t)(s >> 32);
+    }
+}
+
+static void big_rsh1(uint32_t *a, size_t len) {
+    for (size_t i = 0; i + 1 < len; i++) {
+        a[i] = (a[i] >> 1) | (a[i + 1] << 31);
+    }
+    a[len - 1] = (uint32_t)((int32_t)a[len - 1] >> 1);
+}
+
+static int big_is_zero(const uint32_t *a, size_t len) {
+    uint32_t r = 0;
+    for (size_t i = 0; i < len; i++) {
+        r |= a[i];
+    }
+    return r == 0;
+}
+
+/**
+ * @brief Compare two non-negative values; returns 1 if a >= b
+ */
+static int big_geq(const uint32_t *a, const uint32_t *b, size_t len) {
+    for (size_t i = len; i-- > 0;) {
+        if (a[i] != b[i]) {
+            return a[i] > b[i];
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Number of bits of |a| (of ~a for negative a), excluding the sign bit
+ */
+static unsigned big_bitlen(const uint32_t *a, size_t len) {
+    uint32_t s = big_sign(a, len);
+    for (size_t i = len; i-- > 0;) {
+        uint32_t w = a[i] ^ s;
+        if (w) {
+            unsigned b = 0;
+            while (w) {
+                b++;
+                w >>= 1;
+            }
+            return (unsigned)(i * 32) + b;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief floor(a / 2^sh) as an fpr; the quotient must fit in 63 bits
+ */
+static fpr big_to_fpr(const uint32_t *a, size_t len, unsigned sh) {
+    size_t sw = sh >> 5;
+    unsigned sb = sh & 31;
+    uint32_t ext = big_sign(a, len);
+    uint32_t w[3];
+
+    for (size_t i = 0; i < 3; i++) {
+        w[i] = sw + i < len ? a[sw + i] : ext;
+    }
+    uint64_t lo = (uint64_t)w[0] | ((uint64_t)w[1] << 32);
+    uint64_t v = sb ? (lo >> sb) | ((uint64_t)w[2] << (64 - sb)) : lo;
+    return fpr_of((int64_t)v);
+}
+
+// ============================================================================
+// Big-Integer Polynomials
+// ============================================================================
+
+static unsigned bp_maxbits(const bigpoly_t *p) {
+    unsigned mb = 0;
+    for (size_t i = 0; i < p->m; i++) {
+        unsigned b = big_bitlen(p->c + i * p->len, p->len);
+        if (b > mb) {
+            mb = b;
+        }
+    }
+    return mb;
+}
+
+/**
+ * @brief Shrink the limb count to what the current values need
+ */
+static void bp_trim(bigpoly_t *p) {
+    size_t nl = (bp_maxbits(p) + 1 + 31) >> 5;
+    if (nl >= p->len) {
+        return;
+    }
+    size_t old = p->m * p->len * sizeof(uint32_t);
+    for (size_t i = 0; i < p->m; i++) {
+        memmove(p->c + i * nl, p->c + i * p->len, nl * sizeof(uint32_t));
+    }
+    secure_memzero(p->c + p->m * nl, old - p->m * nl * sizeof(uint32_t));
+    p->len = nl;
+}
+
+/**
+ * @brief d +/-= a * b mod (x^m + 1)
+ */
+static void bp_mul_acc(bigpoly_t *d, const bigpoly_t *a, const bigpoly_t *b, int sub) {
+    size_t m = d->m;
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < m; j++) {
+            size_t k = i + j;
+            int s = sub;
+            if (k >= m) {
+                k -= m;
+                s = !s;
+            }
+            big_addmul(d->c + k * d->len, d->len, a->c + i * a->len, a->len,
+                       b->c + j * b->len, b->len, s);
+        }
+    }
+}
+
+/**
+ * @brief Split p(x) = pe(x^2) + x*po(x^2)
+ */
+static void bp_split(bigpoly_t *pe, bigpoly_t *po, const bigpoly_t *p) {
+    size_t h = p->m >> 1;
+    for (size_t i = 0; i < h; i++) {
+        memcpy(pe->c + i * pe->len, p->c + (2 * i) * p->len, p->len * sizeof(uint32_t));
+        memcpy(po->c + i * po->len, p->c + (2 * i + 1) * p->len, p->len * sizeof(uint32_t));
+    }
+}
+
+/**
+ * @brief Field norm N(p)(y) = pe(y)^2 - y*po(y)^2 in Z[y]/(y^(m/2) + 1)
+ */
+static int bp_field_norm(bigpoly_t *d, const bigpoly_t *p) {
+    size_t h = p->m >> 1;
+    size_t len = 2 * p->len + 1;
+    bigpoly_t pe = { 0 }, po = { 0 }, t = { 0 };
+    int ret = -1;
+
+    if (bp_alloc(d, h, len) || bp_alloc(&pe, h, p->len) || bp_alloc(&po, h, p->len)
+        || bp_alloc(&t, h, len)) {
+        goto cleanup;
+    }
+    bp_split(&pe, &po, p);
+    bp_mul_acc(d, &pe, &pe, 0);
+    bp_mul_acc(&t, &po, &po, 0);
+
+    // Multiplying by y shifts coefficients up; the top one wraps negated
+    big_add(d->c, t.c + (h - 1) * len, len);
+    for (size_t i = 1; i < h; i++) {
+        big_sub(d->c + i * len, t.c + (i - 1) * len, len);
+    }
+    bp_trim(d);
+    ret = 0;
+
+cleanup:
+    bp_free(&pe);
+    bp_free(&po);
+    bp_free(&t);
+    return ret;
+}
+
+// ============================================================================
+// NTRU Solver
+// ============================================================================
+
+/**
+ * @brief Solve f*G - g*F = q for degree-1 f, g (plain integers)
+ */
+static int solve_bottom(bigpoly_t *F, bigpoly_t *G, const bigpoly_t *f, const bigpoly_t *g) {
+    size_t len = (f->len > g->len ? f->len : g->len) + 2;
+    uint32_t *buf = secure_malloc(8 * len * sizeof(uint32_t));
+    int ret = -1;
+
+    if (!buf) {
+        return -1;
+    }
+    memset(buf, 0, 8 * len * sizeof(uint32_t));
+    uint32_t *x = buf, *y = buf + len, *u = buf + 2 * len, *v = buf + 3 * len;
+    uint32_t *A = buf + 4 * len, *B = buf + 5 * len, *C = buf + 6 * len, *D = buf + 7 * len;
+
+    // x = |f|, y = |g| sign-extended to the working width
+    uint32_t sf = big_sign(f->c, f->len), sg = big_sign(g->c, g->len);
+    for (size_t i = 0; i < len; i++) {
+        x[i] = i < f->len ? f->c[i] : sf;
+        y[i] = i < g->len ? g->c[i] : sg;
+    }
+    if (sf) {
+        big_neg(x, len);
+    }
+    if (sg) {
+        big_neg(y, len);
+    }
+    if (big_is_zero(x, len) || big_is_zero(y, len) || (((x[0] | y[0]) & 1) == 0)) {
+        goto cleanup;
+    }
+
+    // Binary extended GCD (HAC 14.61): A*x + B*y = u, C*x + D*y = v
+    memcpy(u, x, len * sizeof(uint32_t));
+    memcpy(v, y, len * sizeof(uint32_t));
+    A[0] = 1;
+    D[0] = 1;
+    while (!big_is_zero(u, len)) {
+        while ((u[0] & 1) == 0) {
+            big_rsh1(u, len);
+            if ((A[0] | B[0]) & 1) {
+                big_add(A, y, len);
+                big_sub(B, x, len);
+            }
+            big_rsh1(A, len);
+            big_rsh1(B, len);
+        }
+        while ((v[0] & 1) == 0) {
+            big_rsh1(v, len);
+            if ((C[0] | D[0]) & 1) {
+                big_add(C, y, len);
+                big_sub(D, x, len);
+            }
+            big_rsh1(C, len);
+            big_rsh1(D, len);
+        }
+        if (big_geq(u, v, len)) {
+            big_sub(u, v, len);
+            big_sub(A, C, len);
+            big_sub(B, D, len);
+        } else {
+            big_sub(v, u, len);
+            big_sub(C, A, len);
+            big_sub(D, B, len);
+        }
+    }
+
+    // gcd(f, g) must be 1
+    if (v[0] != 1 || !big_is_zero(v + 1, len - 1)) {
+        goto cleanup;
+    }
+
+    // C*|f| + D*|g| = 1; fold the signs back in, then F = -q*D', G = q*C'
+    if (sf) {
+        big_neg(C, len);
+    }
+    if (sg) {
+        big_neg(D, len);
+    }
+    if (bp_alloc(F, 1, len + 1) || bp_alloc(G, 1, len + 1)) {
+        goto cleanup;
+    }
+    big_addmul_small(F->c, F->len, D, len, FALCON_Q, 1);
+    big_addmul_small(G->c, G->len, C, len, FALCON_Q, 0);
+    bp_trim(F);
+    bp_trim(G);
+    ret = 0;
+
+cleanup:
+    secure_free(buf, 8 * len * sizeof(uint32_t));
+    return ret;
+}
+
+/**
+ * @brief Lift a solution for (N(f), N(g)) to one for (f, g)
+ *
+ * F(x) = F'(x^2) * g(-x) and G(x) = G'(x^2) * f(-x).
+ */
+static int lift(bigpoly_t *F, bigpoly_t *G, const bigpoly_t *Fp, const bigpoly_t *Gp,
+                const bigpoly_t *f, const bigpoly_t *g) {
+    size_t m = f->m;
+    size_t h = m >> 1;
+    bigpoly_t fe = { 0 }, fo = { 0 }, ge = { 0 }, go = { 0 };
+    bigpoly_t te = { 0 }, to = { 0 };
+    int ret = -1;
+
+    size_t flen = Fp->len + g->len + 1;
+    size_t glen = Gp->len + f->len + 1;
+    size_t tlen = flen > glen ? flen : glen;
+
+    if (bp_alloc(&fe, h, f->len) || bp_alloc(&fo, h, f->len)
+        || bp_alloc(&ge, h, g->len) || bp_alloc(&go, h, g->len)
+        || bp_alloc(&te, h, tlen) || bp_alloc(&to, h, tlen)
+        || bp_alloc(F, m, flen) || bp_alloc(G, m, glen)) {
+        goto cleanup;
+    }
+    bp_split(&fe, &fo, f);
+    bp_split(&ge, &go, g);
+
+    // F: even part F'*ge, odd part -F'*go
+    te.len = to.len = flen;
+    bp_mul_acc(&te, Fp, &ge, 0);
+    bp_mul_acc(&to, Fp, &go, 1);
+    for (size_t i = 0; i < h; i++) {
+        memcpy(F->c + (2 * i) * flen, te.c + i * flen, flen * sizeof(uint32_t));
+        memcpy(F->c + (2 * i + 1) * flen, to.c + i * flen, flen * sizeof(uint32_t));
+    }
+
+    // G: even part G'*fe, odd part -G'*fo
+    memset(te.c, 0, h * tlen * sizeof(uint32_t));
+    memset(to.c, 0, h * tlen * sizeof(uint32_t));
+    te.len = to.len = glen;
+    bp_mul_acc(&te, Gp, &fe, 0);
+    bp_mul_acc(&to, Gp, &fo, 1);
+    for (size_t i = 0; i < h; i++) {
+        memcpy(G->c + (2 * i) * glen, te.c + i * glen, glen * sizeof(uint32_t));
+        memcpy(G->c + (2 * i + 1) * glen, to.c + i * glen, glen * sizeof(uint32_t));
+    }
+    te.len = to.len = tlen;
+    ret = 0;
+
+cleanup:
+    bp_free(&fe);
+    bp_free(&fo);
+    bp_free(&ge);
+    bp_free(&go);
+    bp_free(&te);
+    bp_free(&to);
+    return ret;
+}
+
+/**
+ * @brief Babai-reduce (F, G) against (f, g)
+ *
+ * Each round computes k ~ (F*adj(f) + G*adj(g)) / (f*adj(f) + g*adj(g))
+ * in floating point from the top bits of every value, rounds k*2^-s to
+ * integers small enough to be exact, and subtracts (k*f, k*g) * 2^s.
+ * Rounds stop once k is zero or an unscaled round no longer shrinks F, G.
+ */
+static int reduce(bigpoly_t *F, bigpoly_t *G, const bigpoly_t *f, const bigpoly_t *g,
+                  unsigned logn, fpr *tmp) {
+    size_t m = f->m;
+    fpr *rf = tmp, *rg = tmp + m, *rF = tmp + 2 * m, *rG = tmp + 3 * m, *rd = tmp + 4 * m;
+    size_t klen = (f->len > g->len ? f->len : g->len) + 2;
+    bigpoly_t kf = { 0 };
+    int32_t *k = NULL;
+    int ret = -1;
+
+    if (bp_alloc(&kf, m, klen)) {
+        return -1;
+    }
+    k = secure_malloc(m * sizeof(int32_t));
+    if (!k) {
+        goto cleanup;
+    }
+
+    // (f, g) scaled by 2^-sf, and 1 / (f*adj(f) + g*adj(g))
+    unsigned bfg = bp_maxbits(f);
+    unsigned bg = bp_maxbits(g);
+    bfg = bfg > bg ? bfg : bg;
+    unsigned sf = bfg > 62 ? bfg - 62 : 0;
+    for (size_t i = 0; i < m; i++) {
+        rf[i] = big_to_fpr(f->c + i * f->len, f->len, sf);
+        rg[i] = big_to_fpr(g->c + i * g->len, g->len, sf);
+    }
+    falcon_fft(rf, logn);
+    falcon_fft(rg, logn);
+    falcon_poly_invnorm2_fft(rd, rf, rg, logn);
+
+    unsigned bFG = bp_maxbits(F);
+    unsigned bG = bp_maxbits(G);
+    bFG = bFG > bG ? bFG : bG;
+    for (int round = 0; round < FALCON_BABAI_MAX_ROUNDS; round++) {
+        unsigned sF = bFG > 62 ? bFG - 62 : 0;
+        for (size_t i = 0; i < m; i++) {
+            rF[i] = big_to_fpr(F->c + i * F->len, F->len, sF);
+            rG[i] = big_to_fpr(G->c + i * G->len, G->len, sF);
+        }
+        falcon_fft(rF, logn);
+        falcon_fft(rG, logn);
+        falcon_poly_add_muladj_fft(rF, rF, rG, rf, rg, logn);
+        falcon_poly_mul_autoadj_fft(rF, rd, logn);
+        falcon_ifft(rF, logn);
+
+        // True k is rF * 2^(sF - sf); pick the smallest s >= 0 for which
+        // rF * 2^(sF - sf - s) stays below 2^30 in absolute value
+        fpr amax = fpr_zero;
+        for (size_t i = 0; i < m; i++) {
+            fpr a = fpr_lt(rF[i], fpr_zero) ? fpr_neg(rF[i]) : rF[i];
+            if (fpr_lt(amax, a)) {
+                amax = a;
+            }
+        }
+        int la = 0;
+        while (!fpr_lt(amax, fpr_one)) {
+            amax = fpr_half(amax);
+            la++;
+        }
+        int e = (int)sF - (int)sf;
+        unsigned s = e + la > FALCON_BABAI_K_BITS ? (unsigned)(e + la - FALCON_BABAI_K_BITS) : 0;
+        fpr scale = fpr_scaled(1, e - (int)s);
+
+        int nonzero = 0;
+        for (size_t i = 0; i < m; i++) {
+            k[i] = (int32_t)fpr_rint(fpr_mul(rF[i], scale));
+            nonzero |= k[i];
+        }
+        if (!nonzero) {
+            break;
+        }
+
+        // F -= (k*f) << s, G -= (k*g) << s
+        const bigpoly_t *src[2] = { f, g };
+        bigpoly_t *dst[2] = { F, G };
+        for (int w = 0; w < 2; w++) {
+            memset(kf.c, 0, m * klen * sizeof(uint32_t));
+            for (size_t i = 0; i < m; i++) {
+                const uint32_t *a = src[w]->c + i * src[w]->len;
+                for (size_t j = 0; j < m; j++) {
+                    if (!k[j]) {
+                        continue;
+                    }
+                    size_t t = i + j;
+                    int sub = k[j] < 0;
+                    if (t >= m) {
+                        t -= m;
+                        sub = !sub;
+                    }
+                    uint32_t ak = k[j] < 0 ? (uint32_t)0 - (uint32_t)k[j] : (uint32_t)k[j];
+                    big_addmul_small(kf.c + t * klen, klen, a, src[w]->len, ak, sub);
+                }
+            }
+            for (size_t i = 0; i < m; i++) {
+                big_sub_shifted(dst[w]->c + i * dst[w]->len, dst[w]->len,
+                                kf.c + i * klen, klen, s);
+            }
+        }
+
+        unsigned nb = bp_maxbits(F);
+        bG = bp_maxbits(G);
+        nb = nb > bG ? nb : bG;
+        if (nb >= bFG && s == 0) {
+            break;
+        }
+        bFG = nb < bFG ? nb : bFG;
+    }
+
+    bp_trim(F);
+    bp_trim(G);
+    ret = 0;
+
+cleanup:
+    if (k) {
+        secure_free(k, m * sizeof(int32_t));
+    }
+    bp_free(&kf);
+    return ret;
+}
+
+/**
+ * @brief Solve f*G - g*F = q with short F, G
+ *
+ * @return 0 on success, -1 if this (f, g) has no usable solution
+ */
+static int solve_ntru(int8_t *Fo, int8_t *Go, const int8_t *f, const int8_t *g, unsigned logn) {
+    size_t n = (size_t)1 << logn;
+    bigpoly_t fs[FALCON_MAX_LOGN + 1] = { { 0 } };
+    bigpoly_t gs[FALCON_MAX_LOGN + 1] = { { 0 } };
+    bigpoly_t F = { 0 }, G = { 0 }, Fn = { 0 }, Gn = { 0 };
+    fpr *tmp = NULL;
+    int ret = -1;
+
+    // Field norms down to degree 1
+    if (bp_alloc(&fs[0], n, 1) || bp_alloc(&gs[0], n, 1)) {
+        goto cleanup;
+    }
+    for (size_t i = 0; i < n; i++) {
+        fs[0].c[i] = (uint32_t)(int32_t)f[i];
+        gs[0].c[i] = (uint32_t)(int32_t)g[i];
+    }
+    for (unsigned d = 0; d < logn; d++) {
+        if (bp_field_norm(&fs[d + 1], &fs[d]) || bp_field_norm(&gs[d + 1], &gs[d])) {
+            goto cleanup;
+        }
+    }
+
+    if (solve_bottom(&F, &G, &fs[logn], &gs[logn])) {
+        goto cleanup;
+    }
+
+    tmp = secure_malloc(5 * n * sizeof(fpr));
+    if (!tmp) {
+        goto cleanup;
+    }
+
+    // Lift and reduce back up to degree n
+    for (unsigned d = logn; d-- > 0;) {
+        if (lift(&Fn, &Gn, &F, &G, &fs[d], &gs[d])) {
+            goto cleanup;
+        }
+        bp_free(&F);
+        bp_free(&G);
+        F = Fn;
+        G = Gn;
+        Fn.c = Gn.c = NULL;
+        if (reduce(&F, &G, &fs[d], &gs[d], logn - d, tmp)) {
+            goto cleanup;
+        }
+    }
+
+    // The top-level solution must fit the secret key encoding
+    for (size_t i = 0; i < n; i++) {
+        if (big_bitlen(F.c + i * F.len, F.len) > 7 || big_bitlen(G.c + i * G.len, G.len) > 7) {
+            goto cleanup;
+        }
+        int32_t Fi = (int32_t)F.c[i * F.len];
+        int32_t Gi = (int32_t)G.c[i * G.len];
+        if (Fi < -127 || Gi < -127) {
+            goto cleanup;
+        }
+        Fo[i] = (int8_t)Fi;
+        Go[i] = (int8_t)Gi;
+    }
+    ret = 0;
+
+cleanup:
+    for (unsigned d = 0; d <= logn; d++) {
+        bp_free(&fs[d]);
+        bp_free(&gs[d]);
+    }
+    bp_free(&F);
+    bp_free(&G);
+    bp_free(&Fn);
+    bp_free(&Gn);
+    if (tmp) {
+        secure_free(tmp, 5 * n * sizeof(fpr));
+    }
+    return ret;
+}
+
+// ============================================================================
+// Checks
+// ============================================================================
+
+/**
+ * @brief Exact check of f*G - g*F = q in Z[x]/(x^n + 1)
+ */
+static int check_ntru(const int8_t *f, const int8_t *g, const int8_t *F, const int8_t *G,
+                      unsigned logn, int32_t *acc) {
+    size_t n = (size_t)1 << logn;
+    memset(acc, 0, n * sizeof(int32_t));
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            int32_t z = (int32_t)f[i] * G[j] - (int32_t)g[i] * F[j];
+            size_t k = i + j;
+            if (k >= n) {
+                acc[k - n] -= z;
+            } else {
+                acc[k] += z;
+            }
+        }
+    }
+    if (acc[0] != FALCON_Q) {
+        return -1;
+    }
+    for (size_t i = 1; i < n; i++) {
+        if (acc[i] != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Check the Gram-Schmidt norm of the second basis vector
+ *
+ * (q * adj(f), q * adj(g)) / (f*adj(f) + g*adj(g)) must have squared norm
+ * below the same bound as (g, -f).
+ */
+static int check_orth_norm(const int8_t *f, const int8_t *g, unsigned logn, fpr *tmp) {
+    size_t n = (size_t)1 << logn;
+    fpr *rf = tmp, *rg = tmp + n, *rd = tmp + 2 * n;
+
+    for (size_t i = 0; i < n; i++) {
+        rf[i] = fpr_of(f[i]);
+        rg[i] = fpr_of(g[i]);
+    }
+    falcon_fft(rf, logn);
+    falcon_fft(rg, logn);
+    falcon_poly_invnorm2_fft(rd, rf, rg, logn);
+    falcon_poly_adj_fft(rf, logn);
+    falcon_poly_adj_fft(rg, logn);
+    falcon_poly_mulconst(rf, fpr_q, logn);
+    falcon_poly_mulconst(rg, fpr_q, logn);
+    falcon_poly_mul_autoadj_fft(rf, rd, logn);
+    falcon_poly_mul_autoadj_fft(rg, rd, logn);
+    falcon_ifft(rf, logn);
+    falcon_ifft(rg, logn);
+
+    fpr norm = fpr_zero;
+    for (size_t i = 0; i < n; i++) {
+        norm = fpr_add(norm, fpr_add(fpr_sqr(rf[i]), fpr_sqr(rg[i])));
+    }
+    return fpr_lt(norm, fpr_bnorm_max) ? 0 : -1;
+}
+
+// ============================================================================
+// Key Generation
+// ============================================================================
+
+static int sample_small(falcon_prng_t *prng, unsigned logn) {
+    int v = 0;
+    for (unsigned t = 0; t < (1U << (FALCON_MAX_LOGN - logn)); t++) {
+        uint64_t r = falcon_prng_u64(prng) & ((UINT64_C(1) << 63) - 1);
+        int neg = (int)(falcon_prng_u8(prng) & 1);
+        int z = 0;
+        for (size_t i = 0; i < sizeof(keygen_cdt) / sizeof(keygen_cdt[0]); i++) {
+            z += (int)((r - keygen_cdt[i]) >> 63);
+        }
+        v += neg ? -z : z;
+    }
+    return v;
+}
+
+pqc_result_t falcon_keygen(int8_t *f, int8_t *g, int8_t *F, int8_t *G, uint16_t *h,
+                           unsigned logn, falcon_prng_t *prng) {
+    size_t n = (size_t)1 << logn;
+    int lim = logn == 9 ? 31 : 15;
+    pqc_result_t result = PQC_ERROR_INTERNAL;
+    size_t tmp_size = 3 * n * sizeof(fpr);
+    if (tmp_size < 2 * n * sizeof(uint16_t) + n * sizeof(int32_t)) {
+        tmp_size = 2 * n * sizeof(uint16_t) + n * sizeof(int32_t);
+    }
+    void *tmp = secure_malloc(tmp_size);
+
+    if (!tmp) {
+        return PQC_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    for (int attempt = 0; attempt < FALCON_KEYGEN_MAX_TRIES; attempt++) {
+        // Short f, g within the secret key encoding range
+        int ok = 1;
+        int32_t sq = 0;
+        for (size_t i = 0; i < n; i++) {
+            int a = sample_small(prng, logn);
+            int b = sample_small(prng, logn);
+            ok &= (a >= -lim && a <= lim && b >= -lim && b <= lim);
+            f[i] = (int8_t)a;
+            g[i] = (int8_t)b;
+            sq += a * a + b * b;
+        }
+        if (!ok || sq >= 16823) {
+            continue;
+        }
+        if (check_orth_norm(f, g, logn, tmp)) {
+            continue;
+        }
+
+        // f must be invertible modulo q; h = g / f
+        uint16_t *tf = tmp, *tg = (uint16_t *)tmp + n;
+        for (size_t i = 0; i < n; i++) {
+            tf[i] = (uint16_t)(f[i] < 0 ? f[i] + FALCON_Q : f[i]);
+            tg[i] = (uint16_t)(g[i] < 0 ? g[i] + FALCON_Q : g[i]);
+        }
+        falcon_mq_ntt(tf, logn);
+        falcon_mq_ntt(tg, logn);
+        int inv = 1;
+        for (size_t i = 0; i < n; i++) {
+            inv &= tf[i] != 0;
+            h[i] = (uint16_t)falcon_mq_mul(tg[i], falcon_mq_inv(tf[i]));
+        }
+        if (!inv) {
+            continue;
+        }
+        falcon_mq_intt(h, logn);
+
+        if (solve_ntru(F, G, f, g, logn)) {
+            continue;
+        }
+        if (check_ntru(f, g, F, G, logn, (int32_t *)((uint16_t *)tmp + 2 * n))) {
+            continue;
+        }
+        result = PQC_SUCCESS;
+        break;
+    }
+
+    secure_free(tmp, tmp_size);
+    return result;
+}
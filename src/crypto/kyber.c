@@ -9,6 +9,10 @@
 
 #include "kyber.h"
 #include "pqc_common.h"
+#include "pqc_bytes.h"
+#include "pqc_ntt.h"
+#include "pqc_perf.h"
+#include "pqc_trace.h"
 #include "secure_memory.h"
 #include <string.h>
 
@@ -20,96 +24,145 @@
 #define KYBER_ETA2 2
 #define KYBER_DU 11
 #define KYBER_DV 5
-#define KYBER_QINV 62209
+#define KYBER_ROOT_OF_UNITY 17
+#define KYBER_MONT PQC_NTT_RADIX(16, KYBER_Q)   // 2^16 mod q
+#define KYBER_MONT2 PQC_NTT_MULMOD(KYBER_MONT, KYBER_MONT, KYBER_Q)   // 2^32 mod q
+
+// NTT constants, generated from q and the root of unity
+PQC_NTT_DEFINE_POWERS(KYBER_ROOT, KYBER_ROOT_OF_UNITY, KYBER_Q);
+
+_Static_assert(KYBER_ROOT_POW128 == KYBER_Q - 1, "17 must be a primitive 256-th root of unity mod q");
+_Static_assert((PQC_NTT_QINV32(KYBER_Q) & 0xFFFF) == KYBER_QINV, "KYBER_QINV must be q^-1 mod 2^16");
+
+// zetas[k] = mont * 17^brev7(k) mod q
+#define KYBER_ZETA(k) \
+    PQC_NTT_MONT(PQC_NTT_POW_BITREV(KYBER_ROOT, k, 7, KYBER_Q), KYBER_MONT, KYBER_Q)
+
+// Scaling folded into the last inverse NTT layer: mont^2/128 mod q
+#define KYBER_INVNTT_F \
+    PQC_NTT_MULMOD(PQC_NTT_MULMOD(KYBER_MONT, KYBER_MONT, KYBER_Q), PQC_NTT_INV_N(128, KYBER_Q), KYBER_Q)
+
+_Static_assert(KYBER_ZETA(1) == KYBER_Q - 758, "zetas must match the Kyber reference table");
+_Static_assert(KYBER_INVNTT_F == 1441, "inverse NTT scaling must match the Kyber reference");
 
 // Polynomial arithmetic constants
-static const uint16_t zetas[128] = {
-    2285, 2571, 2970, 1812, 1493, 1422, 287, 202,
-    3158, 622, 1577, 182, 962, 2127, 1855, 1468,
-    573, 2004, 264, 383, 2500, 1458, 1727, 3199,
-    2648, 1017, 732, 608, 1787, 411, 3124, 1758,
-    1223, 652, 2777, 1015, 2036, 1491, 3047, 1785,
-    516, 3321, 3009, 2663, 1711, 2167, 126, 1469,
-    2476, 3239, 3058, 830, 107, 1908, 3082, 2378,
-    2931, 961, 1821, 2604, 448, 2264, 677, 2054,
-    2226, 430, 555, 843, 2078, 871, 1550, 105,
-    422, 587, 177, 3094, 3038, 2869, 1574, 1653,
-    3083, 778, 1159, 3182, 2552, 1483, 2727, 1119,
-    1739, 644, 2457, 349, 418, 329, 3173, 3254,
-    817, 1097, 603, 610, 1322, 2044, 1864, 384,
-    2114, 3193, 1218, 1994, 2455, 220, 2142, 1670,
-    2144, 1799, 2051, 794, 1819, 2475, 2459, 478,
-    3221, 3021, 996, 991, 958, 1869, 1522, 1628
-};
+static const uint16_t zetas[128] = { PQC_NTT_REP128(KYBER_ZETA, 0) };
 
 /**
- * @brief Montgomery reduction for modular arithmetic
- * @param a Input value
- * @return Reduced value modulo q
+ * @brief Montgomery reduction
+ * @param a Input value, |a| < q * 2^15
+ * @return a * 2^-16 mod q, in (-q, q)
  */
-static inline uint16_t montgomery_reduce(uint32_t a) {
-    uint32_t t = (uint32_t)(int16_t)a * KYBER_QINV;
-    t &= ((1U << 16) - 1);
-    t *= KYBER_Q;
-    t = a - t;
-    return (uint16_t)(t >> 16);
+static inline int16_t montgomery_reduce(int32_t a) {
+    int16_t t = (int16_t)(uint16_t)((uint32_t)a * KYBER_QINV);
+    return (int16_t)((a - (int32_t)t * KYBER_Q) >> 16);
 }
 
 /**
- * @brief Barrett reduction for modular arithmetic
+ * @brief Barrett reduction
  * @param a Input value
- * @return Reduced value modulo q
+ * @return a mod q, centered in [-(q-1)/2, (q-1)/2]
+ */
+static inline int16_t barrett_reduce(int16_t a) {
+    const int32_t v = ((1 << 26) + KYBER_Q / 2) / KYBER_Q;
+    int16_t t = (int16_t)((v * a + (1 << 25)) >> 26);
+    return (int16_t)(a - t * KYBER_Q);
+}
+
+/**
+ * @brief Reduce to the canonical representative in [0, q)
+ */
+static inline int16_t freeze(int16_t a) {
+    a = barrett_reduce(a);
+    return (int16_t)(a + ((a >> 15) & KYBER_Q));
+}
+
+/**
+ * @brief Multiply in the Montgomery domain: a * b * 2^-16 mod q
  */
-static inline uint16_t barrett_reduce(uint16_t a) {
-    uint32_t t = ((uint32_t)a * 5039) >> 23;
-    return a - (uint16_t)(t * KYBER_Q);
+static inline int16_t fqmul(int16_t a, int16_t b) {
+    return montgomery_reduce((int32_t)a * b);
 }
 
 /**
- * @brief Number theoretic transform (NTT) for polynomial multiplication
+ * @brief Number theoretic transform, output in bit-reversed order
  * @param poly Polynomial coefficients to transform
  */
-static void ntt(uint16_t poly[KYBER_N]) {
-    int len, start, j, k;
-    uint16_t t, zeta;
+static void ntt(int16_t poly[KYBER_N]) {
+    int len, start, j, k = 1;
 
-    k = 1;
     for (len = 128; len >= 2; len >>= 1) {
         for (start = 0; start < KYBER_N; start = j + len) {
-            zeta = zetas[k++];
+            int16_t zeta = (int16_t)zetas[k++];
             for (j = start; j < start + len; j++) {
-                t = montgomery_reduce((uint32_t)zeta * poly[j + len]);
-                poly[j + len] = poly[j] - t;
-                poly[j] = poly[j] + t;
+                int16_t t = fqmul(zeta, poly[j + len]);
+                poly[j + len] = (int16_t)(poly[j] - t);
+                poly[j] = (int16_t)(poly[j] + t);
             }
         }
     }
+    for (j = 0; j < KYBER_N; j++) {
+        poly[j] = barrett_reduce(poly[j]);
+    }
 }
 
 /**
- * @brief Inverse number theoretic transform
+ * @brief Inverse number theoretic transform, multiplying by the Montgomery factor
  * @param poly Polynomial coefficients to transform
  */
-static void invntt(uint16_t poly[KYBER_N]) {
-    int len, start, j, k;
-    uint16_t t, zeta;
-    const uint16_t f = 1441; // mont^2/128
+static void invntt(int16_t poly[KYBER_N]) {
+    int len, start, j, k = 127;
+    const int16_t f = KYBER_INVNTT_F;
 
-    k = 127;
     for (len = 2; len <= 128; len <<= 1) {
         for (start = 0; start < KYBER_N; start = j + len) {
-            zeta = zetas[k--];
+            int16_t zeta = (int16_t)zetas[k--];
             for (j = start; j < start + len; j++) {
-                t = poly[j];
-                poly[j] = barrett_reduce(t + poly[j + len]);
-                poly[j + len] = t - poly[j + len];
-                poly[j + len] = montgomery_reduce((uint32_t)zeta * poly[j + len]);
+                int16_t t = poly[j];
+                poly[j] = barrett_reduce((int16_t)(t + poly[j + len]));
+                poly[j + len] = fqmul(zeta, (int16_t)(poly[j + len] - t));
             }
         }
     }
 
     for (j = 0; j < KYBER_N; j++) {
-        poly[j] = montgomery_reduce((uint32_t)f * poly[j]);
+        poly[j] = fqmul(poly[j], f);
+    }
+}
+
+/**
+ * @brief Multiply two degree-1 polynomials modulo X^2 - zeta
+ */
+static void basemul(int16_t r[2], const int16_t a[2], const int16_t b[2], int16_t zeta) {
+    r[0] = fqmul(fqmul(a[1], b[1]), zeta);
+    r[0] = (int16_t)(r[0] + fqmul(a[0], b[0]));
+    r[1] = (int16_t)(fqmul(a[0], b[1]) + fqmul(a[1], b[0]));
+}
+
+/**
+ * @brief Inner product of two NTT-domain vectors, times 2^-16
+ * @param r Output polynomial, reduced
+ * @param a First vector
+ * @param b Second vector
+ */
+static void polyvec_basemul_acc(int16_t r[KYBER_N], const int16_t a[KYBER_K][KYBER_N],
+                                const int16_t b[KYBER_K][KYBER_N]) {
+    int16_t t[2];
+
+    memset(r, 0, KYBER_N * sizeof(int16_t));
+    for (int i = 0; i < KYBER_K; i++) {
+        for (int j = 0; j < KYBER_N / 4; j++) {
+            int16_t zeta = (int16_t)zetas[64 + j];
+            basemul(t, &a[i][4 * j], &b[i][4 * j], zeta);
+            r[4 * j] = (int16_t)(r[4 * j] + t[0]);
+            r[4 * j + 1] = (int16_t)(r[4 * j + 1] + t[1]);
+            basemul(t, &a[i][4 * j + 2], &b[i][4 * j + 2], (int16_t)-zeta);
+            r[4 * j + 2] = (int16_t)(r[4 * j + 2] + t[0]);
+            r[4 * j + 3] = (int16_t)(r[4 * j + 3] + t[1]);
+        }
+    }
+    for (int j = 0; j < KYBER_N; j++) {
+        r[j] = barrett_reduce(r[j]);
     }
 }
 
@@ -119,7 +172,7 @@ static void invntt(uint16_t poly[KYBER_N]) {
  * @param seed Random seed
  * @param nonce Nonce for domain separation
  */
-static void poly_getnoise_eta1(uint16_t poly[KYBER_N], const uint8_t seed[32], uint8_t nonce) {
+static void poly_getnoise_eta1(int16_t poly[KYBER_N], const uint8_t seed[32], uint8_t nonce) {
     uint8_t buf[KYBER_ETA1 * KYBER_N / 4];
     uint32_t t, d;
     int i, j;
@@ -131,151 +184,322 @@ static void poly_getnoise_eta1(uint16_t poly[KYBER_N], const uint8_t seed[32], u
         t = buf[4 * i + 0] | ((uint32_t)buf[4 * i + 1] << 8) |
             ((uint32_t)buf[4 * i + 2] << 16) | ((uint32_t)buf[4 * i + 3] << 24);
 
+        d = t & 0x55555555;
+        d += (t >> 1) & 0x55555555;
         for (j = 0; j < 8; j++) {
-            d = t & 0x55555555;
-            d += (t >> 1) & 0x55555555;
-            
-            poly[8 * i + j] = ((d >> (4 * j + 0)) & 0x3) - ((d >> (4 * j + 2)) & 0x3);
+            poly[8 * i + j] = (int16_t)(((d >> (4 * j + 0)) & 0x3) - ((d >> (4 * j + 2)) & 0x3));
+        }
+    }
+}
+
+/**
+ * @brief Sample a uniform polynomial in Rq from the public seed
+ * @param poly Output polynomial
+ * @param seed Public seed
+ * @param x First matrix index byte
+ * @param y Second matrix index byte
+ */
+static void poly_uniform(int16_t poly[KYBER_N], const uint8_t seed[32], uint8_t x, uint8_t y) {
+    // Eight SHAKE-128 blocks yield 896 candidates for 256 coefficients
+    uint8_t buf[8 * 168];
+    uint8_t seed_ext[34];
+    memcpy(seed_ext, seed, 32);
+    seed_ext[32] = x;
+    seed_ext[33] = y;
+    shake128(buf, sizeof(buf), seed_ext, sizeof(seed_ext));
+
+    // Rejection sampling of 12-bit values, two per three bytes
+    size_t pos = 0;
+    int k = 0;
+    while (k < KYBER_N && pos + 3 <= sizeof(buf)) {
+        uint16_t d1 = buf[pos] | ((uint16_t)(buf[pos + 1] & 0x0F) << 8);
+        uint16_t d2 = (buf[pos + 1] >> 4) | ((uint16_t)buf[pos + 2] << 4);
+        pos += 3;
+        if (d1 < KYBER_Q) {
+            poly[k++] = (int16_t)d1;
+        }
+        if (d2 < KYBER_Q && k < KYBER_N) {
+            poly[k++] = (int16_t)d2;
+        }
+    }
+
+    // Running out of candidates has probability below 2^-200; stay in range if it happens
+    for (; k < KYBER_N; k++) {
+        poly[k] = (int16_t)(buf[k] % KYBER_Q);
+    }
+}
+
+/**
+ * @brief Expand the public seed into matrix A, already in the NTT domain
+ * @param A Output matrix
+ * @param seed Public seed
+ * @param transposed Generate A^T instead of A
+ */
+static void expand_matrix(int16_t A[KYBER_K][KYBER_K][KYBER_N], const uint8_t seed[32],
+                          int transposed) {
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_EXPAND_MATRIX);
+    for (int i = 0; i < KYBER_K; i++) {
+        for (int j = 0; j < KYBER_K; j++) {
+            if (transposed) {
+                poly_uniform(A[i][j], seed, (uint8_t)i, (uint8_t)j);
+            } else {
+                poly_uniform(A[i][j], seed, (uint8_t)j, (uint8_t)i);
+            }
         }
     }
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_EXPAND_MATRIX);
 }
 
 /**
- * @brief Polynomial addition in Rq
+ * @brief Polynomial addition in Rq, without reduction
  * @param c Output polynomial
  * @param a First input polynomial  
  * @param b Second input polynomial
  */
-static void poly_add(uint16_t c[KYBER_N], const uint16_t a[KYBER_N], const uint16_t b[KYBER_N]) {
+static void poly_add(int16_t c[KYBER_N], const int16_t a[KYBER_N], const int16_t b[KYBER_N]) {
     for (int i = 0; i < KYBER_N; i++) {
-        c[i] = barrett_reduce(a[i] + b[i]);
+        c[i] = (int16_t)(a[i] + b[i]);
     }
 }
 
 /**
- * @brief Polynomial subtraction in Rq
+ * @brief Polynomial subtraction in Rq, without reduction
  * @param c Output polynomial
  * @param a First input polynomial
  * @param b Second input polynomial  
  */
-static void poly_sub(uint16_t c[KYBER_N], const uint16_t a[KYBER_N], const uint16_t b[KYBER_N]) {
+static void poly_sub(int16_t c[KYBER_N], const int16_t a[KYBER_N], const int16_t b[KYBER_N]) {
     for (int i = 0; i < KYBER_N; i++) {
-        c[i] = barrett_reduce(a[i] - b[i] + KYBER_Q);
+        c[i] = (int16_t)(a[i] - b[i]);
+    }
+}
+
+/**
+ * @brief Serialize a polynomial with 12 bits per canonical coefficient
+ * @param r Output, 384 bytes
+ * @param a Input polynomial
+ */
+static void poly_tobytes(uint8_t r[KYBER_N * 3 / 2], const int16_t a[KYBER_N]) {
+    for (int i = 0; i < KYBER_N / 2; i++) {
+        uint16_t t0 = (uint16_t)freeze(a[2 * i]);
+        uint16_t t1 = (uint16_t)freeze(a[2 * i + 1]);
+        r[3 * i + 0] = (uint8_t)t0;
+        r[3 * i + 1] = (uint8_t)((t0 >> 8) | (t1 << 4));
+        r[3 * i + 2] = (uint8_t)(t1 >> 4);
     }
 }
 
 /**
- * @brief Matrix-vector multiplication in module lattice
- * @param t Output vector
- * @param A Matrix A
- * @param s Vector s
- * @param transposed Whether A is transposed
+ * @brief Deserialize a polynomial with 12 bits per coefficient
+ * @param r Output polynomial, coefficients in [0, 4096)
+ * @param a Input, 384 bytes
  */
-static void matrix_vector_mul(uint16_t t[KYBER_K][KYBER_N], 
-                             const uint16_t A[KYBER_K][KYBER_K][KYBER_N],
-                             const uint16_t s[KYBER_K][KYBER_N],
-                             int transposed) {
+static void poly_frombytes(int16_t r[KYBER_N], const uint8_t a[KYBER_N * 3 / 2]) {
+    for (int i = 0; i < KYBER_N / 2; i++) {
+        r[2 * i] = (int16_t)(a[3 * i + 0] | ((uint16_t)(a[3 * i + 1] & 0x0F) << 8));
+        r[2 * i + 1] = (int16_t)((a[3 * i + 1] >> 4) | ((uint16_t)a[3 * i + 2] << 4));
+    }
+}
+
+/**
+ * @brief Pack polynomial vector t and public seed into a public key
+ * @param pk Output public key
+ * @param t Polynomial vector t
+ * @param seed Public seed for matrix A
+ */
+static void pack_pk(kyber_public_key_t *pk, const int16_t t[KYBER_K][KYBER_N],
+                    const uint8_t seed[32]) {
+    memcpy(pk->seed, seed, 32);
     for (int i = 0; i < KYBER_K; i++) {
-        memset(t[i], 0, KYBER_N * sizeof(uint16_t));
-        for (int j = 0; j < KYBER_K; j++) {
-            uint16_t temp[KYBER_N];
-            memcpy(temp, A[transposed ? j : i][transposed ? i : j], KYBER_N * sizeof(uint16_t));
-            ntt(temp);
-            
-            uint16_t s_ntt[KYBER_N];
-            memcpy(s_ntt, s[j], KYBER_N * sizeof(uint16_t));
-            ntt(s_ntt);
-            
-            for (int k = 0; k < KYBER_N; k++) {
-                temp[k] = montgomery_reduce((uint32_t)temp[k] * s_ntt[k]);
-            }
-            
-            invntt(temp);
-            poly_add(t[i], t[i], temp);
+        poly_tobytes(pk->t + i * KYBER_N * 3 / 2, t[i]);
+    }
+}
+
+/**
+ * @brief Unpack polynomial vector t from a public key
+ * @param t Output polynomial vector
+ * @param pk Public key
+ */
+static void unpack_pk(int16_t t[KYBER_K][KYBER_N], const kyber_public_key_t *pk) {
+    for (int i = 0; i < KYBER_K; i++) {
+        poly_frombytes(t[i], pk->t + i * KYBER_N * 3 / 2);
+    }
+}
+
+/**
+ * @brief Compress coefficients to d bits and pack them little-endian
+ * @param r Output, n * d / 8 bytes
+ * @param a Input coefficients
+ * @param n Number of coefficients, a multiple of 8
+ * @param d Bits per compressed coefficient
+ */
+static void pack_compressed(uint8_t *r, const int16_t *a, int n, int d) {
+    uint32_t acc = 0;
+    int bits = 0;
+
+    for (int i = 0; i < n; i++) {
+        uint32_t x = (uint32_t)freeze(a[i]);
+        acc |= (uint32_t)((((x << d) + KYBER_Q / 2) / KYBER_Q) & ((1U << d) - 1)) << bits;
+        for (bits += d; bits >= 8; bits -= 8) {
+            *r++ = (uint8_t)acc;
+            acc >>= 8;
         }
     }
 }
 
+/**
+ * @brief Unpack d-bit values and decompress them to [0, q)
+ * @param r Output coefficients
+ * @param a Input, n * d / 8 bytes
+ * @param n Number of coefficients, a multiple of 8
+ * @param d Bits per compressed coefficient
+ */
+static void unpack_compressed(int16_t *r, const uint8_t *a, int n, int d) {
+    uint32_t acc = 0;
+    int bits = 0;
+
+    for (int i = 0; i < n; i++) {
+        for (; bits < d; bits += 8) {
+            acc |= (uint32_t)*a++ << bits;
+        }
+        uint32_t x = acc & ((1U << d) - 1);
+        acc >>= d;
+        bits -= d;
+        r[i] = (int16_t)((x * KYBER_Q + (1U << (d - 1))) >> d);
+    }
+}
+
+/**
+ * @brief Compress and pack polynomials u and v into a ciphertext
+ * @param ct Output ciphertext
+ * @param u Polynomial vector u
+ * @param v Polynomial v
+ */
+static void pack_ciphertext(kyber_ciphertext_t *ct, const int16_t u[KYBER_K][KYBER_N],
+                            const int16_t v[KYBER_N]) {
+    pack_compressed(ct->u, &u[0][0], KYBER_K * KYBER_N, KYBER_DU);
+    pack_compressed(ct->v, v, KYBER_N, KYBER_DV);
+}
+
+/**
+ * @brief Unpack and decompress polynomials u and v from a ciphertext
+ * @param u Output polynomial vector u
+ * @param v Output polynomial v
+ * @param ct Ciphertext
+ */
+static void unpack_ciphertext(int16_t u[KYBER_K][KYBER_N], int16_t v[KYBER_N],
+                              const kyber_ciphertext_t *ct) {
+    unpack_compressed(&u[0][0], ct->u, KYBER_K * KYBER_N, KYBER_DU);
+    unpack_compressed(v, ct->v, KYBER_N, KYBER_DV);
+}
+
+/**
+ * @brief IND-CPA encryption of a 32-byte message, deterministic in the coins
+ * @param ct Output ciphertext
+ * @param m Message
+ * @param pk Public key
+ * @param coins Seed for the noise polynomials
+ */
+static void indcpa_encrypt(kyber_ciphertext_t *ct, const uint8_t m[32],
+                           const kyber_public_key_t *pk, const uint8_t coins[32]) {
+    int16_t At[KYBER_K][KYBER_K][KYBER_N];
+    int16_t t[KYBER_K][KYBER_N], r[KYBER_K][KYBER_N], e1[KYBER_K][KYBER_N], e2[KYBER_N];
+    int16_t u[KYBER_K][KYBER_N], v[KYBER_N];
+
+    expand_matrix(At, pk->seed, 1);
+    unpack_pk(t, pk);
+
+    // Generate noise polynomials r, e1, e2
+    for (int i = 0; i < KYBER_K; i++) {
+        poly_getnoise_eta1(r[i], coins, (uint8_t)i);
+        poly_getnoise_eta1(e1[i], coins, (uint8_t)(i + KYBER_K));
+    }
+    poly_getnoise_eta1(e2, coins, 2 * KYBER_K);
+
+    // u = A^T r + e1, v = t^T r + e2 + Decompress_q(m, 1)
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_POLY_ARITH);
+    for (int i = 0; i < KYBER_K; i++) {
+        ntt(r[i]);
+    }
+    for (int i = 0; i < KYBER_K; i++) {
+        polyvec_basemul_acc(u[i], (const int16_t (*)[KYBER_N])At[i], (const int16_t (*)[KYBER_N])r);
+        invntt(u[i]);
+        poly_add(u[i], u[i], e1[i]);
+    }
+    polyvec_basemul_acc(v, (const int16_t (*)[KYBER_N])t, (const int16_t (*)[KYBER_N])r);
+    invntt(v);
+    poly_add(v, v, e2);
+    for (int i = 0; i < KYBER_N; i++) {
+        int16_t mask = (int16_t)-(int16_t)((m[i / 8] >> (i % 8)) & 1);
+        v[i] = (int16_t)(v[i] + (mask & ((KYBER_Q + 1) / 2)));
+    }
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_POLY_ARITH);
+
+    pack_ciphertext(ct, (const int16_t (*)[KYBER_N])u, v);
+
+    secure_memzero(r, sizeof(r));
+    secure_memzero(e1, sizeof(e1));
+    secure_memzero(e2, sizeof(e2));
+    secure_memzero(v, sizeof(v));
+}
+
 pqc_result_t kyber_keypair(kyber_public_key_t *pk, kyber_secret_key_t *sk) {
+    PQC_BYTES_SCOPE("kyber_keypair");
     if (!pk || !sk) {
         return PQC_ERROR_INVALID_PARAMETER;
     }
 
     uint8_t publicseed[32], noiseseed[32];
-    uint16_t A[KYBER_K][KYBER_K][KYBER_N];
-    uint16_t s[KYBER_K][KYBER_N], e[KYBER_K][KYBER_N], t[KYBER_K][KYBER_N];
+    int16_t A[KYBER_K][KYBER_K][KYBER_N];
+    int16_t s[KYBER_K][KYBER_N], e[KYBER_K][KYBER_N], t[KYBER_K][KYBER_N];
+
+    PQC_TRACE_OP_ENTRY("kyber_keypair", 0);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_KEYGEN);
 
     // Generate random seeds
     if (pqc_randombytes(publicseed, 32) != PQC_SUCCESS ||
         pqc_randombytes(noiseseed, 32) != PQC_SUCCESS) {
+        PQC_PERF_PHASE_END(PQC_PERF_PHASE_KEYGEN);
+        PQC_TRACE_OP_RETURN("kyber_keypair", PQC_ERROR_RANDOM_GENERATION, 0);
         return PQC_ERROR_RANDOM_GENERATION;
     }
 
     // Generate matrix A from public seed
-    for (int i = 0; i < KYBER_K; i++) {
-        for (int j = 0; j < KYBER_K; j++) {
-            uint8_t seed_ext[34];
-            memcpy(seed_ext, publicseed, 32);
-            seed_ext[32] = j;
-            seed_ext[33] = i;
-            
-            uint8_t buf[3 * KYBER_N];
-            shake128(buf, sizeof(buf), seed_ext, 34);
-            
-            int pos = 0;
-            for (int k = 0; k < KYBER_N; k++) {
-                uint16_t val;
-                do {
-                    val = buf[pos] | ((uint16_t)buf[pos + 1] << 8);
-                    pos += 2;
-                    val &= 0x1FFF;
-                } while (val >= KYBER_Q && pos < sizeof(buf) - 1);
-                
-                A[i][j][k] = val;
-            }
-        }
-    }
+    expand_matrix(A, publicseed, 0);
 
-    // Generate secret vector s
+    // Generate secret vector s and error vector e
     for (int i = 0; i < KYBER_K; i++) {
-        poly_getnoise_eta1(s[i], noiseseed, i);
+        poly_getnoise_eta1(s[i], noiseseed, (uint8_t)i);
+        poly_getnoise_eta1(e[i], noiseseed, (uint8_t)(i + KYBER_K));
     }
 
-    // Generate error vector e  
+    // Compute t = As + e in the NTT domain
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_POLY_ARITH);
     for (int i = 0; i < KYBER_K; i++) {
-        poly_getnoise_eta1(e[i], noiseseed, i + KYBER_K);
+        ntt(s[i]);
+        ntt(e[i]);
     }
-
-    // Compute t = As + e
-    matrix_vector_mul(t, A, s, 0);
-    for (int i = 0; i < KYBER_K; i++) {
-        poly_add(t[i], t[i], e[i]);
-    }
-
-    // Pack public key
-    memcpy(pk->seed, publicseed, 32);
     for (int i = 0; i < KYBER_K; i++) {
+        polyvec_basemul_acc(t[i], (const int16_t (*)[KYBER_N])A[i], (const int16_t (*)[KYBER_N])s);
         for (int j = 0; j < KYBER_N; j++) {
-            int idx = i * KYBER_N + j;
-            pk->t[idx * 3 / 2] = t[i][j] & 0xFF;
-            pk->t[idx * 3 / 2 + 1] = (t[i][j] >> 8) | ((j + 1 < KYBER_N ? t[i][j + 1] : 0) << 4);
-            if (j + 1 < KYBER_N) {
-                pk->t[idx * 3 / 2 + 2] = t[i][j + 1] >> 4;
-                j++;
-            }
+            // Back out of the Montgomery domain basemul left t in
+            t[i][j] = montgomery_reduce((int32_t)t[i][j] * KYBER_MONT2);
         }
+        poly_add(t[i], t[i], e[i]);
     }
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_POLY_ARITH);
 
-    // Pack secret key
+    // Pack public and secret key
+    pack_pk(pk, (const int16_t (*)[KYBER_N])t, publicseed);
     for (int i = 0; i < KYBER_K; i++) {
-        for (int j = 0; j < KYBER_N; j++) {
-            sk->s[i * KYBER_N + j] = s[i][j];
-        }
+        poly_tobytes(sk->s + i * KYBER_N * 3 / 2, s[i]);
     }
-    memcpy(sk->pk, pk, sizeof(kyber_public_key_t));
+    memcpy(&sk->pk, pk, sizeof(kyber_public_key_t));
 
     // Generate hash of public key for implicit rejection
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_HASH);
     sha3_256(sk->h, (uint8_t*)pk, sizeof(kyber_public_key_t));
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_HASH);
     
     // Generate random z for implicit rejection
     pqc_randombytes(sk->z, 32);
@@ -285,251 +509,159 @@ pqc_result_t kyber_keypair(kyber_public_key_t *pk, kyber_secret_key_t *sk) {
     secure_memzero(e, sizeof(e));
     secure_memzero(noiseseed, sizeof(noiseseed));
 
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_KEYGEN);
+    PQC_TRACE_OP_RETURN("kyber_keypair", PQC_SUCCESS, KYBER_PUBLICKEYBYTES);
     return PQC_SUCCESS;
 }
 
 pqc_result_t kyber_encapsulate(kyber_ciphertext_t *ct, uint8_t *shared_secret, 
                               const kyber_public_key_t *pk) {
+    PQC_BYTES_SCOPE("kyber_encapsulate");
     if (!ct || !shared_secret || !pk) {
         return PQC_ERROR_INVALID_PARAMETER;
     }
 
-    uint8_t m[32], K[32], coins[32];
-    uint16_t A[KYBER_K][KYBER_K][KYBER_N];
-    uint16_t t[KYBER_K][KYBER_N], r[KYBER_K][KYBER_N], e1[KYBER_K][KYBER_N], e2[KYBER_N];
-    uint16_t u[KYBER_K][KYBER_N], v[KYBER_N];
+    uint8_t hash_input[64], Kr[64];
 
-    // Generate random message
-    if (pqc_randombytes(m, 32) != PQC_SUCCESS) {
-        return PQC_ERROR_RANDOM_GENERATION;
-    }
-
-    // Hash message with public key hash for coins
-    uint8_t pk_hash[32];
-    sha3_256(pk_hash, (uint8_t*)pk, sizeof(kyber_public_key_t));
-    
-    uint8_t hash_input[64];
-    memcpy(hash_input, m, 32);
-    memcpy(hash_input + 32, pk_hash, 32);
-    sha3_512(coins, hash_input, 64);
-
-    // Reconstruct matrix A from public seed
-    for (int i = 0; i < KYBER_K; i++) {
-        for (int j = 0; j < KYBER_K; j++) {
-            uint8_t seed_ext[34];
-            memcpy(seed_ext, pk->seed, 32);
-            seed_ext[32] = j;
-            seed_ext[33] = i;
-            
-            uint8_t buf[3 * KYBER_N];
-            shake128(buf, sizeof(buf), seed_ext, 34);
-            
-            int pos = 0;
-            for (int k = 0; k < KYBER_N; k++) {
-                uint16_t val;
-                do {
-                    val = buf[pos] | ((uint16_t)buf[pos + 1] << 8);
-                    pos += 2;
-                    val &= 0x1FFF;
-                } while (val >= KYBER_Q && pos < sizeof(buf) - 1);
-                
-                A[i][j][k] = val;
-            }
-        }
-    }
+    PQC_TRACE_OP_ENTRY("kyber_encapsulate", KYBER_PUBLICKEYBYTES);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_SIGN_ENCAPS);
 
-    // Unpack public key t
-    for (int i = 0; i < KYBER_K; i++) {
-        for (int j = 0; j < KYBER_N; j += 2) {
-            int idx = i * KYBER_N + j;
-            t[i][j] = pk->t[idx * 3 / 2] | ((pk->t[idx * 3 / 2 + 1] & 0x0F) << 8);
-            if (j + 1 < KYBER_N) {
-                t[i][j + 1] = (pk->t[idx * 3 / 2 + 1] >> 4) | (pk->t[idx * 3 / 2 + 2] << 4);
-            }
-        }
-    }
-
-    // Generate noise polynomials r, e1, e2
-    for (int i = 0; i < KYBER_K; i++) {
-        poly_getnoise_eta1(r[i], coins, i);
-        poly_getnoise_eta1(e1[i], coins, i + KYBER_K);
-    }
-    poly_getnoise_eta1(e2, coins, 2 * KYBER_K);
-
-    // Compute u = A^T * r + e1
-    matrix_vector_mul(u, A, r, 1);
-    for (int i = 0; i < KYBER_K; i++) {
-        poly_add(u[i], u[i], e1[i]);
-    }
-
-    // Compute v = t^T * r + e2 + Decompress_q(Encode(m))
-    uint16_t tr[KYBER_N];
-    memset(tr, 0, sizeof(tr));
-    for (int i = 0; i < KYBER_K; i++) {
-        uint16_t temp[KYBER_N];
-        memcpy(temp, t[i], KYBER_N * sizeof(uint16_t));
-        ntt(temp);
-        
-        uint16_t r_ntt[KYBER_N];
-        memcpy(r_ntt, r[i], KYBER_N * sizeof(uint16_t));
-        ntt(r_ntt);
-        
-        for (int j = 0; j < KYBER_N; j++) {
-            temp[j] = montgomery_reduce((uint32_t)temp[j] * r_ntt[j]);
-        }
-        
-        invntt(temp);
-        poly_add(tr, tr, temp);
-    }
-    
-    poly_add(v, tr, e2);
-    
-    // Add encoded message
-    for (int i = 0; i < KYBER_N; i++) {
-        int bit = (m[i / 8] >> (i % 8)) & 1;
-        v[i] = barrett_reduce(v[i] + bit * ((KYBER_Q + 1) / 2));
-    }
-
-    // Pack ciphertext
-    for (int i = 0; i < KYBER_K; i++) {
-        for (int j = 0; j < KYBER_N; j++) {
-            int idx = i * KYBER_N + j;
-            uint16_t compressed = ((uint32_t)u[i][j] << KYBER_DU) + KYBER_Q / 2) / KYBER_Q;
-            compressed &= (1 << KYBER_DU) - 1;
-            
-            ct->u[idx * KYBER_DU / 8] |= compressed << (idx * KYBER_DU % 8);
-            if (idx * KYBER_DU % 8 + KYBER_DU > 8) {
-                ct->u[idx * KYBER_DU / 8 + 1] |= compressed >> (8 - idx * KYBER_DU % 8);
-            }
-        }
+    // Generate random message m
+    if (pqc_randombytes(hash_input, 32) != PQC_SUCCESS) {
+        PQC_PERF_PHASE_END(PQC_PERF_PHASE_SIGN_ENCAPS);
+        PQC_TRACE_OP_RETURN("kyber_encapsulate", PQC_ERROR_RANDOM_GENERATION, 0);
+        return PQC_ERROR_RANDOM_GENERATION;
     }
 
-    for (int i = 0; i < KYBER_N; i++) {
-        uint16_t compressed = ((uint32_t)v[i] << KYBER_DV) + KYBER_Q / 2) / KYBER_Q;
-        compressed &= (1 << KYBER_DV) - 1;
-        
-        ct->v[i * KYBER_DV / 8] |= compressed << (i * KYBER_DV % 8);
-        if (i * KYBER_DV % 8 + KYBER_DV > 8) {
-            ct->v[i * KYBER_DV / 8 + 1] |= compressed >> (8 - i * KYBER_DV % 8);
-        }
-    }
+    // (K, r) = G(m || H(pk))
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_HASH);
+    sha3_256(hash_input + 32, (const uint8_t*)pk, sizeof(kyber_public_key_t));
+    sha3_512(Kr, hash_input, 64);
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_HASH);
 
-    // Derive shared secret
-    memcpy(hash_input, m, 32);
-    sha3_256(K, hash_input, 32);
-    memcpy(shared_secret, K, 32);
+    // Encrypt m with coins r; the shared secret is K
+    indcpa_encrypt(ct, hash_input, pk, Kr + 32);
+    memcpy(shared_secret, Kr, KYBER_SSBYTES);
 
     // Clear sensitive data
-    secure_memzero(m, sizeof(m));
-    secure_memzero(K, sizeof(K));
-    secure_memzero(coins, sizeof(coins));
-    secure_memzero(r, sizeof(r));
+    secure_memzero(hash_input, sizeof(hash_input));
+    secure_memzero(Kr, sizeof(Kr));
 
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_SIGN_ENCAPS);
+    PQC_TRACE_OP_RETURN("kyber_encapsulate", PQC_SUCCESS, KYBER_CIPHERTEXTBYTES);
     return PQC_SUCCESS;
 }
 
 pqc_result_t kyber_decapsulate(uint8_t *shared_secret, const kyber_ciphertext_t *ct,
                               const kyber_secret_key_t *sk) {
+    PQC_BYTES_SCOPE("kyber_decapsulate");
     if (!shared_secret || !ct || !sk) {
         return PQC_ERROR_INVALID_PARAMETER;
     }
 
-    uint8_t m[32], K[32], Kr[64];
-    uint16_t u[KYBER_K][KYBER_N], v[KYBER_N], s[KYBER_K][KYBER_N];
-    uint16_t mp[KYBER_N];
+    uint8_t hash_input[64], Kr[64], K_reject[KYBER_SSBYTES];
+    int16_t u[KYBER_K][KYBER_N], v[KYBER_N], s[KYBER_K][KYBER_N];
+    int16_t mp[KYBER_N];
+    kyber_ciphertext_t ct_prime;
 
-    // Unpack secret key
-    for (int i = 0; i < KYBER_K; i++) {
-        for (int j = 0; j < KYBER_N; j++) {
-            s[i][j] = sk->s[i * KYBER_N + j];
-        }
-    }
+    PQC_TRACE_OP_ENTRY("kyber_decapsulate", KYBER_CIPHERTEXTBYTES);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_VERIFY_DECAPS);
 
-    // Unpack ciphertext u
+    // Unpack secret key (NTT domain) and ciphertext
     for (int i = 0; i < KYBER_K; i++) {
-        for (int j = 0; j < KYBER_N; j++) {
-            int idx = i * KYBER_N + j;
-            uint16_t compressed = ct->u[idx * KYBER_DU / 8] >> (idx * KYBER_DU % 8);
-            if (idx * KYBER_DU % 8 + KYBER_DU > 8) {
-                compressed |= ct->u[idx * KYBER_DU / 8 + 1] << (8 - idx * KYBER_DU % 8);
-            }
-            compressed &= (1 << KYBER_DU) - 1;
-            
-            u[i][j] = ((uint32_t)compressed * KYBER_Q + (1 << (KYBER_DU - 1))) >> KYBER_DU;
-        }
-    }
-
-    // Unpack ciphertext v
-    for (int i = 0; i < KYBER_N; i++) {
-        uint16_t compressed = ct->v[i * KYBER_DV / 8] >> (i * KYBER_DV % 8);
-        if (i * KYBER_DV % 8 + KYBER_DV > 8) {
-            compressed |= ct->v[i * KYBER_DV / 8 + 1] << (8 - i * KYBER_DV % 8);
-        }
-        compressed &= (1 << KYBER_DV) - 1;
-        
-        v[i] = ((uint32_t)compressed * KYBER_Q + (1 << (KYBER_DV - 1))) >> KYBER_DV;
+        poly_frombytes(s[i], sk->s + i * KYBER_N * 3 / 2);
     }
+    unpack_ciphertext(u, v, ct);
 
-    // Compute s^T * u
-    uint16_t su[KYBER_N];
-    memset(su, 0, sizeof(su));
+    // mp = v - s^T u
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_POLY_ARITH);
     for (int i = 0; i < KYBER_K; i++) {
-        uint16_t temp[KYBER_N];
-        memcpy(temp, s[i], KYBER_N * sizeof(uint16_t));
-        ntt(temp);
-        
-        uint16_t u_ntt[KYBER_N];
-        memcpy(u_ntt, u[i], KYBER_N * sizeof(uint16_t));
-        ntt(u_ntt);
-        
-        for (int j = 0; j < KYBER_N; j++) {
-            temp[j] = montgomery_reduce((uint32_t)temp[j] * u_ntt[j]);
-        }
-        
-        invntt(temp);
-        poly_add(su, su, temp);
+        ntt(u[i]);
     }
+    polyvec_basemul_acc(mp, (const int16_t (*)[KYBER_N])s, (const int16_t (*)[KYBER_N])u);
+    invntt(mp);
+    poly_sub(mp, v, mp);
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_POLY_ARITH);
 
-    // Compute mp = v - s^T * u
-    poly_sub(mp, v, su);
-
-    // Decode message
+    // Decode message m'
     for (int i = 0; i < 32; i++) {
-        m[i] = 0;
+        hash_input[i] = 0;
         for (int j = 0; j < 8; j++) {
-            int coeff_idx = i * 8 + j;
-            uint16_t t = ((uint32_t)mp[coeff_idx] << 1) + KYBER_Q / 2;
-            t = (t / KYBER_Q) & 1;
-            m[i] |= t << j;
+            uint32_t t = (uint32_t)freeze(mp[8 * i + j]);
+            t = (((t << 1) + KYBER_Q / 2) / KYBER_Q) & 1;
+            hash_input[i] |= (uint8_t)(t << j);
         }
     }
 
-    // Recompute shared secret and verify
-    uint8_t hash_input[64];
-    memcpy(hash_input, m, 32);
+    // (K', r') = G(m' || H(pk)), and the rejection key J(z || c)
     memcpy(hash_input + 32, sk->h, 32);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_HASH);
     sha3_512(Kr, hash_input, 64);
+    shake256(K_reject, sizeof(K_reject), sk->z, 32, (const uint8_t*)ct, sizeof(kyber_ciphertext_t));
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_HASH);
 
-    // Compare with implicit rejection
-    kyber_ciphertext_t ct_prime;
-    kyber_encapsulate(&ct_prime, K, &sk->pk);
-    
-    int ct_match = secure_memcmp(ct, &ct_prime, sizeof(kyber_ciphertext_t));
-    
-    // Use implicit rejection on failure
-    if (ct_match != 0) {
-        memcpy(hash_input, sk->z, 32);
-        memcpy(hash_input + 32, (uint8_t*)ct, sizeof(kyber_ciphertext_t));
-        sha3_256(K, hash_input, 32 + sizeof(kyber_ciphertext_t));
-    }
-
-    memcpy(shared_secret, K, 32);
+    // Re-encrypt m' with r' and keep K' only if the ciphertexts match;
+    // the comparison and the selection do not branch on the result
+    indcpa_encrypt(&ct_prime, hash_input, &sk->pk, Kr + 32);
+    int fail = secure_memcmp(ct, &ct_prime, sizeof(kyber_ciphertext_t));
+    memcpy(shared_secret, Kr, KYBER_SSBYTES);
+    secure_memcpy_conditional(shared_secret, K_reject, KYBER_SSBYTES, fail);
 
     // Clear sensitive data
-    secure_memzero(m, sizeof(m));
-    secure_memzero(K, sizeof(K));
+    secure_memzero(hash_input, sizeof(hash_input));
     secure_memzero(Kr, sizeof(Kr));
+    secure_memzero(K_reject, sizeof(K_reject));
     secure_memzero(s, sizeof(s));
+    secure_memzero(mp, sizeof(mp));
+
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_VERIFY_DECAPS);
+    PQC_TRACE_OP_RETURN("kyber_decapsulate", PQC_SUCCESS, KYBER_SSBYTES);
+    return PQC_SUCCESS;
+}
+
+pqc_result_t kyber_validate_public_key(const kyber_public_key_t *pk) {
+    if (!pk) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    // Every 12-bit coefficient must already be reduced mod q (FIPS 203
+    // modulus check); the accumulation keeps the scan branch-free
+    int16_t t[KYBER_K][KYBER_N];
+    unpack_pk(t, pk);
+    int16_t unreduced = 0;
+    for (int i = 0; i < KYBER_K; i++) {
+        for (int j = 0; j < KYBER_N; j++) {
+            unreduced |= (int16_t)((KYBER_Q - 1 - t[i][j]) >> 15);
+        }
+    }
+    return unreduced ? PQC_ERROR_INVALID_KEY : PQC_SUCCESS;
+}
+
+pqc_result_t kyber_validate_ciphertext(const kyber_ciphertext_t *ct) {
+    if (!ct) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
 
+    // Every 11-bit and 5-bit pattern decompresses to a coefficient in
+    // [0, q), so a ciphertext of the right size is always well formed;
+    // tampering is caught by the re-encryption in decapsulation
     return PQC_SUCCESS;
-}
\ No newline at end of file
+}
+
+#ifdef PQC_ENABLE_TESTING
+void kyber_pack_public_key(kyber_public_key_t *pk, const uint16_t t[4 * 256], const uint8_t seed[32]) {
+    pack_pk(pk, (const int16_t (*)[KYBER_N])t, seed);
+}
+
+void kyber_unpack_public_key(uint16_t t[4 * 256], const kyber_public_key_t *pk) {
+    unpack_pk((int16_t (*)[KYBER_N])t, pk);
+}
+
+void kyber_pack_ciphertext(kyber_ciphertext_t *ct, const uint16_t u[4 * 256], const uint16_t v[256]) {
+    pack_ciphertext(ct, (const int16_t (*)[KYBER_N])u, (const int16_t *)v);
+}
+
+void kyber_unpack_ciphertext(uint16_t u[4 * 256], uint16_t v[256], const kyber_ciphertext_t *ct) {
+    unpack_ciphertext((int16_t (*)[KYBER_N])u, (int16_t *)v, ct);
+}
+#endif
@@ -148,6 +148,10 @@ void kyber_poly_ntt(uint16_t poly[256]);
 void kyber_poly_invntt(uint16_t poly[256]);
 uint16_t kyber_montgomery_reduce(uint32_t a);
 uint16_t kyber_barrett_reduce(uint16_t a);
+void kyber_pack_public_key(kyber_public_key_t *pk, const uint16_t t[4 * 256], const uint8_t seed[32]);
+void kyber_unpack_public_key(uint16_t t[4 * 256], const kyber_public_key_t *pk);
+void kyber_pack_ciphertext(kyber_ciphertext_t *ct, const uint16_t u[4 * 256], const uint16_t v[256]);
+void kyber_unpack_ciphertext(uint16_t u[4 * 256], uint16_t v[256], const kyber_ciphertext_t *ct);
 #endif
 
 #ifdef __cplusplus
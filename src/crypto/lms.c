@@ -0,0 +1,946 @@
+/**
+ * @file lms.c
+ * @brief HSS/LMS implementation (RFC 8554) with NV-reserved signing state
+ *
+ * Every LM-OTS chain step hashes I || u32(q) || u16(i) || u8(j) || tmp,
+ * 55 bytes, which pads to exactly one SHA-256 block. Chains are therefore
+ * run through sha256_compress_x8() eight at a time; a lane whose chain
+ * ends is refilled with the next pending chain right away, so the uneven
+ * chain lengths of a signature do not leave lanes idle.
+ *
+ * Private keys follow RFC 8554 Appendix A: x_q[i] is the same 55-byte hash
+ * with j = 0xff and SEED in place of tmp. The I and SEED of each lower
+ * level tree, and the per-signature randomizer C, are derived the same way
+ * from the parent's I, SEED and index with j = 0xff and reserved values of
+ * i, so a signer can rebuild every tree - and re-sign every lower tree's
+ * public key bit-for-bit - from the private key and the NV index alone.
+ */
+
+#define _GNU_SOURCE
+#include "lms.h"
+#include "sha2.h"
+#include "pqc_common.h"
+#include "pqc_bytes.h"
+#include "pqc_perf.h"
+#include "pqc_trace.h"
+#include "secure_memory.h"
+#include <string.h>
+#include <stdio.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+
+// ============================================================================
+// Parameters
+// ============================================================================
+
+#define LMS_N                   32
+#define LMS_I_BYTES             16
+#define LMS_PUBLIC_BYTES        (8 + LMS_I_BYTES + LMS_N)
+#define LMOTS_MAX_P             265
+
+// Domain separators (RFC 8554 section 7.1)
+#define D_PBLC                  0x8080
+#define D_MESG                  0x8181
+#define D_LEAF                  0x8282
+#define D_INTR                  0x8383
+
+// Values of i for derivations with j = 0xff, above every chain index
+#define DERIVE_C                0xfffd
+#define DERIVE_SEED             0xfffe
+#define DERIVE_I                0xffff
+
+#define HSS_NV_MAGIC            0x48535352u     /**< "HSSR" */
+
+typedef struct {
+    uint32_t type;
+    unsigned w;                         /**< Bits per chain digit */
+    unsigned p;                         /**< Number of chains */
+    unsigned ls;                        /**< Checksum left shift */
+} lmots_params_t;
+
+typedef struct {
+    uint32_t type;
+    unsigned h;                         /**< Tree height */
+} lms_params_t;
+
+static const lmots_params_t lmots_params[] = {
+    { LMOTS_SHA256_N32_W1, 1, 265, 7 },
+    { LMOTS_SHA256_N32_W2, 2, 133, 6 },
+    { LMOTS_SHA256_N32_W4, 4, 67, 4 },
+    { LMOTS_SHA256_N32_W8, 8, 34, 0 },
+};
+
+static const lms_params_t lms_params[] = {
+    { LMS_SHA256_M32_H5, 5 },
+    { LMS_SHA256_M32_H10, 10 },
+    { LMS_SHA256_M32_H15, 15 },
+    { LMS_SHA256_M32_H20, 20 },
+    { LMS_SHA256_M32_H25, 25 },
+};
+
+static const lmots_params_t *find_lmots(uint32_t type) {
+    for (size_t i = 0; i < sizeof(lmots_params) / sizeof(lmots_params[0]); i++) {
+        if (lmots_params[i].type == type) {
+            return &lmots_params[i];
+        }
+    }
+    return NULL;
+}
+
+static const lms_params_t *find_lms(uint32_t type) {
+    for (size_t i = 0; i < sizeof(lms_params) / sizeof(lms_params[0]); i++) {
+        if (lms_params[i].type == type) {
+            return &lms_params[i];
+        }
+    }
+    return NULL;
+}
+
+static inline size_t lmots_sig_bytes(const lmots_params_t *o) {
+    return 4 + (size_t)LMS_N * (o->p + 1);
+}
+
+static inline size_t lms_sig_bytes(const lms_params_t *t, const lmots_params_t *o) {
+    return 4 + lmots_sig_bytes(o) + 4 + (size_t)t->h * LMS_N;
+}
+
+static inline void store_be16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)v;
+}
+
+static inline void store_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static inline uint32_t load_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+// ============================================================================
+// Multi-Buffer Chains
+// ============================================================================
+
+// One-block chain message: I || q || i || j || tmp || padding
+#define CHAIN_OFF_I             20
+#define CHAIN_OFF_J             22
+#define CHAIN_OFF_TMP           23
+#define CHAIN_MSG_BYTES         55
+
+/**
+ * @brief One LM-OTS chain: value is hashed for j = start .. end-1
+ */
+typedef struct {
+    uint8_t *value;                     /**< n bytes, updated in place */
+    uint16_t index;                     /**< Chain index i */
+    uint16_t start;
+    uint16_t end;
+} lmots_chain_t;
+
+/**
+ * @brief Run chains of one LM-OTS key eight at a time, refilling lanes as
+ * chains finish
+ */
+static void run_chains(const uint8_t *I, uint32_t q, lmots_chain_t *chains, unsigned count) {
+    uint8_t blocks[SHA256_LANES][SHA256_BLOCK_BYTES];
+    const uint8_t *bp[SHA256_LANES];
+    uint32_t states[SHA256_LANES][8];
+    int lane_chain[SHA256_LANES];
+    unsigned lane_j[SHA256_LANES];
+    sha256_ctx_t iv;
+    bool simd = sha256_backend_x8() == SHA256_BACKEND_AVX2;
+    unsigned next = 0;
+
+    sha256_init(&iv);
+    for (int l = 0; l < SHA256_LANES; l++) {
+        memset(blocks[l], 0, SHA256_BLOCK_BYTES);
+        memcpy(blocks[l], I, LMS_I_BYTES);
+        store_be32(blocks[l] + LMS_I_BYTES, q);
+        blocks[l][CHAIN_MSG_BYTES] = 0x80;
+        store_be32(blocks[l] + 60, CHAIN_MSG_BYTES * 8);
+        bp[l] = blocks[l];
+        lane_chain[l] = -1;
+        lane_j[l] = 0;
+    }
+
+    for (;;) {
+        unsigned mask = 0;
+        for (int l = 0; l < SHA256_LANES; l++) {
+            while (lane_chain[l] < 0 && next < count) {
+                lmots_chain_t *c = &chains[next++];
+                if (c->start >= c->end) {
+                    continue;
+                }
+                lane_chain[l] = (int)(c - chains);
+                lane_j[l] = c->start;
+                store_be16(blocks[l] + CHAIN_OFF_I, c->index);
+                memcpy(blocks[l] + CHAIN_OFF_TMP, c->value, LMS_N);
+            }
+            if (lane_chain[l] >= 0) {
+                blocks[l][CHAIN_OFF_J] = (uint8_t)lane_j[l];
+                memcpy(states[l], iv.h, sizeof(states[l]));
+                mask |= 1U << l;
+            }
+        }
+        if (!mask) {
+            break;
+        }
+
+        if (mask == (1U << SHA256_LANES) - 1 || simd) {
+            sha256_compress_x8(states, bp);
+        } else {
+            for (int l = 0; l < SHA256_LANES; l++) {
+                if (mask & (1U << l)) {
+                    sha256_compress(states[l], blocks[l], 1);
+                }
+            }
+        }
+
+        for (int l = 0; l < SHA256_LANES; l++) {
+            if (!(mask & (1U << l))) {
+                continue;
+            }
+            for (int k = 0; k < 8; k++) {
+                store_be32(blocks[l] + CHAIN_OFF_TMP + 4 * k, states[l][k]);
+            }
+            lmots_chain_t *c = &chains[lane_chain[l]];
+            if (++lane_j[l] == c->end) {
+                memcpy(c->value, blocks[l] + CHAIN_OFF_TMP, LMS_N);
+                lane_chain[l] = -1;
+            }
+        }
+    }
+    secure_memzero(blocks, sizeof(blocks));
+    secure_memzero(states, sizeof(states));
+}
+
+/**
+ * @brief H(I || u32(q) || u16(i) || u8(0xff) || SEED), the RFC 8554 Appendix A PRF
+ */
+static void derive(uint8_t out[LMS_N], const uint8_t *I, uint32_t q, uint16_t i,
+                   const uint8_t *seed) {
+    lmots_chain_t c = { out, i, 0xff, 0x100 };
+    memcpy(out, seed, LMS_N);
+    run_chains(I, q, &c, 1);
+}
+
+// ============================================================================
+// LM-OTS
+// ============================================================================
+
+static inline unsigned coef(const uint8_t *s, unsigned i, unsigned w) {
+    unsigned mask = (1U << w) - 1;
+    unsigned shift = 8 - (w * (i % (8 / w)) + w);
+    return (s[(i * w) / 8] >> shift) & mask;
+}
+
+/**
+ * @brief Chain lengths: digits of Q followed by its checksum
+ */
+static void lmots_digits(uint16_t *a, const uint8_t Q[LMS_N], const lmots_params_t *o) {
+    uint8_t s[LMS_N + 2];
+    unsigned max = (1U << o->w) - 1;
+    uint32_t sum = 0;
+
+    memcpy(s, Q, LMS_N);
+    for (unsigned i = 0; i < LMS_N * 8 / o->w; i++) {
+        sum += max - coef(Q, i, o->w);
+    }
+    store_be16(s + LMS_N, (uint16_t)(sum << o->ls));
+    for (unsigned i = 0; i < o->p; i++) {
+        a[i] = (uint16_t)coef(s, i, o->w);
+    }
+}
+
+static void lmots_message_hash(uint8_t Q[LMS_N], const uint8_t *I, uint32_t q,
+                               const uint8_t *C, const uint8_t *message, size_t msglen) {
+    uint8_t prefix[LMS_I_BYTES + 6];
+    sha256_ctx_t s;
+
+    memcpy(prefix, I, LMS_I_BYTES);
+    store_be32(prefix + LMS_I_BYTES, q);
+    store_be16(prefix + LMS_I_BYTES + 4, D_MESG);
+    sha256_init(&s);
+    sha256_update(&s, prefix, sizeof(prefix));
+    sha256_update(&s, C, LMS_N);
+    sha256_update(&s, message, msglen);
+    sha256_final(&s, Q);
+    PQC_BYTES_COUNT(PQC_BYTES_HASHED, sizeof(prefix) + LMS_N + msglen);
+}
+
+static void lmots_public_hash(uint8_t K[LMS_N], const uint8_t *I, uint32_t q,
+                              const uint8_t *y, const lmots_params_t *o) {
+    uint8_t prefix[LMS_I_BYTES + 6];
+    sha256_ctx_t s;
+
+    memcpy(prefix, I, LMS_I_BYTES);
+    store_be32(prefix + LMS_I_BYTES, q);
+    store_be16(prefix + LMS_I_BYTES + 4, D_PBLC);
+    sha256_init(&s);
+    sha256_update(&s, prefix, sizeof(prefix));
+    sha256_update(&s, y, (size_t)o->p * LMS_N);
+    sha256_final(&s, K);
+}
+
+/**
+ * @brief Secret chain starts x_q[i], written to y
+ */
+static void lmots_secret(uint8_t *y, lmots_chain_t *chains, const uint8_t *I, uint32_t q,
+                         const uint8_t *seed, const lmots_params_t *o) {
+    for (unsigned i = 0; i < o->p; i++) {
+        memcpy(y + (size_t)i * LMS_N, seed, LMS_N);
+        chains[i] = (lmots_chain_t){ y + (size_t)i * LMS_N, (uint16_t)i, 0xff, 0x100 };
+    }
+    run_chains(I, q, chains, o->p);
+}
+
+static void lmots_public_key(uint8_t K[LMS_N], const uint8_t *I, uint32_t q,
+                             const uint8_t *seed, const lmots_params_t *o) {
+    uint8_t y[LMOTS_MAX_P * LMS_N];
+    lmots_chain_t chains[LMOTS_MAX_P];
+
+    lmots_secret(y, chains, I, q, seed, o);
+    for (unsigned i = 0; i < o->p; i++) {
+        chains[i].start = 0;
+        chains[i].end = (uint16_t)((1U << o->w) - 1);
+    }
+    run_chains(I, q, chains, o->p);
+    lmots_public_hash(K, I, q, y, o);
+    secure_memzero(y, sizeof(y));
+}
+
+/**
+ * @brief u32(type) || C || y[0..p-1]
+ *
+ * C is derived rather than random, so signing the same message at the
+ * same index again yields the same signature.
+ */
+static void lmots_sign(uint8_t *sig, const uint8_t *I, uint32_t q, const uint8_t *seed,
+                       const lmots_params_t *o, const uint8_t *message, size_t msglen) {
+    uint8_t Q[LMS_N];
+    uint16_t a[LMOTS_MAX_P];
+    lmots_chain_t chains[LMOTS_MAX_P];
+    uint8_t *C = sig + 4;
+    uint8_t *y = sig + 4 + LMS_N;
+
+    store_be32(sig, o->type);
+    derive(C, I, q, DERIVE_C, seed);
+    lmots_message_hash(Q, I, q, C, message, msglen);
+    lmots_digits(a, Q, o);
+
+    lmots_secret(y, chains, I, q, seed, o);
+    for (unsigned i = 0; i < o->p; i++) {
+        chains[i].start = 0;
+        chains[i].end = a[i];
+    }
+    run_chains(I, q, chains, o->p);
+}
+
+/**
+ * @brief Candidate public key hash from a signature (RFC 8554 Algorithm 4b)
+ */
+static void lmots_candidate(uint8_t Kc[LMS_N], const uint8_t *sig, const uint8_t *I, uint32_t q,
+                            const lmots_params_t *o, const uint8_t *message, size_t msglen) {
+    uint8_t Q[LMS_N];
+    uint16_t a[LMOTS_MAX_P];
+    uint8_t z[LMOTS_MAX_P * LMS_N];
+    lmots_chain_t chains[LMOTS_MAX_P];
+
+    lmots_message_hash(Q, I, q, sig + 4, message, msglen);
+    lmots_digits(a, Q, o);
+
+    memcpy(z, sig + 4 + LMS_N, (size_t)o->p * LMS_N);
+    for (unsigned i = 0; i < o->p; i++) {
+        chains[i] = (lmots_chain_t){ z + (size_t)i * LMS_N, (uint16_t)i, a[i],
+                                     (uint16_t)((1U << o->w) - 1) };
+    }
+    run_chains(I, q, chains, o->p);
+    lmots_public_hash(Kc, I, q, z, o);
+}
+
+// ============================================================================
+// LMS Trees
+// ============================================================================
+
+static void lms_node_hash(uint8_t out[LMS_N], const uint8_t *I, uint32_t r, uint16_t d,
+                          const uint8_t *a, const uint8_t *b) {
+    uint8_t buf[LMS_I_BYTES + 6 + 2 * LMS_N];
+    size_t len = LMS_I_BYTES + 6 + LMS_N;
+
+    memcpy(buf, I, LMS_I_BYTES);
+    store_be32(buf + LMS_I_BYTES, r);
+    store_be16(buf + LMS_I_BYTES + 4, d);
+    memcpy(buf + LMS_I_BYTES + 6, a, LMS_N);
+    if (b) {
+        memcpy(buf + LMS_I_BYTES + 6 + LMS_N, b, LMS_N);
+        len += LMS_N;
+    }
+    sha256(out, buf, len);
+}
+
+/**
+ * @brief All nodes T[1 .. 2^(h+1)-1] of one tree, T[r] at nodes + r*n
+ */
+static void lms_build_tree(uint8_t *nodes, const uint8_t *I, const uint8_t *seed,
+                           const lms_params_t *t, const lmots_params_t *o) {
+    uint32_t leaves = (uint32_t)1 << t->h;
+    uint8_t K[LMS_N];
+
+    for (uint32_t q = 0; q < leaves; q++) {
+        lmots_public_key(K, I, q, seed, o);
+        lms_node_hash(nodes + (size_t)(leaves + q) * LMS_N, I, leaves + q, D_LEAF, K, NULL);
+    }
+    for (uint32_t r = leaves - 1; r >= 1; r--) {
+        lms_node_hash(nodes + (size_t)r * LMS_N, I, r, D_INTR,
+                      nodes + (size_t)2 * r * LMS_N, nodes + (size_t)(2 * r + 1) * LMS_N);
+    }
+}
+
+static void lms_public_key(uint8_t *pub, const uint8_t *I, const uint8_t *nodes,
+                           const lms_params_t *t, const lmots_params_t *o) {
+    store_be32(pub, t->type);
+    store_be32(pub + 4, o->type);
+    memcpy(pub + 8, I, LMS_I_BYTES);
+    memcpy(pub + 8 + LMS_I_BYTES, nodes + LMS_N, LMS_N);
+}
+
+/**
+ * @brief u32(q) || LM-OTS signature || u32(type) || path[0..h-1]
+ */
+static void lms_sign(uint8_t *sig, const uint8_t *I, const uint8_t *seed, const uint8_t *nodes,
+                     const lms_params_t *t, const lmots_params_t *o, uint32_t q,
+                     const uint8_t *message, size_t msglen) {
+    uint32_t node = ((uint32_t)1 << t->h) + q;
+
+    store_be32(sig, q);
+    lmots_sign(sig + 4, I, q, seed, o, message, msglen);
+    sig += 4 + lmots_sig_bytes(o);
+    store_be32(sig, t->type);
+    for (unsigned i = 0; i < t->h; i++) {
+        memcpy(sig + 4 + (size_t)i * LMS_N, nodes + (size_t)((node >> i) ^ 1) * LMS_N, LMS_N);
+    }
+}
+
+/**
+ * @brief Verify one LMS signature at the start of sig (RFC 8554 Algorithm 6a)
+ *
+ * @param[out] used Bytes of sig the LMS signature occupies
+ */
+static pqc_result_t lms_verify(const uint8_t *pub, const uint8_t *sig, size_t siglen,
+                               size_t *used, const uint8_t *message, size_t msglen) {
+    const lms_params_t *t = find_lms(load_be32(pub));
+    const lmots_params_t *o = find_lmots(load_be32(pub + 4));
+    const uint8_t *I = pub + 8;
+    uint8_t Kc[LMS_N], tmp[LMS_N];
+
+    if (!t || !o || siglen < 8) {
+        return PQC_ERROR_INVALID_SIGNATURE;
+    }
+    uint32_t q = load_be32(sig);
+    if (load_be32(sig + 4) != o->type || siglen < lms_sig_bytes(t, o) ||
+        load_be32(sig + 4 + lmots_sig_bytes(o)) != t->type || q >= ((uint32_t)1 << t->h)) {
+        return PQC_ERROR_INVALID_SIGNATURE;
+    }
+    *used = lms_sig_bytes(t, o);
+
+    lmots_candidate(Kc, sig + 4, I, q, o, message, msglen);
+    const uint8_t *path = sig + 8 + lmots_sig_bytes(o);
+    uint32_t node = ((uint32_t)1 << t->h) + q;
+    lms_node_hash(tmp, I, node, D_LEAF, Kc, NULL);
+    for (unsigned i = 0; node > 1; i++, node >>= 1) {
+        if (node & 1) {
+            lms_node_hash(tmp, I, node >> 1, D_INTR, path + (size_t)i * LMS_N, tmp);
+        } else {
+            lms_node_hash(tmp, I, node >> 1, D_INTR, tmp, path + (size_t)i * LMS_N);
+        }
+    }
+    return secure_memcmp(tmp, pub + 8 + LMS_I_BYTES, LMS_N) == 0
+           ? PQC_SUCCESS : PQC_ERROR_INVALID_SIGNATURE;
+}
+
+// ============================================================================
+// HSS Parameters and State Record
+// ============================================================================
+
+/**
+ * @brief Validate a hypertree shape for signing
+ * @return Total height (log2 of the number of signatures), 0 if invalid
+ */
+static unsigned params_height(const hss_params_t *params) {
+    unsigned total = 0;
+    if (params->levels < 1 || params->levels > HSS_MAX_LEVELS) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < params->levels; i++) {
+        const lms_params_t *t = find_lms(params->lms_type[i]);
+        if (!t || t->h > HSS_MAX_SIGN_HEIGHT || !find_lmots(params->lmots_type[i])) {
+            return 0;
+        }
+        total += t->h;
+    }
+    return total < 64 ? total : 0;
+}
+
+size_t hss_signature_bytes(const hss_params_t *params) {
+    if (!params || params->levels < 1 || params->levels > HSS_MAX_LEVELS) {
+        return 0;
+    }
+    size_t bytes = 4;
+    for (uint32_t i = 0; i < params->levels; i++) {
+        const lms_params_t *t = find_lms(params->lms_type[i]);
+        const lmots_params_t *o = find_lmots(params->lmots_type[i]);
+        if (!t || !o) {
+            return 0;
+        }
+        // Level i signs level i+1's public key; the bottom level signs the message
+        bytes += lms_sig_bytes(t, o) + (i + 1 < params->levels ? LMS_PUBLIC_BYTES : 0);
+    }
+    return bytes;
+}
+
+/**
+ * @brief magic || key id || reserved index || check
+ */
+static void record_encode(uint8_t rec[HSS_NV_RECORD_BYTES], const uint8_t *key_id,
+                          uint64_t reserved) {
+    uint8_t digest[SHA256_DIGEST_BYTES];
+
+    store_be32(rec, HSS_NV_MAGIC);
+    memcpy(rec + 4, key_id, LMS_I_BYTES);
+    store_be32(rec + 20, (uint32_t)(reserved >> 32));
+    store_be32(rec + 24, (uint32_t)reserved);
+    sha256(digest, rec, 28);
+    memcpy(rec + 28, digest, 4);
+}
+
+static pqc_result_t record_decode(const uint8_t rec[HSS_NV_RECORD_BYTES], const uint8_t *key_id,
+                                  uint64_t *reserved) {
+    uint8_t digest[SHA256_DIGEST_BYTES];
+
+    sha256(digest, rec, 28);
+    if (load_be32(rec) != HSS_NV_MAGIC || memcmp(digest, rec + 28, 4) != 0 ||
+        memcmp(rec + 4, key_id, LMS_I_BYTES) != 0) {
+        return PQC_ERROR_INVALID_KEY;
+    }
+    *reserved = ((uint64_t)load_be32(rec + 20) << 32) | load_be32(rec + 24);
+    return PQC_SUCCESS;
+}
+
+// Private key layout: u32(L) || (u32 lms, u32 lmots) x HSS_MAX_LEVELS || SEED || I
+#define SK_OFF_SEED             (4 + 8 * HSS_MAX_LEVELS)
+#define SK_OFF_I                (SK_OFF_SEED + LMS_N)
+
+static pqc_result_t parse_secret_key(hss_params_t *params, const uint8_t *sk, size_t sklen) {
+    if (!sk || sklen != HSS_SECRETKEYBYTES) {
+        return PQC_ERROR_INVALID_KEY;
+    }
+    memset(params, 0, sizeof(*params));
+    params->levels = load_be32(sk);
+    if (params->levels < 1 || params->levels > HSS_MAX_LEVELS) {
+        return PQC_ERROR_INVALID_KEY;
+    }
+    for (uint32_t i = 0; i < params->levels; i++) {
+        params->lms_type[i] = load_be32(sk + 4 + 8 * i);
+        params->lmots_type[i] = load_be32(sk + 8 + 8 * i);
+    }
+    return params_height(params) ? PQC_SUCCESS : PQC_ERROR_INVALID_KEY;
+}
+
+// ============================================================================
+// Signer
+// ============================================================================
+
+typedef struct {
+    const lms_params_t *lms;
+    const lmots_params_t *ots;
+    uint8_t I[LMS_I_BYTES];
+    uint8_t seed[LMS_N];
+    uint8_t pub[LMS_PUBLIC_BYTES];
+    uint8_t *nodes;                     /**< T[1 .. 2^(h+1)-1] */
+    size_t nodes_len;
+    uint8_t *sig;                       /**< Parent's signature of pub (levels > 0) */
+    size_t sig_len;
+    unsigned shift;                     /**< Total height of the levels below */
+    uint64_t tree;                      /**< Which tree of this level is loaded */
+} hss_level_t;
+
+struct hss_signer {
+    pthread_mutex_t lock;
+    uint32_t levels;
+    hss_level_t level[HSS_MAX_LEVELS];
+    uint64_t next;                      /**< Next unused global index */
+    uint64_t reserved;                  /**< NV records indices below this as spent */
+    uint64_t limit;                     /**< Number of signatures of the key */
+    uint32_t reserve;
+    hss_nv_store_t store;
+    uint8_t key_id[LMS_I_BYTES];
+};
+
+static inline uint32_t level_leaf(const hss_level_t *lv, uint64_t index) {
+    return (uint32_t)((index >> lv->shift) & (((uint64_t)1 << lv->lms->h) - 1));
+}
+
+/**
+ * @brief Load the trees the next signature needs, top-down
+ *
+ * A level is rebuilt when the tree it needs changed; the parent then
+ * signs its new public key at the parent's current leaf.
+ */
+static void signer_load_trees(hss_signer_t *s, bool force) {
+    for (uint32_t i = 1; i < s->levels; i++) {
+        hss_level_t *lv = &s->level[i];
+        hss_level_t *parent = &s->level[i - 1];
+        uint64_t tree = s->next >> (lv->shift + lv->lms->h);
+        if (!force && tree == lv->tree) {
+            continue;
+        }
+        force = true;
+
+        uint32_t q = level_leaf(parent, s->next);
+        uint8_t I[LMS_N];
+        derive(I, parent->I, q, DERIVE_I, parent->seed);
+        memcpy(lv->I, I, LMS_I_BYTES);
+        derive(lv->seed, parent->I, q, DERIVE_SEED, parent->seed);
+
+        lms_build_tree(lv->nodes, lv->I, lv->seed, lv->lms, lv->ots);
+        lms_public_key(lv->pub, lv->I, lv->nodes, lv->lms, lv->ots);
+        lms_sign(lv->sig, parent->I, parent->seed, parent->nodes, parent->lms, parent->ots,
+                 q, lv->pub, LMS_PUBLIC_BYTES);
+        lv->tree = tree;
+    }
+}
+
+static void signer_free(hss_signer_t *s) {
+    for (uint32_t i = 0; i < HSS_MAX_LEVELS; i++) {
+        hss_level_t *lv = &s->level[i];
+        if (lv->nodes) {
+            secure_free(lv->nodes, lv->nodes_len);
+        }
+        if (lv->sig) {
+            secure_free(lv->sig, lv->sig_len);
+        }
+    }
+    secure_memzero(s, sizeof(*s));
+    secure_free(s, sizeof(*s));
+}
+
+/**
+ * @brief Allocate the signer and set up level 0 from the private key
+ */
+static pqc_result_t signer_alloc(hss_signer_t **out, const hss_params_t *params,
+                                 const uint8_t *sk) {
+    hss_signer_t *s = secure_malloc(sizeof(*s));
+    if (!s) {
+        return PQC_ERROR_INSUFFICIENT_MEMORY;
+    }
+    memset(s, 0, sizeof(*s));
+    s->levels = params->levels;
+
+    unsigned shift = 0;
+    for (uint32_t i = params->levels; i-- > 0;) {
+        hss_level_t *lv = &s->level[i];
+        lv->lms = find_lms(params->lms_type[i]);
+        lv->ots = find_lmots(params->lmots_type[i]);
+        lv->shift = shift;
+        shift += lv->lms->h;
+        lv->nodes_len = ((size_t)2 << lv->lms->h) * LMS_N;
+        lv->nodes = secure_malloc(lv->nodes_len);
+        if (i > 0) {
+            lv->sig_len = lms_sig_bytes(find_lms(params->lms_type[i - 1]),
+                                        find_lmots(params->lmots_type[i - 1]));
+            lv->sig = secure_malloc(lv->sig_len);
+        }
+        if (!lv->nodes || (i > 0 && !lv->sig)) {
+            signer_free(s);
+            return PQC_ERROR_INSUFFICIENT_MEMORY;
+        }
+    }
+    s->limit = (uint64_t)1 << shift;
+
+    memcpy(s->level[0].seed, sk + SK_OFF_SEED, LMS_N);
+    memcpy(s->level[0].I, sk + SK_OFF_I, LMS_I_BYTES);
+    memcpy(s->key_id, s->level[0].I, LMS_I_BYTES);
+    lms_build_tree(s->level[0].nodes, s->level[0].I, s->level[0].seed,
+                   s->level[0].lms, s->level[0].ots);
+    lms_public_key(s->level[0].pub, s->level[0].I, s->level[0].nodes,
+                   s->level[0].lms, s->level[0].ots);
+    *out = s;
+    return PQC_SUCCESS;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+pqc_result_t hss_keypair(const hss_params_t *params, uint8_t *pk, uint8_t *sk,
+                         const hss_nv_store_t *store) {
+    PQC_BYTES_SCOPE("hss_keypair");
+    if (!params || !pk || !sk || !store || !store->write || !params_height(params)) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    PQC_TRACE_OP_ENTRY("hss_keypair", 0);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_KEYGEN);
+
+    memset(sk, 0, HSS_SECRETKEYBYTES);
+    store_be32(sk, params->levels);
+    for (uint32_t i = 0; i < params->levels; i++) {
+        store_be32(sk + 4 + 8 * i, params->lms_type[i]);
+        store_be32(sk + 8 + 8 * i, params->lmots_type[i]);
+    }
+
+    hss_signer_t *s = NULL;
+    pqc_result_t result = pqc_randombytes(sk + SK_OFF_SEED, LMS_N + LMS_I_BYTES);
+    if (result != PQC_SUCCESS) {
+        result = PQC_ERROR_RANDOM_GENERATION;
+    } else {
+        result = signer_alloc(&s, params, sk);
+    }
+    if (result == PQC_SUCCESS) {
+        uint8_t rec[HSS_NV_RECORD_BYTES];
+        record_encode(rec, s->key_id, 0);
+        result = store->write(store->ctx, rec);
+    }
+    if (result == PQC_SUCCESS) {
+        store_be32(pk, params->levels);
+        memcpy(pk + 4, s->level[0].pub, LMS_PUBLIC_BYTES);
+    } else {
+        secure_memzero(sk, HSS_SECRETKEYBYTES);
+    }
+    if (s) {
+        signer_free(s);
+    }
+
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_KEYGEN);
+    PQC_TRACE_OP_RETURN("hss_keypair", result, result == PQC_SUCCESS ? HSS_PUBLICKEYBYTES : 0);
+    return result;
+}
+
+pqc_result_t hss_signer_open(hss_signer_t **signer, const uint8_t *sk, size_t sklen,
+                             const hss_nv_store_t *store, uint32_t reserve) {
+    PQC_BYTES_SCOPE("hss_signer_open");
+    if (!signer || !store || !store->read || !store->write) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    hss_params_t params;
+    pqc_result_t result = parse_secret_key(&params, sk, sklen);
+    if (result != PQC_SUCCESS) {
+        return result;
+    }
+
+    hss_signer_t *s;
+    result = signer_alloc(&s, &params, sk);
+    if (result != PQC_SUCCESS) {
+        return result;
+    }
+
+    uint8_t rec[HSS_NV_RECORD_BYTES];
+    result = store->read(store->ctx, rec);
+    if (result == PQC_SUCCESS) {
+        result = record_decode(rec, s->key_id, &s->reserved);
+    }
+    if (result == PQC_SUCCESS && pthread_mutex_init(&s->lock, NULL) != 0) {
+        result = PQC_ERROR_INTERNAL;
+    }
+    if (result != PQC_SUCCESS) {
+        signer_free(s);
+        return result;
+    }
+
+    // Whatever a previous signer reserved may have been used
+    s->next = s->reserved;
+    s->reserve = reserve ? reserve : HSS_DEFAULT_RESERVE;
+    s->store = *store;
+    if (s->next < s->limit) {
+        signer_load_trees(s, true);
+    }
+    *signer = s;
+    return PQC_SUCCESS;
+}
+
+pqc_result_t hss_sign(hss_signer_t *signer, uint8_t *signature, size_t *siglen,
+                      const uint8_t *message, size_t msglen) {
+    PQC_BYTES_SCOPE("hss_sign");
+    if (!signer || !signature || !siglen || (!message && msglen)) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    PQC_TRACE_OP_ENTRY("hss_sign", msglen);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_SIGN_ENCAPS);
+    pthread_mutex_lock(&signer->lock);
+
+    pqc_result_t result = PQC_SUCCESS;
+    hss_signer_t *s = signer;
+    if (s->next >= s->limit) {
+        result = PQC_ERROR_INVALID_KEY;
+        goto out;
+    }
+
+    // Record the index as spent before any signature with it exists
+    if (s->next >= s->reserved) {
+        uint64_t reserved = s->limit - s->next > s->reserve ? s->next + s->reserve : s->limit;
+        uint8_t rec[HSS_NV_RECORD_BYTES];
+        record_encode(rec, s->key_id, reserved);
+        result = s->store.write(s->store.ctx, rec);
+        if (result != PQC_SUCCESS) {
+            goto out;
+        }
+        s->reserved = reserved;
+    }
+
+    signer_load_trees(s, false);
+
+    // u32(L-1) || (sig[i] || pub[i+1]) for i < L-1 || sig[L-1]
+    uint8_t *p = signature;
+    store_be32(p, s->levels - 1);
+    p += 4;
+    for (uint32_t i = 1; i < s->levels; i++) {
+        memcpy(p, s->level[i].sig, s->level[i].sig_len);
+        p += s->level[i].sig_len;
+        memcpy(p, s->level[i].pub, LMS_PUBLIC_BYTES);
+        p += LMS_PUBLIC_BYTES;
+    }
+    hss_level_t *bottom = &s->level[s->levels - 1];
+    lms_sign(p, bottom->I, bottom->seed, bottom->nodes, bottom->lms, bottom->ots,
+             level_leaf(bottom, s->next), message, msglen);
+    p += lms_sig_bytes(bottom->lms, bottom->ots);
+    *siglen = (size_t)(p - signature);
+    s->next++;
+
+out:
+    pthread_mutex_unlock(&signer->lock);
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_SIGN_ENCAPS);
+    PQC_TRACE_OP_RETURN("hss_sign", result, result == PQC_SUCCESS ? *siglen : 0);
+    return result;
+}
+
+uint64_t hss_signer_remaining(const hss_signer_t *signer) {
+    return signer ? signer->limit - signer->next : 0;
+}
+
+void hss_signer_close(hss_signer_t *signer) {
+    if (!signer) {
+        return;
+    }
+    pthread_mutex_destroy(&signer->lock);
+    signer_free(signer);
+}
+
+pqc_result_t hss_verify(const uint8_t *signature, size_t siglen,
+                        const uint8_t *message, size_t msglen,
+                        const uint8_t *pk, size_t pklen) {
+    PQC_BYTES_SCOPE("hss_verify");
+    if (!signature || (!message && msglen) || !pk) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    if (pklen != HSS_PUBLICKEYBYTES) {
+        return PQC_ERROR_INVALID_KEY;
+    }
+
+    PQC_TRACE_OP_ENTRY("hss_verify", msglen);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_VERIFY_DECAPS);
+
+    pqc_result_t result = PQC_ERROR_INVALID_SIGNATURE;
+    uint32_t levels = load_be32(pk);
+    if (siglen < 4 || levels < 1 || levels > HSS_MAX_LEVELS ||
+        load_be32(signature) != levels - 1) {
+        goto out;
+    }
+
+    // Walk down the chain of signed public keys, then check the message
+    const uint8_t *key = pk + 4;
+    size_t off = 4;
+    for (uint32_t i = 0; i < levels; i++) {
+        bool last = i + 1 == levels;
+        size_t used;
+        const uint8_t *next_key = NULL;
+        if (!last) {
+            // The signed key follows the signature; its offset needs the signature's size
+            const lms_params_t *t = find_lms(load_be32(key));
+            const lmots_params_t *o = find_lmots(load_be32(key + 4));
+            if (!t || !o || siglen - off < lms_sig_bytes(t, o) + LMS_PUBLIC_BYTES) {
+                goto out;
+            }
+            next_key = signature + off + lms_sig_bytes(t, o);
+        }
+        result = lms_verify(key, signature + off, siglen - off, &used,
+                            last ? message : next_key, last ? msglen : LMS_PUBLIC_BYTES);
+        if (result != PQC_SUCCESS) {
+            goto out;
+        }
+        off += used;
+        if (!last) {
+            key = next_key;
+            off += LMS_PUBLIC_BYTES;
+        }
+    }
+    result = off == siglen ? PQC_SUCCESS : PQC_ERROR_INVALID_SIGNATURE;
+
+out:
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_VERIFY_DECAPS);
+    PQC_TRACE_OP_RETURN("hss_verify", result, 0);
+    return result;
+}
+
+// ============================================================================
+// File Store
+// ============================================================================
+
+static pqc_result_t file_store_read(void *ctx, uint8_t record[HSS_NV_RECORD_BYTES]) {
+    int fd = open((const char *)ctx, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+    ssize_t n = read(fd, record, HSS_NV_RECORD_BYTES);
+    close(fd);
+    return n == HSS_NV_RECORD_BYTES ? PQC_SUCCESS : PQC_ERROR_HARDWARE_FAILURE;
+}
+
+static pqc_result_t file_store_write(void *ctx, const uint8_t record[HSS_NV_RECORD_BYTES]) {
+    const char *path = ctx;
+    char tmp[PATH_MAX];
+    char dir[PATH_MAX];
+
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+    bool ok = write(fd, record, HSS_NV_RECORD_BYTES) == HSS_NV_RECORD_BYTES && fsync(fd) == 0;
+    ok = close(fd) == 0 && ok;
+    if (!ok || rename(tmp, path) != 0) {
+        unlink(tmp);
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+
+    // The rename itself must reach the disk before the index is used
+    const char *slash = strrchr(path, '/');
+    if (!slash) {
+        snprintf(dir, sizeof(dir), ".");
+    } else {
+        snprintf(dir, sizeof(dir), "%.*s", slash == path ? 1 : (int)(slash - path), path);
+    }
+    fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+    ok = fsync(fd) == 0;
+    close(fd);
+    return ok ? PQC_SUCCESS : PQC_ERROR_HARDWARE_FAILURE;
+}
+
+pqc_result_t hss_nv_file_store(hss_nv_store_t *store, const char *path) {
+    if (!store || !path || strlen(path) + sizeof(".tmp") > PATH_MAX) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    store->read = file_store_read;
+    store->write = file_store_write;
+    store->ctx = (void *)path;
+    return PQC_SUCCESS;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file lms.h
+ * @brief HSS/LMS stateful hash-based signatures (RFC 8554, SHA-256/M32)
+ *
+ * HSS verification is a few hundred to a few thousand single-block
+ * SHA-256 compressions and nothing else, which makes it the cheapest
+ * post-quantum verifier available to boot-time firmware checks. The price
+ * is state on the signing side: every LM-OTS key may sign only once.
+ *
+ * The private key blob never changes. The only mutable state is the index
+ * of the next one-time key, kept in a small record on crash-safe NV storage
+ * (a TPM NV index or a file) behind hss_nv_store_t. Indices are reserved
+ * from NV in batches: before signing with an index beyond the reservation,
+ * the signer durably records a new upper bound and only then signs, so a
+ * crash can waste at most one batch of indices but never reuse one, and
+ * signing pays one NV write per batch instead of one per signature.
+ */
+
+#ifndef LMS_H
+#define LMS_H
+
+#include "pqc_common.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// LMS tree types (RFC 8554 section 5.1)
+#define LMS_SHA256_M32_H5       5
+#define LMS_SHA256_M32_H10      6
+#define LMS_SHA256_M32_H15      7
+#define LMS_SHA256_M32_H20      8
+#define LMS_SHA256_M32_H25      9
+
+// LM-OTS types (RFC 8554 section 4.1)
+#define LMOTS_SHA256_N32_W1     1
+#define LMOTS_SHA256_N32_W2     2
+#define LMOTS_SHA256_N32_W4     3
+#define LMOTS_SHA256_N32_W8     4
+
+#define HSS_MAX_LEVELS          8       /**< Maximum hypertree levels */
+#define HSS_MAX_SIGN_HEIGHT     15      /**< Tallest tree a signer keeps in memory */
+#define HSS_PUBLICKEYBYTES      60      /**< u32 L || LMS public key */
+#define HSS_SECRETKEYBYTES      (4 + 8 * HSS_MAX_LEVELS + 48)
+#define HSS_NV_RECORD_BYTES     32      /**< Size of the persisted state record */
+#define HSS_DEFAULT_RESERVE     64      /**< Default indices reserved per NV write */
+
+/**
+ * @brief Hypertree shape: one LMS and one LM-OTS type per level, top first
+ */
+typedef struct {
+    uint32_t levels;
+    uint32_t lms_type[HSS_MAX_LEVELS];
+    uint32_t lmots_type[HSS_MAX_LEVELS];
+} hss_params_t;
+
+/**
+ * @brief Crash-safe storage for the signer's state record
+ *
+ * write() must not return PQC_SUCCESS before the record is durable, and a
+ * crash during write() must leave either the old or the new record.
+ */
+typedef struct {
+    pqc_result_t (*read)(void *ctx, uint8_t record[HSS_NV_RECORD_BYTES]);
+    pqc_result_t (*write)(void *ctx, const uint8_t record[HSS_NV_RECORD_BYTES]);
+    void *ctx;
+} hss_nv_store_t;
+
+/**
+ * @brief Stateful signer opened on a private key and its NV store
+ */
+typedef struct hss_signer hss_signer_t;
+
+// ============================================================================
+// Key Generation and Signing
+// ============================================================================
+
+/**
+ * @brief Signature size for a hypertree shape
+ * @return Size in bytes, 0 if the parameters are invalid
+ */
+size_t hss_signature_bytes(const hss_params_t *params);
+
+/**
+ * @brief Generate an HSS keypair and initialize its NV state record
+ *
+ * @param[in] params Hypertree shape, tree heights at most HSS_MAX_SIGN_HEIGHT
+ * @param[out] pk Public key (HSS_PUBLICKEYBYTES)
+ * @param[out] sk Private key (HSS_SECRETKEYBYTES)
+ * @param[in] store NV store that will hold the signing state
+ * @return PQC_SUCCESS on success, error code on failure
+ */
+pqc_result_t hss_keypair(const hss_params_t *params, uint8_t *pk, uint8_t *sk,
+                         const hss_nv_store_t *store);
+
+/**
+ * @brief Open a signer
+ *
+ * Resumes at the index recorded in NV, skipping whatever the previous
+ * signer had reserved but not used, and builds the current tree of each
+ * level in memory.
+ *
+ * @param[out] signer New signer
+ * @param[in] sk Private key
+ * @param[in] sklen Length of private key
+ * @param[in] store NV store initialized by hss_keypair(); must outlive the signer
+ * @param[in] reserve Indices reserved per NV write, 0 for HSS_DEFAULT_RESERVE
+ * @return PQC_SUCCESS on success, PQC_ERROR_INVALID_KEY if the record does
+ *         not belong to the key, error code on other failures
+ */
+pqc_result_t hss_signer_open(hss_signer_t **signer, const uint8_t *sk, size_t sklen,
+                             const hss_nv_store_t *store, uint32_t reserve);
+
+/**
+ * @brief Sign a message; calls on one signer are serialized
+ *
+ * @param[in] signer Signer
+ * @param[out] signature Signature buffer (hss_signature_bytes())
+ * @param[out] siglen Length of the generated signature
+ * @param[in] message Message to sign
+ * @param[in] msglen Length of message
+ * @return PQC_SUCCESS on success, PQC_ERROR_INVALID_KEY when the key is
+ *         exhausted, PQC_ERROR_HARDWARE_FAILURE if the NV write failed
+ */
+pqc_result_t hss_sign(hss_signer_t *signer, uint8_t *signature, size_t *siglen,
+                      const uint8_t *message, size_t msglen);
+
+/**
+ * @brief Signatures left before the key is exhausted
+ */
+uint64_t hss_signer_remaining(const hss_signer_t *signer);
+
+/**
+ * @brief Close a signer and wipe its secrets
+ *
+ * Unused reserved indices are not returned to NV; they are skipped by the
+ * next signer.
+ */
+void hss_signer_close(hss_signer_t *signer);
+
+// ============================================================================
+// Verification
+// ============================================================================
+
+/**
+ * @brief Verify an HSS signature
+ *
+ * Accepts every LMS/LM-OTS type above. The one-time signature chains of
+ * each level are hashed eight at a time with the multi-buffer SHA-256
+ * backend.
+ *
+ * @param[in] signature Signature to verify
+ * @param[in] siglen Length of signature
+ * @param[in] message Original message
+ * @param[in] msglen Length of message
+ * @param[in] pk Public key
+ * @param[in] pklen Length of public key
+ * @return PQC_SUCCESS if the signature is valid, error code if invalid
+ */
+pqc_result_t hss_verify(const uint8_t *signature, size_t siglen,
+                        const uint8_t *message, size_t msglen,
+                        const uint8_t *pk, size_t pklen);
+
+// ============================================================================
+// NV Stores
+// ============================================================================
+
+/**
+ * @brief File-backed store
+ *
+ * Records are written to "<path>.tmp", fsync'd and renamed over path, and
+ * the directory is fsync'd.
+ *
+ * @param[out] store Store to initialize
+ * @param[in] path Record file; the string must outlive the store
+ * @return PQC_SUCCESS on success, PQC_ERROR_INVALID_PARAMETER if path is too long
+ */
+pqc_result_t hss_nv_file_store(hss_nv_store_t *store, const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LMS_H */
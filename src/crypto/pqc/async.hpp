@@ -0,0 +1,592 @@
+/**
+ * @file async.hpp
+ * @brief C++20 coroutine tasks and the executor they run on
+ *
+ * Task<T> is a lazily started coroutine; awaiting it runs it and resumes
+ * the awaiter when it finishes. Executor resumes suspended coroutines on
+ * the native work-stealing pool (pqc_executor.h), normally the shared one
+ * the batch APIs run on as well. Blocking devices (the TPM, see
+ * attestation.hpp) and callback-based I/O (async_io) complete by posting
+ * the waiting coroutine back to the pool, so thousands of operations can
+ * be in flight on a handful of threads.
+ *
+ * Every queue entry is embedded in the awaiter that suspended, which lives
+ * in the coroutine frame: scheduling and completion never allocate. The
+ * frames themselves come from std::pmr (FrameAllocator), so a request can
+ * keep them in its own arena.
+ *
+ * Errors travel as pqc::Result values. An exception escaping a coroutine
+ * terminates the process.
+ */
+
+#ifndef PQC_ASYNC_HPP
+#define PQC_ASYNC_HPP
+
+#if !defined(__cpp_impl_coroutine) || __cplusplus < 202002L
+#error "pqc/async.hpp requires C++20 coroutines"
+#endif
+
+#include "../pqc_executor.h"
+#include "result.hpp"
+#include <condition_variable>
+#include <coroutine>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+// GCC pairs the frame's operator new(size, allocator_arg, mr, args...)
+// with operator delete(void *, size) and reports a mismatch, though that
+// is the deallocation function the standard has coroutines call
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace pqc {
+
+template <typename T>
+class Task;
+
+namespace detail {
+
+// ============================================================================
+// Work Queue
+// ============================================================================
+
+/**
+ * @brief Suspended coroutine waiting to be resumed, linked in place
+ *
+ * The pqc_task_t base is what the executor queues; a WorkQueue links
+ * items through the same next pointer.
+ */
+struct WorkItem : pqc_task_t {
+    std::coroutine_handle<> handle;
+};
+
+/**
+ * @brief Blocking intrusive FIFO of WorkItems
+ */
+class WorkQueue {
+public:
+    void push(WorkItem *item) noexcept {
+        item->next = nullptr;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tail_) {
+            tail_->next = item;
+        } else {
+            head_ = item;
+        }
+        tail_ = item;
+        ready_.notify_one();
+    }
+
+    /**
+     * @brief Next item; NULL once stopped and drained
+     */
+    WorkItem *pop() noexcept {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this] { return head_ != nullptr || stopped_; });
+        WorkItem *item = head_;
+        if (item) {
+            head_ = static_cast<WorkItem *>(item->next);
+            if (!head_) {
+                tail_ = nullptr;
+            }
+        }
+        return item;
+    }
+
+    void stop() noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+        ready_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    WorkItem *head_ = nullptr;
+    WorkItem *tail_ = nullptr;
+    bool stopped_ = false;
+};
+
+// ============================================================================
+// Task Promise
+// ============================================================================
+
+/**
+ * @brief Coroutine frame allocation through std::pmr
+ *
+ * A coroutine whose first two parameters are (std::allocator_arg_t,
+ * std::pmr::memory_resource *) gets its frame from that resource, any
+ * other from std::pmr::get_default_resource().
+ */
+class FrameAllocator {
+public:
+    template <typename... Args>
+    static void *operator new(std::size_t size, std::allocator_arg_t,
+                              std::pmr::memory_resource *mr, Args &&...) {
+        return allocate_frame(size, mr);
+    }
+
+    static void *operator new(std::size_t size) {
+        return allocate_frame(size, std::pmr::get_default_resource());
+    }
+
+    static void operator delete(void *frame, std::size_t size) noexcept {
+        std::pmr::memory_resource *mr;
+        std::memcpy(&mr, static_cast<char *>(frame) + resource_offset(size), sizeof(mr));
+        mr->deallocate(frame, resource_offset(size) + sizeof(mr), kFrameAlign);
+    }
+
+private:
+    static constexpr std::size_t kFrameAlign = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    // The owning resource is stored just past the frame
+    static constexpr std::size_t resource_offset(std::size_t size) noexcept {
+        return (size + alignof(std::pmr::memory_resource *) - 1) &
+               ~(alignof(std::pmr::memory_resource *) - 1);
+    }
+
+    static void *allocate_frame(std::size_t size, std::pmr::memory_resource *mr) {
+        void *frame = mr->allocate(resource_offset(size) + sizeof(mr), kFrameAlign);
+        std::memcpy(static_cast<char *>(frame) + resource_offset(size), &mr, sizeof(mr));
+        return frame;
+    }
+};
+
+class PromiseBase : public FrameAllocator {
+public:
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+            std::coroutine_handle<> next = h.promise().continuation_;
+            return next ? next : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() const noexcept { std::terminate(); }
+
+    void set_continuation(std::coroutine_handle<> continuation) noexcept {
+        continuation_ = continuation;
+    }
+
+private:
+    std::coroutine_handle<> continuation_;
+};
+
+template <typename T>
+class Promise : public PromiseBase {
+public:
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U &&value) noexcept(std::is_nothrow_constructible<T, U &&>::value) {
+        value_.emplace(std::forward<U>(value));
+    }
+
+    T take() noexcept { return std::move(*value_); }
+
+private:
+    std::optional<T> value_;
+};
+
+template <>
+class Promise<void> : public PromiseBase {
+public:
+    Task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+    void take() const noexcept {}
+};
+
+/**
+ * @brief Fire-and-forget coroutine; its frame frees itself on completion
+ */
+struct Detached {
+    struct promise_type : FrameAllocator {
+        Detached get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+} // namespace detail
+
+// ============================================================================
+// Task<T>
+// ============================================================================
+
+/**
+ * @brief Lazily started coroutine producing T
+ *
+ * Move-only; destroying a Task that has not completed destroys its frame,
+ * so keep it alive (or co_await it) until it finishes.
+ */
+template <typename T = void>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::Promise<T>;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    Task() noexcept = default;
+    explicit Task(handle_type handle) noexcept : handle_(handle) {}
+
+    Task(Task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    Task &operator=(Task &&other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept { return !handle_ || handle_.done(); }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept {
+        handle_.promise().set_continuation(awaiter);
+        return handle_;
+    }
+
+    T await_resume() noexcept { return handle_.promise().take(); }
+
+private:
+    handle_type handle_;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> Promise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+} // namespace detail
+
+// ============================================================================
+// Executor
+// ============================================================================
+
+/**
+ * @brief Scheduling priority of a coroutine
+ */
+enum class Priority {
+    Latency = PQC_TASK_PRIORITY_LATENCY,    /**< Ahead of queued bulk work, e.g. signing */
+    Bulk = PQC_TASK_PRIORITY_BULK
+};
+
+/**
+ * @brief Resumes coroutines on a native work-stealing pool
+ *
+ * Executor::shared() posts to the process-wide pool (pqc_executor_shared())
+ * that batch verification and the other batch APIs use, so coroutines and
+ * batches share one set of threads; prefer it. Constructing an Executor
+ * starts a private pool.
+ *
+ * Destroy the executor only after every coroutine that may still post to
+ * it has finished, including those waiting on a device or on I/O.
+ */
+class Executor {
+public:
+    /**
+     * @param[in] threads Worker threads of the private pool, 0 for
+     *                    pqc_executor_default_workers()
+     */
+    explicit Executor(unsigned threads = 0) {
+        pqc_executor_config_t config{};
+        config.workers = threads;
+        pqc_result_t rc = pqc_executor_create(&native_, &config);
+        if (rc != PQC_SUCCESS) {
+            detail::throw_error(Error(rc));
+        }
+    }
+
+    Executor(const Executor &) = delete;
+    Executor &operator=(const Executor &) = delete;
+
+    ~Executor() { pqc_executor_destroy(native_); }
+
+    /**
+     * @brief The process-wide pool
+     *
+     * Looked up on every post, so it follows pqc_cleanup() shutting the
+     * shared pool down and a later call starting it again.
+     */
+    static Executor &shared() noexcept {
+        static Executor executor(nullptr);
+        return executor;
+    }
+
+    /**
+     * @brief The native executor, for pqc_executor_get_stats()
+     */
+    pqc_executor_t *get() const noexcept { return native_ ? native_ : pqc_executor_shared(); }
+
+    unsigned size() const noexcept { return pqc_executor_size(get()); }
+
+    /**
+     * @brief Queue item->handle for resumption on a worker
+     */
+    void post(detail::WorkItem *item, Priority priority = Priority::Bulk) noexcept {
+        pqc_executor_t *executor = get();
+        if (!executor) {
+            // The shared pool failed to start; keep the coroutine going here
+            item->handle.resume();
+            return;
+        }
+        item->run = resume;
+        pqc_executor_submit(executor, item, static_cast<pqc_task_priority_t>(priority));
+    }
+
+    /**
+     * @brief Awaitable that continues the coroutine on a worker
+     */
+    class ScheduleAwaiter : detail::WorkItem {
+    public:
+        ScheduleAwaiter(Executor &executor, Priority priority) noexcept
+            : executor_(executor), priority_(priority) {}
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) noexcept {
+            handle = h;
+            executor_.post(this, priority_);
+        }
+        void await_resume() const noexcept {}
+
+    private:
+        Executor &executor_;
+        Priority priority_;
+    };
+
+    /**
+     * @param[in] priority Latency for work someone is waiting on, so it
+     *                     overtakes queued batches
+     */
+    ScheduleAwaiter schedule(Priority priority = Priority::Bulk) noexcept {
+        return ScheduleAwaiter(*this, priority);
+    }
+
+    /**
+     * @brief Start a task on a worker without waiting for it
+     */
+    void spawn(Task<void> task) { run_detached(*this, std::move(task)); }
+
+private:
+    static detail::Detached run_detached(Executor &executor, Task<void> task) {
+        co_await executor.schedule();
+        co_await task;
+    }
+
+    explicit Executor(std::nullptr_t) noexcept {}
+
+    static void resume(pqc_task_t *task) { static_cast<detail::WorkItem *>(task)->handle.resume(); }
+
+    pqc_executor_t *native_ = nullptr;          /**< Null for the shared pool */
+};
+
+// ============================================================================
+// Blocking Bridge
+// ============================================================================
+
+namespace detail {
+
+template <typename T>
+struct SyncState {
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    bool done = false;
+    std::optional<std::conditional_t<std::is_void<T>::value, bool, T>> value;
+};
+
+/**
+ * @brief Bridging coroutine of sync_wait()
+ *
+ * Signals the waiting thread only once suspended at its final point, and
+ * that thread destroys the frame. The worker that finished the task thus
+ * never touches the frame, or the resource it came from, after the
+ * caller may have returned.
+ */
+template <typename T>
+class SyncBridge {
+public:
+    struct promise_type : FrameAllocator {
+        promise_type(std::allocator_arg_t, std::pmr::memory_resource *, Task<T> &,
+                     SyncState<T> &state) noexcept
+            : state_(state) {}
+
+        struct Signal {
+            SyncState<T> &state;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<>) const noexcept {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                state.done = true;
+                state.done_cv.notify_one();
+            }
+            void await_resume() const noexcept {}
+        };
+
+        SyncBridge get_return_object() noexcept {
+            return SyncBridge(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        Signal final_suspend() const noexcept { return Signal{state_}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+
+    private:
+        SyncState<T> &state_;
+    };
+
+    SyncBridge(const SyncBridge &) = delete;
+    SyncBridge &operator=(const SyncBridge &) = delete;
+
+    ~SyncBridge() { handle_.destroy(); }
+
+private:
+    explicit SyncBridge(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+template <typename T>
+SyncBridge<T> sync_run(std::allocator_arg_t, std::pmr::memory_resource *, Task<T> &task,
+                       SyncState<T> &state) {
+    if constexpr (std::is_void<T>::value) {
+        co_await task;
+        state.value.emplace(true);
+    } else {
+        state.value.emplace(co_await task);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Run a task to completion, blocking the calling thread
+ *
+ * The task starts on the calling thread and may finish on any thread.
+ * Never call this from an executor worker.
+ *
+ * @param[in] mr Resource for the bridging coroutine's frame
+ */
+template <typename T>
+T sync_wait(std::allocator_arg_t, std::pmr::memory_resource *mr, Task<T> task) {
+    detail::SyncState<T> state;
+    detail::SyncBridge<T> bridge = detail::sync_run(std::allocator_arg, mr, task, state);
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.done_cv.wait(lock, [&state] { return state.done; });
+    if constexpr (!std::is_void<T>::value) {
+        return std::move(*state.value);
+    }
+}
+
+template <typename T>
+T sync_wait(Task<T> task) {
+    return sync_wait(std::allocator_arg, std::pmr::get_default_resource(), std::move(task));
+}
+
+// ============================================================================
+// Callback I/O
+// ============================================================================
+
+namespace detail {
+
+template <typename T>
+struct IoState : WorkItem {
+    Executor *executor = nullptr;
+    std::optional<T> value;
+};
+
+} // namespace detail
+
+/**
+ * @brief One-shot completion callback handed to an I/O initiation function
+ *
+ * Must be invoked exactly once, from any thread; the awaiting coroutine is
+ * resumed on the executor with the value.
+ */
+template <typename T>
+class Completer {
+public:
+    explicit Completer(detail::IoState<T> *state) noexcept : state_(state) {}
+
+    void operator()(T value) const {
+        state_->value.emplace(std::move(value));
+        state_->executor->post(state_);
+    }
+
+private:
+    detail::IoState<T> *state_;
+};
+
+template <typename T, typename Initiate>
+class IoAwaiter : detail::IoState<T> {
+public:
+    IoAwaiter(Executor &executor, Initiate initiate) : initiate_(std::move(initiate)) {
+        this->executor = &executor;
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> h) {
+        this->handle = h;
+        // The completion may resume (and destroy) this awaiter before the
+        // initiation function returns; run it from a local copy.
+        Initiate initiate = std::move(initiate_);
+        initiate(Completer<T>(this));
+    }
+
+    T await_resume() { return std::move(*this->value); }
+
+private:
+    Initiate initiate_;
+};
+
+/**
+ * @brief Await a callback-based operation
+ *
+ * initiate(Completer<T>) starts the operation (a registry lookup, a queue
+ * read) and arranges for the completer to be called with the result.
+ *
+ *     auto entry = co_await pqc::async_io<Result<Entry>>(executor,
+ *         [&](pqc::Completer<Result<Entry>> done) { registry.lookup(id, done); });
+ */
+template <typename T, typename Initiate>
+IoAwaiter<T, std::decay_t<Initiate>> async_io(Executor &executor, Initiate &&initiate) {
+    return IoAwaiter<T, std::decay_t<Initiate>>(executor, std::forward<Initiate>(initiate));
+}
+
+} // namespace pqc
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif /* PQC_ASYNC_HPP */
@@ -0,0 +1,232 @@
+/**
+ * @file attestation.hpp
+ * @brief Coroutine API for report verification and TPM commands (C++20)
+ *
+ *     pqc::Executor pool(4);
+ *     pqc::AsyncTpm tpm(pool);
+ *
+ *     pqc::Task<pqc::Status> check(const attestation_report_t &report,
+ *                                  const pqc::dilithium::PublicKey &key) {
+ *         auto quote = co_await tpm.quote(0xff);
+ *         auto verdict = co_await pqc::verify_report(pool, report, key);
+ *         ...
+ *     }
+ *
+ * A TPM executes one command at a time, and the simulated TPM keeps global
+ * state, so AsyncTpm owns a single thread that runs commands in
+ * submission order; the awaiting coroutine resumes on the executor. Route
+ * every TPM access in the process through one AsyncTpm.
+ */
+
+#ifndef PQC_ATTESTATION_HPP
+#define PQC_ATTESTATION_HPP
+
+#include "../../attestation/attestation_engine.h"
+#include "../../attestation/tpm2_interface.h"
+#include "async.hpp"
+#include "dilithium.hpp"
+#include "report.hpp"
+#include <array>
+#include <thread>
+
+// As in async.hpp, for the coroutines defined here
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace pqc {
+
+// ============================================================================
+// Report Verification
+// ============================================================================
+
+/**
+ * @brief Verify a report on an executor worker
+ *
+ * report and public_key are referenced, not copied, and must stay alive
+ * until the task completes.
+ *
+ * @return Verification details, or the error attestation_verify_report()
+ *         returned; an invalid report is a successful result with
+ *         is_valid false
+ */
+inline Task<Result<attestation_verification_result_t>>
+verify_report(Executor &executor, const attestation_report_t &report,
+              const dilithium::PublicKey &public_key) {
+    co_await executor.schedule();
+    attestation_verification_result_t verdict;
+    pqc_result_t rc = attestation_verify_report(&report, public_key.get(), &verdict);
+    if (rc != PQC_SUCCESS) {
+        co_return Error(rc);
+    }
+    co_return std::move(verdict);
+}
+
+/**
+ * @brief Verify a report on an executor worker, allocating from mr
+ *
+ * The coroutine frame and the result's description both come from mr, so
+ * with a per-request arena the verification makes no global heap
+ * allocation. mr must outlive the task.
+ */
+inline Task<Result<VerificationResult>>
+verify_report(std::allocator_arg_t, std::pmr::memory_resource *mr, Executor &executor,
+              const attestation_report_t &report, const dilithium::PublicKey &public_key) {
+    co_await executor.schedule();
+    co_return verify(report, public_key, mr);
+}
+
+/**
+ * @brief Sign an assembled report on an executor worker
+ *
+ * Scheduled as latency-critical work, so a device answering a challenge
+ * does not queue behind batch verification on the same pool. report and
+ * sk must stay alive until the task completes.
+ */
+inline Task<Status> sign_report(Executor &executor, attestation_report_t &report,
+                                const dilithium::SecretKey &sk) {
+    co_await executor.schedule(Priority::Latency);
+    co_return Status(attestation_sign_report(&report, sk.get()));
+}
+
+// ============================================================================
+// Asynchronous TPM
+// ============================================================================
+
+/**
+ * @brief TPM quote as produced by tpm2_quote()
+ */
+struct Quote {
+    std::array<uint8_t, 5 + MAX_PCR_REGISTERS * 32> data;   /**< "TPM2" || mask || PCRs */
+    size_t size = 0;
+
+    bytes_view bytes() const noexcept { return bytes_view(data.data(), size); }
+};
+
+using PcrValue = std::array<uint8_t, 32>;
+
+class AsyncTpm;
+
+namespace detail {
+
+/**
+ * @brief TPM command queued in the awaiting coroutine's frame
+ */
+struct TpmJob : WorkItem {
+    void (*run)(TpmJob *job) = nullptr;
+};
+
+template <typename R, typename F>
+class TpmAwaiter : TpmJob {
+public:
+    TpmAwaiter(AsyncTpm &tpm, F command) : tpm_(tpm), command_(std::move(command)) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) noexcept;
+    R await_resume() noexcept { return std::move(*result_); }
+
+private:
+    static void invoke(TpmJob *job) {
+        TpmAwaiter *self = static_cast<TpmAwaiter *>(job);
+        self->result_.emplace(self->command_());
+    }
+
+    AsyncTpm &tpm_;
+    F command_;
+    std::optional<R> result_;
+};
+
+} // namespace detail
+
+/**
+ * @brief Serializes TPM commands on a dedicated thread
+ *
+ * Destroy it before the executor it resumes coroutines on, and only once
+ * no coroutine is waiting on it.
+ */
+class AsyncTpm {
+public:
+    explicit AsyncTpm(Executor &executor) : executor_(executor), thread_([this] { run(); }) {}
+
+    AsyncTpm(const AsyncTpm &) = delete;
+    AsyncTpm &operator=(const AsyncTpm &) = delete;
+
+    ~AsyncTpm() {
+        queue_.stop();
+        thread_.join();
+    }
+
+    /**
+     * @brief Run command() on the TPM thread; awaiting yields its result
+     */
+    template <typename R, typename F>
+    detail::TpmAwaiter<R, F> submit(F command) {
+        return detail::TpmAwaiter<R, F>(*this, std::move(command));
+    }
+
+    auto quote(uint8_t pcr_mask) {
+        return submit<Result<Quote>>([pcr_mask]() -> Result<Quote> {
+            Quote quote;
+            quote.size = quote.data.size();
+            pqc_result_t rc = tpm2_quote(pcr_mask, quote.data.data(), &quote.size);
+            if (rc != PQC_SUCCESS) {
+                return Error(rc);
+            }
+            return quote;
+        });
+    }
+
+    auto read_pcr(uint8_t pcr_index) {
+        return submit<Result<PcrValue>>([pcr_index]() -> Result<PcrValue> {
+            PcrValue value;
+            pqc_result_t rc = tpm2_read_pcr(pcr_index, value.data());
+            if (rc != PQC_SUCCESS) {
+                return Error(rc);
+            }
+            return value;
+        });
+    }
+
+    /**
+     * @brief Fill buffer from the TPM RNG; buffer must outlive the await
+     */
+    auto random(mutable_bytes buffer) {
+        return submit<Status>([buffer]() -> Status {
+            return tpm2_random(buffer.data(), buffer.size());
+        });
+    }
+
+private:
+    template <typename R, typename F>
+    friend class detail::TpmAwaiter;
+
+    void enqueue(detail::TpmJob *job) noexcept { queue_.push(job); }
+
+    void run() {
+        while (detail::WorkItem *item = queue_.pop()) {
+            detail::TpmJob *job = static_cast<detail::TpmJob *>(item);
+            job->run(job);
+            executor_.post(job);
+        }
+    }
+
+    Executor &executor_;
+    detail::WorkQueue queue_;
+    std::thread thread_;
+};
+
+template <typename R, typename F>
+void detail::TpmAwaiter<R, F>::await_suspend(std::coroutine_handle<> h) noexcept {
+    handle = h;
+    run = &TpmAwaiter::invoke;
+    tpm_.enqueue(this);
+}
+
+} // namespace pqc
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif /* PQC_ATTESTATION_HPP */
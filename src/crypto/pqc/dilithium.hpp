@@ -0,0 +1,110 @@
+/**
+ * @file dilithium.hpp
+ * @brief C++ interface to Dilithium-5 (see dilithium.h)
+ *
+ * A verifier that checks many signatures against the same key should
+ * expand it once and keep the ExpandedPublicKey; see
+ * dilithium_expand_public_key().
+ */
+
+#ifndef PQC_DILITHIUM_HPP
+#define PQC_DILITHIUM_HPP
+
+#include "../dilithium.h"
+#include "memory.hpp"
+
+namespace pqc {
+namespace dilithium {
+
+static_assert(sizeof(dilithium_public_key_t) == DILITHIUM_PUBLICKEYBYTES, "packed public key");
+
+class PublicKey final : public SecureObject<PublicKey, dilithium_public_key_t> {};
+class ExpandedPublicKey final
+    : public SecureObject<ExpandedPublicKey, dilithium_expanded_public_key_t> {};
+
+/** In-memory layout of dilithium_secret_key_t, not the packed encoding */
+class SecretKey final : public SecureObject<SecretKey, dilithium_secret_key_t> {};
+
+class Signature final : public SecureBytes<Signature> {};
+
+static_assert(!std::is_copy_constructible<SecretKey>::value, "keys are move-only");
+static_assert(!std::is_copy_constructible<ExpandedPublicKey>::value, "keys are move-only");
+
+struct KeyPair {
+    PublicKey public_key;
+    SecretKey secret_key;
+};
+
+/**
+ * @brief Generate a keypair
+ * @param[in] mr Resource for both keys
+ */
+inline Result<KeyPair> generate(std::pmr::memory_resource *mr = secure_resource()) noexcept {
+    Result<PublicKey> pk = PublicKey::allocate(mr);
+    Result<SecretKey> sk = SecretKey::allocate(mr);
+    if (!pk || !sk) {
+        return Error(PQC_ERROR_INSUFFICIENT_MEMORY);
+    }
+    Status status = dilithium_keypair(pk->get(), sk->get());
+    if (!status) {
+        return status.error();
+    }
+    return KeyPair{std::move(*pk), std::move(*sk)};
+}
+
+/**
+ * @brief Expand a public key for repeated verification
+ * @param[in] mr Resource for the expanded key (about 64 KB)
+ */
+inline Result<ExpandedPublicKey> expand(const PublicKey &pk,
+                                        std::pmr::memory_resource *mr = secure_resource()) noexcept {
+    Result<ExpandedPublicKey> epk = ExpandedPublicKey::allocate(mr);
+    if (!epk) {
+        return epk;
+    }
+    Status status = dilithium_expand_public_key(epk->get(), pk.get());
+    if (!status) {
+        return status.error();
+    }
+    return epk;
+}
+
+/**
+ * @brief Sign a message
+ * @param[in] mr Resource for the signature
+ */
+inline Result<Signature> sign(const SecretKey &sk, bytes_view message,
+                              std::pmr::memory_resource *mr = secure_resource()) noexcept {
+    Result<Signature> sig = Signature::allocate(DILITHIUM_SIGNATUREBYTES, mr);
+    if (!sig) {
+        return sig;
+    }
+    size_t siglen = 0;
+    Status status = dilithium_sign(sig->data(), &siglen, detail::nonnull_data(message),
+                                   message.size(), sk.get());
+    if (!status) {
+        return status.error();
+    }
+    sig->truncate(siglen);
+    return sig;
+}
+
+inline Status verify(const PublicKey &pk, bytes_view message, bytes_view signature) noexcept {
+    return dilithium_verify(signature.data(), signature.size(), detail::nonnull_data(message),
+                            message.size(), pk.get());
+}
+
+inline Status verify(const ExpandedPublicKey &epk, bytes_view message,
+                     bytes_view signature) noexcept {
+    return dilithium_verify_expanded(signature.data(), signature.size(),
+                                     detail::nonnull_data(message), message.size(), epk.get());
+}
+
+inline Status validate(const PublicKey &pk) noexcept {
+    return dilithium_validate_public_key(pk.get());
+}
+
+} // namespace dilithium
+} // namespace pqc
+
+#endif /* PQC_DILITHIUM_HPP */
@@ -0,0 +1,83 @@
+/**
+ * @file falcon.hpp
+ * @brief C++ interface to Falcon-512/1024 (see falcon.h)
+ *
+ * Keys are byte strings; their length selects the parameter set.
+ */
+
+#ifndef PQC_FALCON_HPP
+#define PQC_FALCON_HPP
+
+#include "../falcon.h"
+#include "memory.hpp"
+
+namespace pqc {
+namespace falcon {
+
+class PublicKey final : public SecureBytes<PublicKey> {};
+class SecretKey final : public SecureBytes<SecretKey> {};
+class Signature final : public SecureBytes<Signature> {};
+
+static_assert(!std::is_copy_constructible<SecretKey>::value, "keys are move-only");
+
+struct KeyPair {
+    PublicKey public_key;
+    SecretKey secret_key;
+};
+
+/**
+ * @brief Generate a keypair
+ * @param[in] algorithm PQC_ALG_FALCON_512 or PQC_ALG_FALCON_1024
+ * @param[in] mr Resource for both keys
+ */
+inline Result<KeyPair> generate(pqc_algorithm_t algorithm = PQC_ALG_FALCON_1024,
+                                std::pmr::memory_resource *mr = secure_resource()) noexcept {
+    if (algorithm != PQC_ALG_FALCON_512 && algorithm != PQC_ALG_FALCON_1024) {
+        return Error(PQC_ERROR_ALGORITHM_NOT_SUPPORTED);
+    }
+    bool l1 = algorithm == PQC_ALG_FALCON_512;
+    Result<PublicKey> pk = PublicKey::allocate(
+        l1 ? FALCON_512_PUBLICKEYBYTES : FALCON_1024_PUBLICKEYBYTES, mr);
+    Result<SecretKey> sk = SecretKey::allocate(
+        l1 ? FALCON_512_SECRETKEYBYTES : FALCON_1024_SECRETKEYBYTES, mr);
+    if (!pk || !sk) {
+        return Error(PQC_ERROR_INSUFFICIENT_MEMORY);
+    }
+    Status status = falcon_keypair(algorithm, pk->data(), sk->data());
+    if (!status) {
+        return status.error();
+    }
+    return KeyPair{std::move(*pk), std::move(*sk)};
+}
+
+/**
+ * @brief Sign a message
+ * @param[in] mr Resource for the signature
+ */
+inline Result<Signature> sign(const SecretKey &sk, bytes_view message,
+                              std::pmr::memory_resource *mr = secure_resource()) noexcept {
+    size_t max = sk.size() == FALCON_512_SECRETKEYBYTES ? FALCON_512_SIGNATUREBYTES
+                                                        : FALCON_1024_SIGNATUREBYTES;
+    Result<Signature> sig = Signature::allocate(max, mr);
+    if (!sig) {
+        return sig;
+    }
+    size_t siglen = 0;
+    Status status = falcon_sign(sig->data(), &siglen, detail::nonnull_data(message),
+                                message.size(), sk.data(), sk.size());
+    if (!status) {
+        return status.error();
+    }
+    sig->truncate(siglen);
+    return sig;
+}
+
+inline Status verify(const PublicKey &pk, bytes_view message, bytes_view signature) noexcept {
+    return falcon_verify(signature.data(), signature.size(), detail::nonnull_data(message),
+                         message.size(), pk.data(), pk.size());
+}
+
+} // namespace falcon
+} // namespace pqc
+
+#endif /* PQC_FALCON_HPP */
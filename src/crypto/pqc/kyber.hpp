@@ -0,0 +1,95 @@
+/**
+ * @file kyber.hpp
+ * @brief C++ interface to Kyber-1024 (see kyber.h)
+ */
+
+#ifndef PQC_KYBER_HPP
+#define PQC_KYBER_HPP
+
+#include "../kyber.h"
+#include "memory.hpp"
+
+namespace pqc {
+namespace kyber {
+
+static_assert(sizeof(kyber_public_key_t) == KYBER_PUBLICKEYBYTES, "packed public key");
+static_assert(sizeof(kyber_secret_key_t) == KYBER_SECRETKEYBYTES, "packed secret key");
+static_assert(sizeof(kyber_ciphertext_t) == KYBER_CIPHERTEXTBYTES, "packed ciphertext");
+
+class PublicKey final : public SecureObject<PublicKey, kyber_public_key_t> {};
+class SecretKey final : public SecureObject<SecretKey, kyber_secret_key_t> {};
+class Ciphertext final : public SecureObject<Ciphertext, kyber_ciphertext_t> {};
+using SharedSecret = SecretBlock<KYBER_SSBYTES>;
+
+static_assert(!std::is_copy_constructible<SecretKey>::value, "keys are move-only");
+static_assert(std::is_nothrow_move_constructible<SecretKey>::value, "keys move without throwing");
+
+struct KeyPair {
+    PublicKey public_key;
+    SecretKey secret_key;
+};
+
+struct Encapsulation {
+    Ciphertext ciphertext;
+    SharedSecret shared_secret;
+};
+
+/**
+ * @brief Generate a keypair
+ * @param[in] mr Resource for both keys
+ */
+inline Result<KeyPair> generate(std::pmr::memory_resource *mr = secure_resource()) noexcept {
+    Result<PublicKey> pk = PublicKey::allocate(mr);
+    Result<SecretKey> sk = SecretKey::allocate(mr);
+    if (!pk || !sk) {
+        return Error(PQC_ERROR_INSUFFICIENT_MEMORY);
+    }
+    Status status = kyber_keypair(pk->get(), sk->get());
+    if (!status) {
+        return status.error();
+    }
+    return KeyPair{std::move(*pk), std::move(*sk)};
+}
+
+/**
+ * @brief Encapsulate a fresh shared secret to pk
+ * @param[in] mr Resource for the ciphertext
+ */
+inline Result<Encapsulation> encapsulate(const PublicKey &pk,
+                                         std::pmr::memory_resource *mr = secure_resource()) noexcept {
+    Result<Ciphertext> ct = Ciphertext::allocate(mr);
+    if (!ct) {
+        return ct.error();
+    }
+    Encapsulation out{std::move(*ct), SharedSecret()};
+    Status status = kyber_encapsulate(out.ciphertext.get(), out.shared_secret.data(), pk.get());
+    if (!status) {
+        return status.error();
+    }
+    return out;
+}
+
+/**
+ * @brief Recover the shared secret from a ciphertext
+ */
+inline Result<SharedSecret> decapsulate(const SecretKey &sk, const Ciphertext &ct) noexcept {
+    SharedSecret ss;
+    Status status = kyber_decapsulate(ss.data(), ct.get(), sk.get());
+    if (!status) {
+        return status.error();
+    }
+    return ss;
+}
+
+inline Status validate(const PublicKey &pk) noexcept {
+    return kyber_validate_public_key(pk.get());
+}
+
+inline Status validate(const Ciphertext &ct) noexcept {
+    return kyber_validate_ciphertext(ct.get());
+}
+
+} // namespace kyber
+} // namespace pqc
+
+#endif /* PQC_KYBER_HPP */
@@ -0,0 +1,360 @@
+/**
+ * @file memory.hpp
+ * @brief Move-only, zeroizing owners for key material in the C++ layer
+ *
+ * Every key, ciphertext and signature type in the C++ layer is one of two
+ * owners defined here: SecureObject wraps one of the fixed-size C structs
+ * (kyber_secret_key_t and friends), SecureBytes a byte string whose length
+ * selects the parameter set (Falcon, SPHINCS+). Both allocate from a
+ * std::pmr::memory_resource, so a request can place its keys in a
+ * monotonic arena, wipe their contents on destruction whatever the
+ * resource, and cannot be copied; clone() makes the one deliberate copy.
+ *
+ * The default resource is secure_resource(), backed by
+ * secure_aligned_malloc() so allocations show up in secure_memory_stats().
+ */
+
+#ifndef PQC_MEMORY_HPP
+#define PQC_MEMORY_HPP
+
+#include "../secure_memory.h"
+#include "result.hpp"
+#include "span.hpp"
+#include <cstring>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+namespace pqc {
+
+// ============================================================================
+// Memory Resources
+// ============================================================================
+
+/**
+ * @brief memory_resource over secure_aligned_malloc()/secure_aligned_free()
+ */
+class SecureResource final : public std::pmr::memory_resource {
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        void *ptr = secure_aligned_malloc(bytes ? bytes : 1, alignment);
+        if (!ptr) {
+#if defined(__cpp_exceptions)
+            throw std::bad_alloc();
+#endif
+        }
+        return ptr;
+    }
+
+    void do_deallocate(void *ptr, std::size_t bytes, std::size_t) override {
+        secure_aligned_free(ptr, bytes ? bytes : 1);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+inline std::pmr::memory_resource *secure_resource() noexcept {
+    static SecureResource resource;
+    return &resource;
+}
+
+namespace detail {
+
+/**
+ * @brief Allocate without letting std::bad_alloc escape
+ */
+inline void *allocate(std::pmr::memory_resource *mr, std::size_t bytes,
+                      std::size_t alignment) noexcept {
+#if defined(__cpp_exceptions)
+    try {
+        return mr->allocate(bytes, alignment);
+    } catch (const std::bad_alloc &) {
+        return nullptr;
+    }
+#else
+    return mr->allocate(bytes, alignment);
+#endif
+}
+
+} // namespace detail
+
+// ============================================================================
+// SecureObject
+// ============================================================================
+
+/**
+ * @brief Owner of one C struct, zero-initialized on allocation and wiped
+ *        on destruction
+ *
+ * @tparam Derived The key type (CRTP), so factories return the right type
+ * @tparam T Trivially copyable C struct
+ */
+template <typename Derived, typename T>
+class SecureObject {
+    static_assert(std::is_trivially_copyable<T>::value, "SecureObject wraps C structs");
+
+public:
+    using value_type = T;
+
+    /**
+     * @brief Allocate a zeroed object from mr
+     * @return The object, or PQC_ERROR_INSUFFICIENT_MEMORY
+     */
+    static Result<Derived> allocate(std::pmr::memory_resource *mr = secure_resource()) noexcept {
+        Derived object;
+        void *ptr = detail::allocate(mr, sizeof(T), alignof(T));
+        if (!ptr) {
+            return Error(PQC_ERROR_INSUFFICIENT_MEMORY);
+        }
+        std::memset(ptr, 0, sizeof(T));
+        object.ptr_ = static_cast<T *>(ptr);
+        object.mr_ = mr;
+        return object;
+    }
+
+    /**
+     * @brief Load an object from its byte representation
+     * @return The object, PQC_ERROR_INVALID_PARAMETER if bytes is not sizeof(T) long
+     */
+    static Result<Derived> from_bytes(bytes_view bytes,
+                                      std::pmr::memory_resource *mr = secure_resource()) noexcept {
+        if (bytes.size() != sizeof(T)) {
+            return Error(PQC_ERROR_INVALID_PARAMETER);
+        }
+        Result<Derived> object = allocate(mr);
+        if (object) {
+            std::memcpy(object->ptr_, bytes.data(), sizeof(T));
+        }
+        return object;
+    }
+
+    /**
+     * @brief Explicit copy
+     * @param[in] mr Resource for the copy, NULL for this object's resource
+     */
+    Result<Derived> clone(std::pmr::memory_resource *mr = nullptr) const noexcept {
+        if (!ptr_) {
+            return Error(PQC_ERROR_INVALID_PARAMETER);
+        }
+        return from_bytes(bytes(), mr ? mr : mr_);
+    }
+
+    SecureObject(const SecureObject &) = delete;
+    SecureObject &operator=(const SecureObject &) = delete;
+
+    SecureObject(SecureObject &&other) noexcept : ptr_(other.ptr_), mr_(other.mr_) {
+        other.ptr_ = nullptr;
+    }
+
+    SecureObject &operator=(SecureObject &&other) noexcept {
+        if (this != &other) {
+            reset();
+            ptr_ = other.ptr_;
+            mr_ = other.mr_;
+            other.ptr_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~SecureObject() { reset(); }
+
+    /**
+     * @brief Wipe and release the object; the owner becomes empty
+     */
+    void reset() noexcept {
+        if (ptr_) {
+            secure_memzero(ptr_, sizeof(T));
+            mr_->deallocate(ptr_, sizeof(T), alignof(T));
+            ptr_ = nullptr;
+        }
+    }
+
+    /** NULL when empty; C calls reject it with PQC_ERROR_INVALID_PARAMETER */
+    T *get() noexcept { return ptr_; }
+    const T *get() const noexcept { return ptr_; }
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    bytes_view bytes() const noexcept {
+        return bytes_view(reinterpret_cast<const uint8_t *>(ptr_), ptr_ ? sizeof(T) : 0);
+    }
+
+    std::pmr::memory_resource *resource() const noexcept { return mr_; }
+
+protected:
+    SecureObject() noexcept = default;
+
+private:
+    T *ptr_ = nullptr;
+    std::pmr::memory_resource *mr_ = nullptr;
+};
+
+// ============================================================================
+// SecureBytes
+// ============================================================================
+
+/**
+ * @brief Owner of a byte string, wiped on destruction
+ *
+ * Keeps the allocated capacity separately from the length so a signature
+ * buffer can be allocated at its maximum size and trimmed to the actual
+ * length without reallocating.
+ *
+ * @tparam Derived The key or signature type (CRTP)
+ */
+template <typename Derived>
+class SecureBytes {
+public:
+    /**
+     * @brief Allocate size zero bytes from mr
+     */
+    static Result<Derived> allocate(std::size_t size,
+                                    std::pmr::memory_resource *mr = secure_resource()) noexcept {
+        Derived object;
+        void *ptr = detail::allocate(mr, size ? size : 1, alignof(std::max_align_t));
+        if (!ptr) {
+            return Error(PQC_ERROR_INSUFFICIENT_MEMORY);
+        }
+        std::memset(ptr, 0, size);
+        object.data_ = static_cast<uint8_t *>(ptr);
+        object.size_ = size;
+        object.capacity_ = size;
+        object.mr_ = mr;
+        return object;
+    }
+
+    static Result<Derived> from_bytes(bytes_view bytes,
+                                      std::pmr::memory_resource *mr = secure_resource()) noexcept {
+        Result<Derived> object = allocate(bytes.size(), mr);
+        if (object && !bytes.empty()) {
+            std::memcpy(object->data_, bytes.data(), bytes.size());
+        }
+        return object;
+    }
+
+    Result<Derived> clone(std::pmr::memory_resource *mr = nullptr) const noexcept {
+        if (!data_) {
+            return Error(PQC_ERROR_INVALID_PARAMETER);
+        }
+        return from_bytes(bytes(), mr ? mr : mr_);
+    }
+
+    SecureBytes(const SecureBytes &) = delete;
+    SecureBytes &operator=(const SecureBytes &) = delete;
+
+    SecureBytes(SecureBytes &&other) noexcept
+        : data_(other.data_), size_(other.size_), capacity_(other.capacity_), mr_(other.mr_) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    SecureBytes &operator=(SecureBytes &&other) noexcept {
+        if (this != &other) {
+            reset();
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            mr_ = other.mr_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.capacity_ = 0;
+        }
+        return *this;
+    }
+
+    ~SecureBytes() { reset(); }
+
+    void reset() noexcept {
+        if (data_) {
+            secure_memzero(data_, capacity_);
+            mr_->deallocate(data_, capacity_ ? capacity_ : 1, alignof(std::max_align_t));
+            data_ = nullptr;
+            size_ = 0;
+            capacity_ = 0;
+        }
+    }
+
+    /**
+     * @brief Shorten to size bytes, wiping the tail; the capacity is kept
+     */
+    void truncate(std::size_t size) noexcept {
+        if (size < size_) {
+            secure_memzero(data_ + size, size_ - size);
+            size_ = size;
+        }
+    }
+
+    uint8_t *data() noexcept { return data_; }
+    const uint8_t *data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    explicit operator bool() const noexcept { return data_ != nullptr; }
+
+    bytes_view bytes() const noexcept { return bytes_view(data_, size_); }
+    operator bytes_view() const noexcept { return bytes(); }
+
+    std::pmr::memory_resource *resource() const noexcept { return mr_; }
+
+protected:
+    SecureBytes() noexcept = default;
+
+private:
+    uint8_t *data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+    std::pmr::memory_resource *mr_ = nullptr;
+};
+
+// ============================================================================
+// SecretBlock
+// ============================================================================
+
+/**
+ * @brief Small fixed-size secret held inline (shared secrets, seeds)
+ *
+ * Too small to be worth an allocation; moving copies the bytes and wipes
+ * the source.
+ */
+template <std::size_t N>
+class SecretBlock {
+public:
+    SecretBlock() noexcept { std::memset(bytes_, 0, N); }
+
+    SecretBlock(const SecretBlock &) = delete;
+    SecretBlock &operator=(const SecretBlock &) = delete;
+
+    SecretBlock(SecretBlock &&other) noexcept {
+        std::memcpy(bytes_, other.bytes_, N);
+        secure_memzero(other.bytes_, N);
+    }
+
+    SecretBlock &operator=(SecretBlock &&other) noexcept {
+        if (this != &other) {
+            std::memcpy(bytes_, other.bytes_, N);
+            secure_memzero(other.bytes_, N);
+        }
+        return *this;
+    }
+
+    ~SecretBlock() { secure_memzero(bytes_, N); }
+
+    uint8_t *data() noexcept { return bytes_; }
+    const uint8_t *data() const noexcept { return bytes_; }
+    static constexpr std::size_t size() noexcept { return N; }
+    bytes_view bytes() const noexcept { return bytes_view(bytes_, N); }
+
+    /** Constant-time comparison */
+    bool operator==(const SecretBlock &other) const noexcept {
+        return secure_memcmp(bytes_, other.bytes_, N) == 0;
+    }
+    bool operator!=(const SecretBlock &other) const noexcept { return !(*this == other); }
+
+private:
+    uint8_t bytes_[N];
+};
+
+} // namespace pqc
+
+#endif /* PQC_MEMORY_HPP */
@@ -0,0 +1,33 @@
+/**
+ * @file pqc.hpp
+ * @brief Header-only C++17 layer over the PQC C API
+ *
+ * Keys, ciphertexts and signatures are move-only owners that allocate
+ * from a std::pmr::memory_resource and wipe their memory on destruction
+ * (memory.hpp). Inputs are taken as pqc::span views, outputs returned as
+ * pqc::Result, so no key struct is ever copied by value and no error path
+ * throws. Link against the C library as usual. report.hpp builds and
+ * verifies attestation reports with the same allocation model.
+ *
+ * Under C++20 the coroutine API (async.hpp, attestation.hpp) is included
+ * as well.
+ */
+
+#ifndef PQC_PQC_HPP
+#define PQC_PQC_HPP
+
+#include "result.hpp"
+#include "span.hpp"
+#include "memory.hpp"
+#include "kyber.hpp"
+#include "dilithium.hpp"
+#include "falcon.hpp"
+#include "sphincs.hpp"
+#include "report.hpp"
+
+#if defined(__cpp_impl_coroutine) && __cplusplus >= 202002L
+#include "async.hpp"
+#include "attestation.hpp"
+#endif
+
+#endif /* PQC_PQC_HPP */
@@ -0,0 +1,357 @@
+/**
+ * @file report.hpp
+ * @brief Attestation report builder and verification (C++17)
+ *
+ * Everything here that allocates takes a std::pmr::memory_resource, so a
+ * verifier can give each request a monotonic buffer and release the
+ * report, its verdict and any batch results in one go:
+ *
+ *     std::array<std::byte, 16 * 1024> arena;
+ *     std::pmr::monotonic_buffer_resource mr(arena.data(), arena.size(),
+ *                                            std::pmr::null_memory_resource());
+ *     auto report = pqc::Report::from_bytes(wire, &mr);
+ *     auto verdict = report.and_then([&](pqc::Report &r) {
+ *         return pqc::verify(r, device_key, &mr);
+ *     });
+ *
+ * Verifying a report performs no global heap allocation: the C verifier
+ * works on the stack and the result lives in the resource passed in.
+ */
+
+#ifndef PQC_REPORT_HPP
+#define PQC_REPORT_HPP
+
+#include "../../attestation/attestation_engine.h"
+#include "../pqc_executor.h"
+#include "dilithium.hpp"
+#include <array>
+#include <cstring>
+#include <ctime>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace pqc {
+
+/**
+ * @brief Attestation report owned in a memory resource
+ */
+class Report final : public SecureObject<Report, attestation_report_t> {};
+
+// ============================================================================
+// Verification Result
+// ============================================================================
+
+/**
+ * @brief Verdict on one report
+ *
+ * Allocator-aware, so a std::pmr container of results places the
+ * descriptions in its own resource.
+ */
+class VerificationResult {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    explicit VerificationResult(const allocator_type &alloc = {}) noexcept
+        : details_(), description_(alloc) {}
+
+    VerificationResult(const attestation_verification_result_t &details,
+                       const allocator_type &alloc = {})
+        : details_(details), description_(attestation_error_to_string(details.error_code), alloc) {}
+
+    VerificationResult(const VerificationResult &other, const allocator_type &alloc)
+        : details_(other.details_), description_(other.description_, alloc) {}
+
+    VerificationResult(VerificationResult &&other, const allocator_type &alloc)
+        : details_(other.details_), description_(std::move(other.description_), alloc) {}
+
+    VerificationResult(VerificationResult &&) noexcept = default;
+    VerificationResult &operator=(VerificationResult &&) = default;
+    VerificationResult(const VerificationResult &) = default;
+    VerificationResult &operator=(const VerificationResult &) = default;
+
+    bool is_valid() const noexcept { return details_.is_valid; }
+    attestation_error_t error_code() const noexcept { return details_.error_code; }
+    trust_level_t trust_level() const noexcept { return details_.trust_level; }
+
+    /** As filled in by attestation_verify_report() */
+    const attestation_verification_result_t &details() const noexcept { return details_; }
+
+    /** attestation_error_to_string() of the error code */
+    const std::pmr::string &description() const noexcept { return description_; }
+
+    allocator_type get_allocator() const noexcept { return description_.get_allocator(); }
+
+private:
+    attestation_verification_result_t details_;
+    std::pmr::string description_;
+};
+
+static_assert(std::is_nothrow_move_constructible<VerificationResult>::value,
+              "VerificationResult is stored in Result<T>");
+
+// ============================================================================
+// Verification
+// ============================================================================
+
+/**
+ * @brief Verify a report against a device key
+ *
+ * @param[in] mr Resource for the result's description
+ * @return The verdict, which may say the report is invalid, or the error
+ *         attestation_verify_report() returned
+ */
+namespace detail {
+
+inline Result<VerificationResult> make_result(const attestation_verification_result_t &details,
+                                              std::pmr::memory_resource *mr) noexcept {
+#if defined(__cpp_exceptions)
+    try {
+        return VerificationResult(details, VerificationResult::allocator_type(mr));
+    } catch (const std::bad_alloc &) {
+        return Error(PQC_ERROR_INSUFFICIENT_MEMORY);
+    }
+#else
+    return VerificationResult(details, VerificationResult::allocator_type(mr));
+#endif
+}
+
+} // namespace detail
+
+inline Result<VerificationResult> verify(const attestation_report_t &report,
+                                         const dilithium::PublicKey &public_key,
+                                         std::pmr::memory_resource *mr =
+                                             std::pmr::get_default_resource()) noexcept {
+    attestation_verification_result_t details;
+    Status status = attestation_verify_report(&report, public_key.get(), &details);
+    if (!status) {
+        return status.error();
+    }
+    return detail::make_result(details, mr);
+}
+
+inline Result<VerificationResult> verify(const Report &report,
+                                         const dilithium::PublicKey &public_key,
+                                         std::pmr::memory_resource *mr =
+                                             std::pmr::get_default_resource()) noexcept {
+    if (!report) {
+        return Error(PQC_ERROR_INVALID_PARAMETER);
+    }
+    return verify(*report.get(), public_key, mr);
+}
+
+/**
+ * @brief One entry of a verification batch
+ *
+ * An entry with a null pointer yields PQC_ERROR_INVALID_PARAMETER.
+ */
+struct VerifyRequest {
+    const attestation_report_t *report;
+    const dilithium::PublicKey *public_key;
+};
+
+using BatchResults = std::pmr::vector<Result<VerificationResult>>;
+
+namespace detail {
+
+/**
+ * @brief Outcome of one batch entry, before its result is built
+ */
+struct BatchVerdict {
+    pqc_result_t status;
+    attestation_verification_result_t details;
+};
+
+struct BatchVerifyJob {
+    const VerifyRequest *requests;
+    BatchVerdict *verdicts;
+};
+
+inline void verify_batch_range(void *ctx, std::size_t begin, std::size_t end) {
+    const BatchVerifyJob *job = static_cast<const BatchVerifyJob *>(ctx);
+    for (std::size_t i = begin; i < end; i++) {
+        const VerifyRequest &request = job->requests[i];
+        BatchVerdict &verdict = job->verdicts[i];
+        if (!request.report || !request.public_key) {
+            verdict.status = PQC_ERROR_INVALID_PARAMETER;
+        } else {
+            verdict.status = attestation_verify_report(request.report, request.public_key->get(),
+                                                       &verdict.details);
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Verify a batch of reports
+ *
+ * The signatures are checked in parallel as bulk work on executor (the
+ * process-wide pool by default, none to verify on the calling thread),
+ * which the calling thread joins. The results are then built on the
+ * calling thread, so mr need not be thread-safe: the result vector, every
+ * description in it and the scratch space all come from mr.
+ *
+ * @return One result per request, in request order; empty if the vector
+ *         or the scratch space could not be allocated
+ */
+inline BatchResults verify_batch(span<const VerifyRequest> requests,
+                                 std::pmr::memory_resource *mr =
+                                     std::pmr::get_default_resource(),
+                                 pqc_executor_t *executor = pqc_executor_shared()) noexcept {
+    BatchResults results{BatchResults::allocator_type(mr)};
+    if (requests.empty()) {
+        return results;
+    }
+#if defined(__cpp_exceptions)
+    try {
+        results.reserve(requests.size());
+    } catch (const std::bad_alloc &) {
+        return results;
+    }
+#else
+    results.reserve(requests.size());
+#endif
+    const std::size_t scratch = requests.size() * sizeof(detail::BatchVerdict);
+    auto *verdicts = static_cast<detail::BatchVerdict *>(
+        detail::allocate(mr, scratch, alignof(detail::BatchVerdict)));
+    if (!verdicts) {
+        return results;
+    }
+
+    detail::BatchVerifyJob job{requests.data(), verdicts};
+    pqc_executor_parallel_for(executor, requests.size(), 0, detail::verify_batch_range, &job,
+                              PQC_TASK_PRIORITY_BULK);
+    for (std::size_t i = 0; i < requests.size(); i++) {
+        if (verdicts[i].status != PQC_SUCCESS) {
+            results.emplace_back(Error(verdicts[i].status));
+        } else {
+            results.emplace_back(detail::make_result(verdicts[i].details, mr));
+        }
+    }
+    mr->deallocate(verdicts, scratch, alignof(detail::BatchVerdict));
+    return results;
+}
+
+// ============================================================================
+// Report Builder
+// ============================================================================
+
+/**
+ * @brief Assembles and signs reports outside the global attestation context
+ *
+ * For gateways and test fixtures that report on behalf of a device whose
+ * state is not this process's attestation engine. The measurement list
+ * lives in the builder's allocator; the signed report in the resource
+ * passed to build(). A builder can be reused, e.g. to re-sign with a
+ * fresh timestamp.
+ */
+class ReportBuilder {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<platform_measurement_t>;
+
+    explicit ReportBuilder(const allocator_type &alloc = {}) noexcept : measurements_(alloc) {}
+
+    ReportBuilder(const ReportBuilder &other, const allocator_type &alloc)
+        : device_id_(other.device_id_), timestamp_(other.timestamp_),
+          pcr_values_(other.pcr_values_), measurements_(other.measurements_, alloc) {}
+
+    ReportBuilder(ReportBuilder &&other, const allocator_type &alloc)
+        : device_id_(other.device_id_), timestamp_(other.timestamp_),
+          pcr_values_(other.pcr_values_), measurements_(std::move(other.measurements_), alloc) {}
+
+    ReportBuilder(ReportBuilder &&) noexcept = default;
+    ReportBuilder &operator=(ReportBuilder &&) = default;
+
+    /**
+     * @brief Device identifier, zero-padded to DEVICE_ID_LENGTH bytes
+     */
+    Status set_device_id(bytes_view device_id) noexcept {
+        if (device_id.size() > DEVICE_ID_LENGTH) {
+            return PQC_ERROR_INVALID_PARAMETER;
+        }
+        device_id_.fill(0);
+        if (!device_id.empty()) {
+            std::memcpy(device_id_.data(), device_id.data(), device_id.size());
+        }
+        return PQC_SUCCESS;
+    }
+
+    /**
+     * @brief Report timestamp; 0 (the default) stamps the time of build()
+     */
+    void set_timestamp(uint64_t timestamp) noexcept { timestamp_ = timestamp; }
+
+    Status set_pcr(uint8_t index, bytes_view value) noexcept {
+        if (index >= MAX_PCR_REGISTERS || value.size() != 32) {
+            return PQC_ERROR_INVALID_PARAMETER;
+        }
+        std::memcpy(pcr_values_[index].data(), value.data(), 32);
+        return PQC_SUCCESS;
+    }
+
+    /**
+     * @return PQC_ERROR_INVALID_PARAMETER once MAX_MEASUREMENTS_PER_REPORT
+     *         measurements have been added
+     */
+    Status add_measurement(const platform_measurement_t &measurement) noexcept {
+        if (measurements_.size() >= MAX_MEASUREMENTS_PER_REPORT) {
+            return PQC_ERROR_INVALID_PARAMETER;
+        }
+#if defined(__cpp_exceptions)
+        try {
+            measurements_.push_back(measurement);
+        } catch (const std::bad_alloc &) {
+            return PQC_ERROR_INSUFFICIENT_MEMORY;
+        }
+#else
+        measurements_.push_back(measurement);
+#endif
+        return PQC_SUCCESS;
+    }
+
+    void clear_measurements() noexcept { measurements_.clear(); }
+    std::size_t measurement_count() const noexcept { return measurements_.size(); }
+
+    /**
+     * @brief Assemble and sign a report
+     * @param[in] mr Resource for the report
+     */
+    Result<Report> build(const dilithium::SecretKey &secret_key,
+                         std::pmr::memory_resource *mr = std::pmr::get_default_resource()) const
+        noexcept {
+        Result<Report> report = Report::allocate(mr);
+        if (!report) {
+            return report;
+        }
+        attestation_report_t *r = report->get();
+        std::memcpy(r->device_id, device_id_.data(), sizeof(r->device_id));
+        r->timestamp = timestamp_ ? timestamp_ : static_cast<uint64_t>(std::time(nullptr));
+        r->report_version = ATTESTATION_REPORT_VERSION;
+        r->measurement_count = static_cast<uint32_t>(measurements_.size());
+        for (std::size_t i = 0; i < MAX_PCR_REGISTERS; i++) {
+            std::memcpy(r->pcr_values[i], pcr_values_[i].data(), 32);
+        }
+        if (!measurements_.empty()) {
+            std::memcpy(r->measurements, measurements_.data(),
+                        measurements_.size() * sizeof(platform_measurement_t));
+        }
+        Status status = attestation_sign_report(r, secret_key.get());
+        if (!status) {
+            return status.error();
+        }
+        return report;
+    }
+
+    allocator_type get_allocator() const noexcept { return measurements_.get_allocator(); }
+
+private:
+    std::array<uint8_t, DEVICE_ID_LENGTH> device_id_{};
+    uint64_t timestamp_ = 0;
+    std::array<std::array<uint8_t, 32>, MAX_PCR_REGISTERS> pcr_values_{};
+    std::pmr::vector<platform_measurement_t> measurements_;
+};
+
+} // namespace pqc
+
+#endif /* PQC_REPORT_HPP */
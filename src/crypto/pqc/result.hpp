@@ -0,0 +1,234 @@
+/**
+ * @file result.hpp
+ * @brief Typed results over pqc_result_t for the C++ layer
+ *
+ * Result<T> holds either a value or a pqc_result_t error code, in the
+ * spirit of std::expected. Status is Result<void> and converts implicitly
+ * from pqc_result_t, so a C call can be returned as-is. Nothing here
+ * throws except value() on an error result, and only when exceptions are
+ * enabled; with -fno-exceptions it aborts instead.
+ */
+
+#ifndef PQC_RESULT_HPP
+#define PQC_RESULT_HPP
+
+#include "../pqc_common.h"
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace pqc {
+
+// ============================================================================
+// Error Codes
+// ============================================================================
+
+/**
+ * @brief std::error_category for pqc_result_t
+ */
+class ErrorCategory final : public std::error_category {
+public:
+    const char *name() const noexcept override { return "pqc"; }
+
+    std::string message(int code) const override {
+        return pqc_result_to_string(static_cast<pqc_result_t>(code));
+    }
+};
+
+inline const std::error_category &error_category() noexcept {
+    static const ErrorCategory category;
+    return category;
+}
+
+/**
+ * @brief Failed operation; never holds PQC_SUCCESS
+ */
+class Error {
+public:
+    explicit constexpr Error(pqc_result_t code) noexcept
+        : code_(code == PQC_SUCCESS ? PQC_ERROR_INTERNAL : code) {}
+
+    constexpr pqc_result_t code() const noexcept { return code_; }
+    const char *message() const noexcept { return pqc_result_to_string(code_); }
+
+    std::error_code error_code() const noexcept {
+        return std::error_code(static_cast<int>(code_), error_category());
+    }
+
+private:
+    pqc_result_t code_;
+};
+
+#if defined(__cpp_exceptions)
+/**
+ * @brief Thrown by Result::value() on an error result
+ */
+class Exception : public std::system_error {
+public:
+    explicit Exception(Error error) : std::system_error(error.error_code()), error_(error) {}
+    pqc_result_t code_value() const noexcept { return error_.code(); }
+
+private:
+    Error error_;
+};
+#endif
+
+namespace detail {
+
+[[noreturn]] inline void throw_error(Error error) {
+#if defined(__cpp_exceptions)
+    throw Exception(error);
+#else
+    (void)error;
+    std::abort();
+#endif
+}
+
+} // namespace detail
+
+// ============================================================================
+// Result<T>
+// ============================================================================
+
+template <typename T>
+class [[nodiscard]] Result {
+    static_assert(!std::is_reference<T>::value, "Result<T&> is not supported");
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+                  "Result<T> requires a nothrow move constructor");
+
+public:
+    using value_type = T;
+
+    Result(T &&value) noexcept : code_(PQC_SUCCESS) { new (&value_) T(std::move(value)); }
+    Result(Error error) noexcept : code_(error.code()) {}
+
+    Result(Result &&other) noexcept : code_(other.code_) {
+        if (code_ == PQC_SUCCESS) {
+            new (&value_) T(std::move(other.value_));
+        }
+    }
+
+    Result &operator=(Result &&other) noexcept {
+        if (this != &other) {
+            destroy();
+            code_ = other.code_;
+            if (code_ == PQC_SUCCESS) {
+                new (&value_) T(std::move(other.value_));
+            }
+        }
+        return *this;
+    }
+
+    Result(const Result &) = delete;
+    Result &operator=(const Result &) = delete;
+
+    ~Result() { destroy(); }
+
+    bool has_value() const noexcept { return code_ == PQC_SUCCESS; }
+    explicit operator bool() const noexcept { return has_value(); }
+
+    /** PQC_SUCCESS or the error code */
+    pqc_result_t code() const noexcept { return code_; }
+    Error error() const noexcept { return Error(code_); }
+
+    T &value() & {
+        if (!has_value()) detail::throw_error(error());
+        return value_;
+    }
+    const T &value() const & {
+        if (!has_value()) detail::throw_error(error());
+        return value_;
+    }
+    T &&value() && {
+        if (!has_value()) detail::throw_error(error());
+        return std::move(value_);
+    }
+
+    // Unchecked access
+    T &operator*() & noexcept { return value_; }
+    const T &operator*() const & noexcept { return value_; }
+    T &&operator*() && noexcept { return std::move(value_); }
+    T *operator->() noexcept { return &value_; }
+    const T *operator->() const noexcept { return &value_; }
+
+    /**
+     * @brief Chain an operation returning Result<U> or Status
+     */
+    template <typename F>
+    auto and_then(F &&f) & -> decltype(f(std::declval<T &>())) {
+        if (!has_value()) return error();
+        return f(value_);
+    }
+    template <typename F>
+    auto and_then(F &&f) && -> decltype(f(std::declval<T &&>())) {
+        if (!has_value()) return error();
+        return f(std::move(value_));
+    }
+
+    /**
+     * @brief Transform the value, propagating the error
+     */
+    template <typename F>
+    auto map(F &&f) & -> Result<decltype(f(std::declval<T &>()))> {
+        if (!has_value()) return error();
+        return f(value_);
+    }
+    template <typename F>
+    auto map(F &&f) && -> Result<decltype(f(std::declval<T &&>()))> {
+        if (!has_value()) return error();
+        return f(std::move(value_));
+    }
+
+private:
+    void destroy() noexcept {
+        if (code_ == PQC_SUCCESS) {
+            value_.~T();
+        }
+    }
+
+    pqc_result_t code_;
+    union {
+        T value_;
+    };
+};
+
+// ============================================================================
+// Status
+// ============================================================================
+
+template <>
+class [[nodiscard]] Result<void> {
+public:
+    using value_type = void;
+
+    constexpr Result() noexcept : code_(PQC_SUCCESS) {}
+    constexpr Result(pqc_result_t code) noexcept : code_(code) {}
+    constexpr Result(Error error) noexcept : code_(error.code()) {}
+
+    constexpr bool has_value() const noexcept { return code_ == PQC_SUCCESS; }
+    constexpr explicit operator bool() const noexcept { return has_value(); }
+    constexpr pqc_result_t code() const noexcept { return code_; }
+    Error error() const noexcept { return Error(code_); }
+
+    void value() const {
+        if (!has_value()) detail::throw_error(error());
+    }
+
+    template <typename F>
+    auto and_then(F &&f) const -> decltype(f()) {
+        if (!has_value()) return error();
+        return f();
+    }
+
+private:
+    pqc_result_t code_;
+};
+
+using Status = Result<void>;
+
+} // namespace pqc
+
+#endif /* PQC_RESULT_HPP */
@@ -0,0 +1,124 @@
+/**
+ * @file span.hpp
+ * @brief Non-owning views for the C++ layer
+ *
+ * pqc::span is std::span when the standard library has it (C++20) and a
+ * minimal dynamic-extent stand-in under C++17, so call sites are the same
+ * in both modes.
+ */
+
+#ifndef PQC_SPAN_HPP
+#define PQC_SPAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#if __cplusplus >= 202002L && defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#endif
+#endif
+
+namespace pqc {
+
+#if defined(__cpp_lib_span)
+
+template <typename T>
+using span = std::span<T>;
+
+#else
+
+/**
+ * @brief Dynamic-extent subset of std::span
+ */
+template <typename T>
+class span {
+    template <typename C>
+    using container_element_t =
+        std::remove_pointer_t<decltype(std::declval<C &>().data())>;
+
+    template <typename C>
+    using enable_if_container_t = std::enable_if_t<
+        !std::is_same<std::decay_t<C>, span>::value &&
+        std::is_convertible<container_element_t<C> (*)[], T (*)[]>::value &&
+        std::is_convertible<decltype(std::declval<C &>().size()), std::size_t>::value>;
+
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using pointer = T *;
+    using reference = T &;
+    using iterator = T *;
+
+    constexpr span() noexcept = default;
+    constexpr span(T *data, size_type size) noexcept : data_(data), size_(size) {}
+
+    template <std::size_t N>
+    constexpr span(T (&array)[N]) noexcept : data_(array), size_(N) {}
+
+    template <typename C, typename = enable_if_container_t<C>>
+    constexpr span(C &container) noexcept(noexcept(container.data()))
+        : data_(container.data()), size_(container.size()) {}
+
+    template <typename C, typename = enable_if_container_t<const C>>
+    constexpr span(const C &container) noexcept(noexcept(container.data()))
+        : data_(container.data()), size_(container.size()) {}
+
+    template <typename U, typename = std::enable_if_t<
+                              std::is_convertible<U (*)[], T (*)[]>::value>>
+    constexpr span(const span<U> &other) noexcept : data_(other.data()), size_(other.size()) {}
+
+    constexpr pointer data() const noexcept { return data_; }
+    constexpr size_type size() const noexcept { return size_; }
+    constexpr size_type size_bytes() const noexcept { return size_ * sizeof(T); }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr iterator begin() const noexcept { return data_; }
+    constexpr iterator end() const noexcept { return data_ + size_; }
+    constexpr reference operator[](size_type i) const noexcept { return data_[i]; }
+
+    constexpr span first(size_type n) const noexcept { return span(data_, n); }
+    constexpr span last(size_type n) const noexcept { return span(data_ + size_ - n, n); }
+    constexpr span subspan(size_type offset) const noexcept {
+        return span(data_ + offset, size_ - offset);
+    }
+    constexpr span subspan(size_type offset, size_type count) const noexcept {
+        return span(data_ + offset, count);
+    }
+
+private:
+    pointer data_ = nullptr;
+    size_type size_ = 0;
+};
+
+#endif
+
+using bytes_view = span<const uint8_t>;     /**< Read-only byte range */
+using mutable_bytes = span<uint8_t>;        /**< Writable byte range */
+
+/**
+ * @brief View a string's characters as bytes
+ */
+inline bytes_view as_bytes(std::string_view text) noexcept {
+    return bytes_view(reinterpret_cast<const uint8_t *>(text.data()), text.size());
+}
+
+namespace detail {
+
+/**
+ * @brief Data pointer that is never NULL, for C calls that reject NULL
+ *        even when the length is zero
+ */
+inline const uint8_t *nonnull_data(bytes_view bytes) noexcept {
+    static const uint8_t empty = 0;
+    return bytes.data() ? bytes.data() : &empty;
+}
+
+} // namespace detail
+
+} // namespace pqc
+
+#endif /* PQC_SPAN_HPP */
@@ -0,0 +1,84 @@
+/**
+ * @file sphincs.hpp
+ * @brief C++ interface to SPHINCS+-SHA256-128f/256f (see sphincs.h)
+ *
+ * Keys are byte strings; their length selects the parameter set.
+ */
+
+#ifndef PQC_SPHINCS_HPP
+#define PQC_SPHINCS_HPP
+
+#include "../sphincs.h"
+#include "memory.hpp"
+
+namespace pqc {
+namespace sphincs {
+
+class PublicKey final : public SecureBytes<PublicKey> {};
+class SecretKey final : public SecureBytes<SecretKey> {};
+class Signature final : public SecureBytes<Signature> {};
+
+static_assert(!std::is_copy_constructible<SecretKey>::value, "keys are move-only");
+
+struct KeyPair {
+    PublicKey public_key;
+    SecretKey secret_key;
+};
+
+/**
+ * @brief Generate a keypair
+ * @param[in] algorithm PQC_ALG_SPHINCS_SHA256_128F or PQC_ALG_SPHINCS_SHA256_256F
+ * @param[in] mr Resource for both keys
+ */
+inline Result<KeyPair> generate(pqc_algorithm_t algorithm = PQC_ALG_SPHINCS_SHA256_128F,
+                                std::pmr::memory_resource *mr = secure_resource()) noexcept {
+    if (algorithm != PQC_ALG_SPHINCS_SHA256_128F && algorithm != PQC_ALG_SPHINCS_SHA256_256F) {
+        return Error(PQC_ERROR_ALGORITHM_NOT_SUPPORTED);
+    }
+    bool l1 = algorithm == PQC_ALG_SPHINCS_SHA256_128F;
+    Result<PublicKey> pk = PublicKey::allocate(
+        l1 ? SPHINCS_SHA256_128F_PUBLICKEYBYTES : SPHINCS_SHA256_256F_PUBLICKEYBYTES, mr);
+    Result<SecretKey> sk = SecretKey::allocate(
+        l1 ? SPHINCS_SHA256_128F_SECRETKEYBYTES : SPHINCS_SHA256_256F_SECRETKEYBYTES, mr);
+    if (!pk || !sk) {
+        return Error(PQC_ERROR_INSUFFICIENT_MEMORY);
+    }
+    Status status = sphincs_keypair(algorithm, pk->data(), sk->data());
+    if (!status) {
+        return status.error();
+    }
+    return KeyPair{std::move(*pk), std::move(*sk)};
+}
+
+/**
+ * @brief Sign a message
+ * @param[in] mr Resource for the signature (17 KB for 128f, 49 KB for 256f)
+ */
+inline Result<Signature> sign(const SecretKey &sk, bytes_view message,
+                              std::pmr::memory_resource *mr = secure_resource()) noexcept {
+    size_t max = sk.size() == SPHINCS_SHA256_128F_SECRETKEYBYTES
+                     ? SPHINCS_SHA256_128F_SIGNATUREBYTES
+                     : SPHINCS_SHA256_256F_SIGNATUREBYTES;
+    Result<Signature> sig = Signature::allocate(max, mr);
+    if (!sig) {
+        return sig;
+    }
+    size_t siglen = 0;
+    Status status = sphincs_sign(sig->data(), &siglen, detail::nonnull_data(message),
+                                 message.size(), sk.data(), sk.size());
+    if (!status) {
+        return status.error();
+    }
+    sig->truncate(siglen);
+    return sig;
+}
+
+inline Status verify(const PublicKey &pk, bytes_view message, bytes_view signature) noexcept {
+    return sphincs_verify(signature.data(), signature.size(), detail::nonnull_data(message),
+                          message.size(), pk.data(), pk.size());
+}
+
+} // namespace sphincs
+} // namespace pqc
+
+#endif /* PQC_SPHINCS_HPP */
@@ -0,0 +1,110 @@
+/**
+ * @file pqc_bytes.c
+ * @brief Bytes-touched accounting for public API calls
+ */
+
+#include "pqc_bytes.h"
+
+/**
+ * @brief Per-thread scope table and open-scope stack
+ */
+typedef struct {
+    pqc_bytes_scope_t scopes[PQC_BYTES_MAX_SCOPES];
+    size_t scope_count;
+    int open[PQC_BYTES_MAX_DEPTH];      /**< Scope indices, innermost last */
+    int depth;                          /**< Open scopes, may exceed PQC_BYTES_MAX_DEPTH */
+} bytes_thread_state_t;
+
+static _Thread_local bytes_thread_state_t t_bytes;
+
+static const char *const kind_names[PQC_BYTES_KIND_COUNT] = {
+    "copied", "zeroed", "hashed", "allocated"
+};
+
+static int find_scope(const char *name) {
+    for (size_t i = 0; i < t_bytes.scope_count; i++) {
+        if (t_bytes.scopes[i].name == name || strcmp(t_bytes.scopes[i].name, name) == 0) {
+            return (int)i;
+        }
+    }
+    if (t_bytes.scope_count == PQC_BYTES_MAX_SCOPES) {
+        return -1;
+    }
+    t_bytes.scopes[t_bytes.scope_count].name = name;
+    return (int)t_bytes.scope_count++;
+}
+
+bool pqc_bytes_enabled(void) {
+#ifdef PQC_ENABLE_BYTE_ACCOUNTING
+    return true;
+#else
+    return false;
+#endif
+}
+
+int pqc_bytes_scope_begin(const char *name) {
+    int token = t_bytes.depth++;
+    if (!name || token >= PQC_BYTES_MAX_DEPTH) {
+        return token;
+    }
+
+    int index = find_scope(name);
+    t_bytes.open[token] = index;
+    if (index >= 0) {
+        t_bytes.scopes[index].calls++;
+    }
+    return token;
+}
+
+void pqc_bytes_scope_end(int *token) {
+    if (token && *token >= 0 && *token < t_bytes.depth) {
+        t_bytes.depth = *token;
+    }
+}
+
+void pqc_bytes_count(pqc_bytes_kind_t kind, size_t bytes) {
+    if ((unsigned)kind >= PQC_BYTES_KIND_COUNT) {
+        return;
+    }
+
+    int depth = t_bytes.depth < PQC_BYTES_MAX_DEPTH ? t_bytes.depth : PQC_BYTES_MAX_DEPTH;
+    for (int d = 0; d < depth; d++) {
+        int index = t_bytes.open[d];
+        if (index < 0) {
+            continue;
+        }
+
+        // A scope that is open more than once (recursion) is counted once
+        bool seen = false;
+        for (int e = 0; e < d && !seen; e++) {
+            seen = t_bytes.open[e] == index;
+        }
+        if (!seen) {
+            t_bytes.scopes[index].bytes[kind] += bytes;
+        }
+    }
+}
+
+size_t pqc_bytes_get_scopes(pqc_bytes_scope_t *scopes, size_t max_scopes) {
+    if (!scopes) {
+        return 0;
+    }
+    size_t n = t_bytes.scope_count < max_scopes ? t_bytes.scope_count : max_scopes;
+    memcpy(scopes, t_bytes.scopes, n * sizeof(pqc_bytes_scope_t));
+    return n;
+}
+
+void pqc_bytes_reset(void) {
+    // Scopes stay registered so names remain valid for open callers
+    for (size_t i = 0; i < t_bytes.scope_count; i++) {
+        t_bytes.scopes[i].calls = 0;
+        memset(t_bytes.scopes[i].bytes, 0, sizeof(t_bytes.scopes[i].bytes));
+    }
+}
+
+const char* pqc_bytes_kind_name(pqc_bytes_kind_t kind) {
+    if ((unsigned)kind >= PQC_BYTES_KIND_COUNT) {
+        return "unknown";
+    }
+    return kind_names[kind];
+}
@@ -0,0 +1,135 @@
+/**
+ * @file pqc_bytes.h
+ * @brief Bytes-touched accounting for public API calls
+ *
+ * Debug instrumentation that counts the bytes copied, zeroed, hashed and
+ * allocated while a public API call runs, so copy elimination work can be
+ * aimed at the largest contributors. Each instrumented entry point opens a
+ * named scope; every count is added to all scopes open on the calling
+ * thread, so an outer call (attestation_verify_report) includes the bytes
+ * of the inner calls it makes (dilithium_verify).
+ *
+ * The hooks are only compiled in with PQC_ENABLE_BYTE_ACCOUNTING, which
+ * requires GCC or Clang for the scope cleanup attribute. Without it
+ * PQC_MEMCPY/PQC_MEMSET are plain memcpy/memset.
+ */
+
+#ifndef PQC_BYTES_H
+#define PQC_BYTES_H
+
+#include "pqc_common.h"
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Constants and Types
+// ============================================================================
+
+#define PQC_BYTES_MAX_SCOPES    32      /**< Distinct scope names per thread */
+#define PQC_BYTES_MAX_DEPTH     8       /**< Nested open scopes per thread */
+
+/**
+ * @brief Kinds of memory traffic counted
+ */
+typedef enum {
+    PQC_BYTES_COPIED = 0,               /**< memcpy and secure_memcpy */
+    PQC_BYTES_ZEROED = 1,               /**< memset and secure_memzero */
+    PQC_BYTES_HASHED = 2,               /**< SHA-3/SHAKE input */
+    PQC_BYTES_ALLOCATED = 3,            /**< secure_malloc/secure_aligned_malloc */
+    PQC_BYTES_KIND_COUNT = 4
+} pqc_bytes_kind_t;
+
+/**
+ * @brief Totals for one scope (API entry point)
+ */
+typedef struct {
+    const char *name;                   /**< Scope name, e.g. "attestation_generate_report" */
+    uint64_t calls;                     /**< Times the scope was entered */
+    uint64_t bytes[PQC_BYTES_KIND_COUNT]; /**< Totals indexed by pqc_bytes_kind_t */
+} pqc_bytes_scope_t;
+
+// ============================================================================
+// Hooks
+// ============================================================================
+
+#ifdef PQC_ENABLE_BYTE_ACCOUNTING
+#define PQC_BYTES_SCOPE(name) \
+    __attribute__((cleanup(pqc_bytes_scope_end))) int pqc_bytes_scope_ = pqc_bytes_scope_begin(name)
+#define PQC_BYTES_COUNT(kind, n)    pqc_bytes_count(kind, (size_t)(n))
+#else
+#define PQC_BYTES_SCOPE(name)       ((void)0)
+#define PQC_BYTES_COUNT(kind, n)    ((void)0)
+#endif
+
+/* n is evaluated twice; pass sizes without side effects */
+#define PQC_MEMCPY(dst, src, n) \
+    (PQC_BYTES_COUNT(PQC_BYTES_COPIED, n), memcpy(dst, src, n))
+#define PQC_MEMSET(dst, value, n) \
+    (PQC_BYTES_COUNT(PQC_BYTES_ZEROED, n), memset(dst, value, n))
+
+// ============================================================================
+// Accounting
+// ============================================================================
+
+/**
+ * @brief Whether the library was built with PQC_ENABLE_BYTE_ACCOUNTING
+ *
+ * @return true if API calls report their byte counts
+ */
+bool pqc_bytes_enabled(void);
+
+/**
+ * @brief Open a scope on the calling thread
+ *
+ * @param[in] name Scope name (string literal; compared by pointer first)
+ * @return Token for pqc_bytes_scope_end()
+ */
+int pqc_bytes_scope_begin(const char *name);
+
+/**
+ * @brief Close the scope opened with the given token
+ *
+ * Scopes left open by an inner call are closed as well.
+ *
+ * @param[in] token Value returned by pqc_bytes_scope_begin()
+ */
+void pqc_bytes_scope_end(int *token);
+
+/**
+ * @brief Add bytes to every scope open on the calling thread
+ *
+ * @param[in] kind Kind of traffic
+ * @param[in] bytes Byte count
+ */
+void pqc_bytes_count(pqc_bytes_kind_t kind, size_t bytes);
+
+/**
+ * @brief Copy the calling thread's scope totals
+ *
+ * @param[out] scopes Output array
+ * @param[in] max_scopes Capacity of scopes
+ * @return Number of scopes written
+ */
+size_t pqc_bytes_get_scopes(pqc_bytes_scope_t *scopes, size_t max_scopes);
+
+/**
+ * @brief Clear the calling thread's scope totals
+ */
+void pqc_bytes_reset(void);
+
+/**
+ * @brief Kind name for reports (e.g. "zeroed")
+ *
+ * @param[in] kind Kind identifier
+ * @return Kind name
+ */
+const char* pqc_bytes_kind_name(pqc_bytes_kind_t kind);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PQC_BYTES_H */
@@ -5,6 +5,9 @@
 
 #include "pqc_common.h"
 #include "secure_memory.h"
+#include "pqc_perf.h"
+#include "pqc_executor.h"
+#include "sha2.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -51,6 +54,62 @@ static const pqc_algorithm_info_t algorithm_info[] = {
         .shared_secret_bytes = 0,
         .constant_time = true,
         .side_channel_resistant = true
+    },
+    {
+        .algorithm = PQC_ALG_FALCON_512,
+        .category = PQC_CATEGORY_SIGNATURE,
+        .security_level = PQC_SECURITY_LEVEL_1,
+        .name = "Falcon-512",
+        .description = "NIST Level 1 compact lattice signature scheme",
+        .public_key_bytes = 897,
+        .secret_key_bytes = 1281,
+        .signature_bytes = 666,
+        .ciphertext_bytes = 0,
+        .shared_secret_bytes = 0,
+        .constant_time = true,
+        .side_channel_resistant = false
+    },
+    {
+        .algorithm = PQC_ALG_FALCON_1024,
+        .category = PQC_CATEGORY_SIGNATURE,
+        .security_level = PQC_SECURITY_LEVEL_5,
+        .name = "Falcon-1024",
+        .description = "NIST Level 5 compact lattice signature scheme",
+        .public_key_bytes = 1793,
+        .secret_key_bytes = 2305,
+        .signature_bytes = 1280,
+        .ciphertext_bytes = 0,
+        .shared_secret_bytes = 0,
+        .constant_time = true,
+        .side_channel_resistant = false
+    },
+    {
+        .algorithm = PQC_ALG_SPHINCS_SHA256_128F,
+        .category = PQC_CATEGORY_SIGNATURE,
+        .security_level = PQC_SECURITY_LEVEL_1,
+        .name = "SPHINCS+-SHA256-128f",
+        .description = "NIST Level 1 stateless hash-based signature scheme",
+        .public_key_bytes = 32,
+        .secret_key_bytes = 64,
+        .signature_bytes = 17088,
+        .ciphertext_bytes = 0,
+        .shared_secret_bytes = 0,
+        .constant_time = true,
+        .side_channel_resistant = false
+    },
+    {
+        .algorithm = PQC_ALG_SPHINCS_SHA256_256F,
+        .category = PQC_CATEGORY_SIGNATURE,
+        .security_level = PQC_SECURITY_LEVEL_5,
+        .name = "SPHINCS+-SHA256-256f",
+        .description = "NIST Level 5 stateless hash-based signature scheme",
+        .public_key_bytes = 64,
+        .secret_key_bytes = 128,
+        .signature_bytes = 49856,
+        .ciphertext_bytes = 0,
+        .shared_secret_bytes = 0,
+        .constant_time = true,
+        .side_channel_resistant = false
     }
 };
 
@@ -116,6 +175,7 @@ pqc_result_t pqc_init(const pqc_config_t *config) {
 }
 
 void pqc_cleanup(void) {
+    pqc_executor_shutdown_shared();
     secure_memory_cleanup();
     memset(&g_pqc_config, 0, sizeof(g_pqc_config));
     memset(&g_perf_stats, 0, sizeof(g_perf_stats));
@@ -127,11 +187,13 @@ pqc_result_t pqc_get_performance_stats(pqc_performance_stats_t *stats) {
     }
     
     *stats = g_perf_stats;
+    pqc_perf_get_phase_counters(stats->phase_counters);
     return PQC_SUCCESS;
 }
 
 void pqc_reset_performance_stats(void) {
     memset(&g_perf_stats, 0, sizeof(g_perf_stats));
+    pqc_perf_reset_phase_counters();
 }
 
 // Simplified random bytes implementation for Generation 1
@@ -161,70 +223,6 @@ pqc_result_t pqc_randombytes(uint8_t *buffer, size_t length) {
     return PQC_SUCCESS;
 }
 
-// Placeholder hash implementations for Generation 1
-pqc_result_t shake128(uint8_t *output, size_t outlen, const uint8_t *input, size_t inlen) {
-    // Simplified implementation - replace with proper SHAKE in Generation 2
-    if (!output || !input) {
-        return PQC_ERROR_INVALID_PARAMETER;
-    }
-    
-    // Simple hash expansion for now
-    for (size_t i = 0; i < outlen; i++) {
-        output[i] = input[i % inlen] ^ (uint8_t)(i & 0xFF);
-    }
-    
-    return PQC_SUCCESS;
-}
-
-pqc_result_t shake256(uint8_t *output, size_t outlen, 
-                     const uint8_t *input, size_t inlen,
-                     const uint8_t *custom, size_t customlen) {
-    // Simplified implementation
-    if (!output || !input) {
-        return PQC_ERROR_INVALID_PARAMETER;
-    }
-    
-    for (size_t i = 0; i < outlen; i++) {
-        uint8_t val = input[i % inlen] ^ (uint8_t)(i & 0xFF);
-        if (custom && customlen > 0) {
-            val ^= custom[i % customlen];
-        }
-        output[i] = val;
-    }
-    
-    return PQC_SUCCESS;
-}
-
-pqc_result_t sha3_256(uint8_t hash[32], const uint8_t *input, size_t inlen) {
-    // Simplified implementation
-    if (!hash || !input) {
-        return PQC_ERROR_INVALID_PARAMETER;
-    }
-    
-    // Simple hash for Generation 1
-    memset(hash, 0, 32);
-    for (size_t i = 0; i < inlen; i++) {
-        hash[i % 32] ^= input[i];
-    }
-    
-    return PQC_SUCCESS;
-}
-
-pqc_result_t sha3_512(uint8_t hash[64], const uint8_t *input, size_t inlen) {
-    // Simplified implementation
-    if (!hash || !input) {
-        return PQC_ERROR_INVALID_PARAMETER;
-    }
-    
-    // Simple hash for Generation 1
-    memset(hash, 0, 64);
-    for (size_t i = 0; i < inlen; i++) {
-        hash[i % 64] ^= input[i];
-    }
-    
-    return PQC_SUCCESS;
-}
-
 const char* pqc_get_version(void) {
     return "1.0.0-generation1";
 }
@@ -240,8 +238,8 @@ pqc_result_t pqc_get_platform_capabilities(pqc_platform_capabilities_t *caps) {
     
     // Basic capabilities for Generation 1
     caps->has_aes_ni = false;
-    caps->has_sha_extensions = false;
-    caps->has_avx2 = false;
+    caps->has_sha_extensions = sha2_cpu_has_shani();
+    caps->has_avx2 = sha2_cpu_has_avx2();
     caps->has_hardware_rng = false;
     caps->has_constant_time_mul = true;
     caps->has_secure_memory = true;
@@ -113,6 +113,45 @@ typedef struct {
     void *hardware_context;             /**< Hardware-specific context */
 } pqc_config_t;
 
+/**
+ * @brief Hardware performance counters (see pqc_perf.h)
+ */
+typedef enum {
+    PQC_PERF_COUNTER_CYCLES = 0,        /**< Core cycles */
+    PQC_PERF_COUNTER_INSTRUCTIONS = 1,  /**< Retired instructions */
+    PQC_PERF_COUNTER_L1D_MISSES = 2,    /**< L1 data cache read misses */
+    PQC_PERF_COUNTER_LLC_MISSES = 3,    /**< Last-level cache read misses */
+    PQC_PERF_COUNTER_BRANCH_MISSES = 4, /**< Mispredicted branches */
+    PQC_PERF_COUNTER_DTLB_MISSES = 5,   /**< Data TLB read misses */
+    PQC_PERF_COUNTER_COUNT = 6
+} pqc_perf_counter_t;
+
+/**
+ * @brief Instrumented phases of the PQC primitives
+ *
+ * The first three cover whole operations; the others are nested inside
+ * them, so their counts are not additive with the operation totals.
+ */
+typedef enum {
+    PQC_PERF_PHASE_KEYGEN = 0,          /**< Key generation */
+    PQC_PERF_PHASE_SIGN_ENCAPS = 1,     /**< Signing / encapsulation */
+    PQC_PERF_PHASE_VERIFY_DECAPS = 2,   /**< Verification / decapsulation */
+    PQC_PERF_PHASE_EXPAND_MATRIX = 3,   /**< Public matrix expansion from seed */
+    PQC_PERF_PHASE_HASH = 4,            /**< Key and message hashing */
+    PQC_PERF_PHASE_POLY_ARITH = 5,      /**< NTT and pointwise multiplication */
+    PQC_PERF_PHASE_REJECTION_LOOP = 6,  /**< Signing rejection-sampling loop */
+    PQC_PERF_PHASE_COUNT = 7
+} pqc_perf_phase_t;
+
+/**
+ * @brief Accumulated hardware counter values for one phase
+ */
+typedef struct {
+    uint64_t values[PQC_PERF_COUNTER_COUNT]; /**< Totals, indexed by pqc_perf_counter_t */
+    uint64_t samples;                   /**< Number of completed phase instances */
+    uint32_t valid_mask;                /**< Bit n set if counter n was available */
+} pqc_perf_counters_t;
+
 /**
  * @brief Performance statistics
  */
@@ -123,6 +162,7 @@ typedef struct {
     uint32_t stack_usage_bytes;         /**< Maximum stack usage in bytes */
     uint32_t heap_usage_bytes;          /**< Heap memory usage in bytes */
     uint32_t operations_count;          /**< Number of operations performed */
+    pqc_perf_counters_t phase_counters[PQC_PERF_PHASE_COUNT]; /**< Hardware counters of the calling thread */
 } pqc_performance_stats_t;
 
 // ============================================================================
@@ -170,6 +210,10 @@ void pqc_cleanup(void);
 /**
  * @brief Get current performance statistics
  * 
+ * phase_counters are per thread and only populated when the library is
+ * built with PQC_ENABLE_PERF_COUNTERS and the calling thread opened its
+ * counters with pqc_perf_thread_open().
+ * 
  * @param[out] stats Performance statistics structure
  * @return PQC_SUCCESS on success, error code on failure
  */
@@ -0,0 +1,730 @@
+/**
+ * @file pqc_executor.c
+ * @brief Work-stealing executor shared by the batch APIs
+ */
+
+#define _GNU_SOURCE
+
+#include "pqc_executor.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#define EXECUTOR_CACHE_LINE     64
+#define EXECUTOR_SPIN_ROUNDS    16      /**< Empty scans before a worker parks */
+#define EXECUTOR_CHUNKS_PER_WORKER 4    /**< Default parallel_for split, for balance */
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+/**
+ * @brief Chase-Lev deque of fixed capacity
+ *
+ * The owning worker pushes and pops at bottom; thieves take from top.
+ * Only the last task is contended, and then a CAS on top decides.
+ */
+typedef struct {
+    _Alignas(EXECUTOR_CACHE_LINE) _Atomic int64_t top;
+    _Alignas(EXECUTOR_CACHE_LINE) _Atomic int64_t bottom;
+    _Atomic(pqc_task_t *) *slots;
+    int64_t mask;
+} executor_deque_t;
+
+/**
+ * @brief FIFO for tasks submitted from outside the pool
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    pqc_task_t *head;
+    pqc_task_t *tail;
+    _Atomic size_t count;               /**< Lets workers skip the lock when empty */
+    _Atomic uint64_t total;
+} executor_inject_t;
+
+typedef struct {
+    executor_deque_t deques[PQC_TASK_PRIORITY_COUNT];
+    struct pqc_executor *executor;
+    pthread_t thread;
+    unsigned index;
+    uint64_t rng;                       /**< Victim selection */
+
+    // Written only by the worker itself
+    _Alignas(EXECUTOR_CACHE_LINE) _Atomic uint64_t executed[PQC_TASK_PRIORITY_COUNT];
+    _Atomic uint64_t local;
+    _Atomic uint64_t steals;
+    _Atomic uint64_t steal_attempts;
+    _Atomic uint64_t parks;
+    _Atomic uint64_t idle_ns;
+} executor_worker_t;
+
+struct pqc_executor {
+    executor_worker_t *workers;
+    unsigned nworkers;
+    unsigned running;                   /**< Worker threads started */
+    executor_inject_t inject[PQC_TASK_PRIORITY_COUNT];
+
+    _Alignas(EXECUTOR_CACHE_LINE) _Atomic size_t latency_pending;  /**< Queued, not yet taken */
+    _Alignas(EXECUTOR_CACHE_LINE) _Atomic unsigned idle;           /**< Workers parked or parking */
+    pthread_mutex_t park_lock;
+    pthread_cond_t park_cond;
+    uint64_t epoch;                     /**< Bumped by every wakeup, under park_lock */
+    _Atomic unsigned submitting;        /**< Submitters still inside pqc_executor_submit() */
+    _Atomic bool stopping;
+};
+
+/**
+ * @brief State of one pqc_executor_parallel_for() call
+ *
+ * Reference counted: helpers that only get to run after the caller has
+ * returned still find it alive, see no chunks left and let go.
+ */
+typedef struct parallel_job parallel_job_t;
+
+typedef struct {
+    pqc_task_t task;
+    parallel_job_t *job;
+} parallel_helper_t;
+
+struct parallel_job {
+    pqc_parallel_fn body;
+    void *ctx;
+    size_t count;
+    size_t grain;
+    size_t chunks;
+    _Atomic size_t next;                /**< Next chunk to hand out */
+    _Atomic size_t done;                /**< Chunks finished */
+    _Atomic unsigned refs;
+    pthread_mutex_t lock;
+    pthread_cond_t finished;
+    parallel_helper_t helpers[];
+};
+
+static _Thread_local executor_worker_t *t_worker;
+
+static pthread_mutex_t g_shared_lock = PTHREAD_MUTEX_INITIALIZER;
+static _Atomic(pqc_executor_t *) g_shared_executor;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Add to a counter only its owner writes; readers may race benignly
+ */
+static void counter_add(_Atomic uint64_t *counter, uint64_t n) {
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + n,
+                          memory_order_relaxed);
+}
+
+static uint64_t xorshift64(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief CPUs allowed by the cgroup CPU quota, 0 if unlimited or unknown
+ */
+static double cgroup_cpu_limit(void) {
+    char quota[32];
+    unsigned long long period;
+    FILE *f = fopen("/sys/fs/cgroup/cpu.max", "r");
+    if (f) {
+        int n = fscanf(f, "%31s %llu", quota, &period);
+        fclose(f);
+        if (n != 2 || strcmp(quota, "max") == 0 || period == 0) {
+            return 0.0;
+        }
+        return strtod(quota, NULL) / (double)period;
+    }
+
+    long long quota_us = -1;
+    f = fopen("/sys/fs/cgroup/cpu/cpu.cfs_quota_us", "r");
+    if (f) {
+        if (fscanf(f, "%lld", &quota_us) != 1) {
+            quota_us = -1;
+        }
+        fclose(f);
+    }
+    f = fopen("/sys/fs/cgroup/cpu/cpu.cfs_period_us", "r");
+    if (!f) {
+        return 0.0;
+    }
+    int n = fscanf(f, "%llu", &period);
+    fclose(f);
+    if (n != 1 || quota_us <= 0 || period == 0) {
+        return 0.0;
+    }
+    return (double)quota_us / (double)period;
+}
+
+unsigned pqc_executor_default_workers(void) {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned cpus = online > 0 ? (unsigned)online : 1;
+
+#ifdef CPU_COUNT
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        unsigned allowed = (unsigned)CPU_COUNT(&set);
+        if (allowed > 0 && allowed < cpus) {
+            cpus = allowed;
+        }
+    }
+#endif
+
+    double limit = cgroup_cpu_limit();
+    if (limit > 0.0) {
+        unsigned quota = (unsigned)limit;
+        if ((double)quota < limit) {
+            quota++;
+        }
+        if (quota < cpus) {
+            cpus = quota;
+        }
+    }
+
+    if (cpus < 1) {
+        cpus = 1;
+    }
+    return cpus < PQC_EXECUTOR_MAX_WORKERS ? cpus : PQC_EXECUTOR_MAX_WORKERS;
+}
+
+// ============================================================================
+// Deques
+// ============================================================================
+
+static int deque_init(executor_deque_t *d, size_t capacity) {
+    d->slots = calloc(capacity, sizeof(*d->slots));
+    if (!d->slots) {
+        return -1;
+    }
+    atomic_init(&d->top, 0);
+    atomic_init(&d->bottom, 0);
+    d->mask = (int64_t)capacity - 1;
+    return 0;
+}
+
+/**
+ * @brief Push at bottom (owner only)
+ * @return false if the deque is full
+ */
+static bool deque_push(executor_deque_t *d, pqc_task_t *task) {
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    if (b - t > d->mask) {
+        return false;
+    }
+    atomic_store_explicit(&d->slots[b & d->mask], task, memory_order_relaxed);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Pop at bottom (owner only), newest first
+ */
+static pqc_task_t *deque_pop(executor_deque_t *d) {
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_relaxed);
+    if (t > b) {
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return NULL;
+    }
+    pqc_task_t *task = atomic_load_explicit(&d->slots[b & d->mask], memory_order_relaxed);
+    if (t == b) {
+        // Last task: race the thieves for it
+        if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1, memory_order_seq_cst,
+                                                     memory_order_relaxed)) {
+            task = NULL;
+        }
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+/**
+ * @brief Take the oldest task (any thread)
+ * @return The task, or NULL if the deque was empty or another thief won
+ */
+static pqc_task_t *deque_steal(executor_deque_t *d) {
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+    if (t >= b) {
+        return NULL;
+    }
+    pqc_task_t *task = atomic_load_explicit(&d->slots[t & d->mask], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1, memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        return NULL;
+    }
+    return task;
+}
+
+static bool deque_empty(executor_deque_t *d) {
+    return atomic_load_explicit(&d->top, memory_order_acquire) >=
+           atomic_load_explicit(&d->bottom, memory_order_acquire);
+}
+
+// ============================================================================
+// Injection Queues
+// ============================================================================
+
+static void inject_push(executor_inject_t *q, pqc_task_t *task) {
+    task->next = NULL;
+    pthread_mutex_lock(&q->lock);
+    if (q->tail) {
+        q->tail->next = task;
+    } else {
+        q->head = task;
+    }
+    q->tail = task;
+    atomic_fetch_add_explicit(&q->count, 1, memory_order_release);
+    atomic_fetch_add_explicit(&q->total, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&q->lock);
+}
+
+static pqc_task_t *inject_pop(executor_inject_t *q) {
+    if (atomic_load_explicit(&q->count, memory_order_acquire) == 0) {
+        return NULL;
+    }
+    pthread_mutex_lock(&q->lock);
+    pqc_task_t *task = q->head;
+    if (task) {
+        q->head = task->next;
+        if (!q->head) {
+            q->tail = NULL;
+        }
+        atomic_fetch_sub_explicit(&q->count, 1, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&q->lock);
+    return task;
+}
+
+// ============================================================================
+// Workers
+// ============================================================================
+
+/**
+ * @brief Next task of one priority: own deque, then injected, then stolen
+ */
+static pqc_task_t *take_task(pqc_executor_t *ex, executor_worker_t *w, int prio) {
+    pqc_task_t *task = deque_pop(&w->deques[prio]);
+    if (task) {
+        return task;
+    }
+    task = inject_pop(&ex->inject[prio]);
+    if (task || ex->nworkers == 1) {
+        return task;
+    }
+
+    unsigned start = (unsigned)(xorshift64(&w->rng) % ex->nworkers);
+    for (unsigned i = 0; i < ex->nworkers; i++) {
+        executor_worker_t *victim = &ex->workers[(start + i) % ex->nworkers];
+        if (victim == w) {
+            continue;
+        }
+        counter_add(&w->steal_attempts, 1);
+        task = deque_steal(&victim->deques[prio]);
+        if (task) {
+            counter_add(&w->steals, 1);
+            return task;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Latency-critical work anywhere in the pool comes before bulk work
+ */
+static pqc_task_t *find_task(pqc_executor_t *ex, executor_worker_t *w, int *prio) {
+    if (atomic_load_explicit(&ex->latency_pending, memory_order_relaxed) > 0) {
+        pqc_task_t *task = take_task(ex, w, PQC_TASK_PRIORITY_LATENCY);
+        if (task) {
+            atomic_fetch_sub_explicit(&ex->latency_pending, 1, memory_order_relaxed);
+            *prio = PQC_TASK_PRIORITY_LATENCY;
+            return task;
+        }
+    }
+    *prio = PQC_TASK_PRIORITY_BULK;
+    return take_task(ex, w, PQC_TASK_PRIORITY_BULK);
+}
+
+static bool has_work(pqc_executor_t *ex) {
+    for (int p = 0; p < PQC_TASK_PRIORITY_COUNT; p++) {
+        if (atomic_load_explicit(&ex->inject[p].count, memory_order_acquire) > 0) {
+            return true;
+        }
+        for (unsigned i = 0; i < ex->nworkers; i++) {
+            if (!deque_empty(&ex->workers[i].deques[p])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Sleep until work is submitted or the executor stops
+ *
+ * The worker announces itself in idle and then looks once more, so a
+ * submitter either sees it idle and wakes it or published its task before
+ * the last look.
+ */
+static void worker_park(pqc_executor_t *ex, executor_worker_t *w) {
+    pthread_mutex_lock(&ex->park_lock);
+    uint64_t epoch = ex->epoch;
+    pthread_mutex_unlock(&ex->park_lock);
+
+    atomic_fetch_add(&ex->idle, 1);
+    atomic_thread_fence(memory_order_seq_cst);
+    if (has_work(ex) || atomic_load(&ex->stopping)) {
+        atomic_fetch_sub(&ex->idle, 1);
+        return;
+    }
+
+    uint64_t start = monotonic_ns();
+    pthread_mutex_lock(&ex->park_lock);
+    while (ex->epoch == epoch && !atomic_load(&ex->stopping)) {
+        pthread_cond_wait(&ex->park_cond, &ex->park_lock);
+    }
+    pthread_mutex_unlock(&ex->park_lock);
+    atomic_fetch_sub(&ex->idle, 1);
+    counter_add(&w->parks, 1);
+    counter_add(&w->idle_ns, monotonic_ns() - start);
+}
+
+static void* worker_main(void *arg) {
+    executor_worker_t *w = arg;
+    pqc_executor_t *ex = w->executor;
+    t_worker = w;
+
+    char name[16];
+    snprintf(name, sizeof(name), "pqc-exec-%u", w->index);
+    pthread_setname_np(pthread_self(), name);
+
+    unsigned empty = 0;
+    for (;;) {
+        int prio;
+        pqc_task_t *task = find_task(ex, w, &prio);
+        if (task) {
+            empty = 0;
+            task->run(task);
+            counter_add(&w->executed[prio], 1);
+            continue;
+        }
+        if (atomic_load(&ex->stopping) && !has_work(ex)) {
+            break;
+        }
+        if (++empty < EXECUTOR_SPIN_ROUNDS) {
+            sched_yield();
+            continue;
+        }
+        empty = 0;
+        worker_park(ex, w);
+    }
+
+    t_worker = NULL;
+    return NULL;
+}
+
+/**
+ * @brief Wake up to n parked workers after publishing work
+ */
+static void executor_wake(pqc_executor_t *ex, unsigned n) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&ex->idle, memory_order_relaxed) == 0) {
+        return;
+    }
+    pthread_mutex_lock(&ex->park_lock);
+    ex->epoch++;
+    if (n == 1) {
+        pthread_cond_signal(&ex->park_cond);
+    } else {
+        pthread_cond_broadcast(&ex->park_cond);
+    }
+    pthread_mutex_unlock(&ex->park_lock);
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+pqc_result_t pqc_executor_create(pqc_executor_t **executor, const pqc_executor_config_t *config) {
+    pqc_executor_config_t defaults = { 0 };
+    if (!config) {
+        config = &defaults;
+    }
+    if (!executor || config->workers > PQC_EXECUTOR_MAX_WORKERS ||
+        (config->deque_capacity & (config->deque_capacity - 1)) != 0) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    *executor = NULL;
+
+    pqc_executor_t *ex = calloc(1, sizeof(*ex));
+    if (!ex) {
+        return PQC_ERROR_INSUFFICIENT_MEMORY;
+    }
+    ex->nworkers = config->workers ? config->workers : pqc_executor_default_workers();
+    size_t capacity = config->deque_capacity >= 2 ? config->deque_capacity
+                                                  : PQC_EXECUTOR_DEFAULT_DEQUE;
+    for (int p = 0; p < PQC_TASK_PRIORITY_COUNT; p++) {
+        pthread_mutex_init(&ex->inject[p].lock, NULL);
+        atomic_init(&ex->inject[p].count, 0);
+        atomic_init(&ex->inject[p].total, 0);
+    }
+    atomic_init(&ex->latency_pending, 0);
+    atomic_init(&ex->idle, 0);
+    atomic_init(&ex->stopping, false);
+    pthread_mutex_init(&ex->park_lock, NULL);
+    pthread_cond_init(&ex->park_cond, NULL);
+
+    ex->workers = aligned_alloc(EXECUTOR_CACHE_LINE, sizeof(executor_worker_t) * ex->nworkers);
+    if (!ex->workers) {
+        pqc_executor_destroy(ex);
+        return PQC_ERROR_INSUFFICIENT_MEMORY;
+    }
+    memset(ex->workers, 0, sizeof(executor_worker_t) * ex->nworkers);
+    for (unsigned i = 0; i < ex->nworkers; i++) {
+        executor_worker_t *w = &ex->workers[i];
+        w->executor = ex;
+        w->index = i;
+        w->rng = 0x9E3779B97F4A7C15ULL * (i + 1);
+        for (int p = 0; p < PQC_TASK_PRIORITY_COUNT; p++) {
+            if (deque_init(&w->deques[p], capacity) != 0) {
+                pqc_executor_destroy(ex);
+                return PQC_ERROR_INSUFFICIENT_MEMORY;
+            }
+        }
+    }
+
+    for (unsigned i = 0; i < ex->nworkers; i++) {
+        if (pthread_create(&ex->workers[i].thread, NULL, worker_main, &ex->workers[i]) != 0) {
+            pqc_executor_destroy(ex);
+            return PQC_ERROR_INSUFFICIENT_MEMORY;
+        }
+        ex->running++;
+    }
+
+    *executor = ex;
+    return PQC_SUCCESS;
+}
+
+void pqc_executor_destroy(pqc_executor_t *executor) {
+    if (!executor) {
+        return;
+    }
+    pthread_mutex_lock(&executor->park_lock);
+    atomic_store(&executor->stopping, true);
+    pthread_cond_broadcast(&executor->park_cond);
+    pthread_mutex_unlock(&executor->park_lock);
+    for (unsigned i = 0; i < executor->running; i++) {
+        pthread_join(executor->workers[i].thread, NULL);
+    }
+    while (atomic_load_explicit(&executor->submitting, memory_order_acquire) != 0) {
+        sched_yield();
+    }
+
+    for (unsigned i = 0; executor->workers && i < executor->nworkers; i++) {
+        for (int p = 0; p < PQC_TASK_PRIORITY_COUNT; p++) {
+            free(executor->workers[i].deques[p].slots);
+        }
+    }
+    for (int p = 0; p < PQC_TASK_PRIORITY_COUNT; p++) {
+        pthread_mutex_destroy(&executor->inject[p].lock);
+    }
+    pthread_mutex_destroy(&executor->park_lock);
+    pthread_cond_destroy(&executor->park_cond);
+    free(executor->workers);
+    free(executor);
+}
+
+pqc_executor_t *pqc_executor_shared(void) {
+    pqc_executor_t *ex = atomic_load_explicit(&g_shared_executor, memory_order_acquire);
+    if (ex) {
+        return ex;
+    }
+    pthread_mutex_lock(&g_shared_lock);
+    ex = atomic_load_explicit(&g_shared_executor, memory_order_relaxed);
+    if (!ex && pqc_executor_create(&ex, NULL) == PQC_SUCCESS) {
+        atomic_store_explicit(&g_shared_executor, ex, memory_order_release);
+    }
+    pthread_mutex_unlock(&g_shared_lock);
+    return ex;
+}
+
+void pqc_executor_shutdown_shared(void) {
+    pthread_mutex_lock(&g_shared_lock);
+    pqc_executor_t *ex = atomic_exchange(&g_shared_executor, NULL);
+    pthread_mutex_unlock(&g_shared_lock);
+    pqc_executor_destroy(ex);
+}
+
+unsigned pqc_executor_size(const pqc_executor_t *executor) {
+    return executor ? executor->nworkers : 0;
+}
+
+// ============================================================================
+// Submission
+// ============================================================================
+
+void pqc_executor_submit(pqc_executor_t *executor, pqc_task_t *task,
+                         pqc_task_priority_t priority) {
+    if (!executor || !task || !task->run || (unsigned)priority >= PQC_TASK_PRIORITY_COUNT) {
+        return;
+    }
+    // The task may run, and its owner destroy the executor, before this
+    // returns; destroy waits for submitting to drop back to zero.
+    atomic_fetch_add(&executor->submitting, 1);
+    if (priority == PQC_TASK_PRIORITY_LATENCY) {
+        atomic_fetch_add(&executor->latency_pending, 1);
+    }
+
+    executor_worker_t *w = t_worker;
+    if (w && w->executor == executor && deque_push(&w->deques[priority], task)) {
+        counter_add(&w->local, 1);
+    } else {
+        inject_push(&executor->inject[priority], task);
+    }
+    executor_wake(executor, 1);
+    atomic_fetch_sub_explicit(&executor->submitting, 1, memory_order_release);
+}
+
+static void job_release(parallel_job_t *job) {
+    if (atomic_fetch_sub(&job->refs, 1) == 1) {
+        pthread_mutex_destroy(&job->lock);
+        pthread_cond_destroy(&job->finished);
+        free(job);
+    }
+}
+
+/**
+ * @brief Run chunks until none are left
+ */
+static void job_work(parallel_job_t *job) {
+    size_t finished = 0;
+    for (;;) {
+        size_t chunk = atomic_fetch_add_explicit(&job->next, 1, memory_order_relaxed);
+        if (chunk >= job->chunks) {
+            break;
+        }
+        size_t begin = chunk * job->grain;
+        size_t end = begin + job->grain < job->count ? begin + job->grain : job->count;
+        job->body(job->ctx, begin, end);
+        finished++;
+    }
+    if (finished > 0 &&
+        atomic_fetch_add_explicit(&job->done, finished, memory_order_acq_rel) + finished ==
+            job->chunks) {
+        pthread_mutex_lock(&job->lock);
+        pthread_cond_broadcast(&job->finished);
+        pthread_mutex_unlock(&job->lock);
+    }
+}
+
+static void job_helper_run(pqc_task_t *task) {
+    parallel_job_t *job = ((parallel_helper_t *)task)->job;
+    job_work(job);
+    job_release(job);
+}
+
+pqc_result_t pqc_executor_parallel_for(pqc_executor_t *executor, size_t count, size_t grain,
+                                       pqc_parallel_fn body, void *ctx,
+                                       pqc_task_priority_t priority) {
+    if (!body || (unsigned)priority >= PQC_TASK_PRIORITY_COUNT) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    if (count == 0) {
+        return PQC_SUCCESS;
+    }
+
+    unsigned workers = pqc_executor_size(executor);
+    if (grain == 0) {
+        size_t pieces = (size_t)(workers + 1) * EXECUTOR_CHUNKS_PER_WORKER;
+        grain = (count + pieces - 1) / pieces;
+    }
+    size_t chunks = (count + grain - 1) / grain;
+    size_t helpers = chunks - 1 < workers ? chunks - 1 : workers;
+
+    parallel_job_t *job = NULL;
+    if (helpers > 0) {
+        job = malloc(sizeof(*job) + helpers * sizeof(parallel_helper_t));
+    }
+    if (!job) {
+        // Nothing to share, or no memory to share it with
+        body(ctx, 0, count);
+        return PQC_SUCCESS;
+    }
+
+    job->body = body;
+    job->ctx = ctx;
+    job->count = count;
+    job->grain = grain;
+    job->chunks = chunks;
+    atomic_init(&job->next, 0);
+    atomic_init(&job->done, 0);
+    atomic_init(&job->refs, (unsigned)helpers + 1);
+    pthread_mutex_init(&job->lock, NULL);
+    pthread_cond_init(&job->finished, NULL);
+    for (size_t i = 0; i < helpers; i++) {
+        job->helpers[i].task.run = job_helper_run;
+        job->helpers[i].job = job;
+        pqc_executor_submit(executor, &job->helpers[i].task, priority);
+    }
+
+    job_work(job);
+
+    // Every chunk is finished or running on a thread that will finish it
+    pthread_mutex_lock(&job->lock);
+    while (atomic_load_explicit(&job->done, memory_order_acquire) < chunks) {
+        pthread_cond_wait(&job->finished, &job->lock);
+    }
+    pthread_mutex_unlock(&job->lock);
+    job_release(job);
+    return PQC_SUCCESS;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+void pqc_executor_get_stats(const pqc_executor_t *executor, pqc_executor_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+    memset(stats, 0, sizeof(*stats));
+    if (!executor) {
+        return;
+    }
+    stats->workers = executor->nworkers;
+    for (unsigned i = 0; i < executor->nworkers; i++) {
+        executor_worker_t *w = &executor->workers[i];
+        for (int p = 0; p < PQC_TASK_PRIORITY_COUNT; p++) {
+            stats->executed[p] += atomic_load_explicit(&w->executed[p], memory_order_relaxed);
+        }
+        stats->local += atomic_load_explicit(&w->local, memory_order_relaxed);
+        stats->steals += atomic_load_explicit(&w->steals, memory_order_relaxed);
+        stats->steal_attempts += atomic_load_explicit(&w->steal_attempts, memory_order_relaxed);
+        stats->parks += atomic_load_explicit(&w->parks, memory_order_relaxed);
+        stats->idle_ns += atomic_load_explicit(&w->idle_ns, memory_order_relaxed);
+    }
+    for (int p = 0; p < PQC_TASK_PRIORITY_COUNT; p++) {
+        stats->injected += atomic_load_explicit(&executor->inject[p].total, memory_order_relaxed);
+    }
+}
@@ -0,0 +1,174 @@
+/**
+ * @file pqc_executor.h
+ * @brief Work-stealing executor shared by the batch APIs
+ *
+ * One pool of worker threads for all parallel work in the process (batch
+ * verification, bulk key generation, parallel measurement, the C++
+ * coroutine executor), so that the batch APIs do not each start threads
+ * of their own and oversubscribe the host.
+ *
+ * Each worker owns a Chase-Lev deque per priority. Tasks submitted from a
+ * worker go to the bottom of its own deque and are popped LIFO, which
+ * keeps a fork-join computation on warm caches; idle workers steal from
+ * the top of the others' deques. Tasks submitted from any other thread
+ * go to a shared injection queue. Latency-critical tasks (signing a
+ * report someone is waiting for) always run before bulk tasks that have
+ * not started yet, wherever they are queued.
+ *
+ * Tasks are intrusive: the caller embeds a pqc_task_t in its own state and
+ * keeps it alive until the task has run, so submitting never allocates.
+ *
+ * The default pool size follows the CPUs the process may actually use:
+ * the affinity mask and, inside a container, the cgroup CPU quota, so a
+ * pod limited to two CPUs on a 64-core host runs two workers.
+ */
+
+#ifndef PQC_EXECUTOR_H
+#define PQC_EXECUTOR_H
+
+#include "pqc_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Constants and Types
+// ============================================================================
+
+#define PQC_EXECUTOR_DEFAULT_DEQUE  1024    /**< Deque slots per worker and priority */
+#define PQC_EXECUTOR_MAX_WORKERS    256
+
+/**
+ * @brief Task priorities, most urgent first
+ */
+typedef enum {
+    PQC_TASK_PRIORITY_LATENCY = 0,      /**< Someone is waiting: signing, interactive verify */
+    PQC_TASK_PRIORITY_BULK = 1,         /**< Batch verification, keygen, measurement */
+    PQC_TASK_PRIORITY_COUNT = 2
+} pqc_task_priority_t;
+
+/**
+ * @brief A unit of work, embedded in the submitter's state
+ *
+ * run receives the task itself; recover the enclosing state from it.
+ */
+typedef struct pqc_task {
+    void (*run)(struct pqc_task *task);
+    struct pqc_task *next;              /**< Executor use */
+} pqc_task_t;
+
+typedef struct {
+    unsigned workers;                   /**< 0 for pqc_executor_default_workers() */
+    size_t deque_capacity;              /**< Power of two; 0 for PQC_EXECUTOR_DEFAULT_DEQUE */
+} pqc_executor_config_t;
+
+/**
+ * @brief Executor counters, summed over workers
+ */
+typedef struct {
+    unsigned workers;
+    uint64_t executed[PQC_TASK_PRIORITY_COUNT]; /**< Tasks run, by priority */
+    uint64_t local;                     /**< Submitted from a worker to its own deque */
+    uint64_t injected;                  /**< Submitted from other threads or on overflow */
+    uint64_t steals;                    /**< Tasks taken from another worker's deque */
+    uint64_t steal_attempts;            /**< Deques probed while looking for work */
+    uint64_t parks;                     /**< Times a worker went to sleep */
+    uint64_t idle_ns;                   /**< Time workers spent asleep */
+} pqc_executor_stats_t;
+
+typedef struct pqc_executor pqc_executor_t;
+
+/**
+ * @brief Loop body for pqc_executor_parallel_for(): handle [begin, end)
+ */
+typedef void (*pqc_parallel_fn)(void *ctx, size_t begin, size_t end);
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+/**
+ * @brief Workers the process can keep busy
+ *
+ * The smallest of the online CPUs, the CPUs in the affinity mask and the
+ * cgroup CPU quota (cgroup v2 cpu.max or v1 cpu.cfs_quota_us), rounded up.
+ */
+unsigned pqc_executor_default_workers(void);
+
+/**
+ * @brief Start a private executor
+ *
+ * Prefer pqc_executor_shared(); a private pool is for work that must not
+ * queue behind the rest of the process.
+ *
+ * @param[out] executor Created executor
+ * @param[in] config Configuration, NULL for defaults
+ * @return PQC_SUCCESS, PQC_ERROR_INVALID_PARAMETER or
+ *         PQC_ERROR_INSUFFICIENT_MEMORY
+ */
+pqc_result_t pqc_executor_create(pqc_executor_t **executor, const pqc_executor_config_t *config);
+
+/**
+ * @brief Run every task still queued, then join the workers
+ *
+ * Nothing may submit to the executor once this has been called.
+ */
+void pqc_executor_destroy(pqc_executor_t *executor);
+
+/**
+ * @brief The process-wide executor, started on first use
+ *
+ * Destroyed by pqc_cleanup().
+ *
+ * @return The executor, or NULL if it could not be started
+ */
+pqc_executor_t *pqc_executor_shared(void);
+
+/**
+ * @brief Destroy the shared executor if it was started
+ */
+void pqc_executor_shutdown_shared(void);
+
+unsigned pqc_executor_size(const pqc_executor_t *executor);
+
+// ============================================================================
+// Submission
+// ============================================================================
+
+/**
+ * @brief Queue a task
+ *
+ * Safe from any thread, including from inside a running task.
+ */
+void pqc_executor_submit(pqc_executor_t *executor, pqc_task_t *task,
+                         pqc_task_priority_t priority);
+
+/**
+ * @brief Run body over [0, count) in chunks of grain, and wait
+ *
+ * The calling thread works on chunks too, so a call made from inside a
+ * task cannot deadlock the pool, and a NULL executor just runs the loop
+ * on the caller.
+ *
+ * @param[in] grain Indices per chunk, 0 for a few chunks per thread
+ * @return PQC_SUCCESS once every chunk has run, PQC_ERROR_INVALID_PARAMETER
+ */
+pqc_result_t pqc_executor_parallel_for(pqc_executor_t *executor, size_t count, size_t grain,
+                                       pqc_parallel_fn body, void *ctx,
+                                       pqc_task_priority_t priority);
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+/**
+ * @brief Counters so far; approximate while tasks are running
+ */
+void pqc_executor_get_stats(const pqc_executor_t *executor, pqc_executor_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PQC_EXECUTOR_H */
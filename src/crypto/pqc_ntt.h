@@ -0,0 +1,127 @@
+/**
+ * @file pqc_ntt.h
+ * @brief Compile-time generation of NTT twiddle tables and constants
+ *
+ * Twiddle tables, Montgomery constants and inverse-transform scalings are
+ * derived here from (q, root of unity, Montgomery radix) by integer
+ * constant expressions, so the compiler computes every table entry and
+ * _Static_assert can check the parameters they come from. A table is
+ * declared by expanding an entry macro over its indices:
+ *
+ *     PQC_NTT_DEFINE_POWERS(KYBER_ROOT, 17, KYBER_Q);
+ *     #define KYBER_ZETA(k) PQC_NTT_MONT(PQC_NTT_POW_BITREV(KYBER_ROOT, k, 7, KYBER_Q), \
+ *                                        KYBER_MONT, KYBER_Q)
+ *     static const uint16_t zetas[128] = { PQC_NTT_REP128(KYBER_ZETA, 0) };
+ *
+ * Other representations of the same twiddles (Shoup companions for
+ * lazy-reduction butterflies, a permuted order for a vectorized layout)
+ * are another entry macro over the same powers, not another pasted table.
+ *
+ * Everything is a macro or an enumerator: there is no code to link, and
+ * all arguments must be integer constant expressions.
+ */
+
+#ifndef PQC_NTT_H
+#define PQC_NTT_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Modular Arithmetic
+// ============================================================================
+
+/** a * b mod q for a, b < q < 2^32 */
+#define PQC_NTT_MULMOD(a, b, q) \
+    ((uint32_t)(((uint64_t)(a) * (uint64_t)(b)) % (uint64_t)(q)))
+
+/** 2^bits mod q, the Montgomery radix R for bits-wide reduction */
+#define PQC_NTT_RADIX(bits, q) ((uint32_t)(((uint64_t)1 << (bits)) % (uint64_t)(q)))
+
+/** x in Montgomery form, x * R mod q, given R = PQC_NTT_RADIX() */
+#define PQC_NTT_MONT(x, radix, q) PQC_NTT_MULMOD(x, radix, q)
+
+/** Shoup companion floor(x * 2^bits / q) of a twiddle x < q */
+#define PQC_NTT_SHOUP(x, bits, q) ((uint32_t)(((uint64_t)(x) << (bits)) / (uint64_t)(q)))
+
+/** One Newton step x * (2 - q * x) mod 2^32 towards q^-1 */
+#define PQC_NTT_NEWTON_(x, q) ((uint32_t)((uint32_t)(x) * (2u - (uint32_t)(q) * (uint32_t)(x))))
+
+/**
+ * q^-1 mod 2^32 for odd q; mask it for a narrower radix. q is its own
+ * inverse mod 8 and each Newton step doubles the correct bits.
+ */
+#define PQC_NTT_QINV32(q) \
+    PQC_NTT_NEWTON_(PQC_NTT_NEWTON_(PQC_NTT_NEWTON_(PQC_NTT_NEWTON_(q, q), q), q), q)
+
+/** n^-1 mod q for a power of two n dividing q - 1 */
+#define PQC_NTT_INV_N(n, q) ((uint32_t)((q) - ((q) - 1) / (n)))
+
+// ============================================================================
+// Powers of the Root of Unity
+// ============================================================================
+
+/**
+ * @brief Declare enumerators P_POW1 .. P_POW1024 = root^(2^i) mod q
+ *
+ * Requires q < 2^31 so every power fits an enumerator. P_POW1024 == q - 1
+ * is the check that root is a primitive 2048-th root of unity; in general
+ * a primitive 2n-th root has P_POWn == q - 1.
+ */
+#define PQC_NTT_DEFINE_POWERS(P, root, q)                                   \
+    enum {                                                                  \
+        P##_POW1 = (int)((root) % (q)),                                     \
+        P##_POW2 = (int)PQC_NTT_MULMOD(P##_POW1, P##_POW1, q),              \
+        P##_POW4 = (int)PQC_NTT_MULMOD(P##_POW2, P##_POW2, q),              \
+        P##_POW8 = (int)PQC_NTT_MULMOD(P##_POW4, P##_POW4, q),              \
+        P##_POW16 = (int)PQC_NTT_MULMOD(P##_POW8, P##_POW8, q),             \
+        P##_POW32 = (int)PQC_NTT_MULMOD(P##_POW16, P##_POW16, q),           \
+        P##_POW64 = (int)PQC_NTT_MULMOD(P##_POW32, P##_POW32, q),           \
+        P##_POW128 = (int)PQC_NTT_MULMOD(P##_POW64, P##_POW64, q),          \
+        P##_POW256 = (int)PQC_NTT_MULMOD(P##_POW128, P##_POW128, q),        \
+        P##_POW512 = (int)PQC_NTT_MULMOD(P##_POW256, P##_POW256, q),        \
+        P##_POW1024 = (int)PQC_NTT_MULMOD(P##_POW512, P##_POW512, q)        \
+    }
+
+/** Bit bits-1-j of k, i.e. bit j of the bits-wide bit reversal of k */
+#define PQC_NTT_REVBIT_(k, j, bits) (((((uint32_t)(k)) << (j)) >> ((bits) - 1)) & 1u)
+
+#define PQC_NTT_TERM_(P, POW, k, j, bits) \
+    (PQC_NTT_REVBIT_(k, j, bits) ? (uint32_t)P##_POW##POW : 1u)
+
+/**
+ * @brief root^brev_bits(k) mod q for k < 2^bits, bits <= 10
+ *
+ * The bit-reversed power that NTT butterfly k uses; P names the powers
+ * declared by PQC_NTT_DEFINE_POWERS().
+ */
+#define PQC_NTT_POW_BITREV(P, k, bits, q)                                   \
+    PQC_NTT_MULMOD(PQC_NTT_MULMOD(PQC_NTT_MULMOD(PQC_NTT_MULMOD(            \
+    PQC_NTT_MULMOD(PQC_NTT_MULMOD(PQC_NTT_MULMOD(PQC_NTT_MULMOD(            \
+    PQC_NTT_MULMOD(PQC_NTT_TERM_(P, 1, k, 0, bits),                         \
+                   PQC_NTT_TERM_(P, 2, k, 1, bits), q),                     \
+                   PQC_NTT_TERM_(P, 4, k, 2, bits), q),                     \
+                   PQC_NTT_TERM_(P, 8, k, 3, bits), q),                     \
+                   PQC_NTT_TERM_(P, 16, k, 4, bits), q),                    \
+                   PQC_NTT_TERM_(P, 32, k, 5, bits), q),                    \
+                   PQC_NTT_TERM_(P, 64, k, 6, bits), q),                    \
+                   PQC_NTT_TERM_(P, 128, k, 7, bits), q),                   \
+                   PQC_NTT_TERM_(P, 256, k, 8, bits), q),                   \
+                   PQC_NTT_TERM_(P, 512, k, 9, bits), q)
+
+// ============================================================================
+// Table Expansion
+// ============================================================================
+
+/** M(i), M(i + 1), ..., M(i + n - 1) as an initializer list */
+#define PQC_NTT_REP2(M, i)    M(i), M((i) + 1)
+#define PQC_NTT_REP4(M, i)    PQC_NTT_REP2(M, i), PQC_NTT_REP2(M, (i) + 2)
+#define PQC_NTT_REP8(M, i)    PQC_NTT_REP4(M, i), PQC_NTT_REP4(M, (i) + 4)
+#define PQC_NTT_REP16(M, i)   PQC_NTT_REP8(M, i), PQC_NTT_REP8(M, (i) + 8)
+#define PQC_NTT_REP32(M, i)   PQC_NTT_REP16(M, i), PQC_NTT_REP16(M, (i) + 16)
+#define PQC_NTT_REP64(M, i)   PQC_NTT_REP32(M, i), PQC_NTT_REP32(M, (i) + 32)
+#define PQC_NTT_REP128(M, i)  PQC_NTT_REP64(M, i), PQC_NTT_REP64(M, (i) + 64)
+#define PQC_NTT_REP256(M, i)  PQC_NTT_REP128(M, i), PQC_NTT_REP128(M, (i) + 128)
+#define PQC_NTT_REP512(M, i)  PQC_NTT_REP256(M, i), PQC_NTT_REP256(M, (i) + 256)
+#define PQC_NTT_REP1024(M, i) PQC_NTT_REP512(M, i), PQC_NTT_REP512(M, (i) + 512)
+
+#endif /* PQC_NTT_H */
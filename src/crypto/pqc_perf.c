@@ -0,0 +1,244 @@
+/**
+ * @file pqc_perf.c
+ * @brief Hardware performance counter instrumentation
+ */
+
+#define _GNU_SOURCE
+
+#include "pqc_perf.h"
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+/**
+ * @brief Per-thread counter group and phase totals
+ */
+typedef struct {
+    int fds[PQC_PERF_COUNTER_COUNT];
+    uint64_t ids[PQC_PERF_COUNTER_COUNT];
+    int leader;                         /**< Group leader fd, -1 if closed */
+    uint32_t valid_mask;
+    uint32_t open_phases;               /**< Bit n set while phase n is running */
+    uint64_t phase_start[PQC_PERF_PHASE_COUNT][PQC_PERF_COUNTER_COUNT];
+    pqc_perf_counters_t phase_totals[PQC_PERF_PHASE_COUNT];
+} perf_thread_state_t;
+
+static _Thread_local perf_thread_state_t t_perf = { .leader = -1 };
+
+static const char *const counter_names[PQC_PERF_COUNTER_COUNT] = {
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses"
+};
+
+static const char *const phase_names[PQC_PERF_PHASE_COUNT] = {
+    "keygen", "sign_encaps", "verify_decaps", "expand_matrix", "hash", "poly_arith",
+    "rejection_loop"
+};
+
+#ifdef __linux__
+
+#define CACHE_READ_MISS(cache) \
+    ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static const struct {
+    uint32_t type;
+    uint64_t config;
+} counter_events[PQC_PERF_COUNTER_COUNT] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D) },
+    { PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_LL) },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    { PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_DTLB) },
+};
+
+static int open_event(int counter, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = counter_events[counter].type;
+    attr.config = counter_events[counter].config;
+    attr.disabled = group_fd == -1 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+                       PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+pqc_result_t pqc_perf_thread_open(void) {
+    if (t_perf.leader >= 0) {
+        return PQC_SUCCESS;
+    }
+
+    int first_errno = 0;
+    t_perf.valid_mask = 0;
+    for (int i = 0; i < PQC_PERF_COUNTER_COUNT; i++) {
+        t_perf.fds[i] = open_event(i, t_perf.leader);
+        if (t_perf.fds[i] < 0) {
+            if (!first_errno) {
+                first_errno = errno;
+            }
+            continue;
+        }
+        if (ioctl(t_perf.fds[i], PERF_EVENT_IOC_ID, &t_perf.ids[i]) != 0) {
+            close(t_perf.fds[i]);
+            t_perf.fds[i] = -1;
+            continue;
+        }
+        if (t_perf.leader < 0) {
+            t_perf.leader = t_perf.fds[i];
+        }
+        t_perf.valid_mask |= 1u << i;
+    }
+
+    if (t_perf.leader < 0) {
+        if (first_errno == ENOENT || first_errno == ENOSYS || first_errno == EOPNOTSUPP) {
+            return PQC_ERROR_NOT_IMPLEMENTED;
+        }
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+
+    ioctl(t_perf.leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(t_perf.leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return PQC_SUCCESS;
+}
+
+void pqc_perf_thread_close(void) {
+    if (t_perf.leader < 0) {
+        return;
+    }
+
+    // Close members before the leader
+    for (int i = PQC_PERF_COUNTER_COUNT - 1; i >= 0; i--) {
+        if (t_perf.valid_mask & (1u << i)) {
+            close(t_perf.fds[i]);
+        }
+    }
+    t_perf.leader = -1;
+    t_perf.valid_mask = 0;
+    t_perf.open_phases = 0;
+}
+
+pqc_result_t pqc_perf_read(uint64_t values[PQC_PERF_COUNTER_COUNT]) {
+    if (!values) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    memset(values, 0, PQC_PERF_COUNTER_COUNT * sizeof(uint64_t));
+    if (t_perf.leader < 0) {
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+
+    // nr, time_enabled, time_running, then {value, id} per event
+    uint64_t buf[3 + 2 * PQC_PERF_COUNTER_COUNT];
+    ssize_t n = read(t_perf.leader, buf, sizeof(buf));
+    if (n < (ssize_t)(3 * sizeof(uint64_t))) {
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+
+    uint64_t nr = buf[0];
+    uint64_t enabled = buf[1];
+    uint64_t running = buf[2];
+    if (nr > PQC_PERF_COUNTER_COUNT) {
+        nr = PQC_PERF_COUNTER_COUNT;
+    }
+
+    for (uint64_t e = 0; e < nr; e++) {
+        uint64_t value = buf[3 + 2 * e];
+        uint64_t id = buf[4 + 2 * e];
+        if (running > 0 && running < enabled) {
+            value = (uint64_t)((double)value * (double)enabled / (double)running);
+        }
+        for (int i = 0; i < PQC_PERF_COUNTER_COUNT; i++) {
+            if ((t_perf.valid_mask & (1u << i)) && t_perf.ids[i] == id) {
+                values[i] = value;
+                break;
+            }
+        }
+    }
+    return PQC_SUCCESS;
+}
+
+#else /* !__linux__ */
+
+pqc_result_t pqc_perf_thread_open(void) {
+    return PQC_ERROR_NOT_IMPLEMENTED;
+}
+
+void pqc_perf_thread_close(void) {
+}
+
+pqc_result_t pqc_perf_read(uint64_t values[PQC_PERF_COUNTER_COUNT]) {
+    if (!values) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    memset(values, 0, PQC_PERF_COUNTER_COUNT * sizeof(uint64_t));
+    return PQC_ERROR_NOT_IMPLEMENTED;
+}
+
+#endif /* __linux__ */
+
+uint32_t pqc_perf_valid_mask(void) {
+    return t_perf.valid_mask;
+}
+
+void pqc_perf_phase_begin(pqc_perf_phase_t phase) {
+    if (t_perf.leader < 0 || phase >= PQC_PERF_PHASE_COUNT) {
+        return;
+    }
+    if (pqc_perf_read(t_perf.phase_start[phase]) == PQC_SUCCESS) {
+        t_perf.open_phases |= 1u << phase;
+    }
+}
+
+void pqc_perf_phase_end(pqc_perf_phase_t phase) {
+    if (phase >= PQC_PERF_PHASE_COUNT || !(t_perf.open_phases & (1u << phase))) {
+        return;
+    }
+    t_perf.open_phases &= ~(1u << phase);
+
+    uint64_t now[PQC_PERF_COUNTER_COUNT];
+    if (pqc_perf_read(now) != PQC_SUCCESS) {
+        return;
+    }
+
+    pqc_perf_counters_t *total = &t_perf.phase_totals[phase];
+    for (int i = 0; i < PQC_PERF_COUNTER_COUNT; i++) {
+        if (now[i] >= t_perf.phase_start[phase][i]) {
+            total->values[i] += now[i] - t_perf.phase_start[phase][i];
+        }
+    }
+    total->samples++;
+    total->valid_mask = t_perf.valid_mask;
+}
+
+void pqc_perf_get_phase_counters(pqc_perf_counters_t counters[PQC_PERF_PHASE_COUNT]) {
+    if (counters) {
+        memcpy(counters, t_perf.phase_totals, sizeof(t_perf.phase_totals));
+    }
+}
+
+void pqc_perf_reset_phase_counters(void) {
+    memset(t_perf.phase_totals, 0, sizeof(t_perf.phase_totals));
+    t_perf.open_phases = 0;
+}
+
+const char* pqc_perf_counter_name(pqc_perf_counter_t counter) {
+    if ((unsigned)counter >= PQC_PERF_COUNTER_COUNT) {
+        return "unknown";
+    }
+    return counter_names[counter];
+}
+
+const char* pqc_perf_phase_name(pqc_perf_phase_t phase) {
+    if ((unsigned)phase >= PQC_PERF_PHASE_COUNT) {
+        return "unknown";
+    }
+    return phase_names[phase];
+}
@@ -0,0 +1,136 @@
+/**
+ * @file pqc_perf.h
+ * @brief Hardware performance counter instrumentation
+ *
+ * Collects cycles, instructions, L1D/LLC misses, branch mispredicts and
+ * dTLB misses through Linux perf_event_open(). Counters are opened as one
+ * group per thread, so every read is a consistent snapshot of all events
+ * on the calling thread. When the library is built with
+ * PQC_ENABLE_PERF_COUNTERS the primitives attribute counts to the phases
+ * in pqc_perf_phase_t; otherwise the phase hooks compile to nothing.
+ *
+ * Access may be denied (perf_event_paranoid, containers, seccomp) or
+ * individual events may be missing on a given CPU; callers check the
+ * return code of pqc_perf_thread_open() and valid_mask.
+ */
+
+#ifndef PQC_PERF_H
+#define PQC_PERF_H
+
+#include "pqc_common.h"
+#include "pqc_profile.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Phase Hooks
+// ============================================================================
+
+#ifdef PQC_ENABLE_PERF_COUNTERS
+#define PQC_PERF_COUNT_BEGIN(phase) pqc_perf_phase_begin(phase)
+#define PQC_PERF_COUNT_END(phase)   pqc_perf_phase_end(phase)
+#else
+#define PQC_PERF_COUNT_BEGIN(phase) ((void)0)
+#define PQC_PERF_COUNT_END(phase)   ((void)0)
+#endif
+
+// Phases double as sampling profiler tags (see pqc_profile.h)
+#define PQC_PERF_PHASE_BEGIN(phase) \
+    (PQC_PROFILE_PHASE_PUSH(pqc_perf_phase_name(phase)), PQC_PERF_COUNT_BEGIN(phase))
+#define PQC_PERF_PHASE_END(phase) \
+    (PQC_PERF_COUNT_END(phase), PQC_PROFILE_PHASE_POP())
+
+// ============================================================================
+// Counter Group
+// ============================================================================
+
+/**
+ * @brief Open the counter group for the calling thread
+ *
+ * Events the CPU or kernel does not provide are skipped; the group is
+ * usable as long as at least one event could be opened. Kernel and
+ * hypervisor activity is excluded so that the default
+ * perf_event_paranoid setting is sufficient.
+ *
+ * @return PQC_SUCCESS if at least one counter is active,
+ *         PQC_ERROR_NOT_IMPLEMENTED if perf events are unsupported,
+ *         PQC_ERROR_HARDWARE_FAILURE if access was denied
+ */
+pqc_result_t pqc_perf_thread_open(void);
+
+/**
+ * @brief Close the calling thread's counter group
+ */
+void pqc_perf_thread_close(void);
+
+/**
+ * @brief Bitmask of counters active on the calling thread
+ *
+ * @return Bit n set if pqc_perf_counter_t n is being counted (0 if closed)
+ */
+uint32_t pqc_perf_valid_mask(void);
+
+/**
+ * @brief Read the calling thread's counters
+ *
+ * Values are scaled for multiplexing when the group was not scheduled
+ * for the whole time it was enabled.
+ *
+ * @param[out] values Snapshot indexed by pqc_perf_counter_t
+ * @return PQC_SUCCESS on success, error code if the group is not open
+ */
+pqc_result_t pqc_perf_read(uint64_t values[PQC_PERF_COUNTER_COUNT]);
+
+// ============================================================================
+// Phase Accounting
+// ============================================================================
+
+/**
+ * @brief Mark the start of a phase on the calling thread
+ *
+ * @param[in] phase Phase identifier
+ */
+void pqc_perf_phase_begin(pqc_perf_phase_t phase);
+
+/**
+ * @brief Mark the end of a phase and accumulate its counter deltas
+ *
+ * @param[in] phase Phase identifier
+ */
+void pqc_perf_phase_end(pqc_perf_phase_t phase);
+
+/**
+ * @brief Copy the calling thread's per-phase totals
+ *
+ * @param[out] counters Totals indexed by pqc_perf_phase_t
+ */
+void pqc_perf_get_phase_counters(pqc_perf_counters_t counters[PQC_PERF_PHASE_COUNT]);
+
+/**
+ * @brief Clear the calling thread's per-phase totals
+ */
+void pqc_perf_reset_phase_counters(void);
+
+/**
+ * @brief Counter name for reports (e.g. "l1d_misses")
+ *
+ * @param[in] counter Counter identifier
+ * @return Counter name
+ */
+const char* pqc_perf_counter_name(pqc_perf_counter_t counter);
+
+/**
+ * @brief Phase name for reports (e.g. "expand_matrix")
+ *
+ * @param[in] phase Phase identifier
+ * @return Phase name
+ */
+const char* pqc_perf_phase_name(pqc_perf_phase_t phase);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PQC_PERF_H */
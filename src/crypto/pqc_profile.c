@@ -0,0 +1,514 @@
+/**
+ * @file pqc_profile.c
+ * @brief Timer-based sampling profiler with operation/phase tags
+ */
+
+#define _GNU_SOURCE
+
+#include "pqc_profile.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+
+#ifdef __linux__
+#include <signal.h>
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+#include <ucontext.h>
+#include <dlfcn.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+#if (PQC_PROFILE_BUFFER_SAMPLES & (PQC_PROFILE_BUFFER_SAMPLES - 1)) != 0
+#error "PQC_PROFILE_BUFFER_SAMPLES must be a power of two"
+#endif
+
+#define PROFILE_MASK (PQC_PROFILE_BUFFER_SAMPLES - 1)
+
+// The handler reads this state; initial-exec TLS is async-signal-safe
+#if defined(__GNUC__)
+#define PROFILE_TLS _Thread_local __attribute__((tls_model("initial-exec")))
+#else
+#define PROFILE_TLS _Thread_local
+#endif
+
+/**
+ * @brief One slot of the bounded MPMC sample buffer
+ *
+ * seq == index: free for the producer claiming index;
+ * seq == index + 1: holds the sample for index.
+ */
+typedef struct {
+    _Atomic uint64_t seq;
+    const char *op;
+    const char *phase;
+    uint32_t depth;
+    uintptr_t frames[PQC_PROFILE_MAX_FRAMES];
+} profile_slot_t;
+
+/**
+ * @brief Per-thread tags and sampling timer
+ */
+typedef struct {
+    const char *ops[PQC_PROFILE_MAX_TAG_DEPTH];
+    const char *phases[PQC_PROFILE_MAX_TAG_DEPTH];
+    int op_depth;                       /**< May exceed the array size */
+    int phase_depth;
+    uintptr_t stack_lo;                 /**< Frame walk bounds, 0 if unknown */
+    uintptr_t stack_hi;
+#ifdef __linux__
+    timer_t timer;
+#endif
+    bool timer_active;
+} profile_thread_state_t;
+
+static PROFILE_TLS profile_thread_state_t t_prof;
+
+static profile_slot_t *g_slots;
+static _Atomic uint64_t g_head;
+static _Atomic uint64_t g_tail;
+static _Atomic uint64_t g_samples;
+static _Atomic uint64_t g_dropped;
+static _Atomic uint64_t g_written;
+static atomic_bool g_running;
+static bool g_handler_installed;
+static unsigned g_hz = PQC_PROFILE_DEFAULT_HZ;
+
+// ============================================================================
+// Tags
+// ============================================================================
+
+void pqc_profile_op_push(const char *op) {
+    int depth = t_prof.op_depth;
+    if (depth < PQC_PROFILE_MAX_TAG_DEPTH) {
+        t_prof.ops[depth] = op;
+    }
+    // The tag must be in place before the handler can see the new depth
+    atomic_signal_fence(memory_order_release);
+    t_prof.op_depth = depth + 1;
+}
+
+void pqc_profile_op_pop(void) {
+    if (t_prof.op_depth > 0) {
+        t_prof.op_depth--;
+    }
+}
+
+void pqc_profile_phase_push(const char *phase) {
+    int depth = t_prof.phase_depth;
+    if (depth < PQC_PROFILE_MAX_TAG_DEPTH) {
+        t_prof.phases[depth] = phase;
+    }
+    atomic_signal_fence(memory_order_release);
+    t_prof.phase_depth = depth + 1;
+}
+
+void pqc_profile_phase_pop(void) {
+    if (t_prof.phase_depth > 0) {
+        t_prof.phase_depth--;
+    }
+}
+
+static const char* innermost(const char *const *stack, int depth) {
+    if (depth <= 0) {
+        return NULL;
+    }
+    return stack[(depth <= PQC_PROFILE_MAX_TAG_DEPTH ? depth : PQC_PROFILE_MAX_TAG_DEPTH) - 1];
+}
+
+// ============================================================================
+// Sample Buffer
+// ============================================================================
+
+/**
+ * @brief Claim a free slot, or NULL if the buffer is full (signal-safe)
+ */
+static profile_slot_t* buffer_claim(uint64_t *index) {
+    uint64_t pos = atomic_load_explicit(&g_head, memory_order_relaxed);
+    for (;;) {
+        profile_slot_t *slot = &g_slots[pos & PROFILE_MASK];
+        uint64_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int64_t diff = (int64_t)(seq - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&g_head, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                *index = pos;
+                return slot;
+            }
+        } else if (diff < 0) {
+            return NULL;
+        } else {
+            pos = atomic_load_explicit(&g_head, memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Take the oldest published sample, or return false if none
+ */
+static bool buffer_take(profile_slot_t *out) {
+    uint64_t pos = atomic_load_explicit(&g_tail, memory_order_relaxed);
+    for (;;) {
+        profile_slot_t *slot = &g_slots[pos & PROFILE_MASK];
+        uint64_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int64_t diff = (int64_t)(seq - (pos + 1));
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&g_tail, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                out->op = slot->op;
+                out->phase = slot->phase;
+                out->depth = slot->depth;
+                memcpy(out->frames, slot->frames, slot->depth * sizeof(uintptr_t));
+                atomic_store_explicit(&slot->seq, pos + PQC_PROFILE_BUFFER_SAMPLES,
+                                      memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = atomic_load_explicit(&g_tail, memory_order_relaxed);
+        }
+    }
+}
+
+#ifdef __linux__
+
+// ============================================================================
+// Sampling
+// ============================================================================
+
+/**
+ * @brief Walk the frame-pointer chain from the interrupted context
+ *
+ * Only frames inside the thread's recorded stack bounds are followed, so a
+ * function built without frame pointers ends the walk instead of faulting.
+ */
+static uint32_t capture_stack(const ucontext_t *uc, uintptr_t *frames) {
+    uintptr_t pc, fp;
+#if defined(__x86_64__)
+    pc = (uintptr_t)uc->uc_mcontext.gregs[REG_RIP];
+    fp = (uintptr_t)uc->uc_mcontext.gregs[REG_RBP];
+#elif defined(__aarch64__)
+    pc = (uintptr_t)uc->uc_mcontext.pc;
+    fp = (uintptr_t)uc->uc_mcontext.regs[29];
+#else
+    (void)uc;
+    return 0;
+#endif
+
+    uint32_t n = 0;
+    frames[n++] = pc;
+    while (n < PQC_PROFILE_MAX_FRAMES && t_prof.stack_lo != 0 &&
+           fp >= t_prof.stack_lo && fp + 2 * sizeof(uintptr_t) <= t_prof.stack_hi &&
+           (fp & (sizeof(uintptr_t) - 1)) == 0) {
+        const uintptr_t *frame = (const uintptr_t *)fp;
+        uintptr_t next = frame[0];
+        uintptr_t ret = frame[1];
+        if (ret == 0) {
+            break;
+        }
+        // Return address minus one lands inside the calling instruction
+        frames[n++] = ret - 1;
+        if (next <= fp) {
+            break;
+        }
+        fp = next;
+    }
+    return n;
+}
+
+static void profile_handler(int sig, siginfo_t *info, void *context) {
+    (void)sig;
+    (void)info;
+    if (!atomic_load_explicit(&g_running, memory_order_relaxed) || !g_slots) {
+        return;
+    }
+
+    int saved_errno = errno;
+    atomic_fetch_add_explicit(&g_samples, 1, memory_order_relaxed);
+
+    uint64_t index;
+    profile_slot_t *slot = buffer_claim(&index);
+    if (!slot) {
+        atomic_fetch_add_explicit(&g_dropped, 1, memory_order_relaxed);
+        errno = saved_errno;
+        return;
+    }
+
+    slot->op = innermost(t_prof.ops, t_prof.op_depth);
+    slot->phase = innermost(t_prof.phases, t_prof.phase_depth);
+    slot->depth = capture_stack((const ucontext_t *)context, slot->frames);
+    atomic_store_explicit(&slot->seq, index + 1, memory_order_release);
+    errno = saved_errno;
+}
+
+pqc_result_t pqc_profile_start(unsigned hz) {
+    if (!g_slots) {
+        profile_slot_t *slots = calloc(PQC_PROFILE_BUFFER_SAMPLES, sizeof(profile_slot_t));
+        if (!slots) {
+            return PQC_ERROR_INSUFFICIENT_MEMORY;
+        }
+        for (uint64_t i = 0; i < PQC_PROFILE_BUFFER_SAMPLES; i++) {
+            atomic_init(&slots[i].seq, i);
+        }
+        g_slots = slots;
+    }
+
+    // Left installed after stop: a timer firing late must not hit SIG_DFL
+    if (!g_handler_installed) {
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = profile_handler;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGPROF, &action, NULL) != 0) {
+            return PQC_ERROR_HARDWARE_FAILURE;
+        }
+        g_handler_installed = true;
+    }
+
+    g_hz = hz ? hz : PQC_PROFILE_DEFAULT_HZ;
+    atomic_store(&g_running, true);
+    return PQC_SUCCESS;
+}
+
+void pqc_profile_stop(void) {
+    atomic_store(&g_running, false);
+    pqc_profile_thread_stop();
+}
+
+pqc_result_t pqc_profile_thread_start(void) {
+    if (t_prof.timer_active) {
+        return PQC_SUCCESS;
+    }
+    if (!atomic_load(&g_running)) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+        void *addr;
+        size_t size;
+        if (pthread_attr_getstack(&attr, &addr, &size) == 0) {
+            t_prof.stack_lo = (uintptr_t)addr;
+            t_prof.stack_hi = (uintptr_t)addr + size;
+        }
+        pthread_attr_destroy(&attr);
+    }
+
+    struct sigevent sev;
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_notify = SIGEV_THREAD_ID;
+    sev.sigev_signo = SIGPROF;
+    sev.sigev_notify_thread_id = (pid_t)syscall(SYS_gettid);
+    if (timer_create(CLOCK_THREAD_CPUTIME_ID, &sev, &t_prof.timer) != 0) {
+        return (errno == ENOTSUP || errno == EINVAL) ? PQC_ERROR_NOT_IMPLEMENTED
+                                                     : PQC_ERROR_HARDWARE_FAILURE;
+    }
+
+    long interval_ns = 1000000000L / (long)g_hz;
+    struct itimerspec spec = {
+        .it_interval = { .tv_sec = interval_ns / 1000000000L, .tv_nsec = interval_ns % 1000000000L },
+        .it_value = { .tv_sec = interval_ns / 1000000000L, .tv_nsec = interval_ns % 1000000000L }
+    };
+    if (timer_settime(t_prof.timer, 0, &spec, NULL) != 0) {
+        timer_delete(t_prof.timer);
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+    t_prof.timer_active = true;
+    return PQC_SUCCESS;
+}
+
+void pqc_profile_thread_stop(void) {
+    if (!t_prof.timer_active) {
+        return;
+    }
+    timer_delete(t_prof.timer);
+    t_prof.timer_active = false;
+}
+
+#else /* !__linux__ */
+
+pqc_result_t pqc_profile_start(unsigned hz) {
+    (void)hz;
+    return PQC_ERROR_NOT_IMPLEMENTED;
+}
+
+void pqc_profile_stop(void) {
+}
+
+pqc_result_t pqc_profile_thread_start(void) {
+    return PQC_ERROR_NOT_IMPLEMENTED;
+}
+
+void pqc_profile_thread_stop(void) {
+}
+
+#endif /* __linux__ */
+
+// ============================================================================
+// Folded Output
+// ============================================================================
+
+/**
+ * @brief Distinct stack and its sample count
+ */
+typedef struct {
+    uint64_t hash;
+    uint64_t count;
+    const char *op;
+    const char *phase;
+    uint32_t depth;
+    uintptr_t frames[PQC_PROFILE_MAX_FRAMES];
+} folded_entry_t;
+
+typedef struct {
+    folded_entry_t *entries;
+    size_t count;
+    size_t capacity;                    /**< Power of two; 0 hash marks a free entry */
+} folded_table_t;
+
+static uint64_t sample_hash(const profile_slot_t *s) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    uintptr_t words[2 + PQC_PROFILE_MAX_FRAMES];
+    words[0] = (uintptr_t)s->op;
+    words[1] = (uintptr_t)s->phase;
+    memcpy(words + 2, s->frames, s->depth * sizeof(uintptr_t));
+    for (uint32_t i = 0; i < s->depth + 2; i++) {
+        h = (h ^ (uint64_t)words[i]) * 0x100000001b3ULL;
+    }
+    return h ? h : 1;
+}
+
+static bool same_stack(const folded_entry_t *e, const profile_slot_t *s) {
+    return e->op == s->op && e->phase == s->phase && e->depth == s->depth &&
+           memcmp(e->frames, s->frames, s->depth * sizeof(uintptr_t)) == 0;
+}
+
+static int table_grow(folded_table_t *t) {
+    size_t capacity = t->capacity ? t->capacity * 2 : 256;
+    folded_entry_t *entries = calloc(capacity, sizeof(folded_entry_t));
+    if (!entries) {
+        return -1;
+    }
+    for (size_t i = 0; i < t->capacity; i++) {
+        if (t->entries[i].hash) {
+            size_t j = t->entries[i].hash & (capacity - 1);
+            while (entries[j].hash) {
+                j = (j + 1) & (capacity - 1);
+            }
+            entries[j] = t->entries[i];
+        }
+    }
+    free(t->entries);
+    t->entries = entries;
+    t->capacity = capacity;
+    return 0;
+}
+
+static int table_add(folded_table_t *t, const profile_slot_t *s) {
+    if ((t->count + 1) * 10 > t->capacity * 7 && table_grow(t) != 0) {
+        return -1;
+    }
+    uint64_t hash = sample_hash(s);
+    size_t j = hash & (t->capacity - 1);
+    while (t->entries[j].hash) {
+        if (t->entries[j].hash == hash && same_stack(&t->entries[j], s)) {
+            t->entries[j].count++;
+            return 0;
+        }
+        j = (j + 1) & (t->capacity - 1);
+    }
+    folded_entry_t *e = &t->entries[j];
+    e->hash = hash;
+    e->count = 1;
+    e->op = s->op;
+    e->phase = s->phase;
+    e->depth = s->depth;
+    memcpy(e->frames, s->frames, s->depth * sizeof(uintptr_t));
+    t->count++;
+    return 0;
+}
+
+static void write_frame(FILE *out, uintptr_t addr) {
+#ifdef __linux__
+    Dl_info info;
+    if (dladdr((void *)addr, &info) != 0) {
+        if (info.dli_sname) {
+            fputs(info.dli_sname, out);
+            return;
+        }
+        if (info.dli_fname) {
+            const char *base = strrchr(info.dli_fname, '/');
+            fprintf(out, "%s+0x%lx", base ? base + 1 : info.dli_fname,
+                    (unsigned long)(addr - (uintptr_t)info.dli_fbase));
+            return;
+        }
+    }
+#endif
+    fprintf(out, "0x%lx", (unsigned long)addr);
+}
+
+pqc_result_t pqc_profile_write_folded(FILE *out) {
+    if (!out) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    if (!g_slots) {
+        return PQC_SUCCESS;
+    }
+
+    folded_table_t table = { 0 };
+    profile_slot_t *sample = malloc(sizeof(profile_slot_t));
+    if (!sample || table_grow(&table) != 0) {
+        free(sample);
+        return PQC_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    pqc_result_t result = PQC_SUCCESS;
+    while (buffer_take(sample)) {
+        if (table_add(&table, sample) != 0) {
+            result = PQC_ERROR_INSUFFICIENT_MEMORY;
+            break;
+        }
+    }
+
+    uint64_t written = 0;
+    for (size_t i = 0; i < table.capacity; i++) {
+        const folded_entry_t *e = &table.entries[i];
+        if (!e->hash) {
+            continue;
+        }
+        fputs(e->op ? e->op : "untagged", out);
+        if (e->phase) {
+            fprintf(out, "/%s", e->phase);
+        }
+        for (uint32_t f = e->depth; f-- > 0;) {
+            fputc(';', out);
+            write_frame(out, e->frames[f]);
+        }
+        fprintf(out, " %llu\n", (unsigned long long)e->count);
+        written += e->count;
+    }
+    atomic_fetch_add(&g_written, written);
+
+    free(table.entries);
+    free(sample);
+    return result;
+}
+
+void pqc_profile_get_stats(pqc_profile_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+    stats->samples = atomic_load(&g_samples);
+    stats->dropped = atomic_load(&g_dropped);
+    stats->written = atomic_load(&g_written);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file pqc_profile.h
+ * @brief Timer-based sampling profiler with operation/phase tags
+ *
+ * Each profiled thread gets a CPU-time timer that delivers SIGPROF to that
+ * thread. The handler walks the frame-pointer chain, tags the sample with
+ * the innermost operation and phase open on the thread (for example
+ * "dilithium_sign/expand_matrix") and pushes it into a lock-free bounded
+ * buffer; when the buffer is full the sample is dropped and counted.
+ * pqc_profile_write_folded() drains the buffer and writes folded stacks
+ * ("tag;outer;...;inner count") for flamegraph.pl or speedscope.
+ *
+ * Tags come from the existing instrumentation points: PQC_TRACE_OP_ENTRY /
+ * PQC_TRACE_OP_RETURN name the operation, PQC_PERF_PHASE_BEGIN/END and
+ * the attestation phase probes name the phase. They are only recorded when
+ * the library is built with PQC_ENABLE_PROFILING; that build profile must
+ * also keep frame pointers (-fno-omit-frame-pointer), otherwise stacks are
+ * truncated to the sampled function.
+ *
+ * Frames are symbolized with dladdr(), so static functions show up as
+ * "module+0xoffset" unless the binary is linked with symbols exported.
+ */
+
+#ifndef PQC_PROFILE_H
+#define PQC_PROFILE_H
+
+#include "pqc_common.h"
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+#define PQC_PROFILE_DEFAULT_HZ      99      /**< Default samples per CPU-second */
+#define PQC_PROFILE_MAX_FRAMES      48      /**< Frames recorded per sample */
+#define PQC_PROFILE_MAX_TAG_DEPTH   8       /**< Nested operations/phases tracked */
+
+#ifndef PQC_PROFILE_BUFFER_SAMPLES
+#define PQC_PROFILE_BUFFER_SAMPLES  4096    /**< Sample buffer slots (power of two) */
+#endif
+
+// ============================================================================
+// Tag Hooks
+// ============================================================================
+
+#ifdef PQC_ENABLE_PROFILING
+#define PQC_PROFILE_OP_PUSH(op)         pqc_profile_op_push(op)
+#define PQC_PROFILE_OP_POP()            pqc_profile_op_pop()
+#define PQC_PROFILE_PHASE_PUSH(phase)   pqc_profile_phase_push(phase)
+#define PQC_PROFILE_PHASE_POP()         pqc_profile_phase_pop()
+#else
+#define PQC_PROFILE_OP_PUSH(op)         ((void)0)
+#define PQC_PROFILE_OP_POP()            ((void)0)
+#define PQC_PROFILE_PHASE_PUSH(phase)   ((void)0)
+#define PQC_PROFILE_PHASE_POP()         ((void)0)
+#endif
+
+/**
+ * @brief Profiler counters
+ */
+typedef struct {
+    uint64_t samples;                   /**< Samples taken */
+    uint64_t dropped;                   /**< Samples lost to a full buffer */
+    uint64_t written;                   /**< Samples written as folded stacks */
+} pqc_profile_stats_t;
+
+// ============================================================================
+// Control
+// ============================================================================
+
+/**
+ * @brief Install the SIGPROF handler and allocate the sample buffer
+ *
+ * @param[in] hz Samples per CPU-second per thread (0 for the default)
+ * @return PQC_SUCCESS on success, error code on failure
+ */
+pqc_result_t pqc_profile_start(unsigned hz);
+
+/**
+ * @brief Stop sampling and disarm the calling thread's timer
+ *
+ * Other threads should call pqc_profile_thread_stop(); until then their
+ * signals are ignored by the handler, which stays installed. Samples
+ * still in the buffer remain available to pqc_profile_write_folded().
+ */
+void pqc_profile_stop(void);
+
+/**
+ * @brief Start sampling the calling thread
+ *
+ * @return PQC_SUCCESS on success, PQC_ERROR_NOT_IMPLEMENTED where per-thread
+ *         CPU-time timers are unavailable, error code on failure
+ */
+pqc_result_t pqc_profile_thread_start(void);
+
+/**
+ * @brief Stop sampling the calling thread
+ */
+void pqc_profile_thread_stop(void);
+
+/**
+ * @brief Drain the sample buffer and write folded stacks
+ *
+ * Identical stacks are merged; each line is
+ * "op/phase;frame;...;frame count" with the outermost frame first.
+ * Safe to call periodically from a background thread while sampling.
+ *
+ * @param[in] out Output stream
+ * @return PQC_SUCCESS on success, error code on failure
+ */
+pqc_result_t pqc_profile_write_folded(FILE *out);
+
+/**
+ * @brief Get profiler counters
+ *
+ * @param[out] stats Counters
+ */
+void pqc_profile_get_stats(pqc_profile_stats_t *stats);
+
+// ============================================================================
+// Tags
+// ============================================================================
+
+/**
+ * @brief Enter an operation on the calling thread
+ *
+ * @param[in] op Operation name (string literal)
+ */
+void pqc_profile_op_push(const char *op);
+
+/**
+ * @brief Leave the innermost operation on the calling thread
+ */
+void pqc_profile_op_pop(void);
+
+/**
+ * @brief Enter a phase on the calling thread
+ *
+ * @param[in] phase Phase name (string literal)
+ */
+void pqc_profile_phase_push(const char *phase);
+
+/**
+ * @brief Leave the innermost phase on the calling thread
+ */
+void pqc_profile_phase_pop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PQC_PROFILE_H */
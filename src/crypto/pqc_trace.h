@@ -0,0 +1,77 @@
+/**
+ * @file pqc_trace.h
+ * @brief USDT static tracepoints for crypto and attestation hot paths
+ *
+ * Probes use the SystemTap/DTrace sys/sdt.h convention under the provider
+ * "pqc". When no tracer is attached a probe site is a single NOP plus a
+ * note in the ELF file, so they are compiled in whenever sys/sdt.h is
+ * available. Define PQC_DISABLE_USDT to remove them entirely.
+ *
+ * Probes (argument order as listed):
+ *   pqc:op_entry            (const char *op, size_t input_bytes)
+ *   pqc:op_return           (const char *op, int result, size_t output_bytes)
+ *   pqc:keccak_entry        (const char *variant, size_t inlen, size_t outlen)
+ *   pqc:keccak_return       (const char *variant, int result)
+ *   pqc:attest_phase_entry  (const char *phase)
+ *   pqc:attest_phase_return (const char *phase, int result)
+ *   pqc:tpm_cmd_entry       (const char *command, size_t size)
+ *   pqc:tpm_cmd_return      (const char *command, int result)
+ *
+ * result is a pqc_result_t, except for attest_phase_return in
+ * attestation_verify_report where it is the attestation_error_t that
+ * rejected the report (ATTESTATION_ERROR_NONE when the phase passed).
+ *
+ * See scripts/bpftrace/ for latency histogram scripts built on these.
+ *
+ * The op and attestation phase helpers also set the sampling profiler's
+ * tags when built with PQC_ENABLE_PROFILING (see pqc_profile.h).
+ */
+
+#ifndef PQC_TRACE_H
+#define PQC_TRACE_H
+
+#include <stddef.h>
+#include "pqc_profile.h"
+
+#if !defined(PQC_DISABLE_USDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define PQC_USDT_ENABLED 1
+#endif
+#endif
+
+#ifdef PQC_USDT_ENABLED
+#define PQC_TRACE1(name, a)             DTRACE_PROBE1(pqc, name, a)
+#define PQC_TRACE2(name, a, b)          DTRACE_PROBE2(pqc, name, a, b)
+#define PQC_TRACE3(name, a, b, c)       DTRACE_PROBE3(pqc, name, a, b, c)
+#else
+#define PQC_TRACE1(name, a)             ((void)0)
+#define PQC_TRACE2(name, a, b)          ((void)0)
+#define PQC_TRACE3(name, a, b, c)       ((void)0)
+#endif
+
+// ============================================================================
+// Probe Helpers
+// ============================================================================
+
+#define PQC_TRACE_OP_ENTRY(op, in_bytes) \
+    do { PQC_PROFILE_OP_PUSH(op); PQC_TRACE2(op_entry, op, (size_t)(in_bytes)); } while (0)
+#define PQC_TRACE_OP_RETURN(op, result, out_bytes) \
+    do { PQC_TRACE3(op_return, op, (int)(result), (size_t)(out_bytes)); PQC_PROFILE_OP_POP(); } while (0)
+
+#define PQC_TRACE_KECCAK_ENTRY(variant, inlen, outlen) \
+    PQC_TRACE3(keccak_entry, variant, (size_t)(inlen), (size_t)(outlen))
+#define PQC_TRACE_KECCAK_RETURN(variant, result) \
+    PQC_TRACE2(keccak_return, variant, (int)(result))
+
+#define PQC_TRACE_ATTEST_PHASE_ENTRY(phase) \
+    do { PQC_PROFILE_PHASE_PUSH(phase); PQC_TRACE1(attest_phase_entry, phase); } while (0)
+#define PQC_TRACE_ATTEST_PHASE_RETURN(phase, result) \
+    do { PQC_TRACE2(attest_phase_return, phase, (int)(result)); PQC_PROFILE_PHASE_POP(); } while (0)
+
+#define PQC_TRACE_TPM_ENTRY(command, size) \
+    PQC_TRACE2(tpm_cmd_entry, command, (size_t)(size))
+#define PQC_TRACE_TPM_RETURN(command, result) \
+    PQC_TRACE2(tpm_cmd_return, command, (int)(result))
+
+#endif /* PQC_TRACE_H */
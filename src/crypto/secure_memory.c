@@ -4,6 +4,7 @@
  */
 
 #include "secure_memory.h"
+#include "pqc_bytes.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -34,6 +35,7 @@ void secure_memzero(void *ptr, size_t length) {
     if (!ptr || length == 0) {
         return;
     }
+    PQC_BYTES_COUNT(PQC_BYTES_ZEROED, length);
     
     volatile uint8_t *p = (volatile uint8_t *)ptr;
     for (size_t i = 0; i < length; i++) {
@@ -48,6 +50,7 @@ void secure_memcpy(void *dest, const void *src, size_t length) {
     if (!dest || !src || length == 0) {
         return;
     }
+    PQC_BYTES_COUNT(PQC_BYTES_COPIED, length);
     
     uint8_t *d = (uint8_t *)dest;
     const uint8_t *s = (const uint8_t *)src;
@@ -61,6 +64,7 @@ void secure_memcpy_conditional(void *dest, const void *src, size_t length, int c
     if (!dest || !src || length == 0) {
         return;
     }
+    PQC_BYTES_COUNT(PQC_BYTES_COPIED, length);
     
     uint8_t *d = (uint8_t *)dest;
     const uint8_t *s = (const uint8_t *)src;
@@ -78,6 +82,7 @@ void* secure_malloc(size_t size) {
     
     void *ptr = malloc(size);
     if (ptr) {
+        PQC_BYTES_COUNT(PQC_BYTES_ALLOCATED, size);
         g_allocated_bytes += size;
         g_allocation_count++;
         if (g_allocated_bytes > g_peak_allocated_bytes) {
@@ -121,6 +126,7 @@ void* secure_aligned_malloc(size_t size, size_t alignment) {
     // Store original pointer
     ((void**)aligned_ptr)[-1] = raw;
     
+    PQC_BYTES_COUNT(PQC_BYTES_ALLOCATED, size);
     g_allocated_bytes += size;
     g_allocation_count++;
     if (g_allocated_bytes > g_peak_allocated_bytes) {
@@ -0,0 +1,665 @@
+/**
+ * @file sha2.c
+ * @brief SHA-256 and SHA-512 implementations
+ *
+ * The SHA-256 compression function has three backends: portable C, the
+ * x86 SHA extensions (one block at a time, about 2 cycles/byte) and an
+ * eight-lane AVX2 implementation that runs eight independent messages in
+ * the 32-bit lanes of the ymm registers. Dispatch is resolved once, on the
+ * first call, from CPUID.
+ */
+
+#include "sha2.h"
+#include "pqc_bytes.h"
+#include "secure_memory.h"
+#include <string.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SHA2_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t sha256_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const uint64_t sha512_k[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+static const uint64_t sha512_iv[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static inline uint32_t load_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline void store_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static inline uint64_t load_be64(const uint8_t *p) {
+    return ((uint64_t)load_be32(p) << 32) | load_be32(p + 4);
+}
+
+static inline void store_be64(uint8_t *p, uint64_t v) {
+    store_be32(p, (uint32_t)(v >> 32));
+    store_be32(p + 4, (uint32_t)v);
+}
+
+static inline uint32_t ror32(uint32_t x, unsigned n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+static inline uint64_t ror64(uint64_t x, unsigned n) {
+    return (x >> n) | (x << (64 - n));
+}
+
+// ============================================================================
+// Generic SHA-256 Compression
+// ============================================================================
+
+static void sha256_compress_generic(uint32_t state[8], const uint8_t *blocks, size_t nblocks) {
+    uint32_t w[16];
+
+    while (nblocks--) {
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int t = 0; t < 16; t++) {
+            w[t] = load_be32(blocks + 4 * t);
+        }
+        for (int t = 0; t < 64; t++) {
+            uint32_t wt = w[t & 15];
+            if (t >= 16) {
+                uint32_t w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15];
+                uint32_t s0 = ror32(w15, 7) ^ ror32(w15, 18) ^ (w15 >> 3);
+                uint32_t s1 = ror32(w2, 17) ^ ror32(w2, 19) ^ (w2 >> 10);
+                wt = w[t & 15] = wt + s0 + w[(t - 7) & 15] + s1;
+            }
+            uint32_t t1 = h + (ror32(e, 6) ^ ror32(e, 11) ^ ror32(e, 25))
+                          + ((e & f) ^ (~e & g)) + sha256_k[t] + wt;
+            uint32_t t2 = (ror32(a, 2) ^ ror32(a, 13) ^ ror32(a, 22))
+                          + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+        blocks += SHA256_BLOCK_BYTES;
+    }
+}
+
+static void sha256_compress_x8_serial(uint32_t states[SHA256_LANES][8],
+                                      const uint8_t *const blocks[SHA256_LANES]);
+
+#ifdef SHA2_X86
+
+// ============================================================================
+// SHA-NI Compression
+// ============================================================================
+
+__attribute__((target("sha,sse4.1")))
+static void sha256_compress_shani(uint32_t state[8], const uint8_t *blocks, size_t nblocks) {
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // The SHA instructions want the state as ABEF / CDGH
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]), 0xB1);
+    __m128i st1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[4]), 0x1B);
+    __m128i st0 = _mm_alignr_epi8(tmp, st1, 8);
+    st1 = _mm_blend_epi16(st1, tmp, 0xF0);
+
+    while (nblocks--) {
+        __m128i abef = st0, cdgh = st1;
+        __m128i m[4];
+
+        // 16 groups of four rounds; msg1/msg2 extend the schedule four
+        // words at a time, three groups ahead of its use
+#pragma GCC unroll 16
+        for (int g = 0; g < 16; g++) {
+            if (g < 4) {
+                m[g] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 16 * g)), bswap);
+            }
+            __m128i msg = _mm_add_epi32(m[g & 3], _mm_loadu_si128((const __m128i *)&sha256_k[4 * g]));
+            st1 = _mm_sha256rnds2_epu32(st1, st0, msg);
+            if (g >= 3 && g <= 14) {
+                __m128i t = _mm_alignr_epi8(m[g & 3], m[(g + 3) & 3], 4);
+                m[(g + 1) & 3] = _mm_add_epi32(m[(g + 1) & 3], t);
+                m[(g + 1) & 3] = _mm_sha256msg2_epu32(m[(g + 1) & 3], m[g & 3]);
+            }
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            st0 = _mm_sha256rnds2_epu32(st0, st1, msg);
+            if (g >= 1 && g <= 12) {
+                m[(g + 3) & 3] = _mm_sha256msg1_epu32(m[(g + 3) & 3], m[g & 3]);
+            }
+        }
+
+        st0 = _mm_add_epi32(st0, abef);
+        st1 = _mm_add_epi32(st1, cdgh);
+        blocks += SHA256_BLOCK_BYTES;
+    }
+
+    tmp = _mm_shuffle_epi32(st0, 0x1B);
+    st1 = _mm_shuffle_epi32(st1, 0xB1);
+    _mm_storeu_si128((__m128i *)&state[0], _mm_blend_epi16(tmp, st1, 0xF0));
+    _mm_storeu_si128((__m128i *)&state[4], _mm_alignr_epi8(st1, tmp, 8));
+}
+
+static void sha256_compress_x8_shani(uint32_t states[SHA256_LANES][8],
+                                     const uint8_t *const blocks[SHA256_LANES]) {
+    for (int i = 0; i < SHA256_LANES; i++) {
+        sha256_compress_shani(states[i], blocks[i], 1);
+    }
+}
+
+// ============================================================================
+// AVX2 Eight-Lane Compression
+// ============================================================================
+
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+AVX2_TARGET static inline __m256i v_ror(__m256i x, int n) {
+    return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+/**
+ * @brief 8x8 transpose of 32-bit words: row i of the output holds word i
+ * of every input row
+ */
+AVX2_TARGET static inline void v_transpose8(__m256i r[8]) {
+    __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+    __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+    __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+    __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+    __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+    r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+AVX2_TARGET
+static void sha256_compress_x8_avx2(uint32_t states[SHA256_LANES][8],
+                                    const uint8_t *const blocks[SHA256_LANES]) {
+    const __m256i bswap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                          12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m256i s[8], w[16];
+
+    for (int i = 0; i < 8; i++) {
+        s[i] = _mm256_loadu_si256((const __m256i *)states[i]);
+    }
+    v_transpose8(s);
+
+    for (int half = 0; half < 2; half++) {
+        __m256i *r = w + 8 * half;
+        for (int i = 0; i < 8; i++) {
+            r[i] = _mm256_loadu_si256((const __m256i *)(blocks[i] + 32 * half));
+        }
+        v_transpose8(r);
+        for (int i = 0; i < 8; i++) {
+            r[i] = _mm256_shuffle_epi8(r[i], bswap);
+        }
+    }
+
+    __m256i a = s[0], b = s[1], c = s[2], d = s[3];
+    __m256i e = s[4], f = s[5], g = s[6], h = s[7];
+
+    for (int t = 0; t < 64; t++) {
+        __m256i wt;
+        if (t < 16) {
+            wt = w[t];
+        } else {
+            __m256i w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15];
+            __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(v_ror(w15, 7), v_ror(w15, 18)),
+                                          _mm256_srli_epi32(w15, 3));
+            __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(v_ror(w2, 17), v_ror(w2, 19)),
+                                          _mm256_srli_epi32(w2, 10));
+            wt = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0),
+                                  _mm256_add_epi32(w[(t - 7) & 15], s1));
+            w[t & 15] = wt;
+        }
+        __m256i S1 = _mm256_xor_si256(_mm256_xor_si256(v_ror(e, 6), v_ror(e, 11)), v_ror(e, 25));
+        __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, S1),
+                                      _mm256_add_epi32(ch, _mm256_add_epi32(
+                                          _mm256_set1_epi32((int)sha256_k[t]), wt)));
+        __m256i S0 = _mm256_xor_si256(_mm256_xor_si256(v_ror(a, 2), v_ror(a, 13)), v_ror(a, 22));
+        __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b),
+                                      _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, _mm256_add_epi32(S0, maj));
+    }
+
+    s[0] = _mm256_add_epi32(s[0], a);
+    s[1] = _mm256_add_epi32(s[1], b);
+    s[2] = _mm256_add_epi32(s[2], c);
+    s[3] = _mm256_add_epi32(s[3], d);
+    s[4] = _mm256_add_epi32(s[4], e);
+    s[5] = _mm256_add_epi32(s[5], f);
+    s[6] = _mm256_add_epi32(s[6], g);
+    s[7] = _mm256_add_epi32(s[7], h);
+    v_transpose8(s);
+    for (int i = 0; i < 8; i++) {
+        _mm256_storeu_si256((__m256i *)states[i], s[i]);
+    }
+}
+
+// ============================================================================
+// CPU Feature Detection
+// ============================================================================
+
+static bool cpu_has_shani(void) {
+    unsigned int a, b, c, d;
+    if (!__get_cpuid(1, &a, &b, &c, &d) || !(c & bit_SSE4_1) || !(c & bit_SSSE3)) {
+        return false;
+    }
+    if (!__get_cpuid_count(7, 0, &a, &b, &c, &d)) {
+        return false;
+    }
+    return (b & bit_SHA) != 0;
+}
+
+static bool cpu_has_avx2(void) {
+    unsigned int a, b, c, d;
+    if (!__get_cpuid(1, &a, &b, &c, &d) || !(c & bit_OSXSAVE) || !(c & bit_AVX)) {
+        return false;
+    }
+    // The OS must save the ymm registers
+    uint32_t xcr0_lo, xcr0_hi;
+    __asm__ volatile ("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    if ((xcr0_lo & 0x6) != 0x6) {
+        return false;
+    }
+    if (!__get_cpuid_count(7, 0, &a, &b, &c, &d)) {
+        return false;
+    }
+    return (b & bit_AVX2) != 0;
+}
+
+#else
+
+static bool cpu_has_shani(void) {
+    return false;
+}
+
+static bool cpu_has_avx2(void) {
+    return false;
+}
+
+#endif /* SHA2_X86 */
+
+static void sha256_compress_x8_serial(uint32_t states[SHA256_LANES][8],
+                                      const uint8_t *const blocks[SHA256_LANES]) {
+    for (int i = 0; i < SHA256_LANES; i++) {
+        sha256_compress_generic(states[i], blocks[i], 1);
+    }
+}
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+typedef void (*sha256_compress_fn)(uint32_t state[8], const uint8_t *blocks, size_t nblocks);
+typedef void (*sha256_compress_x8_fn)(uint32_t states[SHA256_LANES][8],
+                                      const uint8_t *const blocks[SHA256_LANES]);
+
+static pthread_once_t g_sha2_once = PTHREAD_ONCE_INIT;
+static bool g_has_shani;
+static bool g_has_avx2;
+static sha256_backend_t g_backend = SHA256_BACKEND_GENERIC;
+static sha256_backend_t g_backend_x8 = SHA256_BACKEND_GENERIC;
+static sha256_compress_fn g_compress = sha256_compress_generic;
+static sha256_compress_x8_fn g_compress_x8 = sha256_compress_x8_serial;
+
+static void sha2_select(sha256_backend_t single, sha256_backend_t x8) {
+    g_backend = SHA256_BACKEND_GENERIC;
+    g_compress = sha256_compress_generic;
+    g_backend_x8 = SHA256_BACKEND_GENERIC;
+    g_compress_x8 = sha256_compress_x8_serial;
+#ifdef SHA2_X86
+    if (single == SHA256_BACKEND_SHANI && g_has_shani) {
+        g_backend = SHA256_BACKEND_SHANI;
+        g_compress = sha256_compress_shani;
+    }
+    if (x8 == SHA256_BACKEND_SHANI && g_has_shani) {
+        g_backend_x8 = SHA256_BACKEND_SHANI;
+        g_compress_x8 = sha256_compress_x8_shani;
+    } else if (x8 == SHA256_BACKEND_AVX2 && g_has_avx2) {
+        g_backend_x8 = SHA256_BACKEND_AVX2;
+        g_compress_x8 = sha256_compress_x8_avx2;
+    }
+#else
+    (void)single;
+    (void)x8;
+#endif
+}
+
+static void sha2_detect(void) {
+    g_has_shani = cpu_has_shani();
+    g_has_avx2 = cpu_has_avx2();
+
+    // Where both exist, SHA-NI's dedicated round unit beats eight AVX2
+    // lanes of generic integer code, even one message at a time
+    sha2_select(SHA256_BACKEND_SHANI, g_has_shani ? SHA256_BACKEND_SHANI : SHA256_BACKEND_AVX2);
+}
+
+static inline void sha2_init_dispatch(void) {
+    pthread_once(&g_sha2_once, sha2_detect);
+}
+
+void sha256_compress(uint32_t state[8], const uint8_t *blocks, size_t nblocks) {
+    sha2_init_dispatch();
+    g_compress(state, blocks, nblocks);
+}
+
+void sha256_compress_x8(uint32_t states[SHA256_LANES][8],
+                        const uint8_t *const blocks[SHA256_LANES]) {
+    sha2_init_dispatch();
+    g_compress_x8(states, blocks);
+}
+
+sha256_backend_t sha256_backend(void) {
+    sha2_init_dispatch();
+    return g_backend;
+}
+
+sha256_backend_t sha256_backend_x8(void) {
+    sha2_init_dispatch();
+    return g_backend_x8;
+}
+
+const char *sha256_backend_name(void) {
+    static const char *const names[3][3] = {
+        { "generic / generic", "generic / sha-ni", "generic / avx2x8" },
+        { "sha-ni / generic", "sha-ni / sha-ni", "sha-ni / avx2x8" },
+        { "generic / generic", "generic / sha-ni", "generic / avx2x8" }
+    };
+    sha2_init_dispatch();
+    return names[g_backend][g_backend_x8];
+}
+
+bool sha2_cpu_has_shani(void) {
+    sha2_init_dispatch();
+    return g_has_shani;
+}
+
+bool sha2_cpu_has_avx2(void) {
+    sha2_init_dispatch();
+    return g_has_avx2;
+}
+
+#ifdef PQC_ENABLE_TESTING
+void sha256_set_backends(sha256_backend_t single, sha256_backend_t x8) {
+    sha2_init_dispatch();
+    sha2_select(single, x8);
+}
+#endif
+
+// ============================================================================
+// SHA-256
+// ============================================================================
+
+void sha256_init(sha256_ctx_t *ctx) {
+    memcpy(ctx->h, sha256_iv, sizeof(ctx->h));
+    ctx->count = 0;
+    ctx->buflen = 0;
+}
+
+void sha256_update(sha256_ctx_t *ctx, const uint8_t *input, size_t inlen) {
+    sha2_init_dispatch();
+    ctx->count += inlen;
+
+    if (ctx->buflen > 0) {
+        size_t take = SHA256_BLOCK_BYTES - ctx->buflen;
+        if (take > inlen) {
+            take = inlen;
+        }
+        memcpy(ctx->buf + ctx->buflen, input, take);
+        ctx->buflen += take;
+        input += take;
+        inlen -= take;
+        if (ctx->buflen < SHA256_BLOCK_BYTES) {
+            return;
+        }
+        g_compress(ctx->h, ctx->buf, 1);
+        ctx->buflen = 0;
+    }
+
+    size_t nblocks = inlen / SHA256_BLOCK_BYTES;
+    if (nblocks > 0) {
+        g_compress(ctx->h, input, nblocks);
+        input += nblocks * SHA256_BLOCK_BYTES;
+        inlen -= nblocks * SHA256_BLOCK_BYTES;
+    }
+    memcpy(ctx->buf, input, inlen);
+    ctx->buflen = inlen;
+}
+
+void sha256_final(sha256_ctx_t *ctx, uint8_t hash[SHA256_DIGEST_BYTES]) {
+    sha2_init_dispatch();
+    uint64_t bits = ctx->count * 8;
+    size_t len = ctx->buflen;
+
+    ctx->buf[len++] = 0x80;
+    if (len > SHA256_BLOCK_BYTES - 8) {
+        memset(ctx->buf + len, 0, SHA256_BLOCK_BYTES - len);
+        g_compress(ctx->h, ctx->buf, 1);
+        len = 0;
+    }
+    memset(ctx->buf + len, 0, SHA256_BLOCK_BYTES - 8 - len);
+    store_be64(ctx->buf + SHA256_BLOCK_BYTES - 8, bits);
+    g_compress(ctx->h, ctx->buf, 1);
+
+    for (int i = 0; i < 8; i++) {
+        store_be32(hash + 4 * i, ctx->h[i]);
+    }
+    secure_memzero(ctx, sizeof(*ctx));
+}
+
+pqc_result_t sha256(uint8_t hash[SHA256_DIGEST_BYTES], const uint8_t *input, size_t inlen) {
+    if (!hash || (!input && inlen)) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    PQC_BYTES_COUNT(PQC_BYTES_HASHED, inlen);
+
+    sha256_ctx_t ctx;
+    sha256_init(&ctx);
+    sha256_update(&ctx, input, inlen);
+    sha256_final(&ctx, hash);
+    return PQC_SUCCESS;
+}
+
+// ============================================================================
+// SHA-512
+// ============================================================================
+
+static void sha512_compress(uint64_t state[8], const uint8_t *blocks, size_t nblocks) {
+    uint64_t w[16];
+
+    while (nblocks--) {
+        uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int t = 0; t < 80; t++) {
+            uint64_t wt;
+            if (t < 16) {
+                wt = w[t] = load_be64(blocks + 8 * t);
+            } else {
+                uint64_t w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15];
+                uint64_t s0 = ror64(w15, 1) ^ ror64(w15, 8) ^ (w15 >> 7);
+                uint64_t s1 = ror64(w2, 19) ^ ror64(w2, 61) ^ (w2 >> 6);
+                wt = w[t & 15] = w[t & 15] + s0 + w[(t - 7) & 15] + s1;
+            }
+            uint64_t t1 = h + (ror64(e, 14) ^ ror64(e, 18) ^ ror64(e, 41))
+                          + ((e & f) ^ (~e & g)) + sha512_k[t] + wt;
+            uint64_t t2 = (ror64(a, 28) ^ ror64(a, 34) ^ ror64(a, 39))
+                          + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+        blocks += SHA512_BLOCK_BYTES;
+    }
+}
+
+void sha512_init(sha512_ctx_t *ctx) {
+    memcpy(ctx->h, sha512_iv, sizeof(ctx->h));
+    ctx->count = 0;
+    ctx->buflen = 0;
+}
+
+void sha512_update(sha512_ctx_t *ctx, const uint8_t *input, size_t inlen) {
+    ctx->count += inlen;
+
+    if (ctx->buflen > 0) {
+        size_t take = SHA512_BLOCK_BYTES - ctx->buflen;
+        if (take > inlen) {
+            take = inlen;
+        }
+        memcpy(ctx->buf + ctx->buflen, input, take);
+        ctx->buflen += take;
+        input += take;
+        inlen -= take;
+        if (ctx->buflen < SHA512_BLOCK_BYTES) {
+            return;
+        }
+        sha512_compress(ctx->h, ctx->buf, 1);
+        ctx->buflen = 0;
+    }
+
+    size_t nblocks = inlen / SHA512_BLOCK_BYTES;
+    if (nblocks > 0) {
+        sha512_compress(ctx->h, input, nblocks);
+        input += nblocks * SHA512_BLOCK_BYTES;
+        inlen -= nblocks * SHA512_BLOCK_BYTES;
+    }
+    memcpy(ctx->buf, input, inlen);
+    ctx->buflen = inlen;
+}
+
+void sha512_final(sha512_ctx_t *ctx, uint8_t hash[SHA512_DIGEST_BYTES]) {
+    size_t len = ctx->buflen;
+
+    // 128-bit length field; the high half is always zero here
+    ctx->buf[len++] = 0x80;
+    if (len > SHA512_BLOCK_BYTES - 16) {
+        memset(ctx->buf + len, 0, SHA512_BLOCK_BYTES - len);
+        sha512_compress(ctx->h, ctx->buf, 1);
+        len = 0;
+    }
+    memset(ctx->buf + len, 0, SHA512_BLOCK_BYTES - 8 - len);
+    store_be64(ctx->buf + SHA512_BLOCK_BYTES - 8, ctx->count * 8);
+    sha512_compress(ctx->h, ctx->buf, 1);
+
+    for (int i = 0; i < 8; i++) {
+        store_be64(hash + 8 * i, ctx->h[i]);
+    }
+    secure_memzero(ctx, sizeof(*ctx));
+}
+
+pqc_result_t sha512(uint8_t hash[SHA512_DIGEST_BYTES], const uint8_t *input, size_t inlen) {
+    if (!hash || (!input && inlen)) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    PQC_BYTES_COUNT(PQC_BYTES_HASHED, inlen);
+
+    sha512_ctx_t ctx;
+    sha512_init(&ctx);
+    sha512_update(&ctx, input, inlen);
+    sha512_final(&ctx, hash);
+    return PQC_SUCCESS;
+}
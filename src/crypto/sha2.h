@@ -0,0 +1,152 @@
+/**
+ * @file sha2.h
+ * @brief SHA-256 and SHA-512 with multi-buffer compression
+ *
+ * Besides the usual one-shot and incremental interfaces, SHA-256 exposes
+ * its compression function directly, including an eight-lane variant that
+ * compresses one block for each of eight independent states. Hash-based
+ * signatures spend almost all of their time in millions of such
+ * single-block hashes, and the multi-buffer entry point is what lets them
+ * use the SIMD units.
+ *
+ * The backend is picked once at runtime from the CPU features: SHA-NI for
+ * single-buffer compression and, for the eight-lane variant, whichever of
+ * SHA-NI or AVX2 is faster on that CPU class. Other platforms use the
+ * portable implementation.
+ */
+
+#ifndef SHA2_H
+#define SHA2_H
+
+#include "pqc_common.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SHA256_BLOCK_BYTES      64
+#define SHA256_DIGEST_BYTES     32
+#define SHA512_BLOCK_BYTES      128
+#define SHA512_DIGEST_BYTES     64
+
+#define SHA256_LANES            8       /**< Lanes of sha256_compress_x8() */
+
+/**
+ * @brief Incremental SHA-256 state
+ *
+ * May be copied to fork a hash after a common prefix.
+ */
+typedef struct {
+    uint32_t h[8];
+    uint64_t count;                     /**< Bytes absorbed so far */
+    uint8_t buf[SHA256_BLOCK_BYTES];
+    size_t buflen;
+} sha256_ctx_t;
+
+/**
+ * @brief Incremental SHA-512 state
+ */
+typedef struct {
+    uint64_t h[8];
+    uint64_t count;
+    uint8_t buf[SHA512_BLOCK_BYTES];
+    size_t buflen;
+} sha512_ctx_t;
+
+/**
+ * @brief Compression backends
+ */
+typedef enum {
+    SHA256_BACKEND_GENERIC = 0,         /**< Portable C */
+    SHA256_BACKEND_SHANI = 1,           /**< x86 SHA extensions */
+    SHA256_BACKEND_AVX2 = 2             /**< 8-lane AVX2 (multi-buffer only) */
+} sha256_backend_t;
+
+// ============================================================================
+// SHA-256
+// ============================================================================
+
+void sha256_init(sha256_ctx_t *ctx);
+void sha256_update(sha256_ctx_t *ctx, const uint8_t *input, size_t inlen);
+void sha256_final(sha256_ctx_t *ctx, uint8_t hash[SHA256_DIGEST_BYTES]);
+
+/**
+ * @brief One-shot SHA-256
+ *
+ * @param[out] hash 32-byte digest
+ * @param[in] input Input data
+ * @param[in] inlen Input length
+ * @return PQC_SUCCESS on success, error code on failure
+ */
+pqc_result_t sha256(uint8_t hash[SHA256_DIGEST_BYTES], const uint8_t *input, size_t inlen);
+
+/**
+ * @brief Compress whole blocks into a SHA-256 chaining state
+ *
+ * @param[in,out] state Chaining value
+ * @param[in] blocks nblocks * 64 bytes
+ * @param[in] nblocks Number of blocks
+ */
+void sha256_compress(uint32_t state[8], const uint8_t *blocks, size_t nblocks);
+
+/**
+ * @brief Compress one block into each of eight independent chaining states
+ *
+ * @param[in,out] states Chaining values, one row per lane
+ * @param[in] blocks One 64-byte block per lane
+ */
+void sha256_compress_x8(uint32_t states[SHA256_LANES][8],
+                        const uint8_t *const blocks[SHA256_LANES]);
+
+/**
+ * @brief Backend used by sha256_compress() / sha256_compress_x8()
+ */
+sha256_backend_t sha256_backend(void);
+sha256_backend_t sha256_backend_x8(void);
+
+/**
+ * @brief Human-readable backend description, e.g. "sha-ni / avx2x8"
+ */
+const char *sha256_backend_name(void);
+
+// ============================================================================
+// SHA-512
+// ============================================================================
+
+void sha512_init(sha512_ctx_t *ctx);
+void sha512_update(sha512_ctx_t *ctx, const uint8_t *input, size_t inlen);
+void sha512_final(sha512_ctx_t *ctx, uint8_t hash[SHA512_DIGEST_BYTES]);
+
+/**
+ * @brief One-shot SHA-512
+ *
+ * @param[out] hash 64-byte digest
+ * @param[in] input Input data
+ * @param[in] inlen Input length
+ * @return PQC_SUCCESS on success, error code on failure
+ */
+pqc_result_t sha512(uint8_t hash[SHA512_DIGEST_BYTES], const uint8_t *input, size_t inlen);
+
+// ============================================================================
+// CPU Features
+// ============================================================================
+
+bool sha2_cpu_has_shani(void);
+bool sha2_cpu_has_avx2(void);
+
+#ifdef PQC_ENABLE_TESTING
+/**
+ * @brief Force the SHA-256 backends (testing only)
+ *
+ * Unsupported choices fall back to the generic code.
+ */
+void sha256_set_backends(sha256_backend_t single, sha256_backend_t x8);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHA2_H */
@@ -0,0 +1,1086 @@
+/**
+ * @file sphincs.c
+ * @brief SPHINCS+-SHA256-128f/256f-simple (round 3.1) implementation
+ *
+ * Almost every hash in SPHINCS+ is a single SHA-256 compression on top of
+ * the state that absorbed PK.seed: a 22-byte compressed address plus one
+ * or two n-byte values. Those are batched eight at a time through
+ * sha256_compress_x8(): the WOTS+ chains of a leaf advance in lockstep,
+ * FORS leaves are generated eight at a time and tree levels are reduced
+ * eight nodes at a time. Multi-block hashes (WOTS+ public key compression,
+ * FORS roots, and the SHA-512 based tree hashes of 256f) go through the
+ * incremental interface.
+ *
+ * All subtrees a signature needs - one per hypertree layer and one per
+ * FORS tree - are fixed by the message digest before any of them is
+ * computed, so signing hands them out on the shared executor (see
+ * pqc_executor.h) and only the cheap WOTS+ signatures that chain the
+ * layers together run serially.
+ */
+
+#include "sphincs.h"
+#include "sha2.h"
+#include "pqc_common.h"
+#include "pqc_bytes.h"
+#include "pqc_executor.h"
+#include "pqc_perf.h"
+#include "pqc_trace.h"
+#include "secure_memory.h"
+#include <string.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+// ============================================================================
+// Parameters
+// ============================================================================
+
+#define SPX_ADDR_BYTES          22      /**< Compressed address (SHA-2 instances) */
+#define SPX_MAX_N               32
+#define SPX_MAX_LEN             67
+#define SPX_MAX_K               35
+#define SPX_MAX_A               9
+#define SPX_MAX_D               22
+#define SPX_W                   16
+#define SPX_LEN2                3
+#define SPX_MAX_DGST_BYTES      49
+#define SPX_LANES               SHA256_LANES
+
+// Address types
+#define SPX_ADDR_WOTS           0
+#define SPX_ADDR_WOTSPK         1
+#define SPX_ADDR_HASHTREE       2
+#define SPX_ADDR_FORSTREE       3
+#define SPX_ADDR_FORSPK         4
+#define SPX_ADDR_WOTSPRF        5
+#define SPX_ADDR_FORSPRF        6
+
+/**
+ * @brief Parameter set
+ */
+typedef struct {
+    unsigned n;                         /**< Hash output bytes */
+    unsigned full_h;                    /**< Hypertree height */
+    unsigned d;                         /**< Hypertree layers */
+    unsigned hp;                        /**< Height of each XMSS tree */
+    unsigned a;                         /**< FORS tree height */
+    unsigned k;                         /**< FORS trees */
+    unsigned len;                       /**< WOTS+ chains */
+    bool sha512;                        /**< SHA-512 for H, T_l, H_msg, PRF_msg */
+    size_t pk_bytes;
+    size_t sk_bytes;
+    size_t sig_bytes;
+} spx_params_t;
+
+static const spx_params_t spx_128f = {
+    16, 66, 22, 3, 6, 33, 35, false,
+    SPHINCS_SHA256_128F_PUBLICKEYBYTES, SPHINCS_SHA256_128F_SECRETKEYBYTES,
+    SPHINCS_SHA256_128F_SIGNATUREBYTES
+};
+
+static const spx_params_t spx_256f = {
+    32, 68, 17, 4, 9, 35, 67, true,
+    SPHINCS_SHA256_256F_PUBLICKEYBYTES, SPHINCS_SHA256_256F_SECRETKEYBYTES,
+    SPHINCS_SHA256_256F_SIGNATUREBYTES
+};
+
+static inline size_t fors_bytes(const spx_params_t *p) {
+    return (size_t)(p->a + 1) * p->k * p->n;
+}
+
+static inline size_t wots_bytes(const spx_params_t *p) {
+    return (size_t)p->len * p->n;
+}
+
+static inline size_t layer_bytes(const spx_params_t *p) {
+    return wots_bytes(p) + (size_t)p->hp * p->n;
+}
+
+/**
+ * @brief Hashing context: seeds and the SHA-2 states after PK.seed
+ */
+typedef struct {
+    const spx_params_t *p;
+    uint8_t pub_seed[SPX_MAX_N];
+    uint8_t sk_seed[SPX_MAX_N];
+    sha256_ctx_t seeded256;             /**< PK.seed || 0^(64-n) absorbed */
+    sha512_ctx_t seeded512;             /**< PK.seed || 0^(128-n) absorbed */
+} spx_ctx_t;
+
+static atomic_uint g_sphincs_threads;   /**< 0: one per online CPU */
+
+// ============================================================================
+// Addresses
+// ============================================================================
+
+static inline void store_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static inline void set_layer(uint8_t *addr, uint32_t layer) {
+    addr[0] = (uint8_t)layer;
+}
+
+static inline void set_tree(uint8_t *addr, uint64_t tree) {
+    store_be32(addr + 1, (uint32_t)(tree >> 32));
+    store_be32(addr + 5, (uint32_t)tree);
+}
+
+static inline void set_type(uint8_t *addr, uint32_t type) {
+    addr[9] = (uint8_t)type;
+}
+
+static inline void set_keypair(uint8_t *addr, uint32_t keypair) {
+    store_be32(addr + 10, keypair);
+}
+
+static inline void set_chain(uint8_t *addr, uint32_t chain) {
+    store_be32(addr + 14, chain);
+}
+
+static inline void set_hash(uint8_t *addr, uint32_t hash) {
+    store_be32(addr + 18, hash);
+}
+
+static inline void set_tree_height(uint8_t *addr, uint32_t height) {
+    store_be32(addr + 14, height);
+}
+
+static inline void set_tree_index(uint8_t *addr, uint32_t index) {
+    store_be32(addr + 18, index);
+}
+
+/**
+ * @brief Copy layer and tree, clear everything else
+ */
+static inline void copy_subtree(uint8_t *out, const uint8_t *in) {
+    memset(out, 0, SPX_ADDR_BYTES);
+    memcpy(out, in, 9);
+}
+
+/**
+ * @brief Copy layer, tree and keypair, clear everything else
+ */
+static inline void copy_keypair(uint8_t *out, const uint8_t *in) {
+    copy_subtree(out, in);
+    memcpy(out + 10, in + 10, 4);
+}
+
+// ============================================================================
+// Tweakable Hash Functions
+// ============================================================================
+
+static void ctx_init(spx_ctx_t *ctx, const spx_params_t *p,
+                     const uint8_t *pub_seed, const uint8_t *sk_seed) {
+    uint8_t block[SHA512_BLOCK_BYTES] = { 0 };
+
+    ctx->p = p;
+    memcpy(ctx->pub_seed, pub_seed, p->n);
+    if (sk_seed) {
+        memcpy(ctx->sk_seed, sk_seed, p->n);
+    } else {
+        memset(ctx->sk_seed, 0, sizeof(ctx->sk_seed));
+    }
+
+    memcpy(block, pub_seed, p->n);
+    sha256_init(&ctx->seeded256);
+    sha256_update(&ctx->seeded256, block, SHA256_BLOCK_BYTES);
+    if (p->sha512) {
+        sha512_init(&ctx->seeded512);
+        sha512_update(&ctx->seeded512, block, SHA512_BLOCK_BYTES);
+    }
+}
+
+/**
+ * @brief T_l / F / H: hash of inblocks n-byte values under an address
+ */
+static void thash(uint8_t *out, const uint8_t *in, unsigned inblocks,
+                  const spx_ctx_t *ctx, const uint8_t *addr) {
+    const spx_params_t *p = ctx->p;
+
+    if (p->sha512 && inblocks > 1) {
+        uint8_t digest[SHA512_DIGEST_BYTES];
+        sha512_ctx_t s = ctx->seeded512;
+        sha512_update(&s, addr, SPX_ADDR_BYTES);
+        sha512_update(&s, in, (size_t)inblocks * p->n);
+        sha512_final(&s, digest);
+        memcpy(out, digest, p->n);
+    } else {
+        uint8_t digest[SHA256_DIGEST_BYTES];
+        sha256_ctx_t s = ctx->seeded256;
+        sha256_update(&s, addr, SPX_ADDR_BYTES);
+        sha256_update(&s, in, (size_t)inblocks * p->n);
+        sha256_final(&s, digest);
+        memcpy(out, digest, p->n);
+    }
+}
+
+/**
+ * @brief Up to eight single-block SHA-256 tweakable hashes
+ *
+ * Lane j computes out[j] = SHA-256(seed block || addr[j] || in[j]), inlen
+ * bytes of input, for each lane set in mask. out[j] may alias in[j].
+ * Partially filled batches are hashed one lane at a time unless the
+ * backend is a true SIMD one, where a lane costs the same as eight.
+ */
+static void thash_x8(uint8_t *const out[SPX_LANES], const uint8_t *const in[SPX_LANES],
+                     size_t inlen, const spx_ctx_t *ctx,
+                     const uint8_t addr[SPX_LANES][SPX_ADDR_BYTES], unsigned mask) {
+    uint8_t blocks[SPX_LANES][SHA256_BLOCK_BYTES];
+    uint32_t states[SPX_LANES][8];
+    const uint8_t *bp[SPX_LANES];
+    uint64_t bits = (uint64_t)(SHA256_BLOCK_BYTES + SPX_ADDR_BYTES + inlen) * 8;
+    unsigned n = ctx->p->n;
+
+    for (int j = 0; j < SPX_LANES; j++) {
+        bp[j] = blocks[j];
+        memcpy(states[j], ctx->seeded256.h, sizeof(states[j]));
+        if (!(mask & (1U << j))) {
+            memset(blocks[j], 0, SHA256_BLOCK_BYTES);
+            continue;
+        }
+        memcpy(blocks[j], addr[j], SPX_ADDR_BYTES);
+        memcpy(blocks[j] + SPX_ADDR_BYTES, in[j], inlen);
+        blocks[j][SPX_ADDR_BYTES + inlen] = 0x80;
+        memset(blocks[j] + SPX_ADDR_BYTES + inlen + 1, 0,
+               SHA256_BLOCK_BYTES - 8 - SPX_ADDR_BYTES - inlen - 1);
+        store_be32(blocks[j] + 56, (uint32_t)(bits >> 32));
+        store_be32(blocks[j] + 60, (uint32_t)bits);
+    }
+
+    if (mask == (1U << SPX_LANES) - 1 || sha256_backend_x8() == SHA256_BACKEND_AVX2) {
+        sha256_compress_x8(states, bp);
+    } else {
+        for (int j = 0; j < SPX_LANES; j++) {
+            if (mask & (1U << j)) {
+                sha256_compress(states[j], blocks[j], 1);
+            }
+        }
+    }
+
+    for (int j = 0; j < SPX_LANES; j++) {
+        if (mask & (1U << j)) {
+            for (unsigned i = 0; i < n / 4; i++) {
+                store_be32(out[j] + 4 * i, states[j][i]);
+            }
+        }
+    }
+    secure_memzero(blocks, sizeof(blocks));
+}
+
+/**
+ * @brief Whether H (two n-byte inputs) fits one SHA-256 block
+ */
+static inline bool h_is_single_block(const spx_params_t *p) {
+    return !p->sha512 && SPX_ADDR_BYTES + 2 * p->n + 9 <= SHA256_BLOCK_BYTES;
+}
+
+// ============================================================================
+// Message Hashing
+// ============================================================================
+
+/**
+ * @brief HMAC with SHA-256 or SHA-512, truncated to outlen bytes
+ */
+static void hmac(uint8_t *out, size_t outlen, bool use512, const uint8_t *key, size_t keylen,
+                 const uint8_t *m1, size_t m1len, const uint8_t *m2, size_t m2len) {
+    uint8_t pad[SHA512_BLOCK_BYTES];
+    uint8_t inner[SHA512_DIGEST_BYTES];
+    size_t block = use512 ? SHA512_BLOCK_BYTES : SHA256_BLOCK_BYTES;
+    size_t dlen = use512 ? SHA512_DIGEST_BYTES : SHA256_DIGEST_BYTES;
+
+    // Keys are at most n bytes, shorter than a block
+    memset(pad, 0x36, block);
+    for (size_t i = 0; i < keylen; i++) {
+        pad[i] ^= key[i];
+    }
+    if (use512) {
+        sha512_ctx_t s;
+        sha512_init(&s);
+        sha512_update(&s, pad, block);
+        sha512_update(&s, m1, m1len);
+        sha512_update(&s, m2, m2len);
+        sha512_final(&s, inner);
+    } else {
+        sha256_ctx_t s;
+        sha256_init(&s);
+        sha256_update(&s, pad, block);
+        sha256_update(&s, m1, m1len);
+        sha256_update(&s, m2, m2len);
+        sha256_final(&s, inner);
+    }
+
+    for (size_t i = 0; i < block; i++) {
+        pad[i] ^= 0x36 ^ 0x5c;
+    }
+    uint8_t digest[SHA512_DIGEST_BYTES];
+    if (use512) {
+        sha512_ctx_t s;
+        sha512_init(&s);
+        sha512_update(&s, pad, block);
+        sha512_update(&s, inner, dlen);
+        sha512_final(&s, digest);
+    } else {
+        sha256_ctx_t s;
+        sha256_init(&s);
+        sha256_update(&s, pad, block);
+        sha256_update(&s, inner, dlen);
+        sha256_final(&s, digest);
+    }
+    memcpy(out, digest, outlen);
+
+    secure_memzero(pad, sizeof(pad));
+    secure_memzero(inner, sizeof(inner));
+    secure_memzero(digest, sizeof(digest));
+}
+
+/**
+ * @brief MGF1 with SHA-256 or SHA-512
+ */
+static void mgf1(uint8_t *out, size_t outlen, bool use512, const uint8_t *seed, size_t seedlen) {
+    uint8_t digest[SHA512_DIGEST_BYTES];
+    uint8_t ctr[4];
+    size_t dlen = use512 ? SHA512_DIGEST_BYTES : SHA256_DIGEST_BYTES;
+
+    for (uint32_t c = 0; outlen > 0; c++) {
+        store_be32(ctr, c);
+        if (use512) {
+            sha512_ctx_t s;
+            sha512_init(&s);
+            sha512_update(&s, seed, seedlen);
+            sha512_update(&s, ctr, sizeof(ctr));
+            sha512_final(&s, digest);
+        } else {
+            sha256_ctx_t s;
+            sha256_init(&s);
+            sha256_update(&s, seed, seedlen);
+            sha256_update(&s, ctr, sizeof(ctr));
+            sha256_final(&s, digest);
+        }
+        size_t take = outlen < dlen ? outlen : dlen;
+        memcpy(out, digest, take);
+        out += take;
+        outlen -= take;
+    }
+}
+
+/**
+ * @brief Digest layout derived from the parameter set
+ */
+static void digest_layout(const spx_params_t *p, size_t *fors_msg, size_t *tree_bytes,
+                          size_t *leaf_bytes) {
+    *fors_msg = ((size_t)p->a * p->k + 7) / 8;
+    *tree_bytes = (p->full_h - p->hp + 7) / 8;
+    *leaf_bytes = (p->hp + 7) / 8;
+}
+
+static uint64_t bytes_to_u64(const uint8_t *in, size_t len) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < len; i++) {
+        v = (v << 8) | in[i];
+    }
+    return v;
+}
+
+/**
+ * @brief H_msg: FORS message, hypertree tree index and leaf index
+ */
+static void hash_message(uint8_t *mhash, uint64_t *tree, uint32_t *leaf, const spx_params_t *p,
+                         const uint8_t *R, const uint8_t *pk,
+                         const uint8_t *message, size_t msglen) {
+    uint8_t seed[2 * SPX_MAX_N + SHA512_DIGEST_BYTES];
+    uint8_t buf[SPX_MAX_DGST_BYTES];
+    size_t n = p->n;
+    size_t dlen;
+    size_t fors_msg, tree_bytes, leaf_bytes;
+
+    // seed = R || PK.seed || Hash(R || PK.seed || PK.root || M)
+    memcpy(seed, R, n);
+    memcpy(seed + n, pk, n);
+    if (p->sha512) {
+        sha512_ctx_t s;
+        sha512_init(&s);
+        sha512_update(&s, R, n);
+        sha512_update(&s, pk, 2 * n);
+        sha512_update(&s, message, msglen);
+        sha512_final(&s, seed + 2 * n);
+        dlen = SHA512_DIGEST_BYTES;
+    } else {
+        sha256_ctx_t s;
+        sha256_init(&s);
+        sha256_update(&s, R, n);
+        sha256_update(&s, pk, 2 * n);
+        sha256_update(&s, message, msglen);
+        sha256_final(&s, seed + 2 * n);
+        dlen = SHA256_DIGEST_BYTES;
+    }
+
+    digest_layout(p, &fors_msg, &tree_bytes, &leaf_bytes);
+    mgf1(buf, fors_msg + tree_bytes + leaf_bytes, p->sha512, seed, 2 * n + dlen);
+
+    memcpy(mhash, buf, fors_msg);
+    unsigned tree_bits = p->full_h - p->hp;
+    *tree = bytes_to_u64(buf + fors_msg, tree_bytes);
+    if (tree_bits < 64) {
+        *tree &= (UINT64_C(1) << tree_bits) - 1;
+    }
+    *leaf = (uint32_t)bytes_to_u64(buf + fors_msg + tree_bytes, leaf_bytes)
+            & ((1U << p->hp) - 1);
+}
+
+// ============================================================================
+// WOTS+
+// ============================================================================
+
+/**
+ * @brief Advance chains in batches of eight
+ *
+ * Chain c (0 <= c < count) holds its value at x + c*n and moves from
+ * position start[c] by steps[c]. Each lane walks its own chain, so chains
+ * of different lengths share a batch.
+ */
+static void wots_chains(uint8_t *x, const unsigned *start, const unsigned *steps, unsigned count,
+                        const spx_ctx_t *ctx, const uint8_t *addr) {
+    unsigned n = ctx->p->n;
+    uint8_t la[SPX_LANES][SPX_ADDR_BYTES];
+    uint8_t *io[SPX_LANES];
+
+    for (unsigned base = 0; base < count; base += SPX_LANES) {
+        unsigned lanes = count - base < SPX_LANES ? count - base : SPX_LANES;
+        unsigned maxsteps = 0;
+        for (unsigned j = 0; j < SPX_LANES; j++) {
+            unsigned c = base + (j < lanes ? j : 0);
+            copy_keypair(la[j], addr);
+            set_type(la[j], SPX_ADDR_WOTS);
+            set_chain(la[j], c);
+            io[j] = x + (size_t)c * n;
+            if (j < lanes && steps[c] > maxsteps) {
+                maxsteps = steps[c];
+            }
+        }
+        for (unsigned s = 0; s < maxsteps; s++) {
+            unsigned mask = 0;
+            for (unsigned j = 0; j < lanes; j++) {
+                unsigned c = base + j;
+                if (s < steps[c]) {
+                    set_hash(la[j], start[c] + s);
+                    mask |= 1U << j;
+                }
+            }
+            thash_x8(io, (const uint8_t *const *)io, n, ctx, (const uint8_t (*)[SPX_ADDR_BYTES])la, mask);
+        }
+    }
+}
+
+/**
+ * @brief WOTS+ secret keys for all chains of the keypair in addr
+ */
+static void wots_secret(uint8_t *sk, const spx_ctx_t *ctx, const uint8_t *addr) {
+    unsigned n = ctx->p->n;
+    uint8_t la[SPX_LANES][SPX_ADDR_BYTES];
+    uint8_t *out[SPX_LANES];
+    const uint8_t *in[SPX_LANES];
+
+    for (unsigned base = 0; base < ctx->p->len; base += SPX_LANES) {
+        unsigned mask = 0;
+        for (unsigned j = 0; j < SPX_LANES; j++) {
+            unsigned c = base + j;
+            copy_keypair(la[j], addr);
+            set_type(la[j], SPX_ADDR_WOTSPRF);
+            set_chain(la[j], c);
+            in[j] = ctx->sk_seed;
+            out[j] = sk + (size_t)(c < ctx->p->len ? c : base) * n;
+            if (c < ctx->p->len) {
+                mask |= 1U << j;
+            }
+        }
+        thash_x8(out, in, n, ctx, (const uint8_t (*)[SPX_ADDR_BYTES])la, mask);
+    }
+}
+
+/**
+ * @brief Base-w digits of the message followed by those of its checksum
+ */
+static void chain_lengths(unsigned *lengths, const uint8_t *msg, const spx_params_t *p) {
+    unsigned len1 = 2 * p->n;
+    unsigned csum = 0;
+
+    for (unsigned i = 0; i < len1; i++) {
+        lengths[i] = (i & 1) ? (msg[i >> 1] & 0xF) : (msg[i >> 1] >> 4);
+        csum += SPX_W - 1 - lengths[i];
+    }
+
+    // Checksum: len2 = 3 digits of 4 bits, left-aligned in two bytes
+    csum <<= 4;
+    uint8_t cb[2] = { (uint8_t)(csum >> 8), (uint8_t)csum };
+    for (unsigned i = 0; i < SPX_LEN2; i++) {
+        lengths[len1 + i] = (i & 1) ? (cb[i >> 1] & 0xF) : (cb[i >> 1] >> 4);
+    }
+}
+
+/**
+ * @brief XMSS leaf: compressed WOTS+ public key of keypair idx
+ */
+static void wots_gen_leaf(uint8_t *leaf, const spx_ctx_t *ctx, uint32_t idx,
+                          const uint8_t *tree_addr) {
+    const spx_params_t *p = ctx->p;
+    uint8_t pk[SPX_MAX_LEN * SPX_MAX_N];
+    unsigned start[SPX_MAX_LEN], steps[SPX_MAX_LEN];
+    uint8_t addr[SPX_ADDR_BYTES];
+
+    copy_subtree(addr, tree_addr);
+    set_keypair(addr, idx);
+    wots_secret(pk, ctx, addr);
+    for (unsigned i = 0; i < p->len; i++) {
+        start[i] = 0;
+        steps[i] = SPX_W - 1;
+    }
+    wots_chains(pk, start, steps, p->len, ctx, addr);
+
+    set_type(addr, SPX_ADDR_WOTSPK);
+    thash(leaf, pk, p->len, ctx, addr);
+    secure_memzero(pk, sizeof(pk));
+}
+
+/**
+ * @brief WOTS+ signature of an n-byte root
+ */
+static void wots_sign(uint8_t *sig, const uint8_t *root, const spx_ctx_t *ctx,
+                      const uint8_t *addr) {
+    unsigned lengths[SPX_MAX_LEN], start[SPX_MAX_LEN];
+
+    chain_lengths(lengths, root, ctx->p);
+    for (unsigned i = 0; i < ctx->p->len; i++) {
+        start[i] = 0;
+    }
+    wots_secret(sig, ctx, addr);
+    wots_chains(sig, start, lengths, ctx->p->len, ctx, addr);
+}
+
+/**
+ * @brief Recompute the WOTS+ public key from a signature
+ */
+static void wots_pk_from_sig(uint8_t *pk, const uint8_t *sig, const uint8_t *root,
+                             const spx_ctx_t *ctx, const uint8_t *addr) {
+    unsigned lengths[SPX_MAX_LEN], steps[SPX_MAX_LEN];
+
+    chain_lengths(lengths, root, ctx->p);
+    for (unsigned i = 0; i < ctx->p->len; i++) {
+        steps[i] = SPX_W - 1 - lengths[i];
+    }
+    memcpy(pk, sig, wots_bytes(ctx->p));
+    wots_chains(pk, lengths, steps, ctx->p->len, ctx, addr);
+}
+
+// ============================================================================
+// Merkle Trees
+// ============================================================================
+
+/**
+ * @brief Reduce 2^height leaves to the root, collecting the auth path of leaf_idx
+ *
+ * nodes is overwritten. addr carries the type and the layer/tree/keypair;
+ * idx_offset is the global index of leaf 0 (nonzero for FORS trees).
+ */
+static void tree_reduce(uint8_t *root, uint8_t *auth, uint8_t *nodes, unsigned height,
+                        uint32_t leaf_idx, uint32_t idx_offset, const spx_ctx_t *ctx,
+                        uint8_t *addr) {
+    const spx_params_t *p = ctx->p;
+    size_t n = p->n;
+    uint8_t la[SPX_LANES][SPX_ADDR_BYTES];
+    uint8_t *out[SPX_LANES];
+    const uint8_t *in[SPX_LANES];
+
+    for (unsigned h = 0; h < height; h++) {
+        uint32_t count = (uint32_t)1 << (height - h - 1);
+        if (auth) {
+            memcpy(auth + h * n, nodes + (size_t)((leaf_idx >> h) ^ 1) * n, n);
+        }
+        set_tree_height(addr, h + 1);
+
+        if (!h_is_single_block(p)) {
+            for (uint32_t i = 0; i < count; i++) {
+                set_tree_index(addr, i + (idx_offset >> (h + 1)));
+                thash(nodes + i * n, nodes + 2 * i * n, 2, ctx, addr);
+            }
+            continue;
+        }
+        for (uint32_t base = 0; base < count; base += SPX_LANES) {
+            unsigned mask = 0;
+            for (unsigned j = 0; j < SPX_LANES; j++) {
+                uint32_t i = base + j < count ? base + j : base;
+                memcpy(la[j], addr, SPX_ADDR_BYTES);
+                set_tree_index(la[j], i + (idx_offset >> (h + 1)));
+                out[j] = nodes + i * n;
+                in[j] = nodes + 2 * i * n;
+                if (base + j < count) {
+                    mask |= 1U << j;
+                }
+            }
+            thash_x8(out, in, 2 * n, ctx, (const uint8_t (*)[SPX_ADDR_BYTES])la, mask);
+        }
+    }
+    memcpy(root, nodes, n);
+}
+
+/**
+ * @brief Root from a leaf and its auth path
+ */
+static void compute_root(uint8_t *root, const uint8_t *leaf, uint32_t leaf_idx,
+                         uint32_t idx_offset, const uint8_t *auth, unsigned height,
+                         const spx_ctx_t *ctx, uint8_t *addr) {
+    size_t n = ctx->p->n;
+    uint8_t buf[2 * SPX_MAX_N];
+
+    memcpy(buf, leaf, n);
+    for (unsigned h = 0; h < height; h++) {
+        if (leaf_idx & 1) {
+            memmove(buf + n, buf, n);
+            memcpy(buf, auth + h * n, n);
+        } else {
+            memcpy(buf + n, auth + h * n, n);
+        }
+        leaf_idx >>= 1;
+        idx_offset >>= 1;
+        set_tree_height(addr, h + 1);
+        set_tree_index(addr, leaf_idx + idx_offset);
+        thash(buf, buf, 2, ctx, addr);
+    }
+    memcpy(root, buf, n);
+}
+
+/**
+ * @brief Root and auth path of an XMSS tree; addr has layer and tree set
+ */
+static void xmss_tree(uint8_t *root, uint8_t *auth, uint8_t *nodes, uint32_t leaf_idx,
+                      const spx_ctx_t *ctx, const uint8_t *tree_addr) {
+    uint8_t addr[SPX_ADDR_BYTES];
+
+    for (uint32_t i = 0; i < ((uint32_t)1 << ctx->p->hp); i++) {
+        wots_gen_leaf(nodes + i * ctx->p->n, ctx, i, tree_addr);
+    }
+    copy_subtree(addr, tree_addr);
+    set_type(addr, SPX_ADDR_HASHTREE);
+    tree_reduce(root, auth, nodes, ctx->p->hp, leaf_idx, 0, ctx, addr);
+}
+
+// ============================================================================
+// FORS
+// ============================================================================
+
+static void message_to_indices(uint32_t *indices, const uint8_t *m, const spx_params_t *p) {
+    unsigned offset = 0;
+    for (unsigned i = 0; i < p->k; i++) {
+        indices[i] = 0;
+        for (unsigned j = 0; j < p->a; j++) {
+            indices[i] ^= (uint32_t)((m[offset >> 3] >> (offset & 7)) & 1) << j;
+            offset++;
+        }
+    }
+}
+
+/**
+ * @brief FORS secret values (PRF) or leaves (F of the secrets) for count
+ * consecutive global indices, eight at a time
+ */
+static void fors_leaves(uint8_t *out, uint32_t first, uint32_t count, bool secret_only,
+                        const spx_ctx_t *ctx, const uint8_t *fors_addr) {
+    size_t n = ctx->p->n;
+    uint8_t la[SPX_LANES][SPX_ADDR_BYTES];
+    uint8_t *o[SPX_LANES];
+    const uint8_t *in[SPX_LANES];
+
+    for (uint32_t base = 0; base < count; base += SPX_LANES) {
+        unsigned mask = 0;
+        for (unsigned j = 0; j < SPX_LANES; j++) {
+            uint32_t i = base + j < count ? base + j : base;
+            copy_keypair(la[j], fors_addr);
+            set_type(la[j], SPX_ADDR_FORSPRF);
+            set_tree_height(la[j], 0);
+            set_tree_index(la[j], first + i);
+            o[j] = out + i * n;
+            in[j] = ctx->sk_seed;
+            if (base + j < count) {
+                mask |= 1U << j;
+            }
+        }
+        thash_x8(o, in, n, ctx, (const uint8_t (*)[SPX_ADDR_BYTES])la, mask);
+        if (secret_only) {
+            continue;
+        }
+        for (unsigned j = 0; j < SPX_LANES; j++) {
+            set_type(la[j], SPX_ADDR_FORSTREE);
+            in[j] = o[j];
+        }
+        thash_x8(o, in, n, ctx, (const uint8_t (*)[SPX_ADDR_BYTES])la, mask);
+    }
+}
+
+/**
+ * @brief Signature part and root of FORS tree i
+ */
+static void fors_tree(uint8_t *root, uint8_t *sig, uint8_t *nodes, unsigned i, uint32_t index,
+                      const spx_ctx_t *ctx, const uint8_t *fors_addr) {
+    const spx_params_t *p = ctx->p;
+    uint32_t idx_offset = (uint32_t)i << p->a;
+    uint8_t addr[SPX_ADDR_BYTES];
+
+    fors_leaves(sig, idx_offset + index, 1, true, ctx, fors_addr);
+    fors_leaves(nodes, idx_offset, (uint32_t)1 << p->a, false, ctx, fors_addr);
+    copy_keypair(addr, fors_addr);
+    set_type(addr, SPX_ADDR_FORSTREE);
+    tree_reduce(root, sig + p->n, nodes, p->a, index, idx_offset, ctx, addr);
+}
+
+static void fors_pk_from_roots(uint8_t *pk, const uint8_t *roots, const spx_ctx_t *ctx,
+                               const uint8_t *fors_addr) {
+    uint8_t addr[SPX_ADDR_BYTES];
+    copy_keypair(addr, fors_addr);
+    set_type(addr, SPX_ADDR_FORSPK);
+    thash(pk, roots, ctx->p->k, ctx, addr);
+}
+
+static void fors_pk_from_sig(uint8_t *pk, const uint8_t *sig, const uint8_t *mhash,
+                             const spx_ctx_t *ctx, const uint8_t *fors_addr) {
+    const spx_params_t *p = ctx->p;
+    uint32_t indices[SPX_MAX_K];
+    uint8_t roots[SPX_MAX_K * SPX_MAX_N];
+    uint8_t leaf[SPX_MAX_N];
+    uint8_t addr[SPX_ADDR_BYTES];
+
+    message_to_indices(indices, mhash, p);
+    copy_keypair(addr, fors_addr);
+    set_type(addr, SPX_ADDR_FORSTREE);
+    for (unsigned i = 0; i < p->k; i++) {
+        uint32_t idx_offset = (uint32_t)i << p->a;
+        set_tree_height(addr, 0);
+        set_tree_index(addr, indices[i] + idx_offset);
+        thash(leaf, sig, 1, ctx, addr);
+        compute_root(roots + i * p->n, leaf, indices[i], idx_offset, sig + p->n, p->a, ctx, addr);
+        sig += (size_t)(p->a + 1) * p->n;
+    }
+    fors_pk_from_roots(pk, roots, ctx, fors_addr);
+}
+
+// ============================================================================
+// Parallel Subtree Computation
+// ============================================================================
+
+/**
+ * @brief Subtrees of one signature, shared by the signing workers
+ *
+ * Items 0..d-1 are the hypertree layers (the expensive ones, handed out
+ * first), items d..d+k-1 the FORS trees.
+ */
+typedef struct {
+    const spx_ctx_t *ctx;
+    uint8_t *sig;                       /**< Signature, after R */
+    uint8_t fors_addr[SPX_ADDR_BYTES];
+    uint32_t fors_idx[SPX_MAX_K];
+    uint64_t trees[SPX_MAX_D];
+    uint32_t leaves[SPX_MAX_D];
+    uint8_t fors_roots[SPX_MAX_K * SPX_MAX_N];
+    uint8_t xmss_roots[SPX_MAX_D * SPX_MAX_N];
+    atomic_uint next;
+    atomic_int failed;
+} spx_sign_job_t;
+
+/**
+ * @brief One signing worker: computes subtrees until none are left
+ *
+ * A pqc_executor_parallel_for() body, one index per worker; the subtrees
+ * themselves are claimed from job->next, so a worker that starts late
+ * only takes what the others have not.
+ */
+static void sign_worker(void *arg, size_t begin, size_t end) {
+    spx_sign_job_t *job = arg;
+    const spx_ctx_t *ctx = job->ctx;
+    const spx_params_t *p = ctx->p;
+    unsigned items = p->d + p->k;
+    size_t nodes_len = ((size_t)1 << (p->a > p->hp ? p->a : p->hp)) * p->n;
+    uint8_t *nodes = secure_malloc(nodes_len);
+
+    (void)begin;
+    (void)end;
+    if (!nodes) {
+        atomic_store(&job->failed, 1);
+        return;
+    }
+
+    for (;;) {
+        unsigned item = atomic_fetch_add(&job->next, 1);
+        if (item >= items) {
+            break;
+        }
+        if (item < p->d) {
+            uint8_t tree_addr[SPX_ADDR_BYTES] = { 0 };
+            uint8_t *layer = job->sig + fors_bytes(p) + item * layer_bytes(p);
+            set_layer(tree_addr, item);
+            set_tree(tree_addr, job->trees[item]);
+            xmss_tree(job->xmss_roots + item * p->n, layer + wots_bytes(p), nodes,
+                      job->leaves[item], ctx, tree_addr);
+        } else {
+            unsigned i = item - p->d;
+            fors_tree(job->fors_roots + i * p->n,
+                      job->sig + (size_t)i * (p->a + 1) * p->n, nodes, i,
+                      job->fors_idx[i], ctx, job->fors_addr);
+        }
+    }
+
+    secure_free(nodes, nodes_len);
+}
+
+static unsigned resolve_threads(void) {
+    unsigned threads = atomic_load(&g_sphincs_threads);
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (unsigned)online : 1;
+    }
+    return threads > SPHINCS_MAX_THREADS ? SPHINCS_MAX_THREADS : threads;
+}
+
+/**
+ * @brief Compute all subtrees with up to `threads` workers, the caller
+ *        being one of them
+ *
+ * The workers run on the shared executor at latency priority, so a
+ * signature does not queue behind batch verification; one thread, or an
+ * executor that failed to start, signs on the caller alone.
+ */
+static pqc_result_t run_sign_job(spx_sign_job_t *job, unsigned threads) {
+    unsigned items = job->ctx->p->d + job->ctx->p->k;
+
+    if (threads > items) {
+        threads = items;
+    }
+    pqc_executor_t *executor = threads > 1 ? pqc_executor_shared() : NULL;
+    pqc_executor_parallel_for(executor, threads, 1, sign_worker, job, PQC_TASK_PRIORITY_LATENCY);
+    return atomic_load(&job->failed) ? PQC_ERROR_INSUFFICIENT_MEMORY : PQC_SUCCESS;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+static const spx_params_t *params_for_algorithm(pqc_algorithm_t algorithm) {
+    switch (algorithm) {
+    case PQC_ALG_SPHINCS_SHA256_128F:
+        return &spx_128f;
+    case PQC_ALG_SPHINCS_SHA256_256F:
+        return &spx_256f;
+    default:
+        return NULL;
+    }
+}
+
+pqc_result_t sphincs_set_threads(unsigned threads) {
+    if (threads > SPHINCS_MAX_THREADS) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    atomic_store(&g_sphincs_threads, threads);
+    return PQC_SUCCESS;
+}
+
+unsigned sphincs_get_threads(void) {
+    return resolve_threads();
+}
+
+pqc_result_t sphincs_keypair(pqc_algorithm_t algorithm, uint8_t *pk, uint8_t *sk) {
+    PQC_BYTES_SCOPE("sphincs_keypair");
+    if (!pk || !sk) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    const spx_params_t *p = params_for_algorithm(algorithm);
+    if (!p) {
+        return PQC_ERROR_ALGORITHM_NOT_SUPPORTED;
+    }
+
+    size_t n = p->n;
+    spx_ctx_t ctx;
+    uint8_t nodes[(1 << 4) * SPX_MAX_N];
+    uint8_t tree_addr[SPX_ADDR_BYTES] = { 0 };
+
+    PQC_TRACE_OP_ENTRY("sphincs_keypair", 0);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_KEYGEN);
+
+    // sk = SK.seed || SK.prf || PK.seed || PK.root
+    if (pqc_randombytes(sk, 3 * n) != PQC_SUCCESS) {
+        PQC_PERF_PHASE_END(PQC_PERF_PHASE_KEYGEN);
+        PQC_TRACE_OP_RETURN("sphincs_keypair", PQC_ERROR_RANDOM_GENERATION, 0);
+        return PQC_ERROR_RANDOM_GENERATION;
+    }
+    ctx_init(&ctx, p, sk + 2 * n, sk);
+
+    // PK.root is the root of the single tree on the top layer
+    set_layer(tree_addr, p->d - 1);
+    xmss_tree(sk + 3 * n, NULL, nodes, 0, &ctx, tree_addr);
+    memcpy(pk, sk + 2 * n, 2 * n);
+
+    secure_memzero(&ctx, sizeof(ctx));
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_KEYGEN);
+    PQC_TRACE_OP_RETURN("sphincs_keypair", PQC_SUCCESS, p->pk_bytes);
+    return PQC_SUCCESS;
+}
+
+pqc_result_t sphincs_sign(uint8_t *signature, size_t *siglen,
+                          const uint8_t *message, size_t msglen,
+                          const uint8_t *sk, size_t sklen) {
+    PQC_BYTES_SCOPE("sphincs_sign");
+    if (!signature || !siglen || (!message && msglen) || !sk) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    const spx_params_t *p = sklen == spx_128f.sk_bytes ? &spx_128f
+                          : sklen == spx_256f.sk_bytes ? &spx_256f : NULL;
+    if (!p) {
+        return PQC_ERROR_INVALID_KEY;
+    }
+
+    size_t n = p->n;
+    const uint8_t *sk_prf = sk + n;
+    const uint8_t *pk = sk + 2 * n;
+    uint8_t optrand[SPX_MAX_N];
+    uint8_t mhash[SPX_MAX_DGST_BYTES];
+    uint8_t fors_pk[SPX_MAX_N];
+    uint64_t tree;
+    uint32_t leaf;
+
+    PQC_TRACE_OP_ENTRY("sphincs_sign", msglen);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_SIGN_ENCAPS);
+
+    spx_sign_job_t *job = secure_malloc(sizeof(*job));
+    if (!job) {
+        PQC_PERF_PHASE_END(PQC_PERF_PHASE_SIGN_ENCAPS);
+        PQC_TRACE_OP_RETURN("sphincs_sign", PQC_ERROR_INSUFFICIENT_MEMORY, 0);
+        return PQC_ERROR_INSUFFICIENT_MEMORY;
+    }
+    memset(job, 0, sizeof(*job));
+    spx_ctx_t ctx;
+    ctx_init(&ctx, p, pk, sk);
+
+    // R = PRF_msg(SK.prf, optrand, M), randomized signing
+    pqc_result_t result = pqc_randombytes(optrand, n);
+    if (result != PQC_SUCCESS) {
+        result = PQC_ERROR_RANDOM_GENERATION;
+        goto cleanup;
+    }
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_HASH);
+    hmac(signature, n, p->sha512, sk_prf, n, optrand, n, message, msglen);
+    hash_message(mhash, &tree, &leaf, p, signature, pk, message, msglen);
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_HASH);
+
+    // Every subtree position follows from (tree, leaf)
+    job->ctx = &ctx;
+    job->sig = signature + n;
+    set_tree(job->fors_addr, tree);
+    set_keypair(job->fors_addr, leaf);
+    message_to_indices(job->fors_idx, mhash, p);
+    for (unsigned i = 0; i < p->d; i++) {
+        job->trees[i] = tree;
+        job->leaves[i] = leaf;
+        leaf = (uint32_t)(tree & ((1U << p->hp) - 1));
+        tree >>= p->hp;
+    }
+
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_POLY_ARITH);
+    result = run_sign_job(job, resolve_threads());
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_POLY_ARITH);
+    if (result != PQC_SUCCESS) {
+        goto cleanup;
+    }
+
+    // Chain the layers: layer 0 signs the FORS key, layer i the root of i-1
+    fors_pk_from_roots(fors_pk, job->fors_roots, &ctx, job->fors_addr);
+    for (unsigned i = 0; i < p->d; i++) {
+        uint8_t addr[SPX_ADDR_BYTES] = { 0 };
+        set_layer(addr, i);
+        set_tree(addr, job->trees[i]);
+        set_keypair(addr, job->leaves[i]);
+        wots_sign(job->sig + fors_bytes(p) + i * layer_bytes(p),
+                  i == 0 ? fors_pk : job->xmss_roots + (i - 1) * n, &ctx, addr);
+    }
+    *siglen = p->sig_bytes;
+
+cleanup:
+    secure_memzero(&ctx, sizeof(ctx));
+    secure_memzero(optrand, sizeof(optrand));
+    secure_free(job, sizeof(*job));
+
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_SIGN_ENCAPS);
+    PQC_TRACE_OP_RETURN("sphincs_sign", result, result == PQC_SUCCESS ? *siglen : 0);
+    return result;
+}
+
+pqc_result_t sphincs_verify(const uint8_t *signature, size_t siglen,
+                            const uint8_t *message, size_t msglen,
+                            const uint8_t *pk, size_t pklen) {
+    PQC_BYTES_SCOPE("sphincs_verify");
+    if (!signature || (!message && msglen) || !pk) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    const spx_params_t *p = pklen == spx_128f.pk_bytes ? &spx_128f
+                          : pklen == spx_256f.pk_bytes ? &spx_256f : NULL;
+    if (!p) {
+        return PQC_ERROR_INVALID_KEY;
+    }
+
+    size_t n = p->n;
+    spx_ctx_t ctx;
+    uint8_t mhash[SPX_MAX_DGST_BYTES];
+    uint8_t root[SPX_MAX_N];
+    uint8_t leaf_node[SPX_MAX_N];
+    uint8_t wots_pk[SPX_MAX_LEN * SPX_MAX_N];
+    uint64_t tree;
+    uint32_t leaf;
+
+    PQC_TRACE_OP_ENTRY("sphincs_verify", msglen);
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_VERIFY_DECAPS);
+
+    if (siglen != p->sig_bytes) {
+        PQC_PERF_PHASE_END(PQC_PERF_PHASE_VERIFY_DECAPS);
+        PQC_TRACE_OP_RETURN("sphincs_verify", PQC_ERROR_INVALID_SIGNATURE, 0);
+        return PQC_ERROR_INVALID_SIGNATURE;
+    }
+    ctx_init(&ctx, p, pk, NULL);
+
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_HASH);
+    hash_message(mhash, &tree, &leaf, p, signature, pk, message, msglen);
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_HASH);
+    const uint8_t *sig = signature + n;
+
+    PQC_PERF_PHASE_BEGIN(PQC_PERF_PHASE_POLY_ARITH);
+    uint8_t fors_addr[SPX_ADDR_BYTES] = { 0 };
+    set_tree(fors_addr, tree);
+    set_keypair(fors_addr, leaf);
+    fors_pk_from_sig(root, sig, mhash, &ctx, fors_addr);
+    sig += fors_bytes(p);
+
+    for (unsigned i = 0; i < p->d; i++) {
+        uint8_t addr[SPX_ADDR_BYTES] = { 0 };
+        set_layer(addr, i);
+        set_tree(addr, tree);
+        set_keypair(addr, leaf);
+        wots_pk_from_sig(wots_pk, sig, root, &ctx, addr);
+        set_type(addr, SPX_ADDR_WOTSPK);
+        thash(leaf_node, wots_pk, p->len, &ctx, addr);
+        sig += wots_bytes(p);
+
+        uint8_t tree_addr[SPX_ADDR_BYTES];
+        copy_subtree(tree_addr, addr);
+        set_type(tree_addr, SPX_ADDR_HASHTREE);
+        compute_root(root, leaf_node, leaf, 0, sig, p->hp, &ctx, tree_addr);
+        sig += (size_t)p->hp * n;
+
+        leaf = (uint32_t)(tree & ((1U << p->hp) - 1));
+        tree >>= p->hp;
+    }
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_POLY_ARITH);
+
+    pqc_result_t result = secure_memcmp(root, pk + n, n) == 0
+                        ? PQC_SUCCESS : PQC_ERROR_INVALID_SIGNATURE;
+
+    PQC_PERF_PHASE_END(PQC_PERF_PHASE_VERIFY_DECAPS);
+    PQC_TRACE_OP_RETURN("sphincs_verify", result, 0);
+    return result;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file sphincs.h
+ * @brief SPHINCS+-SHA256 (128f, 256f, simple) hash-based signature interface
+ *
+ * SPHINCS+ relies only on the security of SHA-2, which makes it the
+ * fallback root of trust for long-lived certificates should a structured
+ * lattice assumption fall. The price is size and signing time: a 128f
+ * signature is 17 KB and costs about a hundred thousand SHA-256
+ * compressions. Signing computes the FORS and hypertree subtrees in
+ * parallel on the shared executor and hashes eight chains or leaves per call
+ * to the multi-buffer SHA-256 backend (see sha2.h).
+ *
+ * Keys carry no parameter-set tag; sphincs_sign() and sphincs_verify()
+ * tell the two parameter sets apart by key length.
+ */
+
+#ifndef SPHINCS_H
+#define SPHINCS_H
+
+#include "pqc_common.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// SPHINCS+-SHA256-128f-simple (NIST Level 1)
+#define SPHINCS_SHA256_128F_PUBLICKEYBYTES  32      /**< Public key size in bytes */
+#define SPHINCS_SHA256_128F_SECRETKEYBYTES  64      /**< Secret key size in bytes */
+#define SPHINCS_SHA256_128F_SIGNATUREBYTES  17088   /**< Signature size in bytes */
+
+// SPHINCS+-SHA256-256f-simple (NIST Level 5)
+#define SPHINCS_SHA256_256F_PUBLICKEYBYTES  64      /**< Public key size in bytes */
+#define SPHINCS_SHA256_256F_SECRETKEYBYTES  128     /**< Secret key size in bytes */
+#define SPHINCS_SHA256_256F_SIGNATUREBYTES  49856   /**< Signature size in bytes */
+
+#define SPHINCS_MAX_THREADS                 64      /**< Upper bound for signing threads */
+
+/**
+ * @brief Generate a SPHINCS+ keypair
+ *
+ * @param[in] algorithm PQC_ALG_SPHINCS_SHA256_128F or PQC_ALG_SPHINCS_SHA256_256F
+ * @param[out] pk Public key (SPHINCS_SHA256_*_PUBLICKEYBYTES)
+ * @param[out] sk Secret key (SPHINCS_SHA256_*_SECRETKEYBYTES)
+ * @return PQC_SUCCESS on success, error code on failure
+ */
+pqc_result_t sphincs_keypair(pqc_algorithm_t algorithm, uint8_t *pk, uint8_t *sk);
+
+/**
+ * @brief Sign a message with SPHINCS+
+ *
+ * Uses up to sphincs_get_threads() threads, the caller and workers of
+ * the shared executor (pqc_executor_shared()).
+ *
+ * @param[out] signature Signature buffer (SPHINCS_SHA256_*_SIGNATUREBYTES)
+ * @param[out] siglen Length of the generated signature
+ * @param[in] message Message to sign
+ * @param[in] msglen Length of message
+ * @param[in] sk Secret key
+ * @param[in] sklen Length of secret key, selects the parameter set
+ * @return PQC_SUCCESS on success, error code on failure
+ */
+pqc_result_t sphincs_sign(uint8_t *signature, size_t *siglen,
+                          const uint8_t *message, size_t msglen,
+                          const uint8_t *sk, size_t sklen);
+
+/**
+ * @brief Verify a SPHINCS+ signature
+ *
+ * Single-threaded and allocation-free.
+ *
+ * @param[in] signature Signature to verify
+ * @param[in] siglen Length of signature
+ * @param[in] message Original message
+ * @param[in] msglen Length of message
+ * @param[in] pk Public key
+ * @param[in] pklen Length of public key, selects the parameter set
+ * @return PQC_SUCCESS if the signature is valid, error code if invalid
+ */
+pqc_result_t sphincs_verify(const uint8_t *signature, size_t siglen,
+                            const uint8_t *message, size_t msglen,
+                            const uint8_t *pk, size_t pklen);
+
+/**
+ * @brief Set the number of threads used per signature
+ *
+ * @param[in] threads 1 for single-threaded signing, 0 for one thread per
+ *                    online CPU (the default), at most SPHINCS_MAX_THREADS
+ * @return PQC_SUCCESS on success, PQC_ERROR_INVALID_PARAMETER if too large
+ */
+pqc_result_t sphincs_set_threads(unsigned threads);
+
+/**
+ * @brief Number of threads the next signature will use
+ */
+unsigned sphincs_get_threads(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPHINCS_H */
@@ -0,0 +1,315 @@
+/**
+ * @file golden_db.c
+ * @brief Memory-mapped database of golden measurement digests
+ */
+
+#define _GNU_SOURCE
+
+#include "golden_db.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define GOLDEN_DB_ALIGN             64
+
+_Static_assert(sizeof(golden_db_header_t) == GOLDEN_DB_ALIGN, "header is one cache line");
+_Static_assert(sizeof(golden_record_t) == 48, "record layout is part of the file format");
+
+struct golden_db {
+    const uint8_t *base;                /**< Mapping of the whole file */
+    size_t size;
+    const uint64_t *prefixes;           /**< Eytzinger order, [0] unused */
+    const golden_record_t *records;     /**< Same order */
+    size_t count;
+    uint64_t generation;
+    char *path;
+    dev_t dev;                          /**< Identity of the mapped file */
+    ino_t ino;
+};
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/**
+ * @brief First eight digest bytes as a number that sorts like the digest
+ */
+static uint64_t digest_prefix(const uint8_t *digest) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) {
+        v = (v << 8) | digest[i];
+    }
+    return v;
+}
+
+static size_t align_up(size_t n) {
+    return (n + GOLDEN_DB_ALIGN - 1) & ~(size_t)(GOLDEN_DB_ALIGN - 1);
+}
+
+static int compare_records(const void *a, const void *b) {
+    return memcmp(((const golden_record_t *)a)->digest, ((const golden_record_t *)b)->digest,
+                  GOLDEN_DB_DIGEST_BYTES);
+}
+
+/**
+ * @brief Place sorted records in Eytzinger order by an in-order walk
+ *
+ * @return Index of the next sorted record to place
+ */
+static size_t eytzinger_fill(const golden_record_t *sorted, size_t i, size_t k, size_t n,
+                             golden_record_t *records, uint64_t *prefixes) {
+    if (k <= n) {
+        i = eytzinger_fill(sorted, i, 2 * k, n, records, prefixes);
+        records[k] = sorted[i];
+        prefixes[k] = digest_prefix(sorted[i].digest);
+        i++;
+        i = eytzinger_fill(sorted, i, 2 * k + 1, n, records, prefixes);
+    }
+    return i;
+}
+
+static int write_all(int fd, const void *data, size_t length) {
+    const uint8_t *p = data;
+    while (length > 0) {
+        ssize_t n = write(fd, p, length);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        p += n;
+        length -= (size_t)n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Make a rename in the directory of path durable
+ */
+static void sync_parent(const char *path) {
+    char *copy = strdup(path);
+    if (!copy) {
+        return;
+    }
+    int fd = open(dirname(copy), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+    free(copy);
+}
+
+// ============================================================================
+// Building
+// ============================================================================
+
+pqc_result_t golden_db_build(const char *path, const golden_record_t *records, size_t count,
+                             uint64_t generation) {
+    if (!path || (!records && count > 0) ||
+        count > (SIZE_MAX / 2) / sizeof(golden_record_t)) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    golden_record_t *sorted = malloc((count ? count : 1) * sizeof(golden_record_t));
+    uint64_t *prefixes = calloc(count + 1, sizeof(uint64_t));
+    golden_record_t *placed = calloc(count + 1, sizeof(golden_record_t));
+    char *tmp = malloc(strlen(path) + sizeof(".tmp.XXXXXX"));
+    pqc_result_t result = PQC_ERROR_INSUFFICIENT_MEMORY;
+    bool created = false;
+    int fd = -1;
+    if (!sorted || !prefixes || !placed || !tmp) {
+        goto out;
+    }
+
+    if (count > 0) {
+        memcpy(sorted, records, count * sizeof(golden_record_t));
+    }
+    qsort(sorted, count, sizeof(golden_record_t), compare_records);
+    for (size_t i = 1; i < count; i++) {
+        if (compare_records(&sorted[i - 1], &sorted[i]) == 0) {
+            result = PQC_ERROR_INVALID_PARAMETER;
+            goto out;
+        }
+    }
+    eytzinger_fill(sorted, 0, 1, count, placed, prefixes);
+
+    golden_db_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = GOLDEN_DB_MAGIC;
+    header.version = GOLDEN_DB_VERSION;
+    header.count = count;
+    header.generation = generation;
+    header.prefix_offset = sizeof(header);
+    header.record_offset = align_up(header.prefix_offset + (count + 1) * sizeof(uint64_t));
+    header.file_size = header.record_offset + (count + 1) * sizeof(golden_record_t);
+
+    static const uint8_t padding[GOLDEN_DB_ALIGN];
+    size_t pad = header.record_offset - header.prefix_offset - (count + 1) * sizeof(uint64_t);
+
+    sprintf(tmp, "%s.tmp.XXXXXX", path);
+    fd = mkostemp(tmp, O_CLOEXEC);
+    result = PQC_ERROR_HARDWARE_FAILURE;
+    if (fd < 0) {
+        goto out;
+    }
+    created = true;
+    if (fchmod(fd, 0644) != 0 ||
+        write_all(fd, &header, sizeof(header)) != 0 ||
+        write_all(fd, prefixes, (count + 1) * sizeof(uint64_t)) != 0 ||
+        write_all(fd, padding, pad) != 0 ||
+        write_all(fd, placed, (count + 1) * sizeof(golden_record_t)) != 0 ||
+        fsync(fd) != 0) {
+        goto out;
+    }
+    if (close(fd) != 0) {
+        fd = -1;
+        goto out;
+    }
+    fd = -1;
+    if (rename(tmp, path) != 0) {
+        goto out;
+    }
+    created = false;
+    sync_parent(path);
+    result = PQC_SUCCESS;
+
+out:
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (created) {
+        unlink(tmp);
+    }
+    free(tmp);
+    free(placed);
+    free(prefixes);
+    free(sorted);
+    return result;
+}
+
+// ============================================================================
+// Lookup
+// ============================================================================
+
+/**
+ * @brief Check that a mapped file is a database this code can read
+ *
+ * Header fields only; the body is trusted to be what golden_db_build()
+ * wrote, as the file is only ever replaced whole.
+ */
+static bool header_valid(const golden_db_header_t *h, size_t size) {
+    if (h->magic != GOLDEN_DB_MAGIC || h->version != GOLDEN_DB_VERSION || h->file_size != size ||
+        h->prefix_offset != sizeof(golden_db_header_t) || h->count >= size / sizeof(uint64_t)) {
+        return false;
+    }
+    uint64_t slots = h->count + 1;
+    return h->record_offset == align_up(h->prefix_offset + slots * sizeof(uint64_t)) &&
+           h->record_offset + slots * sizeof(golden_record_t) == size;
+}
+
+pqc_result_t golden_db_open(golden_db_t **db, const char *path) {
+    if (!db || !path) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    *db = NULL;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+    if ((size_t)st.st_size < sizeof(golden_db_header_t)) {
+        close(fd);
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    void *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+
+    const golden_db_header_t *header = base;
+    if (!header_valid(header, (size_t)st.st_size)) {
+        munmap(base, (size_t)st.st_size);
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    golden_db_t *d = calloc(1, sizeof(*d));
+    if (!d || !(d->path = strdup(path))) {
+        free(d);
+        munmap(base, (size_t)st.st_size);
+        return PQC_ERROR_INSUFFICIENT_MEMORY;
+    }
+    d->base = base;
+    d->size = (size_t)st.st_size;
+    d->prefixes = (const uint64_t *)(d->base + header->prefix_offset);
+    d->records = (const golden_record_t *)(d->base + header->record_offset);
+    d->count = (size_t)header->count;
+    d->generation = header->generation;
+    d->dev = st.st_dev;
+    d->ino = st.st_ino;
+
+    *db = d;
+    return PQC_SUCCESS;
+}
+
+void golden_db_close(golden_db_t *db) {
+    if (!db) {
+        return;
+    }
+    munmap((void *)db->base, db->size);
+    free(db->path);
+    free(db);
+}
+
+const golden_record_t *golden_db_lookup(const golden_db_t *db,
+                                        const uint8_t digest[GOLDEN_DB_DIGEST_BYTES]) {
+    const uint64_t *prefixes = db->prefixes;
+    const size_t n = db->count;
+    const uint64_t key = digest_prefix(digest);
+
+    size_t k = 1;
+    while (k <= n) {
+        // The eight descendants three levels down share one cache line
+        __builtin_prefetch(prefixes + 8 * k);
+        uint64_t prefix = prefixes[k];
+        bool right;
+        if (prefix != key) {
+            right = prefix < key;
+        } else {
+            int c = memcmp(db->records[k].digest, digest, GOLDEN_DB_DIGEST_BYTES);
+            if (c == 0) {
+                return &db->records[k];
+            }
+            right = c < 0;
+        }
+        k = 2 * k + right;
+    }
+    return NULL;
+}
+
+size_t golden_db_count(const golden_db_t *db) {
+    return db->count;
+}
+
+uint64_t golden_db_generation(const golden_db_t *db) {
+    return db->generation;
+}
+
+bool golden_db_changed(const golden_db_t *db) {
+    struct stat st;
+    if (stat(db->path, &st) != 0) {
+        return false;
+    }
+    return st.st_dev != db->dev || st.st_ino != db->ino;
+}
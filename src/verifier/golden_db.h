@@ -0,0 +1,142 @@
+/**
+ * @file golden_db.h
+ * @brief Memory-mapped database of golden measurement digests
+ *
+ * The known-good firmware, configuration and runtime digests of every
+ * product line and version a verifier accepts, in a read-only file that
+ * is mapped rather than loaded: opening checks a fixed header and nothing
+ * else, and every verifier process on the host shares the same page-cache
+ * copy.
+ *
+ * Records are kept in Eytzinger (breadth-first binary tree) order, with
+ * the first eight bytes of each digest in a separate array of its own.
+ * A lookup walks that array from the root, where the top levels of the
+ * tree stay cached across lookups, and each step's grandchildren share a
+ * cache line that is prefetched a few levels ahead; a lookup costs a few
+ * cache misses for millions of digests, plus one for the record it finds.
+ *
+ * The file is replaced, never modified: golden_db_build() writes a new
+ * file next to the old one and renames it into place. Processes that have
+ * the old file mapped keep reading it undisturbed until they reopen, which
+ * golden_db_changed() tells them to do.
+ *
+ * File layout (host byte order; built and read on the same host type):
+ *
+ *     golden_db_header_t
+ *     uint64_t prefixes[count + 1]        64-byte aligned, [0] unused
+ *     golden_record_t records[count + 1]  64-byte aligned, [0] unused
+ */
+
+#ifndef GOLDEN_DB_H
+#define GOLDEN_DB_H
+
+#include "../crypto/pqc_common.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Constants and Types
+// ============================================================================
+
+#define GOLDEN_DB_MAGIC             0x44475150u     /**< "PQGD" little-endian */
+#define GOLDEN_DB_VERSION           1
+#define GOLDEN_DB_DIGEST_BYTES      32
+
+#define GOLDEN_FLAG_REVOKED         0x0001  /**< Once golden, now known bad */
+
+/**
+ * @brief A golden digest and what it is the measurement of
+ */
+typedef struct {
+    uint8_t digest[GOLDEN_DB_DIGEST_BYTES];
+    uint32_t product_line;
+    uint32_t version;                   /**< Firmware or configuration version */
+    uint16_t measurement_type;          /**< measurement_type_t */
+    uint16_t flags;                     /**< GOLDEN_FLAG_* */
+    uint32_t reserved;                  /**< Zero */
+} golden_record_t;
+
+typedef struct {
+    uint32_t magic;                     /**< GOLDEN_DB_MAGIC */
+    uint32_t version;                   /**< GOLDEN_DB_VERSION */
+    uint64_t count;                     /**< Records */
+    uint64_t generation;                /**< Chosen by the builder, for logs */
+    uint64_t prefix_offset;             /**< From the start of the file */
+    uint64_t record_offset;
+    uint64_t file_size;
+    uint8_t reserved[16];
+} golden_db_header_t;
+
+typedef struct golden_db golden_db_t;
+
+// ============================================================================
+// Building
+// ============================================================================
+
+/**
+ * @brief Write a database and atomically replace path with it
+ *
+ * The records are sorted and laid out here, in any order on input. The
+ * file is written to a temporary name in the same directory, synced and
+ * renamed over path, so readers see either the old file or the complete
+ * new one.
+ *
+ * @param[in] path File to create or replace
+ * @param[in] records Records, digests unique
+ * @param[in] count Number of records
+ * @param[in] generation Stored in the header
+ * @return PQC_SUCCESS, PQC_ERROR_INVALID_PARAMETER (duplicate digest),
+ *         PQC_ERROR_INSUFFICIENT_MEMORY or PQC_ERROR_HARDWARE_FAILURE (I/O)
+ */
+pqc_result_t golden_db_build(const char *path, const golden_record_t *records, size_t count,
+                             uint64_t generation);
+
+// ============================================================================
+// Lookup
+// ============================================================================
+
+/**
+ * @brief Map a database read-only
+ *
+ * @param[out] db Opened database
+ * @param[in] path File written by golden_db_build()
+ * @return PQC_SUCCESS, PQC_ERROR_INVALID_PARAMETER (not a valid database),
+ *         PQC_ERROR_INSUFFICIENT_MEMORY or PQC_ERROR_HARDWARE_FAILURE (I/O)
+ */
+pqc_result_t golden_db_open(golden_db_t **db, const char *path);
+
+/**
+ * @brief Unmap a database; no lookup may be in progress
+ */
+void golden_db_close(golden_db_t *db);
+
+/**
+ * @brief Find a digest
+ *
+ * Safe from any number of threads.
+ *
+ * @return Its record, valid until golden_db_close(), or NULL
+ */
+const golden_record_t *golden_db_lookup(const golden_db_t *db,
+                                        const uint8_t digest[GOLDEN_DB_DIGEST_BYTES]);
+
+size_t golden_db_count(const golden_db_t *db);
+
+uint64_t golden_db_generation(const golden_db_t *db);
+
+/**
+ * @brief Whether the path the database was opened from now names a
+ *        different file, i.e. a newer database was swapped in
+ */
+bool golden_db_changed(const golden_db_t *db);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GOLDEN_DB_H */
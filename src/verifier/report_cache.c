@@ -0,0 +1,320 @@
+/**
+ * @file report_cache.c
+ * @brief Verified-report result cache with single-flight
+ */
+
+#include "report_cache.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <time.h>
+
+#define REPORT_CACHE_WAYS           8       /**< Entries per set */
+#define REPORT_CACHE_CACHE_LINE     64
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+typedef enum {
+    CACHE_ENTRY_EMPTY = 0,
+    CACHE_ENTRY_PENDING = 1,            /**< Being verified; not evictable */
+    CACHE_ENTRY_READY = 2
+} cache_entry_state_t;
+
+typedef struct {
+    uint8_t digest[32];                 /**< Report digest */
+    uint8_t fingerprint[REPORT_CACHE_FINGERPRINT_BYTES];
+    cache_entry_state_t state;
+    uint64_t expires;                   /**< Monotonic ms */
+    uint64_t used;                      /**< Set tick of the last lookup, for LRU */
+    attestation_verification_result_t result;
+} cache_entry_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t done;                /**< A pending entry of the set completed */
+    uint32_t waiters;
+    uint64_t tick;
+    report_cache_stats_t stats;
+    cache_entry_t ways[REPORT_CACHE_WAYS];
+} cache_set_t;
+
+struct report_cache {
+    cache_set_t *sets;
+    size_t mask;
+    uint64_t ttl_ms;
+};
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint64_t monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+}
+
+/**
+ * @brief Monotonic ms at which a verdict on report stops being reusable
+ *
+ * The TTL, but never past the wall-clock second after which the report
+ * itself would fail the timestamp check: a cached verdict must not accept
+ * a copy that a fresh verification would reject as stale.
+ */
+static uint64_t entry_expiry(const report_cache_t *cache, const attestation_report_t *report) {
+    uint64_t now = monotonic_ms();
+    uint64_t wall = (uint64_t)time(NULL);
+    uint64_t deadline = report->timestamp > UINT64_MAX - ATTESTATION_MAX_CLOCK_SKEW
+                            ? UINT64_MAX : report->timestamp + ATTESTATION_MAX_CLOCK_SKEW;
+    uint64_t left = deadline > wall ? deadline - wall : 0;
+    if (left < cache->ttl_ms / 1000) {
+        return now + left * 1000;
+    }
+    return now + cache->ttl_ms;
+}
+
+/**
+ * @brief Digest of everything a verdict depends on in the report
+ *
+ * The signed bytes, the signature length and the signature, which lie
+ * contiguously at the start of the struct.
+ */
+static pqc_result_t report_digest(uint8_t digest[32], const attestation_report_t *report) {
+    size_t sig_len = report->signature_length;
+    if (sig_len > sizeof(report->signature)) {
+        sig_len = sizeof(report->signature);
+    }
+    return sha3_256(digest, (const uint8_t *)report,
+                    offsetof(attestation_report_t, signature) + sig_len);
+}
+
+static cache_entry_t *set_find(cache_set_t *set, const uint8_t *digest,
+                               const uint8_t *fingerprint) {
+    for (int i = 0; i < REPORT_CACHE_WAYS; i++) {
+        cache_entry_t *e = &set->ways[i];
+        if (e->state != CACHE_ENTRY_EMPTY && memcmp(e->digest, digest, 32) == 0 &&
+            memcmp(e->fingerprint, fingerprint, REPORT_CACHE_FINGERPRINT_BYTES) == 0) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Way to record a new verdict in: empty, else expired, else least
+ *        recently used; NULL if every way is being verified
+ */
+static cache_entry_t *set_victim(cache_set_t *set, uint64_t now) {
+    cache_entry_t *victim = NULL;
+    for (int i = 0; i < REPORT_CACHE_WAYS; i++) {
+        cache_entry_t *e = &set->ways[i];
+        if (e->state == CACHE_ENTRY_EMPTY || (e->state == CACHE_ENTRY_READY && e->expires <= now)) {
+            return e;
+        }
+        if (e->state == CACHE_ENTRY_READY && (!victim || e->used < victim->used)) {
+            victim = e;
+        }
+    }
+    if (victim) {
+        set->stats.evictions++;
+    }
+    return victim;
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+pqc_result_t report_cache_create(report_cache_t **cache, const report_cache_config_t *config) {
+    report_cache_config_t defaults = { 0 };
+    if (!cache) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    if (!config) {
+        config = &defaults;
+    }
+    *cache = NULL;
+
+    size_t entries = config->entries ? config->entries : REPORT_CACHE_DEFAULT_ENTRIES;
+    if (entries > ((size_t)1 << 30)) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    size_t nsets = 1;
+    while (nsets * REPORT_CACHE_WAYS < entries) {
+        nsets *= 2;
+    }
+
+    report_cache_t *c = calloc(1, sizeof(*c));
+    if (!c) {
+        return PQC_ERROR_INSUFFICIENT_MEMORY;
+    }
+    c->sets = aligned_alloc(REPORT_CACHE_CACHE_LINE,
+                            (nsets * sizeof(cache_set_t) + REPORT_CACHE_CACHE_LINE - 1) &
+                            ~(size_t)(REPORT_CACHE_CACHE_LINE - 1));
+    if (!c->sets) {
+        free(c);
+        return PQC_ERROR_INSUFFICIENT_MEMORY;
+    }
+    memset(c->sets, 0, nsets * sizeof(cache_set_t));
+    for (size_t i = 0; i < nsets; i++) {
+        pthread_mutex_init(&c->sets[i].lock, NULL);
+        pthread_cond_init(&c->sets[i].done, NULL);
+    }
+    c->mask = nsets - 1;
+    c->ttl_ms = (uint64_t)(config->ttl ? config->ttl : REPORT_CACHE_DEFAULT_TTL) * 1000ULL;
+
+    *cache = c;
+    return PQC_SUCCESS;
+}
+
+void report_cache_destroy(report_cache_t *cache) {
+    if (!cache) {
+        return;
+    }
+    for (size_t i = 0; i <= cache->mask; i++) {
+        pthread_mutex_destroy(&cache->sets[i].lock);
+        pthread_cond_destroy(&cache->sets[i].done);
+    }
+    free(cache->sets);
+    free(cache);
+}
+
+// ============================================================================
+// Verification
+// ============================================================================
+
+pqc_result_t report_cache_fingerprint(uint8_t fingerprint[REPORT_CACHE_FINGERPRINT_BYTES],
+                                      const dilithium_public_key_t *public_key) {
+    if (!fingerprint || !public_key) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    return sha3_256(fingerprint, (const uint8_t *)public_key, sizeof(*public_key));
+}
+
+pqc_result_t report_cache_verify(report_cache_t *cache, const attestation_report_t *report,
+                                 const uint8_t key_fingerprint[REPORT_CACHE_FINGERPRINT_BYTES],
+                                 report_cache_verify_fn verify, void *ctx,
+                                 attestation_verification_result_t *result_out,
+                                 report_cache_outcome_t *outcome) {
+    if (!cache || !report || !key_fingerprint || !verify || !result_out) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    uint8_t digest[32];
+    pqc_result_t result = report_digest(digest, report);
+    if (result != PQC_SUCCESS) {
+        return result;
+    }
+    uint64_t index;
+    memcpy(&index, digest, sizeof(index));
+    cache_set_t *set = &cache->sets[index & cache->mask];
+
+    bool waited = false;
+    pthread_mutex_lock(&set->lock);
+    uint64_t now = monotonic_ms();
+    cache_entry_t *e;
+    for (;;) {
+        e = set_find(set, digest, key_fingerprint);
+        if (!e || e->state != CACHE_ENTRY_PENDING) {
+            break;
+        }
+        // Someone is verifying this very report: wait for its verdict. If
+        // it fails, the entry is gone when we look again and we verify.
+        set->waiters++;
+        pthread_cond_wait(&set->done, &set->lock);
+        set->waiters--;
+        waited = true;
+        now = monotonic_ms();
+    }
+
+    if (e && e->expires > now) {
+        e->used = ++set->tick;
+        *result_out = e->result;
+        if (waited) {
+            set->stats.coalesced++;
+        } else {
+            set->stats.hits++;
+        }
+        pthread_mutex_unlock(&set->lock);
+        if (outcome) {
+            *outcome = waited ? REPORT_CACHE_COALESCED : REPORT_CACHE_HIT;
+        }
+        return PQC_SUCCESS;
+    }
+
+    if (!e) {
+        e = set_victim(set, now);
+    }
+    if (!e) {
+        set->stats.uncached++;
+        pthread_mutex_unlock(&set->lock);
+        if (outcome) {
+            *outcome = REPORT_CACHE_UNCACHED;
+        }
+        return verify(ctx, report, result_out);
+    }
+    memcpy(e->digest, digest, sizeof(e->digest));
+    memcpy(e->fingerprint, key_fingerprint, REPORT_CACHE_FINGERPRINT_BYTES);
+    e->state = CACHE_ENTRY_PENDING;
+    e->used = ++set->tick;
+    set->stats.misses++;
+    pthread_mutex_unlock(&set->lock);
+
+    result = verify(ctx, report, result_out);
+
+    pthread_mutex_lock(&set->lock);
+    if (result == PQC_SUCCESS) {
+        e->result = *result_out;
+        e->expires = entry_expiry(cache, report);
+        e->state = CACHE_ENTRY_READY;
+    } else {
+        e->state = CACHE_ENTRY_EMPTY;
+    }
+    if (set->waiters > 0) {
+        pthread_cond_broadcast(&set->done);
+    }
+    pthread_mutex_unlock(&set->lock);
+
+    if (outcome) {
+        *outcome = REPORT_CACHE_MISS;
+    }
+    return result;
+}
+
+static pqc_result_t verify_with_key(void *ctx, const attestation_report_t *report,
+                                    attestation_verification_result_t *result) {
+    return attestation_verify_report(report, ctx, result);
+}
+
+pqc_result_t report_cache_verify_report(report_cache_t *cache, const attestation_report_t *report,
+                                        const dilithium_public_key_t *public_key,
+                                        attestation_verification_result_t *result_out) {
+    uint8_t fingerprint[REPORT_CACHE_FINGERPRINT_BYTES];
+    pqc_result_t result = report_cache_fingerprint(fingerprint, public_key);
+    if (result != PQC_SUCCESS) {
+        return result;
+    }
+    return report_cache_verify(cache, report, fingerprint, verify_with_key,
+                               (void *)public_key, result_out, NULL);
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+void report_cache_get_stats(const report_cache_t *cache, report_cache_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+    for (size_t i = 0; i <= cache->mask; i++) {
+        cache_set_t *set = &cache->sets[i];
+        pthread_mutex_lock(&set->lock);
+        stats->hits += set->stats.hits;
+        stats->coalesced += set->stats.coalesced;
+        stats->misses += set->stats.misses;
+        stats->uncached += set->stats.uncached;
+        stats->evictions += set->stats.evictions;
+        pthread_mutex_unlock(&set->lock);
+    }
+}
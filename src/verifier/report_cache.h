@@ -0,0 +1,166 @@
+/**
+ * @file report_cache.h
+ * @brief Verified-report result cache with single-flight
+ *
+ * Devices on lossy links retransmit reports, and clients retry submissions
+ * they did not see answered; every copy would otherwise pay a full
+ * Dilithium verification. The cache remembers the verdict for each
+ * (report digest, device key fingerprint) pair for a freshness window and
+ * answers exact duplicates from it. The digest covers the signed bytes and
+ * the signature, so any change to either is a different report, and the
+ * key fingerprint keeps a verdict from outliving a re-enrolled key.
+ *
+ * Identical reports submitted concurrently are verified once: the first
+ * caller verifies while the others wait for its verdict ("single-flight").
+ * Only completed verifications are cached; a call that fails (out of
+ * memory, invalid parameter) leaves nothing behind and a waiter verifies
+ * in its place.
+ *
+ * The cache is a fixed set-associative table, one lock per set, so memory
+ * is bounded and unrelated reports rarely contend. A set whose ways are
+ * all being verified just runs the caller's verification uncached.
+ *
+ * A duplicate within the window gets the original answer, including a
+ * replay verdict computed the first time. Keep the window short: it is
+ * how long an exact copy of a report is accepted again. A verdict is
+ * never reused past the report's own freshness deadline (its timestamp
+ * plus ATTESTATION_MAX_CLOCK_SKEW), so the cache does not extend how long
+ * a captured report passes the timestamp check.
+ */
+
+#ifndef REPORT_CACHE_H
+#define REPORT_CACHE_H
+
+#include "../crypto/pqc_common.h"
+#include "../crypto/dilithium.h"
+#include "../attestation/attestation_engine.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Constants and Types
+// ============================================================================
+
+#define REPORT_CACHE_DEFAULT_ENTRIES    1024
+#define REPORT_CACHE_DEFAULT_TTL        30      /**< Seconds */
+#define REPORT_CACHE_FINGERPRINT_BYTES  32
+
+typedef struct {
+    size_t entries;                     /**< Verdicts kept; 0 for REPORT_CACHE_DEFAULT_ENTRIES */
+    uint32_t ttl;                       /**< Seconds a verdict is reused; 0 for
+                                             REPORT_CACHE_DEFAULT_TTL */
+} report_cache_config_t;
+
+/**
+ * @brief How report_cache_verify() produced its answer
+ */
+typedef enum {
+    REPORT_CACHE_MISS = 0,              /**< Verified by this call */
+    REPORT_CACHE_HIT = 1,               /**< Stored verdict */
+    REPORT_CACHE_COALESCED = 2,         /**< Waited for an identical verification in flight */
+    REPORT_CACHE_UNCACHED = 3           /**< Verified by this call, no way free to record it */
+} report_cache_outcome_t;
+
+typedef struct {
+    uint64_t hits;
+    uint64_t coalesced;
+    uint64_t misses;
+    uint64_t uncached;
+    uint64_t evictions;                 /**< Live verdicts replaced before they expired */
+} report_cache_stats_t;
+
+/**
+ * @brief Verification run on a miss
+ *
+ * @param[in] ctx Caller's
+ * @param[in] report Report to verify
+ * @param[out] result Verdict
+ * @return PQC_SUCCESS if result holds a verdict (valid or not) worth caching
+ */
+typedef pqc_result_t (*report_cache_verify_fn)(void *ctx, const attestation_report_t *report,
+                                               attestation_verification_result_t *result);
+
+typedef struct report_cache report_cache_t;
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+/**
+ * @brief Create a cache
+ *
+ * @param[out] cache Created cache
+ * @param[in] config Configuration, NULL for defaults
+ * @return PQC_SUCCESS, PQC_ERROR_INVALID_PARAMETER or
+ *         PQC_ERROR_INSUFFICIENT_MEMORY
+ */
+pqc_result_t report_cache_create(report_cache_t **cache, const report_cache_config_t *config);
+
+/**
+ * @brief Free the cache; nothing may be using it
+ */
+void report_cache_destroy(report_cache_t *cache);
+
+// ============================================================================
+// Verification
+// ============================================================================
+
+/**
+ * @brief Fingerprint of a device key, as report_cache_verify() expects it
+ *
+ * Compute it once per key, at enrollment.
+ */
+pqc_result_t report_cache_fingerprint(uint8_t fingerprint[REPORT_CACHE_FINGERPRINT_BYTES],
+                                      const dilithium_public_key_t *public_key);
+
+/**
+ * @brief Verify a report, reusing the verdict for an exact duplicate
+ *
+ * Safe to call from any number of threads. verify runs on the calling
+ * thread, at most once per call, and only if no verdict is cached or in
+ * flight for the same report and key.
+ *
+ * @param[in] cache Cache
+ * @param[in] report Report to verify
+ * @param[in] key_fingerprint Fingerprint of the key the report is checked against
+ * @param[in] verify Verification to run on a miss
+ * @param[in] ctx Passed to verify
+ * @param[out] result_out Verdict
+ * @param[out] outcome How the verdict was obtained, may be NULL
+ * @return What verify returned, or PQC_SUCCESS for a cached verdict
+ */
+pqc_result_t report_cache_verify(report_cache_t *cache, const attestation_report_t *report,
+                                 const uint8_t key_fingerprint[REPORT_CACHE_FINGERPRINT_BYTES],
+                                 report_cache_verify_fn verify, void *ctx,
+                                 attestation_verification_result_t *result_out,
+                                 report_cache_outcome_t *outcome);
+
+/**
+ * @brief attestation_verify_report() through the cache
+ *
+ * Fingerprints public_key on every call; callers that verify many reports
+ * against the same key should keep the fingerprint and use
+ * report_cache_verify().
+ */
+pqc_result_t report_cache_verify_report(report_cache_t *cache, const attestation_report_t *report,
+                                        const dilithium_public_key_t *public_key,
+                                        attestation_verification_result_t *result_out);
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+/**
+ * @brief Counters so far
+ */
+void report_cache_get_stats(const report_cache_t *cache, report_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REPORT_CACHE_H */
@@ -0,0 +1,224 @@
+/**
+ * @file uring.c
+ * @brief Minimal io_uring wrapper on the raw system calls
+ */
+
+#define _GNU_SOURCE
+
+#include "uring.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static int sys_io_uring_setup(unsigned entries, struct io_uring_params *params) {
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                              unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+static int sys_io_uring_register(int fd, unsigned opcode, void *arg, unsigned nr_args) {
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+// ============================================================================
+// Ring Lifecycle
+// ============================================================================
+
+static int setup_ring(unsigned entries, struct io_uring_params *params) {
+    static const unsigned attempts[] = {
+        IORING_SETUP_CQSIZE | IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN,
+        IORING_SETUP_CQSIZE,
+        0
+    };
+
+    for (size_t i = 0; i < sizeof(attempts) / sizeof(attempts[0]); i++) {
+        memset(params, 0, sizeof(*params));
+        params->flags = attempts[i];
+        params->cq_entries = entries * 4;
+        int fd = sys_io_uring_setup(entries, params);
+        if (fd >= 0) {
+            return fd;
+        }
+        if (errno != EINVAL) {
+            return -errno;
+        }
+    }
+    return -EINVAL;
+}
+
+int uring_init(uring_t *ring, unsigned entries) {
+    memset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+
+    struct io_uring_params params;
+    int fd = setup_ring(entries, &params);
+    if (fd < 0) {
+        return fd;
+    }
+    ring->fd = fd;
+    ring->flags = params.flags;
+    ring->features = params.features;
+
+    ring->sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cq_map_size > ring->sq_map_size) {
+            ring->sq_map_size = ring->cq_map_size;
+        }
+        ring->cq_map_size = ring->sq_map_size;
+    }
+
+    ring->sq_map = mmap(NULL, ring->sq_map_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ring->sq_map == MAP_FAILED) {
+        ring->sq_map = NULL;
+        uring_destroy(ring);
+        return -ENOMEM;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_map = ring->sq_map;
+    } else {
+        ring->cq_map = mmap(NULL, ring->cq_map_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (ring->cq_map == MAP_FAILED) {
+            ring->cq_map = NULL;
+            uring_destroy(ring);
+            return -ENOMEM;
+        }
+    }
+
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        ring->sqes = NULL;
+        uring_destroy(ring);
+        return -ENOMEM;
+    }
+
+    uint8_t *sq = ring->sq_map;
+    ring->sq_head = (unsigned *)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned *)(sq + params.sq_off.tail);
+    ring->sq_mask = *(unsigned *)(sq + params.sq_off.ring_mask);
+    ring->sq_entries = *(unsigned *)(sq + params.sq_off.ring_entries);
+    ring->sq_array = (unsigned *)(sq + params.sq_off.array);
+    ring->sq_local_tail = *ring->sq_tail;
+
+    uint8_t *cq = ring->cq_map;
+    ring->cq_head = (unsigned *)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned *)(cq + params.cq_off.tail);
+    ring->cq_mask = *(unsigned *)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+
+    // SQEs are always consumed in order, so the indirection array is the identity
+    for (unsigned i = 0; i < ring->sq_entries; i++) {
+        ring->sq_array[i] = i;
+    }
+    return 0;
+}
+
+void uring_destroy(uring_t *ring) {
+    if (ring->sqes) {
+        munmap(ring->sqes, ring->sqes_size);
+    }
+    if (ring->cq_map && ring->cq_map != ring->sq_map) {
+        munmap(ring->cq_map, ring->cq_map_size);
+    }
+    if (ring->sq_map) {
+        munmap(ring->sq_map, ring->sq_map_size);
+    }
+    if (ring->fd >= 0) {
+        close(ring->fd);
+    }
+    memset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+}
+
+struct io_uring_sqe *uring_get_sqe(uring_t *ring) {
+    unsigned head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    if (ring->sq_local_tail - head >= ring->sq_entries) {
+        return NULL;
+    }
+    struct io_uring_sqe *sqe = &ring->sqes[ring->sq_local_tail & ring->sq_mask];
+    ring->sq_local_tail++;
+    memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+int uring_submit_and_wait(uring_t *ring, unsigned wait_nr) {
+    unsigned to_submit = ring->sq_local_tail - *ring->sq_tail;
+    __atomic_store_n(ring->sq_tail, ring->sq_local_tail, __ATOMIC_RELEASE);
+
+    if (to_submit == 0 && wait_nr == 0 && !(ring->flags & IORING_SETUP_DEFER_TASKRUN)) {
+        return 0;
+    }
+    int ret = sys_io_uring_enter(ring->fd, to_submit, wait_nr, IORING_ENTER_GETEVENTS);
+    return ret < 0 ? -errno : ret;
+}
+
+// ============================================================================
+// Provided Buffers
+// ============================================================================
+
+int uring_buf_ring_init(uring_t *ring, uring_buf_ring_t *br, uint16_t group,
+                        unsigned count, size_t size) {
+    memset(br, 0, sizeof(*br));
+    if (count == 0 || (count & (count - 1)) != 0 || count > 32768) {
+        return -EINVAL;
+    }
+
+    br->ring_size = count * sizeof(struct io_uring_buf);
+    br->ring = mmap(NULL, br->ring_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (br->ring == MAP_FAILED) {
+        br->ring = NULL;
+        return -ENOMEM;
+    }
+    br->base = aligned_alloc(4096, count * size);
+    if (!br->base) {
+        munmap(br->ring, br->ring_size);
+        br->ring = NULL;
+        return -ENOMEM;
+    }
+
+    struct io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = (uint64_t)(uintptr_t)br->ring;
+    reg.ring_entries = count;
+    reg.bgid = group;
+    if (sys_io_uring_register(ring->fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        int err = -errno;
+        free(br->base);
+        munmap(br->ring, br->ring_size);
+        memset(br, 0, sizeof(*br));
+        return err;
+    }
+
+    br->buffer_size = size;
+    br->count = count;
+    br->mask = count - 1;
+    br->group = group;
+    for (unsigned i = 0; i < count; i++) {
+        uring_buf_ring_add(br, (uint16_t)i);
+    }
+    uring_buf_ring_commit(br);
+    return 0;
+}
+
+void uring_buf_ring_destroy(uring_t *ring, uring_buf_ring_t *br) {
+    if (!br->ring) {
+        return;
+    }
+    struct io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.bgid = br->group;
+    sys_io_uring_register(ring->fd, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+    munmap(br->ring, br->ring_size);
+    free(br->base);
+    memset(br, 0, sizeof(*br));
+}
@@ -0,0 +1,253 @@
+/**
+ * @file uring.h
+ * @brief Minimal io_uring wrapper for the verifier daemon
+ *
+ * Just enough of io_uring for a single-threaded socket server, on the raw
+ * system calls so the daemon does not depend on liburing: ring setup and
+ * teardown, SQE preparation for multishot accept and receive, send and
+ * read, batched completion reaping, and provided-buffer rings that the
+ * kernel fills on multishot receive.
+ *
+ * A ring belongs to one thread; nothing here is thread-safe. Requires
+ * Linux 6.0 or later for multishot receive.
+ */
+
+#ifndef VERIFIER_URING_H
+#define VERIFIER_URING_H
+
+#include <linux/io_uring.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+/**
+ * @brief Submission and completion rings mapped from the kernel
+ */
+typedef struct {
+    int fd;
+    unsigned flags;                     /**< IORING_SETUP_* in effect */
+    unsigned features;                  /**< IORING_FEAT_* reported by the kernel */
+
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_array;
+    unsigned sq_mask;
+    unsigned sq_entries;
+    unsigned sq_local_tail;             /**< SQEs prepared but not yet published */
+    struct io_uring_sqe *sqes;
+
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned cq_mask;
+    struct io_uring_cqe *cqes;
+
+    void *sq_map;
+    size_t sq_map_size;
+    void *cq_map;
+    size_t cq_map_size;
+    size_t sqes_size;
+} uring_t;
+
+/**
+ * @brief Provided-buffer ring registered with a uring_t
+ *
+ * count buffers of size bytes each, carved from one allocation. The
+ * kernel picks a buffer for each receive completion; the application hands
+ * it back with uring_buf_ring_add() and uring_buf_ring_commit() once the
+ * data has been consumed.
+ */
+typedef struct {
+    struct io_uring_buf_ring *ring;
+    size_t ring_size;
+    uint8_t *base;
+    size_t buffer_size;
+    unsigned count;
+    unsigned mask;
+    uint16_t local_tail;
+    uint16_t group;
+} uring_buf_ring_t;
+
+// ============================================================================
+// Ring Lifecycle
+// ============================================================================
+
+/**
+ * @brief Create a ring
+ *
+ * Asks for single-issuer, deferred task-run mode and a completion queue
+ * four times the submission queue, falling back to defaults on kernels that
+ * refuse them.
+ *
+ * @param[out] ring Ring to initialize
+ * @param[in] entries Submission queue entries (power of two)
+ * @return 0 on success, -errno on failure
+ */
+int uring_init(uring_t *ring, unsigned entries);
+
+void uring_destroy(uring_t *ring);
+
+/**
+ * @brief Next free SQE, zeroed
+ * @return The SQE, or NULL if the submission queue is full (submit first)
+ */
+struct io_uring_sqe *uring_get_sqe(uring_t *ring);
+
+/**
+ * @brief Publish prepared SQEs and optionally wait for completions
+ *
+ * Always reaps: with IORING_SETUP_DEFER_TASKRUN, completions are only
+ * posted from inside this call.
+ *
+ * @param[in] wait_nr Completions to wait for, 0 to submit and reap without blocking
+ * @return SQEs consumed, or -errno (-EINTR and -ETIME are not fatal)
+ */
+int uring_submit_and_wait(uring_t *ring, unsigned wait_nr);
+
+/**
+ * @brief Completions ready to be reaped
+ */
+static inline unsigned uring_cq_ready(const uring_t *ring) {
+    return __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE) - *ring->cq_head;
+}
+
+/**
+ * @brief i-th ready completion, i < uring_cq_ready()
+ */
+static inline struct io_uring_cqe *uring_cqe_at(uring_t *ring, unsigned i) {
+    return &ring->cqes[(*ring->cq_head + i) & ring->cq_mask];
+}
+
+/**
+ * @brief Release n reaped completions back to the kernel
+ */
+static inline void uring_cq_advance(uring_t *ring, unsigned n) {
+    __atomic_store_n(ring->cq_head, *ring->cq_head + n, __ATOMIC_RELEASE);
+}
+
+// ============================================================================
+// Provided Buffers
+// ============================================================================
+
+/**
+ * @brief Allocate count buffers of size bytes and register them as group
+ *
+ * @param[in] count Number of buffers (power of two, at most 32768)
+ * @return 0 on success, -errno on failure
+ */
+int uring_buf_ring_init(uring_t *ring, uring_buf_ring_t *br, uint16_t group,
+                        unsigned count, size_t size);
+
+void uring_buf_ring_destroy(uring_t *ring, uring_buf_ring_t *br);
+
+static inline uint8_t *uring_buf_ring_buffer(const uring_buf_ring_t *br, uint16_t bid) {
+    return br->base + (size_t)bid * br->buffer_size;
+}
+
+/**
+ * @brief Queue buffer bid for return to the kernel
+ */
+static inline void uring_buf_ring_add(uring_buf_ring_t *br, uint16_t bid) {
+    struct io_uring_buf *buf = &br->ring->bufs[br->local_tail & br->mask];
+    buf->addr = (uint64_t)(uintptr_t)uring_buf_ring_buffer(br, bid);
+    buf->len = (uint32_t)br->buffer_size;
+    buf->bid = bid;
+    br->local_tail++;
+}
+
+/**
+ * @brief Make the buffers queued by uring_buf_ring_add() visible to the kernel
+ */
+static inline void uring_buf_ring_commit(uring_buf_ring_t *br) {
+    __atomic_store_n(&br->ring->tail, br->local_tail, __ATOMIC_RELEASE);
+}
+
+// ============================================================================
+// SQE Preparation
+// ============================================================================
+
+static inline void uring_prep_rw(struct io_uring_sqe *sqe, uint8_t op, int fd,
+                                 const void *addr, uint32_t len, uint64_t user_data) {
+    sqe->opcode = op;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)addr;
+    sqe->len = len;
+    sqe->user_data = user_data;
+}
+
+/**
+ * @brief Accept connections until cancelled, one completion per connection
+ */
+static inline void uring_prep_accept_multishot(struct io_uring_sqe *sqe, int fd,
+                                               uint64_t user_data) {
+    uring_prep_rw(sqe, IORING_OP_ACCEPT, fd, NULL, 0, user_data);
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_CLOEXEC;
+}
+
+/**
+ * @brief Receive into buffers from group until the peer closes or buffers run out
+ *
+ * Each completion names its buffer in cqe->flags; IORING_CQE_F_MORE clear
+ * means the receive has ended and must be re-armed.
+ */
+static inline void uring_prep_recv_multishot(struct io_uring_sqe *sqe, int fd, uint16_t group,
+                                             uint64_t user_data) {
+    uring_prep_rw(sqe, IORING_OP_RECV, fd, NULL, 0, user_data);
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = group;
+}
+
+static inline void uring_prep_send(struct io_uring_sqe *sqe, int fd, const void *buf,
+                                   uint32_t len, uint64_t user_data) {
+    uring_prep_rw(sqe, IORING_OP_SEND, fd, buf, len, user_data);
+    sqe->msg_flags = MSG_NOSIGNAL;
+}
+
+static inline void uring_prep_read(struct io_uring_sqe *sqe, int fd, void *buf, uint32_t len,
+                                   uint64_t user_data) {
+    uring_prep_rw(sqe, IORING_OP_READ, fd, buf, len, user_data);
+    sqe->off = (uint64_t)-1;
+}
+
+/**
+ * @brief One-shot readiness notification, for files whose reads io_uring
+ *        cannot complete itself (signalfd)
+ */
+static inline void uring_prep_poll_add(struct io_uring_sqe *sqe, int fd, uint32_t events,
+                                       uint64_t user_data) {
+    uring_prep_rw(sqe, IORING_OP_POLL_ADD, fd, NULL, 0, user_data);
+    sqe->poll32_events = events;
+}
+
+/**
+ * @brief Cancel the request submitted with target as its user_data
+ *
+ * A cancelled multishot request ends with -ECANCELED and IORING_CQE_F_MORE
+ * clear; completions it posted before that still arrive.
+ */
+static inline void uring_prep_cancel(struct io_uring_sqe *sqe, uint64_t target,
+                                     uint64_t user_data) {
+    uring_prep_rw(sqe, IORING_OP_ASYNC_CANCEL, -1, NULL, 0, user_data);
+    sqe->addr = target;
+}
+
+static inline void uring_prep_cancel_fd(struct io_uring_sqe *sqe, int fd, uint64_t user_data) {
+    uring_prep_rw(sqe, IORING_OP_ASYNC_CANCEL, fd, NULL, 0, user_data);
+    sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VERIFIER_URING_H */
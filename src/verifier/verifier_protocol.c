@@ -0,0 +1,180 @@
+/**
+ * @file verifier_protocol.c
+ * @brief Compact report encoding and framing for the verifier daemon wire format
+ */
+
+#include "verifier_protocol.h"
+#include <string.h>
+
+/**
+ * @brief Bytes of the report prefix that carry data for count measurements
+ */
+static size_t report_prefix_bytes(uint32_t count) {
+    return VERIFIER_REPORT_FIXED_BYTES + (size_t)count * sizeof(platform_measurement_t);
+}
+
+size_t verifier_report_size(const attestation_report_t *report) {
+    if (!report || report->measurement_count > MAX_MEASUREMENTS_PER_REPORT ||
+        report->signature_length > DILITHIUM_SIGNATUREBYTES) {
+        return 0;
+    }
+    return report_prefix_bytes(report->measurement_count) + sizeof(uint32_t) +
+           report->signature_length;
+}
+
+size_t verifier_encode_report(uint8_t *out, size_t capacity,
+                              const attestation_report_t *report) {
+    size_t size = verifier_report_size(report);
+    if (size == 0 || !out || capacity < size) {
+        return 0;
+    }
+
+    size_t prefix = report_prefix_bytes(report->measurement_count);
+    memcpy(out, report, prefix);
+    memcpy(out + prefix, &report->signature_length, sizeof(uint32_t));
+    memcpy(out + prefix + sizeof(uint32_t), report->signature, report->signature_length);
+    return size;
+}
+
+pqc_result_t verifier_decode_report(attestation_report_t *report,
+                                    const uint8_t *payload, size_t length) {
+    if (!report || !payload || length < VERIFIER_REPORT_FIXED_BYTES + sizeof(uint32_t)) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    uint32_t count;
+    memcpy(&count, payload + offsetof(attestation_report_t, measurement_count), sizeof(count));
+    if (count > MAX_MEASUREMENTS_PER_REPORT) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    size_t prefix = report_prefix_bytes(count);
+    if (length < prefix + sizeof(uint32_t)) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    uint32_t siglen;
+    memcpy(&siglen, payload + prefix, sizeof(siglen));
+    if (siglen > DILITHIUM_SIGNATUREBYTES || length != prefix + sizeof(uint32_t) + siglen) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+
+    // Only the unsent parts need clearing; the signed region must match the
+    // zero-filled struct the device hashed
+    memcpy(report, payload, prefix);
+    memset((uint8_t *)report + prefix, 0, ATTESTATION_REPORT_SIGNED_BYTES - prefix);
+    report->signature_length = siglen;
+    memcpy(report->signature, payload + prefix + sizeof(uint32_t), siglen);
+    memset(report->signature + siglen, 0, DILITHIUM_SIGNATUREBYTES - siglen);
+    return PQC_SUCCESS;
+}
+
+void verifier_frame_header_init(verifier_frame_header_t *header, verifier_frame_type_t type,
+                                uint32_t length, uint64_t request_id) {
+    header->magic = VERIFIER_MAGIC;
+    header->version = VERIFIER_PROTOCOL_VERSION;
+    header->type = (uint16_t)type;
+    header->length = length;
+    header->reserved = 0;
+    header->request_id = request_id;
+}
+
+pqc_result_t verifier_frame_header_check(const verifier_frame_header_t *header) {
+    if (header->magic != VERIFIER_MAGIC || header->version != VERIFIER_PROTOCOL_VERSION) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    switch (header->type) {
+        case VERIFIER_FRAME_REPORT:
+            return header->length >= VERIFIER_REPORT_FIXED_BYTES + sizeof(uint32_t) &&
+                           header->length <= VERIFIER_MAX_REPORT_BYTES
+                       ? PQC_SUCCESS
+                       : PQC_ERROR_INVALID_PARAMETER;
+        case VERIFIER_FRAME_ENROLL:
+            return header->length == sizeof(verifier_enroll_t) ? PQC_SUCCESS
+                                                               : PQC_ERROR_INVALID_PARAMETER;
+        case VERIFIER_FRAME_RESULT:
+            return header->length == sizeof(verifier_result_t) ? PQC_SUCCESS
+                                                               : PQC_ERROR_INVALID_PARAMETER;
+        default:
+            return PQC_ERROR_INVALID_PARAMETER;
+    }
+}
+
+/**
+ * @brief Bytes the frame starting at data needs in total
+ * @return Header size until the header is complete, then the frame size;
+ *         0 for a malformed header
+ */
+static size_t frame_need(const uint8_t *data, size_t length) {
+    if (length < sizeof(verifier_frame_header_t)) {
+        return sizeof(verifier_frame_header_t);
+    }
+    verifier_frame_header_t header;
+    memcpy(&header, data, sizeof(header));
+    if (verifier_frame_header_check(&header) != PQC_SUCCESS) {
+        return 0;
+    }
+    return sizeof(header) + header.length;
+}
+
+int verifier_frame_split(verifier_reassembly_t *r, const uint8_t *data, size_t length,
+                         size_t *consumed, verifier_frame_fn fn, void *user) {
+    verifier_frame_header_t header;
+    size_t used = 0;
+    int result = 0;
+
+    for (;;) {
+        if (r->length > 0) {
+            // Finish the split frame first, header then payload
+            size_t need = frame_need(r->buffer, r->length);
+            if (need == 0) {
+                result = -1;
+                break;
+            }
+            if (r->length < need) {
+                size_t take = need - r->length < length - used ? need - r->length
+                                                                : length - used;
+                if (take == 0) {
+                    break;
+                }
+                memcpy(r->buffer + r->length, data + used, take);
+                r->length += take;
+                used += take;
+                continue;
+            }
+            memcpy(&header, r->buffer, sizeof(header));
+            result = fn(user, &header, r->buffer + sizeof(header));
+            if (result != 0) {
+                break;
+            }
+            r->length = 0;
+            continue;
+        }
+
+        size_t remaining = length - used;
+        if (remaining == 0) {
+            break;
+        }
+        size_t need = frame_need(data + used, remaining);
+        if (need == 0) {
+            result = -1;
+            break;
+        }
+        if (remaining < need) {
+            memcpy(r->buffer, data + used, remaining);
+            r->length = remaining;
+            used = length;
+            break;
+        }
+        memcpy(&header, data + used, sizeof(header));
+        result = fn(user, &header, data + used + sizeof(header));
+        if (result != 0) {
+            break;
+        }
+        used += need;
+    }
+
+    if (consumed) {
+        *consumed = used;
+    }
+    return result < 0 ? -1 : result > 0;
+}
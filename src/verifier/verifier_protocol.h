@@ -0,0 +1,200 @@
+/**
+ * @file verifier_protocol.h
+ * @brief Wire format spoken by the verifier daemon (verifierd)
+ *
+ * Clients send frames over a stream socket (AF_UNIX or TCP loopback); each
+ * frame is a fixed header followed by `length` payload bytes. A client
+ * enrolls a device's public key once, if the daemon accepts enrollment
+ * from clients, and then streams its reports; every request is answered
+ * by one RESULT frame carrying the same request_id.
+ * Results can arrive in any order and several may share one segment.
+ *
+ * Reports travel in compact form: the attestation_report_t prefix up to and
+ * including the measurement_count used measurements, then the signature
+ * length and the signature itself, so a report with few measurements and a
+ * short signature is a fraction of sizeof(attestation_report_t). The
+ * decoder rebuilds the zero-filled struct the signature covers.
+ *
+ * All integers are in host byte order and the report prefix uses the host
+ * struct layout: the protocol is for local sockets between processes built
+ * for the same ABI, not for the network.
+ */
+
+#ifndef VERIFIER_PROTOCOL_H
+#define VERIFIER_PROTOCOL_H
+
+#include "../crypto/pqc_common.h"
+#include "../crypto/dilithium.h"
+#include "../attestation/attestation_engine.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+#define VERIFIER_MAGIC              0x44565150u     /**< "PQVD" little-endian */
+#define VERIFIER_PROTOCOL_VERSION   1
+
+/** Report bytes before the measurement array, always sent */
+#define VERIFIER_REPORT_FIXED_BYTES offsetof(attestation_report_t, measurements)
+
+/** Largest compact report: every measurement and a full signature */
+#define VERIFIER_MAX_REPORT_BYTES \
+    (VERIFIER_REPORT_FIXED_BYTES + \
+     MAX_MEASUREMENTS_PER_REPORT * sizeof(platform_measurement_t) + \
+     sizeof(uint32_t) + DILITHIUM_SIGNATUREBYTES)
+
+/** Largest frame a peer may send */
+#define VERIFIER_MAX_FRAME_BYTES \
+    (sizeof(verifier_frame_header_t) + VERIFIER_MAX_REPORT_BYTES)
+
+/**
+ * @brief Frame types
+ */
+typedef enum {
+    VERIFIER_FRAME_REPORT = 1,          /**< Compact attestation report */
+    VERIFIER_FRAME_ENROLL = 2,          /**< verifier_enroll_t; refused with
+                                             PQC_ERROR_NOT_IMPLEMENTED unless enabled */
+    VERIFIER_FRAME_RESULT = 0x81        /**< verifier_result_t, daemon to client */
+} verifier_frame_type_t;
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+/**
+ * @brief Header in front of every frame
+ */
+typedef struct {
+    uint32_t magic;                     /**< VERIFIER_MAGIC */
+    uint16_t version;                   /**< VERIFIER_PROTOCOL_VERSION */
+    uint16_t type;                      /**< verifier_frame_type_t */
+    uint32_t length;                    /**< Payload bytes after the header */
+    uint32_t reserved;                  /**< Zero */
+    uint64_t request_id;                /**< Chosen by the client, echoed in the result */
+} verifier_frame_header_t;
+
+/**
+ * @brief ENROLL payload: register or replace a device's key
+ */
+typedef struct {
+    uint8_t device_id[DEVICE_ID_LENGTH];
+    dilithium_public_key_t public_key;
+} verifier_enroll_t;
+
+/**
+ * @brief RESULT payload
+ */
+typedef struct {
+    int32_t status;                     /**< pqc_result_t of the operation */
+    uint32_t error_code;                /**< attestation_error_t, reports only */
+    uint32_t trust_level;               /**< trust_level_t, reports only */
+    uint32_t reserved;                  /**< Zero */
+} verifier_result_t;
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+/**
+ * @brief Compact encoding size of a report
+ * @return Payload bytes, or 0 if the report's counts are out of range
+ */
+size_t verifier_report_size(const attestation_report_t *report);
+
+/**
+ * @brief Encode a report in compact form
+ *
+ * @param[out] out Payload buffer
+ * @param[in] capacity Size of out
+ * @param[in] report Report to encode
+ * @return Bytes written, 0 if the report is malformed or out is too small
+ */
+size_t verifier_encode_report(uint8_t *out, size_t capacity,
+                              const attestation_report_t *report);
+
+/**
+ * @brief Decode a compact report
+ *
+ * The unused measurement slots and the tail of the signature are zeroed,
+ * reproducing the struct attestation_generate_report() signed.
+ *
+ * @param[out] report Decoded report
+ * @param[in] payload Frame payload
+ * @param[in] length Payload length
+ * @return PQC_SUCCESS, or PQC_ERROR_INVALID_PARAMETER for a malformed payload
+ */
+pqc_result_t verifier_decode_report(attestation_report_t *report,
+                                    const uint8_t *payload, size_t length);
+
+/**
+ * @brief Fill in a frame header
+ */
+void verifier_frame_header_init(verifier_frame_header_t *header, verifier_frame_type_t type,
+                                uint32_t length, uint64_t request_id);
+
+/**
+ * @brief Check a received header
+ *
+ * A REPORT must be long enough for the fixed prefix and the signature
+ * length; verifier_decode_report() checks the rest.
+ *
+ * @return PQC_SUCCESS if magic, version and length are acceptable for the
+ *         frame type, PQC_ERROR_INVALID_PARAMETER otherwise
+ */
+pqc_result_t verifier_frame_header_check(const verifier_frame_header_t *header);
+
+// ============================================================================
+// Framing
+// ============================================================================
+
+/**
+ * @brief A frame split across receives, held until its last byte arrives
+ */
+typedef struct {
+    uint8_t *buffer;                    /**< VERIFIER_MAX_FRAME_BYTES, owned by the caller */
+    size_t length;                      /**< Bytes held */
+} verifier_reassembly_t;
+
+/**
+ * @brief Handle one complete frame
+ *
+ * The header has passed verifier_frame_header_check(); payload holds
+ * header->length bytes and is only valid during the call.
+ *
+ * @return 0 to go on, 1 to stop before this frame so that the next
+ *         verifier_frame_split() offers it again, -1 if it is malformed
+ */
+typedef int (*verifier_frame_fn)(void *user, const verifier_frame_header_t *header,
+                                 const uint8_t *payload);
+
+/**
+ * @brief Cut received bytes into frames
+ *
+ * Whole frames are handed to fn in place; only the tail of data that does
+ * not complete a frame is copied into r. After fn stops, the bytes past
+ * *consumed must be offered again, after any that arrived meanwhile are
+ * appended; a frame that was complete in r is retried even with length 0.
+ *
+ * @param[in,out] r Reassembly state of the stream
+ * @param[in] data Received bytes
+ * @param[in] length Bytes in data
+ * @param[out] consumed Bytes of data used, including those copied into r
+ * @param[in] fn Frame handler
+ * @param[in] user Passed to fn
+ * @return 0 once every byte is used, 1 if fn stopped, -1 at a malformed
+ *         header or frame, after which the stream cannot be resynchronised
+ */
+int verifier_frame_split(verifier_reassembly_t *r, const uint8_t *data, size_t length,
+                         size_t *consumed, verifier_frame_fn fn, void *user);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VERIFIER_PROTOCOL_H */
@@ -0,0 +1,1381 @@
+/**
+ * @file verifierd.c
+ * @brief Native attestation verifier daemon
+ *
+ * Accepts compact reports (verifier_protocol.h) over a Unix stream socket
+ * and/or TCP on the loopback interface and verifies them on per-core
+ * shards. One I/O thread drives everything through a single io_uring:
+ * multishot accept on the listeners, multishot receive into a ring of
+ * provided buffers, and one send per connection per batch of results. It
+ * parses frames in place, routes each to the verify_engine shard that owns
+ * its device_id and decodes the report straight into the shard's request
+ * slot.
+ *
+ * Each shard answers through its own single-producer response ring, which
+ * only the I/O thread consumes, so the hot path takes no locks. The I/O
+ * thread is woken through an eventfd only when it has announced it is
+ * about to sleep, so a busy daemon makes no wakeup system calls at all.
+ *
+ * When a shard falls behind, its request queue fills and the I/O thread
+ * stops reading from each connection whose next frame is for that shard
+ * until it drains, which pushes back on those clients through their
+ * socket buffers instead of queueing without bound.
+ *
+ * Devices are enrolled from the --keys file. ENROLL frames from clients
+ * are refused with PQC_ERROR_NOT_IMPLEMENTED unless --allow-enroll is
+ * given, since any local process could otherwise replace a device's key.
+ *
+ * On SIGINT or SIGTERM the daemon prints per-thread CPU time, so the share
+ * spent on I/O can be compared with the share spent verifying.
+ *
+ * Usage: verifierd [--unix PATH] [--tcp PORT] [--shards N] [--keys FILE]
+ *                  [--queue-depth D] [--expanded-keys K] [--replay-window S]
+ *                  [--result-cache N] [--result-ttl S] [--failure-threshold F]
+ *                  [--throttle-rate R] [--golden FILE] [--prefetch-lead MS]
+ *                  [--allow-enroll] [--no-pin]
+ */
+
+#define _GNU_SOURCE
+
+#include "verifier_protocol.h"
+#include "verify_engine.h"
+#include "report_cache.h"
+#include "uring.h"
+#include "../crypto/pqc_common.h"
+#include "../crypto/secure_memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <getopt.h>
+#include <signal.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/un.h>
+
+#define VERIFIERD_RING_ENTRIES      1024    /**< Submission queue entries */
+#define VERIFIERD_RECV_BUFFERS      256     /**< Provided receive buffers */
+#define VERIFIERD_RECV_BUFFER_SIZE  32768
+#define VERIFIERD_FAILURE_THRESHOLD 16      /**< Default --failure-threshold */
+#define VERIFIERD_PREFETCH_LEAD     1000    /**< Default --prefetch-lead, ms */
+#define VERIFIERD_RECV_GROUP        0
+#define VERIFIERD_MAX_CONNECTIONS   4096
+#define VERIFIERD_LISTEN_BACKLOG    512
+#define VERIFIERD_CACHE_LINE        64
+#define VERIFIERD_NO_CONN           UINT32_MAX
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+/**
+ * @brief Completion kinds, the top byte of a CQE's user_data
+ */
+typedef enum {
+    VERIFIERD_OP_ACCEPT = 1,
+    VERIFIERD_OP_RECV = 2,
+    VERIFIERD_OP_SEND = 3,
+    VERIFIERD_OP_WAKE = 4,
+    VERIFIERD_OP_SIGNAL = 5,
+    VERIFIERD_OP_CANCEL = 6
+} verifierd_op_t;
+
+/**
+ * @brief Result handed back from a shard to the I/O thread
+ */
+typedef struct {
+    uint32_t conn;
+    uint32_t gen;
+    uint64_t request_id;
+    verifier_result_t result;
+} verifierd_response_t;
+
+/**
+ * @brief Single-producer single-consumer ring indices
+ *
+ * Each side keeps a cached copy of the other side's index on its own cache
+ * line and reloads it only when the ring looks full (producer) or empty
+ * (consumer).
+ */
+typedef struct {
+    _Alignas(VERIFIERD_CACHE_LINE) _Atomic uint32_t tail;
+    uint32_t head_cache;                /**< Producer's view of head */
+    _Alignas(VERIFIERD_CACHE_LINE) _Atomic uint32_t head;
+    uint32_t tail_cache;                /**< Consumer's view of tail */
+    _Alignas(VERIFIERD_CACHE_LINE) uint32_t mask;
+} verifierd_spsc_t;
+
+/**
+ * @brief Results of one shard on their way to the I/O thread
+ */
+typedef struct {
+    verifierd_spsc_t ring;
+    verifierd_response_t *slots;
+} verifierd_responses_t;
+
+/**
+ * @brief Bytes of one connection, results out or frames held back
+ */
+typedef struct {
+    uint8_t *data;
+    size_t length;
+    size_t capacity;
+} verifierd_buffer_t;
+
+typedef struct {
+    int fd;                             /**< -1 when the slot is free */
+    uint32_t gen;
+    bool recv_armed;
+    bool sending;
+    bool peer_closed;
+    bool broken;
+    bool dirty;                         /**< On the I/O thread's flush list */
+    bool stalled;                       /**< Waiting for room at a shard */
+    uint32_t inflight;                  /**< Requests at shards */
+    verifier_reassembly_t rx;           /**< A frame split across receives */
+    verifierd_buffer_t backlog;         /**< Received while stalled, not yet parsed */
+    verifierd_buffer_t pending;         /**< Results not yet sent */
+    verifierd_buffer_t flight;          /**< Results being sent */
+    size_t flight_offset;
+} verifierd_conn_t;
+
+typedef struct {
+    const char *unix_path;
+    int tcp_port;
+    int shards;
+    const char *keys;
+    size_t queue_depth;
+    size_t expanded_keys;
+    uint32_t replay_window;
+    size_t result_cache;
+    uint32_t result_ttl;
+    uint32_t failure_threshold;
+    uint32_t throttle_rate;
+    const char *golden;
+    uint32_t prefetch_lead;
+    bool allow_enroll;                  /**< Accept ENROLL frames from clients */
+    bool pin;
+} verifierd_options_t;
+
+/**
+ * @brief State of the I/O thread
+ */
+typedef struct {
+    const verifierd_options_t *opts;
+    uring_t ring;
+    uring_buf_ring_t buffers;
+    int listeners[2];
+    bool listener_tcp[2];
+    int nlisteners;
+    int event_fd;                       /**< Written by shards with results */
+    int signal_fd;
+    uint64_t event_value;
+    _Atomic bool sleeping;
+    bool stop;
+
+    verify_engine_t *engine;
+    golden_db_t *golden;                /**< Known-good measurements, or NULL */
+    verifierd_responses_t *responses;   /**< One per shard */
+    int nshards;
+
+    verifierd_conn_t *conns;
+    uint32_t *free_conns;
+    uint32_t nfree;
+    uint32_t *flush;                    /**< Connections with new results */
+    uint32_t nflush;
+    uint32_t *stalled;                  /**< Connections waiting for room at a shard */
+    uint32_t nstalled;
+
+    uint64_t frames;
+    uint64_t malformed;
+    uint64_t refused;                   /**< ENROLL frames without --allow-enroll */
+    uint64_t accepted;
+    uint64_t backpressure;              /**< Times a full shard queue held up a connection
+                                             or the key file */
+} verifierd_t;
+
+static const uint8_t g_zero_device[DEVICE_ID_LENGTH];
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint64_t thread_cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t user_data(verifierd_op_t op, uint32_t conn, uint32_t gen) {
+    return ((uint64_t)op << 56) | ((uint64_t)(conn & 0xFFFFFF) << 32) | gen;
+}
+
+static verifierd_op_t user_data_op(uint64_t data) {
+    return (verifierd_op_t)(data >> 56);
+}
+
+static uint32_t user_data_conn(uint64_t data) {
+    return (uint32_t)(data >> 32) & 0xFFFFFF;
+}
+
+static void eventfd_signal(int fd) {
+    uint64_t one = 1;
+    while (write(fd, &one, sizeof(one)) < 0 && errno == EINTR) {
+    }
+}
+
+// ============================================================================
+// SPSC Rings
+// ============================================================================
+
+static void spsc_init(verifierd_spsc_t *q, uint32_t depth) {
+    atomic_init(&q->tail, 0);
+    atomic_init(&q->head, 0);
+    q->head_cache = 0;
+    q->tail_cache = 0;
+    q->mask = depth - 1;
+}
+
+/**
+ * @brief Slot the producer may fill next
+ * @return Slot index, or -1 while the ring is full
+ */
+static int64_t spsc_reserve(verifierd_spsc_t *q) {
+    uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    if (tail - q->head_cache > q->mask) {
+        q->head_cache = atomic_load_explicit(&q->head, memory_order_acquire);
+        if (tail - q->head_cache > q->mask) {
+            return -1;
+        }
+    }
+    return (int64_t)(tail & q->mask);
+}
+
+static void spsc_publish(verifierd_spsc_t *q) {
+    uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+}
+
+/**
+ * @brief Slot the consumer may read next
+ * @return Slot index, or -1 while the ring is empty
+ */
+static int64_t spsc_peek(verifierd_spsc_t *q) {
+    uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    if (head == q->tail_cache) {
+        q->tail_cache = atomic_load_explicit(&q->tail, memory_order_acquire);
+        if (head == q->tail_cache) {
+            return -1;
+        }
+    }
+    return (int64_t)(head & q->mask);
+}
+
+static void spsc_release(verifierd_spsc_t *q) {
+    uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+}
+
+static bool spsc_empty(verifierd_spsc_t *q) {
+    return atomic_load_explicit(&q->head, memory_order_relaxed) ==
+           atomic_load_explicit(&q->tail, memory_order_acquire);
+}
+
+// ============================================================================
+// Verification Results
+// ============================================================================
+
+static uint64_t request_context(uint32_t conn, uint32_t gen) {
+    return ((uint64_t)conn << 32) | gen;
+}
+
+/**
+ * @brief Wake the I/O thread if it has announced it is about to sleep
+ */
+static void notify_io(verifierd_t *d) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&d->sleeping, memory_order_relaxed) &&
+        atomic_exchange(&d->sleeping, false)) {
+        eventfd_signal(d->event_fd);
+    }
+}
+
+/**
+ * @brief verify_engine_complete_fn: queue a result for the I/O thread
+ */
+static void on_verified(void *user, int shard, const verify_request_t *request,
+                        const verifier_result_t *result) {
+    verifierd_t *d = user;
+    verifierd_responses_t *responses = &d->responses[shard];
+    int64_t slot;
+    while ((slot = spsc_reserve(&responses->ring)) < 0) {
+        // The I/O thread is behind; make sure it is awake and step aside
+        if (atomic_exchange(&d->sleeping, false)) {
+            eventfd_signal(d->event_fd);
+        }
+        sched_yield();
+    }
+    verifierd_response_t *response = &responses->slots[slot];
+    response->conn = (uint32_t)(request->context >> 32);
+    response->gen = (uint32_t)request->context;
+    response->request_id = request->request_id;
+    response->result = *result;
+    spsc_publish(&responses->ring);
+}
+
+static void on_verified_batch(void *user, int shard) {
+    (void)shard;
+    notify_io(user);
+}
+
+static int engine_start(verifierd_t *d) {
+    const verifierd_options_t *opts = d->opts;
+    d->nshards = opts->shards;
+    d->responses = calloc((size_t)d->nshards, sizeof(verifierd_responses_t));
+    if (!d->responses) {
+        return -1;
+    }
+    // Room for everything a shard can have queued plus one batch in hand
+    uint32_t depth = (uint32_t)opts->queue_depth * 2;
+    for (int i = 0; i < d->nshards; i++) {
+        spsc_init(&d->responses[i].ring, depth);
+        d->responses[i].slots = malloc(depth * sizeof(verifierd_response_t));
+        if (!d->responses[i].slots) {
+            return -1;
+        }
+    }
+
+    verify_engine_config_t config = {
+        .shards = opts->shards,
+        .pin = opts->pin,
+        .queue_depth = opts->queue_depth,
+        .expanded_keys = opts->expanded_keys,
+        .replay_window = opts->replay_window,
+        .result_cache = opts->result_cache,
+        .result_ttl = opts->result_ttl,
+        .failure_threshold = opts->failure_threshold,
+        .throttle_rate = opts->throttle_rate,
+        .golden = d->golden,
+        .prefetch_lead = opts->prefetch_lead,
+        .complete = on_verified,
+        .batch_done = on_verified_batch,
+        .user = d
+    };
+    return verify_engine_create(&d->engine, &config) == PQC_SUCCESS ? 0 : -1;
+}
+
+static void engine_free(verifierd_t *d) {
+    verify_engine_destroy(d->engine);
+    d->engine = NULL;
+    golden_db_close(d->golden);
+    d->golden = NULL;
+    for (int i = 0; d->responses && i < d->nshards; i++) {
+        free(d->responses[i].slots);
+    }
+    free(d->responses);
+    d->responses = NULL;
+}
+
+// ============================================================================
+// Connections
+// ============================================================================
+
+static struct io_uring_sqe *get_sqe(verifierd_t *d) {
+    struct io_uring_sqe *sqe;
+    while ((sqe = uring_get_sqe(&d->ring)) == NULL) {
+        uring_submit_and_wait(&d->ring, 0);
+    }
+    return sqe;
+}
+
+static void arm_recv(verifierd_t *d, uint32_t index) {
+    verifierd_conn_t *c = &d->conns[index];
+    struct io_uring_sqe *sqe = get_sqe(d);
+    uring_prep_recv_multishot(sqe, c->fd, VERIFIERD_RECV_GROUP,
+                              user_data(VERIFIERD_OP_RECV, index, c->gen));
+    c->recv_armed = true;
+}
+
+static int conn_open(verifierd_t *d, int fd, bool tcp) {
+    if (d->nfree == 0) {
+        return -1;
+    }
+    uint32_t index = d->free_conns[--d->nfree];
+    verifierd_conn_t *c = &d->conns[index];
+    c->rx.buffer = malloc(VERIFIER_MAX_FRAME_BYTES);
+    if (!c->rx.buffer) {
+        d->free_conns[d->nfree++] = index;
+        return -1;
+    }
+    c->fd = fd;
+    c->rx.length = 0;
+    c->recv_armed = false;
+    c->sending = false;
+    c->peer_closed = false;
+    c->broken = false;
+    c->dirty = false;
+    c->stalled = false;
+    c->inflight = 0;
+    c->flight_offset = 0;
+    if (tcp) {
+        // Results are already batched; Nagle would only add delay
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    arm_recv(d, index);
+    d->accepted++;
+    return 0;
+}
+
+/**
+ * @brief Release a connection once nothing refers to it any more
+ *
+ * A connection lingers after the peer closes or misbehaves until its
+ * receive has ended, the frames it held back are dispatched, its shards
+ * have answered and its results are sent.
+ */
+static void conn_maybe_close(verifierd_t *d, uint32_t index) {
+    verifierd_conn_t *c = &d->conns[index];
+    if (c->fd < 0 || !(c->peer_closed || c->broken) || c->recv_armed || c->sending ||
+        c->stalled || c->inflight > 0 || c->dirty || (c->pending.length > 0 && !c->broken)) {
+        return;
+    }
+    close(c->fd);
+    c->fd = -1;
+    c->gen++;
+    free(c->rx.buffer);
+    c->rx.buffer = NULL;
+    free(c->backlog.data);
+    free(c->pending.data);
+    free(c->flight.data);
+    memset(&c->backlog, 0, sizeof(c->backlog));
+    memset(&c->pending, 0, sizeof(c->pending));
+    memset(&c->flight, 0, sizeof(c->flight));
+    d->free_conns[d->nfree++] = index;
+}
+
+/**
+ * @brief Drop a connection that hit an I/O error
+ *
+ * shutdown() ends the multishot receive; the connection is released by
+ * conn_maybe_close() once the completions drain.
+ */
+static void conn_break(verifierd_t *d, uint32_t index) {
+    verifierd_conn_t *c = &d->conns[index];
+    if (!c->broken) {
+        c->broken = true;
+        shutdown(c->fd, SHUT_RDWR);
+    }
+}
+
+/**
+ * @brief Stop reading from a peer that sent a malformed frame
+ *
+ * Requests accepted before the bad frame are still answered; the
+ * connection closes once they have been sent.
+ */
+static void conn_reject(verifierd_t *d, uint32_t index) {
+    verifierd_conn_t *c = &d->conns[index];
+    d->malformed++;
+    c->peer_closed = true;
+    shutdown(c->fd, SHUT_RD);
+}
+
+static int buffer_reserve(verifierd_buffer_t *b, size_t extra) {
+    if (b->length + extra <= b->capacity) {
+        return 0;
+    }
+    size_t capacity = b->capacity ? b->capacity : 4096;
+    while (capacity < b->length + extra) {
+        capacity *= 2;
+    }
+    uint8_t *data = realloc(b->data, capacity);
+    if (!data) {
+        return -1;
+    }
+    b->data = data;
+    b->capacity = capacity;
+    return 0;
+}
+
+/**
+ * @brief Put a connection on the list flush_all() visits after this pass
+ */
+static void conn_mark_dirty(verifierd_t *d, uint32_t index) {
+    verifierd_conn_t *c = &d->conns[index];
+    if (!c->dirty) {
+        c->dirty = true;
+        d->flush[d->nflush++] = index;
+    }
+}
+
+static void conn_queue_result(verifierd_t *d, uint32_t index, uint64_t request_id,
+                              const verifier_result_t *result) {
+    verifierd_conn_t *c = &d->conns[index];
+    conn_mark_dirty(d, index);
+    if (c->broken) {
+        return;
+    }
+    if (buffer_reserve(&c->pending, sizeof(verifier_frame_header_t) + sizeof(*result)) != 0) {
+        conn_break(d, index);
+        return;
+    }
+    verifier_frame_header_t header;
+    verifier_frame_header_init(&header, VERIFIER_FRAME_RESULT, sizeof(*result), request_id);
+    memcpy(c->pending.data + c->pending.length, &header, sizeof(header));
+    memcpy(c->pending.data + c->pending.length + sizeof(header), result, sizeof(*result));
+    c->pending.length += sizeof(header) + sizeof(*result);
+}
+
+static void conn_send(verifierd_t *d, uint32_t index) {
+    verifierd_conn_t *c = &d->conns[index];
+    struct io_uring_sqe *sqe = get_sqe(d);
+    uring_prep_send(sqe, c->fd, c->flight.data + c->flight_offset,
+                    (uint32_t)(c->flight.length - c->flight_offset),
+                    user_data(VERIFIERD_OP_SEND, index, c->gen));
+    c->sending = true;
+}
+
+/**
+ * @brief Start sending a connection's pending results unless a send is in flight
+ */
+static void conn_flush(verifierd_t *d, uint32_t index) {
+    verifierd_conn_t *c = &d->conns[index];
+    if (c->sending || c->pending.length == 0 || c->broken) {
+        return;
+    }
+    verifierd_buffer_t tmp = c->flight;
+    c->flight = c->pending;
+    c->pending = tmp;
+    c->pending.length = 0;
+    c->flight_offset = 0;
+    conn_send(d, index);
+}
+
+static void flush_all(verifierd_t *d) {
+    for (uint32_t i = 0; i < d->nflush; i++) {
+        uint32_t index = d->flush[i];
+        d->conns[index].dirty = false;
+        conn_flush(d, index);
+        conn_maybe_close(d, index);
+    }
+    d->nflush = 0;
+}
+
+// ============================================================================
+// Request Routing
+// ============================================================================
+
+/**
+ * @brief Move shard results onto their connections
+ * @return Results collected
+ */
+static size_t collect_responses(verifierd_t *d) {
+    size_t collected = 0;
+    for (int s = 0; s < d->nshards; s++) {
+        verifierd_responses_t *responses = &d->responses[s];
+        int64_t slot;
+        while ((slot = spsc_peek(&responses->ring)) >= 0) {
+            const verifierd_response_t *response = &responses->slots[slot];
+            if (response->conn != VERIFIERD_NO_CONN) {
+                verifierd_conn_t *c = &d->conns[response->conn];
+                if (c->fd >= 0 && c->gen == response->gen) {
+                    c->inflight--;
+                    conn_queue_result(d, response->conn, response->request_id,
+                                      &response->result);
+                }
+            }
+            spsc_release(&responses->ring);
+            collected++;
+        }
+    }
+    return collected;
+}
+
+/**
+ * @brief Request slot on a shard for the key file, waiting for room
+ *
+ * Runs before the I/O loop, so it sleeps on the eventfd itself: the shard
+ * signals it after releasing slots once the sleep is announced. Results
+ * are collected meanwhile, otherwise a shard blocked on a full response
+ * ring could never free a request slot.
+ */
+static verify_request_t *shard_wait(verifierd_t *d, int s) {
+    verify_request_t *req = verify_engine_reserve(d->engine, s);
+    if (req) {
+        return req;
+    }
+    d->backpressure++;
+    for (;;) {
+        collect_responses(d);
+        atomic_store(&d->sleeping, true);
+        atomic_thread_fence(memory_order_seq_cst);
+        if ((req = verify_engine_reserve(d->engine, s)) != NULL) {
+            atomic_store(&d->sleeping, false);
+            return req;
+        }
+        uint64_t value;
+        while (read(d->event_fd, &value, sizeof(value)) < 0 && errno == EINTR) {
+        }
+    }
+}
+
+/**
+ * @brief Decode one frame straight into its shard's request queue
+ *
+ * A key file record waits for room at its shard; a connection's frame does
+ * not, the connection stalls instead. A client's ENROLL is answered here
+ * unless --allow-enroll is given.
+ *
+ * @return 0, 1 if the shard's queue is full, or -1 if the frame is
+ *         malformed and the connection must go
+ */
+static int dispatch_frame(verifierd_t *d, uint32_t conn, uint32_t gen,
+                          const verifier_frame_header_t *header, const uint8_t *payload) {
+    const uint8_t *device_id;
+    if (header->type == VERIFIER_FRAME_REPORT) {
+        device_id = payload + offsetof(attestation_report_t, device_id);
+    } else if (header->type == VERIFIER_FRAME_ENROLL) {
+        if (conn != VERIFIERD_NO_CONN && !d->opts->allow_enroll) {
+            verifier_result_t refused = { .status = PQC_ERROR_NOT_IMPLEMENTED };
+            conn_queue_result(d, conn, header->request_id, &refused);
+            d->refused++;
+            return 0;
+        }
+        device_id = payload + offsetof(verifier_enroll_t, device_id);
+    } else {
+        return -1;
+    }
+    if (memcmp(device_id, g_zero_device, DEVICE_ID_LENGTH) == 0) {
+        return -1;
+    }
+
+    int s = verify_engine_shard_of(d->engine, device_id);
+    verify_request_t *req = conn == VERIFIERD_NO_CONN ? shard_wait(d, s)
+                                                      : verify_engine_reserve(d->engine, s);
+    if (!req) {
+        return 1;
+    }
+    req->context = request_context(conn, gen);
+    req->request_id = header->request_id;
+    if (header->type == VERIFIER_FRAME_REPORT) {
+        req->type = VERIFY_REQUEST_REPORT;
+        if (verifier_decode_report(&req->u.report, payload, header->length) != PQC_SUCCESS) {
+            req->type = VERIFY_REQUEST_NONE;
+            verify_engine_commit(d->engine, s, req);
+            return -1;
+        }
+    } else {
+        req->type = VERIFY_REQUEST_ENROLL;
+        memcpy(&req->u.enroll, payload, sizeof(verifier_enroll_t));
+    }
+    verify_engine_commit(d->engine, s, req);
+    d->frames++;
+    if (conn != VERIFIERD_NO_CONN) {
+        d->conns[conn].inflight++;
+    }
+    return 0;
+}
+
+/**
+ * @brief Where verifier_frame_split() hands a connection's frames
+ */
+typedef struct {
+    verifierd_t *d;
+    uint32_t index;
+} verifierd_frame_target_t;
+
+static int on_frame(void *user, const verifier_frame_header_t *header, const uint8_t *payload) {
+    const verifierd_frame_target_t *target = user;
+    return dispatch_frame(target->d, target->index, target->d->conns[target->index].gen,
+                          header, payload);
+}
+
+/**
+ * @brief Hold received bytes back until the connection's shard has room
+ */
+static void conn_park(verifierd_t *d, uint32_t index, const uint8_t *data, size_t length) {
+    verifierd_conn_t *c = &d->conns[index];
+    if (buffer_reserve(&c->backlog, length) != 0) {
+        conn_break(d, index);
+        return;
+    }
+    memcpy(c->backlog.data + c->backlog.length, data, length);
+    c->backlog.length += length;
+}
+
+/**
+ * @brief Stop reading from a connection whose next frame found its shard full
+ *
+ * The multishot receive is cancelled rather than left to fill the provided
+ * buffers; what it already delivered is parked. resume_stalled() picks the
+ * connection up again once the shard has room.
+ */
+static void conn_stall(verifierd_t *d, uint32_t index) {
+    verifierd_conn_t *c = &d->conns[index];
+    c->stalled = true;
+    d->stalled[d->nstalled++] = index;
+    d->backpressure++;
+    if (c->recv_armed) {
+        struct io_uring_sqe *sqe = get_sqe(d);
+        uring_prep_cancel(sqe, user_data(VERIFIERD_OP_RECV, index, c->gen),
+                          user_data(VERIFIERD_OP_CANCEL, index, c->gen));
+    }
+}
+
+/**
+ * @brief Parse received bytes into frames
+ *
+ * Whole frames are dispatched from the receive buffer in place; only a
+ * frame split across receives is copied into the connection's reassembly
+ * buffer. Once a shard is full, this and everything after it is parked.
+ */
+static void conn_consume(verifierd_t *d, uint32_t index, const uint8_t *data, size_t length) {
+    verifierd_conn_t *c = &d->conns[index];
+    if (c->stalled) {
+        conn_park(d, index, data, length);
+        return;
+    }
+    verifierd_frame_target_t target = { d, index };
+    size_t consumed;
+    int result = verifier_frame_split(&c->rx, data, length, &consumed, on_frame, &target);
+    if (result < 0) {
+        conn_reject(d, index);
+    } else if (result > 0) {
+        conn_stall(d, index);
+        conn_park(d, index, data + consumed, length - consumed);
+    }
+}
+
+/**
+ * @brief Dispatch a stalled connection's parked frames
+ * @return true once the connection is no longer stalled
+ */
+static bool conn_resume(verifierd_t *d, uint32_t index) {
+    verifierd_conn_t *c = &d->conns[index];
+    int result = 0;
+    if (!c->broken) {
+        verifierd_frame_target_t target = { d, index };
+        size_t consumed;
+        result = verifier_frame_split(&c->rx, c->backlog.data, c->backlog.length, &consumed,
+                                      on_frame, &target);
+        if (result > 0) {
+            memmove(c->backlog.data, c->backlog.data + consumed, c->backlog.length - consumed);
+            c->backlog.length -= consumed;
+            return false;
+        }
+    }
+    c->backlog.length = 0;
+    c->stalled = false;
+    if (result < 0) {
+        conn_reject(d, index);
+    } else if (!c->recv_armed && !c->peer_closed && !c->broken && !d->stop) {
+        arm_recv(d, index);
+    }
+    conn_maybe_close(d, index);
+    return true;
+}
+
+/**
+ * @brief Retry every stalled connection
+ * @return true if any of them is reading again
+ */
+static bool resume_stalled(verifierd_t *d) {
+    bool resumed = false;
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < d->nstalled; i++) {
+        uint32_t index = d->stalled[i];
+        if (conn_resume(d, index)) {
+            resumed = true;
+        } else {
+            d->stalled[kept++] = index;
+        }
+    }
+    d->nstalled = kept;
+    return resumed;
+}
+
+// ============================================================================
+// Completions
+// ============================================================================
+
+static void arm_accept(verifierd_t *d, int listener) {
+    struct io_uring_sqe *sqe = get_sqe(d);
+    uring_prep_accept_multishot(sqe, d->listeners[listener],
+                                user_data(VERIFIERD_OP_ACCEPT, (uint32_t)listener, 0));
+}
+
+static void arm_wake(verifierd_t *d) {
+    struct io_uring_sqe *sqe = get_sqe(d);
+    uring_prep_read(sqe, d->event_fd, &d->event_value, sizeof(d->event_value),
+                    user_data(VERIFIERD_OP_WAKE, 0, 0));
+}
+
+/**
+ * @brief Watch the signalfd
+ *
+ * A read would be handed to an io_uring worker that never sees the
+ * process's signals, so poll for readiness instead.
+ */
+static void arm_signal(verifierd_t *d) {
+    struct io_uring_sqe *sqe = get_sqe(d);
+    uring_prep_poll_add(sqe, d->signal_fd, POLLIN, user_data(VERIFIERD_OP_SIGNAL, 0, 0));
+}
+
+static void on_accept(verifierd_t *d, const struct io_uring_cqe *cqe) {
+    int listener = (int)user_data_conn(cqe->user_data);
+    if (cqe->res >= 0 && conn_open(d, cqe->res, d->listener_tcp[listener]) != 0) {
+        close(cqe->res);
+    }
+    if (!(cqe->flags & IORING_CQE_F_MORE) && !d->stop) {
+        arm_accept(d, listener);
+    }
+}
+
+static bool on_recv(verifierd_t *d, const struct io_uring_cqe *cqe) {
+    uint32_t index = user_data_conn(cqe->user_data);
+    verifierd_conn_t *c = &d->conns[index];
+    bool returned = false;
+
+    if (cqe->flags & IORING_CQE_F_BUFFER) {
+        uint16_t bid = (uint16_t)(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+        if (cqe->res > 0 && !c->broken && !c->peer_closed) {
+            conn_consume(d, index, uring_buf_ring_buffer(&d->buffers, bid), (size_t)cqe->res);
+        }
+        uring_buf_ring_add(&d->buffers, bid);
+        returned = true;
+    }
+
+    if (cqe->res == 0) {
+        c->peer_closed = true;
+    } else if (cqe->res < 0 && cqe->res != -ENOBUFS && cqe->res != -ECANCELED) {
+        conn_break(d, index);
+    }
+    if (!(cqe->flags & IORING_CQE_F_MORE)) {
+        c->recv_armed = false;
+        // Out of buffers, a receive that ended early or a stall that has
+        // already cleared: pick up where it left off
+        if (!c->peer_closed && !c->broken && !c->stalled && !d->stop) {
+            arm_recv(d, index);
+        }
+    }
+    conn_maybe_close(d, index);
+    return returned;
+}
+
+static void on_send(verifierd_t *d, const struct io_uring_cqe *cqe) {
+    uint32_t index = user_data_conn(cqe->user_data);
+    verifierd_conn_t *c = &d->conns[index];
+    c->sending = false;
+
+    if (cqe->res < 0) {
+        conn_break(d, index);
+    } else {
+        c->flight_offset += (size_t)cqe->res;
+        if (c->flight_offset < c->flight.length && !c->broken) {
+            conn_send(d, index);
+        } else {
+            c->flight.length = 0;
+            conn_flush(d, index);
+        }
+    }
+    conn_maybe_close(d, index);
+}
+
+static void process_completions(verifierd_t *d) {
+    unsigned ready = uring_cq_ready(&d->ring);
+    bool buffers_returned = false;
+
+    for (unsigned i = 0; i < ready; i++) {
+        const struct io_uring_cqe *cqe = uring_cqe_at(&d->ring, i);
+        switch (user_data_op(cqe->user_data)) {
+            case VERIFIERD_OP_ACCEPT:
+                on_accept(d, cqe);
+                break;
+            case VERIFIERD_OP_RECV:
+                buffers_returned |= on_recv(d, cqe);
+                break;
+            case VERIFIERD_OP_SEND:
+                on_send(d, cqe);
+                break;
+            case VERIFIERD_OP_WAKE:
+                if (!d->stop) {
+                    arm_wake(d);
+                }
+                break;
+            case VERIFIERD_OP_SIGNAL:
+                d->stop = true;
+                break;
+            case VERIFIERD_OP_CANCEL:
+                // The cancelled receive's last completion says how it ended
+                break;
+            default:
+                break;
+        }
+    }
+    uring_cq_advance(&d->ring, ready);
+
+    if (buffers_returned) {
+        uring_buf_ring_commit(&d->buffers);
+    }
+}
+
+/**
+ * @brief The I/O thread's loop
+ *
+ * Each pass reaps every ready completion, which hands the new requests to
+ * their shards, moves finished results onto their connections, resumes
+ * connections whose shards have room again and submits one send per
+ * connection. It sleeps in io_uring_enter() only after telling the shards
+ * to wake it and finding nothing left to collect and no stalled
+ * connection able to go on; a shard releasing slots after that wakes it.
+ */
+static void io_loop(verifierd_t *d) {
+    for (;;) {
+        process_completions(d);
+        collect_responses(d);
+        resume_stalled(d);
+        flush_all(d);
+        if (d->stop) {
+            break;
+        }
+
+        if (uring_cq_ready(&d->ring) > 0) {
+            uring_submit_and_wait(&d->ring, 0);
+            continue;
+        }
+
+        atomic_store(&d->sleeping, true);
+        atomic_thread_fence(memory_order_seq_cst);
+        bool pending = false;
+        for (int s = 0; s < d->nshards && !pending; s++) {
+            pending = !spsc_empty(&d->responses[s].ring);
+        }
+        if (!pending && d->nstalled > 0) {
+            pending = resume_stalled(d);
+        }
+        if (pending) {
+            atomic_store(&d->sleeping, false);
+            uring_submit_and_wait(&d->ring, 0);
+            continue;
+        }
+        int ret = uring_submit_and_wait(&d->ring, 1);
+        atomic_store(&d->sleeping, false);
+        if (ret < 0 && ret != -EINTR && ret != -ETIME && ret != -EBUSY) {
+            fprintf(stderr, "io_uring_enter: %s\n", strerror(-ret));
+            break;
+        }
+    }
+}
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+static int listen_unix(const char *path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "%s: path too long\n", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+    unlink(path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(fd, VERIFIERD_LISTEN_BACKLOG) != 0) {
+        perror(path);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+static int listen_tcp(int port) {
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    int one = 1;
+    if (fd < 0 || setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0 ||
+        bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(fd, VERIFIERD_LISTEN_BACKLOG) != 0) {
+        perror("tcp listener");
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Enroll every record of a key file, routed like ENROLL frames
+ *
+ * The file is a sequence of verifier_enroll_t records.
+ */
+static int preload_keys(verifierd_t *d, const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    verifier_enroll_t *record = malloc(sizeof(*record));
+    if (!record) {
+        fclose(f);
+        return -1;
+    }
+    verifier_frame_header_t header;
+    verifier_frame_header_init(&header, VERIFIER_FRAME_ENROLL, sizeof(*record), 0);
+
+    size_t loaded = 0;
+    int result = 0;
+    while (fread(record, sizeof(*record), 1, f) == 1) {
+        if (dispatch_frame(d, VERIFIERD_NO_CONN, 0, &header, (const uint8_t *)record) != 0) {
+            fprintf(stderr, "%s: invalid record %zu\n", path, loaded);
+            result = -1;
+            break;
+        }
+        loaded++;
+    }
+    secure_memzero(record, sizeof(*record));
+    free(record);
+    fclose(f);
+    if (result == 0) {
+        fprintf(stderr, "Loaded %zu device keys from %s\n", loaded, path);
+    }
+    return result;
+}
+
+static int daemon_init(verifierd_t *d, const verifierd_options_t *opts) {
+    memset(d, 0, sizeof(*d));
+    d->opts = opts;
+    d->event_fd = d->signal_fd = -1;
+    atomic_init(&d->sleeping, false);
+
+    d->conns = calloc(VERIFIERD_MAX_CONNECTIONS, sizeof(verifierd_conn_t));
+    d->free_conns = malloc(VERIFIERD_MAX_CONNECTIONS * sizeof(uint32_t));
+    d->flush = malloc(VERIFIERD_MAX_CONNECTIONS * sizeof(uint32_t));
+    d->stalled = malloc(VERIFIERD_MAX_CONNECTIONS * sizeof(uint32_t));
+    if (!d->conns || !d->free_conns || !d->flush || !d->stalled) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < VERIFIERD_MAX_CONNECTIONS; i++) {
+        d->conns[i].fd = -1;
+        d->free_conns[i] = VERIFIERD_MAX_CONNECTIONS - 1 - i;
+    }
+    d->nfree = VERIFIERD_MAX_CONNECTIONS;
+
+    int ret = uring_init(&d->ring, VERIFIERD_RING_ENTRIES);
+    if (ret != 0) {
+        fprintf(stderr, "io_uring_setup: %s\n", strerror(-ret));
+        return -1;
+    }
+    ret = uring_buf_ring_init(&d->ring, &d->buffers, VERIFIERD_RECV_GROUP,
+                              VERIFIERD_RECV_BUFFERS, VERIFIERD_RECV_BUFFER_SIZE);
+    if (ret != 0) {
+        fprintf(stderr, "provided buffers: %s\n", strerror(-ret));
+        return -1;
+    }
+
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &mask, NULL);
+    d->signal_fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    d->event_fd = eventfd(0, EFD_CLOEXEC);
+    if (d->signal_fd < 0 || d->event_fd < 0) {
+        perror("eventfd");
+        return -1;
+    }
+
+    if (opts->golden) {
+        if (golden_db_open(&d->golden, opts->golden) != PQC_SUCCESS) {
+            fprintf(stderr, "%s: not a golden measurement database\n", opts->golden);
+            return -1;
+        }
+        fprintf(stderr, "Loaded %zu golden measurements from %s (generation %llu)\n",
+                golden_db_count(d->golden), opts->golden,
+                (unsigned long long)golden_db_generation(d->golden));
+    }
+
+    // Shards inherit the blocked signal mask, so only the ring sees them
+    if (engine_start(d) != 0) {
+        fprintf(stderr, "Failed to start %d shards\n", opts->shards);
+        return -1;
+    }
+
+    if (opts->unix_path) {
+        int fd = listen_unix(opts->unix_path);
+        if (fd < 0) {
+            return -1;
+        }
+        d->listeners[d->nlisteners++] = fd;
+    }
+    if (opts->tcp_port > 0) {
+        int fd = listen_tcp(opts->tcp_port);
+        if (fd < 0) {
+            return -1;
+        }
+        d->listener_tcp[d->nlisteners] = true;
+        d->listeners[d->nlisteners++] = fd;
+    }
+    return 0;
+}
+
+static void daemon_destroy(verifierd_t *d) {
+    verify_engine_stop(d->engine);
+    for (uint32_t i = 0; d->conns && i < VERIFIERD_MAX_CONNECTIONS; i++) {
+        verifierd_conn_t *c = &d->conns[i];
+        if (c->fd >= 0) {
+            close(c->fd);
+        }
+        free(c->rx.buffer);
+        free(c->backlog.data);
+        free(c->pending.data);
+        free(c->flight.data);
+    }
+    for (int i = 0; i < d->nlisteners; i++) {
+        close(d->listeners[i]);
+    }
+    if (d->opts->unix_path && d->nlisteners > 0) {
+        unlink(d->opts->unix_path);
+    }
+    uring_buf_ring_destroy(&d->ring, &d->buffers);
+    uring_destroy(&d->ring);
+    if (d->event_fd >= 0) {
+        close(d->event_fd);
+    }
+    if (d->signal_fd >= 0) {
+        close(d->signal_fd);
+    }
+    engine_free(d);
+    free(d->conns);
+    free(d->free_conns);
+    free(d->flush);
+    free(d->stalled);
+}
+
+static void print_stats(const verifierd_t *d, uint64_t io_cpu_ns) {
+    verify_engine_stats_t total;
+    memset(&total, 0, sizeof(total));
+    fprintf(stderr, "\n%-8s %12s %12s %12s %12s %12s %12s\n", "shard", "verified", "valid",
+            "devices", "expansions", "prefetched", "cpu (ms)");
+    for (int i = 0; i < d->nshards; i++) {
+        verify_engine_stats_t stats;
+        verify_engine_get_stats(d->engine, i, &stats);
+        fprintf(stderr, "%-8d %12llu %12llu %12llu %12llu %12llu %12.1f\n", i,
+                (unsigned long long)stats.verified, (unsigned long long)stats.valid,
+                (unsigned long long)stats.devices, (unsigned long long)stats.key_expansions,
+                (unsigned long long)stats.key_prefetches, (double)stats.cpu_ns / 1e6);
+        total.verified += stats.verified;
+        total.valid += stats.valid;
+        total.unknown += stats.unknown;
+        total.replayed += stats.replayed;
+        total.throttled += stats.throttled;
+        total.cached += stats.cached;
+        total.key_prefetches += stats.key_prefetches;
+        total.prefetch_hits += stats.prefetch_hits;
+        for (int j = 0; j < ATTESTATION_STAGE_COUNT; j++) {
+            total.rejected[j] += stats.rejected[j];
+        }
+        total.enrolled += stats.enrolled;
+        total.cpu_ns += stats.cpu_ns;
+    }
+
+    uint64_t total_ns = io_cpu_ns + total.cpu_ns;
+    fprintf(stderr, "\nConnections %llu, frames %llu, malformed %llu, enrollments refused %llu, "
+            "shard queue full %llu\n",
+            (unsigned long long)d->accepted, (unsigned long long)d->frames,
+            (unsigned long long)d->malformed, (unsigned long long)d->refused,
+            (unsigned long long)d->backpressure);
+    fprintf(stderr, "Enrolled %llu, reports verified %llu, valid %llu, invalid %llu "
+            "(unknown device %llu, replayed %llu, throttled %llu), answered from cache %llu\n",
+            (unsigned long long)total.enrolled, (unsigned long long)total.verified,
+            (unsigned long long)total.valid,
+            (unsigned long long)(total.verified - total.valid),
+            (unsigned long long)total.unknown, (unsigned long long)total.replayed,
+            (unsigned long long)total.throttled, (unsigned long long)total.cached);
+    fprintf(stderr, "Rejected by stage: structure %llu, freshness %llu, revocation %llu, "
+            "policy %llu, signature %llu\n",
+            (unsigned long long)total.rejected[ATTESTATION_STAGE_STRUCTURE],
+            (unsigned long long)total.rejected[ATTESTATION_STAGE_FRESHNESS],
+            (unsigned long long)total.rejected[ATTESTATION_STAGE_REVOCATION],
+            (unsigned long long)total.rejected[ATTESTATION_STAGE_POLICY],
+            (unsigned long long)total.rejected[ATTESTATION_STAGE_SIGNATURE]);
+    fprintf(stderr, "Keys prefetched %llu, found warm by %llu reports\n",
+            (unsigned long long)total.key_prefetches, (unsigned long long)total.prefetch_hits);
+    fprintf(stderr, "CPU: shards %.1f ms, I/O %.1f ms (%.2f%% of total)\n",
+            (double)total.cpu_ns / 1e6, (double)io_cpu_ns / 1e6,
+            total_ns ? 100.0 * (double)io_cpu_ns / (double)total_ns : 0.0);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --unix PATH        listen on a Unix stream socket\n"
+            "  --tcp PORT         listen on 127.0.0.1:PORT\n"
+            "  --shards N         verification shards (default online CPUs)\n"
+            "  --keys FILE        preload verifier_enroll_t records\n"
+            "  --allow-enroll     accept ENROLL frames from clients; without it only\n"
+            "                     --keys adds devices\n"
+            "  --queue-depth D    request slots per shard, power of two (default %d)\n"
+            "  --expanded-keys K  expanded public keys cached per shard (default %d)\n"
+            "  --replay-window S  reject reports a device already sent in the last S\n"
+            "                     seconds, at most %d (default 0, off)\n"
+            "  --result-cache N   verdicts cached per shard; an identical report\n"
+            "                     gets the cached verdict (default %d, 0 off)\n"
+            "  --result-ttl S     seconds a cached verdict is reused, at most %d\n"
+            "                     (default %d)\n"
+            "  --failure-threshold F\n"
+            "                     throttle a device after about F bad signatures in\n"
+            "                     the last %d seconds, at most %d (default %d, 0 off)\n"
+            "  --throttle-rate R  verifications per second left to a throttled device\n"
+            "                     (default %d)\n"
+            "  --golden FILE      accept only measurements in this golden_db file;\n"
+            "                     restart to pick up a rebuilt one\n"
+            "  --prefetch-lead MS expand a device's key this many milliseconds before\n"
+            "                     its next report is due, at most %d (default %d, 0 off)\n"
+            "  --no-pin           do not pin shards to CPUs\n",
+            argv0, VERIFY_ENGINE_DEFAULT_DEPTH, VERIFY_ENGINE_DEFAULT_EXPANDED_KEYS,
+            VERIFY_ENGINE_MAX_REPLAY_WINDOW, REPORT_CACHE_DEFAULT_ENTRIES,
+            VERIFY_ENGINE_MAX_RESULT_TTL, REPORT_CACHE_DEFAULT_TTL,
+            VERIFY_ENGINE_FAILURE_HALFLIFE, VERIFY_ENGINE_MAX_FAILURE_THRESHOLD,
+            VERIFIERD_FAILURE_THRESHOLD, VERIFY_ENGINE_DEFAULT_THROTTLE_RATE,
+            VERIFY_ENGINE_MAX_PREFETCH_LEAD, VERIFIERD_PREFETCH_LEAD);
+}
+
+static int parse_options(int argc, char **argv, verifierd_options_t *opts) {
+    static const struct option long_opts[] = {
+        { "unix",              required_argument, NULL, 'u' },
+        { "tcp",               required_argument, NULL, 't' },
+        { "shards",            required_argument, NULL, 's' },
+        { "keys",              required_argument, NULL, 'k' },
+        { "queue-depth",       required_argument, NULL, 'q' },
+        { "expanded-keys",     required_argument, NULL, 'e' },
+        { "replay-window",     required_argument, NULL, 'r' },
+        { "result-cache",      required_argument, NULL, 'c' },
+        { "result-ttl",        required_argument, NULL, 'T' },
+        { "failure-threshold", required_argument, NULL, 'f' },
+        { "throttle-rate",     required_argument, NULL, 'R' },
+        { "golden",            required_argument, NULL, 'g' },
+        { "prefetch-lead",     required_argument, NULL, 'p' },
+        { "allow-enroll",      no_argument,       NULL, 'E' },
+        { "no-pin",            no_argument,       NULL, 'P' },
+        { "help",              no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    memset(opts, 0, sizeof(*opts));
+    opts->queue_depth = VERIFY_ENGINE_DEFAULT_DEPTH;
+    opts->result_cache = REPORT_CACHE_DEFAULT_ENTRIES;
+    opts->failure_threshold = VERIFIERD_FAILURE_THRESHOLD;
+    opts->prefetch_lead = VERIFIERD_PREFETCH_LEAD;
+    opts->pin = true;
+
+    int c;
+    while ((c = getopt_long(argc, argv, "u:t:s:k:q:e:r:c:T:f:R:g:p:EPh", long_opts, NULL)) != -1) {
+        switch (c) {
+            case 'u': opts->unix_path = optarg; break;
+            case 't': opts->tcp_port = atoi(optarg); break;
+            case 's': opts->shards = atoi(optarg); break;
+            case 'k': opts->keys = optarg; break;
+            case 'q': opts->queue_depth = strtoul(optarg, NULL, 10); break;
+            case 'e': opts->expanded_keys = strtoul(optarg, NULL, 10); break;
+            case 'r': opts->replay_window = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'c': opts->result_cache = strtoul(optarg, NULL, 10); break;
+            case 'T': opts->result_ttl = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'f': opts->failure_threshold = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'R': opts->throttle_rate = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'g': opts->golden = optarg; break;
+            case 'p': opts->prefetch_lead = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'E': opts->allow_enroll = true; break;
+            case 'P': opts->pin = false; break;
+            default:
+                usage(argv[0]);
+                return -1;
+        }
+    }
+
+    if (opts->shards == 0) {
+        opts->shards = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if ((!opts->unix_path && opts->tcp_port <= 0) || opts->tcp_port > 65535 ||
+        opts->shards < 1 || opts->queue_depth < 2 ||
+        (opts->queue_depth & (opts->queue_depth - 1)) != 0 ||
+        opts->replay_window > VERIFY_ENGINE_MAX_REPLAY_WINDOW ||
+        opts->result_ttl > VERIFY_ENGINE_MAX_RESULT_TTL ||
+        opts->failure_threshold > VERIFY_ENGINE_MAX_FAILURE_THRESHOLD ||
+        opts->throttle_rate > VERIFY_ENGINE_MAX_THROTTLE_RATE ||
+        opts->prefetch_lead > VERIFY_ENGINE_MAX_PREFETCH_LEAD) {
+        usage(argv[0]);
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    verifierd_options_t opts;
+    if (parse_options(argc, argv, &opts) != 0) {
+        return 2;
+    }
+
+    if (pqc_init(NULL) != PQC_SUCCESS) {
+        fprintf(stderr, "pqc_init failed\n");
+        return 1;
+    }
+
+    verifierd_t *d = malloc(sizeof(verifierd_t));
+    if (!d) {
+        return 1;
+    }
+    int exit_code = 0;
+    if (daemon_init(d, &opts) != 0 || (opts.keys && preload_keys(d, opts.keys) != 0)) {
+        exit_code = 1;
+    } else {
+        for (int i = 0; i < d->nlisteners; i++) {
+            arm_accept(d, i);
+        }
+        arm_wake(d);
+        arm_signal(d);
+        fprintf(stderr, "verifierd: %d shards, listening on%s%s%s", d->nshards,
+                opts.unix_path ? " " : "", opts.unix_path ? opts.unix_path : "",
+                opts.tcp_port > 0 ? " 127.0.0.1:" : "");
+        if (opts.tcp_port > 0) {
+            fprintf(stderr, "%d", opts.tcp_port);
+        }
+        fprintf(stderr, "\n");
+
+        io_loop(d);
+        uint64_t io_cpu_ns = thread_cpu_ns();
+        verify_engine_stop(d->engine);
+        print_stats(d, io_cpu_ns);
+    }
+
+    daemon_destroy(d);
+    free(d);
+    pqc_cleanup();
+    return exit_code;
+}
@@ -0,0 +1,1261 @@
+/**
+ * @file verify_engine.c
+ * @brief Sharded per-core report verification engine
+ */
+
+#define _GNU_SOURCE
+
+#include "verify_engine.h"
+#include "report_cache.h"
+#include "../crypto/secure_memory.h"
+#include "../crypto/pqc_executor.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#define VERIFY_ENGINE_CACHE_LINE    64
+#define VERIFY_ENGINE_TABLE_INITIAL 1024    /**< Device table slots per shard */
+#define VERIFY_ENGINE_BATCH         32      /**< Requests handled between batch_done calls */
+#define VERIFY_ENGINE_NO_KEY        UINT32_MAX
+#define VERIFY_ENGINE_SKETCH_DEPTH  4
+#define VERIFY_ENGINE_SKETCH_WIDTH  4096    /**< Counters per sketch row, power of two */
+#define VERIFY_ENGINE_PREFETCH_SLOTS 8      /**< Key expansions in flight per shard */
+#define VERIFY_ENGINE_DUE_INITIAL   256     /**< Prefetch schedule entries per shard */
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+/**
+ * @brief Queue cell
+ *
+ * seq equals the cell's position while it is free for that position's
+ * producer, position + 1 once committed, and position + depth after the
+ * shard has consumed it.
+ */
+typedef struct {
+    _Atomic uint32_t seq;
+    uint32_t pos;                       /**< Position of the reservation, for commit */
+    verify_request_t request;
+} verify_cell_t;
+
+/**
+ * @brief Bounded multi-producer single-consumer queue
+ */
+typedef struct {
+    _Alignas(VERIFY_ENGINE_CACHE_LINE) _Atomic uint32_t enqueue_pos;
+    _Alignas(VERIFY_ENGINE_CACHE_LINE) uint32_t dequeue_pos;    /**< Shard only */
+    uint32_t mask;
+    verify_cell_t *cells;
+} verify_queue_t;
+
+/**
+ * @brief Enrolled device, owned by one shard
+ */
+typedef struct {
+    uint8_t device_id[DEVICE_ID_LENGTH];
+    dilithium_public_key_t public_key;
+    uint8_t fingerprint[REPORT_CACHE_FINGERPRINT_BYTES];   /**< Key fingerprint, with a result cache */
+    uint32_t key;                       /**< Expanded-key cache entry, or VERIFY_ENGINE_NO_KEY */
+    uint64_t newest;                    /**< Latest accepted report timestamp */
+    uint64_t seen;                      /**< Bit i: newest - i was accepted */
+    uint64_t bucket_at;                 /**< Monotonic ms of the last refill, 0 before the
+                                             device was first throttled */
+    uint32_t tokens;                    /**< Token bucket, in thousandths of a verification */
+    uint32_t epoch;                     /**< Enrollments of this device, to spot a key
+                                             replaced while it was being prefetched */
+    uint32_t interval;                  /**< Smoothed ms between valid reports, 0 unknown */
+    uint64_t arrived_at;                /**< Monotonic ms of the last valid report */
+    uint64_t prefetch_at;               /**< Monotonic ms its key is due to be prefetched,
+                                             0 for none */
+} verify_device_t;
+
+/**
+ * @brief Open-addressing index into a shard's device array
+ */
+typedef struct {
+    uint64_t hash;
+    uint32_t entry;                     /**< Device index + 1, 0 for an empty slot */
+} verify_slot_t;
+
+typedef struct {
+    verify_slot_t *slots;
+    size_t mask;
+    verify_device_t *devices;
+    size_t count;
+    size_t capacity;
+} verify_table_t;
+
+/**
+ * @brief Count-min sketch of recent signature failures by device
+ *
+ * Fixed size whatever the number of devices; estimates only err high, and
+ * only when devices collide in every row. Saturates at 255.
+ */
+typedef struct {
+    uint8_t counts[VERIFY_ENGINE_SKETCH_DEPTH][VERIFY_ENGINE_SKETCH_WIDTH];
+    uint64_t aged_at;                   /**< Monotonic ms of the last halving */
+} verify_sketch_t;
+
+/**
+ * @brief Expanded-key cache entry, replaced in CLOCK order
+ */
+typedef struct {
+    dilithium_expanded_public_key_t *epk;   /**< Allocated on first use */
+    uint32_t device;                    /**< Owning device index + 1, 0 when unused */
+    bool referenced;
+    bool prefetched;                    /**< Expanded ahead of a report, not yet used */
+} verify_key_t;
+
+/**
+ * @brief Prefetch schedule entry, in a min-heap by time
+ *
+ * Rescheduling a device leaves its old entry behind; an entry is live only
+ * while at matches the device's prefetch_at.
+ */
+typedef struct {
+    uint64_t at;                        /**< Monotonic ms */
+    uint32_t device;                    /**< Device index */
+} verify_due_t;
+
+typedef enum {
+    PREFETCH_IDLE = 0,                  /**< Owned by the shard */
+    PREFETCH_RUNNING = 1,               /**< Owned by the executor */
+    PREFETCH_DONE = 2                   /**< Owned by the shard, to be installed */
+} verify_prefetch_state_t;
+
+/**
+ * @brief Key expansion run on the executor ahead of a report
+ */
+typedef struct {
+    pqc_task_t task;                    /**< First, so the task is the slot */
+    _Atomic int state;                  /**< verify_prefetch_state_t */
+    struct verify_shard *shard;
+    dilithium_public_key_t public_key;  /**< Copy; the device table may move meanwhile */
+    dilithium_expanded_public_key_t *epk;   /**< Allocated on first use, then traded with
+                                                 the cache entry it is installed in */
+    pqc_result_t result;
+    uint32_t device;                    /**< Device index */
+    uint32_t epoch;                     /**< Device epoch when started */
+} verify_prefetch_t;
+
+typedef struct verify_shard {
+    _Alignas(VERIFY_ENGINE_CACHE_LINE) verify_queue_t queue;
+    _Alignas(VERIFY_ENGINE_CACHE_LINE) _Atomic bool sleeping;
+    _Atomic bool stop;
+    _Atomic uint64_t queue_full;
+    _Atomic uint32_t prefetch_finished; /**< Prefetch tasks that no longer touch the shard */
+    int event_fd;
+    int index;
+    int cpu;                            /**< CPU to pin to, -1 for none */
+    pthread_t thread;
+    struct verify_engine *engine;
+
+    // Owned by the shard thread
+    _Alignas(VERIFY_ENGINE_CACHE_LINE) verify_table_t table;
+    verify_key_t *keys;
+    size_t nkeys;
+    size_t hand;
+    report_cache_t *results;            /**< Verdicts of recent reports, or NULL */
+    verify_sketch_t *failures;          /**< Recent signature failures, or NULL */
+    verify_prefetch_t *prefetch;        /**< VERIFY_ENGINE_PREFETCH_SLOTS, or NULL */
+    uint32_t prefetch_busy;             /**< Slots not idle */
+    uint32_t prefetch_started;
+    verify_due_t *due;                  /**< Prefetch schedule, a min-heap */
+    size_t ndue;
+    size_t due_capacity;
+    verify_engine_stats_t stats;
+} verify_shard_t;
+
+struct verify_engine {
+    verify_engine_config_t config;
+    verify_shard_t *shards;
+    int nshards;
+    pqc_executor_t *executor;           /**< Runs key prefetches, or NULL to run them
+                                             on the shard */
+    int running;                        /**< Shard threads started and not yet joined */
+};
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+#ifdef PQC_ENABLE_TESTING
+static _Atomic uint64_t g_clock_offset_ms;
+
+void verify_engine_advance_clock(uint32_t ms) {
+    atomic_fetch_add(&g_clock_offset_ms, ms);
+}
+#endif
+
+static uint64_t monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t now = (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+#ifdef PQC_ENABLE_TESTING
+    now += atomic_load(&g_clock_offset_ms);
+#endif
+    return now;
+}
+
+static uint64_t thread_cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief FNV-1a over the device identifier with a final avalanche
+ *
+ * The high half picks the shard and the low half the table slot, so the
+ * two stay independent.
+ */
+static uint64_t device_hash(const uint8_t *device_id) {
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < DEVICE_ID_LENGTH; i++) {
+        h = (h ^ device_id[i]) * 0x100000001B3ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static void eventfd_signal(int fd) {
+    uint64_t one = 1;
+    while (write(fd, &one, sizeof(one)) < 0 && errno == EINTR) {
+    }
+}
+
+static void shard_wake(verify_shard_t *shard) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&shard->sleeping, memory_order_relaxed) &&
+        atomic_exchange(&shard->sleeping, false)) {
+        eventfd_signal(shard->event_fd);
+    }
+}
+
+// ============================================================================
+// Request Queue
+// ============================================================================
+
+static int queue_init(verify_queue_t *q, uint32_t depth) {
+    q->cells = malloc(depth * sizeof(verify_cell_t));
+    if (!q->cells) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < depth; i++) {
+        atomic_init(&q->cells[i].seq, i);
+    }
+    atomic_init(&q->enqueue_pos, 0);
+    q->dequeue_pos = 0;
+    q->mask = depth - 1;
+    return 0;
+}
+
+static void queue_destroy(verify_queue_t *q) {
+    if (q->cells) {
+        secure_memzero(q->cells, (q->mask + 1) * sizeof(verify_cell_t));
+    }
+    free(q->cells);
+    q->cells = NULL;
+}
+
+/**
+ * @brief Claim the next position, or NULL if its cell is still unconsumed
+ */
+static verify_cell_t *queue_reserve(verify_queue_t *q) {
+    uint32_t pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+    for (;;) {
+        verify_cell_t *cell = &q->cells[pos & q->mask];
+        uint32_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        int32_t diff = (int32_t)(seq - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                cell->pos = pos;
+                return cell;
+            }
+        } else if (diff < 0) {
+            return NULL;
+        } else {
+            pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+static void queue_commit(verify_cell_t *cell) {
+    atomic_store_explicit(&cell->seq, cell->pos + 1, memory_order_release);
+}
+
+/**
+ * @brief Next committed cell in order, or NULL
+ */
+static verify_cell_t *queue_peek(verify_queue_t *q) {
+    verify_cell_t *cell = &q->cells[q->dequeue_pos & q->mask];
+    uint32_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+    return seq == q->dequeue_pos + 1 ? cell : NULL;
+}
+
+static void queue_release(verify_queue_t *q, verify_cell_t *cell) {
+    atomic_store_explicit(&cell->seq, q->dequeue_pos + q->mask + 1, memory_order_release);
+    q->dequeue_pos++;
+}
+
+// ============================================================================
+// Device Table
+// ============================================================================
+
+static int table_init(verify_table_t *t, size_t slots) {
+    memset(t, 0, sizeof(*t));
+    t->slots = calloc(slots, sizeof(verify_slot_t));
+    if (!t->slots) {
+        return -1;
+    }
+    t->mask = slots - 1;
+    return 0;
+}
+
+static void table_destroy(verify_table_t *t) {
+    if (t->devices) {
+        secure_memzero(t->devices, t->capacity * sizeof(verify_device_t));
+    }
+    free(t->devices);
+    free(t->slots);
+    memset(t, 0, sizeof(*t));
+}
+
+static verify_device_t *table_find(verify_table_t *t, const uint8_t *device_id, uint64_t hash) {
+    for (size_t i = hash & t->mask;; i = (i + 1) & t->mask) {
+        const verify_slot_t *slot = &t->slots[i];
+        if (slot->entry == 0) {
+            return NULL;
+        }
+        verify_device_t *dev = &t->devices[slot->entry - 1];
+        if (slot->hash == hash && memcmp(dev->device_id, device_id, DEVICE_ID_LENGTH) == 0) {
+            return dev;
+        }
+    }
+}
+
+static int table_grow(verify_table_t *t) {
+    size_t nslots = (t->mask + 1) * 2;
+    verify_slot_t *slots = calloc(nslots, sizeof(verify_slot_t));
+    if (!slots) {
+        return -1;
+    }
+    for (size_t i = 0; i <= t->mask; i++) {
+        if (t->slots[i].entry == 0) {
+            continue;
+        }
+        size_t j = t->slots[i].hash & (nslots - 1);
+        while (slots[j].entry != 0) {
+            j = (j + 1) & (nslots - 1);
+        }
+        slots[j] = t->slots[i];
+    }
+    free(t->slots);
+    t->slots = slots;
+    t->mask = nslots - 1;
+    return 0;
+}
+
+/**
+ * @brief Add a device
+ * @return The new device, or NULL when out of memory
+ */
+static verify_device_t *table_insert(verify_table_t *t, const uint8_t *device_id, uint64_t hash) {
+    // Keep the load factor at or below one half
+    if ((t->count + 1) * 2 > t->mask + 1 && table_grow(t) != 0) {
+        return NULL;
+    }
+    if (t->count == t->capacity) {
+        size_t capacity = t->capacity ? t->capacity * 2 : 64;
+        verify_device_t *devices = realloc(t->devices, capacity * sizeof(verify_device_t));
+        if (!devices) {
+            return NULL;
+        }
+        t->devices = devices;
+        t->capacity = capacity;
+    }
+
+    verify_device_t *dev = &t->devices[t->count++];
+    memcpy(dev->device_id, device_id, DEVICE_ID_LENGTH);
+
+    size_t i = hash & t->mask;
+    while (t->slots[i].entry != 0) {
+        i = (i + 1) & t->mask;
+    }
+    t->slots[i].hash = hash;
+    t->slots[i].entry = (uint32_t)t->count;
+    return dev;
+}
+
+// ============================================================================
+// Expanded-Key Cache
+// ============================================================================
+
+static void key_release(verify_shard_t *shard, verify_device_t *dev) {
+    if (dev->key != VERIFY_ENGINE_NO_KEY) {
+        shard->keys[dev->key].device = 0;
+        shard->keys[dev->key].referenced = false;
+        shard->keys[dev->key].prefetched = false;
+        dev->key = VERIFY_ENGINE_NO_KEY;
+    }
+}
+
+/**
+ * @brief Free an entry for a new key: the first one the clock hand finds
+ *        unreferenced since its last sweep
+ *
+ * @param[in] keep_prefetched Pass over prefetched keys not yet used, so
+ *            one prefetch does not evict another whose report is sooner
+ * @return The entry, or NULL if keep_prefetched and every entry is one
+ */
+static verify_key_t *key_evict(verify_shard_t *shard, bool keep_prefetched) {
+    verify_key_t *entry;
+    for (size_t visited = 0;; visited++) {
+        entry = &shard->keys[shard->hand];
+        shard->hand = (shard->hand + 1) % shard->nkeys;
+        if (keep_prefetched && entry->prefetched) {
+            // Two sweeps clear every other entry's reference bit
+            if (visited >= 2 * shard->nkeys) {
+                return NULL;
+            }
+            continue;
+        }
+        if (!entry->referenced) {
+            break;
+        }
+        entry->referenced = false;
+    }
+    if (entry->device != 0) {
+        shard->table.devices[entry->device - 1].key = VERIFY_ENGINE_NO_KEY;
+        entry->device = 0;
+    }
+    entry->prefetched = false;
+    return entry;
+}
+
+/**
+ * @brief Expanded form of a device's key, expanding it on a miss
+ *
+ * Devices that report often keep their entry; a miss evicts an entry in
+ * CLOCK order.
+ *
+ * @return The expanded key, or NULL if it could not be allocated
+ */
+static const dilithium_expanded_public_key_t *key_get(verify_shard_t *shard,
+                                                      verify_device_t *dev) {
+    if (dev->key != VERIFY_ENGINE_NO_KEY) {
+        verify_key_t *entry = &shard->keys[dev->key];
+        entry->referenced = true;
+        if (entry->prefetched) {
+            entry->prefetched = false;
+            shard->stats.prefetch_hits++;
+        }
+        return entry->epk;
+    }
+
+    verify_key_t *entry = key_evict(shard, false);
+    if (!entry->epk) {
+        entry->epk = malloc(sizeof(dilithium_expanded_public_key_t));
+        if (!entry->epk) {
+            return NULL;
+        }
+    }
+    if (dilithium_expand_public_key(entry->epk, &dev->public_key) != PQC_SUCCESS) {
+        return NULL;
+    }
+    entry->device = (uint32_t)(dev - shard->table.devices) + 1;
+    entry->referenced = true;
+    dev->key = (uint32_t)(entry - shard->keys);
+    shard->stats.key_expansions++;
+    return entry->epk;
+}
+
+static void keys_destroy(verify_shard_t *shard) {
+    for (size_t i = 0; shard->keys && i < shard->nkeys; i++) {
+        if (shard->keys[i].epk) {
+            secure_memzero(shard->keys[i].epk, sizeof(dilithium_expanded_public_key_t));
+            free(shard->keys[i].epk);
+        }
+    }
+    free(shard->keys);
+    shard->keys = NULL;
+}
+
+// ============================================================================
+// Key Prefetch
+// ============================================================================
+
+static int due_push(verify_shard_t *shard, uint64_t at, uint32_t device) {
+    if (shard->ndue == shard->due_capacity) {
+        size_t capacity = shard->due_capacity ? shard->due_capacity * 2 : VERIFY_ENGINE_DUE_INITIAL;
+        verify_due_t *due = realloc(shard->due, capacity * sizeof(verify_due_t));
+        if (!due) {
+            return -1;
+        }
+        shard->due = due;
+        shard->due_capacity = capacity;
+    }
+    size_t i = shard->ndue++;
+    while (i > 0 && shard->due[(i - 1) / 2].at > at) {
+        shard->due[i] = shard->due[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    shard->due[i].at = at;
+    shard->due[i].device = device;
+    return 0;
+}
+
+static void due_pop(verify_shard_t *shard) {
+    verify_due_t last = shard->due[--shard->ndue];
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= shard->ndue) {
+            break;
+        }
+        if (child + 1 < shard->ndue && shard->due[child + 1].at < shard->due[child].at) {
+            child++;
+        }
+        if (shard->due[child].at >= last.at) {
+            break;
+        }
+        shard->due[i] = shard->due[child];
+        i = child;
+    }
+    if (shard->ndue > 0) {
+        shard->due[i] = last;
+    }
+}
+
+/**
+ * @brief Learn a device's reporting interval from a valid report and
+ *        schedule its key to be prefetched before the next one
+ *
+ * The interval is an exponential moving average (weight 1/4) of the gaps
+ * between arrivals, so a device's jitter or one missed report moves the
+ * prediction only a little. A device that reports more often than the
+ * lead is not scheduled: its key is either kept warm or lost to devices
+ * that report even more often.
+ */
+static void schedule_record(verify_shard_t *shard, verify_device_t *dev, uint64_t now) {
+    if (dev->arrived_at != 0 && now > dev->arrived_at) {
+        uint64_t gap = now - dev->arrived_at;
+        if (gap > UINT32_MAX) {
+            gap = UINT32_MAX;
+        }
+        dev->interval = dev->interval ? dev->interval - dev->interval / 4 + (uint32_t)gap / 4
+                                      : (uint32_t)gap;
+    }
+    dev->arrived_at = now;
+
+    uint32_t lead = shard->engine->config.prefetch_lead;
+    if (dev->interval > lead) {
+        uint64_t at = now + dev->interval - lead;
+        if (due_push(shard, at, (uint32_t)(dev - shard->table.devices)) == 0) {
+            dev->prefetch_at = at;
+        }
+    }
+}
+
+static void prefetch_run(pqc_task_t *task) {
+    verify_prefetch_t *p = (verify_prefetch_t *)task;
+    verify_shard_t *shard = p->shard;
+    p->result = dilithium_expand_public_key(p->epk, &p->public_key);
+    atomic_store_explicit(&p->state, PREFETCH_DONE, memory_order_release);
+    shard_wake(shard);
+    // Last touch: the shard may exit once every started task got here
+    atomic_fetch_add_explicit(&shard->prefetch_finished, 1, memory_order_release);
+}
+
+/**
+ * @brief Expand the keys of devices whose report is about to arrive,
+ *        as far as free slots allow
+ */
+static void prefetch_start(verify_shard_t *shard, uint64_t now) {
+    while (shard->ndue > 0 && shard->due[0].at <= now &&
+           shard->prefetch_busy < VERIFY_ENGINE_PREFETCH_SLOTS) {
+        verify_due_t due = shard->due[0];
+        due_pop(shard);
+        verify_device_t *dev = &shard->table.devices[due.device];
+        if (dev->prefetch_at != due.at) {
+            continue;
+        }
+        dev->prefetch_at = 0;
+        if (dev->key != VERIFY_ENGINE_NO_KEY) {
+            continue;
+        }
+
+        verify_prefetch_t *p = shard->prefetch;
+        while (atomic_load_explicit(&p->state, memory_order_relaxed) != PREFETCH_IDLE) {
+            p++;
+        }
+        if (!p->epk && !(p->epk = malloc(sizeof(dilithium_expanded_public_key_t)))) {
+            return;
+        }
+        memcpy(&p->public_key, &dev->public_key, sizeof(p->public_key));
+        p->device = due.device;
+        p->epoch = dev->epoch;
+        atomic_store_explicit(&p->state, PREFETCH_RUNNING, memory_order_relaxed);
+        shard->prefetch_busy++;
+        shard->prefetch_started++;
+        if (shard->engine->executor) {
+            pqc_executor_submit(shard->engine->executor, &p->task, PQC_TASK_PRIORITY_BULK);
+        } else {
+            prefetch_run(&p->task);
+        }
+    }
+}
+
+/**
+ * @brief Install the keys expanded since the last call
+ *
+ * A key is dropped if its device reported (and expanded it on demand) or
+ * re-enrolled in the meantime, or if the cache holds nothing but other
+ * prefetched keys. Other prefetches leave the installed entry alone until
+ * its report uses it; a miss may still evict it, which is what reclaims
+ * the keys of devices that stopped reporting.
+ */
+static void prefetch_install(verify_shard_t *shard) {
+    for (int i = 0; i < VERIFY_ENGINE_PREFETCH_SLOTS && shard->prefetch_busy > 0; i++) {
+        verify_prefetch_t *p = &shard->prefetch[i];
+        if (atomic_load_explicit(&p->state, memory_order_acquire) != PREFETCH_DONE) {
+            continue;
+        }
+        verify_device_t *dev = &shard->table.devices[p->device];
+        verify_key_t *entry = NULL;
+        if (p->result == PQC_SUCCESS && dev->epoch == p->epoch &&
+            dev->key == VERIFY_ENGINE_NO_KEY && (entry = key_evict(shard, true)) != NULL) {
+            dilithium_expanded_public_key_t *spare = entry->epk;
+            entry->epk = p->epk;
+            p->epk = spare;
+            entry->device = p->device + 1;
+            entry->referenced = true;
+            entry->prefetched = true;
+            dev->key = (uint32_t)(entry - shard->keys);
+            shard->stats.key_prefetches++;
+        }
+        atomic_store_explicit(&p->state, PREFETCH_IDLE, memory_order_relaxed);
+        shard->prefetch_busy--;
+    }
+}
+
+static bool prefetch_ready(verify_shard_t *shard) {
+    for (int i = 0; shard->prefetch && i < VERIFY_ENGINE_PREFETCH_SLOTS; i++) {
+        if (atomic_load_explicit(&shard->prefetch[i].state, memory_order_relaxed) ==
+            PREFETCH_DONE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief How long the shard may sleep before a prefetch is due, -1 for
+ *        until woken
+ */
+static int prefetch_timeout(const verify_shard_t *shard, uint64_t now) {
+    if (!shard->prefetch || shard->ndue == 0 ||
+        shard->prefetch_busy == VERIFY_ENGINE_PREFETCH_SLOTS) {
+        return -1;
+    }
+    uint64_t at = shard->due[0].at;
+    if (at <= now) {
+        return 0;
+    }
+    return at - now < INT_MAX ? (int)(at - now) : INT_MAX;
+}
+
+/**
+ * @brief Wait for every started prefetch, then free them
+ */
+static void prefetch_destroy(verify_shard_t *shard) {
+    if (shard->prefetch) {
+        while (atomic_load_explicit(&shard->prefetch_finished, memory_order_acquire) !=
+               shard->prefetch_started) {
+            poll(NULL, 0, 1);
+        }
+        for (int i = 0; i < VERIFY_ENGINE_PREFETCH_SLOTS; i++) {
+            if (shard->prefetch[i].epk) {
+                secure_memzero(shard->prefetch[i].epk, sizeof(dilithium_expanded_public_key_t));
+                free(shard->prefetch[i].epk);
+            }
+        }
+        free(shard->prefetch);
+        shard->prefetch = NULL;
+    }
+    free(shard->due);
+    shard->due = NULL;
+    shard->ndue = shard->due_capacity = 0;
+}
+
+// ============================================================================
+// Replay Window
+// ============================================================================
+
+/**
+ * @brief Whether a report timestamp would be accepted, sliding window style
+ *
+ * A device may report once per second. A timestamp newer than any seen
+ * is fresh; an older one is fresh once if it is still inside the window.
+ * Checked before the signature, so a stale report costs no verification.
+ */
+static bool replay_fresh(const verify_device_t *dev, uint64_t timestamp, uint32_t window) {
+    if (timestamp > dev->newest) {
+        return true;
+    }
+    uint64_t age = dev->newest - timestamp;
+    return age < window && !(dev->seen & (1ULL << age));
+}
+
+/**
+ * @brief Record the timestamp of a correctly signed, fresh report
+ */
+static void replay_record(verify_device_t *dev, uint64_t timestamp) {
+    if (timestamp > dev->newest) {
+        uint64_t shift = timestamp - dev->newest;
+        dev->seen = shift < 64 ? (dev->seen << shift) | 1 : 1;
+        dev->newest = timestamp;
+        return;
+    }
+    dev->seen |= 1ULL << (dev->newest - timestamp);
+}
+
+// ============================================================================
+// Failure Tracking
+// ============================================================================
+
+/**
+ * @brief Halve every counter once per elapsed half-life
+ */
+static void sketch_age(verify_sketch_t *sketch, uint64_t now_ms) {
+    const uint64_t halflife_ms = VERIFY_ENGINE_FAILURE_HALFLIFE * 1000ULL;
+    uint64_t halvings = (now_ms - sketch->aged_at) / halflife_ms;
+    if (halvings == 0) {
+        return;
+    }
+    sketch->aged_at += halvings * halflife_ms;
+    if (halvings >= 8) {
+        memset(sketch->counts, 0, sizeof(sketch->counts));
+        return;
+    }
+    uint8_t *counts = &sketch->counts[0][0];
+    for (size_t i = 0; i < sizeof(sketch->counts); i++) {
+        counts[i] >>= halvings;
+    }
+}
+
+/**
+ * @brief Column of a device in one row, by double hashing its device hash
+ */
+static size_t sketch_column(uint64_t hash, int row) {
+    uint32_t h1 = (uint32_t)hash;
+    uint32_t h2 = (uint32_t)((hash * 0x9E3779B97F4A7C15ULL) >> 32) | 1;
+    return (h1 + (uint32_t)row * h2) & (VERIFY_ENGINE_SKETCH_WIDTH - 1);
+}
+
+static unsigned sketch_estimate(const verify_sketch_t *sketch, uint64_t hash) {
+    unsigned estimate = UINT8_MAX;
+    for (int row = 0; row < VERIFY_ENGINE_SKETCH_DEPTH; row++) {
+        unsigned count = sketch->counts[row][sketch_column(hash, row)];
+        if (count < estimate) {
+            estimate = count;
+        }
+    }
+    return estimate;
+}
+
+/**
+ * @brief Count a failure, raising only the counters at the current minimum
+ *
+ * The conservative update keeps heavy hitters from inflating the
+ * estimates of the devices that share their counters.
+ */
+static void sketch_add(verify_sketch_t *sketch, uint64_t hash) {
+    unsigned estimate = sketch_estimate(sketch, hash);
+    if (estimate == UINT8_MAX) {
+        return;
+    }
+    for (int row = 0; row < VERIFY_ENGINE_SKETCH_DEPTH; row++) {
+        uint8_t *count = &sketch->counts[row][sketch_column(hash, row)];
+        if (*count == estimate) {
+            (*count)++;
+        }
+    }
+}
+
+/**
+ * @brief Take one verification from a throttled device's token bucket
+ *
+ * The bucket holds up to one second's worth of verifications and starts
+ * full, so a device that has just crossed the threshold is not cut off
+ * mid-burst.
+ *
+ * @return true if the report may be verified
+ */
+static bool bucket_take(verify_device_t *dev, uint32_t rate, uint64_t now_ms) {
+    uint64_t capacity = (uint64_t)rate * 1000;
+    uint64_t tokens = dev->tokens;
+    if (dev->bucket_at == 0) {
+        tokens = capacity;
+    } else if (now_ms > dev->bucket_at) {
+        tokens += (now_ms - dev->bucket_at) * rate;
+        if (tokens > capacity) {
+            tokens = capacity;
+        }
+    }
+    dev->bucket_at = now_ms;
+    if (tokens < 1000) {
+        dev->tokens = (uint32_t)tokens;
+        return false;
+    }
+    dev->tokens = (uint32_t)(tokens - 1000);
+    return true;
+}
+
+// ============================================================================
+// Shards
+// ============================================================================
+
+static pqc_result_t shard_enroll(verify_shard_t *shard, const verifier_enroll_t *enroll) {
+    uint64_t hash = device_hash(enroll->device_id);
+    verify_device_t *dev = table_find(&shard->table, enroll->device_id, hash);
+    if (dev) {
+        key_release(shard, dev);
+    } else {
+        dev = table_insert(&shard->table, enroll->device_id, hash);
+        if (!dev) {
+            return PQC_ERROR_INSUFFICIENT_MEMORY;
+        }
+        dev->epoch = 0;
+    }
+    memcpy(&dev->public_key, &enroll->public_key, sizeof(dev->public_key));
+    if (shard->results) {
+        pqc_result_t result = report_cache_fingerprint(dev->fingerprint, &dev->public_key);
+        if (result != PQC_SUCCESS) {
+            return result;
+        }
+    }
+    dev->key = VERIFY_ENGINE_NO_KEY;
+    dev->epoch++;
+    dev->interval = 0;
+    dev->arrived_at = 0;
+    dev->prefetch_at = 0;
+    dev->newest = 0;
+    dev->seen = 0;
+    dev->bucket_at = 0;
+    dev->tokens = 0;
+    shard->stats.enrolled++;
+    return PQC_SUCCESS;
+}
+
+typedef struct {
+    verify_shard_t *shard;
+    verify_device_t *dev;
+    uint64_t hash;                      /**< device_hash() of the device */
+} verify_call_t;
+
+/**
+ * @brief Whether every checked measurement is a golden digest of its type
+ *
+ * A report with more measurements than fit is left to the structure check
+ * of the attestation engine.
+ */
+static bool golden_accept(const verify_engine_config_t *config, const attestation_report_t *report) {
+    if (report->measurement_count > MAX_MEASUREMENTS_PER_REPORT) {
+        return true;
+    }
+    for (uint32_t i = 0; i < report->measurement_count; i++) {
+        const platform_measurement_t *m = &report->measurements[i];
+        if ((unsigned)m->measurement_type >= 32 ||
+            !(config->golden_types & (1u << m->measurement_type))) {
+            continue;
+        }
+        const golden_record_t *golden = golden_db_lookup(config->golden, m->measurement_value);
+        if (!golden || golden->measurement_type != (uint16_t)m->measurement_type ||
+            (golden->flags & GOLDEN_FLAG_REVOKED)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Check a report stage by stage: structure and clock skew, the
+ *        replay window, golden measurements, then policy and signature
+ *
+ * Runs on a result-cache miss, so a retransmission does not reach the
+ * replay window and is answered with the verdict of its first copy. The
+ * cache drops that verdict at the report's freshness deadline, after
+ * which a copy is verified again and fails the timestamp check.
+ */
+static pqc_result_t device_verify(void *ctx, const attestation_report_t *report,
+                                  attestation_verification_result_t *outcome) {
+    verify_shard_t *shard = ((verify_call_t *)ctx)->shard;
+    verify_device_t *dev = ((verify_call_t *)ctx)->dev;
+
+    // A malformed or skewed report is rejected as such, not as a replay
+    pqc_result_t result = attestation_check_report(report, outcome);
+    if (result != PQC_SUCCESS || outcome->error_code != ATTESTATION_ERROR_NONE) {
+        return result;
+    }
+
+    uint32_t window = shard->engine->config.replay_window;
+    if (window > 0 && !replay_fresh(dev, report->timestamp, window)) {
+        memset(outcome, 0, sizeof(*outcome));
+        outcome->error_code = ATTESTATION_ERROR_REPLAYED;
+        outcome->trust_level = TRUST_LEVEL_UNKNOWN;
+        shard->stats.replayed++;
+        return PQC_SUCCESS;
+    }
+
+    const verify_engine_config_t *config = &shard->engine->config;
+    if (config->golden && !golden_accept(config, report)) {
+        memset(outcome, 0, sizeof(*outcome));
+        outcome->error_code = ATTESTATION_ERROR_POLICY_VIOLATION;
+        outcome->trust_level = TRUST_LEVEL_UNKNOWN;
+        return PQC_SUCCESS;
+    }
+
+    const dilithium_expanded_public_key_t *epk = key_get(shard, dev);
+    if (epk) {
+        result = attestation_verify_report_expanded(report, epk, outcome);
+    } else {
+        result = attestation_verify_report(report, &dev->public_key, outcome);
+    }
+    if (result != PQC_SUCCESS) {
+        return result;
+    }
+
+    // Only a correctly signed report may move the window forward, or the
+    // prefetch schedule
+    if (outcome->is_valid && window > 0) {
+        replay_record(dev, report->timestamp);
+    }
+    if (outcome->is_valid && shard->prefetch) {
+        schedule_record(shard, dev, monotonic_ms());
+    }
+    if (outcome->error_code == ATTESTATION_ERROR_SIGNATURE_INVALID && shard->failures) {
+        sketch_add(shard->failures, ((verify_call_t *)ctx)->hash);
+    }
+    return PQC_SUCCESS;
+}
+
+static void shard_verify(verify_shard_t *shard, const attestation_report_t *report,
+                         verifier_result_t *out) {
+    shard->stats.verified++;
+    uint64_t hash = device_hash(report->device_id);
+    verify_device_t *dev = table_find(&shard->table, report->device_id, hash);
+    if (!dev) {
+        out->status = PQC_SUCCESS;
+        out->error_code = ATTESTATION_ERROR_UNKNOWN_DEVICE;
+        shard->stats.unknown++;
+        shard->stats.rejected[ATTESTATION_STAGE_REVOCATION]++;
+        return;
+    }
+
+    // A device that keeps failing verification gets a token bucket; this
+    // runs before the result cache, whose lookup already hashes the report
+    const verify_engine_config_t *config = &shard->engine->config;
+    if (shard->failures) {
+        uint64_t now = monotonic_ms();
+        sketch_age(shard->failures, now);
+        if (sketch_estimate(shard->failures, hash) >= config->failure_threshold &&
+            !bucket_take(dev, config->throttle_rate, now)) {
+            out->status = PQC_SUCCESS;
+            out->error_code = ATTESTATION_ERROR_RATE_LIMITED;
+            shard->stats.throttled++;
+            shard->stats.rejected[ATTESTATION_STAGE_REVOCATION]++;
+            return;
+        }
+    }
+
+    verify_call_t call = { shard, dev, hash };
+    attestation_verification_result_t outcome;
+    if (shard->results) {
+        report_cache_outcome_t how = REPORT_CACHE_MISS;
+        out->status = report_cache_verify(shard->results, report, dev->fingerprint, device_verify,
+                                          &call, &outcome, &how);
+        shard->stats.cached += (how == REPORT_CACHE_HIT || how == REPORT_CACHE_COALESCED);
+    } else {
+        out->status = device_verify(&call, report, &outcome);
+    }
+    if (out->status != PQC_SUCCESS) {
+        return;
+    }
+    out->error_code = (uint32_t)outcome.error_code;
+    out->trust_level = outcome.trust_level;
+    if (outcome.is_valid) {
+        shard->stats.valid++;
+    } else {
+        shard->stats.rejected[attestation_error_stage(outcome.error_code)]++;
+    }
+}
+
+static void shard_handle(verify_shard_t *shard, const verify_request_t *req) {
+    verifier_result_t result;
+    memset(&result, 0, sizeof(result));
+
+    if (req->type == VERIFY_REQUEST_ENROLL) {
+        result.status = shard_enroll(shard, &req->u.enroll);
+    } else {
+        shard_verify(shard, &req->u.report, &result);
+    }
+    shard->engine->config.complete(shard->engine->config.user, shard->index, req, &result);
+}
+
+static void* shard_main(void *arg) {
+    verify_shard_t *shard = arg;
+    const verify_engine_config_t *config = &shard->engine->config;
+
+    if (shard->cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(shard->cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+
+    // Allocated after pinning so first touch places the shard's state on
+    // its own node
+    shard->nkeys = config->expanded_keys;
+    shard->keys = calloc(shard->nkeys, sizeof(verify_key_t));
+    if (config->failure_threshold > 0) {
+        shard->failures = calloc(1, sizeof(verify_sketch_t));
+    }
+    if (config->prefetch_lead > 0) {
+        shard->prefetch = calloc(VERIFY_ENGINE_PREFETCH_SLOTS, sizeof(verify_prefetch_t));
+    }
+    report_cache_config_t cache_config = { config->result_cache, config->result_ttl };
+    if (!shard->keys || table_init(&shard->table, VERIFY_ENGINE_TABLE_INITIAL) != 0 ||
+        (config->result_cache > 0 &&
+         report_cache_create(&shard->results, &cache_config) != PQC_SUCCESS) ||
+        (config->failure_threshold > 0 && !shard->failures) ||
+        (config->prefetch_lead > 0 && !shard->prefetch)) {
+        fprintf(stderr, "verify shard %d: out of memory\n", shard->index);
+        abort();
+    }
+    if (shard->failures) {
+        shard->failures->aged_at = monotonic_ms();
+    }
+    for (int i = 0; shard->prefetch && i < VERIFY_ENGINE_PREFETCH_SLOTS; i++) {
+        shard->prefetch[i].task.run = prefetch_run;
+        shard->prefetch[i].shard = shard;
+    }
+
+    verify_queue_t *q = &shard->queue;
+    while (!atomic_load_explicit(&shard->stop, memory_order_relaxed)) {
+        if (shard->prefetch) {
+            prefetch_install(shard);
+            prefetch_start(shard, monotonic_ms());
+        }
+
+        int handled = 0;
+        bool released = false;
+        verify_cell_t *cell;
+        while (handled < VERIFY_ENGINE_BATCH && (cell = queue_peek(q)) != NULL) {
+            if (cell->request.type != VERIFY_REQUEST_NONE) {
+                shard_handle(shard, &cell->request);
+                handled++;
+            }
+            queue_release(q, cell);
+            released = true;
+        }
+        // Even a batch of cancelled slots is reported: a producer waiting
+        // for room relies on it
+        if (released) {
+            if (config->batch_done) {
+                config->batch_done(config->user, shard->index);
+            }
+            continue;
+        }
+        if (queue_peek(q)) {
+            continue;
+        }
+
+        // Announce the sleep, then look once more so a commit in between
+        // is not missed
+        atomic_store(&shard->sleeping, true);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (queue_peek(q) || atomic_load_explicit(&shard->stop, memory_order_relaxed) ||
+            prefetch_ready(shard)) {
+            atomic_store(&shard->sleeping, false);
+            continue;
+        }
+        // Sleep until woken or the next prefetch is due
+        int timeout = prefetch_timeout(shard, monotonic_ms());
+        struct pollfd pfd = { .fd = shard->event_fd, .events = POLLIN };
+        if (timeout < 0 || poll(&pfd, 1, timeout) > 0) {
+            uint64_t value;
+            while (read(shard->event_fd, &value, sizeof(value)) < 0 && errno == EINTR) {
+            }
+        }
+        atomic_store(&shard->sleeping, false);
+        shard->stats.wakeups++;
+    }
+
+    shard->stats.devices = shard->table.count;
+    shard->stats.cpu_ns = thread_cpu_ns();
+    prefetch_destroy(shard);
+    keys_destroy(shard);
+    table_destroy(&shard->table);
+    report_cache_destroy(shard->results);
+    shard->results = NULL;
+    free(shard->failures);
+    shard->failures = NULL;
+    return NULL;
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+pqc_result_t verify_engine_create(verify_engine_t **engine, const verify_engine_config_t *config) {
+    if (!engine || !config || !config->complete || config->shards < 0 ||
+        config->replay_window > VERIFY_ENGINE_MAX_REPLAY_WINDOW ||
+        config->result_ttl > VERIFY_ENGINE_MAX_RESULT_TTL ||
+        config->failure_threshold > VERIFY_ENGINE_MAX_FAILURE_THRESHOLD ||
+        config->throttle_rate > VERIFY_ENGINE_MAX_THROTTLE_RATE ||
+        config->prefetch_lead > VERIFY_ENGINE_MAX_PREFETCH_LEAD ||
+        (config->queue_depth & (config->queue_depth - 1)) != 0 ||
+        config->queue_depth > (1u << 30)) {
+        return PQC_ERROR_INVALID_PARAMETER;
+    }
+    *engine = NULL;
+
+    verify_engine_t *e = calloc(1, sizeof(*e));
+    if (!e) {
+        return PQC_ERROR_INSUFFICIENT_MEMORY;
+    }
+    e->config = *config;
+    if (e->config.queue_depth < 2) {
+        e->config.queue_depth = VERIFY_ENGINE_DEFAULT_DEPTH;
+    }
+    if (e->config.expanded_keys == 0) {
+        e->config.expanded_keys = VERIFY_ENGINE_DEFAULT_EXPANDED_KEYS;
+    }
+    if (e->config.throttle_rate == 0) {
+        e->config.throttle_rate = VERIFY_ENGINE_DEFAULT_THROTTLE_RATE;
+    }
+    if (e->config.golden_types == 0) {
+        e->config.golden_types = VERIFY_ENGINE_DEFAULT_GOLDEN_TYPES;
+    }
+    if (e->config.prefetch_lead > 0) {
+        // Started here rather than from a pinned shard, whose CPU affinity
+        // its workers would inherit; without it shards expand keys themselves
+        e->executor = pqc_executor_shared();
+    }
+    int ncpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    e->nshards = config->shards > 0 ? config->shards : (ncpus > 0 ? ncpus : 1);
+
+    e->shards = aligned_alloc(VERIFY_ENGINE_CACHE_LINE, sizeof(verify_shard_t) * (size_t)e->nshards);
+    if (!e->shards) {
+        free(e);
+        return PQC_ERROR_INSUFFICIENT_MEMORY;
+    }
+    memset(e->shards, 0, sizeof(verify_shard_t) * (size_t)e->nshards);
+    for (int i = 0; i < e->nshards; i++) {
+        e->shards[i].event_fd = -1;
+    }
+
+    for (int i = 0; i < e->nshards; i++) {
+        verify_shard_t *shard = &e->shards[i];
+        shard->engine = e;
+        shard->index = i;
+        shard->cpu = config->pin && ncpus > 0 ? i % ncpus : -1;
+        atomic_init(&shard->sleeping, false);
+        atomic_init(&shard->stop, false);
+        atomic_init(&shard->queue_full, 0);
+        shard->event_fd = eventfd(0, EFD_CLOEXEC);
+        if (shard->event_fd < 0 || queue_init(&shard->queue, (uint32_t)e->config.queue_depth) != 0 ||
+            pthread_create(&shard->thread, NULL, shard_main, shard) != 0) {
+            verify_engine_destroy(e);
+            return PQC_ERROR_INSUFFICIENT_MEMORY;
+        }
+        e->running++;
+    }
+
+    *engine = e;
+    return PQC_SUCCESS;
+}
+
+void verify_engine_stop(verify_engine_t *engine) {
+    if (!engine) {
+        return;
+    }
+    for (int i = 0; i < engine->running; i++) {
+        atomic_store(&engine->shards[i].stop, true);
+        eventfd_signal(engine->shards[i].event_fd);
+    }
+    for (int i = 0; i < engine->running; i++) {
+        pthread_join(engine->shards[i].thread, NULL);
+    }
+    engine->running = 0;
+}
+
+void verify_engine_destroy(verify_engine_t *engine) {
+    if (!engine) {
+        return;
+    }
+    verify_engine_stop(engine);
+    for (int i = 0; i < engine->nshards; i++) {
+        verify_shard_t *shard = &engine->shards[i];
+        queue_destroy(&shard->queue);
+        if (shard->event_fd >= 0) {
+            close(shard->event_fd);
+        }
+    }
+    free(engine->shards);
+    free(engine);
+}
+
+int verify_engine_shard_count(const verify_engine_t *engine) {
+    return engine->nshards;
+}
+
+int verify_engine_shard_of(const verify_engine_t *engine, const uint8_t *device_id) {
+    return (int)((device_hash(device_id) >> 32) % (uint64_t)engine->nshards);
+}
+
+// ============================================================================
+// Submission
+// ============================================================================
+
+verify_request_t *verify_engine_reserve(verify_engine_t *engine, int shard) {
+    verify_shard_t *s = &engine->shards[shard];
+    verify_cell_t *cell = queue_reserve(&s->queue);
+    if (!cell) {
+        atomic_fetch_add_explicit(&s->queue_full, 1, memory_order_relaxed);
+        return NULL;
+    }
+    return &cell->request;
+}
+
+void verify_engine_commit(verify_engine_t *engine, int shard, verify_request_t *request) {
+    verify_cell_t *cell = (verify_cell_t *)((uint8_t *)request - offsetof(verify_cell_t, request));
+    queue_commit(cell);
+    shard_wake(&engine->shards[shard]);
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+void verify_engine_get_stats(const verify_engine_t *engine, int shard,
+                             verify_engine_stats_t *stats) {
+    verify_shard_t *s = &engine->shards[shard];
+    *stats = s->stats;
+    stats->queue_full = atomic_load_explicit(&s->queue_full, memory_order_relaxed);
+}
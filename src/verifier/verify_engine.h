@@ -0,0 +1,262 @@
+/**
+ * @file verify_engine.h
+ * @brief Sharded per-core report verification engine
+ *
+ * Verification state is per device: its public key, the expanded form of
+ * that key, and the replay window over its report timestamps. The engine
+ * hashes device_id to one of N shards, each a thread pinned to one CPU
+ * that owns the state of its devices outright. Shards never touch each
+ * other's memory, and all device state is allocated by the shard thread
+ * itself so it lands on that CPU's memory node and stays in its caches.
+ * A shard can also keep the verdicts of recent reports and answer an
+ * exact retransmission from them instead of verifying it again.
+ *
+ * Each shard tracks recent signature failures per device in a count-min
+ * sketch of fixed size. A device whose failures pass a threshold gets a
+ * token bucket: its reports are verified at a limited rate and the rest
+ * are rejected before any crypto work, so a device (or an attacker using
+ * its identity) streaming bad signatures cannot monopolize its shard. The
+ * sketch forgets, halving every VERIFY_ENGINE_FAILURE_HALFLIFE seconds.
+ *
+ * With a golden database (golden_db.h), every firmware, configuration and
+ * runtime measurement in a report must be a known-good digest of its type;
+ * this policy check also runs before the signature.
+ *
+ * Devices report on a schedule, so a shard can tell which expanded keys it
+ * is about to need. It learns each device's reporting interval from the
+ * arrival of its valid reports and, prefetch_lead ms before the next one
+ * is due, expands the key on the shared executor (pqc_executor.h) if it
+ * has dropped out of the cache. The shard only installs the result, and
+ * the report then finds its key warm.
+ *
+ * Requests reach a shard through a bounded lock-free multi-producer queue.
+ * A producer reserves a slot, fills it in place (a report is decoded
+ * straight into the slot, never copied) and commits it:
+ *
+ *     int shard = verify_engine_shard_of(engine, device_id);
+ *     verify_request_t *req = verify_engine_reserve(engine, shard);
+ *     if (!req) {
+ *         // Shard is saturated: back off, shed load or push back upstream
+ *     }
+ *     req->type = VERIFY_REQUEST_REPORT;
+ *     req->context = ...;
+ *     decode_into(&req->u.report, ...);
+ *     verify_engine_commit(engine, shard, req);
+ *
+ * A full queue is the backpressure signal: reserve returns NULL instead of
+ * blocking, and the caller decides whether to wait, drop or stop reading
+ * its input. Results are delivered by a callback on the shard thread.
+ *
+ * The only memory shared between a producer and a shard on the hot path
+ * is the queue itself; a sleeping shard costs its next producer one
+ * eventfd write, an awake one costs nothing.
+ */
+
+#ifndef VERIFY_ENGINE_H
+#define VERIFY_ENGINE_H
+
+#include "verifier_protocol.h"
+#include "golden_db.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+#define VERIFY_ENGINE_DEFAULT_DEPTH         256     /**< Request slots per shard */
+#define VERIFY_ENGINE_DEFAULT_EXPANDED_KEYS 64      /**< Expanded keys cached per shard */
+#define VERIFY_ENGINE_MAX_REPLAY_WINDOW     64      /**< Seconds */
+#define VERIFY_ENGINE_MAX_RESULT_TTL        300     /**< Seconds */
+#define VERIFY_ENGINE_FAILURE_HALFLIFE      10      /**< Seconds until failures count half */
+#define VERIFY_ENGINE_MAX_FAILURE_THRESHOLD 200
+#define VERIFY_ENGINE_DEFAULT_THROTTLE_RATE 1       /**< Verifications per second */
+#define VERIFY_ENGINE_MAX_THROTTLE_RATE     100000
+#define VERIFY_ENGINE_MAX_PREFETCH_LEAD      60000   /**< Milliseconds */
+#define VERIFY_ENGINE_DEFAULT_GOLDEN_TYPES  ((1u << MEASUREMENT_TYPE_FIRMWARE) | \
+                                             (1u << MEASUREMENT_TYPE_CONFIGURATION) | \
+                                             (1u << MEASUREMENT_TYPE_RUNTIME))
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+typedef enum {
+    VERIFY_REQUEST_NONE = 0,            /**< Cancelled reservation, skipped */
+    VERIFY_REQUEST_REPORT = 1,          /**< Verify u.report */
+    VERIFY_REQUEST_ENROLL = 2           /**< Add or replace the key in u.enroll */
+} verify_request_type_t;
+
+/**
+ * @brief One request, filled in place in a shard's queue
+ */
+typedef struct {
+    verify_request_type_t type;
+    uint64_t context;                   /**< Caller's, passed back with the result */
+    uint64_t request_id;                /**< Caller's, passed back with the result */
+    union {
+        attestation_report_t report;
+        verifier_enroll_t enroll;
+    } u;
+} verify_request_t;
+
+/**
+ * @brief Result callback, run on the shard thread
+ *
+ * Must not block for long: the shard verifies nothing else meanwhile.
+ *
+ * @param[in] user verify_engine_config_t.user
+ * @param[in] shard Shard that handled the request
+ * @param[in] request The request; valid only during the call
+ * @param[in] result Outcome; status is a pqc_result_t and error_code an
+ *                   attestation_error_t
+ */
+typedef void (*verify_engine_complete_fn)(void *user, int shard, const verify_request_t *request,
+                                          const verifier_result_t *result);
+
+/**
+ * @brief Called on the shard thread after a batch of completions
+ *
+ * Lets the consumer of results publish or wake once per batch instead of
+ * once per result. It comes after the batch's request slots are released,
+ * including cancelled ones, so it also tells a producer that found the
+ * queue full to try again.
+ */
+typedef void (*verify_engine_batch_fn)(void *user, int shard);
+
+typedef struct {
+    int shards;                         /**< 0 for one per online CPU */
+    bool pin;                           /**< Pin shard i to CPU i modulo online CPUs */
+    size_t queue_depth;                 /**< Slots per shard, power of two; 0 for default */
+    size_t expanded_keys;               /**< Expanded keys cached per shard; 0 for default */
+    uint32_t replay_window;             /**< Seconds, at most VERIFY_ENGINE_MAX_REPLAY_WINDOW;
+                                             0 disables replay detection */
+    size_t result_cache;                /**< Verdicts cached per shard for duplicate
+                                             reports (report_cache.h); 0 disables */
+    uint32_t result_ttl;                /**< Seconds a cached verdict is reused, at most
+                                             VERIFY_ENGINE_MAX_RESULT_TTL; 0 for default */
+    uint32_t failure_threshold;         /**< Recent signature failures after which a device
+                                             is throttled, at most
+                                             VERIFY_ENGINE_MAX_FAILURE_THRESHOLD; 0 disables */
+    uint32_t throttle_rate;             /**< Verifications per second for a throttled
+                                             device, at most VERIFY_ENGINE_MAX_THROTTLE_RATE;
+                                             0 for default */
+    const golden_db_t *golden;          /**< Known-good measurements, NULL for no check;
+                                             must outlive the engine */
+    uint32_t golden_types;              /**< Bit per measurement_type_t checked against
+                                             golden; 0 for VERIFY_ENGINE_DEFAULT_GOLDEN_TYPES */
+    uint32_t prefetch_lead;             /**< Milliseconds before a device's next expected
+                                             report to expand its key, at most
+                                             VERIFY_ENGINE_MAX_PREFETCH_LEAD; 0 disables */
+    verify_engine_complete_fn complete;
+    verify_engine_batch_fn batch_done;  /**< Optional */
+    void *user;
+} verify_engine_config_t;
+
+/**
+ * @brief Counters of one shard
+ *
+ * Read them after verify_engine_stop(); while the engine runs they are
+ * only approximate.
+ */
+typedef struct {
+    uint64_t verified;                  /**< Reports handled */
+    uint64_t valid;
+    uint64_t rejected[ATTESTATION_STAGE_COUNT]; /**< Invalid reports, by rejecting stage */
+    uint64_t unknown;                   /**< Reports from devices never enrolled */
+    uint64_t replayed;                  /**< Counted once, when first verified */
+    uint64_t throttled;                 /**< Rejected by a device's token bucket */
+    uint64_t enrolled;
+    uint64_t devices;                   /**< Devices in the shard's table */
+    uint64_t key_expansions;            /**< Expanded-key cache misses */
+    uint64_t key_prefetches;            /**< Keys expanded ahead of an expected report */
+    uint64_t prefetch_hits;             /**< Reports that found a prefetched key */
+    uint64_t cached;                    /**< Reports answered from the result cache */
+    uint64_t queue_full;                /**< verify_engine_reserve() calls that found no slot */
+    uint64_t wakeups;                   /**< Times the shard was woken from sleep */
+    uint64_t cpu_ns;                    /**< Shard thread CPU time */
+} verify_engine_stats_t;
+
+typedef struct verify_engine verify_engine_t;
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+/**
+ * @brief Start the shards
+ *
+ * @param[out] engine Created engine
+ * @param[in] config Configuration; complete is required
+ * @return PQC_SUCCESS, PQC_ERROR_INVALID_PARAMETER or
+ *         PQC_ERROR_INSUFFICIENT_MEMORY
+ */
+pqc_result_t verify_engine_create(verify_engine_t **engine, const verify_engine_config_t *config);
+
+/**
+ * @brief Stop and join the shards
+ *
+ * Requests still queued are dropped without a callback. Idempotent;
+ * producers must have stopped first.
+ */
+void verify_engine_stop(verify_engine_t *engine);
+
+/**
+ * @brief Stop the engine if running and free everything, device keys zeroized
+ */
+void verify_engine_destroy(verify_engine_t *engine);
+
+int verify_engine_shard_count(const verify_engine_t *engine);
+
+/**
+ * @brief Shard that owns a device
+ */
+int verify_engine_shard_of(const verify_engine_t *engine, const uint8_t *device_id);
+
+// ============================================================================
+// Submission
+// ============================================================================
+
+/**
+ * @brief Reserve the next request slot of a shard
+ *
+ * Safe to call from any number of threads. The slot must be committed,
+ * or cancelled by committing it with type VERIFY_REQUEST_NONE; the shard
+ * processes its queue in order and waits at an uncommitted slot.
+ *
+ * @return The slot to fill in, or NULL while the shard's queue is full
+ */
+verify_request_t *verify_engine_reserve(verify_engine_t *engine, int shard);
+
+/**
+ * @brief Hand a filled slot to its shard, waking the shard if it sleeps
+ */
+void verify_engine_commit(verify_engine_t *engine, int shard, verify_request_t *request);
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+void verify_engine_get_stats(const verify_engine_t *engine, int shard,
+                             verify_engine_stats_t *stats);
+
+#ifdef PQC_ENABLE_TESTING
+/**
+ * @brief Move the engines' clock forward (testing only)
+ *
+ * Affects failure aging, token buckets and the prefetch schedule of every
+ * engine in the process; report timestamps still follow the wall clock.
+ */
+void verify_engine_advance_clock(uint32_t ms);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VERIFY_ENGINE_H */
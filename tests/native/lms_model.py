@@ -0,0 +1,222 @@
+#!/usr/bin/env python3
+"""
+Independent RFC 8554 model for the C HSS/LMS implementation.
+
+Written from the RFC text alone (hashlib only, nothing shared with
+src/crypto/lms.c): it rebuilds each top-level public key from the private
+seed and identifier with the Appendix A derivation, verifies each HSS
+signature with Algorithms 4b, 6a and the HSS procedure of section 6.3, and
+checks that altered signatures and messages are rejected.
+
+    lms_model.py <test_lms>     run "<test_lms> --dump <tmpdir>" and check it
+"""
+
+import hashlib
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+
+N = 32
+D_PBLC = 0x8080
+D_MESG = 0x8181
+D_LEAF = 0x8282
+D_INTR = 0x8383
+
+# Section 4.1 / Table 1: type -> (w, p, ls)
+LMOTS = {1: (1, 265, 7), 2: (2, 133, 6), 3: (4, 67, 4), 4: (8, 34, 0)}
+# Section 5.1 / Table 2: type -> h
+LMS = {5: 5, 6: 10, 7: 15, 8: 20, 9: 25}
+
+HSS_MAX_LEVELS = 8
+
+
+def H(*parts):
+    return hashlib.sha256(b"".join(parts)).digest()
+
+
+def u8(x):
+    return struct.pack(">B", x)
+
+
+def u16(x):
+    return struct.pack(">H", x)
+
+
+def u32(x):
+    return struct.pack(">I", x)
+
+
+def coef(s, i, w):
+    """Section 3.1.3"""
+    return ((1 << w) - 1) & (s[(i * w) // 8] >> (8 - (w * (i % (8 // w)) + w)))
+
+
+def cksm(q, w, ls):
+    """Section 4.4"""
+    total = sum((1 << w) - 1 - coef(q, i, w) for i in range(N * 8 // w))
+    return u16((total << ls) & 0xFFFF)
+
+
+def chain(I, q, i, x, start, end):
+    for j in range(start, end):
+        x = H(I, u32(q), u16(i), u8(j), x)
+    return x
+
+
+class Reader:
+    def __init__(self, data):
+        self.data, self.off = data, 0
+
+    def take(self, n):
+        if self.off + n > len(self.data):
+            raise ValueError("truncated")
+        out = self.data[self.off:self.off + n]
+        self.off += n
+        return out
+
+    def u32(self):
+        return struct.unpack(">I", self.take(4))[0]
+
+
+def lmots_candidate(I, q, ots_type, sig, msg):
+    """Algorithm 4b; sig is the full LM-OTS signature"""
+    w, p, ls = LMOTS[ots_type]
+    r = Reader(sig)
+    if r.u32() != ots_type:
+        raise ValueError("LM-OTS type")
+    c = r.take(N)
+    y = [r.take(N) for _ in range(p)]
+    Q = H(I, u32(q), u16(D_MESG), c, msg)
+    qc = Q + cksm(Q, w, ls)
+    z = [chain(I, q, i, y[i], coef(qc, i, w), (1 << w) - 1) for i in range(p)]
+    return H(I, u32(q), u16(D_PBLC), *z)
+
+
+def lms_verify(pub, r, msg):
+    """Algorithm 6a; consumes one LMS signature from r"""
+    lms_type, ots_type = struct.unpack(">II", pub[:8])
+    I, T1 = pub[8:24], pub[24:56]
+    if lms_type not in LMS or ots_type not in LMOTS:
+        return False
+    h, (_, p, _) = LMS[lms_type], LMOTS[ots_type]
+    q = r.u32()
+    ots_sig = r.take(4 + N * (p + 1))
+    if r.u32() != lms_type or q >= (1 << h):
+        return False
+    path = [r.take(N) for _ in range(h)]
+    try:
+        kc = lmots_candidate(I, q, ots_type, ots_sig, msg)
+    except ValueError:
+        return False
+    node = (1 << h) + q
+    tmp = H(I, u32(node), u16(D_LEAF), kc)
+    for i in range(h):
+        if node % 2 == 1:
+            tmp = H(I, u32(node // 2), u16(D_INTR), path[i], tmp)
+        else:
+            tmp = H(I, u32(node // 2), u16(D_INTR), tmp, path[i])
+        node //= 2
+    return tmp == T1
+
+
+def lms_signature_bytes(sig, off):
+    """Length of the LMS signature at sig[off:], from its type fields"""
+    ots_type = struct.unpack(">I", sig[off + 4:off + 8])[0]
+    if ots_type not in LMOTS:
+        raise ValueError("LM-OTS type")
+    type_off = off + 8 + N * (LMOTS[ots_type][1] + 1)
+    lms_type = struct.unpack(">I", sig[type_off:type_off + 4])[0]
+    if lms_type not in LMS:
+        raise ValueError("LMS type")
+    return type_off + 4 + N * LMS[lms_type] - off
+
+
+def hss_verify(pk, sig, msg):
+    """Section 6.3"""
+    if len(pk) != 60:
+        return False
+    levels = struct.unpack(">I", pk[:4])[0]
+    r = Reader(sig)
+    try:
+        if r.u32() + 1 != levels:
+            return False
+        pub = pk[4:]
+        for _ in range(levels - 1):
+            # Each level signs the public key that follows its signature
+            end = r.off + lms_signature_bytes(sig, r.off)
+            next_pub = sig[end:end + 56]
+            if len(next_pub) != 56 or not lms_verify(pub, r, next_pub):
+                return False
+            r.take(56)
+            pub = next_pub
+        return lms_verify(pub, r, msg) and r.off == len(sig)
+    except (ValueError, struct.error):
+        return False
+
+
+def top_public_key(sk):
+    """Appendix A key derivation and section 5.3 tree for the top level"""
+    r = Reader(sk)
+    levels = r.u32()
+    types = [(r.u32(), r.u32()) for _ in range(HSS_MAX_LEVELS)]
+    seed, I = r.take(N), r.take(16)
+    lms_type, ots_type = types[0]
+    h, (w, p, _) = LMS[lms_type], LMOTS[ots_type]
+
+    def leaf(q):
+        y = [chain(I, q, i, H(I, u32(q), u16(i), u8(0xFF), seed), 0, (1 << w) - 1)
+             for i in range(p)]
+        return H(I, u32(q), u16(D_PBLC), *y)
+
+    nodes = {}
+    for q in range(1 << h):
+        nodes[(1 << h) + q] = H(I, u32((1 << h) + q), u16(D_LEAF), leaf(q))
+    for r_ in range((1 << h) - 1, 0, -1):
+        nodes[r_] = H(I, u32(r_), u16(D_INTR), nodes[2 * r_], nodes[2 * r_ + 1])
+    return u32(levels) + u32(lms_type) + u32(ots_type) + I + nodes[1]
+
+
+def check_dump(directory):
+    failures = 0
+    k = 0
+    while os.path.exists(os.path.join(directory, "sig-%d.bin" % k)):
+        def load(name):
+            with open(os.path.join(directory, "%s-%d.bin" % (name, k)), "rb") as f:
+                return f.read()
+        sk, pk, msg, sig = load("sk"), load("pk"), load("msg"), load("sig")
+
+        checks = [
+            ("public key from seed", top_public_key(sk) == pk),
+            ("signature verifies", hss_verify(pk, sig, msg)),
+        ]
+        for off in (7, 12, len(sig) // 2, len(sig) - 1):
+            bad = bytearray(sig)
+            bad[off] ^= 1
+            checks.append(("altered byte %d rejected" % off, not hss_verify(pk, bytes(bad), msg)))
+        checks.append(("altered message rejected", not hss_verify(pk, sig, msg[:-1] + bytes([msg[-1] ^ 1]))))
+        checks.append(("truncated signature rejected", not hss_verify(pk, sig[:-1], msg)))
+
+        for name, ok in checks:
+            print("%s case %d: %s" % ("PASS" if ok else "FAIL", k, name))
+            failures += not ok
+        k += 1
+
+    if k == 0:
+        print("FAIL: no signatures in %s" % directory)
+        return 1
+    return 1 if failures else 0
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+    with tempfile.TemporaryDirectory() as directory:
+        subprocess.run([sys.argv[1], "--dump", directory], check=True)
+        return check_dump(directory)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
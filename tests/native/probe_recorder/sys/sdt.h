@@ -0,0 +1,24 @@
+/**
+ * @file sdt.h
+ * @brief Stand-in for <sys/sdt.h> that turns each USDT probe into a call
+ *
+ * Only the pqc_probe_recorder variant of libpqc is built with this
+ * directory on its include path; test_trace.c defines the recorder.
+ */
+
+#ifndef PQC_TEST_SDT_H
+#define PQC_TEST_SDT_H
+
+#include <stdint.h>
+
+void pqc_test_probe(const char *provider, const char *name, int argc,
+                    uintptr_t a, uintptr_t b, uintptr_t c);
+
+#define DTRACE_PROBE1(provider, name, a) \
+    pqc_test_probe(#provider, #name, 1, (uintptr_t)(a), 0, 0)
+#define DTRACE_PROBE2(provider, name, a, b) \
+    pqc_test_probe(#provider, #name, 2, (uintptr_t)(a), (uintptr_t)(b), 0)
+#define DTRACE_PROBE3(provider, name, a, b, c) \
+    pqc_test_probe(#provider, #name, 3, (uintptr_t)(a), (uintptr_t)(b), (uintptr_t)(c))
+
+#endif /* PQC_TEST_SDT_H */
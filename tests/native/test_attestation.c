@@ -0,0 +1,79 @@
+/**
+ * @file test_attestation.c
+ * @brief Report signing and verification cover the same bytes
+ */
+
+#include "test_common.h"
+#include "attestation_engine.h"
+#include "pqc_common.h"
+#include <stddef.h>
+
+static attestation_report_t g_report;
+static device_certificate_t g_cert;
+
+static uint32_t verify(const attestation_report_t *report) {
+    attestation_verification_result_t result;
+    CHECK_EQ_INT(attestation_verify_report(report, &g_cert.public_key, &result), PQC_SUCCESS);
+    CHECK_EQ_INT(result.is_valid, result.error_code == ATTESTATION_ERROR_NONE);
+    return result.error_code;
+}
+
+static void test_generated_report_verifies(void) {
+    CHECK_EQ_INT(attestation_generate_report(&g_report), PQC_SUCCESS);
+    CHECK_EQ_INT(g_report.signature_length, DILITHIUM_SIGNATUREBYTES);
+    CHECK_EQ_INT(verify(&g_report), ATTESTATION_ERROR_NONE);
+}
+
+/**
+ * @brief Every byte before signature_length is signed; the length field,
+ *        the signature and any trailing padding are not
+ */
+static void test_signed_region(void) {
+    static attestation_report_t copy;
+
+    CHECK_EQ_INT(ATTESTATION_REPORT_SIGNED_BYTES, offsetof(attestation_report_t, signature_length));
+
+    static const size_t signed_offsets[] = {
+        0, offsetof(attestation_report_t, timestamp), offsetof(attestation_report_t, pcr_values),
+        ATTESTATION_REPORT_SIGNED_BYTES - 1,
+    };
+    for (size_t i = 0; i < sizeof(signed_offsets) / sizeof(signed_offsets[0]); i++) {
+        copy = g_report;
+        ((uint8_t *)&copy)[signed_offsets[i]] ^= 0x01;
+        CHECK(verify(&copy) != ATTESTATION_ERROR_NONE);
+    }
+
+    // Padding after the signature is neither hashed nor verified
+    size_t end = offsetof(attestation_report_t, signature) + sizeof(g_report.signature);
+    for (size_t off = end; off < sizeof(attestation_report_t); off++) {
+        copy = g_report;
+        ((uint8_t *)&copy)[off] ^= 0xff;
+        CHECK_EQ_INT(verify(&copy), ATTESTATION_ERROR_NONE);
+    }
+
+    copy = g_report;
+    copy.signature[0] ^= 0x01;
+    CHECK_EQ_INT(verify(&copy), ATTESTATION_ERROR_SIGNATURE_INVALID);
+    copy = g_report;
+    copy.signature_length--;
+    CHECK_EQ_INT(verify(&copy), ATTESTATION_ERROR_SIGNATURE_INVALID);
+}
+
+int main(void) {
+    attestation_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.device_type = DEVICE_TYPE_SMART_METER;
+    snprintf(config.device_serial, sizeof(config.device_serial), "TEST-0001");
+    config.enable_measurement_log = true;
+    config.max_log_entries = 16;
+
+    CHECK_EQ_INT(pqc_init(NULL), PQC_SUCCESS);
+    CHECK_EQ_INT(attestation_init(&config), PQC_SUCCESS);
+    CHECK_EQ_INT(attestation_collect_measurements(), PQC_SUCCESS);
+    CHECK_EQ_INT(attestation_get_device_certificate(&g_cert), PQC_SUCCESS);
+    RUN_TEST(test_generated_report_verifies);
+    RUN_TEST(test_signed_region);
+    attestation_cleanup();
+    pqc_cleanup();
+    return test_finish();
+}
@@ -0,0 +1,120 @@
+/**
+ * @file test_bench_regression.c
+ * @brief Baseline comparison used by benchmark-check
+ */
+
+#include "test_common.h"
+#include "bench_common.h"
+#include "bench_json.h"
+#include "bench_regression.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+#define SAMPLES 64
+
+static void fill(uint64_t *values, size_t count, uint64_t base) {
+    // Deterministic spread of +-3% around base
+    for (size_t i = 0; i < count; i++) {
+        values[i] = base + (base * ((i * 37) % 61)) / 1000 - (base * 3) / 100;
+    }
+}
+
+// Baseline report in the format benchmark_runner writes
+static char* make_report(const uint64_t *samples, size_t count) {
+    size_t cap = 128 + count * 24;
+    char *text = malloc(cap);
+    int off = snprintf(text, cap, "{\"operations\":[{\"name\":\"case\",\"samples_ns\":[");
+    for (size_t i = 0; i < count; i++) {
+        off += snprintf(text + off, cap - off, "%s%llu", i ? "," : "",
+                        (unsigned long long)samples[i]);
+    }
+    snprintf(text + off, cap - off, "]}]}");
+    return text;
+}
+
+static bench_verdict_t compare(uint64_t base, uint64_t current) {
+    uint64_t base_samples[SAMPLES], cur_samples[SAMPLES];
+    fill(base_samples, SAMPLES, base);
+    fill(cur_samples, SAMPLES, current);
+
+    char *text = make_report(base_samples, SAMPLES);
+    bench_json_value_t *report = bench_json_parse(text);
+    free(text);
+    CHECK(report != NULL);
+    if (!report) {
+        return BENCH_VERDICT_NO_BASELINE;
+    }
+
+    const bench_json_value_t *op = bench_regression_find_operation(report, "case");
+    CHECK(op != NULL);
+    bench_comparison_t row;
+    CHECK_EQ_INT(bench_regression_compare("case", cur_samples, SAMPLES, op, "samples_ns",
+                                          BENCH_DEFAULT_THRESHOLD_PCT, BENCH_DEFAULT_ALPHA, &row), 0);
+    bench_json_free(report);
+    return row.verdict;
+}
+
+static void test_verdicts(void) {
+    CHECK_EQ_INT(compare(100000, 100000), BENCH_VERDICT_OK);
+    CHECK_EQ_INT(compare(100000, 103000), BENCH_VERDICT_OK);      // Under the 5% threshold
+    CHECK_EQ_INT(compare(100000, 120000), BENCH_VERDICT_REGRESSED);
+    CHECK_EQ_INT(compare(100000, 80000), BENCH_VERDICT_IMPROVED);
+}
+
+static void test_missing_baseline(void) {
+    uint64_t samples[SAMPLES];
+    fill(samples, SAMPLES, 1000);
+    bench_comparison_t row;
+
+    CHECK_EQ_INT(bench_regression_compare("case", samples, SAMPLES, NULL, "samples_ns",
+                                          5.0, 0.01, &row), 0);
+    CHECK_EQ_INT(row.verdict, BENCH_VERDICT_NO_BASELINE);
+
+    bench_json_value_t *report = bench_json_parse("{\"operations\":[{\"name\":\"case\"}]}");
+    CHECK(report != NULL);
+    const bench_json_value_t *op = bench_regression_find_operation(report, "case");
+    CHECK(op != NULL);
+    CHECK(bench_regression_find_operation(report, "other") == NULL);
+    CHECK_EQ_INT(bench_regression_compare("case", samples, SAMPLES, op, "samples_ns",
+                                          5.0, 0.01, &row), 0);
+    CHECK_EQ_INT(row.verdict, BENCH_VERDICT_NO_SAMPLES);
+    bench_json_free(report);
+}
+
+static void test_mann_whitney(void) {
+    double low[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    double high[8] = {11, 12, 13, 14, 15, 16, 17, 18};
+    bench_mann_whitney_t mw;
+
+    CHECK_EQ_INT(bench_mann_whitney(low, 8, high, 8, &mw), 0);
+    CHECK(mw.p_slower < 0.01);
+    CHECK(mw.p_faster > 0.99);
+
+    CHECK_EQ_INT(bench_mann_whitney(low, 8, low, 8, &mw), 0);
+    CHECK(mw.p_slower > 0.4 && mw.p_faster > 0.4);
+}
+
+static void test_thresholds(void) {
+    const bench_threshold_t overrides[] = {{"noisy", 15.0}};
+    CHECK(bench_regression_threshold(overrides, 1, "noisy", 5.0) == 15.0);
+    CHECK(bench_regression_threshold(overrides, 1, "quiet", 5.0) == 5.0);
+}
+
+static void test_stats(void) {
+    const uint64_t values[] = {5, 1, 4, 2, 3};
+    bench_stats_t stats = {0};
+    CHECK_EQ_INT(bench_compute_stats(values, 5, &stats), 0);
+    CHECK(stats.median == 3.0);
+    CHECK_EQ_INT(stats.min, 1);
+    CHECK_EQ_INT(stats.max, 5);
+    CHECK(stats.mean == 3.0);
+}
+
+int main(void) {
+    RUN_TEST(test_verdicts);
+    RUN_TEST(test_missing_baseline);
+    RUN_TEST(test_mann_whitney);
+    RUN_TEST(test_thresholds);
+    RUN_TEST(test_stats);
+    return test_finish();
+}
@@ -0,0 +1,180 @@
+/**
+ * @file test_bytes.c
+ * @brief Bytes-touched accounting for one attestation, against the sizes
+ *        the engine is known to copy, clear and hash around the signature
+ *
+ * Linked against a libpqc built with PQC_ENABLE_BYTE_ACCOUNTING.
+ */
+
+#include "test_common.h"
+#include "attestation_engine.h"
+#include "pqc_bytes.h"
+#include "pqc_common.h"
+
+static attestation_report_t g_report;
+static device_certificate_t g_cert;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static pqc_bytes_scope_t g_scopes[PQC_BYTES_MAX_SCOPES];
+static size_t g_scope_count;
+static pqc_bytes_scope_t g_hash_cost;
+
+static void snapshot(void) {
+    g_scope_count = pqc_bytes_get_scopes(g_scopes, PQC_BYTES_MAX_SCOPES);
+}
+
+static pqc_bytes_scope_t scope(const char *name) {
+    for (size_t i = 0; i < g_scope_count; i++) {
+        if (strcmp(g_scopes[i].name, name) == 0) {
+            return g_scopes[i];
+        }
+    }
+    pqc_bytes_scope_t none = { name, 0, { 0 } };
+    return none;
+}
+
+/**
+ * @brief What hashing the signed part of a report costs on its own,
+ *        including the hash state the SHA-3 code clears afterwards
+ */
+static pqc_bytes_scope_t report_hash_cost(void) {
+    uint8_t hash[32];
+    pqc_bytes_scope_t cost = { "report_hash", 0, { 0 } };
+
+    pqc_bytes_reset();
+    int token = pqc_bytes_scope_begin(cost.name);
+    CHECK_EQ_INT(sha3_256(hash, (const uint8_t *)&g_report, ATTESTATION_REPORT_SIGNED_BYTES),
+                 PQC_SUCCESS);
+    pqc_bytes_scope_end(&token);
+    snapshot();
+
+    cost = scope(cost.name);
+    CHECK_EQ_INT(cost.bytes[PQC_BYTES_HASHED], ATTESTATION_REPORT_SIGNED_BYTES);
+    return cost;
+}
+
+/**
+ * @brief The outer scope holds exactly the inner scope's bytes, one
+ *        report hash and the listed bytes, so every count is attributed
+ *        once and in full
+ */
+static void check_outer(const char *outer_name, const char *inner_name,
+                        const uint64_t own[PQC_BYTES_KIND_COUNT]) {
+    pqc_bytes_scope_t outer = scope(outer_name), inner = scope(inner_name);
+
+    CHECK_EQ_INT(outer.calls, 1);
+    CHECK_EQ_INT(inner.calls, 1);
+    for (int k = 0; k < PQC_BYTES_KIND_COUNT; k++) {
+        uint64_t expected = inner.bytes[k] + g_hash_cost.bytes[k] + own[k];
+        if (outer.bytes[k] != expected) {
+            fprintf(stderr, "%s %s: %llu, expected %llu from %s + hash + %llu\n",
+                    outer_name, pqc_bytes_kind_name((pqc_bytes_kind_t)k),
+                    (unsigned long long)outer.bytes[k], (unsigned long long)expected,
+                    inner_name, (unsigned long long)own[k]);
+            g_test_failures++;
+        }
+    }
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+static void test_generate_report(void) {
+    pqc_bytes_reset();
+    CHECK_EQ_INT(attestation_generate_report(&g_report), PQC_SUCCESS);
+    snapshot();
+
+    // Valid PCRs are hash outputs, the others stay zero
+    static const uint8_t zero[32];
+    uint64_t valid_pcrs = 0;
+    for (int i = 0; i < MAX_PCR_REGISTERS; i++) {
+        valid_pcrs += memcmp(g_report.pcr_values[i], zero, 32) != 0;
+    }
+    CHECK(valid_pcrs > 0);
+    CHECK(g_report.measurement_count > 0);
+
+    const uint64_t own[PQC_BYTES_KIND_COUNT] = {
+        [PQC_BYTES_COPIED] = sizeof(g_report.device_id) + 32 * valid_pcrs +
+                             g_report.measurement_count * sizeof(platform_measurement_t),
+        [PQC_BYTES_ZEROED] = sizeof(attestation_report_t),
+    };
+    check_outer("attestation_generate_report", "dilithium_sign", own);
+
+    // The signature is over the 32-byte report hash
+    CHECK(scope("dilithium_sign").bytes[PQC_BYTES_HASHED] >= 32);
+}
+
+static void test_verify_report(void) {
+    attestation_verification_result_t result;
+
+    pqc_bytes_reset();
+    CHECK_EQ_INT(attestation_verify_report(&g_report, &g_cert.public_key, &result), PQC_SUCCESS);
+    CHECK(result.is_valid);
+    snapshot();
+
+    const uint64_t own[PQC_BYTES_KIND_COUNT] = {
+        [PQC_BYTES_COPIED] = sizeof(result.device_id),
+        [PQC_BYTES_ZEROED] = sizeof(attestation_verification_result_t),
+    };
+    check_outer("attestation_verify_report", "dilithium_verify", own);
+    CHECK(scope("dilithium_verify").bytes[PQC_BYTES_HASHED] >= 32);
+
+    // Verification is deterministic: a second call adds the same counts
+    pqc_bytes_scope_t first = scope("attestation_verify_report");
+    CHECK_EQ_INT(attestation_verify_report(&g_report, &g_cert.public_key, &result), PQC_SUCCESS);
+    snapshot();
+    pqc_bytes_scope_t second = scope("attestation_verify_report");
+    CHECK_EQ_INT(second.calls, 2);
+    for (int k = 0; k < PQC_BYTES_KIND_COUNT; k++) {
+        CHECK_EQ_INT(second.bytes[k], 2 * first.bytes[k]);
+    }
+}
+
+/**
+ * @brief A report rejected before the signature check costs only the
+ *        result clear, and never enters dilithium_verify
+ */
+static void test_rejected_report(void) {
+    static attestation_report_t bad;
+    attestation_verification_result_t result;
+
+    bad = g_report;
+    bad.report_version++;
+    pqc_bytes_reset();
+    CHECK_EQ_INT(attestation_verify_report(&bad, &g_cert.public_key, &result), PQC_SUCCESS);
+    CHECK(!result.is_valid);
+    snapshot();
+
+    pqc_bytes_scope_t outer = scope("attestation_verify_report");
+    CHECK_EQ_INT(outer.calls, 1);
+    CHECK_EQ_INT(outer.bytes[PQC_BYTES_ZEROED], sizeof(attestation_verification_result_t));
+    CHECK_EQ_INT(outer.bytes[PQC_BYTES_COPIED], 0);
+    CHECK_EQ_INT(outer.bytes[PQC_BYTES_HASHED], 0);
+    CHECK_EQ_INT(scope("dilithium_verify").calls, 0);
+}
+
+int main(void) {
+    attestation_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.device_type = DEVICE_TYPE_SMART_METER;
+    snprintf(config.device_serial, sizeof(config.device_serial), "TEST-0001");
+    config.enable_measurement_log = true;
+    config.max_log_entries = 16;
+
+    CHECK(pqc_bytes_enabled());
+    CHECK_EQ_INT(pqc_init(NULL), PQC_SUCCESS);
+    CHECK_EQ_INT(attestation_init(&config), PQC_SUCCESS);
+    CHECK_EQ_INT(attestation_collect_measurements(), PQC_SUCCESS);
+    CHECK_EQ_INT(attestation_get_device_certificate(&g_cert), PQC_SUCCESS);
+    g_hash_cost = report_hash_cost();
+    RUN_TEST(test_generate_report);
+    RUN_TEST(test_verify_report);
+    RUN_TEST(test_rejected_report);
+    attestation_cleanup();
+    pqc_cleanup();
+    return test_finish();
+}
@@ -0,0 +1,69 @@
+/**
+ * @file test_common.h
+ * @brief Minimal assertion helpers for the native tests
+ *
+ * Each test executable runs its cases from main() and returns
+ * test_finish(), which is non-zero if any CHECK failed.
+ */
+
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <stdio.h>
+#include <string.h>
+
+static int g_test_failures;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            g_test_failures++; \
+        } \
+    } while (0)
+
+#define CHECK_EQ_INT(a, b) \
+    do { \
+        long long _a = (long long)(a), _b = (long long)(b); \
+        if (_a != _b) { \
+            fprintf(stderr, "%s:%d: CHECK failed: %s == %s (%lld != %lld)\n", \
+                    __FILE__, __LINE__, #a, #b, _a, _b); \
+            g_test_failures++; \
+        } \
+    } while (0)
+
+#define CHECK_MEM(a, b, n) CHECK(memcmp((a), (b), (n)) == 0)
+
+#define RUN_TEST(fn) \
+    do { \
+        int _before = g_test_failures; \
+        fn(); \
+        printf("%s %s\n", g_test_failures == _before ? "PASS" : "FAIL", #fn); \
+    } while (0)
+
+static inline int test_finish(void) {
+    if (g_test_failures) {
+        fprintf(stderr, "%d check(s) failed\n", g_test_failures);
+    }
+    return g_test_failures ? 1 : 0;
+}
+
+/**
+ * @brief Decode a hex string into bytes
+ *
+ * @return Number of bytes written
+ */
+static inline size_t test_unhex(unsigned char *out, size_t outlen, const char *hex) {
+    size_t n = 0;
+    while (hex[0] && hex[1] && n < outlen) {
+        unsigned int byte;
+        if (sscanf(hex, "%2x", &byte) != 1) {
+            break;
+        }
+        out[n++] = (unsigned char)byte;
+        hex += 2;
+    }
+    return n;
+}
+
+#endif /* TEST_COMMON_H */
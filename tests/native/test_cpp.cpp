@@ -0,0 +1,292 @@
+/**
+ * @file test_cpp.cpp
+ * @brief C++ layer: key types stay move-only, and building and verifying
+ *        reports in a caller's arena never touches the global heap
+ *
+ * Global operator new and delete are replaced with counting versions, so
+ * any allocation that bypasses the memory_resource passed in shows up as
+ * a non-zero count, whichever thread makes it.
+ */
+
+#include "test_common.h"
+#include "pqc/pqc.hpp"
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// ============================================================================
+// Counting Global Allocator
+// ============================================================================
+
+static std::atomic<long> g_new_calls;
+
+void *operator new(std::size_t size) {
+    g_new_calls.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+// std::pmr::new_delete_resource() asks for the alignment explicitly
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    g_new_calls.fetch_add(1, std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    if (void *ptr = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+// ============================================================================
+// Ownership
+// ============================================================================
+
+template <typename T>
+constexpr bool move_only_v = !std::is_copy_constructible_v<T> && !std::is_copy_assignable_v<T> &&
+                             std::is_nothrow_move_constructible_v<T>;
+
+static_assert(move_only_v<pqc::kyber::PublicKey>);
+static_assert(move_only_v<pqc::kyber::SecretKey>);
+static_assert(move_only_v<pqc::kyber::Ciphertext>);
+static_assert(move_only_v<pqc::kyber::SharedSecret>);
+static_assert(move_only_v<pqc::dilithium::PublicKey>);
+static_assert(move_only_v<pqc::dilithium::SecretKey>);
+static_assert(move_only_v<pqc::dilithium::ExpandedPublicKey>);
+static_assert(move_only_v<pqc::dilithium::Signature>);
+static_assert(move_only_v<pqc::falcon::SecretKey>);
+static_assert(move_only_v<pqc::sphincs::SecretKey>);
+static_assert(move_only_v<pqc::Report>);
+static_assert(move_only_v<pqc::SecretBlock<32>>);
+static_assert(!std::is_copy_constructible_v<pqc::Result<pqc::dilithium::SecretKey>>);
+
+/**
+ * @brief Moving leaves the source empty; clone() is the only copy
+ */
+static void test_move_and_clone(void) {
+    auto pair = pqc::kyber::generate();
+    CHECK(pair.has_value());
+    if (!pair) {
+        return;
+    }
+    pqc::kyber::PublicKey moved = std::move(pair->public_key);
+    CHECK(!pair->public_key);
+    CHECK(moved);
+    CHECK(pqc::kyber::validate(moved).has_value());
+
+    auto copy = moved.clone();
+    CHECK(copy.has_value());
+    CHECK(copy->get() != moved.get());
+    CHECK_MEM(copy->get(), moved.get(), sizeof(kyber_public_key_t));
+    CHECK_EQ_INT(pqc::kyber::PublicKey().clone().code(), PQC_ERROR_INVALID_PARAMETER);
+
+    auto enc = pqc::kyber::encapsulate(moved);
+    CHECK(enc.has_value());
+    auto ss = pqc::kyber::decapsulate(pair->secret_key, enc->ciphertext);
+    CHECK(ss.has_value());
+    CHECK(*ss == enc->shared_secret);
+
+    pqc::kyber::SharedSecret taken = std::move(enc->shared_secret);
+    CHECK(taken == *ss);
+    CHECK(enc->shared_secret != *ss);
+}
+
+// ============================================================================
+// Allocation
+// ============================================================================
+
+static std::array<std::byte, 512 * 1024> g_arena;
+
+static pqc::ReportBuilder make_builder(const pqc::ReportBuilder::allocator_type &alloc) {
+    pqc::ReportBuilder builder(alloc);
+    const uint8_t device_id[] = { 'c', 'p', 'p', '-', 't', 'e', 's', 't' };
+    std::array<uint8_t, 32> pcr;
+    pcr.fill(0xA5);
+    CHECK(builder.set_device_id(pqc::bytes_view(device_id, sizeof(device_id))).has_value());
+    CHECK(builder.set_pcr(0, pqc::bytes_view(pcr.data(), pcr.size())).has_value());
+    for (int i = 0; i < 4; i++) {
+        platform_measurement_t m{};
+        m.pcr_index = (uint8_t)i;
+        m.measurement_value[0] = (uint8_t)i;
+        CHECK(builder.add_measurement(m).has_value());
+    }
+    return builder;
+}
+
+/**
+ * @brief The counter sees allocations the default resource makes, so the
+ *        zero counts below are not the counter missing them
+ */
+static void test_counter_sees_default_resource(void) {
+    long before = g_new_calls.load();
+    pqc::ReportBuilder builder = make_builder({});
+    CHECK(g_new_calls.load() > before);
+}
+
+/**
+ * @brief Measurements, the signed report and the verdict all come from
+ *        one monotonic arena with nothing behind it
+ */
+static void test_build_and_verify_in_arena(void) {
+    auto keys = pqc::dilithium::generate();
+    CHECK(keys.has_value());
+    if (!keys) {
+        return;
+    }
+    std::pmr::monotonic_buffer_resource arena(g_arena.data(), g_arena.size(),
+                                              std::pmr::null_memory_resource());
+
+    long before = g_new_calls.load();
+    pqc::ReportBuilder builder = make_builder(&arena);
+    auto report = builder.build(keys->secret_key, &arena);
+    auto verdict = report.and_then([&](pqc::Report &r) {
+        return pqc::verify(r, keys->public_key, &arena);
+    });
+    CHECK_EQ_INT(g_new_calls.load() - before, 0);
+
+    CHECK(report.has_value());
+    CHECK(verdict.has_value());
+    if (!verdict) {
+        return;
+    }
+    CHECK(report->resource() == &arena);
+    CHECK(verdict->get_allocator().resource() == &arena);
+    CHECK(verdict->is_valid());
+    CHECK_EQ_INT(report->get()->measurement_count, 4);
+}
+
+/**
+ * @brief A batch verified on the shared pool, with one entry left empty
+ *        and one report altered
+ */
+static void test_verify_batch_in_arena(void) {
+    auto keys = pqc::dilithium::generate();
+    CHECK(keys.has_value());
+    if (!keys) {
+        return;
+    }
+    pqc::ReportBuilder builder = make_builder({});
+    auto good = builder.build(keys->secret_key);
+    CHECK(good.has_value());
+    if (!good) {
+        return;
+    }
+    auto bad = good->clone();
+    CHECK(bad.has_value());
+    if (!bad) {
+        return;
+    }
+    bad->get()->pcr_values[0][0] ^= 0x01;
+
+    std::array<pqc::VerifyRequest, 6> requests;
+    for (auto &request : requests) {
+        request = { good->get(), &keys->public_key };
+    }
+    requests[2].report = bad->get();
+    requests[4].public_key = nullptr;
+
+    // Start the shared pool first, so its workers are not counted
+    CHECK(pqc_executor_shared() != nullptr);
+    std::pmr::monotonic_buffer_resource arena(g_arena.data(), g_arena.size(),
+                                              std::pmr::null_memory_resource());
+    long before = g_new_calls.load();
+    pqc::BatchResults results =
+        pqc::verify_batch(pqc::span<const pqc::VerifyRequest>(requests.data(), requests.size()),
+                          &arena);
+    CHECK_EQ_INT(g_new_calls.load() - before, 0);
+
+    CHECK_EQ_INT(results.size(), requests.size());
+    CHECK(results.get_allocator().resource() == &arena);
+    for (std::size_t i = 0; i < results.size() && i < requests.size(); i++) {
+        if (i == 4) {
+            CHECK_EQ_INT(results[i].code(), PQC_ERROR_INVALID_PARAMETER);
+            continue;
+        }
+        CHECK(results[i].has_value());
+        CHECK(results[i] && results[i]->is_valid() == (i != 2));
+    }
+}
+
+/**
+ * @brief The coroutine path: frames and verdict in the arena, the
+ *        verification itself on a pool worker
+ */
+static void test_coroutine_verify_in_arena(void) {
+    auto keys = pqc::dilithium::generate();
+    CHECK(keys.has_value());
+    if (!keys) {
+        return;
+    }
+    pqc::ReportBuilder builder = make_builder({});
+    auto report = builder.build(keys->secret_key);
+    CHECK(report.has_value());
+    if (!report) {
+        return;
+    }
+
+    pqc::Executor &executor = pqc::Executor::shared();
+    CHECK(executor.get() != nullptr);
+    std::pmr::monotonic_buffer_resource arena(g_arena.data(), g_arena.size(),
+                                              std::pmr::null_memory_resource());
+    long before = g_new_calls.load();
+    auto verdict = pqc::sync_wait(std::allocator_arg, &arena,
+                                  pqc::verify_report(std::allocator_arg, &arena, executor,
+                                                     *report->get(), keys->public_key));
+    CHECK_EQ_INT(g_new_calls.load() - before, 0);
+
+    CHECK(verdict.has_value());
+    CHECK(verdict && verdict->is_valid());
+    CHECK(verdict && verdict->get_allocator().resource() == &arena);
+}
+
+int main(void) {
+    CHECK_EQ_INT(pqc_init(NULL), PQC_SUCCESS);
+    RUN_TEST(test_move_and_clone);
+    RUN_TEST(test_counter_sees_default_resource);
+    RUN_TEST(test_build_and_verify_in_arena);
+    RUN_TEST(test_verify_batch_in_arena);
+    RUN_TEST(test_coroutine_verify_in_arena);
+    pqc_cleanup();
+    return test_finish();
+}
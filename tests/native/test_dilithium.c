@@ -0,0 +1,104 @@
+/**
+ * @file test_dilithium.c
+ * @brief Dilithium-5 sign/verify round trip and rejection of altered input
+ */
+
+#include "test_common.h"
+#include "dilithium.h"
+#include "pqc_common.h"
+
+static dilithium_public_key_t g_pk;
+static dilithium_secret_key_t g_sk;
+static uint8_t g_sig[DILITHIUM_SIGNATUREBYTES];
+static size_t g_siglen;
+static const uint8_t g_msg[] = "firmware measurement 0001";
+
+static void test_round_trip(void) {
+    CHECK_EQ_INT(dilithium_keypair(&g_pk, &g_sk), PQC_SUCCESS);
+    CHECK_EQ_INT(dilithium_sign(g_sig, &g_siglen, g_msg, sizeof(g_msg), &g_sk), PQC_SUCCESS);
+    CHECK_EQ_INT(g_siglen, DILITHIUM_SIGNATUREBYTES);
+    CHECK_EQ_INT(dilithium_verify(g_sig, g_siglen, g_msg, sizeof(g_msg), &g_pk), PQC_SUCCESS);
+
+    static dilithium_expanded_public_key_t epk;
+    CHECK_EQ_INT(dilithium_expand_public_key(&epk, &g_pk), PQC_SUCCESS);
+    CHECK_EQ_INT(dilithium_verify_expanded(g_sig, g_siglen, g_msg, sizeof(g_msg), &epk), PQC_SUCCESS);
+}
+
+static void test_randomized(void) {
+    uint8_t again[DILITHIUM_SIGNATUREBYTES];
+    size_t len = 0;
+    CHECK_EQ_INT(dilithium_sign(again, &len, g_msg, sizeof(g_msg), &g_sk), PQC_SUCCESS);
+    CHECK_EQ_INT(len, g_siglen);
+    CHECK(memcmp(again, g_sig, g_siglen) != 0);
+    CHECK_EQ_INT(dilithium_verify(again, len, g_msg, sizeof(g_msg), &g_pk), PQC_SUCCESS);
+}
+
+static void test_tamper(void) {
+    uint8_t bad[DILITHIUM_SIGNATUREBYTES];
+    uint8_t msg[sizeof(g_msg)];
+
+    // Challenge, response and hint sections each invalidate the signature
+    const size_t offsets[] = { 0, 100, DILITHIUM_SIGNATUREBYTES - 1 };
+    for (size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+        memcpy(bad, g_sig, sizeof(bad));
+        bad[offsets[i]] ^= 0x01;
+        CHECK(dilithium_verify(bad, g_siglen, g_msg, sizeof(g_msg), &g_pk) != PQC_SUCCESS);
+    }
+
+    memcpy(msg, g_msg, sizeof(msg));
+    msg[0] ^= 0x01;
+    CHECK(dilithium_verify(g_sig, g_siglen, msg, sizeof(msg), &g_pk) != PQC_SUCCESS);
+    CHECK(dilithium_verify(g_sig, g_siglen - 1, g_msg, sizeof(g_msg), &g_pk) != PQC_SUCCESS);
+
+    dilithium_public_key_t other = g_pk;
+    other.t1[0] ^= 0x01;
+    CHECK(dilithium_verify(g_sig, g_siglen, g_msg, sizeof(g_msg), &other) != PQC_SUCCESS);
+}
+
+/**
+ * @brief The encoding checks run without a key: length, response norm
+ *        and hint layout
+ */
+static void test_validate_signature(void) {
+    uint8_t bad[DILITHIUM_SIGNATUREBYTES];
+
+    CHECK_EQ_INT(dilithium_validate_signature(g_sig, g_siglen), PQC_SUCCESS);
+    CHECK_EQ_INT(dilithium_validate_signature(g_sig, g_siglen - 1), PQC_ERROR_INVALID_SIGNATURE);
+
+    // The last byte is the hint count of the final polynomial
+    memcpy(bad, g_sig, sizeof(bad));
+    bad[DILITHIUM_SIGNATUREBYTES - 1] = 0xFF;
+    CHECK_EQ_INT(dilithium_validate_signature(bad, sizeof(bad)), PQC_ERROR_INVALID_SIGNATURE);
+
+    // A response coefficient at the top of its range exceeds gamma1 - beta
+    memcpy(bad, g_sig, sizeof(bad));
+    memset(bad + 32, 0xFF, 8);
+    CHECK_EQ_INT(dilithium_validate_signature(bad, sizeof(bad)), PQC_ERROR_INVALID_SIGNATURE);
+
+    CHECK_EQ_INT(dilithium_validate_public_key(&g_pk), PQC_SUCCESS);
+    CHECK_EQ_INT(dilithium_validate_signature(NULL, g_siglen), PQC_ERROR_INVALID_PARAMETER);
+    CHECK_EQ_INT(dilithium_validate_public_key(NULL), PQC_ERROR_INVALID_PARAMETER);
+}
+
+static void test_pack_public_key(void) {
+    static uint32_t t1[8 * 256];
+    dilithium_public_key_t repacked;
+
+    dilithium_unpack_public_key(t1, &g_pk);
+    for (size_t i = 0; i < sizeof(t1) / sizeof(t1[0]); i++) {
+        CHECK(t1[i] < 1024);
+    }
+    dilithium_pack_public_key(&repacked, t1, g_pk.rho);
+    CHECK_MEM(&repacked, &g_pk, sizeof(g_pk));
+}
+
+int main(void) {
+    CHECK_EQ_INT(pqc_init(NULL), PQC_SUCCESS);
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_randomized);
+    RUN_TEST(test_tamper);
+    RUN_TEST(test_validate_signature);
+    RUN_TEST(test_pack_public_key);
+    pqc_cleanup();
+    return test_finish();
+}
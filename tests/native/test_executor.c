@@ -0,0 +1,474 @@
+/**
+ * @file test_executor.c
+ * @brief Work-stealing executor: latency-before-bulk ordering, stealing
+ *        from a blocked worker, deque overflow, parallel_for coverage and
+ *        draining on shutdown
+ */
+
+#include "test_common.h"
+#include "pqc_executor.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <time.h>
+
+#define WAIT_SECONDS 10     /**< Upper bound on any wait; a hang fails the test */
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/**
+ * @brief One-shot event a task can block on
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bool set;
+} gate_t;
+
+static void gate_init(gate_t *g) {
+    pthread_mutex_init(&g->lock, NULL);
+    pthread_cond_init(&g->cond, NULL);
+    g->set = false;
+}
+
+static void gate_open(gate_t *g) {
+    pthread_mutex_lock(&g->lock);
+    g->set = true;
+    pthread_cond_broadcast(&g->cond);
+    pthread_mutex_unlock(&g->lock);
+}
+
+static bool gate_wait(gate_t *g) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += WAIT_SECONDS;
+    pthread_mutex_lock(&g->lock);
+    int rc = 0;
+    while (!g->set && rc == 0) {
+        rc = pthread_cond_timedwait(&g->cond, &g->lock, &deadline);
+    }
+    bool set = g->set;
+    pthread_mutex_unlock(&g->lock);
+    return set;
+}
+
+static void gate_destroy(gate_t *g) {
+    pthread_mutex_destroy(&g->lock);
+    pthread_cond_destroy(&g->cond);
+}
+
+static bool wait_count(_Atomic unsigned *counter, unsigned target) {
+    struct timespec pause = { 0, 1000000 };
+    for (int i = 0; i < WAIT_SECONDS * 1000; i++) {
+        if (atomic_load(counter) >= target) {
+            return true;
+        }
+        nanosleep(&pause, NULL);
+    }
+    return atomic_load(counter) >= target;
+}
+
+/**
+ * @brief Stats once n tasks have returned; a task is counted after it runs
+ */
+static pqc_executor_stats_t stats_after(const pqc_executor_t *ex, uint64_t n) {
+    struct timespec pause = { 0, 1000000 };
+    pqc_executor_stats_t stats;
+    for (int i = 0; i < WAIT_SECONDS * 1000; i++) {
+        pqc_executor_get_stats(ex, &stats);
+        if (stats.executed[PQC_TASK_PRIORITY_LATENCY] + stats.executed[PQC_TASK_PRIORITY_BULK] >= n) {
+            break;
+        }
+        nanosleep(&pause, NULL);
+    }
+    return stats;
+}
+
+/**
+ * @brief Task that appends its tag to a shared log when it runs
+ */
+typedef struct {
+    pqc_task_t task;
+    int tag;
+    gate_t *started;                    /**< Opened as soon as it runs, if set */
+    gate_t *gate;                       /**< Then blocks on this, if set */
+} logged_task_t;
+
+#define LOG_MAX 64
+
+static int g_log[LOG_MAX];
+static _Atomic unsigned g_logged;
+
+static void logged_run(pqc_task_t *task) {
+    logged_task_t *t = (logged_task_t *)task;
+    if (t->started) {
+        gate_open(t->started);
+    }
+    if (t->gate) {
+        CHECK(gate_wait(t->gate));
+    }
+    unsigned slot = atomic_fetch_add(&g_logged, 1);
+    if (slot < LOG_MAX) {
+        g_log[slot] = t->tag;
+    }
+}
+
+static void log_reset(void) {
+    atomic_store(&g_logged, 0);
+    memset(g_log, 0, sizeof(g_log));
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+static void test_create_parameters(void) {
+    pqc_executor_t *ex = NULL;
+    pqc_executor_config_t bad_capacity = { 1, 3 };
+    pqc_executor_config_t too_many = { PQC_EXECUTOR_MAX_WORKERS + 1, 0 };
+
+    CHECK_EQ_INT(pqc_executor_create(&ex, &bad_capacity), PQC_ERROR_INVALID_PARAMETER);
+    CHECK_EQ_INT(pqc_executor_create(&ex, &too_many), PQC_ERROR_INVALID_PARAMETER);
+    CHECK_EQ_INT(pqc_executor_create(NULL, NULL), PQC_ERROR_INVALID_PARAMETER);
+
+    CHECK(pqc_executor_default_workers() >= 1);
+    CHECK_EQ_INT(pqc_executor_create(&ex, NULL), PQC_SUCCESS);
+    CHECK_EQ_INT(pqc_executor_size(ex), pqc_executor_default_workers());
+    pqc_executor_destroy(ex);
+    pqc_executor_destroy(NULL);
+}
+
+static void test_latency_before_bulk(void) {
+    enum { BULK = 8, LATENCY = 4 };
+    pqc_executor_config_t config = { 1, 0 };
+    pqc_executor_t *ex = NULL;
+    logged_task_t blocker = { { logged_run, NULL }, -1, NULL, NULL };
+    logged_task_t bulk[BULK], latency[LATENCY];
+    gate_t started, gate;
+
+    gate_init(&started);
+    gate_init(&gate);
+    blocker.started = &started;
+    blocker.gate = &gate;
+    log_reset();
+    CHECK_EQ_INT(pqc_executor_create(&ex, &config), PQC_SUCCESS);
+    if (!ex) {
+        return;
+    }
+
+    // The only worker is busy while both queues fill, bulk first
+    pqc_executor_submit(ex, &blocker.task, PQC_TASK_PRIORITY_BULK);
+    CHECK(gate_wait(&started));
+    for (int i = 0; i < BULK; i++) {
+        bulk[i] = (logged_task_t){ { logged_run, NULL }, 100 + i, NULL, NULL };
+        pqc_executor_submit(ex, &bulk[i].task, PQC_TASK_PRIORITY_BULK);
+    }
+    for (int i = 0; i < LATENCY; i++) {
+        latency[i] = (logged_task_t){ { logged_run, NULL }, i, NULL, NULL };
+        pqc_executor_submit(ex, &latency[i].task, PQC_TASK_PRIORITY_LATENCY);
+    }
+    gate_open(&gate);
+    CHECK(wait_count(&g_logged, 1 + BULK + LATENCY));
+
+    // Blocker, then the latency tasks in FIFO order, then bulk in FIFO order
+    CHECK_EQ_INT(g_log[0], -1);
+    for (int i = 0; i < LATENCY; i++) {
+        CHECK_EQ_INT(g_log[1 + i], i);
+    }
+    for (int i = 0; i < BULK; i++) {
+        CHECK_EQ_INT(g_log[1 + LATENCY + i], 100 + i);
+    }
+
+    pqc_executor_stats_t stats = stats_after(ex, 1 + BULK + LATENCY);
+    CHECK_EQ_INT(stats.executed[PQC_TASK_PRIORITY_LATENCY], LATENCY);
+    CHECK_EQ_INT(stats.executed[PQC_TASK_PRIORITY_BULK], 1 + BULK);
+    CHECK_EQ_INT(stats.injected, 1 + BULK + LATENCY);
+
+    pqc_executor_destroy(ex);
+    gate_destroy(&started);
+    gate_destroy(&gate);
+}
+
+/**
+ * @brief Parent that queues children on its own worker's deques
+ */
+typedef struct {
+    pqc_task_t task;
+    pqc_executor_t *ex;
+    logged_task_t *children;
+    int count;
+} spawner_t;
+
+static void spawner_run(pqc_task_t *task) {
+    spawner_t *s = (spawner_t *)task;
+    for (int i = 0; i < s->count; i++) {
+        pqc_task_priority_t prio = s->children[i].tag < 100 ? PQC_TASK_PRIORITY_LATENCY
+                                                            : PQC_TASK_PRIORITY_BULK;
+        pqc_executor_submit(s->ex, &s->children[i].task, prio);
+    }
+}
+
+static void test_local_priorities(void) {
+    enum { CHILDREN = 6 };
+    pqc_executor_config_t config = { 1, 0 };
+    pqc_executor_t *ex = NULL;
+    logged_task_t children[CHILDREN];
+
+    log_reset();
+    CHECK_EQ_INT(pqc_executor_create(&ex, &config), PQC_SUCCESS);
+    if (!ex) {
+        return;
+    }
+
+    // Bulk, latency, bulk, ... pushed from the worker onto its own deques
+    for (int i = 0; i < CHILDREN; i++) {
+        children[i] = (logged_task_t){ { logged_run, NULL }, i % 2 ? i : 100 + i, NULL, NULL };
+    }
+    spawner_t spawner = { { spawner_run, NULL }, ex, children, CHILDREN };
+    pqc_executor_submit(ex, &spawner.task, PQC_TASK_PRIORITY_BULK);
+    CHECK(wait_count(&g_logged, CHILDREN));
+
+    // Own deque pops newest first, but never a bulk task before a latency one
+    const int expect[CHILDREN] = { 5, 3, 1, 104, 102, 100 };
+    CHECK_MEM(g_log, expect, sizeof(expect));
+
+    pqc_executor_stats_t stats;
+    pqc_executor_get_stats(ex, &stats);
+    CHECK_EQ_INT(stats.local, CHILDREN);
+    CHECK_EQ_INT(stats.injected, 1);
+    pqc_executor_destroy(ex);
+}
+
+/**
+ * @brief Parent that queues children locally, then blocks until others ran them
+ */
+typedef struct {
+    pqc_task_t task;
+    pqc_executor_t *ex;
+    pqc_task_t *children;
+    int count;
+    _Atomic unsigned done;
+    pthread_t owner_id;
+    _Atomic unsigned on_owner;
+    bool all_done;
+} stealing_root_t;
+
+static stealing_root_t g_root;
+
+static void stolen_child_run(pqc_task_t *task) {
+    (void)task;
+    if (pthread_equal(pthread_self(), g_root.owner_id)) {
+        atomic_fetch_add(&g_root.on_owner, 1);
+    }
+    atomic_fetch_add(&g_root.done, 1);
+}
+
+static void stealing_root_run(pqc_task_t *task) {
+    stealing_root_t *r = (stealing_root_t *)task;
+    r->owner_id = pthread_self();
+    for (int i = 0; i < r->count; i++) {
+        pqc_executor_submit(r->ex, &r->children[i], PQC_TASK_PRIORITY_BULK);
+    }
+    // This worker never gets back to its deque until every child ran
+    r->all_done = wait_count(&r->done, (unsigned)r->count);
+}
+
+static void test_stealing(void) {
+    enum { CHILDREN = 64 };
+    pqc_executor_config_t config = { 4, 0 };
+    pqc_executor_t *ex = NULL;
+    pqc_task_t children[CHILDREN];
+
+    CHECK_EQ_INT(pqc_executor_create(&ex, &config), PQC_SUCCESS);
+    if (!ex) {
+        return;
+    }
+    for (int i = 0; i < CHILDREN; i++) {
+        children[i] = (pqc_task_t){ stolen_child_run, NULL };
+    }
+    memset(&g_root, 0, sizeof(g_root));
+    g_root.task.run = stealing_root_run;
+    g_root.ex = ex;
+    g_root.children = children;
+    g_root.count = CHILDREN;
+
+    pqc_executor_submit(ex, &g_root.task, PQC_TASK_PRIORITY_BULK);
+    CHECK(wait_count(&g_root.done, CHILDREN));
+
+    // Every child was taken from the blocked worker's deque by another one
+    pqc_executor_stats_t stats = stats_after(ex, 1 + CHILDREN);
+    pqc_executor_destroy(ex);
+    CHECK(g_root.all_done);
+    CHECK_EQ_INT(atomic_load(&g_root.on_owner), 0);
+    CHECK_EQ_INT(stats.workers, 4);
+    CHECK_EQ_INT(stats.local, CHILDREN);
+    CHECK(stats.steals >= CHILDREN);
+    CHECK(stats.steal_attempts >= stats.steals);
+}
+
+static void test_deque_overflow(void) {
+    enum { CHILDREN = 20 };
+    pqc_executor_config_t config = { 1, 4 };
+    pqc_executor_t *ex = NULL;
+    logged_task_t children[CHILDREN];
+
+    log_reset();
+    CHECK_EQ_INT(pqc_executor_create(&ex, &config), PQC_SUCCESS);
+    if (!ex) {
+        return;
+    }
+    for (int i = 0; i < CHILDREN; i++) {
+        children[i] = (logged_task_t){ { logged_run, NULL }, 100 + i, NULL, NULL };
+    }
+
+    // A full deque spills into the injection queue instead of dropping tasks
+    spawner_t spawner = { { spawner_run, NULL }, ex, children, CHILDREN };
+    pqc_executor_submit(ex, &spawner.task, PQC_TASK_PRIORITY_BULK);
+    CHECK(wait_count(&g_logged, CHILDREN));
+
+    pqc_executor_stats_t stats = stats_after(ex, 1 + CHILDREN);
+    CHECK_EQ_INT(stats.local, 4);
+    CHECK_EQ_INT(stats.injected, 1 + CHILDREN - 4);
+    CHECK_EQ_INT(stats.executed[PQC_TASK_PRIORITY_BULK], 1 + CHILDREN);
+    pqc_executor_destroy(ex);
+}
+
+/**
+ * @brief parallel_for body counting how often each index was visited
+ */
+typedef struct {
+    _Atomic unsigned char *hits;
+    pqc_executor_t *ex;
+    bool nested;
+} coverage_t;
+
+static void coverage_body(void *ctx, size_t begin, size_t end) {
+    coverage_t *c = ctx;
+    for (size_t i = begin; i < end; i++) {
+        atomic_fetch_add(&c->hits[i], 1);
+    }
+}
+
+static void nested_body(void *ctx, size_t begin, size_t end) {
+    coverage_t *c = ctx;
+    for (size_t i = begin; i < end; i++) {
+        // Each outer index runs an inner loop over its own 16 slots
+        coverage_t inner = { c->hits + i * 16, c->ex, false };
+        CHECK_EQ_INT(pqc_executor_parallel_for(c->ex, 16, 1, coverage_body, &inner,
+                                               PQC_TASK_PRIORITY_LATENCY), PQC_SUCCESS);
+    }
+}
+
+static bool all_hit_once(_Atomic unsigned char *hits, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (atomic_load(&hits[i]) != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_parallel_for(void) {
+    enum { COUNT = 1000, OUTER = 40 };
+    static _Atomic unsigned char hits[COUNT];
+    pqc_executor_config_t config = { 3, 0 };
+    pqc_executor_t *ex = NULL;
+    coverage_t c = { hits, NULL, false };
+    const size_t grains[] = { 0, 1, 7, COUNT, COUNT + 1 };
+
+    CHECK_EQ_INT(pqc_executor_create(&ex, &config), PQC_SUCCESS);
+    c.ex = ex;
+    for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); g++) {
+        memset(hits, 0, sizeof(hits));
+        CHECK_EQ_INT(pqc_executor_parallel_for(ex, COUNT, grains[g], coverage_body, &c,
+                                               PQC_TASK_PRIORITY_BULK), PQC_SUCCESS);
+        CHECK(all_hit_once(hits, COUNT));
+    }
+
+    // Called from inside tasks, the caller helps instead of deadlocking the pool
+    memset(hits, 0, sizeof(hits));
+    CHECK_EQ_INT(pqc_executor_parallel_for(ex, OUTER, 1, nested_body, &c,
+                                           PQC_TASK_PRIORITY_BULK), PQC_SUCCESS);
+    CHECK(all_hit_once(hits, OUTER * 16));
+
+    // No executor: the loop runs on the caller
+    memset(hits, 0, sizeof(hits));
+    CHECK_EQ_INT(pqc_executor_parallel_for(NULL, COUNT, 10, coverage_body, &c,
+                                           PQC_TASK_PRIORITY_BULK), PQC_SUCCESS);
+    CHECK(all_hit_once(hits, COUNT));
+
+    CHECK_EQ_INT(pqc_executor_parallel_for(ex, 0, 1, coverage_body, &c,
+                                           PQC_TASK_PRIORITY_BULK), PQC_SUCCESS);
+    CHECK_EQ_INT(pqc_executor_parallel_for(ex, COUNT, 1, NULL, &c,
+                                           PQC_TASK_PRIORITY_BULK), PQC_ERROR_INVALID_PARAMETER);
+    CHECK_EQ_INT(pqc_executor_parallel_for(ex, COUNT, 1, coverage_body, &c,
+                                           PQC_TASK_PRIORITY_COUNT), PQC_ERROR_INVALID_PARAMETER);
+    pqc_executor_destroy(ex);
+}
+
+static _Atomic unsigned g_drained;
+
+static void drain_run(pqc_task_t *task) {
+    (void)task;
+    atomic_fetch_add(&g_drained, 1);
+}
+
+static void test_shutdown_drains(void) {
+    enum { TASKS = 2000 };
+    static pqc_task_t tasks[TASKS];
+    pqc_executor_config_t config = { 2, 0 };
+    pqc_executor_t *ex = NULL;
+    logged_task_t blocker = { { logged_run, NULL }, -1, NULL, NULL };
+    gate_t gate;
+
+    gate_init(&gate);
+    blocker.gate = &gate;
+    log_reset();
+    atomic_store(&g_drained, 0);
+    CHECK_EQ_INT(pqc_executor_create(&ex, &config), PQC_SUCCESS);
+    if (!ex) {
+        return;
+    }
+
+    pqc_executor_submit(ex, &blocker.task, PQC_TASK_PRIORITY_BULK);
+    for (int i = 0; i < TASKS; i++) {
+        tasks[i] = (pqc_task_t){ drain_run, NULL };
+        pqc_executor_submit(ex, &tasks[i], i % 3 ? PQC_TASK_PRIORITY_BULK
+                                                 : PQC_TASK_PRIORITY_LATENCY);
+    }
+
+    // destroy() must not return while anything queued is still unrun
+    gate_open(&gate);
+    pqc_executor_destroy(ex);
+    CHECK_EQ_INT(atomic_load(&g_drained), TASKS);
+    CHECK_EQ_INT(atomic_load(&g_logged), 1);
+    gate_destroy(&gate);
+}
+
+static void test_shared_executor(void) {
+    pqc_executor_t *ex = pqc_executor_shared();
+    CHECK(ex != NULL);
+    CHECK(pqc_executor_shared() == ex);
+
+    // pqc_cleanup() tears it down; the next call starts a fresh one
+    pqc_executor_shutdown_shared();
+    ex = pqc_executor_shared();
+    CHECK(ex != NULL);
+    CHECK(ex != NULL && pqc_executor_size(ex) == pqc_executor_default_workers());
+}
+
+int main(void) {
+    CHECK_EQ_INT(pqc_init(NULL), PQC_SUCCESS);
+    RUN_TEST(test_create_parameters);
+    RUN_TEST(test_latency_before_bulk);
+    RUN_TEST(test_local_priorities);
+    RUN_TEST(test_stealing);
+    RUN_TEST(test_deque_overflow);
+    RUN_TEST(test_parallel_for);
+    RUN_TEST(test_shutdown_drains);
+    RUN_TEST(test_shared_executor);
+    pqc_cleanup();
+    return test_finish();
+}
@@ -0,0 +1,131 @@
+/**
+ * @file test_falcon.c
+ * @brief Falcon-512/1024 sign/verify round trip and rejection of altered input
+ */
+
+#include "test_common.h"
+#include "falcon.h"
+#include "pqc_common.h"
+
+#define MAX_PK   FALCON_1024_PUBLICKEYBYTES
+#define MAX_SK   FALCON_1024_SECRETKEYBYTES
+#define MAX_SIG  FALCON_1024_SIGNATUREBYTES
+
+typedef struct {
+    pqc_algorithm_t algorithm;
+    unsigned logn;
+    size_t pk_bytes;
+    size_t sk_bytes;
+    size_t sig_bytes;
+    uint8_t pk[MAX_PK];
+    uint8_t sk[MAX_SK];
+    uint8_t sig[MAX_SIG];
+    size_t siglen;
+} falcon_case_t;
+
+static falcon_case_t g_cases[] = {
+    { PQC_ALG_FALCON_512,  9,  FALCON_512_PUBLICKEYBYTES,  FALCON_512_SECRETKEYBYTES,
+      FALCON_512_SIGNATUREBYTES,  {0}, {0}, {0}, 0 },
+    { PQC_ALG_FALCON_1024, 10, FALCON_1024_PUBLICKEYBYTES, FALCON_1024_SECRETKEYBYTES,
+      FALCON_1024_SIGNATUREBYTES, {0}, {0}, {0}, 0 },
+};
+
+#define CASE_COUNT (sizeof(g_cases) / sizeof(g_cases[0]))
+
+static const uint8_t g_msg[] = "firmware measurement 0001";
+
+static void test_round_trip(void) {
+    for (size_t i = 0; i < CASE_COUNT; i++) {
+        falcon_case_t *c = &g_cases[i];
+        CHECK_EQ_INT(falcon_keypair(c->algorithm, c->pk, c->sk), PQC_SUCCESS);
+
+        // Encoding headers: 0x00 + logn, 0x50 + logn, 0x30 + logn
+        CHECK_EQ_INT(c->pk[0], c->logn);
+        CHECK_EQ_INT(c->sk[0], 0x50 + c->logn);
+
+        CHECK_EQ_INT(falcon_sign(c->sig, &c->siglen, g_msg, sizeof(g_msg), c->sk, c->sk_bytes),
+                     PQC_SUCCESS);
+        CHECK_EQ_INT(c->siglen, c->sig_bytes);
+        CHECK_EQ_INT(c->sig[0], 0x30 + c->logn);
+        CHECK_EQ_INT(falcon_verify(c->sig, c->siglen, g_msg, sizeof(g_msg), c->pk, c->pk_bytes),
+                     PQC_SUCCESS);
+
+        // The empty message is a valid input
+        uint8_t sig[MAX_SIG];
+        size_t siglen = 0;
+        CHECK_EQ_INT(falcon_sign(sig, &siglen, NULL, 0, c->sk, c->sk_bytes), PQC_SUCCESS);
+        CHECK_EQ_INT(falcon_verify(sig, siglen, NULL, 0, c->pk, c->pk_bytes), PQC_SUCCESS);
+    }
+}
+
+static void test_randomized(void) {
+    for (size_t i = 0; i < CASE_COUNT; i++) {
+        falcon_case_t *c = &g_cases[i];
+        uint8_t again[MAX_SIG];
+        size_t len = 0;
+        CHECK_EQ_INT(falcon_sign(again, &len, g_msg, sizeof(g_msg), c->sk, c->sk_bytes),
+                     PQC_SUCCESS);
+        CHECK(memcmp(again + 1, c->sig + 1, FALCON_NONCEBYTES) != 0);
+        CHECK_EQ_INT(falcon_verify(again, len, g_msg, sizeof(g_msg), c->pk, c->pk_bytes),
+                     PQC_SUCCESS);
+    }
+}
+
+static void test_tamper(void) {
+    for (size_t i = 0; i < CASE_COUNT; i++) {
+        falcon_case_t *c = &g_cases[i];
+        uint8_t bad[MAX_SIG];
+
+        // Header, nonce, first body byte and trailing padding
+        const size_t offsets[] = { 0, 1, 1 + FALCON_NONCEBYTES, c->sig_bytes - 1 };
+        for (size_t k = 0; k < sizeof(offsets) / sizeof(offsets[0]); k++) {
+            memcpy(bad, c->sig, c->siglen);
+            bad[offsets[k]] ^= 0x01;
+            CHECK(falcon_verify(bad, c->siglen, g_msg, sizeof(g_msg), c->pk, c->pk_bytes)
+                  != PQC_SUCCESS);
+        }
+
+        uint8_t msg[sizeof(g_msg)];
+        memcpy(msg, g_msg, sizeof(msg));
+        msg[sizeof(msg) - 1] ^= 0x80;
+        CHECK(falcon_verify(c->sig, c->siglen, msg, sizeof(msg), c->pk, c->pk_bytes)
+              != PQC_SUCCESS);
+        CHECK(falcon_verify(c->sig, c->siglen - 1, g_msg, sizeof(g_msg), c->pk, c->pk_bytes)
+              != PQC_SUCCESS);
+
+        uint8_t pk[MAX_PK];
+        memcpy(pk, c->pk, c->pk_bytes);
+        pk[1] ^= 0x01;
+        CHECK(falcon_verify(c->sig, c->siglen, g_msg, sizeof(g_msg), pk, c->pk_bytes)
+              != PQC_SUCCESS);
+    }
+}
+
+static void test_parameter_mismatch(void) {
+    falcon_case_t *small = &g_cases[0], *large = &g_cases[1];
+
+    // A signature is only accepted under a key of its own parameter set
+    CHECK(falcon_verify(small->sig, small->siglen, g_msg, sizeof(g_msg),
+                        large->pk, large->pk_bytes) != PQC_SUCCESS);
+    CHECK(falcon_verify(large->sig, large->siglen, g_msg, sizeof(g_msg),
+                        small->pk, small->pk_bytes) != PQC_SUCCESS);
+
+    uint8_t sig[MAX_SIG];
+    size_t siglen = 0;
+    CHECK_EQ_INT(falcon_sign(sig, &siglen, g_msg, sizeof(g_msg), small->sk, large->sk_bytes),
+                 PQC_ERROR_INVALID_KEY);
+    CHECK_EQ_INT(falcon_verify(small->sig, small->siglen, g_msg, sizeof(g_msg),
+                               small->pk, small->pk_bytes - 1), PQC_ERROR_INVALID_KEY);
+    CHECK_EQ_INT(falcon_keypair(PQC_ALG_DILITHIUM_5, small->pk, small->sk),
+                 PQC_ERROR_ALGORITHM_NOT_SUPPORTED);
+}
+
+int main(void) {
+    CHECK_EQ_INT(pqc_init(NULL), PQC_SUCCESS);
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_randomized);
+    RUN_TEST(test_tamper);
+    RUN_TEST(test_parameter_mismatch);
+    pqc_cleanup();
+    return test_finish();
+}
@@ -0,0 +1,302 @@
+/**
+ * @file test_golden_db.c
+ * @brief Golden database lookups checked against a plain sorted array, and
+ *        the header checks that keep a damaged file from being mapped
+ */
+
+#include "test_common.h"
+#include "golden_db.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static char g_dir[] = "/tmp/test_golden_db.XXXXXX";
+static char g_path[sizeof(g_dir) + 16];
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t next_random(void) {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 7;
+    g_rng ^= g_rng << 17;
+    return g_rng;
+}
+
+static void random_digest(uint8_t digest[GOLDEN_DB_DIGEST_BYTES]) {
+    for (int i = 0; i < GOLDEN_DB_DIGEST_BYTES; i += 8) {
+        uint64_t v = next_random();
+        memcpy(digest + i, &v, 8);
+    }
+}
+
+static int compare_digests(const void *a, const void *b) {
+    return memcmp(a, b, GOLDEN_DB_DIGEST_BYTES);
+}
+
+/**
+ * @brief Distinct records, every fourth sharing its first eight digest
+ *        bytes with the one before, so lookups also reach the full compare
+ */
+static golden_record_t *make_records(size_t count) {
+    golden_record_t *records = calloc(count ? count : 1, sizeof(golden_record_t));
+    for (size_t i = 0; i < count; i++) {
+        golden_record_t *r = &records[i];
+        random_digest(r->digest);
+        if (i % 4 == 3) {
+            memcpy(r->digest, records[i - 1].digest, 8);
+        }
+        r->product_line = (uint32_t)(i % 7);
+        r->version = (uint32_t)i;
+        r->measurement_type = (uint16_t)(i % 5);
+        r->flags = (i % 11 == 0) ? GOLDEN_FLAG_REVOKED : 0;
+    }
+    return records;
+}
+
+/**
+ * @brief Reference lookup: binary search over the digests, sorted
+ */
+static bool reference_has(const uint8_t (*sorted)[GOLDEN_DB_DIGEST_BYTES], size_t count,
+                          const uint8_t *digest) {
+    return count > 0 && bsearch(digest, sorted, count, GOLDEN_DB_DIGEST_BYTES, compare_digests);
+}
+
+static void write_file(const char *path, const void *data, size_t length) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    CHECK(fd >= 0);
+    if (fd < 0) {
+        return;
+    }
+    CHECK_EQ_INT(write(fd, data, length), (long long)length);
+    close(fd);
+}
+
+static uint8_t *read_file(const char *path, size_t *length) {
+    struct stat st;
+    CHECK_EQ_INT(stat(path, &st), 0);
+    uint8_t *data = malloc((size_t)st.st_size + 1);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    CHECK_EQ_INT(read(fd, data, (size_t)st.st_size), st.st_size);
+    close(fd);
+    *length = (size_t)st.st_size;
+    return data;
+}
+
+static int directory_entries(void) {
+    DIR *dir = opendir(g_dir);
+    int n = 0;
+    for (struct dirent *e; dir && (e = readdir(dir));) {
+        n += strcmp(e->d_name, ".") != 0 && strcmp(e->d_name, "..") != 0;
+    }
+    if (dir) {
+        closedir(dir);
+    }
+    return n;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+/**
+ * @brief Every tree shape up to a few levels, then larger ones: each
+ *        record is found as built, and probes around every record agree
+ *        with the sorted array
+ */
+static void test_lookup_matches_sorted(void) {
+    static const size_t sizes[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 15, 16, 17, 100, 1023, 4097 };
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t count = sizes[s];
+        golden_record_t *records = make_records(count);
+        uint8_t (*sorted)[GOLDEN_DB_DIGEST_BYTES] = malloc((count + 1) * GOLDEN_DB_DIGEST_BYTES);
+        for (size_t i = 0; i < count; i++) {
+            memcpy(sorted[i], records[i].digest, GOLDEN_DB_DIGEST_BYTES);
+        }
+        qsort(sorted, count, GOLDEN_DB_DIGEST_BYTES, compare_digests);
+
+        golden_db_t *db = NULL;
+        CHECK_EQ_INT(golden_db_build(g_path, records, count, 100 + s), PQC_SUCCESS);
+        CHECK_EQ_INT(golden_db_open(&db, g_path), PQC_SUCCESS);
+        if (!db) {
+            free(sorted);
+            free(records);
+            continue;
+        }
+        CHECK_EQ_INT(golden_db_count(db), count);
+        CHECK_EQ_INT(golden_db_generation(db), 100 + s);
+
+        int mismatches = 0;
+        for (size_t i = 0; i < count; i++) {
+            const golden_record_t *found = golden_db_lookup(db, records[i].digest);
+            mismatches += !found || memcmp(found, &records[i], sizeof(*found)) != 0;
+        }
+        CHECK_EQ_INT(mismatches, 0);
+
+        // Neighbours of each digest: the last byte and the eighth byte
+        // moved either way, plus the extremes
+        int disagreements = 0;
+        for (size_t i = 0; i <= count; i++) {
+            uint8_t probes[5][GOLDEN_DB_DIGEST_BYTES];
+            int n = 0;
+            if (i < count) {
+                for (int d = -1; d <= 1; d += 2) {
+                    memcpy(probes[n], sorted[i], GOLDEN_DB_DIGEST_BYTES);
+                    probes[n++][GOLDEN_DB_DIGEST_BYTES - 1] += (uint8_t)d;
+                    memcpy(probes[n], sorted[i], GOLDEN_DB_DIGEST_BYTES);
+                    probes[n++][7] += (uint8_t)d;
+                }
+            } else {
+                memset(probes[n++], 0x00, GOLDEN_DB_DIGEST_BYTES);
+                memset(probes[n++], 0xff, GOLDEN_DB_DIGEST_BYTES);
+                random_digest(probes[n++]);
+            }
+            for (int p = 0; p < n; p++) {
+                const golden_record_t *found = golden_db_lookup(db, probes[p]);
+                bool expected = reference_has(sorted, count, probes[p]);
+                disagreements += (found != NULL) != expected ||
+                                 (found && memcmp(found->digest, probes[p],
+                                                  GOLDEN_DB_DIGEST_BYTES) != 0);
+            }
+        }
+        CHECK_EQ_INT(disagreements, 0);
+
+        golden_db_close(db);
+        free(sorted);
+        free(records);
+    }
+    unlink(g_path);
+}
+
+static void test_build_rejects_duplicates(void) {
+    golden_record_t *records = make_records(10);
+    records[7] = records[2];
+    records[7].version = 99;
+
+    CHECK_EQ_INT(golden_db_build(g_path, records, 10, 1), PQC_ERROR_INVALID_PARAMETER);
+    CHECK_EQ_INT(access(g_path, F_OK), -1);
+    CHECK_EQ_INT(directory_entries(), 0);
+    free(records);
+}
+
+/**
+ * @brief Damaged copies of a valid file are refused before any lookup
+ */
+static void test_open_rejects_bad_files(void) {
+    golden_record_t *records = make_records(50);
+    CHECK_EQ_INT(golden_db_build(g_path, records, 50, 7), PQC_SUCCESS);
+    size_t length;
+    uint8_t *good = read_file(g_path, &length);
+    uint8_t *bad = malloc(length + GOLDEN_DB_DIGEST_BYTES);
+    golden_db_header_t *h = (golden_db_header_t *)bad;
+    char path[sizeof(g_path) + 8];
+    snprintf(path, sizeof(path), "%s.bad", g_path);
+    golden_db_t *db = NULL;
+
+    // The unmodified copy opens, so each rejection below is its own field
+    write_file(path, good, length);
+    CHECK_EQ_INT(golden_db_open(&db, path), PQC_SUCCESS);
+    golden_db_close(db);
+
+    enum { MAGIC, VERSION, FILE_SIZE, PREFIX_OFFSET, RECORD_OFFSET, COUNT, HUGE_COUNT, CASES };
+    for (int c = 0; c < CASES; c++) {
+        memcpy(bad, good, length);
+        switch (c) {
+        case MAGIC:         h->magic ^= 1; break;
+        case VERSION:       h->version++; break;
+        case FILE_SIZE:     h->file_size--; break;
+        case PREFIX_OFFSET: h->prefix_offset += 8; break;
+        case RECORD_OFFSET: h->record_offset -= 8; break;
+        case COUNT:         h->count++; break;
+        case HUGE_COUNT:    h->count = UINT64_MAX; break;
+        }
+        write_file(path, bad, length);
+        db = (golden_db_t *)1;
+        CHECK_EQ_INT(golden_db_open(&db, path), PQC_ERROR_INVALID_PARAMETER);
+        CHECK(db == NULL);
+    }
+
+    // Truncated anywhere, down to nothing, or with trailing bytes
+    static const size_t cut[] = { 1, sizeof(golden_record_t), 0 };
+    for (size_t i = 0; i < sizeof(cut) / sizeof(cut[0]); i++) {
+        write_file(path, good, cut[i] ? length - cut[i] : 0);
+        CHECK_EQ_INT(golden_db_open(&db, path), PQC_ERROR_INVALID_PARAMETER);
+    }
+    write_file(path, good, sizeof(golden_db_header_t) - 1);
+    CHECK_EQ_INT(golden_db_open(&db, path), PQC_ERROR_INVALID_PARAMETER);
+    memcpy(bad, good, length);
+    memset(bad + length, 0, GOLDEN_DB_DIGEST_BYTES);
+    write_file(path, bad, length + GOLDEN_DB_DIGEST_BYTES);
+    CHECK_EQ_INT(golden_db_open(&db, path), PQC_ERROR_INVALID_PARAMETER);
+
+    unlink(path);
+    CHECK_EQ_INT(golden_db_open(&db, path), PQC_ERROR_HARDWARE_FAILURE);
+    CHECK_EQ_INT(golden_db_open(NULL, g_path), PQC_ERROR_INVALID_PARAMETER);
+
+    unlink(g_path);
+    free(bad);
+    free(good);
+    free(records);
+}
+
+/**
+ * @brief A rebuilt file is swapped in whole: the old mapping keeps
+ *        answering from the old records until the reader reopens
+ */
+static void test_replace_while_open(void) {
+    golden_record_t *first = make_records(20);
+    golden_record_t *second = make_records(30);
+    golden_db_t *old_db = NULL, *new_db = NULL;
+
+    CHECK_EQ_INT(golden_db_build(g_path, first, 20, 1), PQC_SUCCESS);
+    CHECK_EQ_INT(golden_db_open(&old_db, g_path), PQC_SUCCESS);
+    if (!old_db) {
+        free(second);
+        free(first);
+        return;
+    }
+    CHECK(!golden_db_changed(old_db));
+
+    CHECK_EQ_INT(golden_db_build(g_path, second, 30, 2), PQC_SUCCESS);
+    CHECK(golden_db_changed(old_db));
+    CHECK(golden_db_lookup(old_db, first[5].digest) != NULL);
+    CHECK(golden_db_lookup(old_db, second[5].digest) == NULL);
+    CHECK_EQ_INT(golden_db_generation(old_db), 1);
+
+    CHECK_EQ_INT(golden_db_open(&new_db, g_path), PQC_SUCCESS);
+    if (new_db) {
+        CHECK(!golden_db_changed(new_db));
+        CHECK(golden_db_lookup(new_db, first[5].digest) == NULL);
+        CHECK(golden_db_lookup(new_db, second[5].digest) != NULL);
+        CHECK_EQ_INT(golden_db_generation(new_db), 2);
+        golden_db_close(new_db);
+    }
+    golden_db_close(old_db);
+
+    // No temporary file is left behind by either build
+    CHECK_EQ_INT(directory_entries(), 1);
+    unlink(g_path);
+    free(second);
+    free(first);
+}
+
+int main(void) {
+    if (!mkdtemp(g_dir)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    snprintf(g_path, sizeof(g_path), "%s/golden.db", g_dir);
+    RUN_TEST(test_lookup_matches_sorted);
+    RUN_TEST(test_build_rejects_duplicates);
+    RUN_TEST(test_open_rejects_bad_files);
+    RUN_TEST(test_replace_while_open);
+    CHECK_EQ_INT(rmdir(g_dir), 0);
+    return test_finish();
+}
@@ -0,0 +1,111 @@
+/**
+ * @file test_kyber.c
+ * @brief Kyber-1024 encapsulate/decapsulate agreement, implicit rejection
+ *        and public key validation
+ */
+
+#include "test_common.h"
+#include "kyber.h"
+#include "pqc_common.h"
+
+static kyber_public_key_t g_pk;
+static kyber_secret_key_t g_sk;
+
+static void test_shared_secret_matches(void) {
+    kyber_ciphertext_t ct;
+    uint8_t ss_enc[KYBER_SSBYTES], ss_dec[KYBER_SSBYTES], first[KYBER_SSBYTES];
+
+    CHECK_EQ_INT(kyber_keypair(&g_pk, &g_sk), PQC_SUCCESS);
+    for (int i = 0; i < 20; i++) {
+        CHECK_EQ_INT(kyber_encapsulate(&ct, ss_enc, &g_pk), PQC_SUCCESS);
+        CHECK_EQ_INT(kyber_decapsulate(ss_dec, &ct, &g_sk), PQC_SUCCESS);
+        CHECK_MEM(ss_dec, ss_enc, KYBER_SSBYTES);
+        if (i == 0) {
+            memcpy(first, ss_enc, KYBER_SSBYTES);
+        } else {
+            CHECK(memcmp(first, ss_enc, KYBER_SSBYTES) != 0);
+        }
+    }
+}
+
+/**
+ * @brief An altered ciphertext decapsulates to a different secret, and to
+ *        the same one every time, so the caller sees no failure signal
+ */
+static void test_implicit_rejection(void) {
+    kyber_ciphertext_t ct, bad;
+    uint8_t ss[KYBER_SSBYTES], rejected[KYBER_SSBYTES], again[KYBER_SSBYTES];
+
+    CHECK_EQ_INT(kyber_encapsulate(&ct, ss, &g_pk), PQC_SUCCESS);
+
+    // One bit in u and one in v
+    const size_t offsets[] = { 0, sizeof(ct.u) + 7 };
+    for (size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+        memcpy(&bad, &ct, sizeof(ct));
+        ((uint8_t *)&bad)[offsets[i]] ^= 0x01;
+        CHECK_EQ_INT(kyber_decapsulate(rejected, &bad, &g_sk), PQC_SUCCESS);
+        CHECK(memcmp(rejected, ss, KYBER_SSBYTES) != 0);
+        CHECK_EQ_INT(kyber_decapsulate(again, &bad, &g_sk), PQC_SUCCESS);
+        CHECK_MEM(again, rejected, KYBER_SSBYTES);
+    }
+
+    // A different key pair cannot recover the secret
+    static kyber_public_key_t other_pk;
+    static kyber_secret_key_t other_sk;
+    CHECK_EQ_INT(kyber_keypair(&other_pk, &other_sk), PQC_SUCCESS);
+    CHECK_EQ_INT(kyber_decapsulate(rejected, &ct, &other_sk), PQC_SUCCESS);
+    CHECK(memcmp(rejected, ss, KYBER_SSBYTES) != 0);
+}
+
+static void test_pack_public_key(void) {
+    static uint16_t t[4 * 256];
+    kyber_public_key_t repacked;
+
+    kyber_unpack_public_key(t, &g_pk);
+    for (size_t i = 0; i < sizeof(t) / sizeof(t[0]); i++) {
+        CHECK(t[i] < 3329);
+    }
+    kyber_pack_public_key(&repacked, t, g_pk.seed);
+    CHECK_MEM(&repacked, &g_pk, sizeof(g_pk));
+}
+
+/**
+ * @brief A coefficient of q or more is refused; a generated key and any
+ *        full-size ciphertext pass
+ */
+static void test_validate(void) {
+    kyber_public_key_t bad;
+    kyber_ciphertext_t ct;
+    uint8_t ss[KYBER_SSBYTES];
+
+    CHECK_EQ_INT(kyber_validate_public_key(&g_pk), PQC_SUCCESS);
+
+    // The first coefficient is the low 12 bits of t[0..1]: 0xFFF, then q
+    memcpy(&bad, &g_pk, sizeof(bad));
+    bad.t[0] = 0xFF;
+    bad.t[1] |= 0x0F;
+    CHECK_EQ_INT(kyber_validate_public_key(&bad), PQC_ERROR_INVALID_KEY);
+    bad.t[0] = 3329 & 0xFF;
+    bad.t[1] = (uint8_t)((bad.t[1] & 0xF0) | (3329 >> 8));
+    CHECK_EQ_INT(kyber_validate_public_key(&bad), PQC_ERROR_INVALID_KEY);
+    bad.t[0] = 3328 & 0xFF;
+    CHECK_EQ_INT(kyber_validate_public_key(&bad), PQC_SUCCESS);
+
+    CHECK_EQ_INT(kyber_encapsulate(&ct, ss, &g_pk), PQC_SUCCESS);
+    CHECK_EQ_INT(kyber_validate_ciphertext(&ct), PQC_SUCCESS);
+    memset(&ct, 0xFF, sizeof(ct));
+    CHECK_EQ_INT(kyber_validate_ciphertext(&ct), PQC_SUCCESS);
+
+    CHECK_EQ_INT(kyber_validate_public_key(NULL), PQC_ERROR_INVALID_PARAMETER);
+    CHECK_EQ_INT(kyber_validate_ciphertext(NULL), PQC_ERROR_INVALID_PARAMETER);
+}
+
+int main(void) {
+    CHECK_EQ_INT(pqc_init(NULL), PQC_SUCCESS);
+    RUN_TEST(test_shared_secret_matches);
+    RUN_TEST(test_implicit_rejection);
+    RUN_TEST(test_pack_public_key);
+    RUN_TEST(test_validate);
+    pqc_cleanup();
+    return test_finish();
+}
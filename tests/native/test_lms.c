@@ -0,0 +1,473 @@
+/**
+ * @file test_lms.c
+ * @brief HSS/LMS sign/verify, and that no one-time index is ever used twice
+ *        across signer restarts, NV write failures and the TPM NV store
+ *
+ * Run as "test_lms --dump <dir>" it instead writes keys, messages and
+ * signatures for lms_model.py to check against RFC 8554.
+ */
+
+#include "test_common.h"
+#include "lms.h"
+#include "attestation_engine.h"
+#include "tpm2_interface.h"
+#include "pqc_common.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <unistd.h>
+
+#define TEST_NV_INDEX   0x01500020u
+#define MAX_INDICES     1024
+
+static const uint8_t g_msg[] = "firmware measurement 0001";
+
+// Two H5 levels: 1024 signatures, each bottom tree used for 32 of them
+static const hss_params_t g_two_level = {
+    2, { LMS_SHA256_M32_H5, LMS_SHA256_M32_H5 }, { LMOTS_SHA256_N32_W4, LMOTS_SHA256_N32_W4 }
+};
+
+static char g_dir[] = "/tmp/test_lms.XXXXXX";
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t load_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static unsigned lms_height(uint32_t type) {
+    return type >= LMS_SHA256_M32_H5 && type <= LMS_SHA256_M32_H25 ? 5 * (type - 4) : 0;
+}
+
+static unsigned lmots_p(uint32_t type) {
+    static const unsigned p[] = { 0, 265, 133, 67, 34 };
+    return type >= LMOTS_SHA256_N32_W1 && type <= LMOTS_SHA256_N32_W8 ? p[type] : 0;
+}
+
+/**
+ * @brief Position of a signature's bottom-level one-time key in the whole
+ *        hypertree, from the q of every level (RFC 8554 section 6.2)
+ */
+static uint64_t signature_index(const uint8_t *sig, size_t siglen) {
+    uint32_t levels = load_be32(sig) + 1;
+    size_t off = 4;
+    uint64_t index = 0;
+
+    for (uint32_t i = 0; i < levels; i++) {
+        uint32_t q = load_be32(sig + off);
+        unsigned p = lmots_p(load_be32(sig + off + 4));
+        size_t type_off = off + 8 + 32 * (p + 1);
+        unsigned h = lms_height(load_be32(sig + type_off));
+        index = (index << h) | q;
+        off = type_off + 4 + 32 * h;
+        if (i + 1 < levels) {
+            off += 56;  // Signed public key of the next level
+        }
+    }
+    CHECK_EQ_INT(off, siglen);
+    return index;
+}
+
+/**
+ * @brief Store wrapper that remembers the last durable reservation and
+ *        can be told to fail writes
+ */
+typedef struct {
+    hss_nv_store_t inner;
+    uint64_t durable;
+    unsigned writes;
+    bool fail;
+} watched_store_t;
+
+static pqc_result_t watched_read(void *ctx, uint8_t record[HSS_NV_RECORD_BYTES]) {
+    watched_store_t *w = ctx;
+    return w->inner.read(w->inner.ctx, record);
+}
+
+static pqc_result_t watched_write(void *ctx, const uint8_t record[HSS_NV_RECORD_BYTES]) {
+    watched_store_t *w = ctx;
+    if (w->fail) {
+        return PQC_ERROR_HARDWARE_FAILURE;
+    }
+    pqc_result_t result = w->inner.write(w->inner.ctx, record);
+    if (result == PQC_SUCCESS) {
+        // Record layout: magic || key id || u64 reserved || check
+        w->durable = ((uint64_t)load_be32(record + 20) << 32) | load_be32(record + 24);
+        w->writes++;
+    }
+    return result;
+}
+
+static hss_nv_store_t watched(watched_store_t *w) {
+    hss_nv_store_t store = { watched_read, watched_write, w };
+    return store;
+}
+
+/**
+ * @brief Sign count messages, checking each signature verifies, uses an
+ *        index above the previous one and below the durable reservation
+ */
+static void sign_batch(hss_signer_t *signer, const uint8_t *pk, const watched_store_t *w,
+                       uint8_t *sig, bool used[MAX_INDICES], int64_t *last, unsigned count) {
+    for (unsigned i = 0; i < count; i++) {
+        size_t siglen = 0;
+        CHECK_EQ_INT(hss_sign(signer, sig, &siglen, g_msg, sizeof(g_msg)), PQC_SUCCESS);
+        CHECK_EQ_INT(hss_verify(sig, siglen, g_msg, sizeof(g_msg), pk, HSS_PUBLICKEYBYTES),
+                     PQC_SUCCESS);
+
+        uint64_t index = signature_index(sig, siglen);
+        CHECK(index < MAX_INDICES);
+        CHECK((int64_t)index > *last);
+        CHECK(index < w->durable);
+        if (index < MAX_INDICES) {
+            CHECK(!used[index]);
+            used[index] = true;
+        }
+        *last = (int64_t)index;
+    }
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+static void test_round_trip(void) {
+    static const hss_params_t shapes[] = {
+        { 1, { LMS_SHA256_M32_H5 }, { LMOTS_SHA256_N32_W1 } },
+        { 1, { LMS_SHA256_M32_H5 }, { LMOTS_SHA256_N32_W2 } },
+        { 1, { LMS_SHA256_M32_H5 }, { LMOTS_SHA256_N32_W8 } },
+        { 2, { LMS_SHA256_M32_H5, LMS_SHA256_M32_H5 },
+             { LMOTS_SHA256_N32_W8, LMOTS_SHA256_N32_W4 } },
+    };
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s/round_trip.state", g_dir);
+
+    for (size_t k = 0; k < sizeof(shapes) / sizeof(shapes[0]); k++) {
+        uint8_t pk[HSS_PUBLICKEYBYTES], sk[HSS_SECRETKEYBYTES];
+        hss_nv_store_t store;
+        hss_signer_t *signer = NULL;
+        size_t sig_bytes = hss_signature_bytes(&shapes[k]);
+        uint8_t *sig = malloc(sig_bytes), *bad = malloc(sig_bytes);
+        size_t siglen = 0;
+        CHECK(sig != NULL && bad != NULL);
+        if (!sig || !bad) {
+            free(sig);
+            free(bad);
+            return;
+        }
+
+        CHECK_EQ_INT(hss_nv_file_store(&store, path), PQC_SUCCESS);
+        CHECK_EQ_INT(hss_keypair(&shapes[k], pk, sk, &store), PQC_SUCCESS);
+        CHECK_EQ_INT(load_be32(pk), shapes[k].levels);
+        CHECK_EQ_INT(hss_signer_open(&signer, sk, sizeof(sk), &store, 0), PQC_SUCCESS);
+        if (!signer) {
+            free(sig);
+            free(bad);
+            continue;
+        }
+        CHECK_EQ_INT(hss_sign(signer, sig, &siglen, g_msg, sizeof(g_msg)), PQC_SUCCESS);
+        CHECK_EQ_INT(siglen, sig_bytes);
+        CHECK_EQ_INT(hss_verify(sig, siglen, g_msg, sizeof(g_msg), pk, sizeof(pk)), PQC_SUCCESS);
+
+        // The empty message is a valid input
+        CHECK_EQ_INT(hss_sign(signer, bad, &siglen, NULL, 0), PQC_SUCCESS);
+        CHECK_EQ_INT(hss_verify(bad, siglen, NULL, 0, pk, sizeof(pk)), PQC_SUCCESS);
+
+        // Level count, q, randomizer C, last authentication path node
+        const size_t offsets[] = { 3, 7, 12, sig_bytes - 1 };
+        for (size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+            memcpy(bad, sig, sig_bytes);
+            bad[offsets[i]] ^= 0x01;
+            CHECK(hss_verify(bad, sig_bytes, g_msg, sizeof(g_msg), pk, sizeof(pk)) != PQC_SUCCESS);
+        }
+
+        uint8_t msg[sizeof(g_msg)];
+        memcpy(msg, g_msg, sizeof(msg));
+        msg[0] ^= 0x01;
+        CHECK(hss_verify(sig, sig_bytes, msg, sizeof(msg), pk, sizeof(pk)) != PQC_SUCCESS);
+        CHECK(hss_verify(sig, sig_bytes - 1, g_msg, sizeof(g_msg), pk, sizeof(pk)) != PQC_SUCCESS);
+
+        pk[sizeof(pk) - 1] ^= 0x01;
+        CHECK(hss_verify(sig, sig_bytes, g_msg, sizeof(g_msg), pk, sizeof(pk)) != PQC_SUCCESS);
+
+        hss_signer_close(signer);
+        free(sig);
+        free(bad);
+    }
+    unlink(path);
+}
+
+static void test_reopen_never_reuses(void) {
+    enum { RESERVE = 4 };
+    uint8_t pk[HSS_PUBLICKEYBYTES], sk[HSS_SECRETKEYBYTES];
+    bool used[MAX_INDICES] = { false };
+    int64_t last = -1;
+    char path[PATH_MAX];
+    watched_store_t w = { 0 };
+    hss_nv_store_t store = watched(&w);
+    uint8_t *sig = malloc(hss_signature_bytes(&g_two_level));
+    CHECK(sig != NULL);
+    if (!sig) {
+        return;
+    }
+
+    snprintf(path, sizeof(path), "%s/reopen.state", g_dir);
+    CHECK_EQ_INT(hss_nv_file_store(&w.inner, path), PQC_SUCCESS);
+    CHECK_EQ_INT(hss_keypair(&g_two_level, pk, sk, &store), PQC_SUCCESS);
+    CHECK_EQ_INT(w.durable, 0);
+
+    // 6 signatures reserve [0, 4) then [4, 8); the restart skips 6 and 7
+    hss_signer_t *signer = NULL;
+    CHECK_EQ_INT(hss_signer_open(&signer, sk, sizeof(sk), &store, RESERVE), PQC_SUCCESS);
+    CHECK_EQ_INT(hss_signer_remaining(signer), MAX_INDICES);
+    sign_batch(signer, pk, &w, sig, used, &last, 6);
+    CHECK_EQ_INT(w.writes, 3);  // keypair, then one per batch
+    CHECK_EQ_INT(last, 5);
+    hss_signer_close(signer);
+
+    CHECK_EQ_INT(hss_signer_open(&signer, sk, sizeof(sk), &store, RESERVE), PQC_SUCCESS);
+    CHECK_EQ_INT(hss_signer_remaining(signer), MAX_INDICES - 8);
+    sign_batch(signer, pk, &w, sig, used, &last, 1);
+    CHECK_EQ_INT(last, 8);
+    hss_signer_close(signer);
+
+    // Restarts that sign nothing reserve nothing, so they do not burn indices
+    for (int crash = 0; crash < 3; crash++) {
+        CHECK_EQ_INT(hss_signer_open(&signer, sk, sizeof(sk), &store, RESERVE), PQC_SUCCESS);
+        hss_signer_close(signer);
+    }
+    CHECK_EQ_INT(hss_signer_open(&signer, sk, sizeof(sk), &store, RESERVE), PQC_SUCCESS);
+    sign_batch(signer, pk, &w, sig, used, &last, 1);
+    CHECK_EQ_INT(last, 12);
+
+    // Across a bottom-tree boundary (index 32) the upper level signs a new tree
+    sign_batch(signer, pk, &w, sig, used, &last, 40);
+    CHECK_EQ_INT(last, 52);
+    hss_signer_close(signer);
+
+    // A different key's record is refused rather than reinterpreted
+    uint8_t other_pk[HSS_PUBLICKEYBYTES], other_sk[HSS_SECRETKEYBYTES];
+    char other_path[PATH_MAX];
+    hss_nv_store_t other;
+    snprintf(other_path, sizeof(other_path), "%s/other.state", g_dir);
+    CHECK_EQ_INT(hss_nv_file_store(&other, other_path), PQC_SUCCESS);
+    CHECK_EQ_INT(hss_keypair(&g_two_level, other_pk, other_sk, &other), PQC_SUCCESS);
+    CHECK_EQ_INT(hss_signer_open(&signer, sk, sizeof(sk), &other, RESERVE), PQC_ERROR_INVALID_KEY);
+
+    free(sig);
+    unlink(path);
+    unlink(other_path);
+}
+
+static void test_failed_nv_write(void) {
+    enum { RESERVE = 2 };
+    uint8_t pk[HSS_PUBLICKEYBYTES], sk[HSS_SECRETKEYBYTES];
+    bool used[MAX_INDICES] = { false };
+    int64_t last = -1;
+    char path[PATH_MAX];
+    watched_store_t w = { 0 };
+    hss_nv_store_t store = watched(&w);
+    hss_signer_t *signer = NULL;
+    size_t siglen = 0;
+    uint8_t *sig = malloc(hss_signature_bytes(&g_two_level));
+    CHECK(sig != NULL);
+    if (!sig) {
+        return;
+    }
+
+    snprintf(path, sizeof(path), "%s/failed.state", g_dir);
+    CHECK_EQ_INT(hss_nv_file_store(&w.inner, path), PQC_SUCCESS);
+    CHECK_EQ_INT(hss_keypair(&g_two_level, pk, sk, &store), PQC_SUCCESS);
+    CHECK_EQ_INT(hss_signer_open(&signer, sk, sizeof(sk), &store, RESERVE), PQC_SUCCESS);
+    sign_batch(signer, pk, &w, sig, used, &last, 2);
+
+    // No signature may come out of an index that was not made durable first
+    w.fail = true;
+    memset(sig, 0, hss_signature_bytes(&g_two_level));
+    CHECK_EQ_INT(hss_sign(signer, sig, &siglen, g_msg, sizeof(g_msg)), PQC_ERROR_HARDWARE_FAILURE);
+    CHECK(hss_verify(sig, hss_signature_bytes(&g_two_level), g_msg, sizeof(g_msg),
+                     pk, sizeof(pk)) != PQC_SUCCESS);
+    CHECK_EQ_INT(hss_signer_remaining(signer), MAX_INDICES - 2);
+
+    w.fail = false;
+    sign_batch(signer, pk, &w, sig, used, &last, 3);
+    CHECK_EQ_INT(last, 4);
+    hss_signer_close(signer);
+
+    free(sig);
+    unlink(path);
+}
+
+static void test_exhaustion(void) {
+    static const hss_params_t shape = { 1, { LMS_SHA256_M32_H5 }, { LMOTS_SHA256_N32_W8 } };
+    uint8_t pk[HSS_PUBLICKEYBYTES], sk[HSS_SECRETKEYBYTES];
+    bool used[MAX_INDICES] = { false };
+    int64_t last = -1;
+    char path[PATH_MAX];
+    watched_store_t w = { 0 };
+    hss_nv_store_t store = watched(&w);
+    hss_signer_t *signer = NULL;
+    size_t siglen = 0;
+    uint8_t *sig = malloc(hss_signature_bytes(&shape));
+    CHECK(sig != NULL);
+    if (!sig) {
+        return;
+    }
+
+    snprintf(path, sizeof(path), "%s/exhaustion.state", g_dir);
+    CHECK_EQ_INT(hss_nv_file_store(&w.inner, path), PQC_SUCCESS);
+    CHECK_EQ_INT(hss_keypair(&shape, pk, sk, &store), PQC_SUCCESS);
+    CHECK_EQ_INT(hss_signer_open(&signer, sk, sizeof(sk), &store, 10), PQC_SUCCESS);
+    sign_batch(signer, pk, &w, sig, used, &last, 25);
+    hss_signer_close(signer);
+
+    // [20, 30) was reserved; only 30 and 31 are left
+    CHECK_EQ_INT(hss_signer_open(&signer, sk, sizeof(sk), &store, 10), PQC_SUCCESS);
+    CHECK_EQ_INT(hss_signer_remaining(signer), 2);
+    sign_batch(signer, pk, &w, sig, used, &last, 2);
+    CHECK_EQ_INT(last, 31);
+    CHECK_EQ_INT(w.durable, 32);
+    CHECK_EQ_INT(hss_signer_remaining(signer), 0);
+    CHECK_EQ_INT(hss_sign(signer, sig, &siglen, g_msg, sizeof(g_msg)), PQC_ERROR_INVALID_KEY);
+    hss_signer_close(signer);
+
+    CHECK_EQ_INT(hss_signer_open(&signer, sk, sizeof(sk), &store, 10), PQC_SUCCESS);
+    CHECK_EQ_INT(hss_sign(signer, sig, &siglen, g_msg, sizeof(g_msg)), PQC_ERROR_INVALID_KEY);
+    hss_signer_close(signer);
+
+    free(sig);
+    unlink(path);
+}
+
+static void test_tpm_nv_store(void) {
+    enum { RESERVE = 4 };
+    uint8_t pk[HSS_PUBLICKEYBYTES], sk[HSS_SECRETKEYBYTES];
+    bool used[MAX_INDICES] = { false };
+    int64_t last = -1;
+    watched_store_t w = { 0 };
+    hss_nv_store_t store = watched(&w);
+    hss_signer_t *signer = NULL;
+    char path[PATH_MAX];
+    uint8_t *sig = malloc(hss_signature_bytes(&g_two_level));
+    CHECK(sig != NULL);
+    if (!sig) {
+        return;
+    }
+
+    // RAM-only NV would forget the reservation on restart
+    CHECK_EQ_INT(tpm2_init(), PQC_SUCCESS);
+    CHECK_EQ_INT(attestation_hss_nv_store(&w.inner, TEST_NV_INDEX), PQC_ERROR_HARDWARE_FAILURE);
+
+    CHECK_EQ_INT(tpm2_nv_set_backing_dir(g_dir), PQC_SUCCESS);
+    CHECK_EQ_INT(attestation_hss_nv_store(&w.inner, TEST_NV_INDEX), PQC_SUCCESS);
+    CHECK_EQ_INT(hss_keypair(&g_two_level, pk, sk, &store), PQC_SUCCESS);
+    CHECK_EQ_INT(hss_signer_open(&signer, sk, sizeof(sk), &store, RESERVE), PQC_SUCCESS);
+    sign_batch(signer, pk, &w, sig, used, &last, 5);
+    hss_signer_close(signer);
+
+    // Restart the TPM: the record has to come back from the backing file
+    for (int restart = 0; restart < 2; restart++) {
+        tpm2_cleanup();
+        CHECK_EQ_INT(tpm2_init(), PQC_SUCCESS);
+        CHECK_EQ_INT(hss_signer_open(&signer, sk, sizeof(sk), &store, RESERVE), PQC_SUCCESS);
+        sign_batch(signer, pk, &w, sig, used, &last, 3);
+        hss_signer_close(signer);
+    }
+    CHECK_EQ_INT(last, 14);
+
+    tpm2_cleanup();
+    tpm2_nv_set_backing_dir(NULL);
+    snprintf(path, sizeof(path), "%s/nv-%08x.bin", g_dir, TEST_NV_INDEX);
+    CHECK_EQ_INT(unlink(path), 0);
+    free(sig);
+}
+
+// ============================================================================
+// Model Input
+// ============================================================================
+
+static bool write_file(const char *dir, const char *name, size_t k,
+                       const uint8_t *data, size_t len) {
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s/%s-%zu.bin", dir, name, k);
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+    bool ok = fwrite(data, 1, len, f) == len;
+    return fclose(f) == 0 && ok;
+}
+
+/**
+ * @brief Write sk/pk/msg/sig-<k>.bin for every shape lms_model.py checks
+ */
+static int dump_signatures(const char *dir) {
+    static const hss_params_t shapes[] = {
+        { 1, { LMS_SHA256_M32_H5 }, { LMOTS_SHA256_N32_W1 } },
+        { 1, { LMS_SHA256_M32_H5 }, { LMOTS_SHA256_N32_W2 } },
+        { 1, { LMS_SHA256_M32_H5 }, { LMOTS_SHA256_N32_W4 } },
+        { 1, { LMS_SHA256_M32_H5 }, { LMOTS_SHA256_N32_W8 } },
+        { 3, { LMS_SHA256_M32_H5, LMS_SHA256_M32_H5, LMS_SHA256_M32_H5 },
+             { LMOTS_SHA256_N32_W8, LMOTS_SHA256_N32_W4, LMOTS_SHA256_N32_W1 } },
+    };
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s/dump.state", dir);
+
+    for (size_t k = 0; k < sizeof(shapes) / sizeof(shapes[0]); k++) {
+        uint8_t pk[HSS_PUBLICKEYBYTES], sk[HSS_SECRETKEYBYTES], msg[64];
+        hss_nv_store_t store;
+        hss_signer_t *signer = NULL;
+        size_t siglen = 0;
+        uint8_t *sig = malloc(hss_signature_bytes(&shapes[k]));
+        if (!sig || pqc_randombytes(msg, sizeof(msg)) != PQC_SUCCESS ||
+            hss_nv_file_store(&store, path) != PQC_SUCCESS ||
+            hss_keypair(&shapes[k], pk, sk, &store) != PQC_SUCCESS ||
+            hss_signer_open(&signer, sk, sizeof(sk), &store, 1) != PQC_SUCCESS) {
+            free(sig);
+            return 1;
+        }
+
+        // Skip ahead so q is not 0 and the authentication paths are not all left turns
+        pqc_result_t result = PQC_SUCCESS;
+        for (size_t i = 0; i <= 5 + 3 * k && result == PQC_SUCCESS; i++) {
+            result = hss_sign(signer, sig, &siglen, msg, sizeof(msg));
+        }
+        hss_signer_close(signer);
+
+        bool ok = result == PQC_SUCCESS &&
+                  write_file(dir, "sk", k, sk, sizeof(sk)) &&
+                  write_file(dir, "pk", k, pk, sizeof(pk)) &&
+                  write_file(dir, "msg", k, msg, sizeof(msg)) &&
+                  write_file(dir, "sig", k, sig, siglen);
+        free(sig);
+        if (!ok) {
+            return 1;
+        }
+    }
+    unlink(path);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    CHECK_EQ_INT(pqc_init(NULL), PQC_SUCCESS);
+    if (argc == 3 && strcmp(argv[1], "--dump") == 0) {
+        int status = dump_signatures(argv[2]);
+        pqc_cleanup();
+        return status;
+    }
+
+    if (!mkdtemp(g_dir)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_reopen_never_reuses);
+    RUN_TEST(test_failed_nv_write);
+    RUN_TEST(test_exhaustion);
+    RUN_TEST(test_tpm_nv_store);
+    CHECK_EQ_INT(rmdir(g_dir), 0);
+    pqc_cleanup();
+    return test_finish();
+}
@@ -0,0 +1,152 @@
+/**
+ * @file test_perf.c
+ * @brief Counter group behaviour when perf_event_open() is refused, as it
+ *        is under restrictive perf_event_paranoid, containers and seccomp
+ */
+
+#define _GNU_SOURCE
+
+#include "test_common.h"
+#include "pqc_perf.h"
+#include <errno.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <linux/audit.h>
+#include <linux/filter.h>
+#include <linux/seccomp.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+
+#if defined(__x86_64__)
+#define TEST_AUDIT_ARCH AUDIT_ARCH_X86_64
+#elif defined(__aarch64__)
+#define TEST_AUDIT_ARCH AUDIT_ARCH_AARCH64
+#endif
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+#ifdef TEST_AUDIT_ARCH
+/**
+ * @brief Make perf_event_open() fail with @p err for the rest of the process
+ */
+static int deny_perf_event_open(int err) {
+    struct sock_filter filter[] = {
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(struct seccomp_data, arch)),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, TEST_AUDIT_ARCH, 1, 0),
+        BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW),
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(struct seccomp_data, nr)),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, SYS_perf_event_open, 0, 1),
+        BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ERRNO | (uint32_t)err),
+        BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW),
+    };
+    struct sock_fprog prog = { sizeof(filter) / sizeof(filter[0]), filter };
+
+    if (prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) != 0) {
+        return -1;
+    }
+    return prctl(PR_SET_SECCOMP, SECCOMP_MODE_FILTER, &prog);
+}
+#endif
+
+/**
+ * @brief With every open refused: the mapped error, an empty group, and
+ *        phase hooks that record nothing
+ */
+static void check_unavailable(pqc_result_t expected) {
+    uint64_t values[PQC_PERF_COUNTER_COUNT];
+    pqc_perf_counters_t phases[PQC_PERF_PHASE_COUNT];
+
+    CHECK_EQ_INT(pqc_perf_thread_open(), expected);
+    CHECK_EQ_INT(pqc_perf_valid_mask(), 0);
+
+    memset(values, 0xA5, sizeof(values));
+    CHECK_EQ_INT(pqc_perf_read(values), PQC_ERROR_HARDWARE_FAILURE);
+    for (int i = 0; i < PQC_PERF_COUNTER_COUNT; i++) {
+        CHECK_EQ_INT(values[i], 0);
+    }
+
+    pqc_perf_reset_phase_counters();
+    pqc_perf_phase_begin(PQC_PERF_PHASE_HASH);
+    pqc_perf_phase_end(PQC_PERF_PHASE_HASH);
+    pqc_perf_get_phase_counters(phases);
+    CHECK_EQ_INT(phases[PQC_PERF_PHASE_HASH].samples, 0);
+    CHECK_EQ_INT(phases[PQC_PERF_PHASE_HASH].valid_mask, 0);
+
+    // Closing a group that never opened is harmless, and a retry fails the same way
+    pqc_perf_thread_close();
+    CHECK_EQ_INT(pqc_perf_thread_open(), expected);
+}
+
+/**
+ * @brief Run check_unavailable() in a child whose perf_event_open() fails
+ *        with @p err, folding the child's failures into this process
+ */
+static void run_denied(int err, pqc_result_t expected) {
+#ifdef TEST_AUDIT_ARCH
+    fflush(NULL);
+    pid_t pid = fork();
+    CHECK(pid >= 0);
+    if (pid == 0) {
+        if (deny_perf_event_open(err) != 0) {
+            fprintf(stderr, "seccomp unavailable, skipping errno %d\n", err);
+            _exit(0);
+        }
+        check_unavailable(expected);
+        fflush(NULL);
+        _exit(g_test_failures);
+    }
+
+    int status = 0;
+    CHECK_EQ_INT(waitpid(pid, &status, 0), pid);
+    CHECK(WIFEXITED(status));
+    g_test_failures += WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+#else
+    (void)err;
+    (void)expected;
+#endif
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+static void test_unsupported(void) {
+    run_denied(ENOSYS, PQC_ERROR_NOT_IMPLEMENTED);
+    run_denied(ENOENT, PQC_ERROR_NOT_IMPLEMENTED);
+    run_denied(EOPNOTSUPP, PQC_ERROR_NOT_IMPLEMENTED);
+}
+
+static void test_access_denied(void) {
+    run_denied(EACCES, PQC_ERROR_HARDWARE_FAILURE);
+    run_denied(EPERM, PQC_ERROR_HARDWARE_FAILURE);
+}
+
+/**
+ * @brief Whatever this host allows: an open group reads, a refused one
+ *        reports one of the two documented errors
+ */
+static void test_host(void) {
+    uint64_t values[PQC_PERF_COUNTER_COUNT];
+    pqc_result_t rc = pqc_perf_thread_open();
+
+    if (rc == PQC_SUCCESS) {
+        CHECK(pqc_perf_valid_mask() != 0);
+        CHECK_EQ_INT(pqc_perf_read(values), PQC_SUCCESS);
+        pqc_perf_thread_close();
+        CHECK_EQ_INT(pqc_perf_valid_mask(), 0);
+    } else {
+        CHECK(rc == PQC_ERROR_NOT_IMPLEMENTED || rc == PQC_ERROR_HARDWARE_FAILURE);
+        CHECK_EQ_INT(pqc_perf_valid_mask(), 0);
+    }
+    CHECK_EQ_INT(pqc_perf_read(NULL), PQC_ERROR_INVALID_PARAMETER);
+}
+
+int main(void) {
+    RUN_TEST(test_unsupported);
+    RUN_TEST(test_access_denied);
+    RUN_TEST(test_host);
+    return test_finish();
+}
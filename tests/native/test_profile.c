@@ -0,0 +1,197 @@
+/**
+ * @file test_profile.c
+ * @brief Folded-stack export of the sampling profiler: one merged line per
+ *        stack in the "tag;outer;...;inner count" form flamegraph.pl reads
+ */
+
+#define _GNU_SOURCE
+
+#include "test_common.h"
+#include "pqc_profile.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define TEST_PROFILE_HZ         1000
+#define TEST_MIN_SAMPLES        40
+
+static volatile uint64_t g_sink;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Burn CPU until the profiler has taken @p samples more samples
+ */
+static __attribute__((noinline)) void spin_until_sampled(uint64_t samples) {
+    pqc_profile_stats_t stats;
+    pqc_profile_get_stats(&stats);
+    uint64_t target = stats.samples + samples;
+    double deadline = now_seconds() + 10.0;
+
+    while (stats.samples < target && now_seconds() < deadline) {
+        for (int i = 0; i < 100000; i++) {
+            g_sink = g_sink * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+        pqc_profile_get_stats(&stats);
+    }
+}
+
+/**
+ * @brief A frame is a symbol, "module+0xoffset" or a bare "0xaddress"
+ */
+static int valid_frame(const char *frame, size_t len) {
+    if (len == 0) {
+        return 0;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (isspace((unsigned char)frame[i]) || frame[i] == ';') {
+            return 0;
+        }
+    }
+    const char *plus = memchr(frame, '+', len);
+    if (plus || (len > 2 && frame[0] == '0' && frame[1] == 'x')) {
+        const char *hex = plus ? plus + 1 : frame;
+        size_t hex_len = len - (size_t)(hex - frame);
+        if (hex_len < 3 || hex[0] != '0' || hex[1] != 'x') {
+            return 0;
+        }
+        for (size_t i = 2; i < hex_len; i++) {
+            if (!isxdigit((unsigned char)hex[i])) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+static void test_folded_format(void) {
+    pqc_profile_stats_t before, after;
+
+    CHECK_EQ_INT(pqc_profile_start(TEST_PROFILE_HZ), PQC_SUCCESS);
+    pqc_result_t rc = pqc_profile_thread_start();
+    if (rc == PQC_ERROR_NOT_IMPLEMENTED) {
+        printf("per-thread CPU timers unavailable, skipping\n");
+        pqc_profile_stop();
+        return;
+    }
+    CHECK_EQ_INT(rc, PQC_SUCCESS);
+    pqc_profile_get_stats(&before);
+
+    pqc_profile_op_push("test_op");
+    pqc_profile_phase_push("test_phase");
+    spin_until_sampled(TEST_MIN_SAMPLES);
+    pqc_profile_phase_pop();
+    spin_until_sampled(TEST_MIN_SAMPLES / 4);
+    pqc_profile_op_pop();
+    pqc_profile_stop();
+
+    char *text = NULL;
+    size_t size = 0;
+    FILE *out = open_memstream(&text, &size);
+    CHECK(out != NULL);
+    if (!out) {
+        return;
+    }
+    CHECK_EQ_INT(pqc_profile_write_folded(out), PQC_SUCCESS);
+    fclose(out);
+    pqc_profile_get_stats(&after);
+
+    uint64_t total = 0;
+    int lines = 0, tagged = 0, op_only = 0, bad = 0, duplicates = 0;
+    char **stacks = calloc(size + 1, sizeof(char *));
+    CHECK(size > 0 && text[size - 1] == '\n');
+    for (char *line = text, *end; line < text + size; line = end + 1) {
+        end = strchr(line, '\n');
+        if (!end) {
+            bad++;
+            break;
+        }
+        *end = '\0';
+        lines++;
+
+        // "<stack> <count>": the only space separates the count
+        char *space = strrchr(line, ' ');
+        char *count_end = NULL;
+        unsigned long long count = space ? strtoull(space + 1, &count_end, 10) : 0;
+        if (!space || strchr(line, ' ') != space || count == 0 || !count_end || *count_end) {
+            fprintf(stderr, "malformed line: %s\n", line);
+            bad++;
+            continue;
+        }
+        *space = '\0';
+        total += count;
+
+        // Tag first, then at least the sampled frame, outermost first
+        char *semi = strchr(line, ';');
+        if (!semi) {
+            bad++;
+            continue;
+        }
+        *semi = '\0';
+        if (strcmp(line, "test_op/test_phase") == 0) {
+            tagged++;
+        } else if (strcmp(line, "test_op") == 0) {
+            op_only++;
+        } else if (strcmp(line, "untagged") != 0) {
+            fprintf(stderr, "unexpected tag: %s\n", line);
+            bad++;
+        }
+        *semi = ';';
+        for (char *frame = semi + 1, *next; ; frame = next + 1) {
+            next = strchr(frame, ';');
+            size_t len = next ? (size_t)(next - frame) : strlen(frame);
+            if (!valid_frame(frame, len)) {
+                fprintf(stderr, "bad frame in: %s\n", line);
+                bad++;
+                break;
+            }
+            if (!next) {
+                break;
+            }
+        }
+
+        // Identical stacks are merged into one line
+        for (int i = 0; i < lines - 1; i++) {
+            duplicates += stacks[i] && strcmp(stacks[i], line) == 0;
+        }
+        stacks[lines - 1] = line;
+    }
+
+    CHECK_EQ_INT(bad, 0);
+    CHECK_EQ_INT(duplicates, 0);
+    CHECK(lines > 0);
+    CHECK(tagged > 0);
+    CHECK(op_only > 0);
+    CHECK_EQ_INT(total, after.written - before.written);
+    CHECK_EQ_INT(after.written - before.written,
+                 (after.samples - before.samples) - (after.dropped - before.dropped));
+    free(stacks);
+    free(text);
+
+    // The buffer was drained: a second export writes nothing
+    text = NULL;
+    out = open_memstream(&text, &size);
+    CHECK_EQ_INT(pqc_profile_write_folded(out), PQC_SUCCESS);
+    fclose(out);
+    CHECK_EQ_INT(size, 0);
+    free(text);
+
+    CHECK_EQ_INT(pqc_profile_write_folded(NULL), PQC_ERROR_INVALID_PARAMETER);
+}
+
+int main(void) {
+    RUN_TEST(test_folded_format);
+    return test_finish();
+}
@@ -0,0 +1,286 @@
+/**
+ * @file test_report_cache.c
+ * @brief Report result cache: hits, single-flight coalescing, a failed
+ *        verification releasing its waiters, and expiry capped at the
+ *        report's freshness deadline
+ */
+
+#include "test_common.h"
+#include "report_cache.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <time.h>
+
+#define THREADS 6
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/**
+ * @brief Counting verification that can be held until released
+ */
+typedef struct {
+    _Atomic unsigned calls;
+    _Atomic bool hold;                  /**< First call blocks while set */
+    pqc_result_t first_result;          /**< Returned by the first call only */
+} fake_verifier_t;
+
+static void pause_ms(long ms) {
+    struct timespec ts = { ms / 1000, (ms % 1000) * 1000000L };
+    nanosleep(&ts, NULL);
+}
+
+static pqc_result_t fake_verify(void *ctx, const attestation_report_t *report,
+                                attestation_verification_result_t *result) {
+    fake_verifier_t *v = ctx;
+    unsigned call = atomic_fetch_add(&v->calls, 1);
+    for (int i = 0; call == 0 && atomic_load(&v->hold) && i < 10000; i++) {
+        pause_ms(1);
+    }
+    if (call == 0 && v->first_result != PQC_SUCCESS) {
+        return v->first_result;
+    }
+    memset(result, 0, sizeof(*result));
+    result->is_valid = true;
+    result->trust_level = TRUST_LEVEL_HIGH;
+    result->timestamp = report->timestamp;
+    return PQC_SUCCESS;
+}
+
+static void make_report(attestation_report_t *report, uint64_t timestamp, uint8_t tag) {
+    memset(report, 0, sizeof(*report));
+    report->report_version = ATTESTATION_REPORT_VERSION;
+    report->timestamp = timestamp;
+    report->device_id[0] = tag;
+    report->signature_length = 64;
+    memset(report->signature, tag, 64);
+}
+
+static const uint8_t g_fingerprint[REPORT_CACHE_FINGERPRINT_BYTES] = { 1, 2, 3 };
+
+typedef struct {
+    pthread_t thread;
+    report_cache_t *cache;
+    const attestation_report_t *report;
+    fake_verifier_t *verifier;
+    pqc_result_t status;
+    report_cache_outcome_t how;
+    attestation_verification_result_t result;
+} caller_t;
+
+static void* caller_main(void *arg) {
+    caller_t *c = arg;
+    c->status = report_cache_verify(c->cache, c->report, g_fingerprint, fake_verify,
+                                    c->verifier, &c->result, &c->how);
+    return NULL;
+}
+
+/**
+ * @brief Start a holding verification, pile identical callers on it, release
+ */
+static void run_concurrent(report_cache_t *cache, const attestation_report_t *report,
+                           fake_verifier_t *v, caller_t callers[THREADS]) {
+    atomic_store(&v->hold, true);
+    for (int i = 0; i < THREADS; i++) {
+        callers[i] = (caller_t){ .cache = cache, .report = report, .verifier = v };
+    }
+    pthread_create(&callers[0].thread, NULL, caller_main, &callers[0]);
+    for (int i = 0; i < 10000 && atomic_load(&v->calls) == 0; i++) {
+        pause_ms(1);
+    }
+    for (int i = 1; i < THREADS; i++) {
+        pthread_create(&callers[i].thread, NULL, caller_main, &callers[i]);
+    }
+    // Give the others time to find the verification in flight and wait on it
+    pause_ms(200);
+    atomic_store(&v->hold, false);
+    for (int i = 0; i < THREADS; i++) {
+        pthread_join(callers[i].thread, NULL);
+    }
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+static void test_hit_and_miss(void) {
+    report_cache_t *cache = NULL;
+    fake_verifier_t v = { 0 };
+    attestation_report_t report, other;
+    attestation_verification_result_t result;
+    report_cache_outcome_t how;
+    uint8_t fingerprint[REPORT_CACHE_FINGERPRINT_BYTES];
+
+    CHECK_EQ_INT(report_cache_create(&cache, NULL), PQC_SUCCESS);
+    make_report(&report, (uint64_t)time(NULL), 1);
+
+    CHECK_EQ_INT(report_cache_verify(cache, &report, g_fingerprint, fake_verify, &v,
+                                     &result, &how), PQC_SUCCESS);
+    CHECK_EQ_INT(how, REPORT_CACHE_MISS);
+    CHECK(result.is_valid);
+    CHECK_EQ_INT(report_cache_verify(cache, &report, g_fingerprint, fake_verify, &v,
+                                     &result, &how), PQC_SUCCESS);
+    CHECK_EQ_INT(how, REPORT_CACHE_HIT);
+    CHECK(result.is_valid);
+    CHECK_EQ_INT(atomic_load(&v.calls), 1);
+
+    // One signature byte, or another key, is another report
+    other = report;
+    other.signature[63] ^= 0x01;
+    CHECK_EQ_INT(report_cache_verify(cache, &other, g_fingerprint, fake_verify, &v,
+                                     &result, &how), PQC_SUCCESS);
+    CHECK_EQ_INT(how, REPORT_CACHE_MISS);
+    memcpy(fingerprint, g_fingerprint, sizeof(fingerprint));
+    fingerprint[0] ^= 0x01;
+    CHECK_EQ_INT(report_cache_verify(cache, &report, fingerprint, fake_verify, &v,
+                                     &result, &how), PQC_SUCCESS);
+    CHECK_EQ_INT(how, REPORT_CACHE_MISS);
+    CHECK_EQ_INT(atomic_load(&v.calls), 3);
+
+    // A failed verification leaves nothing behind
+    fake_verifier_t failing = { .first_result = PQC_ERROR_INSUFFICIENT_MEMORY };
+    make_report(&other, (uint64_t)time(NULL), 2);
+    CHECK_EQ_INT(report_cache_verify(cache, &other, g_fingerprint, fake_verify, &failing,
+                                     &result, &how), PQC_ERROR_INSUFFICIENT_MEMORY);
+    CHECK_EQ_INT(report_cache_verify(cache, &other, g_fingerprint, fake_verify, &failing,
+                                     &result, &how), PQC_SUCCESS);
+    CHECK_EQ_INT(how, REPORT_CACHE_MISS);
+    CHECK_EQ_INT(atomic_load(&failing.calls), 2);
+
+    report_cache_stats_t stats;
+    report_cache_get_stats(cache, &stats);
+    CHECK_EQ_INT(stats.hits, 1);
+    CHECK_EQ_INT(stats.misses, 5);
+    CHECK_EQ_INT(report_cache_verify(NULL, &report, g_fingerprint, fake_verify, &v,
+                                     &result, &how), PQC_ERROR_INVALID_PARAMETER);
+    report_cache_destroy(cache);
+}
+
+static void test_coalescing(void) {
+    report_cache_t *cache = NULL;
+    fake_verifier_t v = { 0 };
+    attestation_report_t report;
+    caller_t callers[THREADS];
+
+    CHECK_EQ_INT(report_cache_create(&cache, NULL), PQC_SUCCESS);
+    make_report(&report, (uint64_t)time(NULL), 3);
+    run_concurrent(cache, &report, &v, callers);
+
+    // One verification; everyone else got its verdict
+    CHECK_EQ_INT(atomic_load(&v.calls), 1);
+    CHECK_EQ_INT(callers[0].how, REPORT_CACHE_MISS);
+    for (int i = 0; i < THREADS; i++) {
+        CHECK_EQ_INT(callers[i].status, PQC_SUCCESS);
+        CHECK(callers[i].result.is_valid);
+        CHECK_EQ_INT(callers[i].result.timestamp, report.timestamp);
+    }
+
+    report_cache_stats_t stats;
+    report_cache_get_stats(cache, &stats);
+    CHECK_EQ_INT(stats.misses, 1);
+    CHECK_EQ_INT(stats.coalesced + stats.hits, THREADS - 1);
+    CHECK(stats.coalesced > 0);
+    report_cache_destroy(cache);
+}
+
+static void test_failure_releases_waiters(void) {
+    report_cache_t *cache = NULL;
+    fake_verifier_t v = { .first_result = PQC_ERROR_INSUFFICIENT_MEMORY };
+    attestation_report_t report;
+    caller_t callers[THREADS];
+
+    CHECK_EQ_INT(report_cache_create(&cache, NULL), PQC_SUCCESS);
+    make_report(&report, (uint64_t)time(NULL), 4);
+    run_concurrent(cache, &report, &v, callers);
+
+    // The failed call reports its error; one waiter verifies in its place
+    // and the rest share that verdict instead of hanging or failing
+    CHECK_EQ_INT(callers[0].status, PQC_ERROR_INSUFFICIENT_MEMORY);
+    CHECK_EQ_INT(atomic_load(&v.calls), 2);
+    for (int i = 1; i < THREADS; i++) {
+        CHECK_EQ_INT(callers[i].status, PQC_SUCCESS);
+        CHECK(callers[i].result.is_valid);
+    }
+
+    report_cache_stats_t stats;
+    report_cache_get_stats(cache, &stats);
+    CHECK_EQ_INT(stats.misses, 2);
+    CHECK_EQ_INT(stats.coalesced + stats.hits, THREADS - 2);
+    report_cache_destroy(cache);
+}
+
+static void test_freshness_deadline(void) {
+    report_cache_config_t config = { 0, 3600 };
+    report_cache_t *cache = NULL;
+    attestation_verification_result_t result;
+    report_cache_outcome_t how;
+    attestation_report_t report;
+    uint64_t now = (uint64_t)time(NULL);
+
+    CHECK_EQ_INT(report_cache_create(&cache, &config), PQC_SUCCESS);
+
+    // Well inside the skew: reused for the TTL
+    fake_verifier_t fresh = { 0 };
+    make_report(&report, now, 5);
+    report_cache_verify(cache, &report, g_fingerprint, fake_verify, &fresh, &result, &how);
+    report_cache_verify(cache, &report, g_fingerprint, fake_verify, &fresh, &result, &how);
+    CHECK_EQ_INT(how, REPORT_CACHE_HIT);
+    CHECK_EQ_INT(atomic_load(&fresh.calls), 1);
+
+    // At its deadline the verdict is not reused, whatever the TTL, so the
+    // copy goes back through the timestamp check
+    fake_verifier_t stale = { 0 };
+    make_report(&report, now - ATTESTATION_MAX_CLOCK_SKEW, 6);
+    report_cache_verify(cache, &report, g_fingerprint, fake_verify, &stale, &result, &how);
+    report_cache_verify(cache, &report, g_fingerprint, fake_verify, &stale, &result, &how);
+    CHECK_EQ_INT(how, REPORT_CACHE_MISS);
+    CHECK_EQ_INT(atomic_load(&stale.calls), 2);
+
+    // One second from its deadline: reused only until then
+    fake_verifier_t closing = { 0 };
+    make_report(&report, (uint64_t)time(NULL) - ATTESTATION_MAX_CLOCK_SKEW + 1, 7);
+    report_cache_verify(cache, &report, g_fingerprint, fake_verify, &closing, &result, &how);
+    pause_ms(1100);
+    report_cache_verify(cache, &report, g_fingerprint, fake_verify, &closing, &result, &how);
+    CHECK_EQ_INT(how, REPORT_CACHE_MISS);
+    CHECK_EQ_INT(atomic_load(&closing.calls), 2);
+
+    // Timestamps near the top of the range must not wrap the deadline
+    fake_verifier_t future = { 0 };
+    make_report(&report, UINT64_MAX - 1, 8);
+    report_cache_verify(cache, &report, g_fingerprint, fake_verify, &future, &result, &how);
+    report_cache_verify(cache, &report, g_fingerprint, fake_verify, &future, &result, &how);
+    CHECK_EQ_INT(how, REPORT_CACHE_HIT);
+    report_cache_destroy(cache);
+}
+
+static void test_ttl(void) {
+    report_cache_config_t config = { 0, 1 };
+    report_cache_t *cache = NULL;
+    fake_verifier_t v = { 0 };
+    attestation_verification_result_t result;
+    report_cache_outcome_t how;
+    attestation_report_t report;
+
+    CHECK_EQ_INT(report_cache_create(&cache, &config), PQC_SUCCESS);
+    make_report(&report, (uint64_t)time(NULL), 9);
+    report_cache_verify(cache, &report, g_fingerprint, fake_verify, &v, &result, &how);
+    pause_ms(1100);
+    report_cache_verify(cache, &report, g_fingerprint, fake_verify, &v, &result, &how);
+    CHECK_EQ_INT(how, REPORT_CACHE_MISS);
+    CHECK_EQ_INT(atomic_load(&v.calls), 2);
+    report_cache_destroy(cache);
+}
+
+int main(void) {
+    CHECK_EQ_INT(pqc_init(NULL), PQC_SUCCESS);
+    RUN_TEST(test_hit_and_miss);
+    RUN_TEST(test_coalescing);
+    RUN_TEST(test_failure_releases_waiters);
+    RUN_TEST(test_freshness_deadline);
+    RUN_TEST(test_ttl);
+    pqc_cleanup();
+    return test_finish();
+}
@@ -0,0 +1,152 @@
+/**
+ * @file test_sha2.c
+ * @brief SHA-256/512 against FIPS 180-4 examples, and every SHA-256 backend
+ *        against the portable one
+ */
+
+#include "test_common.h"
+#include "sha2.h"
+#include <stdlib.h>
+
+typedef struct {
+    const char *message;
+    const char *sha256;
+    const char *sha512;
+} sha2_vector_t;
+
+// FIPS 180-4 / NIST CSRC example messages
+static const sha2_vector_t g_vectors[] = {
+    { "",
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+      "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce"
+      "47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e" },
+    { "abc",
+      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+      "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+      "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f" },
+    { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+      "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+      NULL },
+    { "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+      "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+      NULL,
+      "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018"
+      "501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909" },
+};
+
+#define VECTOR_COUNT (sizeof(g_vectors) / sizeof(g_vectors[0]))
+
+static const sha256_backend_t g_backends[] = {
+    SHA256_BACKEND_GENERIC, SHA256_BACKEND_SHANI, SHA256_BACKEND_AVX2
+};
+
+static void check_vectors(void) {
+    uint8_t expect[SHA512_DIGEST_BYTES], out[SHA512_DIGEST_BYTES];
+
+    for (size_t i = 0; i < VECTOR_COUNT; i++) {
+        const sha2_vector_t *v = &g_vectors[i];
+        const uint8_t *msg = (const uint8_t *)v->message;
+        size_t len = strlen(v->message);
+
+        if (v->sha256) {
+            test_unhex(expect, SHA256_DIGEST_BYTES, v->sha256);
+            CHECK_EQ_INT(sha256(out, msg, len), PQC_SUCCESS);
+            CHECK_MEM(out, expect, SHA256_DIGEST_BYTES);
+
+            // Byte-at-a-time updates exercise the partial-block path
+            sha256_ctx_t ctx;
+            sha256_init(&ctx);
+            for (size_t k = 0; k < len; k++) {
+                sha256_update(&ctx, msg + k, 1);
+            }
+            sha256_final(&ctx, out);
+            CHECK_MEM(out, expect, SHA256_DIGEST_BYTES);
+        }
+        if (v->sha512) {
+            test_unhex(expect, SHA512_DIGEST_BYTES, v->sha512);
+            CHECK_EQ_INT(sha512(out, msg, len), PQC_SUCCESS);
+            CHECK_MEM(out, expect, SHA512_DIGEST_BYTES);
+        }
+    }
+}
+
+static void test_fips_vectors(void) {
+    // Whatever the dispatcher picked for this CPU
+    check_vectors();
+}
+
+static void test_million_a(void) {
+    uint8_t expect[SHA256_DIGEST_BYTES], out[SHA256_DIGEST_BYTES];
+    uint8_t chunk[1000];
+    memset(chunk, 'a', sizeof(chunk));
+    test_unhex(expect, sizeof(expect),
+               "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+
+    sha256_ctx_t ctx;
+    sha256_init(&ctx);
+    for (int i = 0; i < 1000; i++) {
+        sha256_update(&ctx, chunk, sizeof(chunk));
+    }
+    sha256_final(&ctx, out);
+    CHECK_MEM(out, expect, sizeof(expect));
+}
+
+static void test_single_backends(void) {
+    // Unsupported backends fall back to the generic code, so this is safe on any CPU
+    for (size_t b = 0; b < sizeof(g_backends) / sizeof(g_backends[0]); b++) {
+        sha256_set_backends(g_backends[b], SHA256_BACKEND_GENERIC);
+        check_vectors();
+    }
+}
+
+static void test_x8_lanes_match_scalar(void) {
+    enum { BLOCKS = 5 };
+    uint8_t *data = malloc(SHA256_LANES * BLOCKS * SHA256_BLOCK_BYTES);
+    CHECK(data != NULL);
+    if (!data) {
+        return;
+    }
+    for (size_t i = 0; i < SHA256_LANES * BLOCKS * SHA256_BLOCK_BYTES; i++) {
+        data[i] = (uint8_t)(i * 131 + (i >> 7));
+    }
+
+    // Reference: each lane through the portable single-message compressor
+    uint32_t expect[SHA256_LANES][8];
+    sha256_set_backends(SHA256_BACKEND_GENERIC, SHA256_BACKEND_GENERIC);
+    for (size_t lane = 0; lane < SHA256_LANES; lane++) {
+        for (size_t w = 0; w < 8; w++) {
+            expect[lane][w] = (uint32_t)(0x6a09e667u * (lane + 1) + w);
+        }
+        sha256_compress(expect[lane], data + lane * BLOCKS * SHA256_BLOCK_BYTES, BLOCKS);
+    }
+
+    for (size_t b = 0; b < sizeof(g_backends) / sizeof(g_backends[0]); b++) {
+        uint32_t states[SHA256_LANES][8];
+        sha256_set_backends(SHA256_BACKEND_GENERIC, g_backends[b]);
+        for (size_t lane = 0; lane < SHA256_LANES; lane++) {
+            for (size_t w = 0; w < 8; w++) {
+                states[lane][w] = (uint32_t)(0x6a09e667u * (lane + 1) + w);
+            }
+        }
+        for (size_t blk = 0; blk < BLOCKS; blk++) {
+            const uint8_t *blocks[SHA256_LANES];
+            for (size_t lane = 0; lane < SHA256_LANES; lane++) {
+                blocks[lane] = data + (lane * BLOCKS + blk) * SHA256_BLOCK_BYTES;
+            }
+            sha256_compress_x8(states, blocks);
+        }
+        CHECK_MEM(states, expect, sizeof(expect));
+        printf("  x8 backend %d (%s)\n", (int)sha256_backend_x8(),
+               sha256_backend_x8() == g_backends[b] ? "available" : "fell back");
+    }
+
+    free(data);
+}
+
+int main(void) {
+    RUN_TEST(test_fips_vectors);
+    RUN_TEST(test_million_a);
+    RUN_TEST(test_single_backends);
+    RUN_TEST(test_x8_lanes_match_scalar);
+    return test_finish();
+}
@@ -0,0 +1,113 @@
+/**
+ * @file test_sphincs.c
+ * @brief SPHINCS+-SHA256-128f/256f sign/verify round trip and rejection of
+ *        altered input, single- and multi-threaded
+ */
+
+#include "test_common.h"
+#include "sphincs.h"
+#include "pqc_common.h"
+#include "pqc_executor.h"
+#include <stdlib.h>
+#include <time.h>
+
+typedef struct {
+    pqc_algorithm_t algorithm;
+    size_t pk_bytes;
+    size_t sk_bytes;
+    size_t sig_bytes;
+} sphincs_case_t;
+
+static const sphincs_case_t g_cases[] = {
+    { PQC_ALG_SPHINCS_SHA256_128F, SPHINCS_SHA256_128F_PUBLICKEYBYTES,
+      SPHINCS_SHA256_128F_SECRETKEYBYTES, SPHINCS_SHA256_128F_SIGNATUREBYTES },
+    { PQC_ALG_SPHINCS_SHA256_256F, SPHINCS_SHA256_256F_PUBLICKEYBYTES,
+      SPHINCS_SHA256_256F_SECRETKEYBYTES, SPHINCS_SHA256_256F_SIGNATUREBYTES },
+};
+
+#define CASE_COUNT (sizeof(g_cases) / sizeof(g_cases[0]))
+
+static const uint8_t g_msg[] = "firmware measurement 0001";
+
+static void run_case(const sphincs_case_t *c, unsigned threads) {
+    uint8_t pk[SPHINCS_SHA256_256F_PUBLICKEYBYTES], sk[SPHINCS_SHA256_256F_SECRETKEYBYTES];
+    uint8_t *sig = malloc(c->sig_bytes);
+    uint8_t *bad = malloc(c->sig_bytes);
+    size_t siglen = 0;
+    CHECK(sig != NULL && bad != NULL);
+    if (!sig || !bad) {
+        free(sig);
+        free(bad);
+        return;
+    }
+
+    CHECK_EQ_INT(sphincs_set_threads(threads), PQC_SUCCESS);
+    CHECK_EQ_INT(sphincs_keypair(c->algorithm, pk, sk), PQC_SUCCESS);
+    CHECK_EQ_INT(sphincs_sign(sig, &siglen, g_msg, sizeof(g_msg), sk, c->sk_bytes), PQC_SUCCESS);
+    CHECK_EQ_INT(siglen, c->sig_bytes);
+    CHECK_EQ_INT(sphincs_verify(sig, siglen, g_msg, sizeof(g_msg), pk, c->pk_bytes), PQC_SUCCESS);
+
+    // Randomizer R, FORS section, last hypertree authentication node
+    const size_t offsets[] = { 0, c->sig_bytes / 8, c->sig_bytes - 1 };
+    for (size_t k = 0; k < sizeof(offsets) / sizeof(offsets[0]); k++) {
+        memcpy(bad, sig, siglen);
+        bad[offsets[k]] ^= 0x01;
+        CHECK(sphincs_verify(bad, siglen, g_msg, sizeof(g_msg), pk, c->pk_bytes) != PQC_SUCCESS);
+    }
+
+    uint8_t msg[sizeof(g_msg)];
+    memcpy(msg, g_msg, sizeof(msg));
+    msg[0] ^= 0x01;
+    CHECK(sphincs_verify(sig, siglen, msg, sizeof(msg), pk, c->pk_bytes) != PQC_SUCCESS);
+    CHECK(sphincs_verify(sig, siglen - 1, g_msg, sizeof(g_msg), pk, c->pk_bytes) != PQC_SUCCESS);
+
+    pk[c->pk_bytes - 1] ^= 0x01;
+    CHECK(sphincs_verify(sig, siglen, g_msg, sizeof(g_msg), pk, c->pk_bytes) != PQC_SUCCESS);
+
+    free(sig);
+    free(bad);
+}
+
+static void test_single_threaded(void) {
+    for (size_t i = 0; i < CASE_COUNT; i++) {
+        run_case(&g_cases[i], 1);
+    }
+}
+
+static uint64_t latency_tasks_run(void) {
+    pqc_executor_stats_t stats;
+    pqc_executor_get_stats(pqc_executor_shared(), &stats);
+    return stats.executed[PQC_TASK_PRIORITY_LATENCY];
+}
+
+static void test_multi_threaded(void) {
+    uint64_t before = latency_tasks_run();
+
+    // More threads than this machine may have CPUs; the work split must not care
+    for (size_t i = 0; i < CASE_COUNT; i++) {
+        run_case(&g_cases[i], 4);
+    }
+
+    // The helpers ran on the shared pool as latency work; one that was
+    // queued behind the caller's last chunk may still be finishing
+    const struct timespec pause = { 0, 1000000 };
+    for (int i = 0; i < 5000 && latency_tasks_run() == before; i++) {
+        nanosleep(&pause, NULL);
+    }
+    CHECK(latency_tasks_run() > before);
+}
+
+static void test_parameters(void) {
+    uint8_t pk[SPHINCS_SHA256_256F_PUBLICKEYBYTES], sk[SPHINCS_SHA256_256F_SECRETKEYBYTES];
+    CHECK_EQ_INT(sphincs_set_threads(SPHINCS_MAX_THREADS + 1), PQC_ERROR_INVALID_PARAMETER);
+    CHECK(sphincs_keypair(PQC_ALG_FALCON_512, pk, sk) != PQC_SUCCESS);
+}
+
+int main(void) {
+    CHECK_EQ_INT(pqc_init(NULL), PQC_SUCCESS);
+    RUN_TEST(test_single_threaded);
+    RUN_TEST(test_multi_threaded);
+    RUN_TEST(test_parameters);
+    pqc_cleanup();
+    return test_finish();
+}
@@ -0,0 +1,337 @@
+/**
+ * @file test_trace.c
+ * @brief USDT probes fire in matched pairs with the documented arguments
+ *
+ * Linked against the pqc_probe_recorder variant of libpqc, whose
+ * <sys/sdt.h> turns every probe site into a call to pqc_test_probe(), so
+ * the probes are checked whether or not the host has SystemTap headers.
+ */
+
+#include "test_common.h"
+#include "attestation_engine.h"
+#include "dilithium.h"
+#include "kyber.h"
+#include "pqc_common.h"
+#include "sys/sdt.h"
+
+#define TEST_MAX_EVENTS     4096
+#define TEST_MAX_DEPTH      16
+
+typedef struct {
+    const char *name;
+    const char *tag;                    /**< First argument: op, phase, variant or command */
+    uintptr_t b;
+    uintptr_t c;
+} probe_event_t;
+
+static const struct {
+    const char *name;
+    int argc;
+} g_probes[] = {
+    { "op_entry", 2 }, { "op_return", 3 },
+    { "keccak_entry", 3 }, { "keccak_return", 2 },
+    { "attest_phase_entry", 1 }, { "attest_phase_return", 2 },
+    { "tpm_cmd_entry", 2 }, { "tpm_cmd_return", 2 },
+};
+
+static probe_event_t g_events[TEST_MAX_EVENTS];
+static size_t g_event_count;
+static const char *g_ops[TEST_MAX_DEPTH];
+static int g_op_depth;
+static const char *g_phases[TEST_MAX_DEPTH];
+static int g_phase_depth;
+static const char *g_keccak;
+static const char *g_tpm;
+
+// ============================================================================
+// Recorder
+// ============================================================================
+
+static void probe_error(const char *what, const char *name, const char *tag) {
+    fprintf(stderr, "probe %s(%s): %s\n", name, tag ? tag : "NULL", what);
+    g_test_failures++;
+}
+
+static void push(const char **stack, int *depth, const char *name, const char *tag) {
+    if (*depth == TEST_MAX_DEPTH) {
+        probe_error("nested too deep", name, tag);
+        return;
+    }
+    stack[(*depth)++] = tag;
+}
+
+static void pop(const char **stack, int *depth, const char *name, const char *tag) {
+    if (*depth == 0 || strcmp(stack[*depth - 1], tag) != 0) {
+        probe_error("does not close the innermost entry", name, tag);
+        return;
+    }
+    (*depth)--;
+}
+
+static void open_single(const char **open, const char *name, const char *tag) {
+    if (*open) {
+        probe_error("entered while another call is open", name, tag);
+    }
+    *open = tag;
+}
+
+static void close_single(const char **open, const char *name, const char *tag) {
+    if (!*open || strcmp(*open, tag) != 0) {
+        probe_error("does not match the open entry", name, tag);
+    }
+    *open = NULL;
+}
+
+void pqc_test_probe(const char *provider, const char *name, int argc,
+                    uintptr_t a, uintptr_t b, uintptr_t c) {
+    const char *tag = (const char *)a;
+    size_t p = 0;
+    while (p < sizeof(g_probes) / sizeof(g_probes[0]) && strcmp(g_probes[p].name, name) != 0) {
+        p++;
+    }
+    if (strcmp(provider, "pqc") != 0 || p == sizeof(g_probes) / sizeof(g_probes[0]) ||
+        g_probes[p].argc != argc || !tag) {
+        probe_error("unknown probe or wrong arguments", name, tag);
+        return;
+    }
+
+    if (g_event_count < TEST_MAX_EVENTS) {
+        g_events[g_event_count++] = (probe_event_t){ name, tag, b, c };
+    }
+
+    if (strcmp(name, "op_entry") == 0) {
+        push(g_ops, &g_op_depth, name, tag);
+    } else if (strcmp(name, "op_return") == 0) {
+        pop(g_ops, &g_op_depth, name, tag);
+    } else if (strcmp(name, "attest_phase_entry") == 0) {
+        push(g_phases, &g_phase_depth, name, tag);
+    } else if (strcmp(name, "attest_phase_return") == 0) {
+        pop(g_phases, &g_phase_depth, name, tag);
+    } else if (strcmp(name, "keccak_entry") == 0) {
+        open_single(&g_keccak, name, tag);
+    } else if (strcmp(name, "keccak_return") == 0) {
+        close_single(&g_keccak, name, tag);
+    } else if (strcmp(name, "tpm_cmd_entry") == 0) {
+        open_single(&g_tpm, name, tag);
+    } else {
+        close_single(&g_tpm, name, tag);
+    }
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void reset_events(void) {
+    g_event_count = 0;
+}
+
+/**
+ * @brief Every entry seen so far has been closed
+ */
+static void check_balanced(const char *after) {
+    if (g_op_depth || g_phase_depth || g_keccak || g_tpm) {
+        fprintf(stderr, "after %s: %d op(s), %d phase(s) open, keccak %s, tpm %s\n", after,
+                g_op_depth, g_phase_depth, g_keccak ? g_keccak : "closed",
+                g_tpm ? g_tpm : "closed");
+        g_test_failures++;
+    }
+    g_op_depth = g_phase_depth = 0;
+    g_keccak = g_tpm = NULL;
+}
+
+static const probe_event_t *find_event(const char *name, const char *tag) {
+    for (size_t i = 0; i < g_event_count; i++) {
+        if (strcmp(g_events[i].name, name) == 0 && strcmp(g_events[i].tag, tag) == 0) {
+            return &g_events[i];
+        }
+    }
+    return NULL;
+}
+
+static size_t count_events(const char *name) {
+    size_t n = 0;
+    for (size_t i = 0; i < g_event_count; i++) {
+        n += strcmp(g_events[i].name, name) == 0;
+    }
+    return n;
+}
+
+/**
+ * @brief The op was entered with @p in_bytes and returned @p result
+ */
+static void check_op(const char *op, size_t in_bytes, int result, size_t out_bytes) {
+    const probe_event_t *entry = find_event("op_entry", op);
+    const probe_event_t *ret = find_event("op_return", op);
+    CHECK(entry && ret);
+    if (entry && ret) {
+        CHECK_EQ_INT(entry->b, in_bytes);
+        CHECK_EQ_INT((int)ret->b, result);
+        CHECK_EQ_INT(ret->c, out_bytes);
+    }
+}
+
+/**
+ * @brief The phases were entered in this order, and the last one returned
+ *        @p last_result
+ */
+static void check_phases(const char *const *phases, size_t count, int last_result) {
+    size_t seen = 0;
+    const probe_event_t *last = NULL;
+    for (size_t i = 0; i < g_event_count; i++) {
+        if (strcmp(g_events[i].name, "attest_phase_entry") == 0) {
+            CHECK(seen < count && strcmp(g_events[i].tag, phases[seen]) == 0);
+            seen++;
+        } else if (strcmp(g_events[i].name, "attest_phase_return") == 0) {
+            last = &g_events[i];
+        }
+    }
+    CHECK_EQ_INT(seen, count);
+    CHECK(last != NULL);
+    if (last) {
+        CHECK(strcmp(last->tag, phases[count - 1]) == 0);
+        CHECK_EQ_INT((int)last->b, last_result);
+    }
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+static void test_kyber_probes(void) {
+    static kyber_public_key_t pk;
+    static kyber_secret_key_t sk;
+    kyber_ciphertext_t ct;
+    uint8_t ss[KYBER_SSBYTES];
+
+    reset_events();
+    CHECK_EQ_INT(kyber_keypair(&pk, &sk), PQC_SUCCESS);
+    check_balanced("kyber_keypair");
+    check_op("kyber_keypair", 0, PQC_SUCCESS, KYBER_PUBLICKEYBYTES);
+
+    reset_events();
+    CHECK_EQ_INT(kyber_encapsulate(&ct, ss, &pk), PQC_SUCCESS);
+    check_balanced("kyber_encapsulate");
+    check_op("kyber_encapsulate", KYBER_PUBLICKEYBYTES, PQC_SUCCESS, KYBER_CIPHERTEXTBYTES);
+    const probe_event_t *g = find_event("keccak_entry", "sha3_512");
+    CHECK(g != NULL);
+    if (g) {
+        CHECK_EQ_INT(g->b, 64);
+        CHECK_EQ_INT(g->c, 64);
+    }
+
+    reset_events();
+    CHECK_EQ_INT(kyber_decapsulate(ss, &ct, &sk), PQC_SUCCESS);
+    check_balanced("kyber_decapsulate");
+    check_op("kyber_decapsulate", KYBER_CIPHERTEXTBYTES, PQC_SUCCESS, KYBER_SSBYTES);
+    CHECK_EQ_INT(count_events("keccak_entry"), count_events("keccak_return"));
+}
+
+static void test_dilithium_probes(void) {
+    static dilithium_public_key_t pk;
+    static dilithium_secret_key_t sk;
+    static uint8_t sig[DILITHIUM_SIGNATUREBYTES];
+    static const uint8_t msg[] = "probe test";
+    size_t siglen = 0;
+
+    CHECK_EQ_INT(dilithium_keypair(&pk, &sk), PQC_SUCCESS);
+    check_balanced("dilithium_keypair");
+
+    reset_events();
+    CHECK_EQ_INT(dilithium_sign(sig, &siglen, msg, sizeof(msg), &sk), PQC_SUCCESS);
+    check_balanced("dilithium_sign");
+    check_op("dilithium_sign", sizeof(msg), PQC_SUCCESS, siglen);
+
+    reset_events();
+    CHECK_EQ_INT(dilithium_verify(sig, siglen, msg, sizeof(msg), &pk), PQC_SUCCESS);
+    check_balanced("dilithium_verify");
+    check_op("dilithium_verify", sizeof(msg), PQC_SUCCESS, 0);
+
+    // A failed verification still closes the op, with its result
+    sig[0] ^= 0x01;
+    reset_events();
+    pqc_result_t rc = dilithium_verify(sig, siglen, msg, sizeof(msg), &pk);
+    CHECK(rc != PQC_SUCCESS);
+    check_balanced("dilithium_verify (bad signature)");
+    check_op("dilithium_verify", sizeof(msg), rc, 0);
+}
+
+static void test_attestation_probes(void) {
+    static attestation_report_t report, bad;
+    static device_certificate_t cert;
+    attestation_verification_result_t result;
+    attestation_config_t config;
+
+    memset(&config, 0, sizeof(config));
+    config.device_type = DEVICE_TYPE_SMART_METER;
+    snprintf(config.device_serial, sizeof(config.device_serial), "TEST-0001");
+    config.enable_measurement_log = true;
+    config.max_log_entries = 16;
+
+    reset_events();
+    CHECK_EQ_INT(attestation_init(&config), PQC_SUCCESS);
+    check_balanced("attestation_init");
+    CHECK(find_event("tpm_cmd_return", "init") != NULL);
+
+    reset_events();
+    CHECK_EQ_INT(attestation_collect_measurements(), PQC_SUCCESS);
+    check_balanced("attestation_collect_measurements");
+    CHECK(count_events("tpm_cmd_entry") > 0);
+    CHECK(find_event("tpm_cmd_entry", "extend_pcr") != NULL);
+    CHECK_EQ_INT(attestation_get_device_certificate(&cert), PQC_SUCCESS);
+    check_balanced("attestation_get_device_certificate");
+
+    static const char *const generate_phases[] = { "assemble", "hash", "sign" };
+    reset_events();
+    CHECK_EQ_INT(attestation_generate_report(&report), PQC_SUCCESS);
+    check_balanced("attestation_generate_report");
+    check_op("attestation_generate_report", 0, PQC_SUCCESS, sizeof(attestation_report_t));
+    check_phases(generate_phases, 3, PQC_SUCCESS);
+    CHECK(find_event("op_entry", "dilithium_sign") != NULL);
+
+    static const char *const verify_phases[] = {
+        "format", "timestamp", "policy", "hash", "signature"
+    };
+    reset_events();
+    CHECK_EQ_INT(attestation_verify_report(&report, &cert.public_key, &result), PQC_SUCCESS);
+    CHECK(result.is_valid);
+    check_balanced("attestation_verify_report");
+    check_op("attestation_verify_report", sizeof(attestation_report_t), PQC_SUCCESS,
+             sizeof(attestation_verification_result_t));
+    check_phases(verify_phases, 5, ATTESTATION_ERROR_NONE);
+
+    // Rejections close the phase with the attestation error and the op
+    // with PQC_SUCCESS, at the stage that rejected the report
+    bad = report;
+    bad.report_version++;
+    reset_events();
+    CHECK_EQ_INT(attestation_verify_report(&bad, &cert.public_key, &result), PQC_SUCCESS);
+    check_balanced("attestation_verify_report (bad version)");
+    check_op("attestation_verify_report", sizeof(attestation_report_t), PQC_SUCCESS, 0);
+    check_phases(verify_phases, 1, ATTESTATION_ERROR_INVALID_FORMAT);
+
+    bad = report;
+    bad.signature[0] ^= 0x01;
+    reset_events();
+    CHECK_EQ_INT(attestation_verify_report(&bad, &cert.public_key, &result), PQC_SUCCESS);
+    check_balanced("attestation_verify_report (bad signature)");
+    check_op("attestation_verify_report", sizeof(attestation_report_t), PQC_SUCCESS, 0);
+    check_phases(verify_phases, 5, ATTESTATION_ERROR_SIGNATURE_INVALID);
+
+    reset_events();
+    CHECK_EQ_INT(attestation_check_report(&report, &result), PQC_SUCCESS);
+    check_balanced("attestation_check_report");
+    check_op("attestation_check_report", sizeof(attestation_report_t), PQC_SUCCESS, 0);
+
+    attestation_cleanup();
+    check_balanced("attestation_cleanup");
+}
+
+int main(void) {
+    CHECK_EQ_INT(pqc_init(NULL), PQC_SUCCESS);
+    RUN_TEST(test_kyber_probes);
+    RUN_TEST(test_dilithium_probes);
+    RUN_TEST(test_attestation_probes);
+    pqc_cleanup();
+    return test_finish();
+}
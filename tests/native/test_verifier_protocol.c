@@ -0,0 +1,472 @@
+/**
+ * @file test_verifier_protocol.c
+ * @brief verifierd wire format: compact report decoding, header checks and
+ *        the reassembly of frames from arbitrarily cut receives
+ */
+
+#include "test_common.h"
+#include "verifier_protocol.h"
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define STREAM_FRAMES 6
+
+/** attestation_report_t up to the end of the signature, without tail padding */
+#define REPORT_BYTES (offsetof(attestation_report_t, signature) + DILITHIUM_SIGNATUREBYTES)
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/**
+ * @brief A report with count measurements and a siglen-byte signature, all
+ *        fields recognisable
+ */
+static void make_report(attestation_report_t *report, uint32_t count, uint32_t siglen,
+                        uint8_t seed) {
+    memset(report, 0, sizeof(*report));
+    memset(report->device_id, 0x40 + seed, DEVICE_ID_LENGTH);
+    report->timestamp = 1700000000u + seed;
+    report->report_version = 1;
+    report->measurement_count = count;
+    for (int i = 0; i < MAX_PCR_REGISTERS; i++) {
+        memset(report->pcr_values[i], i + seed, 32);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        report->measurements[i].pcr_index = (uint8_t)i;
+        memset(report->measurements[i].measurement_value, (int)(i * 3 + seed), 32);
+        report->measurements[i].measurement_size = i + 1;
+    }
+    report->signature_length = siglen;
+    for (uint32_t i = 0; i < siglen; i++) {
+        report->signature[i] = (uint8_t)(i * 7 + seed);
+    }
+}
+
+/**
+ * @brief One frame of a test stream: header and payload, contiguous
+ */
+typedef struct {
+    uint8_t bytes[VERIFIER_MAX_FRAME_BYTES];
+    size_t length;
+} test_frame_t;
+
+static void make_frame(test_frame_t *frame, verifier_frame_type_t type, uint64_t request_id,
+                       uint8_t seed) {
+    verifier_frame_header_t header;
+    uint8_t *payload = frame->bytes + sizeof(header);
+    uint32_t length;
+    if (type == VERIFIER_FRAME_REPORT) {
+        attestation_report_t *report = malloc(sizeof(*report));
+        make_report(report, seed % (MAX_MEASUREMENTS_PER_REPORT + 1),
+                    seed * 97u % (DILITHIUM_SIGNATUREBYTES + 1), seed);
+        length = (uint32_t)verifier_encode_report(payload, VERIFIER_MAX_REPORT_BYTES, report);
+        free(report);
+    } else {
+        length = sizeof(verifier_enroll_t);
+        memset(payload, seed, length);
+    }
+    verifier_frame_header_init(&header, type, length, request_id);
+    memcpy(frame->bytes, &header, sizeof(header));
+    frame->length = sizeof(header) + length;
+}
+
+/**
+ * @brief verifier_frame_fn that records what it is handed
+ */
+typedef struct {
+    const test_frame_t *expected;       /**< Frame n carries request_id n */
+    int count;
+    int mismatches;
+    int stop_at;                        /**< Stop once when this frame arrives, or -1 */
+    int reject_at;                      /**< Call this frame malformed, or -1 */
+} collector_t;
+
+static int collect(void *user, const verifier_frame_header_t *header, const uint8_t *payload) {
+    collector_t *c = user;
+    if ((int)header->request_id == c->stop_at) {
+        c->stop_at = -1;
+        return 1;
+    }
+    if ((int)header->request_id == c->reject_at) {
+        return -1;
+    }
+    const test_frame_t *want = &c->expected[c->count];
+    c->mismatches += header->request_id != (uint64_t)c->count ||
+                     sizeof(*header) + header->length != want->length ||
+                     memcmp(header, want->bytes, sizeof(*header)) != 0 ||
+                     memcmp(payload, want->bytes + sizeof(*header), header->length) != 0;
+    c->count++;
+    return 0;
+}
+
+static void collector_init(collector_t *c, const test_frame_t *expected) {
+    memset(c, 0, sizeof(*c));
+    c->expected = expected;
+    c->stop_at = -1;
+    c->reject_at = -1;
+}
+
+/**
+ * @brief Reports of several sizes and an enrollment, back to back
+ */
+static size_t make_stream(test_frame_t *frames, uint8_t *stream) {
+    static const verifier_frame_type_t types[STREAM_FRAMES] = {
+        VERIFIER_FRAME_REPORT, VERIFIER_FRAME_ENROLL, VERIFIER_FRAME_REPORT,
+        VERIFIER_FRAME_REPORT, VERIFIER_FRAME_ENROLL, VERIFIER_FRAME_REPORT
+    };
+    size_t length = 0;
+    for (int i = 0; i < STREAM_FRAMES; i++) {
+        make_frame(&frames[i], types[i], (uint64_t)i, (uint8_t)(i * 11 + 1));
+        memcpy(stream + length, frames[i].bytes, frames[i].length);
+        length += frames[i].length;
+    }
+    return length;
+}
+
+// ============================================================================
+// Reports
+// ============================================================================
+
+static void test_report_round_trip(void) {
+    static const uint32_t counts[] = { 0, 1, 7, MAX_MEASUREMENTS_PER_REPORT };
+    static const uint32_t siglens[] = { 0, 1, 2420, DILITHIUM_SIGNATUREBYTES };
+    attestation_report_t *report = malloc(sizeof(*report));
+    attestation_report_t *decoded = malloc(sizeof(*decoded));
+    uint8_t *payload = malloc(VERIFIER_MAX_REPORT_BYTES);
+
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        for (size_t j = 0; j < sizeof(siglens) / sizeof(siglens[0]); j++) {
+            make_report(report, counts[i], siglens[j], (uint8_t)(i * 4 + j));
+            size_t length = verifier_encode_report(payload, VERIFIER_MAX_REPORT_BYTES, report);
+            CHECK_EQ_INT(length, verifier_report_size(report));
+            CHECK_EQ_INT(length, VERIFIER_REPORT_FIXED_BYTES +
+                                 counts[i] * sizeof(platform_measurement_t) +
+                                 sizeof(uint32_t) + siglens[j]);
+            // Stale contents must not survive anywhere but the tail padding
+            memset(decoded, 0xEE, sizeof(*decoded));
+            CHECK_EQ_INT(verifier_decode_report(decoded, payload, length), PQC_SUCCESS);
+            CHECK_MEM(decoded, report, REPORT_BYTES);
+
+            // One byte short of the end
+            CHECK_EQ_INT(verifier_encode_report(payload, length - 1, report), 0);
+        }
+    }
+
+    make_report(report, MAX_MEASUREMENTS_PER_REPORT + 1, 0, 0);
+    CHECK_EQ_INT(verifier_report_size(report), 0);
+    make_report(report, 0, DILITHIUM_SIGNATUREBYTES + 1, 0);
+    CHECK_EQ_INT(verifier_report_size(report), 0);
+    CHECK_EQ_INT(verifier_encode_report(payload, VERIFIER_MAX_REPORT_BYTES, report), 0);
+
+    free(payload);
+    free(decoded);
+    free(report);
+}
+
+/**
+ * @brief Every truncation and every oversized count is refused
+ */
+static void test_decode_rejects(void) {
+    attestation_report_t *report = malloc(sizeof(*report));
+    attestation_report_t *decoded = malloc(sizeof(*decoded));
+    uint8_t *payload = malloc(VERIFIER_MAX_REPORT_BYTES + 1);
+    const size_t count_at = offsetof(attestation_report_t, measurement_count);
+
+    make_report(report, 3, 100, 5);
+    size_t length = verifier_encode_report(payload, VERIFIER_MAX_REPORT_BYTES, report);
+    size_t siglen_at = length - 100 - sizeof(uint32_t);
+
+    int accepted = 0;
+    for (size_t cut = 0; cut < length; cut++) {
+        accepted += verifier_decode_report(decoded, payload, cut) == PQC_SUCCESS;
+    }
+    CHECK_EQ_INT(accepted, 0);
+    payload[length] = 0;
+    CHECK_EQ_INT(verifier_decode_report(decoded, payload, length + 1),
+                 PQC_ERROR_INVALID_PARAMETER);
+
+    // Signature longer than the payload, and longer than any signature
+    uint32_t siglen = 101;
+    memcpy(payload + siglen_at, &siglen, sizeof(siglen));
+    CHECK_EQ_INT(verifier_decode_report(decoded, payload, length), PQC_ERROR_INVALID_PARAMETER);
+    siglen = DILITHIUM_SIGNATUREBYTES + 1;
+    memcpy(payload + siglen_at, &siglen, sizeof(siglen));
+    CHECK_EQ_INT(verifier_decode_report(decoded, payload,
+                                        siglen_at + sizeof(uint32_t) + siglen),
+                 PQC_ERROR_INVALID_PARAMETER);
+    siglen = UINT32_MAX;
+    memcpy(payload + siglen_at, &siglen, sizeof(siglen));
+    CHECK_EQ_INT(verifier_decode_report(decoded, payload, length), PQC_ERROR_INVALID_PARAMETER);
+
+    // Measurement counts past the array, with the payload sized to match
+    make_report(report, MAX_MEASUREMENTS_PER_REPORT, 0, 5);
+    length = verifier_encode_report(payload, VERIFIER_MAX_REPORT_BYTES, report);
+    CHECK_EQ_INT(verifier_decode_report(decoded, payload, length), PQC_SUCCESS);
+    static const uint32_t counts[] = { MAX_MEASUREMENTS_PER_REPORT + 1, 0x01000000u, UINT32_MAX };
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        memcpy(payload + count_at, &counts[i], sizeof(uint32_t));
+        CHECK_EQ_INT(verifier_decode_report(decoded, payload, length),
+                     PQC_ERROR_INVALID_PARAMETER);
+    }
+    // A count that disagrees with the payload length
+    uint32_t fewer = MAX_MEASUREMENTS_PER_REPORT - 1;
+    memcpy(payload + count_at, &fewer, sizeof(uint32_t));
+    CHECK_EQ_INT(verifier_decode_report(decoded, payload, length), PQC_ERROR_INVALID_PARAMETER);
+
+    CHECK_EQ_INT(verifier_decode_report(NULL, payload, length), PQC_ERROR_INVALID_PARAMETER);
+    CHECK_EQ_INT(verifier_decode_report(decoded, NULL, length), PQC_ERROR_INVALID_PARAMETER);
+
+    free(payload);
+    free(decoded);
+    free(report);
+}
+
+// ============================================================================
+// Headers
+// ============================================================================
+
+static void test_header_check(void) {
+    verifier_frame_header_t header;
+    const uint32_t report_min = VERIFIER_REPORT_FIXED_BYTES + sizeof(uint32_t);
+
+    verifier_frame_header_init(&header, VERIFIER_FRAME_REPORT, report_min, 1);
+    CHECK_EQ_INT(verifier_frame_header_check(&header), PQC_SUCCESS);
+    header.length = VERIFIER_MAX_REPORT_BYTES;
+    CHECK_EQ_INT(verifier_frame_header_check(&header), PQC_SUCCESS);
+    verifier_frame_header_init(&header, VERIFIER_FRAME_ENROLL, sizeof(verifier_enroll_t), 2);
+    CHECK_EQ_INT(verifier_frame_header_check(&header), PQC_SUCCESS);
+    verifier_frame_header_init(&header, VERIFIER_FRAME_RESULT, sizeof(verifier_result_t), 3);
+    CHECK_EQ_INT(verifier_frame_header_check(&header), PQC_SUCCESS);
+
+    enum {
+        MAGIC, VERSION, TYPE_ZERO, TYPE_UNKNOWN, TYPE_RESULT_LIKE, REPORT_SHORT, REPORT_LONG,
+        REPORT_HUGE, ENROLL_SHORT, ENROLL_LONG, RESULT_LONG, CASES
+    };
+    for (int c = 0; c < CASES; c++) {
+        verifier_frame_header_init(&header, VERIFIER_FRAME_REPORT, report_min, 1);
+        switch (c) {
+        case MAGIC:            header.magic ^= 1; break;
+        case VERSION:          header.version++; break;
+        case TYPE_ZERO:        header.type = 0; break;
+        case TYPE_UNKNOWN:     header.type = 3; break;
+        case TYPE_RESULT_LIKE: header.type = VERIFIER_FRAME_RESULT + 1; break;
+        case REPORT_SHORT:     header.length = report_min - 1; break;
+        case REPORT_LONG:      header.length = VERIFIER_MAX_REPORT_BYTES + 1; break;
+        case REPORT_HUGE:      header.length = UINT32_MAX; break;
+        case ENROLL_SHORT:
+            verifier_frame_header_init(&header, VERIFIER_FRAME_ENROLL,
+                                       sizeof(verifier_enroll_t) - 1, 1);
+            break;
+        case ENROLL_LONG:
+            verifier_frame_header_init(&header, VERIFIER_FRAME_ENROLL,
+                                       sizeof(verifier_enroll_t) + 1, 1);
+            break;
+        case RESULT_LONG:
+            verifier_frame_header_init(&header, VERIFIER_FRAME_RESULT,
+                                       sizeof(verifier_result_t) + 1, 1);
+            break;
+        }
+        CHECK_EQ_INT(verifier_frame_header_check(&header), PQC_ERROR_INVALID_PARAMETER);
+    }
+}
+
+// ============================================================================
+// Reassembly
+// ============================================================================
+
+/**
+ * @brief The whole stream in one receive, cut once at every offset, and a
+ *        byte at a time: the same frames in the same order each time
+ */
+static void test_split_any_cut(void) {
+    test_frame_t *frames = malloc(STREAM_FRAMES * sizeof(test_frame_t));
+    uint8_t *stream = malloc(STREAM_FRAMES * VERIFIER_MAX_FRAME_BYTES);
+    size_t length = make_stream(frames, stream);
+    uint8_t *buffer = malloc(VERIFIER_MAX_FRAME_BYTES);
+    verifier_reassembly_t r = { buffer, 0 };
+    collector_t c;
+    size_t consumed;
+
+    collector_init(&c, frames);
+    CHECK_EQ_INT(verifier_frame_split(&r, stream, length, &consumed, collect, &c), 0);
+    CHECK_EQ_INT(consumed, length);
+    CHECK_EQ_INT(c.count, STREAM_FRAMES);
+    CHECK_EQ_INT(c.mismatches, 0);
+    CHECK_EQ_INT(r.length, 0);
+
+    int bad_cuts = 0;
+    for (size_t cut = 0; cut <= length; cut++) {
+        collector_init(&c, frames);
+        int first = verifier_frame_split(&r, stream, cut, &consumed, collect, &c);
+        int second = verifier_frame_split(&r, stream + cut, length - cut, NULL, collect, &c);
+        bad_cuts += first != 0 || second != 0 || consumed != cut ||
+                    c.count != STREAM_FRAMES || c.mismatches != 0 || r.length != 0;
+    }
+    CHECK_EQ_INT(bad_cuts, 0);
+
+    collector_init(&c, frames);
+    int failures = 0;
+    for (size_t i = 0; i < length; i++) {
+        failures += verifier_frame_split(&r, stream + i, 1, &consumed, collect, &c) != 0 ||
+                    consumed != 1;
+    }
+    CHECK_EQ_INT(failures, 0);
+    CHECK_EQ_INT(c.count, STREAM_FRAMES);
+    CHECK_EQ_INT(c.mismatches, 0);
+
+    free(buffer);
+    free(stream);
+    free(frames);
+}
+
+/**
+ * @brief A stream that ends mid-frame delivers only the whole frames and
+ *        holds the rest, however little of the next header has arrived
+ */
+static void test_split_truncated(void) {
+    test_frame_t *frames = malloc(STREAM_FRAMES * sizeof(test_frame_t));
+    uint8_t *stream = malloc(STREAM_FRAMES * VERIFIER_MAX_FRAME_BYTES);
+    make_stream(frames, stream);
+    uint8_t *buffer = malloc(VERIFIER_MAX_FRAME_BYTES);
+    size_t whole = frames[0].length + frames[1].length;
+    const size_t tails[] = { 1, sizeof(verifier_frame_header_t) - 1,
+                             sizeof(verifier_frame_header_t),
+                             sizeof(verifier_frame_header_t) + 1, frames[2].length - 1 };
+
+    for (size_t i = 0; i < sizeof(tails) / sizeof(tails[0]); i++) {
+        verifier_reassembly_t r = { buffer, 0 };
+        collector_t c;
+        size_t consumed;
+        collector_init(&c, frames);
+        CHECK_EQ_INT(verifier_frame_split(&r, stream, whole + tails[i], &consumed, collect, &c), 0);
+        CHECK_EQ_INT(consumed, whole + tails[i]);
+        CHECK_EQ_INT(c.count, 2);
+        CHECK_EQ_INT(c.mismatches, 0);
+        CHECK_EQ_INT(r.length, tails[i]);
+        CHECK_MEM(r.buffer, frames[2].bytes, tails[i]);
+
+        // Nothing new arrives: still nothing to hand over
+        CHECK_EQ_INT(verifier_frame_split(&r, NULL, 0, &consumed, collect, &c), 0);
+        CHECK_EQ_INT(consumed, 0);
+        CHECK_EQ_INT(c.count, 2);
+    }
+
+    free(buffer);
+    free(stream);
+    free(frames);
+}
+
+/**
+ * @brief A bad header ends the stream as soon as it is complete, after the
+ *        frames before it and without waiting for its payload
+ */
+static void test_split_rejects(void) {
+    test_frame_t *frames = malloc(STREAM_FRAMES * sizeof(test_frame_t));
+    uint8_t *stream = malloc(STREAM_FRAMES * VERIFIER_MAX_FRAME_BYTES);
+    size_t length = make_stream(frames, stream);
+    uint8_t *buffer = malloc(VERIFIER_MAX_FRAME_BYTES);
+    size_t at = frames[0].length + frames[1].length;
+    verifier_frame_header_t *third = (verifier_frame_header_t *)(stream + at);
+    const verifier_frame_header_t good = *third;
+
+    enum { MAGIC, TYPE, OVERSIZED, ENROLL_LENGTH, CASES };
+    for (int k = 0; k < CASES; k++) {
+        *third = good;
+        switch (k) {
+        case MAGIC:        third->magic = 0; break;
+        case TYPE:         third->type = VERIFIER_FRAME_RESULT; break;
+        case OVERSIZED:    third->length = VERIFIER_MAX_REPORT_BYTES + 1; break;
+        case ENROLL_LENGTH: third->type = VERIFIER_FRAME_ENROLL; break;
+        }
+        for (int split = 0; split < 2; split++) {
+            verifier_reassembly_t r = { buffer, 0 };
+            collector_t c;
+            collector_init(&c, frames);
+            // Either all at once, or the bad header alone in the second receive
+            size_t first = split ? at + sizeof(good) / 2 : length;
+            int rc = verifier_frame_split(&r, stream, first, NULL, collect, &c);
+            if (split) {
+                CHECK_EQ_INT(rc, 0);
+                rc = verifier_frame_split(&r, stream + first, sizeof(good) - sizeof(good) / 2,
+                                          NULL, collect, &c);
+            }
+            CHECK_EQ_INT(rc, -1);
+            CHECK_EQ_INT(c.count, 2);
+            CHECK_EQ_INT(c.mismatches, 0);
+        }
+    }
+
+    // The handler calling a frame malformed ends the stream the same way
+    *third = good;
+    verifier_reassembly_t r = { buffer, 0 };
+    collector_t c;
+    collector_init(&c, frames);
+    c.reject_at = 4;
+    CHECK_EQ_INT(verifier_frame_split(&r, stream, length, NULL, collect, &c), -1);
+    CHECK_EQ_INT(c.count, 4);
+
+    free(buffer);
+    free(stream);
+    free(frames);
+}
+
+/**
+ * @brief A handler that stops is offered the same frame again, whether it
+ *        was in the receive or in the reassembly buffer, and no frame is
+ *        delivered twice
+ */
+static void test_split_stop_and_resume(void) {
+    test_frame_t *frames = malloc(STREAM_FRAMES * sizeof(test_frame_t));
+    uint8_t *stream = malloc(STREAM_FRAMES * VERIFIER_MAX_FRAME_BYTES);
+    size_t length = make_stream(frames, stream);
+    uint8_t *buffer = malloc(VERIFIER_MAX_FRAME_BYTES);
+    size_t before = frames[0].length + frames[1].length + frames[2].length;
+
+    // In place: consumed stops at the start of the frame
+    verifier_reassembly_t r = { buffer, 0 };
+    collector_t c;
+    size_t consumed;
+    collector_init(&c, frames);
+    c.stop_at = 3;
+    CHECK_EQ_INT(verifier_frame_split(&r, stream, length, &consumed, collect, &c), 1);
+    CHECK_EQ_INT(consumed, before);
+    CHECK_EQ_INT(c.count, 3);
+    CHECK_EQ_INT(verifier_frame_split(&r, stream + consumed, length - consumed, &consumed,
+                                      collect, &c), 0);
+    CHECK_EQ_INT(c.count, STREAM_FRAMES);
+    CHECK_EQ_INT(c.mismatches, 0);
+
+    // Completed in the reassembly buffer: retried with nothing new
+    size_t cut = before + frames[3].length / 2;
+    collector_init(&c, frames);
+    c.stop_at = 3;
+    CHECK_EQ_INT(verifier_frame_split(&r, stream, cut, &consumed, collect, &c), 0);
+    CHECK_EQ_INT(c.count, 3);
+    CHECK_EQ_INT(verifier_frame_split(&r, stream + cut, frames[3].length - frames[3].length / 2,
+                                      &consumed, collect, &c), 1);
+    CHECK_EQ_INT(consumed, frames[3].length - frames[3].length / 2);
+    CHECK_EQ_INT(r.length, frames[3].length);
+    CHECK_EQ_INT(verifier_frame_split(&r, NULL, 0, &consumed, collect, &c), 0);
+    CHECK_EQ_INT(c.count, 4);
+    CHECK_EQ_INT(r.length, 0);
+    CHECK_EQ_INT(verifier_frame_split(&r, stream + before + frames[3].length,
+                                      length - before - frames[3].length, NULL, collect, &c), 0);
+    CHECK_EQ_INT(c.count, STREAM_FRAMES);
+    CHECK_EQ_INT(c.mismatches, 0);
+
+    free(buffer);
+    free(stream);
+    free(frames);
+}
+
+int main(void) {
+    RUN_TEST(test_report_round_trip);
+    RUN_TEST(test_decode_rejects);
+    RUN_TEST(test_header_check);
+    RUN_TEST(test_split_any_cut);
+    RUN_TEST(test_split_truncated);
+    RUN_TEST(test_split_rejects);
+    RUN_TEST(test_split_stop_and_resume);
+    return test_finish();
+}
@@ -0,0 +1,391 @@
+/**
+ * @file test_verifierd.c
+ * @brief The verifier daemon end to end: a client flooding a shard with a
+ *        two-slot queue gets every report answered once, with the daemon
+ *        holding the connection back rather than spinning, and clients
+ *        enroll devices only when the daemon allows it
+ *
+ * Takes the path of the verifierd binary as its only argument and runs it
+ * on a Unix socket in a temporary directory.
+ */
+
+#include "test_common.h"
+#include "verifier_protocol.h"
+#include "attestation_engine.h"
+#include "dilithium.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#define KEY_RECORDS     64      /**< g_device and others, in the key file */
+#define FLOOD_REPORTS   200
+#define WRITE_CHUNK     1000    /**< Bytes per write, so frames straddle receives */
+
+static const char *g_verifierd;
+static char g_dir[] = "/tmp/test_verifierd.XXXXXX";
+static char g_socket[sizeof(g_dir) + 16];
+static char g_keys[sizeof(g_dir) + 16];
+static char g_log[sizeof(g_dir) + 16];
+
+static dilithium_public_key_t g_pk;
+static dilithium_secret_key_t g_sk;
+static const uint8_t g_device[DEVICE_ID_LENGTH] = { 0xd0, 0x0d };
+
+// ============================================================================
+// Daemon
+// ============================================================================
+
+/**
+ * @brief Run verifierd on the test socket with the key file and extra,
+ *        NULL-terminated options
+ * @return Its pid once it accepts connections, or -1
+ */
+static pid_t daemon_start(const char *const *extra) {
+    const char *argv[32] = { g_verifierd, "--unix", g_socket, "--keys", g_keys,
+                             "--shards", "1", "--no-pin" };
+    int argc = 8;
+    while (extra && *extra && argc < 31) {
+        argv[argc++] = *extra++;
+    }
+    argv[argc] = NULL;
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        int log = open(g_log, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (log >= 0) {
+            dup2(log, STDERR_FILENO);
+        }
+        execv(g_verifierd, (char *const *)argv);
+        _exit(127);
+    }
+    CHECK(pid > 0);
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, g_socket);
+    for (int i = 0; pid > 0 && i < 1000; i++) {
+        int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0) {
+            close(fd);
+            return pid;
+        }
+        close(fd);
+        if (waitpid(pid, NULL, WNOHANG) == pid) {
+            break;
+        }
+        poll(NULL, 0, 10);
+    }
+    fprintf(stderr, "verifierd did not start, see %s\n", g_log);
+    CHECK(false);
+    return -1;
+}
+
+/**
+ * @brief Stop the daemon and check it exited cleanly
+ */
+static void daemon_stop(pid_t pid) {
+    int status = 0;
+    CHECK_EQ_INT(kill(pid, SIGTERM), 0);
+    CHECK_EQ_INT(waitpid(pid, &status, 0), pid);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+/**
+ * @brief A counter from the statistics a stopped daemon printed
+ * @return The number after label in its output, or -1
+ */
+static long long daemon_counter(const char *label) {
+    char text[8192];
+    FILE *f = fopen(g_log, "r");
+    size_t n = f ? fread(text, 1, sizeof(text) - 1, f) : 0;
+    if (f) {
+        fclose(f);
+    }
+    text[n] = '\0';
+    const char *at = strstr(text, label);
+    return at ? strtoll(at + strlen(label), NULL, 10) : -1;
+}
+
+static int client_connect(void) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, g_socket);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    CHECK_EQ_INT(connect(fd, (struct sockaddr *)&addr, sizeof(addr)), 0);
+    return fd;
+}
+
+// ============================================================================
+// Client
+// ============================================================================
+
+typedef struct {
+    int fd;
+    const uint8_t *data;
+    size_t length;
+    bool ok;
+} writer_t;
+
+static void *writer_run(void *arg) {
+    writer_t *w = arg;
+    w->ok = true;
+    for (size_t off = 0; off < w->length && w->ok;) {
+        size_t chunk = w->length - off < WRITE_CHUNK ? w->length - off : WRITE_CHUNK;
+        ssize_t n = send(w->fd, w->data + off, chunk, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        w->ok = n > 0;
+        off += n > 0 ? (size_t)n : 0;
+    }
+    return NULL;
+}
+
+/**
+ * @brief RESULT frames read back, by request_id
+ */
+typedef struct {
+    int answered[FLOOD_REPORTS];
+    verifier_result_t results[FLOOD_REPORTS];
+    int total;
+    int unexpected;
+} results_t;
+
+static int on_result(void *user, const verifier_frame_header_t *header, const uint8_t *payload) {
+    results_t *r = user;
+    if (header->type != VERIFIER_FRAME_RESULT || header->request_id >= FLOOD_REPORTS) {
+        r->unexpected++;
+        return -1;
+    }
+    r->answered[header->request_id]++;
+    memcpy(&r->results[header->request_id], payload, sizeof(verifier_result_t));
+    r->total++;
+    return 0;
+}
+
+/**
+ * @brief Read results until expected have arrived, the daemon hangs up or
+ *        nothing comes for 30 seconds
+ */
+static void read_results(int fd, results_t *r, int expected) {
+    uint8_t buffer[4096];
+    uint8_t *frame = malloc(VERIFIER_MAX_FRAME_BYTES);
+    verifier_reassembly_t rx = { frame, 0 };
+    while (r->total < expected) {
+        struct pollfd pfd = { .fd = fd, .events = POLLIN };
+        if (poll(&pfd, 1, 30000) != 1) {
+            break;
+        }
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0 || verifier_frame_split(&rx, buffer, (size_t)n, NULL, on_result, r) != 0) {
+            break;
+        }
+    }
+    free(frame);
+}
+
+static size_t append_frame(uint8_t *out, verifier_frame_type_t type, uint64_t request_id,
+                           const void *payload, size_t length) {
+    verifier_frame_header_t header;
+    verifier_frame_header_init(&header, type, (uint32_t)length, request_id);
+    memcpy(out, &header, sizeof(header));
+    memcpy(out + sizeof(header), payload, length);
+    return sizeof(header) + length;
+}
+
+/**
+ * @brief Append a REPORT frame for device, signed with sk
+ */
+static size_t append_report(uint8_t *out, uint64_t request_id, const uint8_t *device,
+                            const dilithium_secret_key_t *sk) {
+    attestation_report_t *report = calloc(1, sizeof(*report));
+    memcpy(report->device_id, device, sizeof(report->device_id));
+    report->timestamp = (uint64_t)time(NULL);
+    report->report_version = ATTESTATION_REPORT_VERSION;
+    CHECK_EQ_INT(attestation_sign_report(report, sk), PQC_SUCCESS);
+    verifier_frame_header_t header;
+    size_t length = verifier_encode_report(out + sizeof(header), VERIFIER_MAX_REPORT_BYTES,
+                                           report);
+    CHECK(length > 0);
+    verifier_frame_header_init(&header, VERIFIER_FRAME_REPORT, (uint32_t)length, request_id);
+    memcpy(out, &header, sizeof(header));
+    free(report);
+    return sizeof(header) + length;
+}
+
+static size_t append_enroll(uint8_t *out, uint64_t request_id, const uint8_t *device,
+                            const dilithium_public_key_t *pk) {
+    verifier_enroll_t enroll;
+    memcpy(enroll.device_id, device, sizeof(enroll.device_id));
+    memcpy(&enroll.public_key, pk, sizeof(enroll.public_key));
+    return append_frame(out, VERIFIER_FRAME_ENROLL, request_id, &enroll, sizeof(enroll));
+}
+
+/**
+ * @brief Send a stream on a new connection while reading expected results
+ * @return Results, each request_id answered exactly once when they check out
+ */
+static results_t *exchange(const uint8_t *stream, size_t length, int expected) {
+    results_t *results = calloc(1, sizeof(*results));
+    writer_t writer = { client_connect(), stream, length, false };
+    pthread_t thread;
+    CHECK_EQ_INT(pthread_create(&thread, NULL, writer_run, &writer), 0);
+    read_results(writer.fd, results, expected);
+    pthread_join(thread, NULL);
+    close(writer.fd);
+
+    CHECK(writer.ok);
+    CHECK_EQ_INT(results->total, expected);
+    CHECK_EQ_INT(results->unexpected, 0);
+    int repeated = 0;
+    for (int i = 0; i < expected; i++) {
+        repeated += results->answered[i] != 1;
+    }
+    CHECK_EQ_INT(repeated, 0);
+    return results;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+/**
+ * @brief Far more keys and reports than the shard can queue, the reports
+ *        written in chunks that cut frames apart: every key is loaded, each
+ *        report is verified and answered exactly once, and the shard's full
+ *        queue held the daemon back rather than dropping anything
+ */
+static void test_flood_small_queue(void) {
+    static const char *const options[] = { "--queue-depth", "2", "--result-cache", "0", NULL };
+    pid_t pid = daemon_start(options);
+    if (pid < 0) {
+        return;
+    }
+
+    // One signed report sent over and over
+    uint8_t *stream = malloc(FLOOD_REPORTS * VERIFIER_MAX_FRAME_BYTES);
+    size_t frame = append_report(stream, 0, g_device, &g_sk);
+    size_t length = frame;
+    for (uint64_t i = 1; i < FLOOD_REPORTS; i++) {
+        memcpy(stream + length, stream, frame);
+        memcpy(stream + length + offsetof(verifier_frame_header_t, request_id), &i, sizeof(i));
+        length += frame;
+    }
+
+    results_t *results = exchange(stream, length, FLOOD_REPORTS);
+    int wrong = 0;
+    for (int i = 0; i < FLOOD_REPORTS; i++) {
+        wrong += results->results[i].status != PQC_SUCCESS ||
+                 results->results[i].error_code != ATTESTATION_ERROR_NONE;
+    }
+    CHECK_EQ_INT(wrong, 0);
+
+    daemon_stop(pid);
+    CHECK_EQ_INT(daemon_counter("Enrolled "), KEY_RECORDS);
+    CHECK(daemon_counter("shard queue full ") > 0);
+    free(results);
+    free(stream);
+}
+
+/**
+ * @brief Clients may only enroll with --allow-enroll: without it a new
+ *        device stays unknown and a known device keeps its key, and the
+ *        connection goes on being served
+ */
+static void test_enroll_needs_option(void) {
+    static const uint8_t newcomer[DEVICE_ID_LENGTH] = { 0xd0, 0x0e };
+    dilithium_public_key_t *pk = malloc(sizeof(*pk));
+    dilithium_secret_key_t *sk = malloc(sizeof(*sk));
+    CHECK_EQ_INT(dilithium_keypair(pk, sk), PQC_SUCCESS);
+
+    // Enroll a new device and re-key a known one, each followed by a
+    // report signed with the key just sent
+    uint8_t *stream = malloc(4 * VERIFIER_MAX_FRAME_BYTES);
+    size_t length = append_enroll(stream, 0, newcomer, pk);
+    length += append_report(stream + length, 1, newcomer, sk);
+    length += append_enroll(stream + length, 2, g_device, pk);
+    length += append_report(stream + length, 3, g_device, sk);
+
+    for (int allow = 0; allow < 2; allow++) {
+        static const char *const allowed[] = { "--allow-enroll", NULL };
+        pid_t pid = daemon_start(allow ? allowed : NULL);
+        if (pid < 0) {
+            continue;
+        }
+        results_t *results = exchange(stream, length, 4);
+        const verifier_result_t *r = results->results;
+        if (allow) {
+            CHECK_EQ_INT(r[0].status, PQC_SUCCESS);
+            CHECK_EQ_INT(r[1].error_code, ATTESTATION_ERROR_NONE);
+            CHECK_EQ_INT(r[2].status, PQC_SUCCESS);
+            CHECK_EQ_INT(r[3].error_code, ATTESTATION_ERROR_NONE);
+        } else {
+            CHECK_EQ_INT(r[0].status, PQC_ERROR_NOT_IMPLEMENTED);
+            CHECK_EQ_INT(r[1].error_code, ATTESTATION_ERROR_UNKNOWN_DEVICE);
+            CHECK_EQ_INT(r[2].status, PQC_ERROR_NOT_IMPLEMENTED);
+            CHECK(r[3].error_code != ATTESTATION_ERROR_NONE);
+        }
+        CHECK_EQ_INT(r[1].status, PQC_SUCCESS);
+        CHECK_EQ_INT(r[3].status, PQC_SUCCESS);
+
+        daemon_stop(pid);
+        CHECK_EQ_INT(daemon_counter("enrollments refused "), allow ? 0 : 2);
+        CHECK_EQ_INT(daemon_counter("Enrolled "), KEY_RECORDS + (allow ? 2 : 0));
+        CHECK_EQ_INT(daemon_counter("malformed "), 0);
+        free(results);
+    }
+    free(stream);
+    free(sk);
+    free(pk);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s path/to/verifierd\n", argv[0]);
+        return 2;
+    }
+    g_verifierd = argv[1];
+    if (!mkdtemp(g_dir)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    snprintf(g_socket, sizeof(g_socket), "%s/sock", g_dir);
+    snprintf(g_keys, sizeof(g_keys), "%s/keys", g_dir);
+    snprintf(g_log, sizeof(g_log), "%s/log", g_dir);
+
+    CHECK_EQ_INT(pqc_init(NULL), PQC_SUCCESS);
+    CHECK_EQ_INT(dilithium_keypair(&g_pk, &g_sk), PQC_SUCCESS);
+    verifier_enroll_t enroll;
+    memcpy(&enroll.public_key, &g_pk, sizeof(enroll.public_key));
+    FILE *keys = fopen(g_keys, "wb");
+    CHECK(keys != NULL);
+    for (int i = 0; keys && i < KEY_RECORDS; i++) {
+        memcpy(enroll.device_id, g_device, sizeof(enroll.device_id));
+        enroll.device_id[DEVICE_ID_LENGTH - 1] = (uint8_t)i;
+        CHECK_EQ_INT(fwrite(&enroll, sizeof(enroll), 1, keys), 1);
+    }
+    if (keys) {
+        fclose(keys);
+    }
+
+    RUN_TEST(test_flood_small_queue);
+    RUN_TEST(test_enroll_needs_option);
+
+    unlink(g_keys);
+    unlink(g_log);
+    unlink(g_socket);
+    CHECK_EQ_INT(rmdir(g_dir), 0);
+    pqc_cleanup();
+    return test_finish();
+}
@@ -0,0 +1,579 @@
+/**
+ * @file test_verify_engine.c
+ * @brief Verification engine behaviour seen through its request queue:
+ *        ordering under concurrent producers, device-to-shard affinity,
+ *        the order in which a report meets the rejection stages, the
+ *        throttling of devices that keep failing, and key prefetch
+ */
+
+#include "test_common.h"
+#include "verify_engine.h"
+#include "attestation_engine.h"
+#include "dilithium.h"
+#include <stdbool.h>
+#include <pthread.h>
+#include <sched.h>
+#include <poll.h>
+#include <time.h>
+
+// ============================================================================
+// Harness
+// ============================================================================
+
+/**
+ * @brief One shard unless the test asks for more, driven one request at
+ *        a time from the test thread
+ */
+typedef struct {
+    verify_engine_t *engine;
+    pthread_mutex_t lock;
+    pthread_cond_t done;
+    uint64_t next_id;
+    uint64_t completed_id;
+    verifier_result_t result;
+    verify_engine_stats_t stats;        /**< As of the last completion, read on the shard */
+} harness_t;
+
+static harness_t g_h = { .lock = PTHREAD_MUTEX_INITIALIZER, .done = PTHREAD_COND_INITIALIZER };
+
+static dilithium_public_key_t g_pk;
+static dilithium_secret_key_t g_sk;
+static const uint8_t g_device[DEVICE_ID_LENGTH] = { 0xd0, 0x01 };
+static const uint8_t g_other[DEVICE_ID_LENGTH] = { 0xd0, 0x02 };
+static const uint8_t g_stranger[DEVICE_ID_LENGTH] = { 0xd0, 0xff };
+
+static void harness_complete(void *user, int shard, const verify_request_t *request,
+                             const verifier_result_t *result) {
+    harness_t *h = user;
+    pthread_mutex_lock(&h->lock);
+    h->result = *result;
+    verify_engine_get_stats(h->engine, shard, &h->stats);
+    h->completed_id = request->request_id;
+    pthread_cond_broadcast(&h->done);
+    pthread_mutex_unlock(&h->lock);
+}
+
+static bool harness_start(verify_engine_config_t *config) {
+    if (!config->shards) {
+        config->shards = 1;
+    }
+    config->complete = harness_complete;
+    config->user = &g_h;
+    g_h.engine = NULL;
+    return verify_engine_create(&g_h.engine, config) == PQC_SUCCESS;
+}
+
+/**
+ * @brief Stop the engine and return its shard's counters
+ */
+static verify_engine_stats_t harness_stop(void) {
+    verify_engine_stats_t stats;
+    verify_engine_stop(g_h.engine);
+    verify_engine_get_stats(g_h.engine, 0, &stats);
+    verify_engine_destroy(g_h.engine);
+    g_h.engine = NULL;
+    return stats;
+}
+
+/**
+ * @brief Queue one request on a shard and wait for its result
+ */
+static verifier_result_t harness_submit_to(int shard, verify_request_type_t type,
+                                           const void *payload) {
+    verify_request_t *req;
+    while (!(req = verify_engine_reserve(g_h.engine, shard))) {
+        sched_yield();
+    }
+    uint64_t id = ++g_h.next_id;
+    req->type = type;
+    req->request_id = id;
+    if (type == VERIFY_REQUEST_ENROLL) {
+        memcpy(&req->u.enroll, payload, sizeof(req->u.enroll));
+    } else {
+        memcpy(&req->u.report, payload, sizeof(req->u.report));
+    }
+    verify_engine_commit(g_h.engine, shard, req);
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += 30;
+    pthread_mutex_lock(&g_h.lock);
+    while (g_h.completed_id != id &&
+           pthread_cond_timedwait(&g_h.done, &g_h.lock, &deadline) == 0) {
+    }
+    verifier_result_t result = g_h.result;
+    bool completed = g_h.completed_id == id;
+    pthread_mutex_unlock(&g_h.lock);
+    CHECK(completed);
+    if (!completed) {
+        result.status = PQC_ERROR_INTERNAL;
+    }
+    return result;
+}
+
+static verifier_result_t harness_submit(verify_request_type_t type, const void *payload) {
+    return harness_submit_to(0, type, payload);
+}
+
+static void enroll_device(const uint8_t *device) {
+    verifier_enroll_t enroll;
+    memcpy(enroll.device_id, device, sizeof(enroll.device_id));
+    memcpy(&enroll.public_key, &g_pk, sizeof(enroll.public_key));
+    CHECK_EQ_INT(harness_submit(VERIFY_REQUEST_ENROLL, &enroll).status, PQC_SUCCESS);
+}
+
+static void make_report(attestation_report_t *report, const uint8_t *device,
+                        uint64_t timestamp) {
+    memset(report, 0, sizeof(*report));
+    memcpy(report->device_id, device, sizeof(report->device_id));
+    report->timestamp = timestamp;
+    report->report_version = ATTESTATION_REPORT_VERSION;
+    CHECK_EQ_INT(attestation_sign_report(report, &g_sk), PQC_SUCCESS);
+}
+
+static uint32_t verdict(const attestation_report_t *report) {
+    verifier_result_t result = harness_submit(VERIFY_REQUEST_REPORT, report);
+    CHECK_EQ_INT(result.status, PQC_SUCCESS);
+    return result.error_code;
+}
+
+/**
+ * @brief Wake the shard with a report it rejects at once, and return its
+ *        counters as of that report
+ *
+ * Advancing the clock does not wake a sleeping shard; this does, and the
+ * shard starts any prefetch that has come due before it handles the report.
+ */
+static verify_engine_stats_t nudge(void) {
+    attestation_report_t report;
+    memset(&report, 0, sizeof(report));
+    memcpy(report.device_id, g_stranger, sizeof(report.device_id));
+    CHECK_EQ_INT(verdict(&report), ATTESTATION_ERROR_UNKNOWN_DEVICE);
+    pthread_mutex_lock(&g_h.lock);
+    verify_engine_stats_t stats = g_h.stats;
+    pthread_mutex_unlock(&g_h.lock);
+    return stats;
+}
+
+/**
+ * @brief Nudge the shard until n prefetched keys are installed
+ */
+static bool wait_prefetches(uint64_t n) {
+    for (int i = 0; i < 10000; i++) {
+        if (nudge().key_prefetches >= n) {
+            return true;
+        }
+        poll(NULL, 0, 1);
+    }
+    return false;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+#define MPSC_PRODUCERS  4
+#define MPSC_REQUESTS   2000            /**< Per producer */
+#define MPSC_CANCEL     7               /**< Every 7th reservation is cancelled */
+
+_Static_assert(MPSC_REQUESTS % MPSC_CANCEL != 0, "each producer's last request is committed");
+
+/**
+ * @brief What the shard saw of each producer's requests
+ *
+ * Written only on the one shard thread and read after the engine stops.
+ */
+typedef struct {
+    uint32_t last_seq[MPSC_PRODUCERS];
+    uint64_t received;
+    uint64_t out_of_order;
+    uint64_t cancelled_seen;
+} mpsc_log_t;
+
+static void mpsc_complete(void *user, int shard, const verify_request_t *request,
+                          const verifier_result_t *result) {
+    mpsc_log_t *log = user;
+    unsigned producer = (unsigned)(request->request_id >> 32);
+    uint32_t seq = (uint32_t)request->request_id;
+    (void)shard;
+    (void)result;
+
+    log->received++;
+    if (producer >= MPSC_PRODUCERS || seq <= log->last_seq[producer]) {
+        log->out_of_order++;
+        return;
+    }
+    log->cancelled_seen += seq % MPSC_CANCEL == 0;
+    log->last_seq[producer] = seq;
+}
+
+typedef struct {
+    verify_engine_t *engine;
+    unsigned producer;
+} mpsc_producer_t;
+
+static void *mpsc_produce(void *arg) {
+    const mpsc_producer_t *p = arg;
+    for (uint32_t seq = 1; seq <= MPSC_REQUESTS; seq++) {
+        verify_request_t *req;
+        while (!(req = verify_engine_reserve(p->engine, 0))) {
+            sched_yield();
+        }
+        req->request_id = ((uint64_t)p->producer << 32) | seq;
+        if (seq % MPSC_CANCEL == 0) {
+            req->type = VERIFY_REQUEST_NONE;
+        } else {
+            // Unknown device: rejected before any crypto work
+            req->type = VERIFY_REQUEST_REPORT;
+            memset(&req->u.report, 0, sizeof(req->u.report));
+            memcpy(req->u.report.device_id, g_stranger, sizeof(req->u.report.device_id));
+        }
+        verify_engine_commit(p->engine, 0, req);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Producers racing for a short queue: every committed request
+ *        arrives once, each producer's in the order it committed them, and
+ *        cancelled slots are skipped
+ */
+static void test_multi_producer(void) {
+    mpsc_log_t log;
+    verify_engine_config_t config = {
+        .shards = 1, .queue_depth = 8, .complete = mpsc_complete, .user = &log,
+    };
+    verify_engine_t *engine = NULL;
+    pthread_t threads[MPSC_PRODUCERS];
+    mpsc_producer_t producers[MPSC_PRODUCERS];
+
+    memset(&log, 0, sizeof(log));
+    CHECK_EQ_INT(verify_engine_create(&engine, &config), PQC_SUCCESS);
+    if (!engine) {
+        return;
+    }
+    for (unsigned i = 0; i < MPSC_PRODUCERS; i++) {
+        producers[i] = (mpsc_producer_t){ engine, i };
+        CHECK_EQ_INT(pthread_create(&threads[i], NULL, mpsc_produce, &producers[i]), 0);
+    }
+    for (unsigned i = 0; i < MPSC_PRODUCERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    // Everything is committed; wait for the shard to drain the queue
+    const uint64_t expected = MPSC_PRODUCERS * (MPSC_REQUESTS - MPSC_REQUESTS / MPSC_CANCEL);
+    verify_engine_stats_t stats;
+    for (int i = 0; i < 30000; i++) {
+        verify_engine_get_stats(engine, 0, &stats);
+        if (stats.verified >= expected) {
+            break;
+        }
+        poll(NULL, 0, 1);
+    }
+    verify_engine_stop(engine);
+    verify_engine_get_stats(engine, 0, &stats);
+    verify_engine_destroy(engine);
+
+    CHECK_EQ_INT(log.received, expected);
+    CHECK_EQ_INT(log.out_of_order, 0);
+    CHECK_EQ_INT(log.cancelled_seen, 0);
+    for (unsigned i = 0; i < MPSC_PRODUCERS; i++) {
+        CHECK_EQ_INT(log.last_seq[i], MPSC_REQUESTS);
+    }
+    CHECK_EQ_INT(stats.verified, expected);
+    CHECK_EQ_INT(stats.unknown, expected);
+}
+
+/**
+ * @brief A device maps to the same shard on every call and in every
+ *        engine of the same size, and its state lives in that shard only
+ */
+static void test_shard_affinity(void) {
+    enum { SHARDS = 4, DEVICES = 64 };
+    verify_engine_config_t config = { .shards = SHARDS };
+    verify_engine_config_t other_config = { .shards = SHARDS, .complete = harness_complete };
+    verify_engine_t *other = NULL;
+    int per_shard[SHARDS] = { 0 };
+
+    CHECK(harness_start(&config));
+    CHECK_EQ_INT(verify_engine_create(&other, &other_config), PQC_SUCCESS);
+    if (!g_h.engine || !other) {
+        verify_engine_destroy(other);
+        return;
+    }
+    CHECK_EQ_INT(verify_engine_shard_count(g_h.engine), SHARDS);
+
+    int mismatches = 0;
+    for (int i = 0; i < DEVICES; i++) {
+        uint8_t device[DEVICE_ID_LENGTH] = { 0xd1, (uint8_t)i, (uint8_t)(i * 7) };
+        int shard = verify_engine_shard_of(g_h.engine, device);
+        CHECK(shard >= 0 && shard < SHARDS);
+        if (shard < 0 || shard >= SHARDS) {
+            continue;
+        }
+        per_shard[shard]++;
+        mismatches += verify_engine_shard_of(g_h.engine, device) != shard;
+        mismatches += verify_engine_shard_of(other, device) != shard;
+    }
+    verify_engine_destroy(other);
+    CHECK_EQ_INT(mismatches, 0);
+    for (int s = 0; s < SHARDS; s++) {
+        CHECK(per_shard[s] > 0);
+    }
+
+    // Enrolled through its own shard, the device is known there and
+    // nowhere else
+    int home = verify_engine_shard_of(g_h.engine, g_device);
+    int away = (home + 1) % SHARDS;
+    verifier_enroll_t enroll;
+    memcpy(enroll.device_id, g_device, sizeof(enroll.device_id));
+    memcpy(&enroll.public_key, &g_pk, sizeof(enroll.public_key));
+    CHECK_EQ_INT(harness_submit_to(home, VERIFY_REQUEST_ENROLL, &enroll).status, PQC_SUCCESS);
+
+    attestation_report_t report;
+    make_report(&report, g_device, (uint64_t)time(NULL));
+    CHECK_EQ_INT(harness_submit_to(home, VERIFY_REQUEST_REPORT, &report).error_code,
+                 ATTESTATION_ERROR_NONE);
+    CHECK_EQ_INT(harness_submit_to(away, VERIFY_REQUEST_REPORT, &report).error_code,
+                 ATTESTATION_ERROR_UNKNOWN_DEVICE);
+
+    verify_engine_stop(g_h.engine);
+    for (int s = 0; s < SHARDS; s++) {
+        verify_engine_stats_t stats;
+        verify_engine_get_stats(g_h.engine, s, &stats);
+        CHECK_EQ_INT(stats.devices, s == home);
+        CHECK_EQ_INT(stats.valid, s == home);
+        CHECK_EQ_INT(stats.unknown, s == away);
+    }
+    harness_stop();
+}
+
+static void test_stage_order(void) {
+    verify_engine_config_t config = { .replay_window = 16 };
+    attestation_report_t report, bad;
+    uint64_t now = (uint64_t)time(NULL);
+
+    CHECK(harness_start(&config));
+    if (!g_h.engine) {
+        return;
+    }
+    enroll_device(g_device);
+
+    make_report(&report, g_device, now);
+    CHECK_EQ_INT(verdict(&report), ATTESTATION_ERROR_NONE);
+    CHECK_EQ_INT(verdict(&report), ATTESTATION_ERROR_REPLAYED);
+
+    // Malformed, and also a replay: the structure stage comes first
+    bad = report;
+    bad.report_version = ATTESTATION_REPORT_VERSION + 1;
+    CHECK_EQ_INT(verdict(&bad), ATTESTATION_ERROR_INVALID_FORMAT);
+    bad = report;
+    bad.signature_length = 0;
+    CHECK_EQ_INT(verdict(&bad), ATTESTATION_ERROR_INVALID_FORMAT);
+
+    // Far behind the window and the clock: stale, not replayed
+    make_report(&bad, g_device, now - ATTESTATION_MAX_CLOCK_SKEW - 60);
+    CHECK_EQ_INT(verdict(&bad), ATTESTATION_ERROR_TIMESTAMP_INVALID);
+
+    // Inside the window but badly signed: still the signature stage, and
+    // it does not move the window
+    make_report(&bad, g_device, now + 1);
+    bad.signature[0] ^= 0x01;
+    CHECK_EQ_INT(verdict(&bad), ATTESTATION_ERROR_SIGNATURE_INVALID);
+    make_report(&bad, g_device, now + 1);
+    CHECK_EQ_INT(verdict(&bad), ATTESTATION_ERROR_NONE);
+
+    verify_engine_stats_t stats = harness_stop();
+    CHECK_EQ_INT(stats.verified, 7);
+    CHECK_EQ_INT(stats.valid, 2);
+    CHECK_EQ_INT(stats.replayed, 1);
+    CHECK_EQ_INT(stats.rejected[ATTESTATION_STAGE_STRUCTURE], 2);
+    CHECK_EQ_INT(stats.rejected[ATTESTATION_STAGE_FRESHNESS], 2);
+    CHECK_EQ_INT(stats.rejected[ATTESTATION_STAGE_SIGNATURE], 1);
+}
+
+static void test_unknown_device(void) {
+    verify_engine_config_t config = { .replay_window = 16 };
+    attestation_report_t report;
+
+    CHECK(harness_start(&config));
+    if (!g_h.engine) {
+        return;
+    }
+    make_report(&report, g_device, (uint64_t)time(NULL));
+    CHECK_EQ_INT(verdict(&report), ATTESTATION_ERROR_UNKNOWN_DEVICE);
+
+    verify_engine_stats_t stats = harness_stop();
+    CHECK_EQ_INT(stats.unknown, 1);
+    CHECK_EQ_INT(stats.rejected[ATTESTATION_STAGE_REVOCATION], 1);
+}
+
+/**
+ * @brief A badly signed report from a device, which counts as a failure
+ */
+static uint32_t fail_once(const uint8_t *device) {
+    attestation_report_t report;
+    make_report(&report, device, (uint64_t)time(NULL));
+    report.signature[0] ^= 0x01;
+    return verdict(&report);
+}
+
+static uint32_t good_once(const uint8_t *device) {
+    attestation_report_t report;
+    make_report(&report, device, (uint64_t)time(NULL));
+    return verdict(&report);
+}
+
+static void test_throttling(void) {
+    // No replay window, so repeated timestamps are fine; one token a second
+    verify_engine_config_t config = { .failure_threshold = 3, .throttle_rate = 1 };
+    const uint64_t halflife_ms = VERIFY_ENGINE_FAILURE_HALFLIFE * 1000;
+
+    CHECK(harness_start(&config));
+    if (!g_h.engine) {
+        return;
+    }
+    enroll_device(g_device);
+    enroll_device(g_other);
+
+    // Below the threshold every report is verified
+    for (int i = 0; i < 3; i++) {
+        CHECK_EQ_INT(fail_once(g_device), ATTESTATION_ERROR_SIGNATURE_INVALID);
+    }
+
+    // At the threshold the bucket starts full: one second's worth, then
+    // nothing until it refills
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_NONE);
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_RATE_LIMITED);
+    CHECK_EQ_INT(fail_once(g_device), ATTESTATION_ERROR_RATE_LIMITED);
+
+    // Another device's counters are untouched
+    CHECK_EQ_INT(good_once(g_other), ATTESTATION_ERROR_NONE);
+    CHECK_EQ_INT(good_once(g_other), ATTESTATION_ERROR_NONE);
+
+    // A partial refill is kept, not lost to the rejection it did not pay for
+    verify_engine_advance_clock(600);
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_RATE_LIMITED);
+    verify_engine_advance_clock(400);
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_NONE);
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_RATE_LIMITED);
+
+    // One half-life takes the count from 3 to 1: no longer throttled, and
+    // two more failures bring it back to the threshold
+    verify_engine_advance_clock(halflife_ms);
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_NONE);
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_NONE);
+    CHECK_EQ_INT(fail_once(g_device), ATTESTATION_ERROR_SIGNATURE_INVALID);
+    CHECK_EQ_INT(fail_once(g_device), ATTESTATION_ERROR_SIGNATURE_INVALID);
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_NONE);
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_RATE_LIMITED);
+
+    // Eight half-lives forget everything: two failures stay below it
+    verify_engine_advance_clock(8 * halflife_ms);
+    CHECK_EQ_INT(fail_once(g_device), ATTESTATION_ERROR_SIGNATURE_INVALID);
+    CHECK_EQ_INT(fail_once(g_device), ATTESTATION_ERROR_SIGNATURE_INVALID);
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_NONE);
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_NONE);
+
+    verify_engine_stats_t stats = harness_stop();
+    CHECK_EQ_INT(stats.throttled, 5);
+    CHECK_EQ_INT(stats.rejected[ATTESTATION_STAGE_REVOCATION], 5);
+    CHECK_EQ_INT(stats.rejected[ATTESTATION_STAGE_SIGNATURE], 7);
+}
+
+/**
+ * @brief A device's key is expanded one lead before its next report is
+ *        expected, going by the smoothed gap between its reports
+ */
+static void test_prefetch_schedule(void) {
+    // One cached key, so any other device's report evicts it
+    verify_engine_config_t config = { .expanded_keys = 1, .prefetch_lead = 1000 };
+
+    CHECK(harness_start(&config));
+    if (!g_h.engine) {
+        return;
+    }
+    enroll_device(g_device);
+    enroll_device(g_other);
+
+    // Gaps of 8 s then 4 s: the interval is 8 - 8/4 + 4/4 = 7 s, so the key
+    // is due 6 s after the last report; going by the last gap alone it
+    // would be due after 3 s
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_NONE);
+    verify_engine_advance_clock(8000);
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_NONE);
+    verify_engine_advance_clock(4000);
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_NONE);
+    CHECK_EQ_INT(good_once(g_other), ATTESTATION_ERROR_NONE);
+
+    // Not yet due; the entry left by the earlier schedule is passed over
+    verify_engine_advance_clock(5500);
+    nudge();
+    poll(NULL, 0, 20);
+    CHECK_EQ_INT(nudge().key_prefetches, 0);
+
+    verify_engine_advance_clock(500);
+    CHECK(wait_prefetches(1));
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_NONE);
+
+    verify_engine_stats_t stats = harness_stop();
+    CHECK_EQ_INT(stats.key_expansions, 2);
+    CHECK_EQ_INT(stats.key_prefetches, 1);
+    CHECK_EQ_INT(stats.prefetch_hits, 1);
+    CHECK_EQ_INT(stats.valid, 5);
+}
+
+/**
+ * @brief No prefetch for a device that reports within the lead, or whose
+ *        key is still cached when it comes due
+ */
+static void test_prefetch_skipped(void) {
+    verify_engine_config_t config = { .expanded_keys = 1, .prefetch_lead = 1000 };
+
+    CHECK(harness_start(&config));
+    if (!g_h.engine) {
+        return;
+    }
+    enroll_device(g_device);
+    enroll_device(g_other);
+
+    // Every 500 ms: the key is evicted, but never scheduled
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_NONE);
+    verify_engine_advance_clock(500);
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_NONE);
+    CHECK_EQ_INT(good_once(g_other), ATTESTATION_ERROR_NONE);
+    verify_engine_advance_clock(10000);
+    nudge();
+    poll(NULL, 0, 20);
+    CHECK_EQ_INT(nudge().key_prefetches, 0);
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_NONE);
+
+    // Scheduled now that the gaps are longer, but its key is still cached
+    // when it comes due
+    verify_engine_advance_clock(5000);
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_NONE);
+    verify_engine_advance_clock(5000);
+    nudge();
+    poll(NULL, 0, 20);
+    CHECK_EQ_INT(nudge().key_prefetches, 0);
+    CHECK_EQ_INT(good_once(g_device), ATTESTATION_ERROR_NONE);
+
+    verify_engine_stats_t stats = harness_stop();
+    CHECK_EQ_INT(stats.key_expansions, 3);
+    CHECK_EQ_INT(stats.key_prefetches, 0);
+    CHECK_EQ_INT(stats.prefetch_hits, 0);
+}
+
+int main(void) {
+    CHECK_EQ_INT(pqc_init(NULL), PQC_SUCCESS);
+    CHECK_EQ_INT(dilithium_keypair(&g_pk, &g_sk), PQC_SUCCESS);
+    RUN_TEST(test_multi_producer);
+    RUN_TEST(test_shard_affinity);
+    RUN_TEST(test_stage_order);
+    RUN_TEST(test_unknown_device);
+    RUN_TEST(test_throttling);
+    RUN_TEST(test_prefetch_schedule);
+    RUN_TEST(test_prefetch_skipped);
+    pqc_cleanup();
+    return test_finish();
+}